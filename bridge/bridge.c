@@ -137,155 +137,98 @@ static Steinberg_tresult SMTG_STDMETHODCALLTYPE factory_createInstance(void* thi
     return ((Steinberg_tresult)0);
 }
 
-// Parameter automation helper functions implementation
-
-int32_t getParameterChangeCount(void* inputParameterChanges) {
-    if (!inputParameterChanges) {
-        DBG_LOG("getParameterChangeCount: inputParameterChanges is NULL");
-        return 0;
-    }
-    
-    struct Steinberg_Vst_IParameterChanges* changes = (struct Steinberg_Vst_IParameterChanges*)inputParameterChanges;
-    if (!changes->lpVtbl || !changes->lpVtbl->getParameterCount) {
-        DBG_LOG("getParameterChangeCount: vtable or method is NULL");
+// Block input marshalling
+//
+// Walks the host's IParameterChanges and IEventList once per block and copies
+// everything into flat arrays owned by Go, so the audio thread pays for a
+// single cgo transition instead of one per queue, point and event.
+
+static int32_t readParameterPoints(struct Steinberg_Vst_IParameterChanges* changes, ParamPoint* points, int32_t maxPoints) {
+    if (!changes || !changes->lpVtbl || !changes->lpVtbl->getParameterCount || !changes->lpVtbl->getParameterData) {
         return 0;
     }
-    
-    int32_t count = changes->lpVtbl->getParameterCount(changes);
-    // DBG_LOG("getParameterChangeCount: returning %d parameters", count);
-    return count;
-}
 
-void* getParameterData(void* inputParameterChanges, int32_t index) {
-    if (!inputParameterChanges) {
-        DBG_LOG("getParameterData: inputParameterChanges is NULL");
-        return NULL;
-    }
-    
-    struct Steinberg_Vst_IParameterChanges* changes = (struct Steinberg_Vst_IParameterChanges*)inputParameterChanges;
-    if (!changes->lpVtbl || !changes->lpVtbl->getParameterData) {
-        DBG_LOG("getParameterData: vtable or method is NULL");
-        return NULL;
-    }
-    
-    struct Steinberg_Vst_IParamValueQueue* queue = changes->lpVtbl->getParameterData(changes, index);
-    DBG_LOG("getParameterData: index=%d, returning queue=%p", index, queue);
-    return queue;
-}
+    int32_t numPoints = 0;
+    int32_t paramCount = changes->lpVtbl->getParameterCount(changes);
+    for (int32_t i = 0; i < paramCount; i++) {
+        struct Steinberg_Vst_IParamValueQueue* queue = changes->lpVtbl->getParameterData(changes, i);
+        if (!queue || !queue->lpVtbl || !queue->lpVtbl->getParameterId || !queue->lpVtbl->getPointCount || !queue->lpVtbl->getPoint) {
+            continue;
+        }
 
-uint32_t getParameterId(void* paramQueue) {
-    if (!paramQueue) {
-        DBG_LOG("getParameterId: paramQueue is NULL");
-        return 0;
-    }
-    
-    struct Steinberg_Vst_IParamValueQueue* queue = (struct Steinberg_Vst_IParamValueQueue*)paramQueue;
-    if (!queue->lpVtbl || !queue->lpVtbl->getParameterId) {
-        DBG_LOG("getParameterId: vtable or method is NULL");
-        return 0;
-    }
-    
-    uint32_t paramId = queue->lpVtbl->getParameterId(queue);
-    DBG_LOG("getParameterId: returning paramId=%u", paramId);
-    return paramId;
-}
+        uint32_t paramId = queue->lpVtbl->getParameterId(queue);
+        int32_t pointCount = queue->lpVtbl->getPointCount(queue);
+        for (int32_t j = 0; j < pointCount; j++) {
+            if (numPoints >= maxPoints) {
+                DBG_LOG("readParameterPoints: dropping points beyond %d", maxPoints);
+                return numPoints;
+            }
 
-int32_t getPointCount(void* paramQueue) {
-    if (!paramQueue) {
-        DBG_LOG("getPointCount: paramQueue is NULL");
-        return 0;
+            ParamPoint* point = &points[numPoints];
+            Steinberg_Vst_ParamValue value;
+            if (queue->lpVtbl->getPoint(queue, j, &point->sampleOffset, &value) == 0) { // kResultOk
+                point->paramId = paramId;
+                point->value = value;
+                numPoints++;
+            }
+        }
     }
-    
-    struct Steinberg_Vst_IParamValueQueue* queue = (struct Steinberg_Vst_IParamValueQueue*)paramQueue;
-    if (!queue->lpVtbl || !queue->lpVtbl->getPointCount) {
-        DBG_LOG("getPointCount: vtable or method is NULL");
-        return 0;
-    }
-    
-    int32_t count = queue->lpVtbl->getPointCount(queue);
-    DBG_LOG("getPointCount: returning %d points", count);
-    return count;
-}
 
-int32_t getPoint(void* paramQueue, int32_t index, int32_t* sampleOffset, double* value) {
-    if (!paramQueue) {
-        DBG_LOG("getPoint: paramQueue is NULL");
-        return 1; // kResultFalse
-    }
-    
-    if (!sampleOffset || !value) {
-        DBG_LOG("getPoint: sampleOffset or value pointer is NULL");
-        return 1; // kResultFalse
-    }
-    
-    struct Steinberg_Vst_IParamValueQueue* queue = (struct Steinberg_Vst_IParamValueQueue*)paramQueue;
-    if (!queue->lpVtbl || !queue->lpVtbl->getPoint) {
-        DBG_LOG("getPoint: vtable or method is NULL");
-        return 1; // kResultFalse
-    }
-    
-    // VST3 uses ParamValue which is double
-    Steinberg_Vst_ParamValue vstValue;
-    Steinberg_tresult result = queue->lpVtbl->getPoint(queue, index, sampleOffset, &vstValue);
-    
-    if (result == 0) { // kResultOk
-        *value = vstValue;
-        DBG_LOG("getPoint: index=%d, sampleOffset=%d, value=%.6f", index, *sampleOffset, *value);
-    } else {
-        DBG_LOG("getPoint: failed with result=%d", result);
-    }
-    
-    return result;
+    return numPoints;
 }
 
-// Event processing helper functions
-int32_t getEventCount(void* eventList) {
-    if (!eventList) {
-        // DBG_LOG("getEventCount: eventList is NULL");
-        return 0;
-    }
-    
-    struct Steinberg_Vst_IEventList* list = (struct Steinberg_Vst_IEventList*)eventList;
-    if (!list->lpVtbl || !list->lpVtbl->getEventCount) {
-        // DBG_LOG("getEventCount: vtable or method is NULL");
+static int32_t readEventRecords(struct Steinberg_Vst_IEventList* list, EventRecord* records, int32_t maxEvents) {
+    if (!list || !list->lpVtbl || !list->lpVtbl->getEventCount || !list->lpVtbl->getEvent) {
         return 0;
     }
-    
-    int32_t count = list->lpVtbl->getEventCount(list);
-    // DBG_LOG("getEventCount: returning %d events", count);
-    return count;
-}
-
-int32_t getEvent(void* eventList, int32_t index, struct Steinberg_Vst_Event* event) {
-    if (!eventList || !event) {
-        DBG_LOG("getEvent: eventList or event is NULL");
-        return 1; // kResultFalse
-    }
-    
-    struct Steinberg_Vst_IEventList* list = (struct Steinberg_Vst_IEventList*)eventList;
-    if (!list->lpVtbl || !list->lpVtbl->getEvent) {
-        DBG_LOG("getEvent: vtable or method is NULL");
-        return 1; // kResultFalse
-    }
-    
-    Steinberg_tresult result = list->lpVtbl->getEvent(list, index, event);
-    if (result == 0) { // kResultOk
-        DBG_LOG("getEvent: got event at index %d, type=%d", index, event->type);
-    } else {
-        DBG_LOG("getEvent: failed with result=%d", result);
-    }
-    
-    return result;
-}
-
-uint16_t getEventType(struct Steinberg_Vst_Event* event) {
-    return event->type;
-}
-
-struct Steinberg_Vst_NoteOnEvent* getNoteOnEvent(struct Steinberg_Vst_Event* event) {
-    return &event->Steinberg_Vst_Event_noteOn;
-}
 
-struct Steinberg_Vst_NoteOffEvent* getNoteOffEvent(struct Steinberg_Vst_Event* event) {
-    return &event->Steinberg_Vst_Event_noteOff;
+    int32_t numEvents = 0;
+    int32_t eventCount = list->lpVtbl->getEventCount(list);
+    for (int32_t i = 0; i < eventCount; i++) {
+        if (numEvents >= maxEvents) {
+            DBG_LOG("readEventRecords: dropping events beyond %d", maxEvents);
+            break;
+        }
+
+        struct Steinberg_Vst_Event event;
+        if (list->lpVtbl->getEvent(list, i, &event) != 0) { // kResultOk
+            continue;
+        }
+
+        EventRecord* record = &records[numEvents];
+        switch (event.type) {
+        case Steinberg_Vst_Event_EventTypes_kNoteOnEvent:
+            record->channel = event.Steinberg_Vst_Event_noteOn.channel;
+            record->pitch = event.Steinberg_Vst_Event_noteOn.pitch;
+            record->noteId = event.Steinberg_Vst_Event_noteOn.noteId;
+            record->value = event.Steinberg_Vst_Event_noteOn.velocity;
+            break;
+        case Steinberg_Vst_Event_EventTypes_kNoteOffEvent:
+            record->channel = event.Steinberg_Vst_Event_noteOff.channel;
+            record->pitch = event.Steinberg_Vst_Event_noteOff.pitch;
+            record->noteId = event.Steinberg_Vst_Event_noteOff.noteId;
+            record->value = event.Steinberg_Vst_Event_noteOff.velocity;
+            break;
+        case Steinberg_Vst_Event_EventTypes_kPolyPressureEvent:
+            record->channel = event.Steinberg_Vst_Event_polyPressure.channel;
+            record->pitch = event.Steinberg_Vst_Event_polyPressure.pitch;
+            record->noteId = event.Steinberg_Vst_Event_polyPressure.noteId;
+            record->value = event.Steinberg_Vst_Event_polyPressure.pressure;
+            break;
+        default:
+            continue; // Not forwarded to Go
+        }
+
+        record->type = event.type;
+        record->sampleOffset = event.sampleOffset;
+        numEvents++;
+    }
+
+    return numEvents;
+}
+
+void readBlockInputs(struct Steinberg_Vst_ProcessData* data, ParamPoint* points, int32_t maxPoints,
+                     EventRecord* events, int32_t maxEvents, BlockInputCounts* counts) {
+    counts->numPoints = readParameterPoints(data->inputParameterChanges, points, maxPoints);
+    counts->numEvents = readEventRecords(data->inputEvents, events, maxEvents);
 }
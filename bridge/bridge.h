@@ -11,18 +11,30 @@ extern int32_t GoCountClasses();
 extern void GoGetClassInfo(int32_t index, char* cid, int32_t* cardinality, char* category, char* name);
 extern void* GoCreateInstance(char* cid, char* iid);
 
-// Parameter automation helper functions
-int32_t getParameterChangeCount(void* inputParameterChanges);
-void* getParameterData(void* inputParameterChanges, int32_t index);
-uint32_t getParameterId(void* paramQueue);
-int32_t getPointCount(void* paramQueue);
-int32_t getPoint(void* paramQueue, int32_t index, int32_t* sampleOffset, double* value);
-
-// Event processing helper functions
-int32_t getEventCount(void* eventList);
-int32_t getEvent(void* eventList, int32_t index, struct Steinberg_Vst_Event* event);
-uint16_t getEventType(struct Steinberg_Vst_Event* event);
-struct Steinberg_Vst_NoteOnEvent* getNoteOnEvent(struct Steinberg_Vst_Event* event);
-struct Steinberg_Vst_NoteOffEvent* getNoteOffEvent(struct Steinberg_Vst_Event* event);
+// Block input marshalling: one automation point per ParamPoint
+typedef struct {
+    uint32_t paramId;
+    int32_t sampleOffset;
+    double value;
+} ParamPoint;
+
+// Note and poly pressure events; value is velocity or pressure (0-1)
+typedef struct {
+    uint16_t type;
+    int16_t channel;
+    int16_t pitch;
+    int32_t sampleOffset;
+    int32_t noteId;
+    float value;
+} EventRecord;
+
+typedef struct {
+    int32_t numPoints;
+    int32_t numEvents;
+} BlockInputCounts;
+
+// Copies a block's parameter changes and events into caller-owned arrays
+void readBlockInputs(struct Steinberg_Vst_ProcessData* data, ParamPoint* points, int32_t maxPoints,
+                     EventRecord* events, int32_t maxEvents, BlockInputCounts* counts);
 
 #endif // VST3GO_BRIDGE_H
\ No newline at end of file
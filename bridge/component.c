@@ -2,6 +2,10 @@
 #include <string.h>
 #include <stdlib.h>
 #include <stdio.h>
+#include <stdint.h>
+#if defined(__SSE__) || defined(__x86_64__)
+#include <xmmintrin.h>
+#endif
 
 // Debug logging
 #ifdef DEBUG_VST3GO
@@ -35,7 +39,7 @@ struct Component {
     EditControllerInterface editController;
     // Reference count
     int refCount;
-    // Go component handle
+    // Stable Go component handle (slot index + generation, never a Go pointer)
     void* goComponent;
 };
 
@@ -327,9 +331,41 @@ static Steinberg_tresult SMTG_STDMETHODCALLTYPE audio_setProcessing(void* thisIn
     return GoAudioSetProcessing(audioProc->component->goComponent, state);
 }
 
+// Flush-to-zero and denormals-are-zero for the duration of a process call,
+// so decaying feedback never runs on subnormal floats. The host's floating
+// point state is restored on return.
+#if defined(__SSE__) || defined(__x86_64__)
+#define FTZ_DAZ_BITS 0x8040 // MXCSR FTZ (bit 15) and DAZ (bit 6)
+static inline uintptr_t denormals_off(void) {
+    unsigned int csr = _mm_getcsr();
+    _mm_setcsr(csr | FTZ_DAZ_BITS);
+    return csr;
+}
+static inline void denormals_restore(uintptr_t csr) {
+    _mm_setcsr((unsigned int)csr);
+}
+#elif defined(__aarch64__)
+#define FPCR_FZ_BIT (1ULL << 24) // Flush-to-zero for inputs and outputs
+static inline uintptr_t denormals_off(void) {
+    uint64_t fpcr;
+    __asm__ __volatile__("mrs %0, fpcr" : "=r"(fpcr));
+    __asm__ __volatile__("msr fpcr, %0" : : "r"(fpcr | FPCR_FZ_BIT));
+    return fpcr;
+}
+static inline void denormals_restore(uintptr_t fpcr) {
+    __asm__ __volatile__("msr fpcr, %0" : : "r"((uint64_t)fpcr));
+}
+#else
+static inline uintptr_t denormals_off(void) { return 0; }
+static inline void denormals_restore(uintptr_t state) { (void)state; }
+#endif
+
 static Steinberg_tresult SMTG_STDMETHODCALLTYPE audio_process(void* thisInterface, struct Steinberg_Vst_ProcessData* data) {
     AudioProcessorInterface* audioProc = (AudioProcessorInterface*)thisInterface;
-    return GoAudioProcess(audioProc->component->goComponent, data);
+    uintptr_t fpState = denormals_off();
+    Steinberg_tresult result = GoAudioProcess(audioProc->component->goComponent, data);
+    denormals_restore(fpState);
+    return result;
 }
 
 static Steinberg_uint32 SMTG_STDMETHODCALLTYPE audio_getTailSamples(void* thisInterface) {
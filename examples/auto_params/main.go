@@ -194,5 +194,12 @@ func init() {
 	vst3plugin.Register(&AutoParamsPlugin{})
 }
 
-// Required for c-shared build mode
-func main() {}
\ No newline at end of file
+// benchMain is set by main_bench.go in builds with the bench tag
+var benchMain func()
+
+// Required for c-shared build mode; bench builds run the offline host instead
+func main() {
+	if benchMain != nil {
+		benchMain()
+	}
+}
\ No newline at end of file
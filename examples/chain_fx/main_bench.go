@@ -0,0 +1,11 @@
+//go:build bench
+
+package main
+
+import "github.com/justyntemme/vst3go/pkg/host"
+
+// Built as an executable with the bench tag, the plugin benchmarks itself
+// through the offline host (see host.Main)
+func init() {
+	benchMain = host.Main
+}
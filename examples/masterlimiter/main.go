@@ -25,8 +25,15 @@ func init() {
 	vst3plugin.Register(&MasterLimiterPlugin{})
 }
 
-// Required for c-shared build mode
-func main() {}
+// benchMain is set by main_bench.go in builds with the bench tag
+var benchMain func()
+
+// Required for c-shared build mode; bench builds run the offline host instead
+func main() {
+	if benchMain != nil {
+		benchMain()
+	}
+}
 
 // MasterLimiterPlugin implements the Plugin interface
 type MasterLimiterPlugin struct{}
@@ -57,8 +64,7 @@ const (
 // MasterLimiterProcessor implements the audio processing
 type MasterLimiterProcessor struct {
 	// DSP
-	limiterL *dynamics.Limiter
-	limiterR *dynamics.Limiter
+	limiter *dynamics.Limiter // One limiter for both channels, linked detection
 	
 	// Parameters
 	params *param.Registry
@@ -73,9 +79,6 @@ type MasterLimiterProcessor struct {
 	// State
 	sampleRate float64
 	active     bool
-	
-	// Stereo linking
-	stereoBuffer []float32
 }
 
 // NewMasterLimiterProcessor creates a new processor
@@ -134,10 +137,10 @@ func (p *MasterLimiterProcessor) initializeParameters() {
 			Build(),
 	)
 	
-	// Lookahead time (0-10ms)
+	// Lookahead time (0-100ms)
 	p.params.Add(
 		param.New(ParamLookahead, "Lookahead").
-			Range(0.0, 0.010).
+			Range(0.0, dynamics.MaxLookahead).
 			Default(0.005).
 			Unit("ms").
 			Formatter(func(value float64) string {
@@ -167,30 +170,22 @@ func (p *MasterLimiterProcessor) initializeParameters() {
 func (p *MasterLimiterProcessor) Initialize(sampleRate float64, maxBlockSize int32) error {
 	p.sampleRate = sampleRate
 	
-	// Create limiters for stereo processing
-	p.limiterL = dynamics.NewLimiter(sampleRate)
-	p.limiterR = dynamics.NewLimiter(sampleRate)
+	// Create the stereo limiter
+	p.limiter = dynamics.NewLimiter(sampleRate)
+	p.limiter.SetChannels(2)
 	
-	// Configure limiters
+	// Configure limiter
 	p.configureLimiters()
 	
-	// Allocate stereo buffer for linked processing
-	p.stereoBuffer = make([]float32, maxBlockSize*2)
-	
 	return nil
 }
 
 // configureLimiters sets up the limiters with current parameters
 func (p *MasterLimiterProcessor) configureLimiters() {
-	p.limiterL.SetThreshold(p.ceiling)
-	p.limiterL.SetRelease(p.release)
-	p.limiterL.SetTruePeak(p.truePeak)
-	p.limiterL.SetLookahead(p.lookahead)
-	
-	p.limiterR.SetThreshold(p.ceiling)
-	p.limiterR.SetRelease(p.release)
-	p.limiterR.SetTruePeak(p.truePeak)
-	p.limiterR.SetLookahead(p.lookahead)
+	p.limiter.SetThreshold(p.ceiling)
+	p.limiter.SetRelease(p.release)
+	p.limiter.SetTruePeak(p.truePeak)
+	p.limiter.SetLookahead(p.lookahead)
 }
 
 // ProcessAudio processes audio
@@ -209,22 +204,16 @@ func (p *MasterLimiterProcessor) ProcessAudio(ctx *process.Context) {
 		return
 	}
 	
-	// Process stereo with linked limiting
-	// The limiter has stereo processing but we need to handle it properly
-	for i := 0; i < numSamples; i++ {
-		// Process each channel with its own limiter but linked detection
-		ctx.Output[0][i] = p.limiterL.Process(ctx.Input[0][i])
-		ctx.Output[1][i] = p.limiterR.Process(ctx.Input[1][i])
-	}
+	// Process stereo with linked limiting, one block at a time
+	p.limiter.ProcessStereo(
+		ctx.Input[0][:numSamples], ctx.Input[1][:numSamples],
+		ctx.Output[0][:numSamples], ctx.Output[1][:numSamples])
 	
 	// Update gain reduction meter
-	// Use the maximum gain reduction from both channels
-	grL := p.limiterL.GetGainReduction()
-	grR := p.limiterR.GetGainReduction()
-	maxGR := -max(grL, grR) // Negate because GR is positive but we display negative
+	gr := -p.limiter.GetGainReduction() // Negate because GR is positive but we display negative
 	
 	if grParam := p.params.Get(ParamGainReduction); grParam != nil {
-		grParam.SetPlainValue(maxGR)
+		grParam.SetPlainValue(gr)
 	}
 }
 
@@ -234,16 +223,14 @@ func (p *MasterLimiterProcessor) updateParameters(ctx *process.Context) {
 	newCeiling := ctx.ParamPlain(ParamCeiling)
 	if newCeiling != p.ceiling {
 		p.ceiling = newCeiling
-		p.limiterL.SetThreshold(p.ceiling)
-		p.limiterR.SetThreshold(p.ceiling)
+		p.limiter.SetThreshold(p.ceiling)
 	}
 	
 	// Check release parameter
 	newRelease := ctx.ParamPlain(ParamRelease)
 	if newRelease != p.release {
 		p.release = newRelease
-		p.limiterL.SetRelease(p.release)
-		p.limiterR.SetRelease(p.release)
+		p.limiter.SetRelease(p.release)
 	}
 	
 	// Check true peak parameter
@@ -251,16 +238,14 @@ func (p *MasterLimiterProcessor) updateParameters(ctx *process.Context) {
 	newTruePeak := truePeakValue > 0.5
 	if newTruePeak != p.truePeak {
 		p.truePeak = newTruePeak
-		p.limiterL.SetTruePeak(p.truePeak)
-		p.limiterR.SetTruePeak(p.truePeak)
+		p.limiter.SetTruePeak(p.truePeak)
 	}
 	
 	// Check lookahead parameter
 	newLookahead := ctx.ParamPlain(ParamLookahead)
 	if newLookahead != p.lookahead {
 		p.lookahead = newLookahead
-		p.limiterL.SetLookahead(p.lookahead)
-		p.limiterR.SetLookahead(p.lookahead)
+		p.limiter.SetLookahead(p.lookahead)
 	}
 }
 
@@ -278,12 +263,9 @@ func (p *MasterLimiterProcessor) GetBuses() *bus.Configuration {
 func (p *MasterLimiterProcessor) SetActive(active bool) error {
 	p.active = active
 	if !active {
-		// Reset limiters when deactivated
-		if p.limiterL != nil {
-			p.limiterL.Reset()
-		}
-		if p.limiterR != nil {
-			p.limiterR.Reset()
+		// Reset the limiter when deactivated
+		if p.limiter != nil {
+			p.limiter.Reset()
 		}
 	}
 	return nil
@@ -291,8 +273,11 @@ func (p *MasterLimiterProcessor) SetActive(active bool) error {
 
 // GetLatencySamples returns the plugin latency in samples
 func (p *MasterLimiterProcessor) GetLatencySamples() int32 {
-	// Return lookahead time in samples
-	return int32(p.lookahead * p.sampleRate)
+	// Lookahead plus the true-peak detector's alignment delay
+	if p.limiter == nil {
+		return int32(p.lookahead * p.sampleRate)
+	}
+	return int32(p.limiter.Latency())
 }
 
 // GetTailSamples returns the tail length in samples
@@ -300,11 +285,3 @@ func (p *MasterLimiterProcessor) GetTailSamples() int32 {
 	// Return release time in samples
 	return int32(p.release * p.sampleRate)
 }
-
-// max returns the maximum of two float64 values
-func max(a, b float64) float64 {
-	if a > b {
-		return a
-	}
-	return b
-}
\ No newline at end of file
@@ -152,30 +152,24 @@ func (p *SidechainProcessor) ProcessAudio(ctx *process.Context) {
 	p.compressor.SetKnee(dynamics.KneeSoft, float64(knee))
 	p.compressor.SetMakeupGain(float64(makeupDb))
 
-	// Standard stereo processing for now - multi-bus support will be added when VST3 wrapper is updated
-	_ = sidechainActive // Will be used when multi-bus support is available
-
-	// Process main signal through compressor with internal detection
-	ctx.ProcessChannels(func(ch int, input, output []float32) {
-		// Create temporary buffer for compressed signal
-		compressed := make([]float32, len(input))
-		copy(compressed, input)
-
-		// Apply compression using ProcessBuffer
-		p.compressor.ProcessBuffer(compressed, compressed)
-
-		// Apply makeup gain
-		makeupLinear := gain.DbToLinear32(makeupDb)
-		gain.ApplyBuffer(compressed, makeupLinear)
-
-		// Mix dry/wet
-		mix.DryWetBufferTo(input, compressed, mixAmount, output)
+	// The sidechain bus keys the detector once the host activates it;
+	// otherwise the compressor detects on its own input
+	makeupLinear := gain.DbToLinear32(makeupDb)
+	ctx.Buses().ProcessWithSidechain(func(main, sidechain, output [][]float32) {
+		if !sidechainActive {
+			sidechain = nil
+		}
+		compressed := ctx.WorkBuffer()
+		for ch := 0; ch < len(main) && ch < len(output); ch++ {
+			if len(sidechain) > 0 {
+				p.compressor.ProcessSidechain(main[ch], sidechain[ch%len(sidechain)], compressed)
+			} else {
+				p.compressor.ProcessBuffer(main[ch], compressed)
+			}
+			gain.ApplyBuffer(compressed, makeupLinear)
+			mix.DryWetBufferTo(main[ch], compressed, mixAmount, output[ch])
+		}
 	})
-
-	// Note: When multi-bus wrapper support is available, we'll use:
-	// - Main input bus for the signal to be compressed
-	// - Sidechain input bus for the detection signal
-	// - Process like: compressor.ProcessWithSidechain(main, sidechain, output)
 }
 
 func (p *SidechainProcessor) GetParameters() *param.Registry {
@@ -220,5 +214,12 @@ func init() {
 	vst3plugin.Register(&SidechainPlugin{})
 }
 
-// Required for c-shared build mode
-func main() {}
\ No newline at end of file
+// benchMain is set by main_bench.go in builds with the bench tag
+var benchMain func()
+
+// Required for c-shared build mode; bench builds run the offline host instead
+func main() {
+	if benchMain != nil {
+		benchMain()
+	}
+}
\ No newline at end of file
@@ -21,6 +21,7 @@ type SimpleSynthProcessor struct {
 	// Voice management
 	voices     []voice.Voice
 	voiceAlloc *voice.Allocator
+	renderer   *voice.Renderer
 	
 	// Parameters
 	params *param.Registry
@@ -120,6 +121,12 @@ func (p *SimpleSynthProcessor) Initialize(sampleRate float64, maxBlockSize int32
 	p.voiceAlloc.SetMode(voice.ModePoly)
 	p.voiceAlloc.SetStealingMode(voice.StealOldest)
 	
+	// The helper thread is started by SetActive
+	if p.renderer != nil {
+		p.renderer.Stop()
+	}
+	p.renderer = voice.NewRenderer(p.voices, int(maxBlockSize))
+	
 	// Update voice parameters
 	p.updateVoiceParameters()
 	
@@ -161,38 +168,24 @@ func (p *SimpleSynthProcessor) ProcessAudio(ctx *process.Context) {
 		return
 	}
 	
-	// Use pre-allocated voice buffer
+	// Sum all active voices into the pre-allocated voice buffer
 	voiceBuffer := p.voiceBuffer[:numSamples]
-	activeVoices := 0
+	if p.renderer.Render(voiceBuffer) == 0 {
+		return
+	}
 	
-	for _, v := range p.voices {
-		if v != nil && v.IsActive() {
-			activeVoices++
-			// Process voice into temporary buffer
-			v.Process(voiceBuffer)
-			
-			// Mix into output (stereo)
-			for i := 0; i < numSamples; i++ {
-				sample := voiceBuffer[i] * float32(p.volume)
-				ctx.Output[0][i] += sample // Left
-				ctx.Output[1][i] += sample // Right
-			}
-		}
+	// Mix into output (stereo)
+	for i := 0; i < numSamples; i++ {
+		sample := voiceBuffer[i] * float32(p.volume)
+		ctx.Output[0][i] += sample // Left
+		ctx.Output[1][i] += sample // Right
 	}
 	
 }
 
 // processMIDIEvents handles incoming MIDI events
 func (p *SimpleSynthProcessor) processMIDIEvents(ctx *process.Context) {
-	events := ctx.GetAllInputEvents()
-	if len(events) > 0 {
-		
-	}
-	
-	for _, event := range events {
-		
-		p.voiceAlloc.ProcessEvent(event)
-	}
+	p.voiceAlloc.ProcessEvents(ctx.GetAllInputEvents())
 	
 	// Clear processed events
 	ctx.ClearInputEvents()
@@ -261,6 +254,15 @@ func (p *SimpleSynthProcessor) GetBuses() *bus.Configuration {
 func (p *SimpleSynthProcessor) SetActive(active bool) error {
 	
 	p.active = active
+	if p.renderer != nil {
+		if active {
+			// Render voices with one helper thread once the voice load is heavy enough
+			p.renderer.Start(1)
+		} else {
+			// Join the helper so a released instance leaves no thread behind
+			p.renderer.Stop()
+		}
+	}
 	if !active && p.voiceAlloc != nil {
 		// Stop all voices when deactivated
 		p.voiceAlloc.Reset()
@@ -97,11 +97,12 @@ func (v *SynthVoice) Process(output []float32) {
 	firstSample := true
 	maxSample := float32(0.0)
 	
-	// Generate audio
+	// Render the table-based oscillator for the whole block, then shape it
+	v.osc.ProcessSine(output)
+
 	for i := range output {
-		// Get oscillator sample
-		sample := v.osc.Sine()
-		
+		sample := output[i]
+
 		// Apply envelope
 		envValue := v.ampEnv.Next()
 		
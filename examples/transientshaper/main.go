@@ -26,8 +26,15 @@ func init() {
 	vst3plugin.Register(&TransientShaperPlugin{})
 }
 
-// Required for c-shared build mode
-func main() {}
+// benchMain is set by main_bench.go in builds with the bench tag
+var benchMain func()
+
+// Required for c-shared build mode; bench builds run the offline host instead
+func main() {
+	if benchMain != nil {
+		benchMain()
+	}
+}
 
 // TransientShaperPlugin implements the Plugin interface
 type TransientShaperPlugin struct{}
@@ -28,8 +28,15 @@ func init() {
 	vst3plugin.Register(&VocalStripPlugin{})
 }
 
-// Required for c-shared build mode
-func main() {}
+// benchMain is set by main_bench.go in builds with the bench tag
+var benchMain func()
+
+// Required for c-shared build mode; bench builds run the offline host instead
+func main() {
+	if benchMain != nil {
+		benchMain()
+	}
+}
 
 // VocalStripPlugin implements the Plugin interface
 type VocalStripPlugin struct{}
@@ -126,7 +133,7 @@ type VocalStripProcessor struct {
 	eqLowL, eqLowR         *filter.Biquad
 	eqMidL, eqMidR         *filter.Biquad
 	eqHighL, eqHighR       *filter.Biquad
-	limiterL, limiterR     *dynamics.Limiter
+	limiter                *dynamics.Limiter // One limiter for both channels, linked detection
 	
 	// Parameters
 	params *param.Registry
@@ -411,8 +418,8 @@ func (p *VocalStripProcessor) Initialize(sampleRate float64, maxBlockSize int32)
 	p.eqHighL = filter.NewBiquad(1)
 	p.eqHighR = filter.NewBiquad(1)
 	
-	p.limiterL = dynamics.NewLimiter(sampleRate)
-	p.limiterR = dynamics.NewLimiter(sampleRate)
+	p.limiter = dynamics.NewLimiter(sampleRate)
+	p.limiter.SetChannels(2)
 	
 	// Configure processors with default values
 	p.configureProcessors()
@@ -440,14 +447,10 @@ func (p *VocalStripProcessor) configureProcessors() {
 	// Configure EQ filters
 	p.updateEQFilters()
 	
-	// Configure limiters
-	p.limiterL.SetRelease(0.050)   // 50ms
-	p.limiterL.SetTruePeak(true)
-	p.limiterL.SetLookahead(0.005) // 5ms
-	
-	p.limiterR.SetRelease(0.050)
-	p.limiterR.SetTruePeak(true)
-	p.limiterR.SetLookahead(0.005)
+	// Configure limiter
+	p.limiter.SetRelease(0.050)   // 50ms
+	p.limiter.SetTruePeak(true)
+	p.limiter.SetLookahead(0.005) // 5ms
 }
 
 // updateEQFilters updates all EQ filter coefficients
@@ -514,8 +517,9 @@ func (p *VocalStripProcessor) ProcessAudio(ctx *process.Context) {
 	
 	// 4. Limiter
 	if p.limiterEnable {
-		p.limiterL.ProcessBuffer(ctx.Output[0][:numSamples], ctx.Output[0][:numSamples])
-		p.limiterR.ProcessBuffer(ctx.Output[1][:numSamples], ctx.Output[1][:numSamples])
+		p.limiter.ProcessStereo(
+			ctx.Output[0][:numSamples], ctx.Output[1][:numSamples],
+			ctx.Output[0][:numSamples], ctx.Output[1][:numSamples])
 	}
 	
 	// 5. Output gain
@@ -527,7 +531,7 @@ func (p *VocalStripProcessor) ProcessAudio(ctx *process.Context) {
 	
 	// Update gain reduction meter (combined from compressor and limiter)
 	compGR := (p.compressorL.GetGainReduction() + p.compressorR.GetGainReduction()) / 2.0
-	limGR := (p.limiterL.GetGainReduction() + p.limiterR.GetGainReduction()) / 2.0
+	limGR := p.limiter.GetGainReduction()
 	totalGR := -(compGR + limGR) // Negate for display
 	
 	if grParam := p.params.Get(ParamGainReduction); grParam != nil {
@@ -623,8 +627,7 @@ func (p *VocalStripProcessor) updateParameters(ctx *process.Context) {
 	p.limiterEnable = ctx.Param(ParamLimiterEnable) > 0.5
 	
 	ceiling := ctx.ParamPlain(ParamLimiterCeiling)
-	p.limiterL.SetThreshold(ceiling)
-	p.limiterR.SetThreshold(ceiling)
+	p.limiter.SetThreshold(ceiling)
 	
 	// Output gain
 	outputGainDB := ctx.ParamPlain(ParamOutputGain)
@@ -662,9 +665,8 @@ func (p *VocalStripProcessor) SetActive(active bool) error {
 			p.eqHighL.Reset()
 			p.eqHighR.Reset()
 		}
-		if p.limiterL != nil {
-			p.limiterL.Reset()
-			p.limiterR.Reset()
+		if p.limiter != nil {
+			p.limiter.Reset()
 		}
 	}
 	return nil
@@ -672,8 +674,12 @@ func (p *VocalStripProcessor) SetActive(active bool) error {
 
 // GetLatencySamples returns the plugin latency in samples
 func (p *VocalStripProcessor) GetLatencySamples() int32 {
-	// Only the limiter adds latency (lookahead)
-	return int32(0.005 * p.sampleRate) // 5ms
+	// Only the limiter adds latency: lookahead plus the true-peak
+	// detector's alignment delay
+	if p.limiter == nil {
+		return int32(0.005 * p.sampleRate) // 5ms lookahead
+	}
+	return int32(p.limiter.Latency())
 }
 
 // GetTailSamples returns the tail length in samples
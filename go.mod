@@ -1,3 +1,3 @@
 module github.com/justyntemme/vst3go
 
-go 1.24.3
+go 1.21
@@ -0,0 +1,532 @@
+package analysis
+
+import (
+	"math"
+
+	"github.com/justyntemme/vst3go/pkg/dsp/sample"
+)
+
+// Loudness gating constants (ITU-R BS.1770-4, EBU Tech 3342)
+const (
+	loudnessOffset       = -0.691 // K-weighted mean square to LUFS
+	absoluteGateLUFS     = -70.0
+	relativeGateLU       = -10.0 // Integrated loudness
+	rangeRelativeGateLU  = -20.0 // Loudness range
+	loudnessStepSeconds  = 0.1   // Gating block step (75% overlap of 400 ms)
+	momentarySteps       = 4     // 400 ms
+	shortTermSteps       = 30    // 3 s
+	minLoudnessRangeStep = 20    // Short-term values needed before reporting LRA
+)
+
+// Loudness histogram layout: 0.1 LU bins from the absolute gate up
+const (
+	histogramStepLU = 0.1
+	histogramBins   = 1000 // -70 to +30 LUFS
+)
+
+// True-peak interpolator: 4x polyphase FIR, 12 taps per phase
+const (
+	truePeakFactor = 4
+	truePeakTaps   = 12
+)
+
+// truePeakPhases holds the fractional phases 1/4, 2/4 and 3/4; phase 0 is
+// the input sample itself, which the sample peak already covers
+var truePeakPhases = designTruePeakPhases()
+
+// BusMeter meters every channel of a bus in one fused pass per block: sample
+// peak, RMS, 4x-oversampled true peak and K-weighted loudness.
+//
+// Loudness is decimated to the 100 ms gating step as soon as it is
+// filtered: each channel only accumulates its K-weighted energy, and
+// momentary (400 ms) and short-term (3 s) loudness are sums over a ring of
+// step energies. Integrated loudness and loudness range are gated from
+// fixed-size histograms, so memory is constant and each step is an O(1)
+// update however long the programme runs; the gate thresholds are resolved
+// to the 0.1 LU bin width.
+//
+// Process, Process64 and Reset belong to the audio thread. The controller
+// reads results with ReadSnapshot, which never blocks them.
+type BusMeter struct {
+	sampleRate float64
+	channels   []meterChannel
+
+	// K-weighting coefficients, shared by every channel
+	shelf, highpass kWeightingStage
+
+	stepSize int // Samples per gating step
+	stepPos  int // Samples into the current step
+
+	// Channel-weighted mean square of the most recent steps
+	steps     [shortTermSteps]float64
+	stepNext  int
+	stepCount int
+
+	momentary, shortTerm float64 // Mean squares; loudness is derived on publish
+	integrated           float64 // LUFS
+	loudnessRange        float64 // LU
+	maxTruePeak          float64
+
+	gated    loudnessHistogram // Momentary blocks for integrated loudness
+	ranged   loudnessHistogram // Short-term blocks for loudness range
+	frames   *TripleBuffer[MeterSnapshot]
+	sequence uint64
+}
+
+// MeterSnapshot is one published set of meter readings. Levels are linear;
+// loudness is in LUFS and the range in LU. Snapshots are reused; one returned
+// by ReadSnapshot stays valid until the next call.
+type MeterSnapshot struct {
+	Sequence uint64
+
+	Peak     []float64 // Sample peak of the last block, per channel
+	RMS      []float64 // RMS of the last block, per channel
+	TruePeak []float64 // 4x-oversampled peak of the last block, per channel
+
+	MaxTruePeak   float64 // Highest true peak since Reset
+	Momentary     float64 // 400 ms loudness
+	ShortTerm     float64 // 3 s loudness
+	Integrated    float64 // Gated programme loudness since Reset
+	LoudnessRange float64 // EBU Tech 3342 LRA since Reset
+}
+
+// meterChannel is the per-channel state of the fused pass
+type meterChannel struct {
+	weight float64 // BS.1770 channel weight
+
+	shelf, highpass biquadState
+	energy          float64 // K-weighted sum of squares in this step
+
+	// Input history for the true-peak interpolator, stored twice so the
+	// newest truePeakTaps samples are always contiguous at history[pos:]
+	history [2 * truePeakTaps]float64
+	pos     int
+
+	peak, sumSquares, truePeak float64 // Current block
+	blockSamples               int
+}
+
+// kWeightingStage holds normalized biquad coefficients
+type kWeightingStage struct {
+	b0, b1, b2, a1, a2 float64
+}
+
+// biquadState is the TDF2 state of one K-weighting stage
+type biquadState struct {
+	s1, s2 float64
+}
+
+// loudnessHistogram counts gating blocks in 0.1 LU bins above the absolute
+// gate and keeps the energy of each bin, so gated means stay exact within
+// the bins that pass
+type loudnessHistogram struct {
+	counts [histogramBins]uint32
+	energy [histogramBins]float64
+	total  uint32
+	sum    float64 // Energy of every block above the absolute gate
+}
+
+// NewBusMeter creates a meter for channels channels at sampleRate. Channel
+// weights follow BS.1770 for 5.1 (L R C LFE Ls Rs); every other layout
+// starts with all weights at 1.
+func NewBusMeter(sampleRate float64, channels int) *BusMeter {
+	if channels < 1 {
+		channels = 1
+	}
+	m := &BusMeter{
+		sampleRate: sampleRate,
+		channels:   make([]meterChannel, channels),
+		shelf:      kWeightingShelf(sampleRate),
+		highpass:   kWeightingHighpass(sampleRate),
+		stepSize:   int(math.Round(loudnessStepSeconds * sampleRate)),
+	}
+	if m.stepSize < 1 {
+		m.stepSize = 1
+	}
+	for ch := range m.channels {
+		m.channels[ch].weight = 1
+	}
+	if channels == 6 {
+		m.channels[3].weight = 0    // LFE
+		m.channels[4].weight = 1.41 // Ls
+		m.channels[5].weight = 1.41 // Rs
+	}
+
+	m.frames = NewTripleBuffer(func(s *MeterSnapshot) {
+		s.Peak = make([]float64, channels)
+		s.RMS = make([]float64, channels)
+		s.TruePeak = make([]float64, channels)
+	})
+	m.Reset()
+	return m
+}
+
+// Channels returns the number of metered channels
+func (m *BusMeter) Channels() int {
+	return len(m.channels)
+}
+
+// SetChannelWeight sets the loudness weight of one channel (for example 0
+// for an LFE channel or 1.41 for a surround channel). Call it at setup time.
+func (m *BusMeter) SetChannelWeight(channel int, weight float64) {
+	if channel >= 0 && channel < len(m.channels) {
+		m.channels[channel].weight = weight
+	}
+}
+
+// Process meters one block of float32 channels. Channels beyond the meter's
+// count are ignored and missing ones are metered as silence.
+func (m *BusMeter) Process(channels [][]float32) {
+	processBusMeter(m, channels)
+}
+
+// Process64 meters one block of float64 channels
+func (m *BusMeter) Process64(channels [][]float64) {
+	processBusMeter(m, channels)
+}
+
+func processBusMeter[T sample.Float](m *BusMeter, channels [][]T) {
+	n := 0
+	if len(channels) > 0 {
+		n = len(channels[0])
+	}
+	if len(channels) > len(m.channels) {
+		channels = channels[:len(m.channels)]
+	}
+	for ch := range m.channels {
+		c := &m.channels[ch]
+		c.peak, c.sumSquares, c.truePeak = 0, 0, 0
+		c.blockSamples = n
+	}
+
+	// Split the block at gating step boundaries
+	for offset := 0; offset < n; {
+		k := n - offset
+		if k > m.stepSize-m.stepPos {
+			k = m.stepSize - m.stepPos
+		}
+		for ch, input := range channels {
+			meterSamples(&m.channels[ch], &m.shelf, &m.highpass, input[offset:offset+k])
+		}
+		offset += k
+		m.stepPos += k
+		if m.stepPos == m.stepSize {
+			m.completeStep()
+		}
+	}
+
+	m.publish()
+}
+
+// meterSamples is the fused per-channel pass
+func meterSamples[T sample.Float](c *meterChannel, shelf, highpass *kWeightingStage, input []T) {
+	peak, sumSquares, truePeak, energy := c.peak, c.sumSquares, c.truePeak, c.energy
+	s1a, s2a := c.shelf.s1, c.shelf.s2
+	s1b, s2b := c.highpass.s1, c.highpass.s2
+	pos := c.pos
+
+	for _, v := range input {
+		x := float64(v)
+
+		ax := math.Abs(x)
+		if ax > peak {
+			peak = ax
+		}
+		sumSquares += x * x
+
+		// True peak: interpolate the fractional phases around the history
+		c.history[pos] = x
+		c.history[pos+truePeakTaps] = x
+		pos++
+		if pos == truePeakTaps {
+			pos = 0
+		}
+		window := c.history[pos : pos+truePeakTaps]
+		for p := range truePeakPhases {
+			taps := &truePeakPhases[p]
+			y := 0.0
+			for j, h := range taps {
+				y += h * window[j]
+			}
+			if y = math.Abs(y); y > truePeak {
+				truePeak = y
+			}
+		}
+
+		// K-weighting: high shelf, then the RLB highpass
+		y := shelf.b0*x + s1a
+		s1a = shelf.b1*x - shelf.a1*y + s2a
+		s2a = shelf.b2*x - shelf.a2*y
+		z := highpass.b0*y + s1b
+		s1b = highpass.b1*y - highpass.a1*z + s2b
+		s2b = highpass.b2*y - highpass.a2*z
+		energy += z * z
+	}
+
+	if peak > truePeak {
+		truePeak = peak
+	}
+	c.peak, c.sumSquares, c.truePeak, c.energy = peak, sumSquares, truePeak, energy
+	c.shelf.s1, c.shelf.s2 = s1a, s2a
+	c.highpass.s1, c.highpass.s2 = s1b, s2b
+	c.pos = pos
+}
+
+// completeStep closes a 100 ms gating step and updates the loudness values
+func (m *BusMeter) completeStep() {
+	power := 0.0
+	for ch := range m.channels {
+		c := &m.channels[ch]
+		power += c.weight * c.energy
+		c.energy = 0
+	}
+	power /= float64(m.stepSize)
+	m.stepPos = 0
+
+	m.steps[m.stepNext] = power
+	m.stepNext = (m.stepNext + 1) % shortTermSteps
+	if m.stepCount < shortTermSteps {
+		m.stepCount++
+	}
+	m.momentary = m.meanSteps(momentarySteps)
+	m.shortTerm = m.meanSteps(shortTermSteps)
+
+	// Gating blocks start once their window is full
+	changed := false
+	if m.stepCount >= momentarySteps {
+		changed = m.gated.add(m.momentary) || changed
+	}
+	if m.stepCount >= shortTermSteps {
+		changed = m.ranged.add(m.shortTerm) || changed
+	}
+	if changed {
+		m.integrated = m.gated.integrated()
+		m.loudnessRange = m.ranged.loudnessRange()
+	}
+}
+
+// meanSteps averages the last count steps, or as many as have completed
+func (m *BusMeter) meanSteps(count int) float64 {
+	if count > m.stepCount {
+		count = m.stepCount
+	}
+	if count == 0 {
+		return 0
+	}
+	sum := 0.0
+	for i := 1; i <= count; i++ {
+		sum += m.steps[(m.stepNext-i+shortTermSteps)%shortTermSteps]
+	}
+	return sum / float64(count)
+}
+
+// publish hands the current readings to the controller
+func (m *BusMeter) publish() {
+	s := m.frames.Back()
+	m.sequence++
+	s.Sequence = m.sequence
+
+	for ch := range m.channels {
+		c := &m.channels[ch]
+		s.Peak[ch] = c.peak
+		s.TruePeak[ch] = c.truePeak
+		s.RMS[ch] = 0
+		if c.blockSamples > 0 {
+			s.RMS[ch] = math.Sqrt(c.sumSquares / float64(c.blockSamples))
+		}
+		if c.truePeak > m.maxTruePeak {
+			m.maxTruePeak = c.truePeak
+		}
+	}
+
+	s.MaxTruePeak = m.maxTruePeak
+	s.Momentary = powerToLUFS(m.momentary)
+	s.ShortTerm = powerToLUFS(m.shortTerm)
+	s.Integrated = m.integrated
+	s.LoudnessRange = m.loudnessRange
+
+	m.frames.Publish()
+}
+
+// ReadSnapshot returns the latest readings without copying, and whether they
+// are new since the previous call. Controller side only.
+func (m *BusMeter) ReadSnapshot() (*MeterSnapshot, bool) {
+	return m.frames.Read()
+}
+
+// Reset clears every measurement, including integrated loudness and the
+// true-peak maximum, and publishes the cleared readings
+func (m *BusMeter) Reset() {
+	for ch := range m.channels {
+		weight := m.channels[ch].weight
+		m.channels[ch] = meterChannel{weight: weight}
+	}
+	m.stepPos = 0
+	m.steps = [shortTermSteps]float64{}
+	m.stepNext = 0
+	m.stepCount = 0
+	m.momentary = 0
+	m.shortTerm = 0
+	m.integrated = math.Inf(-1)
+	m.loudnessRange = 0
+	m.maxTruePeak = 0
+	m.gated.reset()
+	m.ranged.reset()
+	m.publish()
+}
+
+// powerToLUFS converts a channel-weighted mean square to LUFS
+func powerToLUFS(power float64) float64 {
+	if power <= 0 {
+		return math.Inf(-1)
+	}
+	return loudnessOffset + 10.0*math.Log10(power)
+}
+
+// add counts one gating block; blocks below the absolute gate are dropped
+func (h *loudnessHistogram) add(power float64) bool {
+	loudness := powerToLUFS(power)
+	if loudness < absoluteGateLUFS {
+		return false
+	}
+	bin := histogramBin(loudness)
+	h.counts[bin]++
+	h.energy[bin] += power
+	h.total++
+	h.sum += power
+	return true
+}
+
+// integrated returns the BS.1770 gated loudness of the counted blocks
+func (h *loudnessHistogram) integrated() float64 {
+	if h.total == 0 {
+		return math.Inf(-1)
+	}
+	threshold := powerToLUFS(h.sum/float64(h.total)) + relativeGateLU
+
+	sum := 0.0
+	count := uint32(0)
+	for bin := histogramBin(threshold); bin < histogramBins; bin++ {
+		sum += h.energy[bin]
+		count += h.counts[bin]
+	}
+	if count == 0 {
+		return math.Inf(-1)
+	}
+	return powerToLUFS(sum / float64(count))
+}
+
+// loudnessRange returns the EBU Tech 3342 loudness range of the counted
+// blocks: the spread between the 10th and 95th percentiles after gating
+func (h *loudnessHistogram) loudnessRange() float64 {
+	if h.total < minLoudnessRangeStep {
+		return 0
+	}
+	first := histogramBin(powerToLUFS(h.sum/float64(h.total)) + rangeRelativeGateLU)
+
+	count := uint32(0)
+	for bin := first; bin < histogramBins; bin++ {
+		count += h.counts[bin]
+	}
+	if count < minLoudnessRangeStep {
+		return 0
+	}
+	low := h.percentile(first, count, 0.10)
+	high := h.percentile(first, count, 0.95)
+	return high - low
+}
+
+// percentile returns the loudness at fraction q of count blocks, from bin first up
+func (h *loudnessHistogram) percentile(first int, count uint32, q float64) float64 {
+	target := uint32(q * float64(count-1))
+	seen := uint32(0)
+	for bin := first; bin < histogramBins; bin++ {
+		seen += h.counts[bin]
+		if seen > target {
+			return absoluteGateLUFS + (float64(bin)+0.5)*histogramStepLU
+		}
+	}
+	return absoluteGateLUFS + histogramBins*histogramStepLU
+}
+
+func (h *loudnessHistogram) reset() {
+	*h = loudnessHistogram{}
+}
+
+// histogramBin returns the bin of a loudness value, clamped to the histogram
+func histogramBin(loudness float64) int {
+	bin := int(math.Floor((loudness - absoluteGateLUFS) / histogramStepLU))
+	if bin < 0 {
+		return 0
+	}
+	if bin >= histogramBins {
+		return histogramBins - 1
+	}
+	return bin
+}
+
+// kWeightingShelf designs the first K-weighting stage, a +4 dB high shelf
+// (ITU-R BS.1770-4, re-derived for sampleRate)
+func kWeightingShelf(sampleRate float64) kWeightingStage {
+	f0 := 1681.974450955533
+	G := 3.999843853973347
+	Q := 0.7071752369554196
+	K := math.Tan(math.Pi * f0 / sampleRate)
+	Vh := math.Pow(10.0, G/20.0)
+	Vb := math.Pow(Vh, 0.4996667741545416)
+
+	a0 := 1.0 + K/Q + K*K
+	return kWeightingStage{
+		b0: (Vh + Vb*K/Q + K*K) / a0,
+		b1: 2.0 * (K*K - Vh) / a0,
+		b2: (Vh - Vb*K/Q + K*K) / a0,
+		a1: 2.0 * (K*K - 1.0) / a0,
+		a2: (1.0 - K/Q + K*K) / a0,
+	}
+}
+
+// kWeightingHighpass designs the second K-weighting stage, the RLB highpass
+func kWeightingHighpass(sampleRate float64) kWeightingStage {
+	f0 := 38.13547087602444
+	Q := 0.5003270373238773
+	K := math.Tan(math.Pi * f0 / sampleRate)
+
+	a0 := 1.0 + K/Q + K*K
+	return kWeightingStage{
+		b0: 1.0,
+		b1: -2.0,
+		b2: 1.0,
+		a1: 2.0 * (K*K - 1.0) / a0,
+		a2: (1.0 - K/Q + K*K) / a0,
+	}
+}
+
+// designTruePeakPhases designs the fractional phases of a Kaiser-windowed
+// sinc interpolator, each normalized to unity DC gain. Taps run oldest
+// sample first; phase p estimates the signal p/4 of a sample after the
+// seventh-newest input.
+func designTruePeakPhases() [truePeakFactor - 1][truePeakTaps]float64 {
+	const beta = 6.0
+	const halfSpan = truePeakTaps/2 + 0.5
+	centre := float64(truePeakTaps/2 - 1)
+
+	var phases [truePeakFactor - 1][truePeakTaps]float64
+	for p := range phases {
+		frac := float64(p+1) / truePeakFactor
+		sum := 0.0
+		for j := range phases[p] {
+			t := centre + frac - float64(j)
+			u := t / halfSpan
+			h := bessel0(beta*math.Sqrt(1-u*u)) / bessel0(beta)
+			if t != 0 {
+				h *= math.Sin(math.Pi*t) / (math.Pi * t)
+			}
+			phases[p][j] = h
+			sum += h
+		}
+		for j := range phases[p] {
+			phases[p][j] /= sum
+		}
+	}
+	return phases
+}
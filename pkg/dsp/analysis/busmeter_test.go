@@ -0,0 +1,151 @@
+package analysis
+
+import (
+	"math"
+	"testing"
+)
+
+// meterSine feeds seconds of a stereo sine through m in 10 ms blocks
+func meterSine(m *BusMeter, sampleRate, freq, amplitude, seconds float64, phase *float64) {
+	block := int(sampleRate / 100)
+	left := make([]float32, block)
+	right := make([]float32, block)
+	buffers := [][]float32{left, right}
+
+	for n := int(seconds * sampleRate); n > 0; n -= block {
+		for i := range left {
+			v := float32(amplitude * math.Sin(*phase))
+			left[i], right[i] = v, v
+			*phase += 2 * math.Pi * freq / sampleRate
+		}
+		m.Process(buffers)
+	}
+}
+
+func TestBusMeterLoudness(t *testing.T) {
+	sampleRate := 48000.0
+	m := NewBusMeter(sampleRate, 2)
+
+	// A 997 Hz stereo sine at -20 dBFS peak measures -20 LUFS: 0 dBFS in one
+	// channel is -3.01 LUFS, and the second channel adds 3.01 LU
+	phase := 0.0
+	meterSine(m, sampleRate, 997, 0.1, 5, &phase)
+
+	s, fresh := m.ReadSnapshot()
+	if !fresh {
+		t.Fatal("Expected a fresh snapshot")
+	}
+	for name, got := range map[string]float64{
+		"momentary":  s.Momentary,
+		"short-term": s.ShortTerm,
+		"integrated": s.Integrated,
+	} {
+		if math.Abs(got-(-20)) > 0.1 {
+			t.Errorf("%s loudness %f LUFS, want -20", name, got)
+		}
+	}
+	if math.Abs(s.Peak[0]-0.1) > 1e-3 || math.Abs(s.RMS[1]-0.1/math.Sqrt2) > 1e-3 {
+		t.Errorf("Peak %f, RMS %f", s.Peak[0], s.RMS[1])
+	}
+}
+
+func TestBusMeterGating(t *testing.T) {
+	sampleRate := 48000.0
+	m := NewBusMeter(sampleRate, 2)
+
+	// 20 s at -20 LUFS, 20 s at -40 LUFS and 10 s of silence. The relative
+	// gate drops the quiet part from integrated loudness, the absolute gate
+	// drops the silence from both measures.
+	phase := 0.0
+	meterSine(m, sampleRate, 997, 0.1, 20, &phase)
+	meterSine(m, sampleRate, 997, 0.01, 20, &phase)
+	meterSine(m, sampleRate, 997, 0, 10, &phase)
+
+	s, _ := m.ReadSnapshot()
+	if math.Abs(s.Integrated-(-20)) > 0.2 {
+		t.Errorf("Integrated %f LUFS, want -20", s.Integrated)
+	}
+	if math.Abs(s.LoudnessRange-20) > 0.3 {
+		t.Errorf("Loudness range %f LU, want 20", s.LoudnessRange)
+	}
+	if !math.IsInf(s.Momentary, -1) {
+		t.Errorf("Momentary loudness of silence %f, want -Inf", s.Momentary)
+	}
+
+	m.Reset()
+	if s, _ = m.ReadSnapshot(); !math.IsInf(s.Integrated, -1) || s.LoudnessRange != 0 {
+		t.Errorf("Reset left integrated %f, range %f", s.Integrated, s.LoudnessRange)
+	}
+}
+
+func TestBusMeterTruePeak(t *testing.T) {
+	sampleRate := 48000.0
+	m := NewBusMeter(sampleRate, 2)
+
+	// A quarter-rate sine offset by 45 degrees: every sample is at 0.707,
+	// but the waveform peaks at 1 between them
+	phase := math.Pi / 4
+	meterSine(m, sampleRate, sampleRate/4, 1, 0.1, &phase)
+
+	s, _ := m.ReadSnapshot()
+	if math.Abs(s.Peak[0]-math.Sqrt(0.5)) > 1e-3 {
+		t.Errorf("Sample peak %f, want 0.707", s.Peak[0])
+	}
+	if db := 20 * math.Log10(s.TruePeak[0]); math.Abs(db) > 0.2 {
+		t.Errorf("True peak %f dBTP, want 0", db)
+	}
+	if s.MaxTruePeak < s.TruePeak[0] {
+		t.Errorf("Max true peak %f below block true peak %f", s.MaxTruePeak, s.TruePeak[0])
+	}
+}
+
+func TestBusMeterZeroAllocations(t *testing.T) {
+	m := NewBusMeter(48000, 2)
+	buffers := [][]float32{make([]float32, 512), make([]float32, 512)}
+	for i := range buffers[0] {
+		buffers[0][i] = float32(math.Sin(float64(i) * 0.05))
+		buffers[1][i] = buffers[0][i]
+	}
+
+	allocs := testing.AllocsPerRun(200, func() {
+		m.Process(buffers)
+		m.ReadSnapshot()
+	})
+	if allocs != 0 {
+		t.Errorf("Process/ReadSnapshot allocated %.1f times", allocs)
+	}
+}
+
+func BenchmarkBusMeter(b *testing.B) {
+	const block = 512
+	samples := make([]float64, block)
+	for i := range samples {
+		samples[i] = math.Sin(2.0 * math.Pi * 1000.0 * float64(i) / 48000.0)
+	}
+
+	b.Run("Fused", func(b *testing.B) {
+		m := NewBusMeter(48000, 2)
+		buffers := [][]float64{samples, samples}
+		for i := 0; i < b.N; i++ {
+			m.Process64(buffers)
+			m.ReadSnapshot()
+		}
+	})
+
+	b.Run("Separate", func(b *testing.B) {
+		peak := NewPeakMeter(48000)
+		rms := NewRMSMeter(block)
+		lufs := NewLUFSMeter(48000, 2)
+		interleaved := make([]float64, 2*block)
+		for i, v := range samples {
+			interleaved[2*i], interleaved[2*i+1] = v, v
+		}
+		for i := 0; i < b.N; i++ {
+			for ch := 0; ch < 2; ch++ {
+				peak.Process(samples)
+				rms.Process(samples)
+			}
+			lufs.Process(interleaved)
+		}
+	})
+}
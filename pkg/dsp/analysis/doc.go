@@ -15,6 +15,7 @@
 //   - LUFS meter (ITU-R BS.1770-4 compliant)
 //   - Momentary, short-term, and integrated loudness
 //   - Loudness range (LRA) measurement
+//   - Bus meter: peak, RMS, true peak and loudness in one pass per block
 //
 // Stereo Field Analysis:
 //   - Correlation meter for phase relationships
@@ -42,6 +43,12 @@
 //	    spectrum := sa.GetSpectrumDB()
 //	    peakFreq, peakMag := sa.GetPeakFrequency()
 //	}
+//
+//	// Or feed float32 audio and poll from the GUI without copying
+//	sa.Process32(block)
+//	if frame, fresh := sa.ReadFrame(); fresh {
+//	    drawBars(frame.Bands)
+//	}
 //	
 //	// Create a LUFS meter
 //	lufs := analysis.NewLUFSMeter(48000, 2)
@@ -14,6 +14,9 @@ type FFT struct {
 	imag       []float64
 	magnitude  []float64
 	phase      []float64
+	plan       *fftPlan
+	complexOut []complex128
+	inverseOut []float64
 }
 
 // WindowFunc represents a window function type
@@ -39,6 +42,9 @@ func NewFFT(size int, window WindowFunc) *FFT {
 		imag:       make([]float64, size),
 		magnitude:  make([]float64, size/2+1),
 		phase:      make([]float64, size/2+1),
+		plan:       newFFTPlan(size),
+		complexOut: make([]complex128, size),
+		inverseOut: make([]float64, size),
 	}
 	
 	// Pre-calculate window coefficients
@@ -135,7 +141,8 @@ func (f *FFT) Forward(input []float64) (magnitude, phase []float64) {
 	return f.magnitude, f.phase
 }
 
-// ForwardComplex performs a forward FFT on complex input data
+// ForwardComplex performs a forward FFT on complex input data. The result
+// is owned by the FFT and overwritten by the next call.
 func (f *FFT) ForwardComplex(input []complex128) []complex128 {
 	// Copy input to working arrays
 	for i := 0; i < f.size && i < len(input); i++ {
@@ -154,7 +161,7 @@ func (f *FFT) ForwardComplex(input []complex128) []complex128 {
 	f.fft(f.real, f.imag)
 	
 	// Convert back to complex
-	result := make([]complex128, f.size)
+	result := f.complexOut
 	for i := 0; i < f.size; i++ {
 		result[i] = complex(f.real[i], f.imag[i])
 	}
@@ -162,22 +169,17 @@ func (f *FFT) ForwardComplex(input []complex128) []complex128 {
 	return result
 }
 
-// Inverse performs an inverse FFT
+// Inverse performs an inverse FFT and returns the real part. The result is
+// owned by the FFT and overwritten by the next call.
 func (f *FFT) Inverse(real, imag []float64) []float64 {
 	// Copy input
 	copy(f.real, real)
 	copy(f.imag, imag)
 	
-	// Conjugate
-	for i := 0; i < f.size; i++ {
-		f.imag[i] = -f.imag[i]
-	}
-	
-	// Forward FFT
-	f.fft(f.real, f.imag)
-	
-	// Conjugate and scale
-	result := make([]float64, f.size)
+	f.plan.transform(f.real, f.imag, true)
+
+	// Scale
+	result := f.inverseOut
 	scale := 1.0 / float64(f.size)
 	for i := 0; i < f.size; i++ {
 		result[i] = f.real[i] * scale
@@ -186,55 +188,9 @@ func (f *FFT) Inverse(real, imag []float64) []float64 {
 	return result
 }
 
-// fft performs the actual FFT using Cooley-Tukey algorithm
+// fft performs the actual FFT using the precomputed radix-2 plan
 func (f *FFT) fft(real, imag []float64) {
-	n := f.size
-	
-	// Bit reversal
-	j := 0
-	for i := 0; i < n; i++ {
-		if i < j {
-			real[i], real[j] = real[j], real[i]
-			imag[i], imag[j] = imag[j], imag[i]
-		}
-		m := n >> 1
-		for m >= 1 && j >= m {
-			j -= m
-			m >>= 1
-		}
-		j += m
-	}
-	
-	// Cooley-Tukey FFT
-	for stage := 2; stage <= n; stage <<= 1 {
-		theta := -2.0 * math.Pi / float64(stage)
-		wReal := math.Cos(theta)
-		wImag := math.Sin(theta)
-		
-		for k := 0; k < n; k += stage {
-			wTempReal := 1.0
-			wTempImag := 0.0
-			
-			for j := 0; j < stage/2; j++ {
-				i1 := k + j
-				i2 := i1 + stage/2
-				
-				tempReal := wTempReal*real[i2] - wTempImag*imag[i2]
-				tempImag := wTempReal*imag[i2] + wTempImag*real[i2]
-				
-				real[i2] = real[i1] - tempReal
-				imag[i2] = imag[i1] - tempImag
-				
-				real[i1] += tempReal
-				imag[i1] += tempImag
-				
-				// Update twiddle factor
-				oldWReal := wTempReal
-				wTempReal = oldWReal*wReal - wTempImag*wImag
-				wTempImag = oldWReal*wImag + wTempImag*wReal
-			}
-		}
-	}
+	f.plan.transform(real, imag, false)
 }
 
 // GetMagnitudeDB returns the magnitude spectrum in decibels
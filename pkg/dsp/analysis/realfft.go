@@ -0,0 +1,204 @@
+package analysis
+
+import "math"
+
+// fftPlan holds the bit-reversal permutation and twiddle factors of a
+// radix-2 complex FFT, computed once so transforms do no trigonometry
+type fftPlan struct {
+	size   int
+	bitrev []int32
+	// Twiddles of the stage with butterfly span h at [h, 2h):
+	// cos and sin of pi*j/h
+	cos []float64
+	sin []float64
+}
+
+func newFFTPlan(size int) *fftPlan {
+	p := &fftPlan{
+		size:   size,
+		bitrev: make([]int32, size),
+		cos:    make([]float64, size),
+		sin:    make([]float64, size),
+	}
+
+	bits := 0
+	for 1<<bits < size {
+		bits++
+	}
+	for i := range p.bitrev {
+		r := 0
+		for b := 0; b < bits; b++ {
+			r |= (i >> b & 1) << (bits - 1 - b)
+		}
+		p.bitrev[i] = int32(r)
+	}
+	for half := 1; half < size; half <<= 1 {
+		for j := 0; j < half; j++ {
+			p.sin[half+j], p.cos[half+j] = math.Sincos(math.Pi * float64(j) / float64(half))
+		}
+	}
+	return p
+}
+
+// transform runs an unscaled in-place complex FFT; inverse selects the
+// positive exponent
+func (p *fftPlan) transform(re, im []float64, inverse bool) {
+	n := p.size
+	re = re[:n]
+	im = im[:n]
+
+	for i, r := range p.bitrev {
+		if j := int(r); i < j {
+			re[i], re[j] = re[j], re[i]
+			im[i], im[j] = im[j], im[i]
+		}
+	}
+
+	sign := -1.0
+	if inverse {
+		sign = 1.0
+	}
+	// The first stage has only the trivial twiddle
+	for k := 0; k+1 < n; k += 2 {
+		r0, i0 := re[k], im[k]
+		re[k], im[k] = r0+re[k+1], i0+im[k+1]
+		re[k+1], im[k+1] = r0-re[k+1], i0-im[k+1]
+	}
+
+	for half := 2; half < n; half <<= 1 {
+		cos := p.cos[half : 2*half]
+		sin := p.sin[half : 2*half]
+		for k := 0; k < n; k += 2 * half {
+			a, b := re[k:k+half], re[k+half:k+2*half]
+			c, d := im[k:k+half], im[k+half:k+2*half]
+			b, c, d = b[:len(a)], c[:len(a)], d[:len(a)]
+			for j := range a {
+				wr := cos[j]
+				wi := sign * sin[j]
+
+				tr := wr*b[j] - wi*d[j]
+				ti := wr*d[j] + wi*b[j]
+				b[j] = a[j] - tr
+				d[j] = c[j] - ti
+				a[j] += tr
+				c[j] += ti
+			}
+		}
+	}
+}
+
+// RealFFT transforms real signals of a power-of-two size through a complex
+// FFT of half the size, with precomputed bit-reversal and twiddle tables.
+// Spectra are split into real and imaginary arrays of Size/2+1 bins. The
+// transforms work in preallocated buffers and never allocate; a RealFFT is
+// not safe for concurrent use.
+type RealFFT struct {
+	size int
+	half *fftPlan
+
+	// e^(-2*pi*i*k/size) for the split between the even and odd halves
+	splitCos []float64
+	splitSin []float64
+
+	workRe []float64
+	workIm []float64
+}
+
+// NewRealFFT creates a real FFT of size samples, rounded up to a power of two
+// (at least 4)
+func NewRealFFT(size int) *RealFFT {
+	n := 4
+	for n < size {
+		n <<= 1
+	}
+	r := &RealFFT{
+		size:     n,
+		half:     newFFTPlan(n / 2),
+		splitCos: make([]float64, n/2+1),
+		splitSin: make([]float64, n/2+1),
+		workRe:   make([]float64, n/2),
+		workIm:   make([]float64, n/2),
+	}
+	for k := range r.splitCos {
+		s, c := math.Sincos(2 * math.Pi * float64(k) / float64(n))
+		r.splitCos[k] = c
+		r.splitSin[k] = -s
+	}
+	return r
+}
+
+// Size returns the transform length in samples
+func (r *RealFFT) Size() int {
+	return r.size
+}
+
+// Bins returns the number of spectrum bins, Size/2+1
+func (r *RealFFT) Bins() int {
+	return r.size/2 + 1
+}
+
+// Forward transforms Size samples of input into re and im, each Bins long.
+// Input shorter than Size is zero-padded.
+func (r *RealFFT) Forward(input, re, im []float64) {
+	m := r.size / 2
+	zr, zi := r.workRe, r.workIm
+
+	// Pack even samples as real and odd samples as imaginary parts
+	for k := 0; k < m; k++ {
+		zr[k], zi[k] = 0, 0
+		if 2*k < len(input) {
+			zr[k] = input[2*k]
+		}
+		if 2*k+1 < len(input) {
+			zi[k] = input[2*k+1]
+		}
+	}
+	r.half.transform(zr, zi, false)
+
+	re = re[:m+1]
+	im = im[:m+1]
+	for k := 0; k <= m; k++ {
+		ar, ai := zr[k%m], zi[k%m]
+		br, bi := zr[(m-k)%m], -zi[(m-k)%m] // conj(Z[m-k])
+
+		// Spectra of the even and odd samples
+		er, ei := 0.5*(ar+br), 0.5*(ai+bi)
+		or, oi := 0.5*(ai-bi), -0.5*(ar-br) // (a-b)/(2i)
+
+		wr, wi := r.splitCos[k], r.splitSin[k]
+		re[k] = er + wr*or - wi*oi
+		im[k] = ei + wr*oi + wi*or
+	}
+}
+
+// Inverse transforms a spectrum of Bins bins back into Size samples of
+// output, including the 1/Size scaling, so Inverse(Forward(x)) == x
+func (r *RealFFT) Inverse(re, im, output []float64) {
+	m := r.size / 2
+	zr, zi := r.workRe, r.workIm
+
+	for k := 0; k < m; k++ {
+		ar, ai := re[k], im[k]
+		br, bi := re[m-k], -im[m-k] // conj(X[m-k])
+
+		er, ei := 0.5*(ar+br), 0.5*(ai+bi)
+		dr, di := 0.5*(ar-br), 0.5*(ai-bi)
+
+		// Odd spectrum: d * conj(w)
+		wr, wi := r.splitCos[k], -r.splitSin[k]
+		or := dr*wr - di*wi
+		oi := dr*wi + di*wr
+
+		// Z = E + i*O
+		zr[k] = er - oi
+		zi[k] = ei + or
+	}
+	r.half.transform(zr, zi, true)
+
+	scale := 1.0 / float64(m)
+	output = output[:r.size]
+	for k := 0; k < m; k++ {
+		output[2*k] = zr[k] * scale
+		output[2*k+1] = zi[k] * scale
+	}
+}
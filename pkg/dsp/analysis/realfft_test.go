@@ -0,0 +1,80 @@
+package analysis
+
+import (
+	"fmt"
+	"math"
+	"testing"
+)
+
+func TestRealFFT(t *testing.T) {
+	for _, size := range []int{4, 8, 64, 1024} {
+		r := NewRealFFT(size)
+		reference := NewFFT(size, RectangularWindow)
+
+		input := make([]float64, size)
+		for i := range input {
+			input[i] = math.Sin(0.3*float64(i)) + 0.25*math.Cos(1.7*float64(i)) + 0.1
+		}
+
+		re := make([]float64, r.Bins())
+		im := make([]float64, r.Bins())
+		r.Forward(input, re, im)
+
+		complexInput := make([]complex128, size)
+		for i, v := range input {
+			complexInput[i] = complex(v, 0)
+		}
+		want := reference.ForwardComplex(complexInput)
+		for k := 0; k < r.Bins(); k++ {
+			if math.Abs(re[k]-real(want[k])) > 1e-9 || math.Abs(im[k]-imag(want[k])) > 1e-9 {
+				t.Fatalf("Size %d bin %d: got (%f, %f), want %v", size, k, re[k], im[k], want[k])
+			}
+		}
+
+		output := make([]float64, size)
+		r.Inverse(re, im, output)
+		for i := range input {
+			if math.Abs(output[i]-input[i]) > 1e-12 {
+				t.Fatalf("Size %d sample %d: round trip %f, want %f", size, i, output[i], input[i])
+			}
+		}
+	}
+}
+
+func TestRealFFTZeroAllocations(t *testing.T) {
+	r := NewRealFFT(512)
+	input := make([]float64, 512)
+	re := make([]float64, r.Bins())
+	im := make([]float64, r.Bins())
+	allocs := testing.AllocsPerRun(50, func() {
+		r.Forward(input, re, im)
+		r.Inverse(re, im, input)
+	})
+	if allocs != 0 {
+		t.Errorf("RealFFT allocated %.1f times", allocs)
+	}
+}
+
+func BenchmarkRealFFT(b *testing.B) {
+	for _, size := range []int{256, 1024, 4096} {
+		r := NewRealFFT(size)
+		complexFFT := NewFFT(size, RectangularWindow)
+		input := make([]float64, size)
+		for i := range input {
+			input[i] = math.Sin(float64(i) * 0.1)
+		}
+		re := make([]float64, r.Bins())
+		im := make([]float64, r.Bins())
+
+		b.Run(fmt.Sprintf("Real_%d", size), func(b *testing.B) {
+			for i := 0; i < b.N; i++ {
+				r.Forward(input, re, im)
+			}
+		})
+		b.Run(fmt.Sprintf("Complex_%d", size), func(b *testing.B) {
+			for i := 0; i < b.N; i++ {
+				complexFFT.Forward(input)
+			}
+		})
+	}
+}
@@ -3,15 +3,33 @@ package analysis
 import (
 	"math"
 	"sync"
+
+	"github.com/justyntemme/vst3go/pkg/dsp/sample"
 )
 
-// SpectrumAnalyzer provides real-time spectral analysis
+// DefaultDisplayBands is the number of log-frequency bands in a published frame
+const DefaultDisplayBands = 64
+
+// MaxDisplayBands is the most log-frequency bands SetDisplayBands accepts
+const MaxDisplayBands = 512
+
+// spectrumFloorDB is the level reported for silent bins and bands
+const spectrumFloorDB = -120.0
+
+// SpectrumAnalyzer provides real-time spectral analysis.
+//
+// Samples are written to a ring buffer and transformed only when a hop
+// boundary is crossed: the first frame once fftSize samples have arrived,
+// then one every hop. Each frame is published through a triple buffer, so
+// the controller side reads the latest spectrum with ReadFrame without
+// locking against Process or copying. The log-frequency band tables behind
+// SpectrumFrame.Bands are computed by SetFrequencyRange and SetDisplayBands,
+// never per frame.
 type SpectrumAnalyzer struct {
 	fftSize      int
 	sampleRate   float64
-	fft          *FFT
-	buffer       []float64
-	writePos     int
+	window       []float64
+	rfft         *RealFFT
 	hopSize      int
 	averaging    AveragingMode
 	avgBuffer    [][]float64
@@ -23,7 +41,39 @@ type SpectrumAnalyzer struct {
 	minBin       int
 	maxBin       int
 	outputBuffer []float64
-	mu           sync.Mutex
+	mu           sync.Mutex // Serializes Process with the setters
+
+	// Ring-buffered STFT input
+	ring     []float64
+	ringPos  int // Next write position; also the oldest sample once full
+	filled   int // Samples in the ring, up to fftSize
+	sinceHop int // Samples since the last frame
+	frame    []float64
+	re, im   []float64
+
+	// Log-frequency band tables. Band b is the max of bins
+	// [bandStart[b], bandEnd[b]), or interpolated at bin bandCentre[b] when
+	// the band is narrower than a bin.
+	numBands   int
+	bandStart  []int
+	bandEnd    []int
+	bandCentre []float64
+
+	frames   *TripleBuffer[SpectrumFrame]
+	sequence uint64
+	readMu   sync.Mutex // Serializes controller-side reads of frames
+}
+
+// SpectrumFrame is one published analysis frame. Frames are owned by the
+// analyzer and reused; one returned by ReadFrame stays valid until the next
+// read of the same analyzer.
+type SpectrumFrame struct {
+	Sequence  uint64    // Increments with every published frame
+	Magnitude []float64 // Averaged magnitude per bin, fftSize/2+1 long
+	DB        []float64 // Magnitude in dB, floored at -120
+	Bands     []float64 // Peak level in dB of each log-frequency band
+
+	minBin, maxBin int // Frequency range the frame was published with
 }
 
 // AveragingMode defines how the spectrum is averaged over time
@@ -38,21 +88,36 @@ const (
 
 // NewSpectrumAnalyzer creates a new spectrum analyzer
 func NewSpectrumAnalyzer(fftSize int, sampleRate float64, window WindowFunc) *SpectrumAnalyzer {
+	bins := fftSize/2 + 1
 	sa := &SpectrumAnalyzer{
 		fftSize:      fftSize,
 		sampleRate:   sampleRate,
-		fft:          NewFFT(fftSize, window),
-		buffer:       make([]float64, fftSize),
+		window:       NewFFT(fftSize, window).windowData,
+		rfft:         NewRealFFT(fftSize),
 		hopSize:      fftSize / 2, // 50% overlap by default
 		averaging:    NoAveraging,
 		smoothing:    0.9,
 		minFreq:      20.0,
 		maxFreq:      sampleRate / 2.0,
-		outputBuffer: make([]float64, fftSize/2+1),
+		outputBuffer: make([]float64, bins),
+		ring:         make([]float64, fftSize),
+		frame:        make([]float64, fftSize),
+		numBands:     DefaultDisplayBands,
+		bandStart:    make([]int, MaxDisplayBands),
+		bandEnd:      make([]int, MaxDisplayBands),
+		bandCentre:   make([]float64, MaxDisplayBands),
 	}
-	
+	sa.re = make([]float64, sa.rfft.Bins())
+	sa.im = make([]float64, sa.rfft.Bins())
+	sa.frames = NewTripleBuffer(func(f *SpectrumFrame) {
+		f.Magnitude = make([]float64, bins)
+		f.DB = make([]float64, bins)
+		f.Bands = make([]float64, 0, MaxDisplayBands)
+	})
+
 	sa.updateFrequencyRange()
-	
+	sa.publish()
+
 	return sa
 }
 
@@ -60,7 +125,7 @@ func NewSpectrumAnalyzer(fftSize int, sampleRate float64, window WindowFunc) *Sp
 func (sa *SpectrumAnalyzer) SetHopSize(hopSize int) {
 	sa.mu.Lock()
 	defer sa.mu.Unlock()
-	
+
 	if hopSize > 0 && hopSize <= sa.fftSize {
 		sa.hopSize = hopSize
 	}
@@ -70,7 +135,7 @@ func (sa *SpectrumAnalyzer) SetHopSize(hopSize int) {
 func (sa *SpectrumAnalyzer) SetAveraging(mode AveragingMode, bufferSize int) {
 	sa.mu.Lock()
 	defer sa.mu.Unlock()
-	
+
 	sa.averaging = mode
 	if mode != NoAveraging && bufferSize > 0 {
 		sa.avgBuffer = make([][]float64, bufferSize)
@@ -86,87 +151,223 @@ func (sa *SpectrumAnalyzer) SetAveraging(mode AveragingMode, bufferSize int) {
 func (sa *SpectrumAnalyzer) SetSmoothing(smoothing float64) {
 	sa.mu.Lock()
 	defer sa.mu.Unlock()
-	
+
 	if smoothing >= 0 && smoothing <= 1 {
 		sa.smoothing = smoothing
 	}
 }
 
-// SetFrequencyRange sets the frequency range to analyze
+// SetFrequencyRange sets the frequency range to analyze and rebuilds the
+// display band tables. The current spectrum is republished in the new range.
 func (sa *SpectrumAnalyzer) SetFrequencyRange(minFreq, maxFreq float64) {
 	sa.mu.Lock()
 	defer sa.mu.Unlock()
-	
+
 	sa.minFreq = math.Max(0, minFreq)
 	sa.maxFreq = math.Min(sa.sampleRate/2.0, maxFreq)
 	sa.updateFrequencyRange()
+	sa.publish()
 }
 
-// updateFrequencyRange updates the bin range based on frequency limits
+// SetDisplayBands sets how many log-spaced bands between the range limits
+// each frame reports in Bands, clamped to 1..MaxDisplayBands
+func (sa *SpectrumAnalyzer) SetDisplayBands(bands int) {
+	sa.mu.Lock()
+	defer sa.mu.Unlock()
+
+	if bands < 1 {
+		bands = 1
+	}
+	if bands > MaxDisplayBands {
+		bands = MaxDisplayBands
+	}
+	sa.numBands = bands
+	sa.updateFrequencyRange()
+	sa.publish()
+}
+
+// updateFrequencyRange updates the bin range and band tables based on the
+// frequency limits
 func (sa *SpectrumAnalyzer) updateFrequencyRange() {
 	binWidth := sa.sampleRate / float64(sa.fftSize)
+	nyquistBin := sa.fftSize / 2
 	sa.minBin = int(sa.minFreq / binWidth)
 	sa.maxBin = int(sa.maxFreq/binWidth) + 1
-	
-	if sa.maxBin > sa.fftSize/2 {
-		sa.maxBin = sa.fftSize / 2
+
+	if sa.maxBin > nyquistBin {
+		sa.maxBin = nyquistBin
+	}
+
+	// Log spacing needs a positive lower edge; below one bin there is no
+	// resolution to show anyway
+	low := math.Max(sa.minFreq, binWidth)
+	high := math.Max(sa.maxFreq, low)
+	ratio := high / low
+
+	edgeBin := func(band int) float64 {
+		return low * math.Pow(ratio, float64(band)/float64(sa.numBands)) / binWidth
+	}
+	lower := edgeBin(0)
+	for b := 0; b < sa.numBands; b++ {
+		upper := edgeBin(b + 1)
+		start := int(math.Ceil(lower))
+		end := int(math.Ceil(upper))
+		if b == sa.numBands-1 {
+			end = int(math.Floor(upper)) + 1 // Include the top edge
+		}
+		if end > nyquistBin+1 {
+			end = nyquistBin + 1
+		}
+		if start > end {
+			start = end
+		}
+		sa.bandStart[b] = start
+		sa.bandEnd[b] = end
+		sa.bandCentre[b] = math.Min(math.Sqrt(lower*upper), float64(nyquistBin))
+		lower = upper
 	}
 }
 
 // Process adds samples to the analyzer and returns true when new spectrum is available
 func (sa *SpectrumAnalyzer) Process(samples []float64) bool {
+	return processSpectrum(sa, samples)
+}
+
+// Process32 is Process for float32 audio, without a conversion pass
+func (sa *SpectrumAnalyzer) Process32(samples []float32) bool {
+	return processSpectrum(sa, samples)
+}
+
+func processSpectrum[T sample.Float](sa *SpectrumAnalyzer, samples []T) bool {
 	sa.mu.Lock()
 	defer sa.mu.Unlock()
-	
+
 	spectrumReady := false
-	
-	for _, sample := range samples {
-		sa.buffer[sa.writePos] = sample
-		sa.writePos++
-		
-		if sa.writePos >= sa.fftSize {
-			// Perform FFT
-			magnitude, _ := sa.fft.Forward(sa.buffer)
-			
-			// Apply averaging
-			sa.applyAveraging(magnitude)
-			
-			// Shift buffer by hop size
-			if sa.hopSize < sa.fftSize {
-				copy(sa.buffer, sa.buffer[sa.hopSize:])
-				sa.writePos = sa.fftSize - sa.hopSize
-			} else {
-				sa.writePos = 0
+
+	for len(samples) > 0 {
+		// Copy up to the next frame boundary or the end of the ring
+		need := sa.hopSize - sa.sinceHop
+		if sa.filled < sa.fftSize {
+			need = sa.fftSize - sa.filled
+		}
+		if need < 1 {
+			need = 1 // Hop shortened since the last frame
+		}
+		n := len(samples)
+		if n > need {
+			n = need
+		}
+		if n > sa.fftSize-sa.ringPos {
+			n = sa.fftSize - sa.ringPos
+		}
+
+		ring := sa.ring[sa.ringPos : sa.ringPos+n]
+		for i, x := range samples[:n] {
+			ring[i] = float64(x)
+		}
+		samples = samples[n:]
+		sa.ringPos += n
+		if sa.ringPos == sa.fftSize {
+			sa.ringPos = 0
+		}
+
+		if sa.filled < sa.fftSize {
+			sa.filled += n
+			if sa.filled < sa.fftSize {
+				continue
+			}
+		} else {
+			sa.sinceHop += n
+			if sa.sinceHop < sa.hopSize {
+				continue
 			}
-			
-			spectrumReady = true
 		}
+
+		sa.sinceHop = 0
+		sa.analyze()
+		spectrumReady = true
 	}
-	
+
 	return spectrumReady
 }
 
+// analyze transforms the ring contents, oldest sample first, and publishes
+// the averaged result
+func (sa *SpectrumAnalyzer) analyze() {
+	tail := sa.fftSize - sa.ringPos
+	for i, x := range sa.ring[sa.ringPos:] {
+		sa.frame[i] = x * sa.window[i]
+	}
+	for i, x := range sa.ring[:sa.ringPos] {
+		sa.frame[tail+i] = x * sa.window[tail+i]
+	}
+
+	sa.rfft.Forward(sa.frame, sa.re, sa.im)
+	magnitude := sa.re[:len(sa.outputBuffer)]
+	for i, re := range magnitude {
+		im := sa.im[i]
+		magnitude[i] = math.Sqrt(re*re + im*im)
+	}
+
+	sa.applyAveraging(magnitude)
+	sa.publish()
+}
+
+// publish fills the writer's frame from outputBuffer and hands it to readers
+func (sa *SpectrumAnalyzer) publish() {
+	f := sa.frames.Back()
+	sa.sequence++
+	f.Sequence = sa.sequence
+	f.minBin, f.maxBin = sa.minBin, sa.maxBin
+
+	copy(f.Magnitude, sa.outputBuffer)
+	for i, mag := range sa.outputBuffer {
+		f.DB[i] = magnitudeToDB(mag)
+	}
+
+	f.Bands = f.Bands[:sa.numBands]
+	for b := range f.Bands {
+		var level float64
+		if start, end := sa.bandStart[b], sa.bandEnd[b]; start < end {
+			for _, mag := range sa.outputBuffer[start:end] {
+				level = math.Max(level, mag)
+			}
+		} else {
+			// Narrower than a bin: interpolate at the band centre
+			pos := sa.bandCentre[b]
+			i := int(pos)
+			level = sa.outputBuffer[i]
+			if i+1 < len(sa.outputBuffer) {
+				level += (sa.outputBuffer[i+1] - level) * (pos - float64(i))
+			}
+		}
+		f.Bands[b] = magnitudeToDB(level)
+	}
+
+	sa.frames.Publish()
+}
+
 // applyAveraging applies the selected averaging mode
 func (sa *SpectrumAnalyzer) applyAveraging(magnitude []float64) {
 	switch sa.averaging {
 	case NoAveraging:
 		copy(sa.outputBuffer, magnitude)
-		
+
 	case ExponentialAveraging:
 		for i := range magnitude {
 			sa.outputBuffer[i] = sa.outputBuffer[i]*sa.smoothing + magnitude[i]*(1-sa.smoothing)
 		}
-		
+
 	case LinearAveraging:
 		if sa.avgBuffer != nil {
 			// Store current spectrum
 			copy(sa.avgBuffer[sa.avgWritePos], magnitude)
 			sa.avgWritePos = (sa.avgWritePos + 1) % len(sa.avgBuffer)
-			
+
 			if sa.avgCount < len(sa.avgBuffer) {
 				sa.avgCount++
 			}
-			
+
 			// Average all stored spectra
 			for i := range sa.outputBuffer {
 				sum := 0.0
@@ -176,7 +377,7 @@ func (sa *SpectrumAnalyzer) applyAveraging(magnitude []float64) {
 				sa.outputBuffer[i] = sum / float64(sa.avgCount)
 			}
 		}
-		
+
 	case PeakHold:
 		for i := range magnitude {
 			if magnitude[i] > sa.outputBuffer[i] {
@@ -186,60 +387,62 @@ func (sa *SpectrumAnalyzer) applyAveraging(magnitude []float64) {
 	}
 }
 
-// GetSpectrum returns the current magnitude spectrum
+// ReadFrame returns the latest published frame without copying, and whether
+// it is new since the previous read. It never blocks Process. The frame is
+// reused and must not be held past the next read.
+func (sa *SpectrumAnalyzer) ReadFrame() (*SpectrumFrame, bool) {
+	sa.readMu.Lock()
+	defer sa.readMu.Unlock()
+
+	return sa.frames.Read()
+}
+
+// GetSpectrum returns a copy of the current magnitude spectrum
 func (sa *SpectrumAnalyzer) GetSpectrum() []float64 {
-	sa.mu.Lock()
-	defer sa.mu.Unlock()
-	
-	result := make([]float64, len(sa.outputBuffer))
-	copy(result, sa.outputBuffer)
+	f, _ := sa.ReadFrame()
+	result := make([]float64, len(f.Magnitude))
+	copy(result, f.Magnitude)
 	return result
 }
 
-// GetSpectrumDB returns the spectrum in decibels
+// GetSpectrumDB returns a copy of the spectrum in decibels
 func (sa *SpectrumAnalyzer) GetSpectrumDB() []float64 {
-	sa.mu.Lock()
-	defer sa.mu.Unlock()
-	
-	db := make([]float64, len(sa.outputBuffer))
-	for i, mag := range sa.outputBuffer {
-		if mag > 0 {
-			db[i] = 20.0 * math.Log10(mag)
-		} else {
-			db[i] = -120.0 // Floor at -120 dB
-		}
-	}
+	f, _ := sa.ReadFrame()
+	db := make([]float64, len(f.DB))
+	copy(db, f.DB)
 	return db
 }
 
 // GetSpectrumInRange returns the spectrum only for the configured frequency range
 func (sa *SpectrumAnalyzer) GetSpectrumInRange() []float64 {
-	sa.mu.Lock()
-	defer sa.mu.Unlock()
-	
-	if sa.minBin >= sa.maxBin {
+	f, _ := sa.ReadFrame()
+	if f.minBin >= f.maxBin {
 		return []float64{}
 	}
-	
-	rangeSize := sa.maxBin - sa.minBin
-	result := make([]float64, rangeSize)
-	copy(result, sa.outputBuffer[sa.minBin:sa.maxBin])
+
+	result := make([]float64, f.maxBin-f.minBin)
+	copy(result, f.Magnitude[f.minBin:f.maxBin])
 	return result
 }
 
 // GetSpectrumDBInRange returns the spectrum in dB for the configured frequency range
 func (sa *SpectrumAnalyzer) GetSpectrumDBInRange() []float64 {
-	spectrum := sa.GetSpectrumInRange()
-	db := make([]float64, len(spectrum))
-	
-	for i, mag := range spectrum {
-		if mag > 0 {
-			db[i] = 20.0 * math.Log10(mag)
-		} else {
-			db[i] = -120.0
-		}
+	f, _ := sa.ReadFrame()
+	if f.minBin >= f.maxBin {
+		return []float64{}
 	}
-	return db
+
+	result := make([]float64, f.maxBin-f.minBin)
+	copy(result, f.DB[f.minBin:f.maxBin])
+	return result
+}
+
+// magnitudeToDB converts a linear magnitude to dB, floored at -120 dB
+func magnitudeToDB(mag float64) float64 {
+	if mag > 0 {
+		return math.Max(20.0*math.Log10(mag), spectrumFloorDB)
+	}
+	return spectrumFloorDB
 }
 
 // GetFrequencyForBin returns the frequency corresponding to a bin index
@@ -252,24 +455,26 @@ func (sa *SpectrumAnalyzer) GetBinForFrequency(freq float64) int {
 	return int(freq * float64(sa.fftSize) / sa.sampleRate)
 }
 
-// Reset clears all buffers and averaging history
+// Reset clears all buffers and averaging history and publishes a silent frame
 func (sa *SpectrumAnalyzer) Reset() {
 	sa.mu.Lock()
 	defer sa.mu.Unlock()
-	
+
 	// Clear buffers
-	for i := range sa.buffer {
-		sa.buffer[i] = 0
+	for i := range sa.ring {
+		sa.ring[i] = 0
 	}
 	for i := range sa.outputBuffer {
 		sa.outputBuffer[i] = 0
 	}
-	
+
 	// Reset positions
-	sa.writePos = 0
+	sa.ringPos = 0
+	sa.filled = 0
+	sa.sinceHop = 0
 	sa.avgWritePos = 0
 	sa.avgCount = 0
-	
+
 	// Clear averaging buffers
 	if sa.avgBuffer != nil {
 		for i := range sa.avgBuffer {
@@ -278,81 +483,80 @@ func (sa *SpectrumAnalyzer) Reset() {
 			}
 		}
 	}
+
+	sa.publish()
 }
 
 // GetPeakFrequency finds the frequency with the highest magnitude
 func (sa *SpectrumAnalyzer) GetPeakFrequency() (float64, float64) {
-	sa.mu.Lock()
-	defer sa.mu.Unlock()
-	
+	f, _ := sa.ReadFrame()
+
 	maxMag := 0.0
 	maxBin := 0
-	
-	for i := sa.minBin; i < sa.maxBin && i < len(sa.outputBuffer); i++ {
-		if sa.outputBuffer[i] > maxMag {
-			maxMag = sa.outputBuffer[i]
+
+	for i := f.minBin; i < f.maxBin && i < len(f.Magnitude); i++ {
+		if f.Magnitude[i] > maxMag {
+			maxMag = f.Magnitude[i]
 			maxBin = i
 		}
 	}
-	
+
 	freq := sa.GetFrequencyForBin(maxBin)
 	return freq, maxMag
 }
 
 // GetBandEnergy calculates the energy in a frequency band
 func (sa *SpectrumAnalyzer) GetBandEnergy(minFreq, maxFreq float64) float64 {
-	sa.mu.Lock()
-	defer sa.mu.Unlock()
-	
+	f, _ := sa.ReadFrame()
+
 	minBin := sa.GetBinForFrequency(minFreq)
 	maxBin := sa.GetBinForFrequency(maxFreq)
-	
+
 	if minBin < 0 {
 		minBin = 0
 	}
-	if maxBin >= len(sa.outputBuffer) {
-		maxBin = len(sa.outputBuffer) - 1
+	if maxBin >= len(f.Magnitude) {
+		maxBin = len(f.Magnitude) - 1
 	}
-	
+
 	energy := 0.0
 	for i := minBin; i <= maxBin; i++ {
-		energy += sa.outputBuffer[i] * sa.outputBuffer[i]
+		energy += f.Magnitude[i] * f.Magnitude[i]
 	}
-	
+
 	return energy
 }
 
 // GetOctaveBands returns spectrum data grouped into octave bands
 func (sa *SpectrumAnalyzer) GetOctaveBands(centerFreqs []float64) []float64 {
-	sa.mu.Lock()
-	defer sa.mu.Unlock()
-	
+	f, _ := sa.ReadFrame()
+
 	bands := make([]float64, len(centerFreqs))
-	
+
 	for i, centerFreq := range centerFreqs {
 		// Calculate octave band limits
 		lowerFreq := centerFreq / math.Sqrt(2)
 		upperFreq := centerFreq * math.Sqrt(2)
-		
+
 		// Sum energy in band
 		energy := 0.0
 		count := 0
-		
+
 		lowerBin := sa.GetBinForFrequency(lowerFreq)
 		upperBin := sa.GetBinForFrequency(upperFreq)
-		
-		for bin := lowerBin; bin <= upperBin && bin < len(sa.outputBuffer); bin++ {
+
+		for bin := lowerBin; bin <= upperBin && bin < len(f.Magnitude); bin++ {
 			if bin >= 0 {
-				energy += sa.outputBuffer[bin] * sa.outputBuffer[bin]
+				energy += f.Magnitude[bin] * f.Magnitude[bin]
 				count++
 			}
 		}
-		
+
 		if count > 0 {
 			bands[i] = math.Sqrt(energy / float64(count))
 		}
 	}
-	
+
 	return bands
 }
 
@@ -365,7 +569,7 @@ func StandardOctaveBands() []float64 {
 func StandardThirdOctaveBands() []float64 {
 	bands := []float64{}
 	baseFreq := 1000.0
-	
+
 	// Generate bands from 20 Hz to 20 kHz
 	for i := -16; i <= 13; i++ {
 		freq := baseFreq * math.Pow(2, float64(i)/3.0)
@@ -373,6 +577,6 @@ func StandardThirdOctaveBands() []float64 {
 			bands = append(bands, freq)
 		}
 	}
-	
+
 	return bands
-}
\ No newline at end of file
+}
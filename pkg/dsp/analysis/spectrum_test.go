@@ -402,4 +402,128 @@ func BenchmarkSpectrumAnalyzer(b *testing.B) {
 			}
 		})
 	}
-}
\ No newline at end of file
+}
+
+func TestSpectrumStreaming(t *testing.T) {
+	sampleRate := 48000.0
+	fftSize := 1024
+	hop := 256
+	sa := NewSpectrumAnalyzer(fftSize, sampleRate, HannWindow)
+	sa.SetHopSize(hop)
+
+	start, _ := sa.ReadFrame()
+	sequence := start.Sequence
+
+	samples := make([]float32, fftSize*3)
+	for i := range samples {
+		samples[i] = float32(math.Sin(2.0 * math.Pi * 1000.0 * float64(i) / sampleRate))
+	}
+
+	// Frames appear only at hop boundaries: after fftSize samples, then every hop
+	block := 100
+	frames := 0
+	for i := 0; i < len(samples); i += block {
+		end := i + block
+		if end > len(samples) {
+			end = len(samples)
+		}
+		ready := sa.Process32(samples[i:end])
+
+		want := 0
+		if end >= fftSize {
+			want = 1 + (end-fftSize)/hop
+		}
+		if ready != (want > frames) {
+			t.Fatalf("Block ending at %d: ready = %v, want %v", end, ready, want > frames)
+		}
+		frames = want
+	}
+
+	f, fresh := sa.ReadFrame()
+	if !fresh || f.Sequence != sequence+uint64(frames) {
+		t.Errorf("Expected frame %d, got %d (fresh %v)", sequence+uint64(frames), f.Sequence, fresh)
+	}
+	if _, fresh = sa.ReadFrame(); fresh {
+		t.Error("Second read without new audio should not be fresh")
+	}
+
+	// float32 and float64 input produce the same spectrum
+	sa64 := NewSpectrumAnalyzer(fftSize, sampleRate, HannWindow)
+	sa64.SetHopSize(hop)
+	samples64 := make([]float64, len(samples))
+	for i, x := range samples {
+		samples64[i] = float64(x)
+	}
+	sa64.Process(samples64)
+	f64, _ := sa64.ReadFrame()
+	for i := range f.Magnitude {
+		if math.Abs(f.Magnitude[i]-f64.Magnitude[i]) > 1e-9 {
+			t.Fatalf("Bin %d differs: %g vs %g", i, f.Magnitude[i], f64.Magnitude[i])
+		}
+	}
+}
+
+func TestSpectrumDisplayBands(t *testing.T) {
+	sampleRate := 48000.0
+	fftSize := 2048
+	sa := NewSpectrumAnalyzer(fftSize, sampleRate, HannWindow)
+	sa.SetFrequencyRange(20, 20000)
+	sa.SetDisplayBands(32)
+
+	freq := 1000.0
+	samples := make([]float64, fftSize)
+	for i := range samples {
+		samples[i] = math.Sin(2.0 * math.Pi * freq * float64(i) / sampleRate)
+	}
+	sa.Process(samples)
+
+	f, _ := sa.ReadFrame()
+	if len(f.Bands) != 32 {
+		t.Fatalf("Expected 32 bands, got %d", len(f.Bands))
+	}
+
+	// The loudest band is the one whose log-spaced edges contain 1 kHz. The
+	// lower edge is clamped to one bin width.
+	low, high := sampleRate/float64(fftSize), 20000.0
+	want := int(math.Log(freq/low) / math.Log(high/low) * 32)
+	loudest := 0
+	for b, level := range f.Bands {
+		if level > f.Bands[loudest] {
+			loudest = b
+		}
+	}
+	if loudest != want {
+		t.Errorf("Loudest band %d, want %d", loudest, want)
+	}
+	if f.Bands[0] > f.Bands[want]-40 {
+		t.Errorf("Low band too loud: %f dB vs %f dB", f.Bands[0], f.Bands[want])
+	}
+
+	// Low bands narrower than a bin interpolate instead of dropping to the floor
+	sa.SetDisplayBands(MaxDisplayBands)
+	f, _ = sa.ReadFrame()
+	for b, level := range f.Bands[:MaxDisplayBands/4] {
+		if level <= spectrumFloorDB {
+			t.Errorf("Band %d fell to the floor", b)
+			break
+		}
+	}
+}
+
+func TestSpectrumZeroAllocations(t *testing.T) {
+	sa := NewSpectrumAnalyzer(1024, 48000, HannWindow)
+	sa.SetHopSize(128)
+	samples := make([]float32, 256)
+	for i := range samples {
+		samples[i] = float32(math.Sin(float64(i) * 0.1))
+	}
+
+	allocs := testing.AllocsPerRun(100, func() {
+		sa.Process32(samples)
+		f, _ := sa.ReadFrame()
+		_ = f.Bands
+	})
+	if allocs != 0 {
+		t.Errorf("Process32/ReadFrame allocated %.1f times", allocs)
+	}
+}
@@ -0,0 +1,53 @@
+package analysis
+
+import "sync/atomic"
+
+// TripleBuffer hands values from one writer to one reader without locks or
+// copies. The writer fills the back slot and publishes it; the reader takes
+// the most recently published slot. Each side owns its slot exclusively until
+// its next Publish or Read, so neither ever waits for the other, and a slow
+// reader simply skips frames.
+type TripleBuffer[T any] struct {
+	slots [3]T
+	back  int           // Writer's slot
+	front int           // Reader's slot
+	ready atomic.Uint32 // Shared slot index, plus readyFresh once published
+}
+
+const readyFresh = 1 << 2
+
+// NewTripleBuffer creates a triple buffer; init prepares each of the three
+// slots (for example, allocating its buffers)
+func NewTripleBuffer[T any](init func(*T)) *TripleBuffer[T] {
+	t := &TripleBuffer[T]{back: 0, front: 1}
+	t.ready.Store(2)
+	if init != nil {
+		for i := range t.slots {
+			init(&t.slots[i])
+		}
+	}
+	return t
+}
+
+// Back returns the writer's slot to fill. Writer side only.
+func (t *TripleBuffer[T]) Back() *T {
+	return &t.slots[t.back]
+}
+
+// Publish makes the back slot the latest value and gives the writer a new
+// back slot. Writer side only.
+func (t *TripleBuffer[T]) Publish() {
+	previous := t.ready.Swap(uint32(t.back) | readyFresh)
+	t.back = int(previous &^ readyFresh)
+}
+
+// Read returns the latest published value and whether it is new since the
+// previous Read. The value stays valid until the next Read. Reader side only.
+func (t *TripleBuffer[T]) Read() (*T, bool) {
+	fresh := t.ready.Load()&readyFresh != 0
+	if fresh {
+		previous := t.ready.Swap(uint32(t.front))
+		t.front = int(previous &^ readyFresh)
+	}
+	return &t.slots[t.front], fresh
+}
@@ -0,0 +1,60 @@
+package analysis
+
+import (
+	"sync"
+	"testing"
+)
+
+func TestTripleBuffer(t *testing.T) {
+	tb := NewTripleBuffer(func(v *[]int) { *v = make([]int, 1) })
+
+	if _, fresh := tb.Read(); fresh {
+		t.Error("Nothing published yet, Read should not report fresh")
+	}
+
+	// A reader that falls behind sees only the latest value
+	for i := 1; i <= 3; i++ {
+		(*tb.Back())[0] = i
+		tb.Publish()
+	}
+	v, fresh := tb.Read()
+	if !fresh || (*v)[0] != 3 {
+		t.Errorf("Read = %v, %v; want [3], true", *v, fresh)
+	}
+	if v, fresh = tb.Read(); fresh || (*v)[0] != 3 {
+		t.Errorf("Repeated Read = %v, %v; want [3], false", *v, fresh)
+	}
+}
+
+func TestTripleBufferConcurrent(t *testing.T) {
+	type frame struct{ a, b int }
+	tb := NewTripleBuffer[frame](nil)
+	const writes = 100000
+
+	var wg sync.WaitGroup
+	wg.Add(1)
+	go func() {
+		defer wg.Done()
+		for i := 1; i <= writes; i++ {
+			f := tb.Back()
+			f.a, f.b = i, -i
+			tb.Publish()
+		}
+	}()
+
+	last := 0
+	for last < writes {
+		f, fresh := tb.Read()
+		if !fresh {
+			continue
+		}
+		if f.a != -f.b {
+			t.Fatalf("Torn frame: %d, %d", f.a, f.b)
+		}
+		if f.a <= last {
+			t.Fatalf("Frame went backwards: %d after %d", f.a, last)
+		}
+		last = f.a
+	}
+	wg.Wait()
+}
@@ -2,9 +2,11 @@ package dsp
 
 import (
 	"math"
+	"strconv"
 	"testing"
 
 	"github.com/justyntemme/vst3go/pkg/dsp/gain"
+	"github.com/justyntemme/vst3go/pkg/dsp/internal/simd"
 	"github.com/justyntemme/vst3go/pkg/dsp/mix"
 	"github.com/justyntemme/vst3go/pkg/dsp/utility"
 )
@@ -21,7 +23,7 @@ func BenchmarkGainOperations(b *testing.B) {
 			buffer[i] = float32(math.Sin(float64(i) * 0.1))
 		}
 
-		b.Run("ApplyBuffer_"+string(rune(size)), func(b *testing.B) {
+		b.Run("ApplyBuffer_"+strconv.Itoa(size), func(b *testing.B) {
 			b.SetBytes(int64(size * 4)) // float32 is 4 bytes
 			for i := 0; i < b.N; i++ {
 				gain.ApplyBuffer(buffer, 0.5)
@@ -54,14 +56,14 @@ func BenchmarkMixOperations(b *testing.B) {
 			dst[i] = float32(math.Cos(float64(i) * 0.1))
 		}
 
-		b.Run("AddScaled_"+string(rune(size)), func(b *testing.B) {
+		b.Run("AddScaled_"+strconv.Itoa(size), func(b *testing.B) {
 			b.SetBytes(int64(size * 4))
 			for i := 0; i < b.N; i++ {
 				AddScaled(dst, src, 0.5)
 			}
 		})
 
-		b.Run("Mix_"+string(rune(size)), func(b *testing.B) {
+		b.Run("Mix_"+strconv.Itoa(size), func(b *testing.B) {
 			b.SetBytes(int64(size * 4))
 			src2 := make([]float32, size)
 			copy(src2, dst)
@@ -69,6 +71,51 @@ func BenchmarkMixOperations(b *testing.B) {
 				Mix(dst, src, src2, 0.5)
 			}
 		})
+
+		b.Run("DryWetBuffer_"+strconv.Itoa(size), func(b *testing.B) {
+			b.SetBytes(int64(size * 4))
+			for i := 0; i < b.N; i++ {
+				mix.DryWetBuffer(dst, src, 0.5)
+			}
+		})
+	}
+}
+
+// BenchmarkAcceleratedVsGeneric compares the SIMD buffer kernels with the
+// portable loops they replace
+func BenchmarkAcceleratedVsGeneric(b *testing.B) {
+	dst := make([]float32, 512)
+	src := make([]float32, 512)
+	for i := range src {
+		src[i] = float32(math.Sin(float64(i) * 0.1))
+	}
+
+	kernels := []struct {
+		name string
+		fn   func()
+	}{
+		{"AddScaled", func() { AddScaled(dst, src, 0.5) }},
+		{"Scale", func() { Scale(dst, 0.999) }},
+		{"Mix", func() { Mix(dst, src, dst, 0.5) }},
+		{"PeakRMS", func() { _, _ = PeakRMS(src) }},
+		{"Clip", func() { Clip(dst, 0.8) }},
+		{"GainApplyBuffer", func() { gain.ApplyBuffer(dst, 0.999) }},
+	}
+
+	previous := simd.SetAccelerated(true)
+	defer simd.SetAccelerated(previous)
+
+	for _, level := range []bool{true, false} {
+		simd.SetAccelerated(level)
+		name := AccelerationLevel()
+		for _, k := range kernels {
+			b.Run(k.name+"_"+name, func(b *testing.B) {
+				b.SetBytes(int64(len(src) * 4))
+				for i := 0; i < b.N; i++ {
+					k.fn()
+				}
+			})
+		}
 	}
 }
 
@@ -83,21 +130,21 @@ func BenchmarkBufferOperations(b *testing.B) {
 			src[i] = float32(math.Sin(float64(i) * 0.1))
 		}
 
-		b.Run("Clear_"+string(rune(size)), func(b *testing.B) {
+		b.Run("Clear_"+strconv.Itoa(size), func(b *testing.B) {
 			b.SetBytes(int64(size * 4))
 			for i := 0; i < b.N; i++ {
 				Clear(buffer)
 			}
 		})
 
-		b.Run("Copy_"+string(rune(size)), func(b *testing.B) {
+		b.Run("Copy_"+strconv.Itoa(size), func(b *testing.B) {
 			b.SetBytes(int64(size * 4))
 			for i := 0; i < b.N; i++ {
 				Copy(buffer, src)
 			}
 		})
 
-		b.Run("Scale_"+string(rune(size)), func(b *testing.B) {
+		b.Run("Scale_"+strconv.Itoa(size), func(b *testing.B) {
 			b.SetBytes(int64(size * 4))
 			copy(buffer, src)
 			for i := 0; i < b.N; i++ {
@@ -204,6 +251,12 @@ func BenchmarkAllocationCheck(b *testing.B) {
 		{"AddScaled", func() {
 			AddScaled(buffer, src, 0.5)
 		}},
+		{"GainApplyTo", func() {
+			gain.ApplyBufferTo(src, 0.5, buffer)
+		}},
+		{"PeakRMS", func() {
+			_, _ = PeakRMS(buffer)
+		}},
 		{"ParameterScale", func() {
 			_ = utility.ScaleParameter(0.5, -60.0, 0.0)
 		}},
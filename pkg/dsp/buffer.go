@@ -1,9 +1,20 @@
 // Package dsp provides digital signal processing utilities for audio
 package dsp
 
-import "math"
+import (
+	"math"
 
-// Buffer utilities for common audio operations
+	"github.com/justyntemme/vst3go/pkg/dsp/internal/simd"
+)
+
+// Buffer utilities for common audio operations. The arithmetic kernels use
+// SIMD instructions when the CPU supports them (see AccelerationLevel).
+
+// AccelerationLevel names the instruction set the buffer kernels run on,
+// "avx2" or "generic"
+func AccelerationLevel() string {
+	return simd.Level()
+}
 
 // Clear zeroes a buffer - no allocations
 func Clear(buffer []float32) {
@@ -19,58 +30,80 @@ func Copy(dst, src []float32) {
 
 // Add adds source to destination - no allocations
 func Add(dst, src []float32) {
-	n := len(dst)
-	if len(src) < n {
-		n = len(src)
-	}
-	for i := 0; i < n; i++ {
-		dst[i] += src[i]
-	}
+	simd.Add(dst, src)
 }
 
 // AddScaled adds scaled source to destination - no allocations
 func AddScaled(dst, src []float32, scale float32) {
-	n := len(dst)
-	if len(src) < n {
-		n = len(src)
-	}
-	for i := 0; i < n; i++ {
-		dst[i] += src[i] * scale
-	}
+	simd.ScaleAdd(dst, src, scale)
 }
 
 // Scale multiplies buffer by a constant - no allocations
 func Scale(buffer []float32, scale float32) {
-	for i := range buffer {
-		buffer[i] *= scale
-	}
+	simd.Scale(buffer, scale)
+}
+
+// ScaleTo writes src multiplied by a constant into dst - no allocations
+func ScaleTo(dst, src []float32, scale float32) {
+	simd.ScaleTo(dst, src, scale)
+}
+
+// ScaleStereo applies separate gains to the two channels of a stereo pair
+func ScaleStereo(left, right []float32, gainL, gainR float32) {
+	simd.Scale(left, gainL)
+	simd.Scale(right, gainR)
 }
 
 // Mix blends two buffers with a mix factor (0=all src1, 1=all src2)
 func Mix(dst, src1, src2 []float32, mix float32) {
-	n := len(dst)
-	if len(src1) < n {
-		n = len(src1)
+	simd.Mix(dst, src1, src2, 1.0-mix, mix)
+}
+
+// MixGains writes src1*gain1 + src2*gain2 into dst - no allocations
+func MixGains(dst, src1, src2 []float32, gain1, gain2 float32) {
+	simd.Mix(dst, src1, src2, gain1, gain2)
+}
+
+// Interleave writes a stereo pair into dst as LRLR... frames. dst must hold
+// 2*len(left) samples.
+func Interleave(dst, left, right []float32) {
+	n := len(left)
+	if len(right) < n {
+		n = len(right)
 	}
-	if len(src2) < n {
-		n = len(src2)
+	if len(dst)/2 < n {
+		n = len(dst) / 2
 	}
+	dst = dst[:2*n]
+	left = left[:n]
+	right = right[:n]
+	for i := range left {
+		dst[2*i] = left[i]
+		dst[2*i+1] = right[i]
+	}
+}
 
-	invMix := 1.0 - mix
-	for i := 0; i < n; i++ {
-		dst[i] = src1[i]*invMix + src2[i]*mix
+// Deinterleave splits LRLR... frames from src into a stereo pair
+func Deinterleave(left, right, src []float32) {
+	n := len(src) / 2
+	if len(left) < n {
+		n = len(left)
+	}
+	if len(right) < n {
+		n = len(right)
+	}
+	src = src[:2*n]
+	left = left[:n]
+	right = right[:n]
+	for i := range left {
+		left[i] = src[2*i]
+		right[i] = src[2*i+1]
 	}
 }
 
 // Peak finds the maximum absolute value in a buffer
 func Peak(buffer []float32) float32 {
-	peak := float32(0)
-	for _, sample := range buffer {
-		abs := float32(math.Abs(float64(sample)))
-		if abs > peak {
-			peak = abs
-		}
-	}
+	peak, _ := simd.PeakSumSquares(buffer)
 	return peak
 }
 
@@ -80,27 +113,39 @@ func RMS(buffer []float32) float32 {
 		return 0
 	}
 
-	sum := float32(0)
-	for _, sample := range buffer {
-		sum += sample * sample
+	_, sum := simd.PeakSumSquares(buffer)
+	return float32(math.Sqrt(float64(sum / float32(len(buffer)))))
+}
+
+// PeakRMS returns the peak and RMS of a buffer in a single pass, for meters
+// that report both
+func PeakRMS(buffer []float32) (peak, rms float32) {
+	if len(buffer) == 0 {
+		return 0, 0
 	}
+	peak, sum := simd.PeakSumSquares(buffer)
+	return peak, float32(math.Sqrt(float64(sum / float32(len(buffer)))))
+}
 
-	return float32(math.Sqrt(float64(sum / float32(len(buffer)))))
+// PeakRMSStereo returns the peak and RMS of a stereo pair, each channel
+// measured in one pass
+func PeakRMSStereo(left, right []float32) (peakL, peakR, rmsL, rmsR float32) {
+	peakL, rmsL = PeakRMS(left)
+	peakR, rmsR = PeakRMS(right)
+	return peakL, peakR, rmsL, rmsR
 }
 
 // Clip limits samples to [-limit, limit]
 func Clip(buffer []float32, limit float32) {
-	for i := range buffer {
-		if buffer[i] > limit {
-			buffer[i] = limit
-		} else if buffer[i] < -limit {
-			buffer[i] = -limit
-		}
-	}
+	simd.Clamp(buffer, -limit, limit)
 }
 
-// SoftClip applies soft saturation to limit peaks
+// SoftClip applies soft saturation to limit peaks. Buffers that stay below
+// the threshold are left untouched after a single vectorized peak scan.
 func SoftClip(buffer []float32, threshold float32) {
+	if Peak(buffer) <= threshold {
+		return
+	}
 	for i := range buffer {
 		sample := buffer[i]
 		if sample > threshold {
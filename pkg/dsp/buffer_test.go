@@ -0,0 +1,59 @@
+package dsp
+
+import "testing"
+
+func TestInterleave(t *testing.T) {
+	left := []float32{1, 2, 3}
+	right := []float32{-1, -2, -3}
+	frames := make([]float32, 6)
+
+	Interleave(frames, left, right)
+	want := []float32{1, -1, 2, -2, 3, -3}
+	for i := range want {
+		if frames[i] != want[i] {
+			t.Fatalf("Interleave: sample %d got %f, want %f", i, frames[i], want[i])
+		}
+	}
+
+	gotL := make([]float32, 3)
+	gotR := make([]float32, 3)
+	Deinterleave(gotL, gotR, frames)
+	for i := range left {
+		if gotL[i] != left[i] || gotR[i] != right[i] {
+			t.Fatalf("Deinterleave: frame %d got (%f, %f)", i, gotL[i], gotR[i])
+		}
+	}
+}
+
+func TestPeakRMS(t *testing.T) {
+	buffer := make([]float32, 100)
+	for i := range buffer {
+		buffer[i] = 0.5
+	}
+	buffer[37] = -0.9
+
+	peak, rms := PeakRMS(buffer)
+	if peak != 0.9 {
+		t.Errorf("Expected peak 0.9, got %f", peak)
+	}
+	if rms != RMS(buffer) {
+		t.Errorf("PeakRMS rms %f disagrees with RMS %f", rms, RMS(buffer))
+	}
+	if peak != Peak(buffer) {
+		t.Errorf("PeakRMS peak %f disagrees with Peak %f", peak, Peak(buffer))
+	}
+}
+
+func TestSoftClipBelowThreshold(t *testing.T) {
+	buffer := []float32{0.1, -0.2, 0.3}
+	SoftClip(buffer, 0.5)
+	if buffer[0] != 0.1 || buffer[1] != -0.2 || buffer[2] != 0.3 {
+		t.Errorf("SoftClip changed samples below threshold: %v", buffer)
+	}
+
+	buffer[2] = 0.9
+	SoftClip(buffer, 0.5)
+	if buffer[2] >= 0.9 || buffer[2] <= 0.5 {
+		t.Errorf("SoftClip should saturate 0.9, got %f", buffer[2])
+	}
+}
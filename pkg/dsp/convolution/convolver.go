@@ -0,0 +1,352 @@
+// Package convolution provides zero-latency partitioned convolution for
+// impulse-response reverbs and cabinet simulation.
+package convolution
+
+import (
+	"runtime"
+	"sync"
+	"sync/atomic"
+
+	"github.com/justyntemme/vst3go/pkg/dsp/analysis"
+	"github.com/justyntemme/vst3go/pkg/dsp/resample"
+	"github.com/justyntemme/vst3go/pkg/dsp/sample"
+)
+
+const (
+	// DefaultPartitionSize is the head partition length in samples
+	DefaultPartitionSize = 64
+
+	// tailRatio is the size of a tail partition relative to the head
+	tailRatio = 16
+)
+
+// Convolver convolves a mono signal with an impulse response at zero latency
+// using a non-uniform partition:
+//
+//   - the first partition of the response runs as a direct-form FIR, so
+//     every output sample has its earliest taps applied immediately
+//   - the rest of the first 2*tail samples run through uniformly
+//     partitioned overlap-save at the head partition size
+//   - the remainder runs through overlap-save with partitions tailRatio
+//     times larger, on a background goroutine once StartWorker is called
+//
+// Each section starts exactly where the latency of its overlap-save stage
+// has elapsed, so the sections add up to the plain convolution. A tail block
+// is handed to the worker when its input is complete and collected one tail
+// block later, giving the worker a full block period to finish.
+//
+// Impulse responses are loaded with LoadIR from any non-audio thread; the
+// audio thread switches to a new response at its next partition boundary.
+type Convolver struct {
+	sampleRate    float64
+	partitionSize int // Head and middle partition size (B)
+	tailSize      int // Tail partition size (P)
+	tailStart     int // First tap handled by the tail stage (2P)
+	maxLength     int
+
+	kernel  atomic.Pointer[kernel]
+	current *kernel // Kernel in use by the audio thread
+
+	// Direct-form head
+	history []float64
+	histPos int
+
+	// Uniform middle stage, processed inline
+	middle    *uniformStage
+	middleIn  []float64
+	middleOut []float64
+	middlePos int
+
+	// Uniform tail stage, processed one tail block behind
+	tail       *uniformStage
+	tailIn     []float64
+	tailPos    int
+	tailPlay   []float64 // Output being played this tail block
+	tailReady  []float64 // Output the pending job writes
+	tailJob    []float64 // Input of the pending job
+	jobKernel  *kernel
+	jobPending bool
+
+	wake    chan struct{}
+	pending sync.WaitGroup
+}
+
+// kernel is an impulse response prepared for each stage. It is immutable
+// once published.
+type kernel struct {
+	length int
+	head   []float64
+	middle partitionSpectra
+	tail   partitionSpectra
+}
+
+// New creates a convolver for impulse responses of up to maxLength samples at
+// sampleRate. partitionSize (rounded up to a power of two, at least 16) sets
+// the head length; 0 selects DefaultPartitionSize. Everything the audio
+// thread touches is allocated here.
+func New(sampleRate float64, partitionSize, maxLength int) *Convolver {
+	if partitionSize <= 0 {
+		partitionSize = DefaultPartitionSize
+	}
+	size := 16
+	for size < partitionSize {
+		size <<= 1
+	}
+	if maxLength < 1 {
+		maxLength = 1
+	}
+
+	c := &Convolver{
+		sampleRate:    sampleRate,
+		partitionSize: size,
+		tailSize:      size * tailRatio,
+		tailStart:     2 * size * tailRatio,
+		maxLength:     maxLength,
+		history:       make([]float64, 2*size),
+		middleIn:      make([]float64, size),
+		middleOut:     make([]float64, size),
+	}
+
+	middleEnd := maxLength
+	if middleEnd > c.tailStart {
+		middleEnd = c.tailStart
+	}
+	c.middle = newUniformStage(size, (middleEnd-size+size-1)/size)
+
+	if maxLength > c.tailStart {
+		parts := (maxLength - c.tailStart + c.tailSize - 1) / c.tailSize
+		c.tail = newUniformStage(c.tailSize, parts)
+		c.tailIn = make([]float64, c.tailSize)
+		c.tailPlay = make([]float64, c.tailSize)
+		c.tailReady = make([]float64, c.tailSize)
+		c.tailJob = make([]float64, c.tailSize)
+	}
+
+	c.current = c.buildKernel(nil)
+	c.kernel.Store(c.current)
+	return c
+}
+
+// Latency returns the processing delay in samples, which is always zero
+func (c *Convolver) Latency() int {
+	return 0
+}
+
+// PartitionSize returns the head partition size in samples
+func (c *Convolver) PartitionSize() int {
+	return c.partitionSize
+}
+
+// MaxLength returns the longest impulse response the convolver accepts
+func (c *Convolver) MaxLength() int {
+	return c.maxLength
+}
+
+// Length returns the length of the loaded impulse response in samples
+func (c *Convolver) Length() int {
+	return c.kernel.Load().length
+}
+
+// LoadIR prepares ir, recorded at irSampleRate, and publishes it to the audio
+// thread. Responses at another rate are resampled to the convolver's rate
+// (pass 0 to skip), and anything beyond MaxLength is dropped. Call it from a
+// non-audio thread: preparation allocates and transforms the whole response.
+func (c *Convolver) LoadIR(ir []float32, irSampleRate float64) {
+	data := make([]float64, len(ir))
+	for i, v := range ir {
+		data[i] = float64(v)
+	}
+	if irSampleRate > 0 && irSampleRate != c.sampleRate {
+		data = resampleIR(data, irSampleRate, c.sampleRate)
+	}
+	if len(data) > c.maxLength {
+		data = data[:c.maxLength]
+	}
+	c.kernel.Store(c.buildKernel(data))
+}
+
+// buildKernel splits an impulse response over the stages. It uses its own
+// transforms so it never shares state with the audio thread.
+func (c *Convolver) buildKernel(ir []float64) *kernel {
+	k := &kernel{
+		length: len(ir),
+		head:   make([]float64, c.partitionSize),
+	}
+	copy(k.head, ir)
+
+	middleEnd := len(ir)
+	if middleEnd > c.tailStart {
+		middleEnd = c.tailStart
+	}
+	if middleEnd > c.partitionSize {
+		fft := analysis.NewRealFFT(2 * c.partitionSize)
+		k.middle = newPartitionSpectra(fft, ir[c.partitionSize:middleEnd], c.partitionSize)
+	}
+	if c.tail != nil && len(ir) > c.tailStart {
+		fft := analysis.NewRealFFT(2 * c.tailSize)
+		k.tail = newPartitionSpectra(fft, ir[c.tailStart:], c.tailSize)
+	}
+	return k
+}
+
+// StartWorker moves tail processing to a goroutine locked to its own OS
+// thread. Call it at setup time; without it the tail runs inline at each
+// tail partition boundary.
+func (c *Convolver) StartWorker() {
+	if c.tail == nil || c.wake != nil {
+		return
+	}
+	c.wake = make(chan struct{}, 1)
+	go c.runWorker(c.wake)
+}
+
+// StopWorker stops the tail goroutine. It must not be called concurrently
+// with Process.
+func (c *Convolver) StopWorker() {
+	if c.wake == nil {
+		return
+	}
+	if c.jobPending {
+		c.pending.Wait()
+	}
+	close(c.wake)
+	c.wake = nil
+}
+
+func (c *Convolver) runWorker(wake chan struct{}) {
+	runtime.LockOSThread()
+	defer runtime.UnlockOSThread()
+
+	for range wake {
+		c.runTailJob()
+		c.pending.Done()
+	}
+}
+
+func (c *Convolver) runTailJob() {
+	c.tail.process(c.tailJob, &c.jobKernel.tail, c.tailReady)
+}
+
+// Process convolves input into output - no allocations. input and output
+// may be the same slice; blocks can be any length.
+func (c *Convolver) Process(input, output []float32) {
+	convolve(c, input, output)
+}
+
+// Process64 is the double-precision version of Process
+func (c *Convolver) Process64(input, output []float64) {
+	convolve(c, input, output)
+}
+
+func convolve[T sample.Float](c *Convolver, input, output []T) {
+	output = output[:len(input)]
+	k := c.current
+	head := k.head
+
+	for i, x := range input {
+		// Switch impulse responses only between partitions
+		if c.middlePos == 0 {
+			if next := c.kernel.Load(); next != k {
+				c.current = next
+				k = next
+				head = k.head
+			}
+		}
+		xd := float64(x)
+
+		window := push(c.history, &c.histPos, xd)
+		window = window[:len(head)]
+		y := 0.0
+		for j, h := range head {
+			y += h * window[j]
+		}
+
+		y += c.middleOut[c.middlePos]
+		c.middleIn[c.middlePos] = xd
+		c.middlePos++
+
+		if c.tail != nil {
+			y += c.tailPlay[c.tailPos]
+			c.tailIn[c.tailPos] = xd
+			c.tailPos++
+		}
+		output[i] = T(y)
+
+		if c.middlePos == c.partitionSize {
+			c.middle.process(c.middleIn, &k.middle, c.middleOut)
+			c.middlePos = 0
+		}
+		if c.tail != nil && c.tailPos == c.tailSize {
+			c.tailBoundary(k)
+			c.tailPos = 0
+		}
+	}
+}
+
+// tailBoundary collects the previous tail job and starts the next one
+func (c *Convolver) tailBoundary(k *kernel) {
+	if c.jobPending {
+		if c.wake != nil {
+			c.pending.Wait()
+		}
+		c.tailPlay, c.tailReady = c.tailReady, c.tailPlay
+		c.jobPending = false
+	} else {
+		clear(c.tailPlay)
+	}
+
+	copy(c.tailJob, c.tailIn)
+	c.jobKernel = k
+	c.jobPending = true
+	if c.wake != nil {
+		c.pending.Add(1)
+		c.wake <- struct{}{}
+		return
+	}
+	c.runTailJob()
+}
+
+// Reset clears the signal state; the impulse response is kept
+func (c *Convolver) Reset() {
+	if c.jobPending && c.wake != nil {
+		c.pending.Wait()
+	}
+	c.jobPending = false
+
+	clear(c.history)
+	c.histPos = 0
+	c.middle.reset()
+	clear(c.middleOut)
+	c.middlePos = 0
+	if c.tail != nil {
+		c.tail.reset()
+		clear(c.tailPlay)
+		clear(c.tailReady)
+		c.tailPos = 0
+	}
+}
+
+// push writes x as the newest sample of a doubled history and returns the
+// window that starts with it
+func push(history []float64, pos *int, x float64) []float64 {
+	size := len(history) / 2
+	*pos--
+	if *pos < 0 {
+		*pos = size - 1
+	}
+	history[*pos] = x
+	history[*pos+size] = x
+	return history[*pos : *pos+size]
+}
+
+// resampleIR converts an impulse response between sample rates. The
+// response gets ratio times as many samples, so it is scaled to keep its
+// DC gain.
+func resampleIR(ir []float64, from, to float64) []float64 {
+	ratio := to / from
+	out := resample.Convert(ir, ratio, resample.QualityBest)
+	for i := range out {
+		out[i] /= ratio
+	}
+	return out
+}
@@ -0,0 +1,182 @@
+package convolution
+
+import (
+	"math"
+	"math/rand"
+	"testing"
+)
+
+func directConvolution(input, ir []float32) []float64 {
+	out := make([]float64, len(input))
+	for n := range out {
+		for j, h := range ir {
+			if n-j < 0 {
+				break
+			}
+			out[n] += float64(h) * float64(input[n-j])
+		}
+	}
+	return out
+}
+
+func randomSignal(n int, seed int64) []float32 {
+	rng := rand.New(rand.NewSource(seed))
+	x := make([]float32, n)
+	for i := range x {
+		x[i] = float32(rng.NormFloat64() * 0.3)
+	}
+	return x
+}
+
+// decayingIR is a noise burst with an exponential decay, like a room
+func decayingIR(n int) []float32 {
+	ir := randomSignal(n, 7)
+	for i := range ir {
+		ir[i] *= float32(math.Exp(-3 * float64(i) / float64(n)))
+	}
+	return ir
+}
+
+func TestConvolverMatchesDirect(t *testing.T) {
+	const partition = 32
+	tailStart := 2 * partition * tailRatio
+
+	for _, irLength := range []int{1, 20, partition, 300, tailStart, tailStart + 1, 3000} {
+		for _, worker := range []bool{false, true} {
+			ir := decayingIR(irLength)
+			input := randomSignal(6000, 3)
+			want := directConvolution(input, ir)
+
+			c := New(48000, partition, 4096)
+			c.LoadIR(ir, 0)
+			if worker {
+				c.StartWorker()
+			}
+
+			// Irregular host block sizes, processed in place
+			got := append([]float32(nil), input...)
+			for start, step := 0, 1; start < len(got); step = step%97 + 13 {
+				end := start + step
+				if end > len(got) {
+					end = len(got)
+				}
+				c.Process(got[start:end], got[start:end])
+				start = end
+			}
+			c.StopWorker()
+
+			for i := range want {
+				if math.Abs(float64(got[i])-want[i]) > 1e-4 {
+					t.Fatalf("IR %d worker=%v: sample %d got %f, want %f", irLength, worker, i, got[i], want[i])
+				}
+			}
+		}
+	}
+}
+
+func TestConvolverZeroLatency(t *testing.T) {
+	c := New(48000, 64, 8192)
+	ir := make([]float32, 5000)
+	ir[0] = 1
+	ir[4999] = 0.5
+	c.LoadIR(ir, 0)
+
+	impulse := make([]float32, 6000)
+	impulse[0] = 1
+	out := make([]float32, len(impulse))
+	c.Process(impulse, out)
+
+	if c.Latency() != 0 || out[0] != 1 {
+		t.Errorf("Expected the direct tap at sample 0, got %f", out[0])
+	}
+	if math.Abs(float64(out[4999])-0.5) > 1e-6 {
+		t.Errorf("Expected the late tap at sample 4999, got %f", out[4999])
+	}
+}
+
+func TestConvolverSwapsIR(t *testing.T) {
+	c := New(48000, 64, 1024)
+	c.LoadIR([]float32{1}, 0)
+
+	input := randomSignal(512, 1)
+	out := make([]float32, 512)
+	c.Process(input, out)
+
+	c.LoadIR([]float32{0, 0.5}, 0)
+	if c.Length() != 2 {
+		t.Errorf("Expected length 2, got %d", c.Length())
+	}
+	c.Process(input, out)
+
+	// The new response applies from the next partition boundary on
+	for i := 64; i < len(out); i++ {
+		want := 0.5 * input[i-1]
+		if math.Abs(float64(out[i]-want)) > 1e-5 {
+			t.Fatalf("Sample %d: got %f, want %f", i, out[i], want)
+		}
+	}
+}
+
+func TestLoadIRResamples(t *testing.T) {
+	c := New(48000, 64, 4096)
+	ir := make([]float32, 441)
+	for i := range ir {
+		ir[i] = 1.0 / 441 // Unity DC gain spread over 10 ms
+	}
+	c.LoadIR(ir, 44100)
+
+	if got := c.Length(); got != 480 {
+		t.Errorf("Expected 480 samples at 48 kHz, got %d", got)
+	}
+
+	dc := make([]float32, 2048)
+	for i := range dc {
+		dc[i] = 1
+	}
+	out := make([]float32, len(dc))
+	c.Process(dc, out)
+	if math.Abs(float64(out[len(out)-1])-1) > 0.01 {
+		t.Errorf("Resampling should keep the DC gain, got %f", out[len(out)-1])
+	}
+}
+
+func TestConvolverZeroAllocations(t *testing.T) {
+	c := New(48000, 64, 48000)
+	c.LoadIR(decayingIR(48000), 0)
+	c.StartWorker()
+	defer c.StopWorker()
+
+	block := randomSignal(256, 5)
+	allocs := testing.AllocsPerRun(100, func() {
+		c.Process(block, block)
+	})
+	if allocs != 0 {
+		t.Errorf("Process allocated %.1f times", allocs)
+	}
+}
+
+func BenchmarkConvolver(b *testing.B) {
+	for _, seconds := range []float64{0.1, 1, 3} {
+		length := int(seconds * 48000)
+		c := New(48000, 64, length)
+		c.LoadIR(decayingIR(length), 0)
+		block := randomSignal(256, 5)
+
+		b.Run(formatSeconds(seconds), func(b *testing.B) {
+			for i := 0; i < b.N; i++ {
+				c.Process(block, block)
+			}
+		})
+	}
+}
+
+func formatSeconds(s float64) string {
+	switch s {
+	case 0.1:
+		return "IR100ms"
+	case 1:
+		return "IR1s"
+	default:
+		return "IR3s"
+	}
+}
@@ -0,0 +1,127 @@
+package convolution
+
+import "github.com/justyntemme/vst3go/pkg/dsp/analysis"
+
+// partitionSpectra holds the spectra of an impulse-response section cut into
+// equal partitions, each zero-padded to twice the partition size
+type partitionSpectra struct {
+	parts  int
+	re, im []float64 // parts * bins, partition-major
+}
+
+// newPartitionSpectra transforms ir in partitions of size samples
+func newPartitionSpectra(fft *analysis.RealFFT, ir []float64, size int) partitionSpectra {
+	bins := fft.Bins()
+	parts := (len(ir) + size - 1) / size
+	s := partitionSpectra{
+		parts: parts,
+		re:    make([]float64, parts*bins),
+		im:    make([]float64, parts*bins),
+	}
+	for p := 0; p < parts; p++ {
+		end := (p + 1) * size
+		if end > len(ir) {
+			end = len(ir)
+		}
+		fft.Forward(ir[p*size:end], s.re[p*bins:(p+1)*bins], s.im[p*bins:(p+1)*bins])
+	}
+	return s
+}
+
+// uniformStage is a uniformly partitioned overlap-save convolver. Each
+// processed block is transformed once into a frequency-domain delay line;
+// the output is the sum of every delayed input spectrum times its
+// partition's spectrum, so the cost per block grows with the partition count
+// but not with the partition size.
+type uniformStage struct {
+	size int
+	fft  *analysis.RealFFT
+	bins int
+
+	window []float64 // Previous and current input blocks
+
+	// Frequency-domain delay line of input spectra, newest at fdlPos
+	fdlRe, fdlIm []float64
+	fdlParts     int
+	fdlPos       int
+
+	accRe, accIm []float64
+	timeOut      []float64
+}
+
+func newUniformStage(size, maxParts int) *uniformStage {
+	fft := analysis.NewRealFFT(2 * size)
+	bins := fft.Bins()
+	if maxParts < 1 {
+		maxParts = 1
+	}
+	return &uniformStage{
+		size:     size,
+		fft:      fft,
+		bins:     bins,
+		window:   make([]float64, 2*size),
+		fdlRe:    make([]float64, maxParts*bins),
+		fdlIm:    make([]float64, maxParts*bins),
+		fdlParts: maxParts,
+		accRe:    make([]float64, bins),
+		accIm:    make([]float64, bins),
+		timeOut:  make([]float64, 2*size),
+	}
+}
+
+// process convolves the next input block (size samples) with spectra and
+// writes size output samples. The output is the linear convolution for the
+// same time span as block.
+func (u *uniformStage) process(block []float64, spectra *partitionSpectra, out []float64) {
+	size, bins := u.size, u.bins
+
+	// Slide the overlap-save window and transform it into the delay line
+	copy(u.window, u.window[size:])
+	copy(u.window[size:], block)
+	u.fdlPos--
+	if u.fdlPos < 0 {
+		u.fdlPos = u.fdlParts - 1
+	}
+	pos := u.fdlPos
+	u.fft.Forward(u.window, u.fdlRe[pos*bins:(pos+1)*bins], u.fdlIm[pos*bins:(pos+1)*bins])
+
+	parts := spectra.parts
+	if parts > u.fdlParts {
+		parts = u.fdlParts
+	}
+	if parts == 0 {
+		// The delay line is still kept current for the next impulse response
+		clear(out[:size])
+		return
+	}
+	accRe, accIm := u.accRe, u.accIm
+	for k := range accRe {
+		accRe[k], accIm[k] = 0, 0
+	}
+
+	// Partition p meets the input spectrum from p blocks ago
+	for p := 0; p < parts; p++ {
+		slot := (pos + p) % u.fdlParts
+		xr := u.fdlRe[slot*bins : (slot+1)*bins]
+		xi := u.fdlIm[slot*bins : (slot+1)*bins]
+		hr := spectra.re[p*bins : (p+1)*bins]
+		hi := spectra.im[p*bins : (p+1)*bins]
+		xi, hr, hi = xi[:len(xr)], hr[:len(xr)], hi[:len(xr)]
+		ar, ai := accRe[:len(xr)], accIm[:len(xr)]
+		for k := range xr {
+			ar[k] += xr[k]*hr[k] - xi[k]*hi[k]
+			ai[k] += xr[k]*hi[k] + xi[k]*hr[k]
+		}
+	}
+
+	u.fft.Inverse(accRe, accIm, u.timeOut)
+	// The first half holds circular wrap-around; the second half is valid
+	copy(out[:size], u.timeOut[size:])
+}
+
+func (u *uniformStage) reset() {
+	clear(u.window)
+	clear(u.fdlRe)
+	clear(u.fdlIm)
+	u.fdlPos = 0
+}
@@ -0,0 +1,190 @@
+// Package crossover provides Linkwitz-Riley band splitting for multiband processing
+package crossover
+
+import (
+	"math"
+
+	"github.com/justyntemme/vst3go/pkg/dsp/filter"
+	"github.com/justyntemme/vst3go/pkg/dsp/sample"
+)
+
+// Order selects the slope of the crossover filters
+type Order int
+
+const (
+	// LR4 is a 4th-order (24 dB/octave) Linkwitz-Riley crossover
+	LR4 Order = iota
+	// LR8 is an 8th-order (48 dB/octave) Linkwitz-Riley crossover
+	LR8
+)
+
+// butterworthQ returns the section Qs of the Butterworth filter an order's
+// Linkwitz-Riley response is the square of
+func (o Order) butterworthQ() []float64 {
+	if o == LR8 {
+		return []float64{0.54119610, 1.30656296}
+	}
+	return []float64{math.Sqrt2 / 2}
+}
+
+// Crossover is the 32-bit crossover used by most processors
+type Crossover = CrossoverOf[float32]
+
+// Crossover64 is the double-precision crossover for kSample64 processing
+type Crossover64 = CrossoverOf[float64]
+
+// CrossoverOf splits N channels into len(frequencies)+1 bands that sum back
+// to an allpass response of the input.
+//
+// Band k is split off the remainder above the previous split: a lowpass
+// takes band k and a highpass passes the rest on. Each Linkwitz-Riley
+// lowpass/highpass pair sums to the allpass of its split, so every band
+// below a split runs through that allpass too, and all bands arrive in
+// phase at the sum.
+//
+// Every filter stage is a filter.BiquadBankOf over all channels, so the
+// whole tree runs as block kernels with channel pairs in lockstep.
+type CrossoverOf[T sample.Float] struct {
+	sampleRate  float64
+	channels    int
+	order       Order
+	frequencies []float64
+
+	lowpass  []*filter.BiquadBankOf[T] // One per split
+	highpass []*filter.BiquadBankOf[T] // One per split
+	allpass  []*filter.BiquadBankOf[T] // Per band: allpasses of every split above it
+}
+
+// New creates a crossover for channels channels with one split per frequency,
+// which must be ascending
+func New(sampleRate float64, channels int, order Order, frequencies ...float64) *Crossover {
+	return NewOf[float32](sampleRate, channels, order, frequencies...)
+}
+
+// New64 creates a double-precision crossover
+func New64(sampleRate float64, channels int, order Order, frequencies ...float64) *Crossover64 {
+	return NewOf[float64](sampleRate, channels, order, frequencies...)
+}
+
+// NewOf creates a crossover for either sample format
+func NewOf[T sample.Float](sampleRate float64, channels int, order Order, frequencies ...float64) *CrossoverOf[T] {
+	splits := len(frequencies)
+	sections := len(order.butterworthQ())
+	x := &CrossoverOf[T]{
+		sampleRate:  sampleRate,
+		channels:    channels,
+		order:       order,
+		frequencies: append([]float64(nil), frequencies...),
+		lowpass:     make([]*filter.BiquadBankOf[T], splits),
+		highpass:    make([]*filter.BiquadBankOf[T], splits),
+	}
+	for k := 0; k < splits; k++ {
+		x.lowpass[k] = filter.NewBiquadBankOf[T](channels, 2*sections)
+		x.highpass[k] = filter.NewBiquadBankOf[T](channels, 2*sections)
+	}
+	// The two top bands leave no split above their own lowpass to compensate
+	for band := 0; band+1 < splits; band++ {
+		x.allpass = append(x.allpass, filter.NewBiquadBankOf[T](channels, (splits-band-1)*sections))
+	}
+	for k := range frequencies {
+		x.design(k)
+	}
+	return x
+}
+
+// design sets the filters of split k from its frequency
+func (x *CrossoverOf[T]) design(k int) {
+	qs := x.order.butterworthQ()
+	f := x.frequencies[k]
+	for i, q := range qs {
+		// Linkwitz-Riley: the Butterworth response applied twice
+		x.lowpass[k].SetLowpass(i, x.sampleRate, f, q)
+		x.lowpass[k].SetLowpass(i+len(qs), x.sampleRate, f, q)
+		x.highpass[k].SetHighpass(i, x.sampleRate, f, q)
+		x.highpass[k].SetHighpass(i+len(qs), x.sampleRate, f, q)
+	}
+	for band := 0; band < k && band < len(x.allpass); band++ {
+		first := (k - band - 1) * len(qs)
+		for i, q := range qs {
+			x.allpass[band].SetAllpass(first+i, x.sampleRate, f, q)
+		}
+	}
+}
+
+// Bands returns the number of output bands
+func (x *CrossoverOf[T]) Bands() int {
+	return len(x.frequencies) + 1
+}
+
+// Channels returns the number of channels
+func (x *CrossoverOf[T]) Channels() int {
+	return x.channels
+}
+
+// Frequency returns the frequency of split k in Hz
+func (x *CrossoverOf[T]) Frequency(k int) float64 {
+	return x.frequencies[k]
+}
+
+// SetFrequency moves split k. Keep the splits ascending; the lowpass of a
+// split must sit below the next split for the bands to stay apart.
+func (x *CrossoverOf[T]) SetFrequency(k int, hz float64) {
+	if x.frequencies[k] == hz {
+		return
+	}
+	x.frequencies[k] = hz
+	x.design(k)
+}
+
+// SetSmoothing sets how many samples frequency changes ramp over, so an
+// automated split moves without zipper noise
+func (x *CrossoverOf[T]) SetSmoothing(samples int) {
+	for _, banks := range [][]*filter.BiquadBankOf[T]{x.lowpass, x.highpass, x.allpass} {
+		for _, b := range banks {
+			b.SetSmoothing(samples)
+		}
+	}
+}
+
+// Reset clears the filter state
+func (x *CrossoverOf[T]) Reset() {
+	for _, banks := range [][]*filter.BiquadBankOf[T]{x.lowpass, x.highpass, x.allpass} {
+		for _, b := range banks {
+			b.Reset()
+		}
+	}
+}
+
+// Process splits input into bands - no allocations. bands[b][ch] receives
+// band b (lowest first) of channel ch and must be exactly as long as the
+// input block. The input may be one of the band buffers; it is read before
+// any band is written.
+func (x *CrossoverOf[T]) Process(input [][]T, bands [][][]T) {
+	if len(input) == 0 || len(bands) < x.Bands() {
+		return
+	}
+	n := len(input[0])
+	channels := len(input)
+	if channels > x.channels {
+		channels = x.channels
+	}
+
+	// The top band carries the remainder down the tree
+	rest := bands[len(x.frequencies)][:channels]
+	for ch := range rest {
+		copy(rest[ch], input[ch][:n])
+	}
+
+	for k := range x.frequencies {
+		low := bands[k][:channels]
+		for ch := range low {
+			copy(low[ch], rest[ch])
+		}
+		x.lowpass[k].Process(low)
+		x.highpass[k].Process(rest)
+	}
+
+	for band, ap := range x.allpass {
+		ap.Process(bands[band][:channels])
+	}
+}
@@ -0,0 +1,162 @@
+package crossover
+
+import (
+	"math"
+	"testing"
+
+	"github.com/justyntemme/vst3go/pkg/dsp/filter"
+)
+
+func testSignal(n int, seed float64) []float64 {
+	signal := make([]float64, n)
+	for i := range signal {
+		signal[i] = math.Sin(float64(i)*0.05*seed) + 0.3*math.Sin(float64(i)*0.9) + 0.2*math.Sin(float64(i)*2.1)
+	}
+	return signal
+}
+
+func makeBands(bands, channels, n int) [][][]float64 {
+	out := make([][][]float64, bands)
+	for b := range out {
+		out[b] = make([][]float64, channels)
+		for ch := range out[b] {
+			out[b][ch] = make([]float64, n)
+		}
+	}
+	return out
+}
+
+func TestCrossoverSumsToAllpass(t *testing.T) {
+	const sampleRate = 48000
+	frequencies := []float64{200, 1500, 6000}
+
+	for _, order := range []Order{LR4, LR8} {
+		x := New64(sampleRate, 2, order, frequencies...)
+		if x.Bands() != 4 {
+			t.Fatalf("Expected 4 bands, got %d", x.Bands())
+		}
+
+		// The bands must sum to the input through the allpass of every split
+		qs := order.butterworthQ()
+		reference := filter.NewBiquadBank64(2, len(frequencies)*len(qs))
+		for k, f := range frequencies {
+			for i, q := range qs {
+				reference.SetAllpass(k*len(qs)+i, sampleRate, f, q)
+			}
+		}
+
+		bands := makeBands(x.Bands(), 2, 256)
+		for block := 0; block < 4; block++ {
+			input := [][]float64{testSignal(256, 1), testSignal(256, 3)}
+			x.Process(input, bands)
+			reference.Process(input)
+
+			for ch := range input {
+				for i := range input[ch] {
+					sum := 0.0
+					for b := range bands {
+						sum += bands[b][ch][i]
+					}
+					if math.Abs(sum-input[ch][i]) > 1e-6 {
+						t.Fatalf("Order %d, block %d, channel %d, sample %d: bands sum to %f, want %f",
+							order, block, ch, i, sum, input[ch][i])
+					}
+				}
+			}
+		}
+	}
+}
+
+func TestCrossoverBandSeparation(t *testing.T) {
+	const sampleRate = 48000
+	x := New64(sampleRate, 1, LR4, 500, 5000)
+	bands := makeBands(x.Bands(), 1, 4800)
+
+	// A 2 kHz tone belongs to the middle band
+	input := make([]float64, 4800)
+	for i := range input {
+		input[i] = math.Sin(2 * math.Pi * 2000 * float64(i) / sampleRate)
+	}
+	x.Process([][]float64{input}, bands)
+
+	rms := func(buffer []float64) float64 {
+		sum := 0.0
+		for _, v := range buffer[2400:] {
+			sum += v * v
+		}
+		return math.Sqrt(sum / float64(len(buffer)-2400))
+	}
+	low, mid, high := rms(bands[0][0]), rms(bands[1][0]), rms(bands[2][0])
+	if mid < 0.6 {
+		t.Errorf("Middle band should carry the tone: rms %f", mid)
+	}
+	if low > 0.05 || high > 0.1 {
+		t.Errorf("Outer bands should reject the tone: low %f, high %f", low, high)
+	}
+}
+
+func TestCrossoverInPlace(t *testing.T) {
+	x := New64(48000, 1, LR8, 1000)
+	y := New64(48000, 1, LR8, 1000)
+	separate := makeBands(2, 1, 128)
+	shared := makeBands(2, 1, 128)
+
+	input := testSignal(128, 2)
+	copy(shared[1][0], input)
+	x.Process([][]float64{input}, separate)
+	y.Process(shared[1], shared)
+
+	for b := range separate {
+		for i := range separate[b][0] {
+			if separate[b][0][i] != shared[b][0][i] {
+				t.Fatalf("Band %d, sample %d: in-place split differs", b, i)
+			}
+		}
+	}
+}
+
+func TestCrossoverZeroAllocations(t *testing.T) {
+	x := New(48000, 2, LR8, 120, 800, 4000)
+	x.SetSmoothing(256)
+	input := [][]float32{make([]float32, 512), make([]float32, 512)}
+	bands := make([][][]float32, x.Bands())
+	for b := range bands {
+		bands[b] = [][]float32{make([]float32, 512), make([]float32, 512)}
+	}
+
+	allocs := testing.AllocsPerRun(100, func() {
+		x.SetFrequency(1, 900)
+		x.SetFrequency(1, 800)
+		x.Process(input, bands)
+	})
+	if allocs != 0 {
+		t.Errorf("Crossover allocated %.1f times per block", allocs)
+	}
+}
+
+func BenchmarkCrossover(b *testing.B) {
+	for _, order := range []Order{LR4, LR8} {
+		name := "LR4"
+		if order == LR8 {
+			name = "LR8"
+		}
+		b.Run(name, func(b *testing.B) {
+			x := New(48000, 2, order, 120, 800, 4000)
+			input := [][]float32{make([]float32, 512), make([]float32, 512)}
+			for ch := range input {
+				for i := range input[ch] {
+					input[ch][i] = float32(math.Sin(float64(i) * 0.01))
+				}
+			}
+			bands := make([][][]float32, x.Bands())
+			for band := range bands {
+				bands[band] = [][]float32{make([]float32, 512), make([]float32, 512)}
+			}
+
+			b.ResetTimer()
+			for i := 0; i < b.N; i++ {
+				x.Process(input, bands)
+			}
+		})
+	}
+}
@@ -1,107 +1,7 @@
-// Package delay provides delay line implementations for audio effects
 package delay
 
 import "math"
 
-// Line implements a basic delay line with linear interpolation
-type Line struct {
-	buffer     []float32
-	bufferSize int
-	writePos   int
-	sampleRate float64
-}
-
-// New creates a new delay line with the specified maximum delay time
-func New(maxDelaySeconds, sampleRate float64) *Line {
-	bufferSize := int(maxDelaySeconds*sampleRate) + 1
-	return &Line{
-		buffer:     make([]float32, bufferSize),
-		bufferSize: bufferSize,
-		writePos:   0,
-		sampleRate: sampleRate,
-	}
-}
-
-// Reset clears the delay buffer
-func (d *Line) Reset() {
-	for i := range d.buffer {
-		d.buffer[i] = 0
-	}
-	d.writePos = 0
-}
-
-// Write adds a sample to the delay line
-func (d *Line) Write(sample float32) {
-	d.buffer[d.writePos] = sample
-	d.writePos++
-	if d.writePos >= d.bufferSize {
-		d.writePos = 0
-	}
-}
-
-// Read gets a delayed sample (delay in samples)
-func (d *Line) Read(delaySamples float64) float32 {
-	// Calculate read position
-	readPos := float64(d.writePos) - delaySamples
-	if readPos < 0 {
-		readPos += float64(d.bufferSize)
-	}
-
-	// Linear interpolation
-	readPosInt := int(readPos)
-	frac := float32(readPos - float64(readPosInt))
-
-	// Get two samples for interpolation
-	s1 := d.buffer[readPosInt]
-	s2 := d.buffer[(readPosInt+1)%d.bufferSize]
-
-	// Linear interpolation
-	return s1*(1.0-frac) + s2*frac
-}
-
-// ReadMs gets a delayed sample (delay in milliseconds)
-func (d *Line) ReadMs(delayMs float64) float32 {
-	delaySamples := delayMs * d.sampleRate / 1000.0
-	return d.Read(delaySamples)
-}
-
-// Tap reads without writing (for multi-tap delays)
-func (d *Line) Tap(delaySamples float64) float32 {
-	return d.Read(delaySamples)
-}
-
-// Process writes and reads in one operation
-func (d *Line) Process(input float32, delaySamples float64) float32 {
-	output := d.Read(delaySamples)
-	d.Write(input)
-	return output
-}
-
-// ProcessMs writes and reads with delay in milliseconds
-func (d *Line) ProcessMs(input float32, delayMs float64) float32 {
-	delaySamples := delayMs * d.sampleRate / 1000.0
-	return d.Process(input, delaySamples)
-}
-
-// ProcessBuffer processes a buffer with fixed delay - no allocations
-func (d *Line) ProcessBuffer(buffer []float32, delaySamples float64) {
-	for i := range buffer {
-		delayed := d.Read(delaySamples)
-		d.Write(buffer[i])
-		buffer[i] = delayed
-	}
-}
-
-// ProcessBufferMix processes with dry/wet mix - no allocations
-func (d *Line) ProcessBufferMix(buffer []float32, delaySamples float64, mix float32) {
-	dryGain := 1.0 - mix
-	for i := range buffer {
-		dry := buffer[i]
-		wet := d.Process(dry, delaySamples)
-		buffer[i] = dry*dryGain + wet*mix
-	}
-}
-
 // AllpassDelay implements an allpass delay for reverb effects
 type AllpassDelay struct {
 	Line
@@ -222,17 +122,48 @@ func (m *MultiTapDelay) ProcessMultiTap(input float32, taps []TapOutput, outL, o
 
 		tap := &taps[i]
 		delayed := m.Tap(tap.DelaySamples) * tap.Gain
-
-		// Pan (constant power)
-		panAngle := (tap.Pan + 1.0) * 0.25 * math.Pi // 0 to π/2
-		leftGain := float32(math.Cos(float64(panAngle)))
-		rightGain := float32(math.Sin(float64(panAngle)))
+		leftGain, rightGain := tap.panGains()
 
 		*outL += delayed * leftGain
 		*outR += delayed * rightGain
 	}
 }
 
+// ProcessMultiTapBuffer processes a block with multiple taps into stereo
+// outputs - no allocations. The block is written once and every tap reads
+// it back with its pan gains folded into one block read. Block taps use the
+// Process convention: a tap of d samples returns the input d samples ago.
+func (m *MultiTapDelay) ProcessMultiTapBuffer(input, outL, outR []float32, taps []TapOutput) {
+	if len(taps) > m.numTaps {
+		taps = taps[:m.numTaps]
+	}
+	for start := 0; start < len(input); start += m.MaxBlock() {
+		end := start + m.MaxBlock()
+		if end > len(input) {
+			end = len(input)
+		}
+		m.WriteBlock(input[start:end])
+
+		left, right := outL[start:end], outR[start:end]
+		for i := range left {
+			left[i] = 0
+			right[i] = 0
+		}
+		for i := range taps {
+			tap := &taps[i]
+			leftGain, rightGain := tap.panGains()
+			m.AddTap(left, tap.DelaySamples, tap.Gain*leftGain)
+			m.AddTap(right, tap.DelaySamples, tap.Gain*rightGain)
+		}
+	}
+}
+
+// panGains returns the constant-power pan gains of a tap
+func (t *TapOutput) panGains() (left, right float32) {
+	panAngle := (t.Pan + 1.0) * 0.25 * math.Pi // 0 to π/2
+	return float32(math.Cos(float64(panAngle))), float32(math.Sin(float64(panAngle)))
+}
+
 // ModulatedDelay implements a delay with LFO modulation
 type ModulatedDelay struct {
 	Line
@@ -240,8 +171,14 @@ type ModulatedDelay struct {
 	lfoRate     float64
 	lfoDepth    float64
 	centerDelay float64
+
+	delays [modulatedChunk]float32 // One chunk of modulated delay times
 }
 
+// modulatedChunk is how many samples ModulatedDelay.ProcessBuffer
+// modulates per block read
+const modulatedChunk = 64
+
 // NewModulated creates a modulated delay line
 func NewModulated(maxDelaySeconds, sampleRate float64) *ModulatedDelay {
 	return &ModulatedDelay{
@@ -289,9 +226,28 @@ func (m *ModulatedDelay) Process(input float32) float32 {
 	return output
 }
 
-// ProcessBuffer with modulation - no allocations
+// ProcessBuffer with modulation - no allocations. The delay sweep of each
+// chunk is computed first and the chunk read back in one modulated read.
 func (m *ModulatedDelay) ProcessBuffer(buffer []float32) {
-	for i := range buffer {
-		buffer[i] = m.Process(buffer[i])
+	toSamples := m.sampleRate / 1000.0
+	for start := 0; start < len(buffer); start += modulatedChunk {
+		end := start + modulatedChunk
+		if end > len(buffer) {
+			end = len(buffer)
+		}
+		block := buffer[start:end]
+		delays := m.delays[:len(block)]
+		for i := range delays {
+			lfo := math.Sin(2.0 * math.Pi * m.lfoPhase)
+			delays[i] = float32(math.Max((m.centerDelay+m.lfoDepth*lfo)*toSamples, 1.0))
+
+			m.lfoPhase += m.lfoRate / m.sampleRate
+			if m.lfoPhase >= 1.0 {
+				m.lfoPhase -= 1.0
+			}
+		}
+
+		m.WriteBlock(block)
+		m.ReadModulated(block, delays, InterpolationLinear)
 	}
 }
@@ -0,0 +1,273 @@
+// Package delay provides delay line implementations for audio effects
+package delay
+
+import (
+	"github.com/justyntemme/vst3go/pkg/dsp/interpolation"
+)
+
+// Interpolation selects how fractional delays are read
+type Interpolation int
+
+const (
+	// InterpolationLinear blends the two nearest samples
+	InterpolationLinear Interpolation = iota
+	// InterpolationHermite fits a 4-point Hermite curve; cleaner for
+	// modulated delays, delays below 1 sample read as 1
+	InterpolationHermite
+	// InterpolationAllpass runs the nearer sample through a first-order
+	// allpass; flat magnitude, so it suits delays inside feedback loops.
+	// It keeps state, so use it for one delay per line.
+	InterpolationAllpass
+)
+
+// blockHeadroom is the capacity a line adds beyond its maximum delay, so
+// blocks of at least this many samples can be written before they are read
+const blockHeadroom = 64
+
+// Line is a delay line with power-of-two capacity. Positions wrap with a
+// mask instead of a modulo or a branch, and fixed delays move whole blocks
+// with at most two copies.
+//
+// Delays are measured from the write position, so before writing sample n
+// Read(d) returns sample n-d.
+type Line struct {
+	buffer     []float32
+	mask       int
+	writePos   int
+	maxDelay   int
+	sampleRate float64
+
+	allpass interpolation.AllPass // State of InterpolationAllpass reads
+}
+
+// New creates a new delay line with the specified maximum delay time
+func New(maxDelaySeconds, sampleRate float64) *Line {
+	d := NewSamples(int(maxDelaySeconds * sampleRate))
+	d.sampleRate = sampleRate
+	return d
+}
+
+// NewSamples creates a delay line for delays of up to maxDelaySamples
+func NewSamples(maxDelaySamples int) *Line {
+	if maxDelaySamples < 1 {
+		maxDelaySamples = 1
+	}
+	// Interpolation reads up to two samples past the maximum delay
+	size := 1
+	for size < maxDelaySamples+3+blockHeadroom {
+		size <<= 1
+	}
+	d := &Line{
+		buffer:   make([]float32, size),
+		mask:     size - 1,
+		maxDelay: maxDelaySamples,
+	}
+	d.writePos = d.startPosition()
+	return d
+}
+
+// startPosition scatters where lines of different lengths start writing.
+// Buffers of the same power-of-two size map their positions onto the same
+// cache sets, so filters running in lockstep from position 0 would evict
+// each other on every sample.
+func (d *Line) startPosition() int {
+	return (d.maxDelay * 37) & d.mask
+}
+
+// Capacity returns the number of samples the line holds
+func (d *Line) Capacity() int {
+	return len(d.buffer)
+}
+
+// MaxDelay returns the longest delay in samples the line was sized for
+func (d *Line) MaxDelay() int {
+	return d.maxDelay
+}
+
+// MaxBlock returns the longest block that ReadModulated and the
+// ProcessBuffer methods handle in one piece at the maximum delay
+func (d *Line) MaxBlock() int {
+	return len(d.buffer) - d.maxDelay - 3
+}
+
+// Reset clears the delay buffer
+func (d *Line) Reset() {
+	for i := range d.buffer {
+		d.buffer[i] = 0
+	}
+	d.writePos = d.startPosition()
+	d.allpass.Reset()
+}
+
+// Write adds a sample to the delay line
+func (d *Line) Write(sample float32) {
+	d.buffer[d.writePos] = sample
+	d.writePos = (d.writePos + 1) & d.mask
+}
+
+// WriteBlock appends a block to the delay line - at most two copies
+func (d *Line) WriteBlock(src []float32) {
+	if len(src) > len(d.buffer) {
+		// Only the newest samples fit
+		d.writePos = (d.writePos + len(src) - len(d.buffer)) & d.mask
+		src = src[len(src)-len(d.buffer):]
+	}
+	n := copy(d.buffer[d.writePos:], src)
+	copy(d.buffer, src[n:])
+	d.writePos = (d.writePos + len(src)) & d.mask
+}
+
+// At returns the sample delay samples behind the write position
+func (d *Line) At(delay int) float32 {
+	return d.buffer[(d.writePos-delay)&d.mask]
+}
+
+// ReadBlock copies len(dst) samples starting offset samples behind the write
+// position, so dst[0] is At(offset) - at most two copies.
+//
+// Before a block is written, ReadBlock(dst, delay) gives the block's signal
+// at a fixed delay, which needs delay >= len(dst). After WriteBlock the
+// same signal is at offset delay+len(dst).
+func (d *Line) ReadBlock(dst []float32, offset int) {
+	start := (d.writePos - offset) & d.mask
+	n := copy(dst, d.buffer[start:])
+	copy(dst[n:], d.buffer)
+}
+
+// Read gets a delayed sample (delay in samples)
+func (d *Line) Read(delaySamples float64) float32 {
+	// Split the delay so the position never needs float precision
+	whole := int(delaySamples)
+	frac := float32(delaySamples - float64(whole))
+	pos := d.writePos - whole
+
+	// Linear interpolation toward the older sample
+	s1 := d.buffer[pos&d.mask]
+	s2 := d.buffer[(pos-1)&d.mask]
+	return s1 + (s2-s1)*frac
+}
+
+// ReadMs gets a delayed sample (delay in milliseconds)
+func (d *Line) ReadMs(delayMs float64) float32 {
+	delaySamples := delayMs * d.sampleRate / 1000.0
+	return d.Read(delaySamples)
+}
+
+// Tap reads without writing (for multi-tap delays)
+func (d *Line) Tap(delaySamples float64) float32 {
+	return d.Read(delaySamples)
+}
+
+// clampDelay limits a per-sample delay to what the line holds
+func clampDelay(delay, low, high float32) float32 {
+	if delay < low {
+		return low
+	}
+	if delay > high {
+		return high
+	}
+	return delay
+}
+
+// ReadModulated reads the block of len(dst) samples just written with
+// WriteBlock at per-sample delays: dst[i] is the signal delays[i] samples
+// behind sample i of that block, as Read(delays[i]) would have returned
+// right before the sample was written. Delays are clamped to MaxDelay, and
+// blocks must not exceed MaxBlock.
+func (d *Line) ReadModulated(dst, delays []float32, interp Interpolation) {
+	delays = delays[:len(dst)]
+	buffer, mask := d.buffer, d.mask
+	// Position of sample 0 of the block just written
+	base := d.writePos - len(dst)
+	high := float32(d.maxDelay)
+
+	switch interp {
+	case InterpolationHermite:
+		for i, delay := range delays {
+			delay = clampDelay(delay, 1, high)
+			whole := int(delay)
+			pos := base + i - whole
+			dst[i] = interpolation.Hermite(
+				buffer[(pos+1)&mask], buffer[pos&mask],
+				buffer[(pos-1)&mask], buffer[(pos-2)&mask],
+				delay-float32(whole))
+		}
+
+	case InterpolationAllpass:
+		ap := &d.allpass
+		for i, delay := range delays {
+			delay = clampDelay(delay, 0, high)
+			whole := int(delay)
+			dst[i] = ap.Process(buffer[(base+i-whole)&mask], delay-float32(whole))
+		}
+
+	default:
+		for i, delay := range delays {
+			delay = clampDelay(delay, 0, high)
+			whole := int(delay)
+			pos := base + i - whole
+			s1 := buffer[pos&mask]
+			dst[i] = s1 + (buffer[(pos-1)&mask]-s1)*(delay-float32(whole))
+		}
+	}
+}
+
+// AddTap mixes the block of len(dst) samples just written, delayed by a
+// fixed delaySamples and scaled by gain, into dst. Taps of a multi-tap
+// delay all read the one line this way.
+func (d *Line) AddTap(dst []float32, delaySamples float64, gain float32) {
+	if delaySamples < 0 {
+		delaySamples = 0
+	} else if delaySamples > float64(d.maxDelay) {
+		delaySamples = float64(d.maxDelay)
+	}
+	whole := int(delaySamples)
+	frac := float32(delaySamples - float64(whole))
+	g1, g2 := gain*(1-frac), gain*frac
+
+	buffer, mask := d.buffer, d.mask
+	pos := d.writePos - len(dst) - whole
+	for i := range dst {
+		dst[i] += buffer[(pos+i)&mask]*g1 + buffer[(pos+i-1)&mask]*g2
+	}
+}
+
+// Process writes and reads in one operation
+func (d *Line) Process(input float32, delaySamples float64) float32 {
+	output := d.Read(delaySamples)
+	d.Write(input)
+	return output
+}
+
+// ProcessMs writes and reads with delay in milliseconds
+func (d *Line) ProcessMs(input float32, delayMs float64) float32 {
+	delaySamples := delayMs * d.sampleRate / 1000.0
+	return d.Process(input, delaySamples)
+}
+
+// ProcessBuffer processes a buffer with fixed delay - no allocations. Each
+// piece is written with one block copy and read back at the delay.
+func (d *Line) ProcessBuffer(buffer []float32, delaySamples float64) {
+	d.processBuffer(buffer, delaySamples, 1)
+}
+
+// ProcessBufferMix processes with dry/wet mix - no allocations
+func (d *Line) ProcessBufferMix(buffer []float32, delaySamples float64, mix float32) {
+	d.processBuffer(buffer, delaySamples, mix)
+}
+
+// processBuffer replaces buffer with dry*(1-mix) + delayed*mix
+func (d *Line) processBuffer(buffer []float32, delaySamples float64, mix float32) {
+	for start := 0; start < len(buffer); start += d.MaxBlock() {
+		end := start + d.MaxBlock()
+		if end > len(buffer) {
+			end = len(buffer)
+		}
+		block := buffer[start:end]
+		d.WriteBlock(block)
+		for i := range block {
+			block[i] *= 1 - mix
+		}
+		d.AddTap(block, delaySamples, mix)
+	}
+}
@@ -0,0 +1,222 @@
+package delay
+
+import (
+	"math"
+	"testing"
+)
+
+func testSignal(n int) []float32 {
+	signal := make([]float32, n)
+	for i := range signal {
+		signal[i] = float32(math.Sin(float64(i)*0.03) + 0.25*math.Sin(float64(i)*0.71))
+	}
+	return signal
+}
+
+func TestLineCapacityIsPowerOfTwo(t *testing.T) {
+	for _, maxDelay := range []int{1, 100, 1000, 4029, 48000} {
+		d := NewSamples(maxDelay)
+		size := d.Capacity()
+		if size&(size-1) != 0 {
+			t.Errorf("Capacity %d for max delay %d is not a power of two", size, maxDelay)
+		}
+		if d.MaxBlock() < blockHeadroom {
+			t.Errorf("Max delay %d leaves blocks of %d samples, want at least %d", maxDelay, d.MaxBlock(), blockHeadroom)
+		}
+	}
+}
+
+func TestLineBlockCopiesWrap(t *testing.T) {
+	d := NewSamples(100)
+	signal := testSignal(5 * d.Capacity())
+
+	// Odd block sizes so the writes straddle the end of the buffer
+	for start := 0; start+37 <= len(signal); start += 37 {
+		d.WriteBlock(signal[start : start+37])
+
+		const delay = 60
+		got := make([]float32, 37)
+		d.ReadBlock(got, delay+37)
+		for i := range got {
+			want := float32(0)
+			if j := start + i - delay; j >= 0 {
+				want = signal[j]
+			}
+			if got[i] != want {
+				t.Fatalf("Block at %d, sample %d: got %f, want %f", start, i, got[i], want)
+			}
+			if at := d.At(delay + 37 - i); at != want {
+				t.Fatalf("At disagrees with ReadBlock at sample %d: %f vs %f", i, at, want)
+			}
+		}
+	}
+}
+
+func TestLineReadModulatedMatchesProcess(t *testing.T) {
+	perSample := NewSamples(400)
+	block := NewSamples(400)
+	signal := testSignal(2048)
+
+	for start := 0; start < len(signal); start += 64 {
+		input := signal[start : start+64]
+		delays := make([]float32, 64)
+		want := make([]float32, 64)
+		for i := range delays {
+			delays[i] = 200 + 150*float32(math.Sin(float64(start+i)*0.01))
+			want[i] = perSample.Process(input[i], float64(delays[i]))
+		}
+
+		got := make([]float32, 64)
+		block.WriteBlock(input)
+		block.ReadModulated(got, delays, InterpolationLinear)
+		for i := range got {
+			if math.Abs(float64(got[i]-want[i])) > 1e-5 {
+				t.Fatalf("Sample %d: block read %f, per-sample read %f", start+i, got[i], want[i])
+			}
+		}
+	}
+}
+
+func TestLineHermiteIsExactOnCubics(t *testing.T) {
+	d := NewSamples(64)
+	ramp := make([]float32, 64)
+	for i := range ramp {
+		ramp[i] = float32(i)
+	}
+	d.WriteBlock(ramp)
+
+	delays := make([]float32, 64)
+	for i := range delays {
+		delays[i] = 2.25
+	}
+	got := make([]float32, 64)
+	d.ReadModulated(got, delays, InterpolationHermite)
+	for i := 8; i < len(got); i++ {
+		if want := float32(i) - 2.25; math.Abs(float64(got[i]-want)) > 1e-4 {
+			t.Fatalf("Sample %d: got %f, want %f", i, got[i], want)
+		}
+	}
+}
+
+func TestLineAllpassDelaysLowFrequencies(t *testing.T) {
+	const n = 4096
+	d := NewSamples(64)
+	omega := 2 * math.Pi * 100 / 48000.0
+	input := make([]float32, n)
+	for i := range input {
+		input[i] = float32(math.Sin(omega * float64(i)))
+	}
+	delays := make([]float32, n)
+	for i := range delays {
+		delays[i] = 10.4
+	}
+
+	got := make([]float32, n)
+	for start := 0; start < n; start += 64 {
+		d.WriteBlock(input[start : start+64])
+		d.ReadModulated(got[start:start+64], delays[start:start+64], InterpolationAllpass)
+	}
+	for i := n / 2; i < n; i++ {
+		want := math.Sin(omega * (float64(i) - 10.4))
+		if math.Abs(float64(got[i])-want) > 1e-3 {
+			t.Fatalf("Sample %d: got %f, want %f", i, got[i], want)
+		}
+	}
+}
+
+func TestLineProcessBufferFixedDelay(t *testing.T) {
+	d := New(0.01, 48000) // 480 samples
+	signal := testSignal(3000)
+	buffer := append([]float32(nil), signal...)
+	d.ProcessBuffer(buffer, 300)
+
+	for i := range buffer {
+		want := float32(0)
+		if i >= 300 {
+			want = signal[i-300]
+		}
+		if buffer[i] != want {
+			t.Fatalf("Sample %d: got %f, want %f", i, buffer[i], want)
+		}
+	}
+}
+
+func TestMultiTapBufferMatchesPerSample(t *testing.T) {
+	perSample := NewMultiTap(0.05, 48000, 3)
+	block := NewMultiTap(0.05, 48000, 3)
+	taps := []TapOutput{
+		{DelaySamples: 480.5, Gain: 0.8, Pan: -1},
+		{DelaySamples: 1200, Gain: 0.5, Pan: 0},
+		{DelaySamples: 2000.25, Gain: 0.3, Pan: 0.7},
+	}
+	// Per-sample taps read after writing, one sample closer
+	shifted := make([]TapOutput, len(taps))
+	for i, tap := range taps {
+		shifted[i] = tap
+		shifted[i].DelaySamples++
+	}
+
+	input := testSignal(4096)
+	outL, outR := make([]float32, 4096), make([]float32, 4096)
+	block.ProcessMultiTapBuffer(input, outL, outR, taps)
+	for i, x := range input {
+		var l, r float32
+		perSample.ProcessMultiTap(x, shifted, &l, &r)
+		if math.Abs(float64(l-outL[i])) > 1e-5 || math.Abs(float64(r-outR[i])) > 1e-5 {
+			t.Fatalf("Sample %d: block (%f, %f), per-sample (%f, %f)", i, outL[i], outR[i], l, r)
+		}
+	}
+}
+
+func TestLineZeroAllocations(t *testing.T) {
+	d := NewSamples(2048)
+	buffer := testSignal(512)
+	delays := make([]float32, 512)
+	for i := range delays {
+		delays[i] = 1000 + float32(i)
+	}
+
+	allocs := testing.AllocsPerRun(100, func() {
+		d.ProcessBuffer(buffer, 700.5)
+		d.WriteBlock(buffer)
+		d.ReadModulated(buffer, delays, InterpolationHermite)
+	})
+	if allocs != 0 {
+		t.Errorf("Line allocated %.1f times per block", allocs)
+	}
+}
+
+func BenchmarkLine(b *testing.B) {
+	buffer := testSignal(512)
+	delays := make([]float32, 512)
+	for i := range delays {
+		delays[i] = 2000 + 500*float32(math.Sin(float64(i)*0.01))
+	}
+
+	b.Run("PerSample", func(b *testing.B) {
+		d := NewSamples(4800)
+		for i := 0; i < b.N; i++ {
+			for j, x := range buffer {
+				buffer[j] = d.Process(x, float64(delays[j]))
+			}
+		}
+	})
+	b.Run("ProcessBuffer", func(b *testing.B) {
+		d := NewSamples(4800)
+		for i := 0; i < b.N; i++ {
+			d.ProcessBuffer(buffer, 2000.5)
+		}
+	})
+	for _, mode := range []struct {
+		name   string
+		interp Interpolation
+	}{{"Linear", InterpolationLinear}, {"Hermite", InterpolationHermite}, {"Allpass", InterpolationAllpass}} {
+		b.Run("Modulated"+mode.name, func(b *testing.B) {
+			d := NewSamples(4800)
+			for i := 0; i < b.N; i++ {
+				d.WriteBlock(buffer)
+				d.ReadModulated(buffer, delays, mode.interp)
+			}
+		})
+	}
+}
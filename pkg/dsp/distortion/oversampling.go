@@ -0,0 +1,35 @@
+package distortion
+
+import (
+	"math"
+
+	"github.com/justyntemme/vst3go/pkg/dsp/oversample"
+)
+
+// rateScaledCoeff converts a one-pole coefficient tuned for the base rate to
+// the same pole at factor times the rate, so filters inside the nonlinearity
+// keep their voicing when oversampled
+func rateScaledCoeff(coeff float64, factor int) float64 {
+	if factor <= 1 {
+		return coeff
+	}
+	return 1 - math.Pow(1-coeff, 1/float64(factor))
+}
+
+// processStereoOversampled upsamples both channels, lets shape walk the two
+// oversampled blocks together and downsamples the result. Blocks longer
+// than the oversampler's maximum are split.
+func processStereoOversampled(o *oversample.Oversampler, inputL, inputR, outputL, outputR []float64, shape func(left, right []float64)) {
+	n := len(inputL)
+	for start := 0; start < n; start += o.MaxBlockSize() {
+		end := start + o.MaxBlockSize()
+		if end > n {
+			end = n
+		}
+		left := o.Upsample(0, inputL[start:end])
+		right := o.Upsample(1, inputR[start:end])
+		shape(left, right)
+		o.Downsample(0, outputL[start:end])
+		o.Downsample(1, outputR[start:end])
+	}
+}
@@ -0,0 +1,42 @@
+package distortion
+
+import (
+	"math"
+	"testing"
+)
+
+// aliasTestFreq puts the 3rd harmonic above Nyquist, folding back to 0.31
+const aliasTestFreq = 0.23
+
+// aliasLevel measures the folded-back 3rd harmonic a block processor adds
+// to a loud sine
+func aliasLevel(process func(input, output []float64)) float64 {
+	const n = 4096
+	input := make([]float64, n)
+	for i := range input {
+		input[i] = 0.8 * math.Sin(2*math.Pi*aliasTestFreq*float64(i))
+	}
+	output := make([]float64, n)
+	process(input, output)
+
+	settled := output[n/4:]
+	var re, im float64
+	for i, v := range settled {
+		phase := 2 * math.Pi * (1 - 3*aliasTestFreq) * float64(i)
+		re += v * math.Cos(phase)
+		im -= v * math.Sin(phase)
+	}
+	return math.Hypot(re, im) * 2 / float64(len(settled))
+}
+
+func TestRateScaledCoeff(t *testing.T) {
+	if got := rateScaledCoeff(0.3, 1); got != 0.3 {
+		t.Errorf("Base rate coefficient changed: %f", got)
+	}
+
+	// Two steps at twice the rate decay as far as one step at the base rate
+	c := rateScaledCoeff(0.3, 2)
+	if got := 1 - (1-c)*(1-c); math.Abs(got-0.3) > 1e-12 {
+		t.Errorf("Expected the same pole at 2x, got %f", got)
+	}
+}
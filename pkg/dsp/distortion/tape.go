@@ -3,6 +3,8 @@ package distortion
 import (
 	"math"
 	"math/rand"
+
+	"github.com/justyntemme/vst3go/pkg/dsp/oversample"
 )
 
 type TapeSaturation struct {
@@ -35,12 +37,24 @@ type TapeSaturation struct {
 
 	// Noise generator for tape hiss
 	noiseLevel float64
+
+	// One-pole coefficients for the current rate
+	preCutoff    float64
+	deCutoff     float64
+	attackCoeff  float64
+	releaseCoeff float64
+	rateFactor   float64 // Oversampling factor the block methods run at
+
+	// Optional oversampling for the block methods
+	oversampler *oversample.Oversampler
+	shapeBlock  func([]float64)
+	shapeStereo func(left, right []float64)
 }
 
 func NewTapeSaturation(sampleRate float64) *TapeSaturation {
 	bufferSize := int(sampleRate * 0.01) // 10ms max delay for flutter
 
-	return &TapeSaturation{
+	t := &TapeSaturation{
 		saturation:      0.5,
 		compression:     0.5,
 		flutter:         0.0,
@@ -52,7 +66,10 @@ func NewTapeSaturation(sampleRate float64) *TapeSaturation {
 		delayBufferSize: bufferSize,
 		flutterRate:     0.3 + rand.Float64()*0.2, // 0.3-0.5 Hz
 		noiseLevel:      0.0001,
+		rateFactor:      1,
 	}
+	t.updateCoefficients()
+	return t
 }
 
 func (t *TapeSaturation) SetSaturation(saturation float64) {
@@ -69,6 +86,7 @@ func (t *TapeSaturation) SetFlutter(flutter float64) {
 
 func (t *TapeSaturation) SetWarmth(warmth float64) {
 	t.warmth = math.Max(0.0, math.Min(1.0, warmth))
+	t.updateCoefficients()
 }
 
 func (t *TapeSaturation) SetMix(mix float64) {
@@ -79,6 +97,59 @@ func (t *TapeSaturation) SetOutput(output float64) {
 	t.output = math.Max(0.0, math.Min(2.0, output))
 }
 
+// SetOversampling runs ProcessBlock and ProcessStereo at factor times the
+// sample rate (1 disables it) for blocks of up to maxBlockSize samples. The
+// emphasis filters, compressor and flutter delay are rescaled so the voicing
+// is unchanged. Call it at setup time and report Latency to the host.
+func (t *TapeSaturation) SetOversampling(factor int, mode oversample.Mode, maxBlockSize int) {
+	if factor < oversample.Factor2 {
+		t.oversampler = nil
+		factor = 1
+	} else {
+		t.oversampler = oversample.New(2, factor, mode, maxBlockSize)
+		if t.shapeBlock == nil {
+			t.shapeBlock = t.shapeInPlace
+			t.shapeStereo = t.shapeStereoInPlace
+		}
+	}
+	t.rateFactor = float64(factor)
+	t.delayBufferSize = int(t.sampleRate * t.rateFactor * 0.01)
+	t.delayBuffer = make([]float64, t.delayBufferSize)
+	t.delayWritePos = 0
+	t.updateCoefficients()
+}
+
+// Latency returns the delay added by oversampling, in samples
+func (t *TapeSaturation) Latency() int {
+	if t.oversampler == nil {
+		return 0
+	}
+	return t.oversampler.Latency()
+}
+
+// updateCoefficients derives the per-sample filter coefficients from the
+// parameters and the rate the block methods run at
+func (t *TapeSaturation) updateCoefficients() {
+	factor := int(t.rateFactor)
+	t.preCutoff = rateScaledCoeff(0.15+t.warmth*0.1, factor)
+	t.deCutoff = rateScaledCoeff(0.8-t.warmth*0.5, factor)
+	t.attackCoeff = rateScaledCoeff(0.01, factor)
+	t.releaseCoeff = rateScaledCoeff(0.1, factor)
+}
+
+func (t *TapeSaturation) shapeInPlace(block []float64) {
+	for i, x := range block {
+		block[i] = t.processChannel(x, 0)
+	}
+}
+
+func (t *TapeSaturation) shapeStereoInPlace(left, right []float64) {
+	for i := range left {
+		left[i] = t.processChannel(left[i], 0)
+		right[i] = t.processChannel(right[i], 1)
+	}
+}
+
 func (t *TapeSaturation) Process(input float64) float64 {
 	return t.processChannel(input, 0)
 }
@@ -109,12 +180,20 @@ func (t *TapeSaturation) processChannel(input float64, channel int) float64 {
 }
 
 func (t *TapeSaturation) ProcessBlock(input, output []float64) {
+	if t.oversampler != nil {
+		t.oversampler.Process(0, input, output, t.shapeBlock)
+		return
+	}
 	for i := range input {
 		output[i] = t.Process(input[i])
 	}
 }
 
 func (t *TapeSaturation) ProcessStereo(inputL, inputR, outputL, outputR []float64) {
+	if t.oversampler != nil {
+		processStereoOversampled(t.oversampler, inputL, inputR, outputL, outputR, t.shapeStereo)
+		return
+	}
 	for i := range inputL {
 		outputL[i] = t.processChannel(inputL[i], 0)
 		outputR[i] = t.processChannel(inputR[i], 1)
@@ -143,13 +222,10 @@ func (t *TapeSaturation) tapeCompress(x float64) float64 {
 
 	// Update envelope follower
 	absX := math.Abs(x)
-	attack := 0.01
-	release := 0.1
-
 	if absX > t.envelope {
-		t.envelope += (absX - t.envelope) * attack
+		t.envelope += (absX - t.envelope) * t.attackCoeff
 	} else {
-		t.envelope += (absX - t.envelope) * release
+		t.envelope += (absX - t.envelope) * t.releaseCoeff
 	}
 
 	// Calculate compression
@@ -179,7 +255,7 @@ func (t *TapeSaturation) applyFlutter(x float64) float64 {
 	t.delayWritePos = (t.delayWritePos + 1) % t.delayBufferSize
 
 	// Calculate flutter modulation
-	t.flutterPhase += 2.0 * math.Pi * t.flutterRate / t.sampleRate
+	t.flutterPhase += 2.0 * math.Pi * t.flutterRate / (t.sampleRate * t.rateFactor)
 	if t.flutterPhase > 2.0*math.Pi {
 		t.flutterPhase -= 2.0 * math.Pi
 		// Occasionally change flutter rate slightly
@@ -189,14 +265,14 @@ func (t *TapeSaturation) applyFlutter(x float64) float64 {
 	}
 
 	// Flutter modulation depth in samples
-	modDepth := t.flutter * 3.0 // Max 3 samples
+	modDepth := t.flutter * 3.0 * t.rateFactor // Max 3 base-rate samples
 	modulation := math.Sin(t.flutterPhase) * modDepth
 
 	// Add some randomness for more realistic flutter
 	modulation += (rand.Float64()*2.0 - 1.0) * modDepth * 0.3
 
 	// Calculate delayed position
-	delaySamples := 5.0 + modulation // Base delay + modulation
+	delaySamples := 5.0*t.rateFactor + modulation // Base delay + modulation
 
 	// Linear interpolation for fractional delay
 	delayInt := int(delaySamples)
@@ -217,9 +293,8 @@ func (t *TapeSaturation) preEmphasis(x float64, channel int) float64 {
 	// Boost high frequencies before recording
 
 	// High-pass filter component
-	cutoff := 0.15 + t.warmth*0.1
 	highpass := x - t.preEmphasisState[channel]
-	t.preEmphasisState[channel] += highpass * cutoff
+	t.preEmphasisState[channel] += highpass * t.preCutoff
 
 	// Mix based on warmth (more warmth = more pre-emphasis)
 	return x + highpass*t.warmth*0.3
@@ -230,8 +305,7 @@ func (t *TapeSaturation) deEmphasis(x float64, channel int) float64 {
 	// Cut high frequencies after playback
 
 	// Low-pass filter
-	cutoff := 0.8 - t.warmth*0.5
-	t.deEmphasisState[channel] += (x - t.deEmphasisState[channel]) * cutoff
+	t.deEmphasisState[channel] += (x - t.deEmphasisState[channel]) * t.deCutoff
 
 	return t.deEmphasisState[channel]
 }
@@ -249,4 +323,7 @@ func (t *TapeSaturation) Reset() {
 	for i := range t.delayBuffer {
 		t.delayBuffer[i] = 0.0
 	}
+	if t.oversampler != nil {
+		t.oversampler.Reset()
+	}
 }
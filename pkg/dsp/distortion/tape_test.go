@@ -3,6 +3,8 @@ package distortion
 import (
 	"math"
 	"testing"
+
+	"github.com/justyntemme/vst3go/pkg/dsp/oversample"
 )
 
 func TestTapeSaturation(t *testing.T) {
@@ -222,3 +224,21 @@ func BenchmarkTapeSaturation(b *testing.B) {
 		tape.ProcessBlock(input, output)
 	}
 }
+
+func TestTapeSaturationOversampling(t *testing.T) {
+	plain := NewTapeSaturation(48000)
+	plain.SetSaturation(1.0)
+
+	oversampled := NewTapeSaturation(48000)
+	oversampled.SetSaturation(1.0)
+	oversampled.SetOversampling(oversample.Factor4, oversample.LinearPhase, 4096)
+
+	if oversampled.Latency() == 0 || plain.Latency() != 0 {
+		t.Errorf("Unexpected latencies: plain %d, oversampled %d", plain.Latency(), oversampled.Latency())
+	}
+
+	before, after := aliasLevel(plain.ProcessBlock), aliasLevel(oversampled.ProcessBlock)
+	if after > before*0.1 {
+		t.Errorf("Oversampling should cut the alias by 20 dB: %f -> %f", before, after)
+	}
+}
@@ -2,6 +2,8 @@ package distortion
 
 import (
 	"math"
+
+	"github.com/justyntemme/vst3go/pkg/dsp/oversample"
 )
 
 type TubeSaturation struct {
@@ -19,10 +21,21 @@ type TubeSaturation struct {
 	// Pre-emphasis/de-emphasis filters for warmth
 	preEmphasisState float64
 	deEmphasisState  float64
+
+	// One-pole coefficients for the current rate, from warmth and hysteresis
+	preCutoff float64
+	deCutoff  float64
+	riseCoeff float64
+	fallCoeff float64
+
+	// Optional oversampling for the block methods
+	oversampler *oversample.Oversampler
+	shapeBlock  func([]float64)
+	shapeStereo func(left, right []float64)
 }
 
 func NewTubeSaturation() *TubeSaturation {
-	return &TubeSaturation{
+	t := &TubeSaturation{
 		warmth:     0.5,
 		harmonics:  0.5,
 		bias:       0.0,
@@ -30,10 +43,13 @@ func NewTubeSaturation() *TubeSaturation {
 		mix:        1.0,
 		output:     1.0,
 	}
+	t.updateCoefficients()
+	return t
 }
 
 func (t *TubeSaturation) SetWarmth(warmth float64) {
 	t.warmth = math.Max(0.0, math.Min(1.0, warmth))
+	t.updateCoefficients()
 }
 
 func (t *TubeSaturation) SetHarmonics(harmonics float64) {
@@ -46,6 +62,7 @@ func (t *TubeSaturation) SetBias(bias float64) {
 
 func (t *TubeSaturation) SetHysteresis(hysteresis float64) {
 	t.hysteresis = math.Max(0.0, math.Min(1.0, hysteresis))
+	t.updateCoefficients()
 }
 
 func (t *TubeSaturation) SetMix(mix float64) {
@@ -56,6 +73,57 @@ func (t *TubeSaturation) SetOutput(output float64) {
 	t.output = math.Max(0.0, math.Min(2.0, output))
 }
 
+// SetOversampling runs ProcessBlock and ProcessStereo at factor times the
+// sample rate (1 disables it) for blocks of up to maxBlockSize samples. The
+// emphasis and hysteresis filters are retuned so the voicing is unchanged.
+// Call it at setup time and report Latency to the host.
+func (t *TubeSaturation) SetOversampling(factor int, mode oversample.Mode, maxBlockSize int) {
+	if factor < oversample.Factor2 {
+		t.oversampler = nil
+	} else {
+		t.oversampler = oversample.New(2, factor, mode, maxBlockSize)
+		if t.shapeBlock == nil {
+			t.shapeBlock = t.shapeInPlace
+			t.shapeStereo = t.shapeStereoInPlace
+		}
+	}
+	t.updateCoefficients()
+}
+
+// Latency returns the delay added by oversampling, in samples
+func (t *TubeSaturation) Latency() int {
+	if t.oversampler == nil {
+		return 0
+	}
+	return t.oversampler.Latency()
+}
+
+// updateCoefficients derives the per-sample filter coefficients from the
+// parameters and the rate the block methods run at
+func (t *TubeSaturation) updateCoefficients() {
+	factor := 1
+	if t.oversampler != nil {
+		factor = t.oversampler.Factor()
+	}
+	t.preCutoff = rateScaledCoeff(0.1+t.warmth*0.4, factor) // Higher warmth = higher cutoff = more pre-emphasis
+	t.deCutoff = rateScaledCoeff(0.9-t.warmth*0.6, factor)  // Higher warmth = lower cutoff = more de-emphasis
+	t.riseCoeff = rateScaledCoeff(1.0-t.hysteresis*0.3, factor)
+	t.fallCoeff = rateScaledCoeff(1.0-t.hysteresis*0.5, factor)
+}
+
+func (t *TubeSaturation) shapeInPlace(block []float64) {
+	for i, x := range block {
+		block[i] = t.Process(x)
+	}
+}
+
+func (t *TubeSaturation) shapeStereoInPlace(left, right []float64) {
+	for i := range left {
+		left[i] = t.Process(left[i])
+		right[i] = t.Process(right[i])
+	}
+}
+
 func (t *TubeSaturation) Process(input float64) float64 {
 	// Pre-emphasis for warmth (boost highs before saturation)
 	emphasized := t.preEmphasis(input)
@@ -79,12 +147,20 @@ func (t *TubeSaturation) Process(input float64) float64 {
 }
 
 func (t *TubeSaturation) ProcessBlock(input, output []float64) {
+	if t.oversampler != nil {
+		t.oversampler.Process(0, input, output, t.shapeBlock)
+		return
+	}
 	for i := range input {
 		output[i] = t.Process(input[i])
 	}
 }
 
 func (t *TubeSaturation) ProcessStereo(inputL, inputR, outputL, outputR []float64) {
+	if t.oversampler != nil {
+		processStereoOversampled(t.oversampler, inputL, inputR, outputL, outputR, t.shapeStereo)
+		return
+	}
 	for i := range inputL {
 		outputL[i] = t.Process(inputL[i])
 		outputR[i] = t.Process(inputR[i])
@@ -155,10 +231,10 @@ func (t *TubeSaturation) applyHysteresis(x float64) float64 {
 	// Hysteresis effect based on input change direction
 	if diff > 0 {
 		// Rising input
-		t.prevOutput = t.prevOutput + (x-t.prevOutput)*(1.0-t.hysteresis*0.3)
+		t.prevOutput = t.prevOutput + (x-t.prevOutput)*t.riseCoeff
 	} else {
 		// Falling input
-		t.prevOutput = t.prevOutput + (x-t.prevOutput)*(1.0-t.hysteresis*0.5)
+		t.prevOutput = t.prevOutput + (x-t.prevOutput)*t.fallCoeff
 	}
 
 	t.prevInput = x
@@ -168,10 +244,8 @@ func (t *TubeSaturation) applyHysteresis(x float64) float64 {
 func (t *TubeSaturation) preEmphasis(x float64) float64 {
 	// Simple high-frequency boost before saturation
 	// First-order high-pass filter
-	cutoff := 0.1 + t.warmth*0.4 // Higher warmth = higher cutoff = more pre-emphasis
-
 	output := x - t.preEmphasisState
-	t.preEmphasisState += output * cutoff
+	t.preEmphasisState += output * t.preCutoff
 
 	// Mix between filtered and original based on warmth
 	return x + output*t.warmth*0.5
@@ -180,9 +254,7 @@ func (t *TubeSaturation) preEmphasis(x float64) float64 {
 func (t *TubeSaturation) deEmphasis(x float64) float64 {
 	// Simple high-frequency cut after saturation
 	// First-order low-pass filter
-	cutoff := 0.9 - t.warmth*0.6 // Higher warmth = lower cutoff = more de-emphasis
-
-	t.deEmphasisState += (x - t.deEmphasisState) * cutoff
+	t.deEmphasisState += (x - t.deEmphasisState) * t.deCutoff
 	return t.deEmphasisState
 }
 
@@ -191,4 +263,7 @@ func (t *TubeSaturation) Reset() {
 	t.prevOutput = 0.0
 	t.preEmphasisState = 0.0
 	t.deEmphasisState = 0.0
+	if t.oversampler != nil {
+		t.oversampler.Reset()
+	}
 }
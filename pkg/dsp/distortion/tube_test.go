@@ -3,6 +3,8 @@ package distortion
 import (
 	"math"
 	"testing"
+
+	"github.com/justyntemme/vst3go/pkg/dsp/oversample"
 )
 
 func TestTubeSaturation(t *testing.T) {
@@ -186,3 +188,21 @@ func BenchmarkTubeSaturation(b *testing.B) {
 		tube.ProcessBlock(input, output)
 	}
 }
+
+func TestTubeSaturationOversampling(t *testing.T) {
+	plain := NewTubeSaturation()
+	plain.SetHarmonics(1.0)
+
+	oversampled := NewTubeSaturation()
+	oversampled.SetHarmonics(1.0)
+	oversampled.SetOversampling(oversample.Factor4, oversample.LinearPhase, 4096)
+
+	if oversampled.Latency() == 0 || plain.Latency() != 0 {
+		t.Errorf("Unexpected latencies: plain %d, oversampled %d", plain.Latency(), oversampled.Latency())
+	}
+
+	before, after := aliasLevel(plain.ProcessBlock), aliasLevel(oversampled.ProcessBlock)
+	if after > before*0.1 {
+		t.Errorf("Oversampling should cut the alias by 20 dB: %f -> %f", before, after)
+	}
+}
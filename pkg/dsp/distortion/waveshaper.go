@@ -2,6 +2,8 @@ package distortion
 
 import (
 	"math"
+
+	"github.com/justyntemme/vst3go/pkg/dsp/oversample"
 )
 
 type CurveType int
@@ -22,6 +24,10 @@ type Waveshaper struct {
 	mix       float64
 	output    float64
 	asymmetry float64 // For asymmetric curve
+
+	// Optional oversampling for the block methods
+	oversampler *oversample.Oversampler
+	shapeBlock  func([]float64)
 }
 
 func NewWaveshaper() *Waveshaper {
@@ -54,6 +60,34 @@ func (w *Waveshaper) SetAsymmetry(asymmetry float64) {
 	w.asymmetry = math.Max(-1.0, math.Min(1.0, asymmetry))
 }
 
+// SetOversampling runs ProcessBlock and ProcessStereo at factor times the
+// sample rate (1 disables it) for blocks of up to maxBlockSize samples.
+// Call it at setup time and report Latency to the host.
+func (w *Waveshaper) SetOversampling(factor int, mode oversample.Mode, maxBlockSize int) {
+	if factor < oversample.Factor2 {
+		w.oversampler = nil
+		return
+	}
+	w.oversampler = oversample.New(2, factor, mode, maxBlockSize)
+	if w.shapeBlock == nil {
+		w.shapeBlock = w.shapeInPlace
+	}
+}
+
+// Latency returns the delay added by oversampling, in samples
+func (w *Waveshaper) Latency() int {
+	if w.oversampler == nil {
+		return 0
+	}
+	return w.oversampler.Latency()
+}
+
+func (w *Waveshaper) shapeInPlace(block []float64) {
+	for i, x := range block {
+		block[i] = w.Process(x)
+	}
+}
+
 func (w *Waveshaper) Process(input float64) float64 {
 	driven := input * w.drive
 	shaped := w.applyCurve(driven)
@@ -61,12 +95,21 @@ func (w *Waveshaper) Process(input float64) float64 {
 }
 
 func (w *Waveshaper) ProcessBlock(input, output []float64) {
+	if w.oversampler != nil {
+		w.oversampler.Process(0, input, output, w.shapeBlock)
+		return
+	}
 	for i := range input {
 		output[i] = w.Process(input[i])
 	}
 }
 
 func (w *Waveshaper) ProcessStereo(inputL, inputR, outputL, outputR []float64) {
+	if w.oversampler != nil {
+		w.oversampler.Process(0, inputL, outputL, w.shapeBlock)
+		w.oversampler.Process(1, inputR, outputR, w.shapeBlock)
+		return
+	}
 	for i := range inputL {
 		outputL[i] = w.Process(inputL[i])
 		outputR[i] = w.Process(inputR[i])
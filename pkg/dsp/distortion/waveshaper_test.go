@@ -3,6 +3,8 @@ package distortion
 import (
 	"math"
 	"testing"
+
+	"github.com/justyntemme/vst3go/pkg/dsp/oversample"
 )
 
 func TestWaveshaper(t *testing.T) {
@@ -171,6 +173,26 @@ func TestWaveshaperUtilityFunctions(t *testing.T) {
 	})
 }
 
+func TestWaveshaperOversampling(t *testing.T) {
+	plain := NewWaveshaper()
+	plain.SetCurveType(CurveHardClip)
+	plain.SetDrive(4.0)
+
+	oversampled := NewWaveshaper()
+	oversampled.SetCurveType(CurveHardClip)
+	oversampled.SetDrive(4.0)
+	oversampled.SetOversampling(oversample.Factor4, oversample.LinearPhase, 4096)
+
+	if oversampled.Latency() == 0 || plain.Latency() != 0 {
+		t.Errorf("Unexpected latencies: plain %d, oversampled %d", plain.Latency(), oversampled.Latency())
+	}
+
+	before, after := aliasLevel(plain.ProcessBlock), aliasLevel(oversampled.ProcessBlock)
+	if after > before*0.1 {
+		t.Errorf("Oversampling should cut the alias by 20 dB: %f -> %f", before, after)
+	}
+}
+
 func BenchmarkWaveshaper(b *testing.B) {
 	ws := NewWaveshaper()
 	ws.SetCurveType(CurveSoftClip)
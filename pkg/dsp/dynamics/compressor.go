@@ -5,6 +5,7 @@ import (
 	"math"
 
 	"github.com/justyntemme/vst3go/pkg/dsp/envelope"
+	"github.com/justyntemme/vst3go/pkg/dsp/sample"
 )
 
 // KneeType defines the compressor knee characteristic
@@ -34,8 +35,8 @@ type Compressor struct {
 	// Envelope detector
 	detector *envelope.Detector
 
-	// Lookahead delay line
-	delayBuffer  []float32
+	// Lookahead delay line (float64 so both sample formats share it losslessly)
+	delayBuffer  []float64
 	delayIndex   int
 	delaySamples int
 
@@ -106,7 +107,7 @@ func (c *Compressor) SetLookahead(seconds float64) {
 	if newDelaySamples != c.delaySamples {
 		c.delaySamples = newDelaySamples
 		if c.delaySamples > 0 {
-			c.delayBuffer = make([]float32, c.delaySamples)
+			c.delayBuffer = make([]float64, c.delaySamples)
 			c.delayIndex = 0
 		} else {
 			c.delayBuffer = nil
@@ -121,27 +122,33 @@ func (c *Compressor) GetGainReduction() float64 {
 
 // computeGain calculates the gain reduction for a given input level
 func (c *Compressor) computeGain(inputDB float64) float64 {
+	return kneeGainReduction(inputDB, c.threshold, c.ratio, c.kneeWidth, c.kneeType)
+}
+
+// kneeGainReduction is the static gain computer shared by the compressors:
+// the gain reduction in dB for an input level in dB
+func kneeGainReduction(inputDB, threshold, ratio, kneeWidth float64, kneeType KneeType) float64 {
 	// Below threshold - knee: no compression
-	if inputDB < c.threshold-c.kneeWidth/2 {
+	if inputDB < threshold-kneeWidth/2 {
 		return 0.0
 	}
 
 	// Above threshold + knee: full compression
-	if inputDB > c.threshold+c.kneeWidth/2 {
+	if inputDB > threshold+kneeWidth/2 {
 		// Gain reduction formula: reduction = (input - threshold) * (1 - 1/ratio)
-		return (inputDB - c.threshold) * (1.0 - 1.0/c.ratio)
+		return (inputDB - threshold) * (1.0 - 1.0/ratio)
 	}
 
 	// In knee region: interpolate
-	if c.kneeType == KneeSoft && c.kneeWidth > 0 {
+	if kneeType == KneeSoft && kneeWidth > 0 {
 		// Calculate position in knee (0 to 1)
-		kneePos := (inputDB - (c.threshold - c.kneeWidth/2)) / c.kneeWidth
+		kneePos := (inputDB - (threshold - kneeWidth/2)) / kneeWidth
 
 		// Quadratic interpolation for smooth transition
 		// At kneePos=0: no compression
 		// At kneePos=1: full compression at this level
-		compressionRatio := 1.0 - 1.0/c.ratio
-		overshoot := inputDB - c.threshold
+		compressionRatio := 1.0 - 1.0/ratio
+		overshoot := inputDB - threshold
 
 		// Smooth transition using squared interpolation
 		kneeGain := kneePos * kneePos * overshoot * compressionRatio
@@ -152,25 +159,9 @@ func (c *Compressor) computeGain(inputDB float64) float64 {
 	return 0.0
 }
 
-// Process processes a single sample
-func (c *Compressor) Process(input float32) float32 {
-	// For lookahead: detect from current input, but apply to delayed signal
-	detectionSignal := input
-	processSignal := input
-
-	// Handle lookahead delay
-	if c.delaySamples > 0 && c.delayBuffer != nil {
-		// Get delayed signal for processing
-		processSignal = c.delayBuffer[c.delayIndex]
-
-		// Store current input in delay buffer
-		c.delayBuffer[c.delayIndex] = input
-		c.delayIndex = (c.delayIndex + 1) % c.delaySamples
-	}
-
-	// Get envelope of detection signal
-	envelope := c.detector.Detect(detectionSignal)
-
+// gainFor converts a detector envelope into the linear output gain
+// (gain reduction plus makeup) and updates the gain reduction meter
+func (c *Compressor) gainFor(envelope float32) float64 {
 	// Convert to dB
 	inputDB := float64(-96.0)
 	if envelope > 0 {
@@ -183,69 +174,93 @@ func (c *Compressor) Process(input float32) float32 {
 
 	// Convert gain reduction to linear and apply with makeup gain
 	totalGainDB := -gainReductionDB + c.makeupGain
-	gain := math.Pow(10.0, totalGainDB/20.0)
+	return math.Pow(10.0, totalGainDB/20.0)
+}
+
+// compressSample is the per-sample kernel shared by the 32-bit and 64-bit paths
+func compressSample[T sample.Float](c *Compressor, input T) T {
+	// For lookahead: detect from current input, but apply to delayed signal
+	processSignal := input
+
+	// Handle lookahead delay
+	if c.delaySamples > 0 && c.delayBuffer != nil {
+		// Get delayed signal for processing
+		processSignal = T(c.delayBuffer[c.delayIndex])
+
+		// Store current input in delay buffer
+		c.delayBuffer[c.delayIndex] = float64(input)
+		c.delayIndex = (c.delayIndex + 1) % c.delaySamples
+	}
 
 	// Apply gain to delayed signal
-	return processSignal * float32(gain)
+	gain := c.gainFor(c.detector.Detect(float32(input)))
+	return processSignal * T(gain)
 }
 
-// ProcessBuffer processes a buffer of samples
-func (c *Compressor) ProcessBuffer(input, output []float32) {
+func compressBuffer[T sample.Float](c *Compressor, input, output []T) {
 	for i := range input {
-		output[i] = c.Process(input[i])
+		output[i] = compressSample(c, input[i])
 	}
 }
 
-// ProcessStereo processes stereo buffers with linked compression
-func (c *Compressor) ProcessStereo(inputL, inputR, outputL, outputR []float32) {
+func compressStereo[T sample.Float](c *Compressor, inputL, inputR, outputL, outputR []T) {
 	for i := range inputL {
 		// Get max of both channels for linked compression
-		maxInput := float32(math.Max(math.Abs(float64(inputL[i])), math.Abs(float64(inputR[i]))))
-
-		// Get envelope from combined signal
-		envelope := c.detector.Detect(maxInput)
-
-		// Convert to dB
-		inputDB := float64(-96.0)
-		if envelope > 0 {
-			inputDB = 20.0 * math.Log10(float64(envelope))
-		}
-
-		// Calculate gain reduction
-		gainReductionDB := c.computeGain(inputDB)
-		c.lastGainReduction = gainReductionDB
-
-		// Convert to linear gain
-		totalGainDB := -gainReductionDB + c.makeupGain
-		gain := float32(math.Pow(10.0, totalGainDB/20.0))
+		maxInput := math.Max(math.Abs(float64(inputL[i])), math.Abs(float64(inputR[i])))
 
 		// Apply same gain to both channels
+		gain := T(c.gainFor(c.detector.Detect(float32(maxInput))))
 		outputL[i] = inputL[i] * gain
 		outputR[i] = inputR[i] * gain
 	}
 }
 
-// ProcessSidechain processes input using a sidechain signal for detection
-func (c *Compressor) ProcessSidechain(input, sidechain, output []float32) {
+func compressSidechain[T sample.Float](c *Compressor, input, sidechain, output []T) {
 	for i := range input {
-		// Detect from sidechain
-		envelope := c.detector.Detect(sidechain[i])
+		// Detect from sidechain, apply to input signal
+		gain := c.gainFor(c.detector.Detect(float32(sidechain[i])))
+		output[i] = input[i] * T(gain)
+	}
+}
 
-		// Convert to dB
-		inputDB := float64(-96.0)
-		if envelope > 0 {
-			inputDB = 20.0 * math.Log10(float64(envelope))
-		}
+// Process processes a single sample
+func (c *Compressor) Process(input float32) float32 {
+	return compressSample(c, input)
+}
 
-		// Calculate gain reduction
-		gainReductionDB := c.computeGain(inputDB)
-		c.lastGainReduction = gainReductionDB
+// Process64 processes a single double-precision sample
+func (c *Compressor) Process64(input float64) float64 {
+	return compressSample(c, input)
+}
 
-		// Apply to input signal
-		totalGainDB := -gainReductionDB + c.makeupGain
-		gain := float32(math.Pow(10.0, totalGainDB/20.0))
-		output[i] = input[i] * gain
-	}
+// ProcessBuffer processes a buffer of samples
+func (c *Compressor) ProcessBuffer(input, output []float32) {
+	compressBuffer(c, input, output)
+}
+
+// ProcessBuffer64 processes a buffer of double-precision samples
+func (c *Compressor) ProcessBuffer64(input, output []float64) {
+	compressBuffer(c, input, output)
+}
+
+// ProcessStereo processes stereo buffers with linked compression
+func (c *Compressor) ProcessStereo(inputL, inputR, outputL, outputR []float32) {
+	compressStereo(c, inputL, inputR, outputL, outputR)
+}
+
+// ProcessStereo64 processes double-precision stereo buffers with linked compression
+func (c *Compressor) ProcessStereo64(inputL, inputR, outputL, outputR []float64) {
+	compressStereo(c, inputL, inputR, outputL, outputR)
+}
+
+// ProcessSidechain processes input using a sidechain signal for detection
+func (c *Compressor) ProcessSidechain(input, sidechain, output []float32) {
+	compressSidechain(c, input, sidechain, output)
+}
+
+// ProcessSidechain64 is the double-precision version of ProcessSidechain
+func (c *Compressor) ProcessSidechain64(input, sidechain, output []float64) {
+	compressSidechain(c, input, sidechain, output)
 }
 
 // Reset resets the compressor state
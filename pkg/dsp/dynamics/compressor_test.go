@@ -171,6 +171,34 @@ func TestCompressorSidechain(t *testing.T) {
 	}
 }
 
+func TestCompressor64MatchesFloat32(t *testing.T) {
+	c32 := NewCompressor(48000.0)
+	c64 := NewCompressor(48000.0)
+	for _, c := range []*Compressor{c32, c64} {
+		c.SetThreshold(-20.0)
+		c.SetRatio(4.0)
+		c.SetLookahead(0.001)
+	}
+
+	input32 := make([]float32, 256)
+	input64 := make([]float64, 256)
+	for i := range input32 {
+		input32[i] = float32(0.8 * math.Sin(float64(i)*0.1))
+		input64[i] = float64(input32[i])
+	}
+	output32 := make([]float32, 256)
+	output64 := make([]float64, 256)
+
+	c32.ProcessBuffer(input32, output32)
+	c64.ProcessBuffer64(input64, output64)
+
+	for i := range output32 {
+		if math.Abs(float64(output32[i])-output64[i]) > 1e-6 {
+			t.Fatalf("Sample %d: float32 path %f, float64 path %f", i, output32[i], output64[i])
+		}
+	}
+}
+
 func TestCompressorReset(t *testing.T) {
 	c := NewCompressor(48000.0)
 
@@ -3,10 +3,27 @@ package dynamics
 import (
 	"math"
 
-	"github.com/justyntemme/vst3go/pkg/dsp/envelope"
+	"github.com/justyntemme/vst3go/pkg/dsp/oversample"
+	"github.com/justyntemme/vst3go/pkg/dsp/sample"
 )
 
-// Limiter implements a brick-wall limiter with optional true peak detection
+// MaxLookahead is the longest lookahead SetLookahead accepts, in seconds
+const MaxLookahead = 0.100
+
+// limiterChunk is the number of samples the gain curve is computed for at a
+// time; longer blocks are processed in chunks of this size
+const limiterChunk = 256
+
+// Limiter implements a brick-wall lookahead limiter with optional true peak
+// detection.
+//
+// Detection is linked: every block, the peak of all channels (4x
+// oversampled when true peak is on) drives one gain curve that is applied
+// to every channel. The gain computer is a sliding-window minimum of the
+// per-sample target gain over the lookahead, kept in a monotonic deque,
+// followed by the release and a moving average as long as the lookahead that
+// shapes the attack. Every stage is O(1) per sample, so CPU does not grow
+// with the lookahead length.
 type Limiter struct {
 	sampleRate float64
 
@@ -16,85 +33,155 @@ type Limiter struct {
 	lookahead float64 // Lookahead time in seconds
 	truePeak  bool    // Enable true peak detection
 
-	// Envelope detection
-	detector     *envelope.Detector
-	peakDetector *envelope.Detector // For true peak detection
+	ceiling     float64 // Linear ceiling
+	releaseCoef float64 // One-pole release coefficient per sample
 
-	// Lookahead delay
-	delayBuffer  []float32
-	delayIndex   int
-	delaySamples int
+	// Per-channel dry delay (float64 so both sample formats share it losslessly)
+	delayLines [][]float64
+	delayPos   int
+	delay      int // Total dry delay: lookahead plus true-peak alignment
 
-	// True peak oversampling (simple 2x for now)
-	lastSample float32
+	// True peak detection at 4x
+	oversampler *oversample.Oversampler
+	truePeakLag int // Upsampling delay the dry path is aligned with
+
+	// Gain computer
+	lookaheadSamples int
+	minimum          slidingMinimum
+	released         float64   // Held gain after the release stage
+	average          []float64 // Moving average history of the released gain
+	averagePos       int
+	averageLen       int
+	averageSum       float64
+
+	// Per-chunk scratch
+	detection []float64
+	gains     []float64
+	scratch   []float64
 
 	// State
 	gainReduction float64 // Current gain reduction in dB
 }
 
+// slidingMinimum tracks the minimum of the last window values pushed. The
+// deque holds candidates in increasing value order; each value enters and
+// leaves once, so a push is O(1) amortized.
+type slidingMinimum struct {
+	index  []int // Sample index of each candidate, ring of len(values)
+	values []float64
+	head   int
+	count  int
+	next   int // Index of the next pushed value
+	window int
+}
+
 // NewLimiter creates a new brick-wall limiter
 func NewLimiter(sampleRate float64) *Limiter {
+	maxLookahead := int(MaxLookahead*sampleRate) + 1
 	l := &Limiter{
-		sampleRate:   sampleRate,
-		threshold:    -0.3,  // -0.3 dB default ceiling
-		release:      0.050, // 50ms default release
-		lookahead:    0.005, // 5ms default lookahead
-		truePeak:     true,  // True peak detection enabled by default
-		detector:     envelope.NewDetector(sampleRate, envelope.ModePeak),
-		peakDetector: envelope.NewDetector(sampleRate, envelope.ModePeak),
-	}
-
-	// Configure main detector for limiting (very fast attack)
-	l.detector.SetType(envelope.TypeLinear)
-	l.detector.SetAttack(0.0001) // 0.1ms attack
-	l.detector.SetRelease(l.release)
-
-	// Configure peak detector for instant response
-	l.peakDetector.SetType(envelope.TypeLinear)
-	l.peakDetector.SetAttack(0.0)    // Instant
-	l.peakDetector.SetRelease(0.001) // 1ms
-
-	// Initialize lookahead
+		sampleRate: sampleRate,
+		threshold:  -0.3,  // -0.3 dB default ceiling
+		release:    0.050, // 50ms default release
+		lookahead:  0.005, // 5ms default lookahead
+		truePeak:   true,  // True peak detection enabled by default
+		released:   1,
+		average:    make([]float64, maxLookahead+1),
+		detection:  make([]float64, limiterChunk),
+		gains:      make([]float64, limiterChunk),
+		scratch:    make([]float64, limiterChunk),
+	}
+	l.minimum = slidingMinimum{
+		index:  make([]int, maxLookahead+2),
+		values: make([]float64, maxLookahead+2),
+	}
+
+	l.SetChannels(2)
+	l.SetThreshold(l.threshold)
+	l.SetRelease(l.release)
 	l.updateLookahead()
 
 	return l
 }
 
+// SetChannels sizes the limiter for channels linked channels. Call it at
+// setup time; processing more channels than this allocates on first use.
+func (l *Limiter) SetChannels(channels int) {
+	if channels < 1 {
+		channels = 1
+	}
+	if channels == len(l.delayLines) {
+		return
+	}
+	l.oversampler = oversample.New(channels, oversample.Factor4, oversample.LinearPhase, limiterChunk)
+	l.truePeakLag = l.oversampler.UpsampleLatency()
+
+	size := int(MaxLookahead*l.sampleRate) + l.truePeakLag + 1
+	l.delayLines = make([][]float64, channels)
+	for ch := range l.delayLines {
+		l.delayLines[ch] = make([]float64, size)
+	}
+	l.delayPos = 0
+}
+
 // SetThreshold sets the limiter ceiling in dB
 func (l *Limiter) SetThreshold(dB float64) {
 	l.threshold = math.Min(0.0, dB) // Can't be positive
+	l.ceiling = math.Pow(10.0, l.threshold/20.0)
 }
 
 // SetRelease sets the release time in seconds
 func (l *Limiter) SetRelease(seconds float64) {
 	l.release = math.Max(0.001, seconds)
-	l.detector.SetRelease(l.release)
+	l.releaseCoef = 1.0 - math.Exp(-1.0/(l.release*l.sampleRate))
 }
 
-// SetLookahead sets the lookahead time in seconds
+// SetLookahead sets the lookahead time in seconds, up to MaxLookahead.
+// Changing it changes Latency.
 func (l *Limiter) SetLookahead(seconds float64) {
-	l.lookahead = math.Max(0.0, math.Min(0.010, seconds)) // Max 10ms
+	l.lookahead = math.Max(0.0, math.Min(MaxLookahead, seconds))
 	l.updateLookahead()
 }
 
-// SetTruePeak enables or disables true peak detection
+// SetTruePeak enables or disables true peak detection. Enabling it adds the
+// oversampler's delay to Latency.
 func (l *Limiter) SetTruePeak(enabled bool) {
+	if enabled == l.truePeak {
+		return
+	}
 	l.truePeak = enabled
+	l.oversampler.Reset()
+	l.updateLookahead()
 }
 
-// updateLookahead updates the lookahead buffer
+// Latency returns the delay the limiter adds, in samples. Report it through
+// GetLatencySamples.
+func (l *Limiter) Latency() int {
+	return l.delay
+}
+
+// updateLookahead resizes the gain computer for the current lookahead and
+// restarts it from the current gain
 func (l *Limiter) updateLookahead() {
-	newDelaySamples := int(l.lookahead * l.sampleRate)
+	l.lookaheadSamples = int(l.lookahead * l.sampleRate)
+	l.delay = l.lookaheadSamples
 
-	if newDelaySamples != l.delaySamples {
-		l.delaySamples = newDelaySamples
-		if l.delaySamples > 0 {
-			l.delayBuffer = make([]float32, l.delaySamples)
-			l.delayIndex = 0
-		} else {
-			l.delayBuffer = nil
-		}
+	// The averaging ramp spans the lookahead; the minimum is held one sample
+	// longer when true-peak buckets can sit a sample off the dry path
+	window := l.lookaheadSamples + 1
+	if l.truePeak {
+		l.delay += l.truePeakLag
+		window++
+	}
+	l.minimum.window = window
+	l.minimum.clear()
+
+	gain := l.released
+	l.averageLen = l.lookaheadSamples + 1
+	for i := range l.average[:l.averageLen] {
+		l.average[i] = gain
 	}
+	l.averagePos = 0
+	l.averageSum = gain * float64(l.averageLen)
 }
 
 // GetGainReduction returns the current gain reduction in dB
@@ -102,136 +189,228 @@ func (l *Limiter) GetGainReduction() float64 {
 	return l.gainReduction
 }
 
-// estimateTruePeak estimates the true peak using simple linear interpolation
-func (l *Limiter) estimateTruePeak(current float32) float32 {
-	// Simple 2x oversampling estimation
-	// Interpolate between last and current sample
-	midSample := (l.lastSample + current) * 0.5
-
-	// Find peak among last, mid, and current
-	peak := float32(math.Max(math.Abs(float64(l.lastSample)), math.Abs(float64(current))))
-	peak = float32(math.Max(float64(peak), math.Abs(float64(midSample))))
-
-	l.lastSample = current
-	return peak
-}
+// detect writes the linked peak of every channel for one chunk into
+// l.detection
+func detect[T sample.Float](l *Limiter, inputs [][]T, start, n int) {
+	detection := l.detection[:n]
+	clear(detection)
+
+	for ch, input := range inputs {
+		input = input[start : start+n]
+		if !l.truePeak {
+			for i, x := range input {
+				if a := math.Abs(float64(x)); a > detection[i] {
+					detection[i] = a
+				}
+			}
+			continue
+		}
 
-// Process processes a single sample
-func (l *Limiter) Process(input float32) float32 {
-	// Detection signal (with true peak if enabled)
-	detectionSignal := input
-	if l.truePeak {
-		detectionSignal = l.estimateTruePeak(input)
+		scratch := l.scratch[:n]
+		for i, x := range input {
+			scratch[i] = float64(x)
+		}
+		up := l.oversampler.Upsample(ch, scratch)
+		for i := range detection {
+			peak := detection[i]
+			for _, y := range up[4*i : 4*i+4] {
+				if a := math.Abs(y); a > peak {
+					peak = a
+				}
+			}
+			detection[i] = peak
+		}
 	}
+}
 
-	// Handle lookahead
-	processSignal := input
-	if l.delaySamples > 0 && l.delayBuffer != nil {
-		// Get delayed signal
-		processSignal = l.delayBuffer[l.delayIndex]
+// computeGains turns one chunk of detection into the gain curve in l.gains
+func (l *Limiter) computeGains(n int) {
+	released := l.released
+	average := l.average[:l.averageLen]
+	pos, sum := l.averagePos, l.averageSum
+	scale := 1.0 / float64(l.averageLen)
+
+	for i, peak := range l.detection[:n] {
+		target := 1.0
+		if peak > l.ceiling {
+			target = l.ceiling / peak
+		}
+		held := l.minimum.push(target)
 
-		// Store current input
-		l.delayBuffer[l.delayIndex] = input
-		l.delayIndex = (l.delayIndex + 1) % l.delaySamples
+		// Instant attack to the held gain, exponential release above it
+		if held < released {
+			released = held
+		} else {
+			released += (held - released) * l.releaseCoef
+		}
 
-		// For true peak detection in lookahead mode,
-		// we need to check the peak of the delayed signal too
-		if l.truePeak {
-			// Use peak detector for instant response
-			detectionSignal = float32(math.Max(float64(detectionSignal),
-				math.Abs(float64(l.peakDetector.Detect(processSignal)))))
+		sum += released - average[pos]
+		average[pos] = released
+		pos++
+		if pos == len(average) {
+			pos = 0
+			// Re-sum once per lap so rounding never accumulates
+			sum = 0
+			for _, g := range average {
+				sum += g
+			}
 		}
+		l.gains[i] = sum * scale
 	}
 
-	// Get envelope
-	envelope := l.detector.Detect(detectionSignal)
+	l.released = released
+	l.averagePos, l.averageSum = pos, sum
+	l.gainReduction = -20.0 * math.Log10(released)
+}
+
+// apply delays every channel and multiplies it by the chunk's gain curve
+func apply[T sample.Float](l *Limiter, inputs, outputs [][]T, start, n int) {
+	gains := l.gains[:n]
+	size := len(l.delayLines[0])
+	for ch, input := range inputs {
+		line := l.delayLines[ch]
+		input = input[start : start+n]
+		output := outputs[ch][start : start+n]
+
+		write := l.delayPos
+		read := write - l.delay
+		if read < 0 {
+			read += size
+		}
+		for i, x := range input {
+			line[write] = float64(x)
+			output[i] = T(line[read] * gains[i])
+			if write++; write == size {
+				write = 0
+			}
+			if read++; read == size {
+				read = 0
+			}
+		}
+	}
 
-	// Convert to dB
-	inputDB := float64(-96.0)
-	if envelope > 0 {
-		inputDB = 20.0 * math.Log10(float64(envelope))
+	l.delayPos += n
+	if l.delayPos >= size {
+		l.delayPos -= size
 	}
+}
 
-	// Calculate gain reduction (infinite ratio)
-	gainReductionDB := 0.0
-	if inputDB > l.threshold {
-		gainReductionDB = inputDB - l.threshold
+// limitChannels limits a block of linked channels in chunks
+func limitChannels[T sample.Float](l *Limiter, inputs, outputs [][]T) {
+	if len(inputs) == 0 {
+		return
+	}
+	if len(inputs) > len(l.delayLines) {
+		l.SetChannels(len(inputs))
 	}
-	l.gainReduction = gainReductionDB
+	numSamples := len(inputs[0])
+	for start := 0; start < numSamples; start += limiterChunk {
+		n := numSamples - start
+		if n > limiterChunk {
+			n = limiterChunk
+		}
+		detect(l, inputs, start, n)
+		l.computeGains(n)
+		apply(l, inputs, outputs, start, n)
+	}
+}
 
-	// Apply gain reduction
-	gain := float32(math.Pow(10.0, -gainReductionDB/20.0))
+// limitSample runs a single sample of channel 0 through the limiter
+func limitSample[T sample.Float](l *Limiter, input T) T {
+	in := [1]T{input}
+	var out [1]T
+	limitChannels(l, [][]T{in[:]}, [][]T{out[:]})
+	return out[0]
+}
 
-	return processSignal * gain
+// Process processes a single sample
+func (l *Limiter) Process(input float32) float32 {
+	return limitSample(l, input)
+}
+
+// Process64 processes a single double-precision sample
+func (l *Limiter) Process64(input float64) float64 {
+	return limitSample(l, input)
 }
 
 // ProcessBuffer processes a buffer of samples
 func (l *Limiter) ProcessBuffer(input, output []float32) {
-	for i := range input {
-		output[i] = l.Process(input[i])
-	}
+	limitChannels(l, [][]float32{input}, [][]float32{output})
+}
+
+// ProcessBuffer64 processes a buffer of double-precision samples
+func (l *Limiter) ProcessBuffer64(input, output []float64) {
+	limitChannels(l, [][]float64{input}, [][]float64{output})
 }
 
 // ProcessStereo processes stereo buffers with linked limiting
 func (l *Limiter) ProcessStereo(inputL, inputR, outputL, outputR []float32) {
-	for i := range inputL {
-		// Get true peak of both channels
-		peakL := inputL[i]
-		peakR := inputR[i]
-
-		if l.truePeak {
-			peakL = l.estimateTruePeak(inputL[i])
-			// Need separate true peak estimation for right channel
-			// For simplicity, using max of both
-			peakR = float32(math.Max(math.Abs(float64(inputR[i])), float64(peakR)))
-		}
-
-		// Use maximum for detection
-		maxPeak := float32(math.Max(math.Abs(float64(peakL)), math.Abs(float64(peakR))))
-
-		// Process with lookahead
-		var processL, processR float32 = inputL[i], inputR[i]
-		if l.delaySamples > 0 && l.delayBuffer != nil {
-			// We need stereo delay buffers for proper stereo processing
-			// For now, using mono detection with stereo processing
-			processL = inputL[i]
-			processR = inputR[i]
-		}
-
-		// Detect from combined peak
-		envelope := l.detector.Detect(maxPeak)
+	limitChannels(l, [][]float32{inputL, inputR}, [][]float32{outputL, outputR})
+}
 
-		// Calculate limiting
-		inputDB := float64(-96.0)
-		if envelope > 0 {
-			inputDB = 20.0 * math.Log10(float64(envelope))
-		}
+// ProcessStereo64 processes double-precision stereo buffers with linked limiting
+func (l *Limiter) ProcessStereo64(inputL, inputR, outputL, outputR []float64) {
+	limitChannels(l, [][]float64{inputL, inputR}, [][]float64{outputL, outputR})
+}
 
-		gainReductionDB := 0.0
-		if inputDB > l.threshold {
-			gainReductionDB = inputDB - l.threshold
-		}
-		l.gainReduction = gainReductionDB
+// ProcessChannels limits any number of channels with linked detection.
+// Outputs may alias inputs.
+func (l *Limiter) ProcessChannels(inputs, outputs [][]float32) {
+	limitChannels(l, inputs, outputs)
+}
 
-		// Apply same gain to both channels
-		gain := float32(math.Pow(10.0, -gainReductionDB/20.0))
-		outputL[i] = processL * gain
-		outputR[i] = processR * gain
-	}
+// ProcessChannels64 limits double-precision channels with linked detection
+func (l *Limiter) ProcessChannels64(inputs, outputs [][]float64) {
+	limitChannels(l, inputs, outputs)
 }
 
 // Reset resets the limiter state
 func (l *Limiter) Reset() {
-	l.detector.Reset()
-	l.peakDetector.Reset()
+	l.oversampler.Reset()
+	for _, line := range l.delayLines {
+		clear(line)
+	}
+	l.delayPos = 0
+	l.released = 1
 	l.gainReduction = 0.0
-	l.lastSample = 0.0
-	l.delayIndex = 0
+	l.updateLookahead()
+}
+
+func (m *slidingMinimum) clear() {
+	m.head, m.count, m.next = 0, 0, 0
+}
+
+// push adds the next value and returns the minimum of the last window values
+func (m *slidingMinimum) push(value float64) float64 {
+	size := len(m.values)
 
-	// Clear delay buffer
-	if l.delayBuffer != nil {
-		for i := range l.delayBuffer {
-			l.delayBuffer[i] = 0
+	// Later, smaller values make larger ones at the back redundant
+	for m.count > 0 {
+		back := m.head + m.count - 1
+		if back >= size {
+			back -= size
+		}
+		if m.values[back] < value {
+			break
+		}
+		m.count--
+	}
+	tail := m.head + m.count
+	if tail >= size {
+		tail -= size
+	}
+	m.values[tail] = value
+	m.index[tail] = m.next
+	m.count++
+
+	// Drop the front once it leaves the window
+	if m.index[m.head] <= m.next-m.window {
+		m.head++
+		if m.head == size {
+			m.head = 0
 		}
+		m.count--
 	}
+	m.next++
+	return m.values[m.head]
 }
@@ -1,8 +1,11 @@
 package dynamics
 
 import (
+	"fmt"
 	"math"
 	"testing"
+
+	"github.com/justyntemme/vst3go/pkg/dsp/oversample"
 )
 
 func TestLimiterCreation(t *testing.T) {
@@ -190,8 +193,13 @@ func TestLimiterReset(t *testing.T) {
 		t.Errorf("Gain reduction not reset: %f", l.GetGainReduction())
 	}
 
-	if l.lastSample != 0 {
-		t.Error("True peak state not reset")
+	// The delay line and oversampler are cleared: silence in, silence out
+	silence := make([]float32, l.Latency()+64)
+	l.ProcessBuffer(silence, silence)
+	for i, v := range silence {
+		if v != 0 {
+			t.Fatalf("Sample %d not silent after reset: %f", i, v)
+		}
 	}
 }
 
@@ -216,3 +224,156 @@ func BenchmarkLimiterTruePeak(b *testing.B) {
 		_ = l.Process(input)
 	}
 }
+
+// burstSignal is noise with bursts well above the ceiling
+func burstSignal(n int, seed uint32) []float32 {
+	signal := make([]float32, n)
+	for i := range signal {
+		seed = seed*1664525 + 1013904223
+		noise := float32(seed>>8)/float32(1<<24)*2 - 1
+		level := float32(0.3)
+		if (i/700)%3 == 1 {
+			level = 3
+		}
+		signal[i] = noise * level
+	}
+	return signal
+}
+
+func TestLimiterCeiling(t *testing.T) {
+	sampleRate := 96000.0
+	for _, lookahead := range []float64{0, 0.001, 0.020, MaxLookahead} {
+		l := NewLimiter(sampleRate)
+		l.SetThreshold(-1.0)
+		l.SetTruePeak(false)
+		l.SetLookahead(lookahead)
+		ceiling := math.Pow(10, -1.0/20)
+
+		left := burstSignal(20000, 1)
+		right := burstSignal(20000, 2)
+		outL := make([]float32, len(left))
+		outR := make([]float32, len(right))
+		for start := 0; start < len(left); start += 1000 {
+			end := start + 1000
+			l.ProcessStereo(left[start:end], right[start:end], outL[start:end], outR[start:end])
+		}
+
+		for i := range outL {
+			if math.Abs(float64(outL[i])) > ceiling*1.0001 || math.Abs(float64(outR[i])) > ceiling*1.0001 {
+				t.Fatalf("Lookahead %v: sample %d exceeds the ceiling: %f, %f", lookahead, i, outL[i], outR[i])
+			}
+		}
+	}
+}
+
+func TestLimiterTruePeakCeiling(t *testing.T) {
+	l := NewLimiter(48000)
+	l.SetThreshold(-1.0)
+	l.SetLookahead(0.002)
+	ceiling := math.Pow(10, -1.0/20)
+
+	// A quarter-rate tone whose samples sit 3 dB below its true peak
+	input := make([]float32, 8192)
+	for i := range input {
+		input[i] = float32(1.5 * math.Sin(math.Pi/2*float64(i)+math.Pi/4))
+	}
+	output := make([]float32, len(input))
+	l.ProcessBuffer(input, output)
+
+	// Measure the output's true peak once the tone is established
+	o := oversample.New(1, oversample.Factor4, oversample.LinearPhase, len(output))
+	up := o.Upsample(0, float32To64(output))
+	peak := 0.0
+	for _, v := range up[len(up)/2:] {
+		peak = math.Max(peak, math.Abs(v))
+	}
+	if db := 20 * math.Log10(peak/ceiling); db > 0.1 {
+		t.Errorf("Output true peak %.2f dB over the ceiling", db)
+	}
+}
+
+func float32To64(x []float32) []float64 {
+	y := make([]float64, len(x))
+	for i, v := range x {
+		y[i] = float64(v)
+	}
+	return y
+}
+
+func TestLimiterLinkedChannels(t *testing.T) {
+	l := NewLimiter(48000)
+	l.SetThreshold(-6.0)
+	l.SetTruePeak(false)
+	l.SetLookahead(0.001)
+
+	// Only the first channel is loud; all three get the same gain
+	n := 4096
+	inputs := [][]float32{make([]float32, n), make([]float32, n), make([]float32, n)}
+	for i := 0; i < n; i++ {
+		inputs[0][i] = 1.0
+		inputs[1][i] = 0.1
+		inputs[2][i] = 0.05
+	}
+	outputs := [][]float32{make([]float32, n), make([]float32, n), make([]float32, n)}
+	l.ProcessChannels(inputs, outputs)
+
+	i := n - 1
+	gain := outputs[0][i] / inputs[0][i]
+	for ch := 1; ch < 3; ch++ {
+		if g := outputs[ch][i] / inputs[ch][i]; math.Abs(float64(g-gain)) > 1e-6 {
+			t.Errorf("Channel %d gain %f, want linked gain %f", ch, g, gain)
+		}
+	}
+	if math.Abs(20*math.Log10(float64(gain))-(-6)) > 0.1 {
+		t.Errorf("Linked gain %f dB, want -6 dB", 20*math.Log10(float64(gain)))
+	}
+}
+
+func TestLimiterLatency(t *testing.T) {
+	for _, truePeak := range []bool{false, true} {
+		l := NewLimiter(48000)
+		l.SetTruePeak(truePeak)
+		l.SetLookahead(0.003)
+
+		impulse := make([]float32, 1024)
+		impulse[0] = 0.25 // Below the ceiling, so the gain stays at unity
+		l.ProcessBuffer(impulse, impulse)
+
+		latency := l.Latency()
+		if impulse[latency] != 0.25 {
+			t.Errorf("True peak %v: expected the impulse at %d samples", truePeak, latency)
+		}
+	}
+}
+
+func TestLimiterZeroAllocations(t *testing.T) {
+	l := NewLimiter(48000)
+	left := burstSignal(512, 3)
+	right := burstSignal(512, 4)
+
+	allocs := testing.AllocsPerRun(100, func() {
+		l.ProcessStereo(left, right, left, right)
+		l.Process(0.5)
+	})
+	if allocs != 0 {
+		t.Errorf("Processing allocated %.1f times", allocs)
+	}
+}
+
+func BenchmarkLimiterLookahead(b *testing.B) {
+	for _, lookahead := range []float64{0.001, 0.010, 0.100} {
+		b.Run(fmt.Sprintf("%gms", lookahead*1000), func(b *testing.B) {
+			l := NewLimiter(192000)
+			l.SetLookahead(lookahead)
+			left := burstSignal(512, 5)
+			right := burstSignal(512, 6)
+			outL := make([]float32, 512)
+			outR := make([]float32, 512)
+
+			b.ResetTimer()
+			for i := 0; i < b.N; i++ {
+				l.ProcessStereo(left, right, outL, outR)
+			}
+		})
+	}
+}
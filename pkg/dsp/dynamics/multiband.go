@@ -0,0 +1,254 @@
+package dynamics
+
+import (
+	"math"
+
+	"github.com/justyntemme/vst3go/pkg/dsp/crossover"
+	"github.com/justyntemme/vst3go/pkg/dsp/sample"
+)
+
+// MultibandCompressor is the 32-bit multiband compressor used by most processors
+type MultibandCompressor = MultibandCompressorOf[float32]
+
+// MultibandCompressor64 is the double-precision multiband compressor
+type MultibandCompressor64 = MultibandCompressorOf[float64]
+
+// MultibandCompressorOf splits the signal with a Linkwitz-Riley crossover,
+// compresses each band with linked channels and sums the bands back.
+//
+// The bands are not separate Compressor graphs: their settings and detector
+// state are kept as parallel per-band slices and one kernel runs the peak
+// detector and gain computer across all bands sample by sample. A 4-band
+// stereo compressor therefore does the detection work of 4 mono
+// compressors, plus the crossover.
+type MultibandCompressorOf[T sample.Float] struct {
+	sampleRate   float64
+	channels     int
+	maxBlockSize int
+
+	crossover *crossover.CrossoverOf[T]
+	scratch   [][][]T // [band][channel], maxBlockSize samples each
+	views     [][][]T // Block-length views of scratch
+	input     [][]T   // Views of the block being split
+
+	// Per-band settings
+	threshold []float64 // dB
+	ratio     []float64
+	kneeWidth []float64 // dB
+	kneeType  []KneeType
+	makeup    []float64 // Linear makeup gain
+	makeupDB  []float64
+	attack    []float64 // Seconds
+	release   []float64 // Seconds
+
+	// Per-band detector state
+	attackCoef    []float64
+	releaseCoef   []float64
+	envelope      []float64
+	gainReduction []float64 // Last gain reduction in dB, for metering
+}
+
+// NewMultibandCompressor creates a compressor with one band more than
+// crossover frequencies. Blocks longer than maxBlockSize are processed in
+// pieces.
+func NewMultibandCompressor(sampleRate float64, channels, maxBlockSize int, order crossover.Order, frequencies ...float64) *MultibandCompressor {
+	return newMultibandCompressor[float32](sampleRate, channels, maxBlockSize, order, frequencies)
+}
+
+// NewMultibandCompressor64 creates a double-precision multiband compressor
+func NewMultibandCompressor64(sampleRate float64, channels, maxBlockSize int, order crossover.Order, frequencies ...float64) *MultibandCompressor64 {
+	return newMultibandCompressor[float64](sampleRate, channels, maxBlockSize, order, frequencies)
+}
+
+func newMultibandCompressor[T sample.Float](sampleRate float64, channels, maxBlockSize int, order crossover.Order, frequencies []float64) *MultibandCompressorOf[T] {
+	if maxBlockSize < 1 {
+		maxBlockSize = 1
+	}
+	bands := len(frequencies) + 1
+	m := &MultibandCompressorOf[T]{
+		sampleRate:    sampleRate,
+		channels:      channels,
+		maxBlockSize:  maxBlockSize,
+		crossover:     crossover.NewOf[T](sampleRate, channels, order, frequencies...),
+		scratch:       make([][][]T, bands),
+		views:         make([][][]T, bands),
+		input:         make([][]T, channels),
+		threshold:     make([]float64, bands),
+		ratio:         make([]float64, bands),
+		kneeWidth:     make([]float64, bands),
+		kneeType:      make([]KneeType, bands),
+		makeup:        make([]float64, bands),
+		makeupDB:      make([]float64, bands),
+		attack:        make([]float64, bands),
+		release:       make([]float64, bands),
+		attackCoef:    make([]float64, bands),
+		releaseCoef:   make([]float64, bands),
+		envelope:      make([]float64, bands),
+		gainReduction: make([]float64, bands),
+	}
+	for b := 0; b < bands; b++ {
+		m.scratch[b] = make([][]T, channels)
+		m.views[b] = make([][]T, channels)
+		for ch := range m.scratch[b] {
+			m.scratch[b][ch] = make([]T, maxBlockSize)
+		}
+
+		// Same defaults as Compressor
+		m.threshold[b] = -20.0
+		m.ratio[b] = 4.0
+		m.kneeWidth[b] = 2.0
+		m.kneeType[b] = KneeSoft
+		m.makeup[b] = 1.0
+		m.attack[b] = 0.005
+		m.release[b] = 0.050
+		m.updateCoefficients(b)
+	}
+	return m
+}
+
+// Bands returns the number of bands
+func (m *MultibandCompressorOf[T]) Bands() int {
+	return len(m.threshold)
+}
+
+// Crossover returns the band splitter, to move or smooth the splits
+func (m *MultibandCompressorOf[T]) Crossover() *crossover.CrossoverOf[T] {
+	return m.crossover
+}
+
+// SetThreshold sets the threshold of a band in dB
+func (m *MultibandCompressorOf[T]) SetThreshold(band int, dB float64) {
+	m.threshold[band] = dB
+}
+
+// SetRatio sets the compression ratio of a band
+func (m *MultibandCompressorOf[T]) SetRatio(band int, ratio float64) {
+	m.ratio[band] = math.Max(1.0, ratio)
+}
+
+// SetAttack sets the attack time of a band in seconds
+func (m *MultibandCompressorOf[T]) SetAttack(band int, seconds float64) {
+	m.attack[band] = math.Max(0.0001, seconds)
+	m.updateCoefficients(band)
+}
+
+// SetRelease sets the release time of a band in seconds
+func (m *MultibandCompressorOf[T]) SetRelease(band int, seconds float64) {
+	m.release[band] = math.Max(0.001, seconds)
+	m.updateCoefficients(band)
+}
+
+// SetKnee sets the knee type and width of a band
+func (m *MultibandCompressorOf[T]) SetKnee(band int, kneeType KneeType, widthDB float64) {
+	m.kneeType[band] = kneeType
+	m.kneeWidth[band] = math.Max(0.0, widthDB)
+}
+
+// SetMakeupGain sets the makeup gain of a band in dB
+func (m *MultibandCompressorOf[T]) SetMakeupGain(band int, dB float64) {
+	m.makeupDB[band] = dB
+	m.makeup[band] = math.Pow(10.0, dB/20.0)
+}
+
+// GetGainReduction returns the current gain reduction of a band in dB
+func (m *MultibandCompressorOf[T]) GetGainReduction(band int) float64 {
+	return m.gainReduction[band]
+}
+
+// detectPeak advances a logarithmic peak detector by one sample, the
+// response envelope.Detector gives Compressor
+func detectPeak(env, level, attackCoef, releaseCoef float64) float64 {
+	if level > env {
+		env += (level - env) * attackCoef
+		// Capture fast transients immediately
+		if attackCoef > 0.5 || level > env*2.0 {
+			env = level
+		}
+		return env
+	}
+	return env + (level-env)*releaseCoef
+}
+
+// updateCoefficients matches the logarithmic peak detector of Compressor
+func (m *MultibandCompressorOf[T]) updateCoefficients(band int) {
+	m.attackCoef[band] = 1.0 - math.Exp(-2.2/(m.attack[band]*m.sampleRate))
+	m.releaseCoef[band] = 1.0 - math.Exp(-2.2/(m.release[band]*m.sampleRate))
+}
+
+// Reset clears the crossover and detector state
+func (m *MultibandCompressorOf[T]) Reset() {
+	m.crossover.Reset()
+	for b := range m.envelope {
+		m.envelope[b] = 0
+		m.gainReduction[b] = 0
+	}
+}
+
+// Process compresses the channels in place - no allocations
+func (m *MultibandCompressorOf[T]) Process(buffers [][]T) {
+	if len(buffers) == 0 {
+		return
+	}
+	channels := len(buffers)
+	if channels > m.channels {
+		channels = m.channels
+	}
+	buffers = buffers[:channels]
+
+	n := len(buffers[0])
+	for offset := 0; offset < n; offset += m.maxBlockSize {
+		end := offset + m.maxBlockSize
+		if end > n {
+			end = n
+		}
+		m.processBlock(buffers, offset, end)
+	}
+}
+
+func (m *MultibandCompressorOf[T]) processBlock(buffers [][]T, offset, end int) {
+	n := end - offset
+	for b := range m.views {
+		for ch := range m.views[b] {
+			m.views[b][ch] = m.scratch[b][ch][:n]
+		}
+	}
+	input := m.input[:len(buffers)]
+	for ch := range buffers {
+		input[ch] = buffers[ch][offset:end]
+	}
+	m.crossover.Process(input, m.views)
+
+	for i := 0; i < n; i++ {
+		for ch := range buffers {
+			buffers[ch][offset+i] = 0
+		}
+		for b, band := range m.views {
+			// Linked peak detection across the channels of the band
+			level := 0.0
+			for ch := range buffers {
+				if v := math.Abs(float64(band[ch][i])); v > level {
+					level = v
+				}
+			}
+			env := detectPeak(m.envelope[b], level, m.attackCoef[b], m.releaseCoef[b])
+			m.envelope[b] = env
+
+			gain := m.makeup[b]
+			reduction := 0.0
+			if env > 0 {
+				inputDB := 20.0 * math.Log10(env)
+				// Below the knee there is no reduction to convert
+				if inputDB >= m.threshold[b]-m.kneeWidth[b]/2 {
+					reduction = kneeGainReduction(inputDB, m.threshold[b], m.ratio[b], m.kneeWidth[b], m.kneeType[b])
+					gain = math.Pow(10.0, (m.makeupDB[b]-reduction)/20.0)
+				}
+			}
+			m.gainReduction[b] = reduction
+
+			g := T(gain)
+			for ch := range buffers {
+				buffers[ch][offset+i] += band[ch][i] * g
+			}
+		}
+	}
+}
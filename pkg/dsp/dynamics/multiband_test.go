@@ -0,0 +1,162 @@
+package dynamics
+
+import (
+	"math"
+	"testing"
+
+	"github.com/justyntemme/vst3go/pkg/dsp/crossover"
+)
+
+func sineBlock(n int, frequency, amplitude, sampleRate float64) []float32 {
+	buffer := make([]float32, n)
+	for i := range buffer {
+		buffer[i] = float32(amplitude * math.Sin(2*math.Pi*frequency*float64(i)/sampleRate))
+	}
+	return buffer
+}
+
+func TestMultibandCompressorTransparentBelowThreshold(t *testing.T) {
+	const sampleRate = 48000.0
+	m := NewMultibandCompressor64(sampleRate, 2, 256, crossover.LR4, 200, 2000, 8000)
+	for b := 0; b < m.Bands(); b++ {
+		m.SetThreshold(b, 0)
+	}
+	reference := crossover.New64(sampleRate, 2, crossover.LR4, 200, 2000, 8000)
+	bands := make([][][]float64, reference.Bands())
+	for b := range bands {
+		bands[b] = [][]float64{make([]float64, 256), make([]float64, 256)}
+	}
+
+	for block := 0; block < 4; block++ {
+		buffers := make([][]float64, 2)
+		for ch := range buffers {
+			buffers[ch] = make([]float64, 256)
+			for i := range buffers[ch] {
+				buffers[ch][i] = 0.1 * math.Sin(float64(block*256+i)*0.03*float64(ch+1))
+			}
+		}
+		reference.Process(buffers, bands)
+		m.Process(buffers)
+
+		for ch := range buffers {
+			for i := range buffers[ch] {
+				want := 0.0
+				for b := range bands {
+					want += bands[b][ch][i]
+				}
+				if math.Abs(buffers[ch][i]-want) > 1e-9 {
+					t.Fatalf("Block %d, channel %d, sample %d: got %f, want the crossover sum %f",
+						block, ch, i, buffers[ch][i], want)
+				}
+			}
+		}
+	}
+	for b := 0; b < m.Bands(); b++ {
+		if m.GetGainReduction(b) != 0 {
+			t.Errorf("Band %d reduced gain below threshold: %f dB", b, m.GetGainReduction(b))
+		}
+	}
+}
+
+func TestMultibandCompressorCompressesOnlyLoudBand(t *testing.T) {
+	const sampleRate = 48000.0
+	m := NewMultibandCompressor(sampleRate, 1, 512, crossover.LR8, 1000)
+	m.SetThreshold(0, -20)
+	m.SetThreshold(1, -20)
+	m.SetKnee(0, KneeHard, 0)
+	m.SetKnee(1, KneeHard, 0)
+
+	// Loud bass, quiet treble
+	low := sineBlock(4800, 100, 0.8, sampleRate)
+	high := sineBlock(4800, 8000, 0.02, sampleRate)
+	buffer := make([]float32, 4800)
+	for i := range buffer {
+		buffer[i] = low[i] + high[i]
+	}
+	m.Process([][]float32{buffer})
+
+	if m.GetGainReduction(0) < 6 {
+		t.Errorf("Low band should be compressed: %f dB reduction", m.GetGainReduction(0))
+	}
+	if m.GetGainReduction(1) != 0 {
+		t.Errorf("High band should be untouched: %f dB reduction", m.GetGainReduction(1))
+	}
+}
+
+func TestMultibandCompressorLongBlocks(t *testing.T) {
+	const sampleRate = 48000.0
+	small := NewMultibandCompressor64(sampleRate, 2, 64, crossover.LR4, 300, 3000)
+	large := NewMultibandCompressor64(sampleRate, 2, 1024, crossover.LR4, 300, 3000)
+	for _, m := range []*MultibandCompressor64{small, large} {
+		m.SetThreshold(1, -30)
+		m.SetRatio(1, 8)
+		m.SetMakeupGain(2, 3)
+	}
+
+	input := func() [][]float64 {
+		buffers := make([][]float64, 2)
+		for ch := range buffers {
+			buffers[ch] = make([]float64, 1000)
+			for i := range buffers[ch] {
+				buffers[ch][i] = 0.7 * math.Sin(float64(i)*0.07*float64(ch+1))
+			}
+		}
+		return buffers
+	}
+	a, b := input(), input()
+	small.Process(a)
+	large.Process(b)
+
+	for ch := range a {
+		for i := range a[ch] {
+			if math.Abs(a[ch][i]-b[ch][i]) > 1e-12 {
+				t.Fatalf("Channel %d, sample %d: pieces give %f, one block gives %f", ch, i, a[ch][i], b[ch][i])
+			}
+		}
+	}
+}
+
+func TestMultibandCompressorZeroAllocations(t *testing.T) {
+	m := NewMultibandCompressor(48000, 2, 512, crossover.LR4, 150, 1500, 6000)
+	buffers := [][]float32{sineBlock(512, 100, 0.9, 48000), sineBlock(512, 3000, 0.9, 48000)}
+
+	allocs := testing.AllocsPerRun(100, func() {
+		m.SetThreshold(2, -18)
+		m.Process(buffers)
+	})
+	if allocs != 0 {
+		t.Errorf("MultibandCompressor allocated %.1f times per block", allocs)
+	}
+}
+
+// BenchmarkMultibandCompressor compares a 4-band stereo compressor, crossover
+// included, with 4 stereo-linked Compressors on an unsplit signal
+func BenchmarkMultibandCompressor(b *testing.B) {
+	const n = 512
+	left, right := sineBlock(n, 100, 0.9, 48000), sineBlock(n, 3000, 0.9, 48000)
+
+	b.Run("Multiband", func(b *testing.B) {
+		m := NewMultibandCompressor(48000, 2, n, crossover.LR4, 150, 1500, 6000)
+		buffers := [][]float32{make([]float32, n), make([]float32, n)}
+		b.ResetTimer()
+		for i := 0; i < b.N; i++ {
+			copy(buffers[0], left)
+			copy(buffers[1], right)
+			m.Process(buffers)
+		}
+	})
+
+	b.Run("FourCompressors", func(b *testing.B) {
+		compressors := make([]*Compressor, 4)
+		for i := range compressors {
+			compressors[i] = NewCompressor(48000)
+		}
+		outL, outR := make([]float32, n), make([]float32, n)
+		b.ResetTimer()
+		for i := 0; i < b.N; i++ {
+			for _, c := range compressors {
+				c.ProcessStereo(left, right, outL, outR)
+			}
+		}
+	})
+}
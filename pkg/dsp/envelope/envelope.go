@@ -34,6 +34,10 @@ type ADSR struct {
 	decayCoef   float64
 	releaseCoef float64
 
+	// Coefficients for the samples Render skips at its last stride
+	stride       int
+	stridedCoefs [3]float64
+
 	// State
 	stage  Stage
 	value  float64
@@ -95,6 +99,7 @@ func (e *ADSR) updateCoefficients() {
 	e.attackCoef = calcCoef(e.attack, e.sampleRate)
 	e.decayCoef = calcCoef(e.decay, e.sampleRate)
 	e.releaseCoef = calcCoef(e.release, e.sampleRate)
+	e.stride = 0
 }
 
 // calcCoef calculates exponential coefficient for a given time
@@ -138,9 +143,14 @@ func (e *ADSR) GetStage() Stage {
 
 // Next generates the next envelope value
 func (e *ADSR) Next() float32 {
+	return e.step(e.attackCoef, e.decayCoef, e.releaseCoef)
+}
+
+// step advances the envelope by one step of the given coefficients
+func (e *ADSR) step(attackCoef, decayCoef, releaseCoef float64) float32 {
 	switch e.stage {
 	case StageAttack:
-		e.value = e.target + (e.value-e.target)*e.attackCoef
+		e.value = e.target + (e.value-e.target)*attackCoef
 		if e.value >= 0.999 {
 			e.value = 1.0
 			e.stage = StageDecay
@@ -148,7 +158,7 @@ func (e *ADSR) Next() float32 {
 		}
 
 	case StageDecay:
-		e.value = e.target + (e.value-e.target)*e.decayCoef
+		e.value = e.target + (e.value-e.target)*decayCoef
 		if e.value <= e.sustain+0.001 {
 			e.value = e.sustain
 			e.stage = StageSustain
@@ -158,7 +168,7 @@ func (e *ADSR) Next() float32 {
 		e.value = e.sustain
 
 	case StageRelease:
-		e.value = e.target + (e.value-e.target)*e.releaseCoef
+		e.value = e.target + (e.value-e.target)*releaseCoef
 		if e.value <= 0.001 {
 			e.value = 0.0
 			e.stage = StageIdle
@@ -178,6 +188,31 @@ func (e *ADSR) Process(buffer []float32) {
 	}
 }
 
+// Render fills out with envelope values spaced stride samples apart, so the
+// envelope can feed a control-rate modulation engine. Each value is the one
+// Next would return at that sample; the samples in between are skipped in a
+// single step with the coefficients raised to stride-1, which are recomputed
+// only when the stride or the times change - no allocations.
+func (e *ADSR) Render(out []float32, stride int) {
+	if stride <= 1 {
+		e.Process(out)
+		return
+	}
+	if e.stride != stride {
+		e.stride = stride
+		e.stridedCoefs = [3]float64{
+			math.Pow(e.attackCoef, float64(stride-1)),
+			math.Pow(e.decayCoef, float64(stride-1)),
+			math.Pow(e.releaseCoef, float64(stride-1)),
+		}
+	}
+	c := e.stridedCoefs
+	for i := range out {
+		out[i] = e.step(e.attackCoef, e.decayCoef, e.releaseCoef)
+		e.step(c[0], c[1], c[2])
+	}
+}
+
 // ProcessMultiply multiplies buffer by envelope - no allocations
 func (e *ADSR) ProcessMultiply(buffer []float32) {
 	for i := range buffer {
@@ -197,6 +232,10 @@ type AR struct {
 	attackCoef  float64
 	releaseCoef float64
 
+	// Coefficients for the samples Render skips at its last stride
+	stride       int
+	stridedCoefs [2]float64
+
 	// State
 	active bool
 	value  float64
@@ -230,6 +269,7 @@ func (e *AR) SetRelease(seconds float64) {
 func (e *AR) updateCoefficients() {
 	e.attackCoef = calcCoef(e.attack, e.sampleRate)
 	e.releaseCoef = calcCoef(e.release, e.sampleRate)
+	e.stride = 0
 }
 
 // Trigger starts the attack phase
@@ -246,10 +286,15 @@ func (e *AR) Release() {
 
 // Next generates the next envelope value
 func (e *AR) Next() float32 {
+	return e.step(e.attackCoef, e.releaseCoef)
+}
+
+// step advances the envelope by one step of the given coefficients
+func (e *AR) step(attackCoef, releaseCoef float64) float32 {
 	if e.active {
-		e.value = e.target + (e.value-e.target)*e.attackCoef
+		e.value = e.target + (e.value-e.target)*attackCoef
 	} else {
-		e.value = e.target + (e.value-e.target)*e.releaseCoef
+		e.value = e.target + (e.value-e.target)*releaseCoef
 	}
 	return float32(e.value)
 }
@@ -261,6 +306,28 @@ func (e *AR) Process(buffer []float32) {
 	}
 }
 
+// Render fills out with envelope values spaced stride samples apart, so the
+// envelope can feed a control-rate modulation engine. Like ADSR.Render, each
+// value is the one Next would return at that sample - no allocations.
+func (e *AR) Render(out []float32, stride int) {
+	if stride <= 1 {
+		e.Process(out)
+		return
+	}
+	if e.stride != stride {
+		e.stride = stride
+		e.stridedCoefs = [2]float64{
+			math.Pow(e.attackCoef, float64(stride-1)),
+			math.Pow(e.releaseCoef, float64(stride-1)),
+		}
+	}
+	c := e.stridedCoefs
+	for i := range out {
+		out[i] = e.step(e.attackCoef, e.releaseCoef)
+		e.step(c[0], c[1])
+	}
+}
+
 // ProcessMultiply multiplies buffer by envelope - no allocations
 func (e *AR) ProcessMultiply(buffer []float32) {
 	for i := range buffer {
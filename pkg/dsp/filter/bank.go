@@ -0,0 +1,330 @@
+package filter
+
+import (
+	"github.com/justyntemme/vst3go/pkg/dsp/sample"
+)
+
+// BankTopology selects how the sections of a BiquadBank are combined
+type BankTopology int
+
+const (
+	// BankCascade runs the sections in series (EQs, Butterworth/LR cascades)
+	BankCascade BankTopology = iota
+	// BankParallel feeds every section the input and sums their outputs
+	// plus a direct path (graphic EQs, band splits). Sections are
+	// independent, so there is no serial dependency between them.
+	BankParallel
+)
+
+// BiquadBank is the 32-bit biquad bank used by most processors
+type BiquadBank = BiquadBankOf[float32]
+
+// BiquadBank64 is the double-precision biquad bank for kSample64 processing
+type BiquadBank64 = BiquadBankOf[float64]
+
+// BiquadBankOf processes N channels through M biquad sections in Transposed
+// Direct Form II. State is stored section-major with the channels of a
+// section adjacent, the layout a per-lane kernel loads in one go.
+//
+// Coefficient changes set a target; with smoothing enabled the bank ramps
+// every coefficient linearly toward it over the smoothing time, so an
+// automated sweep needs one design call per block rather than per sample.
+type BiquadBankOf[T sample.Float] struct {
+	channels int
+	sections int
+	topology BankTopology
+	direct   T // Direct path gain for BankParallel
+
+	coeffs    []bankSection[T]
+	smoothing int // Ramp length in samples; 0 applies changes immediately
+
+	// TDF2 state, index section*channels + channel
+	s1, s2 []T
+}
+
+// bankSection holds the current and target coefficients of one section
+type bankSection[T sample.Float] struct {
+	current   biquadCoeffs[T]
+	target    biquadCoeffs[T]
+	remaining int // Samples left in the ramp toward target
+}
+
+// biquadCoeffs are normalized (a0 = 1) biquad coefficients
+type biquadCoeffs[T sample.Float] struct {
+	b0, b1, b2, a1, a2 T
+}
+
+// NewBiquadBank creates a bank of sections biquads for channels channels
+func NewBiquadBank(channels, sections int) *BiquadBank {
+	return NewBiquadBankOf[float32](channels, sections)
+}
+
+// NewBiquadBank64 creates a double-precision biquad bank
+func NewBiquadBank64(channels, sections int) *BiquadBank64 {
+	return NewBiquadBankOf[float64](channels, sections)
+}
+
+// NewBiquadBankOf creates a biquad bank for either sample format, for
+// generic processors built on banks
+func NewBiquadBankOf[T sample.Float](channels, sections int) *BiquadBankOf[T] {
+	b := &BiquadBankOf[T]{
+		channels: channels,
+		sections: sections,
+		coeffs:   make([]bankSection[T], sections),
+		s1:       make([]T, channels*sections),
+		s2:       make([]T, channels*sections),
+	}
+	// Start as identity sections
+	for i := range b.coeffs {
+		b.coeffs[i].current.b0 = 1
+		b.coeffs[i].target.b0 = 1
+	}
+	return b
+}
+
+// Channels returns the number of channels
+func (b *BiquadBankOf[T]) Channels() int {
+	return b.channels
+}
+
+// Sections returns the number of sections per channel
+func (b *BiquadBankOf[T]) Sections() int {
+	return b.sections
+}
+
+// SetTopology selects cascade or parallel processing
+func (b *BiquadBankOf[T]) SetTopology(topology BankTopology) {
+	b.topology = topology
+}
+
+// SetDirectGain sets the dry path gain summed with the sections in BankParallel
+func (b *BiquadBankOf[T]) SetDirectGain(gain T) {
+	b.direct = gain
+}
+
+// SetSmoothing sets how many samples coefficient changes ramp over; 0
+// applies them at the start of the next block
+func (b *BiquadBankOf[T]) SetSmoothing(samples int) {
+	if samples < 0 {
+		samples = 0
+	}
+	b.smoothing = samples
+}
+
+// Reset clears the filter state and completes any coefficient ramp
+func (b *BiquadBankOf[T]) Reset() {
+	for i := range b.s1 {
+		b.s1[i] = 0
+		b.s2[i] = 0
+	}
+	for i := range b.coeffs {
+		b.coeffs[i].current = b.coeffs[i].target
+		b.coeffs[i].remaining = 0
+	}
+}
+
+// SetCoefficients sets the target coefficients of one section directly
+func (b *BiquadBankOf[T]) SetCoefficients(section int, b0, b1, b2, a0, a1, a2 T) {
+	invA0 := 1.0 / a0
+	s := &b.coeffs[section]
+	s.target = biquadCoeffs[T]{b0 * invA0, b1 * invA0, b2 * invA0, a1 * invA0, a2 * invA0}
+	s.remaining = b.smoothing
+	if s.remaining == 0 {
+		s.current = s.target
+	}
+}
+
+// SetLowpass configures a section as a lowpass filter
+func (b *BiquadBankOf[T]) SetLowpass(section int, sampleRate, frequency, q float64) {
+	b.setDesign(section, designLowpass(sampleRate, frequency, q))
+}
+
+// SetHighpass configures a section as a highpass filter
+func (b *BiquadBankOf[T]) SetHighpass(section int, sampleRate, frequency, q float64) {
+	b.setDesign(section, designHighpass(sampleRate, frequency, q))
+}
+
+// SetBandpass configures a section as a bandpass filter (constant skirt gain)
+func (b *BiquadBankOf[T]) SetBandpass(section int, sampleRate, frequency, q float64) {
+	b.setDesign(section, designBandpass(sampleRate, frequency, q))
+}
+
+// SetNotch configures a section as a notch (band-reject) filter
+func (b *BiquadBankOf[T]) SetNotch(section int, sampleRate, frequency, q float64) {
+	b.setDesign(section, designNotch(sampleRate, frequency, q))
+}
+
+// SetAllpass configures a section as an allpass filter
+func (b *BiquadBankOf[T]) SetAllpass(section int, sampleRate, frequency, q float64) {
+	b.setDesign(section, designAllpass(sampleRate, frequency, q))
+}
+
+// SetPeakingEQ configures a section as a peaking EQ filter
+func (b *BiquadBankOf[T]) SetPeakingEQ(section int, sampleRate, frequency, q, gainDB float64) {
+	b.setDesign(section, designPeakingEQ(sampleRate, frequency, q, gainDB))
+}
+
+// SetLowShelf configures a section as a low shelf filter
+func (b *BiquadBankOf[T]) SetLowShelf(section int, sampleRate, frequency, q, gainDB float64) {
+	b.setDesign(section, designLowShelf(sampleRate, frequency, q, gainDB))
+}
+
+// SetHighShelf configures a section as a high shelf filter
+func (b *BiquadBankOf[T]) SetHighShelf(section int, sampleRate, frequency, q, gainDB float64) {
+	b.setDesign(section, designHighShelf(sampleRate, frequency, q, gainDB))
+}
+
+func (b *BiquadBankOf[T]) setDesign(section int, d biquadDesign) {
+	b.SetCoefficients(section, T(d.b0), T(d.b1), T(d.b2), T(d.a0), T(d.a1), T(d.a2))
+}
+
+// Process filters every channel in place - no allocations. Extra buffers
+// beyond the bank's channel count are left untouched.
+func (b *BiquadBankOf[T]) Process(buffers [][]T) {
+	if len(buffers) == 0 {
+		return
+	}
+	n := len(buffers[0])
+	channels := len(buffers)
+	if channels > b.channels {
+		channels = b.channels
+	}
+
+	if b.topology == BankParallel {
+		b.processParallel(buffers[:channels], n)
+		return
+	}
+
+	for m := range b.coeffs {
+		start, step := b.advance(m, n)
+		s1 := b.s1[m*b.channels : m*b.channels+channels]
+		s2 := b.s2[m*b.channels : m*b.channels+channels]
+		if step != (biquadCoeffs[T]{}) {
+			for ch := 0; ch < channels; ch++ {
+				processTDF2Ramp(buffers[ch][:n], start, step, &s1[ch], &s2[ch])
+			}
+			continue
+		}
+
+		// Channel pairs run in lockstep so the two recursions overlap
+		ch := 0
+		for ; ch+1 < channels; ch += 2 {
+			processTDF2Pair(buffers[ch][:n], buffers[ch+1][:n], start, s1[ch:ch+2], s2[ch:ch+2])
+		}
+		if ch < channels {
+			processTDF2(buffers[ch][:n], start, &s1[ch], &s2[ch])
+		}
+	}
+}
+
+// processParallel sums every section's response to the input with the
+// direct path. Ramps are applied per block in this form.
+func (b *BiquadBankOf[T]) processParallel(buffers [][]T, n int) {
+	for m := range b.coeffs {
+		b.advance(m, n)
+	}
+
+	for ch, buffer := range buffers {
+		buffer = buffer[:n]
+		for i, x := range buffer {
+			y := b.direct * x
+			for m := range b.coeffs {
+				c := &b.coeffs[m].current
+				idx := m*b.channels + ch
+				out := c.b0*x + b.s1[idx]
+				b.s1[idx] = c.b1*x - c.a1*out + b.s2[idx]
+				b.s2[idx] = c.b2*x - c.a2*out
+				y += out
+			}
+			buffer[i] = y
+		}
+	}
+}
+
+// advance moves section m's ramp forward by n samples. It returns the
+// coefficients at the start of the block and the per-sample step.
+func (b *BiquadBankOf[T]) advance(m, n int) (start, step biquadCoeffs[T]) {
+	s := &b.coeffs[m]
+	start = s.current
+	if s.remaining == 0 {
+		return start, step
+	}
+
+	k := n
+	if k > s.remaining {
+		k = s.remaining
+	}
+	frac := T(k) / T(s.remaining)
+	s.current = biquadCoeffs[T]{
+		b0: start.b0 + (s.target.b0-start.b0)*frac,
+		b1: start.b1 + (s.target.b1-start.b1)*frac,
+		b2: start.b2 + (s.target.b2-start.b2)*frac,
+		a1: start.a1 + (s.target.a1-start.a1)*frac,
+		a2: start.a2 + (s.target.a2-start.a2)*frac,
+	}
+	s.remaining -= k
+	if s.remaining == 0 {
+		s.current = s.target
+	}
+
+	// Spread the change over the whole block, not just the ramp's tail part
+	inv := 1 / T(n)
+	step = biquadCoeffs[T]{
+		b0: (s.current.b0 - start.b0) * inv,
+		b1: (s.current.b1 - start.b1) * inv,
+		b2: (s.current.b2 - start.b2) * inv,
+		a1: (s.current.a1 - start.a1) * inv,
+		a2: (s.current.a2 - start.a2) * inv,
+	}
+	return start, step
+}
+
+// processTDF2 runs one section over a buffer with fixed coefficients
+func processTDF2[T sample.Float](buffer []T, c biquadCoeffs[T], state1, state2 *T) {
+	s1, s2 := *state1, *state2
+	for i, x := range buffer {
+		y := c.b0*x + s1
+		s1 = c.b1*x - c.a1*y + s2
+		s2 = c.b2*x - c.a2*y
+		buffer[i] = y
+	}
+	*state1, *state2 = s1, s2
+}
+
+// processTDF2Pair runs one section over two channels at once
+func processTDF2Pair[T sample.Float](left, right []T, c biquadCoeffs[T], state1, state2 []T) {
+	right = right[:len(left)]
+	l1, l2 := state1[0], state2[0]
+	r1, r2 := state1[1], state2[1]
+	for i, x := range left {
+		z := right[i]
+		yl := c.b0*x + l1
+		yr := c.b0*z + r1
+		l1 = c.b1*x - c.a1*yl + l2
+		r1 = c.b1*z - c.a1*yr + r2
+		l2 = c.b2*x - c.a2*yl
+		r2 = c.b2*z - c.a2*yr
+		left[i] = yl
+		right[i] = yr
+	}
+	state1[0], state2[0] = l1, l2
+	state1[1], state2[1] = r1, r2
+}
+
+// processTDF2Ramp runs one section while stepping its coefficients
+func processTDF2Ramp[T sample.Float](buffer []T, c, step biquadCoeffs[T], state1, state2 *T) {
+	s1, s2 := *state1, *state2
+	for i, x := range buffer {
+		c.b0 += step.b0
+		c.b1 += step.b1
+		c.b2 += step.b2
+		c.a1 += step.a1
+		c.a2 += step.a2
+
+		y := c.b0*x + s1
+		s1 = c.b1*x - c.a1*y + s2
+		s2 = c.b2*x - c.a2*y
+		buffer[i] = y
+	}
+	*state1, *state2 = s1, s2
+}
@@ -0,0 +1,144 @@
+package filter
+
+import (
+	"math"
+	"testing"
+)
+
+func testSignal(n int, seed float64) []float64 {
+	signal := make([]float64, n)
+	for i := range signal {
+		signal[i] = math.Sin(float64(i)*0.05*seed) + 0.3*math.Sin(float64(i)*0.9)
+	}
+	return signal
+}
+
+func TestBiquadBankCascadeMatchesBiquads(t *testing.T) {
+	const sampleRate = 48000
+	bank := NewBiquadBank64(2, 3)
+	bank.SetLowShelf(0, sampleRate, 120, 0.7, 4)
+	bank.SetPeakingEQ(1, sampleRate, 1000, 1.4, -6)
+	bank.SetHighpass(2, sampleRate, 40, 0.707)
+
+	reference := []*Biquad64{NewBiquad64(2), NewBiquad64(2), NewBiquad64(2)}
+	reference[0].SetLowShelf(sampleRate, 120, 0.7, 4)
+	reference[1].SetPeakingEQ(sampleRate, 1000, 1.4, -6)
+	reference[2].SetHighpass(sampleRate, 40, 0.707)
+
+	for block := 0; block < 4; block++ {
+		got := [][]float64{testSignal(256, 1), testSignal(256, 2)}
+		want := [][]float64{testSignal(256, 1), testSignal(256, 2)}
+		bank.Process(got)
+		for _, section := range reference {
+			section.ProcessMulti(want)
+		}
+
+		for ch := range got {
+			for i := range got[ch] {
+				if math.Abs(got[ch][i]-want[ch][i]) > 1e-9 {
+					t.Fatalf("Block %d, channel %d, sample %d: got %f, want %f", block, ch, i, got[ch][i], want[ch][i])
+				}
+			}
+		}
+	}
+}
+
+func TestBiquadBankParallel(t *testing.T) {
+	const sampleRate = 48000
+	bank := NewBiquadBank64(1, 2)
+	bank.SetTopology(BankParallel)
+	bank.SetDirectGain(0.5)
+	bank.SetBandpass(0, sampleRate, 300, 2)
+	bank.SetBandpass(1, sampleRate, 3000, 2)
+
+	low, high := NewBiquad64(1), NewBiquad64(1)
+	low.SetBandpass(sampleRate, 300, 2)
+	high.SetBandpass(sampleRate, 3000, 2)
+
+	input := testSignal(512, 1)
+	got := [][]float64{append([]float64(nil), input...)}
+	bank.Process(got)
+
+	lowOut := append([]float64(nil), input...)
+	highOut := append([]float64(nil), input...)
+	low.Process(lowOut, 0)
+	high.Process(highOut, 0)
+
+	for i := range input {
+		want := 0.5*input[i] + lowOut[i] + highOut[i]
+		if math.Abs(got[0][i]-want) > 1e-9 {
+			t.Fatalf("Sample %d: got %f, want %f", i, got[0][i], want)
+		}
+	}
+}
+
+func TestBiquadBankSmoothing(t *testing.T) {
+	bank := NewBiquadBank(1, 1)
+	bank.SetSmoothing(1000)
+	bank.SetPeakingEQ(0, 48000, 1000, 1, 12)
+
+	target := bank.coeffs[0].target
+	buffer := [][]float32{make([]float32, 256)}
+	bank.Process(buffer)
+	if bank.coeffs[0].current == target {
+		t.Error("Coefficients should still be ramping after one block")
+	}
+
+	for i := 0; i < 4; i++ {
+		bank.Process(buffer)
+	}
+	if bank.coeffs[0].current != target || bank.coeffs[0].remaining != 0 {
+		t.Error("Coefficients should reach the target after the smoothing time")
+	}
+}
+
+func TestBiquadBankZeroAllocations(t *testing.T) {
+	bank := NewBiquadBank(6, 4)
+	bank.SetSmoothing(512)
+	buffers := make([][]float32, 6)
+	for ch := range buffers {
+		buffers[ch] = make([]float32, 512)
+	}
+
+	allocs := testing.AllocsPerRun(100, func() {
+		bank.SetPeakingEQ(2, 48000, 2000, 1, 3)
+		bank.Process(buffers)
+	})
+	if allocs != 0 {
+		t.Errorf("BiquadBank allocated %.1f times per block", allocs)
+	}
+}
+
+func BenchmarkBiquadBank(b *testing.B) {
+	const channels, sections = 6, 4
+	buffers := make([][]float32, channels)
+	for ch := range buffers {
+		buffers[ch] = make([]float32, 512)
+		for i := range buffers[ch] {
+			buffers[ch][i] = float32(math.Sin(float64(i) * 0.01))
+		}
+	}
+
+	b.Run("Bank", func(b *testing.B) {
+		bank := NewBiquadBank(channels, sections)
+		for m := 0; m < sections; m++ {
+			bank.SetPeakingEQ(m, 48000, 200*float64(m+1), 1, 3)
+		}
+		for i := 0; i < b.N; i++ {
+			bank.Process(buffers)
+		}
+	})
+
+	b.Run("Biquads", func(b *testing.B) {
+		filters := make([]*Biquad, sections)
+		for m := range filters {
+			filters[m] = NewBiquad(channels)
+			filters[m].SetPeakingEQ(48000, 200*float64(m+1), 1, 3)
+		}
+		for i := 0; i < b.N; i++ {
+			for _, f := range filters {
+				f.ProcessMulti(buffers)
+			}
+		}
+	})
+}
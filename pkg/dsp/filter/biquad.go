@@ -1,33 +1,52 @@
 // Package filter provides digital signal processing filters
 package filter
 
-import "math"
+import (
+	"math"
 
-// Biquad implements a second-order IIR filter (biquad)
+	"github.com/justyntemme/vst3go/pkg/dsp/sample"
+)
+
+// Biquad is the 32-bit biquad used by most processors
+type Biquad = BiquadOf[float32]
+
+// Biquad64 is the double-precision biquad for kSample64 processing
+type Biquad64 = BiquadOf[float64]
+
+// BiquadOf implements a second-order IIR filter (biquad) for either sample format
 // Direct Form I implementation with pre-allocated state
-type Biquad struct {
+type BiquadOf[T sample.Float] struct {
 	// Coefficients
-	a0, a1, a2 float32 // denominator (a0 is always normalized to 1.0)
-	b0, b1, b2 float32 // numerator
+	a0, a1, a2 T // denominator (a0 is always normalized to 1.0)
+	b0, b1, b2 T // numerator
 
 	// State variables (per-channel)
-	x1, x2 []float32 // input delay line
-	y1, y2 []float32 // output delay line
+	x1, x2 []T // input delay line
+	y1, y2 []T // output delay line
 }
 
 // NewBiquad creates a new biquad filter for the specified number of channels
 func NewBiquad(channels int) *Biquad {
-	return &Biquad{
+	return newBiquad[float32](channels)
+}
+
+// NewBiquad64 creates a new double-precision biquad filter for the specified number of channels
+func NewBiquad64(channels int) *Biquad64 {
+	return newBiquad[float64](channels)
+}
+
+func newBiquad[T sample.Float](channels int) *BiquadOf[T] {
+	return &BiquadOf[T]{
 		a0: 1.0,
-		x1: make([]float32, channels),
-		x2: make([]float32, channels),
-		y1: make([]float32, channels),
-		y2: make([]float32, channels),
+		x1: make([]T, channels),
+		x2: make([]T, channels),
+		y1: make([]T, channels),
+		y2: make([]T, channels),
 	}
 }
 
 // Reset clears the filter state
-func (b *Biquad) Reset() {
+func (b *BiquadOf[T]) Reset() {
 	for i := range b.x1 {
 		b.x1[i] = 0
 		b.x2[i] = 0
@@ -37,7 +56,7 @@ func (b *Biquad) Reset() {
 }
 
 // SetCoefficients sets the filter coefficients directly
-func (b *Biquad) SetCoefficients(b0, b1, b2, a0, a1, a2 float32) {
+func (b *BiquadOf[T]) SetCoefficients(b0, b1, b2, a0, a1, a2 T) {
 	// Normalize by a0
 	invA0 := 1.0 / a0
 	b.b0 = b0 * invA0
@@ -49,7 +68,7 @@ func (b *Biquad) SetCoefficients(b0, b1, b2, a0, a1, a2 float32) {
 }
 
 // Process applies the filter to a buffer (single channel) - no allocations
-func (b *Biquad) Process(buffer []float32, channel int) {
+func (b *BiquadOf[T]) Process(buffer []T, channel int) {
 	// Get state for this channel
 	x1 := b.x1[channel]
 	x2 := b.x2[channel]
@@ -80,7 +99,7 @@ func (b *Biquad) Process(buffer []float32, channel int) {
 }
 
 // ProcessMulti applies the filter to multiple channels - no allocations
-func (b *Biquad) ProcessMulti(buffers [][]float32) {
+func (b *BiquadOf[T]) ProcessMulti(buffers [][]T) {
 	for ch, buffer := range buffers {
 		if ch < len(b.x1) {
 			b.Process(buffer, ch)
@@ -90,8 +109,58 @@ func (b *Biquad) ProcessMulti(buffers [][]float32) {
 
 // Design functions for common filter types
 
+// biquadDesign holds unnormalized coefficients from a design function
+type biquadDesign struct {
+	b0, b1, b2, a0, a1, a2 float64
+}
+
+// setDesign applies coefficients from one of the design functions
+func (b *BiquadOf[T]) setDesign(d biquadDesign) {
+	b.SetCoefficients(T(d.b0), T(d.b1), T(d.b2), T(d.a0), T(d.a1), T(d.a2))
+}
+
 // SetLowpass configures as a lowpass filter
-func (b *Biquad) SetLowpass(sampleRate, frequency, q float64) {
+func (b *BiquadOf[T]) SetLowpass(sampleRate, frequency, q float64) {
+	b.setDesign(designLowpass(sampleRate, frequency, q))
+}
+
+// SetHighpass configures as a highpass filter
+func (b *BiquadOf[T]) SetHighpass(sampleRate, frequency, q float64) {
+	b.setDesign(designHighpass(sampleRate, frequency, q))
+}
+
+// SetBandpass configures as a bandpass filter (constant skirt gain)
+func (b *BiquadOf[T]) SetBandpass(sampleRate, frequency, q float64) {
+	b.setDesign(designBandpass(sampleRate, frequency, q))
+}
+
+// SetNotch configures as a notch (band-reject) filter
+func (b *BiquadOf[T]) SetNotch(sampleRate, frequency, q float64) {
+	b.setDesign(designNotch(sampleRate, frequency, q))
+}
+
+// SetAllpass configures as an allpass filter
+func (b *BiquadOf[T]) SetAllpass(sampleRate, frequency, q float64) {
+	b.setDesign(designAllpass(sampleRate, frequency, q))
+}
+
+// SetPeakingEQ configures as a peaking EQ filter
+func (b *BiquadOf[T]) SetPeakingEQ(sampleRate, frequency, q, gainDB float64) {
+	b.setDesign(designPeakingEQ(sampleRate, frequency, q, gainDB))
+}
+
+// SetLowShelf configures as a low shelf filter
+func (b *BiquadOf[T]) SetLowShelf(sampleRate, frequency, q, gainDB float64) {
+	b.setDesign(designLowShelf(sampleRate, frequency, q, gainDB))
+}
+
+// SetHighShelf configures as a high shelf filter
+func (b *BiquadOf[T]) SetHighShelf(sampleRate, frequency, q, gainDB float64) {
+	b.setDesign(designHighShelf(sampleRate, frequency, q, gainDB))
+}
+
+// designLowpass returns the coefficients of a lowpass filter
+func designLowpass(sampleRate, frequency, q float64) biquadDesign {
 	omega := 2.0 * math.Pi * frequency / sampleRate
 	sinOmega := math.Sin(omega)
 	cosOmega := math.Cos(omega)
@@ -104,12 +173,11 @@ func (b *Biquad) SetLowpass(sampleRate, frequency, q float64) {
 	a1 := -2.0 * cosOmega
 	a2 := 1.0 - alpha
 
-	b.SetCoefficients(float32(b0), float32(b1), float32(b2),
-		float32(a0), float32(a1), float32(a2))
+	return biquadDesign{b0, b1, b2, a0, a1, a2}
 }
 
-// SetHighpass configures as a highpass filter
-func (b *Biquad) SetHighpass(sampleRate, frequency, q float64) {
+// designHighpass returns the coefficients of a highpass filter
+func designHighpass(sampleRate, frequency, q float64) biquadDesign {
 	omega := 2.0 * math.Pi * frequency / sampleRate
 	sinOmega := math.Sin(omega)
 	cosOmega := math.Cos(omega)
@@ -122,12 +190,11 @@ func (b *Biquad) SetHighpass(sampleRate, frequency, q float64) {
 	a1 := -2.0 * cosOmega
 	a2 := 1.0 - alpha
 
-	b.SetCoefficients(float32(b0), float32(b1), float32(b2),
-		float32(a0), float32(a1), float32(a2))
+	return biquadDesign{b0, b1, b2, a0, a1, a2}
 }
 
-// SetBandpass configures as a bandpass filter (constant skirt gain)
-func (b *Biquad) SetBandpass(sampleRate, frequency, q float64) {
+// designBandpass returns the coefficients of a bandpass filter (constant skirt gain)
+func designBandpass(sampleRate, frequency, q float64) biquadDesign {
 	omega := 2.0 * math.Pi * frequency / sampleRate
 	sinOmega := math.Sin(omega)
 	cosOmega := math.Cos(omega)
@@ -140,12 +207,11 @@ func (b *Biquad) SetBandpass(sampleRate, frequency, q float64) {
 	a1 := -2.0 * cosOmega
 	a2 := 1.0 - alpha
 
-	b.SetCoefficients(float32(b0), float32(b1), float32(b2),
-		float32(a0), float32(a1), float32(a2))
+	return biquadDesign{b0, b1, b2, a0, a1, a2}
 }
 
-// SetNotch configures as a notch (band-reject) filter
-func (b *Biquad) SetNotch(sampleRate, frequency, q float64) {
+// designNotch returns the coefficients of a notch (band-reject) filter
+func designNotch(sampleRate, frequency, q float64) biquadDesign {
 	omega := 2.0 * math.Pi * frequency / sampleRate
 	sinOmega := math.Sin(omega)
 	cosOmega := math.Cos(omega)
@@ -158,12 +224,11 @@ func (b *Biquad) SetNotch(sampleRate, frequency, q float64) {
 	a1 := -2.0 * cosOmega
 	a2 := 1.0 - alpha
 
-	b.SetCoefficients(float32(b0), float32(b1), float32(b2),
-		float32(a0), float32(a1), float32(a2))
+	return biquadDesign{b0, b1, b2, a0, a1, a2}
 }
 
-// SetAllpass configures as an allpass filter
-func (b *Biquad) SetAllpass(sampleRate, frequency, q float64) {
+// designAllpass returns the coefficients of an allpass filter
+func designAllpass(sampleRate, frequency, q float64) biquadDesign {
 	omega := 2.0 * math.Pi * frequency / sampleRate
 	sinOmega := math.Sin(omega)
 	cosOmega := math.Cos(omega)
@@ -176,12 +241,11 @@ func (b *Biquad) SetAllpass(sampleRate, frequency, q float64) {
 	a1 := -2.0 * cosOmega
 	a2 := 1.0 - alpha
 
-	b.SetCoefficients(float32(b0), float32(b1), float32(b2),
-		float32(a0), float32(a1), float32(a2))
+	return biquadDesign{b0, b1, b2, a0, a1, a2}
 }
 
-// SetPeakingEQ configures as a peaking EQ filter
-func (b *Biquad) SetPeakingEQ(sampleRate, frequency, q, gainDB float64) {
+// designPeakingEQ returns the coefficients of a peaking EQ filter
+func designPeakingEQ(sampleRate, frequency, q, gainDB float64) biquadDesign {
 	omega := 2.0 * math.Pi * frequency / sampleRate
 	sinOmega := math.Sin(omega)
 	cosOmega := math.Cos(omega)
@@ -195,12 +259,11 @@ func (b *Biquad) SetPeakingEQ(sampleRate, frequency, q, gainDB float64) {
 	a1 := -2.0 * cosOmega
 	a2 := 1.0 - alpha/A
 
-	b.SetCoefficients(float32(b0), float32(b1), float32(b2),
-		float32(a0), float32(a1), float32(a2))
+	return biquadDesign{b0, b1, b2, a0, a1, a2}
 }
 
-// SetLowShelf configures as a low shelf filter
-func (b *Biquad) SetLowShelf(sampleRate, frequency, q, gainDB float64) {
+// designLowShelf returns the coefficients of a low shelf filter
+func designLowShelf(sampleRate, frequency, q, gainDB float64) biquadDesign {
 	omega := 2.0 * math.Pi * frequency / sampleRate
 	sinOmega := math.Sin(omega)
 	cosOmega := math.Cos(omega)
@@ -217,12 +280,11 @@ func (b *Biquad) SetLowShelf(sampleRate, frequency, q, gainDB float64) {
 	a1 := -2.0 * ((A - 1) + (A+1)*cosOmega)
 	a2 := (A + 1) + (A-1)*cosOmega - sqrtAAlpha
 
-	b.SetCoefficients(float32(b0), float32(b1), float32(b2),
-		float32(a0), float32(a1), float32(a2))
+	return biquadDesign{b0, b1, b2, a0, a1, a2}
 }
 
-// SetHighShelf configures as a high shelf filter
-func (b *Biquad) SetHighShelf(sampleRate, frequency, q, gainDB float64) {
+// designHighShelf returns the coefficients of a high shelf filter
+func designHighShelf(sampleRate, frequency, q, gainDB float64) biquadDesign {
 	omega := 2.0 * math.Pi * frequency / sampleRate
 	sinOmega := math.Sin(omega)
 	cosOmega := math.Cos(omega)
@@ -239,6 +301,5 @@ func (b *Biquad) SetHighShelf(sampleRate, frequency, q, gainDB float64) {
 	a1 := 2.0 * ((A - 1) - (A+1)*cosOmega)
 	a2 := (A + 1) - (A-1)*cosOmega - sqrtAAlpha
 
-	b.SetCoefficients(float32(b0), float32(b1), float32(b2),
-		float32(a0), float32(a1), float32(a2))
+	return biquadDesign{b0, b1, b2, a0, a1, a2}
 }
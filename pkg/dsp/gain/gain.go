@@ -3,6 +3,9 @@ package gain
 
 import (
 	"math"
+
+	"github.com/justyntemme/vst3go/pkg/dsp/internal/simd"
+	"github.com/justyntemme/vst3go/pkg/dsp/sample"
 )
 
 // Constants for dB conversion
@@ -49,8 +52,8 @@ func DbToLinear32(db float32) float32 {
 }
 
 // Apply applies a gain factor to a sample.
-func Apply(sample, gain float32) float32 {
-	return sample * gain
+func Apply[T sample.Float](s, gain T) T {
+	return s * gain
 }
 
 // ApplyDb applies a dB gain to a sample.
@@ -59,7 +62,12 @@ func ApplyDb(sample float32, db float32) float32 {
 }
 
 // ApplyBuffer applies gain to an entire buffer in-place.
-func ApplyBuffer(buffer []float32, gain float32) {
+// float32 buffers use the vectorized kernel.
+func ApplyBuffer[T sample.Float](buffer []T, gain T) {
+	if b, ok := any(buffer).([]float32); ok {
+		simd.Scale(b, float32(gain))
+		return
+	}
 	for i := range buffer {
 		buffer[i] *= gain
 	}
@@ -71,8 +79,18 @@ func ApplyDbBuffer(buffer []float32, db float32) {
 	ApplyBuffer(buffer, gain)
 }
 
+// ApplyDbBuffer64 is the float64 version of ApplyDbBuffer.
+func ApplyDbBuffer64(buffer []float64, db float64) {
+	ApplyBuffer(buffer, DbToLinear(db))
+}
+
 // ApplyBufferTo applies gain to a buffer and stores in destination.
-func ApplyBufferTo(src []float32, gain float32, dst []float32) {
+// float32 buffers use the vectorized kernel.
+func ApplyBufferTo[T sample.Float](src []T, gain T, dst []T) {
+	if s, ok := any(src).([]float32); ok {
+		simd.ScaleTo(any(dst).([]float32), s, float32(gain))
+		return
+	}
 	length := len(src)
 	if len(dst) < length {
 		length = len(dst)
@@ -84,12 +102,12 @@ func ApplyBufferTo(src []float32, gain float32, dst []float32) {
 }
 
 // Fade applies a linear fade between two gain values.
-func Fade(buffer []float32, startGain, endGain float32) {
+func Fade[T sample.Float](buffer []T, startGain, endGain T) {
 	if len(buffer) == 0 {
 		return
 	}
 	
-	samples := float32(len(buffer) - 1)
+	samples := T(len(buffer) - 1)
 	if samples <= 0 {
 		buffer[0] *= startGain
 		return
@@ -131,7 +149,7 @@ func SoftClipBuffer(buffer []float32, threshold float32) {
 }
 
 // HardClip applies hard clipping to limit signal amplitude.
-func HardClip(input, threshold float32) float32 {
+func HardClip[T sample.Float](input, threshold T) T {
 	if input > threshold {
 		return threshold
 	}
@@ -142,7 +160,7 @@ func HardClip(input, threshold float32) float32 {
 }
 
 // HardClipBuffer applies hard clipping to an entire buffer.
-func HardClipBuffer(buffer []float32, threshold float32) {
+func HardClipBuffer[T sample.Float](buffer []T, threshold T) {
 	for i := range buffer {
 		buffer[i] = HardClip(buffer[i], threshold)
 	}
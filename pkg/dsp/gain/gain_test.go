@@ -92,6 +92,26 @@ func TestApplyBuffer(t *testing.T) {
 	}
 }
 
+func TestApplyBuffer64(t *testing.T) {
+	buffer := []float64{1.0, 0.5, -0.5, -1.0}
+	expected := []float64{0.5, 0.25, -0.25, -0.5}
+
+	ApplyBuffer(buffer, 0.5)
+
+	for i, v := range buffer {
+		if v != expected[i] {
+			t.Errorf("ApplyBuffer (float64): buffer[%d] = %f, want %f", i, v, expected[i])
+		}
+	}
+
+	// dB variant should keep full double precision
+	buffer = []float64{1.0}
+	ApplyDbBuffer64(buffer, -6.0)
+	if math.Abs(buffer[0]-DbToLinear(-6.0)) > 1e-12 {
+		t.Errorf("ApplyDbBuffer64: got %.15f, want %.15f", buffer[0], DbToLinear(-6.0))
+	}
+}
+
 func TestFade(t *testing.T) {
 	buffer := []float32{1.0, 1.0, 1.0, 1.0}
 	startGain := float32(0.0)
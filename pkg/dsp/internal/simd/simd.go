@@ -0,0 +1,118 @@
+// Package simd provides vectorized float32 buffer kernels for the dsp
+// packages. Each kernel runs an assembly fast path when the CPU supports it
+// (AVX2 with FMA on amd64) and finishes the remainder, or the whole buffer on
+// other platforms, with the portable Go loop.
+package simd
+
+// accelerated is true when the assembly kernels are in use
+var accelerated = hasAccel
+
+// Level names the active kernel set
+func Level() string {
+	if accelerated {
+		return accelName
+	}
+	return "generic"
+}
+
+// SetAccelerated enables or disables the assembly kernels, for comparing
+// against the generic path. It returns the previous setting. Enabling has no
+// effect when the CPU lacks the required features.
+func SetAccelerated(enabled bool) bool {
+	previous := accelerated
+	accelerated = enabled && hasAccel
+	return previous
+}
+
+// Add computes dst[i] += src[i]
+func Add(dst, src []float32) {
+	ScaleAdd(dst, src, 1)
+}
+
+// ScaleAdd computes dst[i] += src[i] * scale
+func ScaleAdd(dst, src []float32, scale float32) {
+	n := len(dst)
+	if len(src) < n {
+		n = len(src)
+	}
+	i := 0
+	if accelerated {
+		i = scaleAddAccel(dst[:n], src[:n], scale)
+	}
+	for ; i < n; i++ {
+		dst[i] += src[i] * scale
+	}
+}
+
+// Scale computes buffer[i] *= scale
+func Scale(buffer []float32, scale float32) {
+	ScaleTo(buffer, buffer, scale)
+}
+
+// ScaleTo computes dst[i] = src[i] * scale
+func ScaleTo(dst, src []float32, scale float32) {
+	n := len(dst)
+	if len(src) < n {
+		n = len(src)
+	}
+	i := 0
+	if accelerated {
+		i = scaleToAccel(dst[:n], src[:n], scale)
+	}
+	for ; i < n; i++ {
+		dst[i] = src[i] * scale
+	}
+}
+
+// Mix computes dst[i] = a[i]*gainA + b[i]*gainB
+func Mix(dst, a, b []float32, gainA, gainB float32) {
+	n := len(dst)
+	if len(a) < n {
+		n = len(a)
+	}
+	if len(b) < n {
+		n = len(b)
+	}
+	i := 0
+	if accelerated {
+		i = mixAccel(dst[:n], a[:n], b[:n], gainA, gainB)
+	}
+	for ; i < n; i++ {
+		dst[i] = a[i]*gainA + b[i]*gainB
+	}
+}
+
+// PeakSumSquares returns the largest absolute sample and the sum of squares
+// in a single pass
+func PeakSumSquares(buffer []float32) (peak, sum float32) {
+	i := 0
+	if accelerated {
+		i, peak, sum = peakSumSquaresAccel(buffer)
+	}
+	for ; i < len(buffer); i++ {
+		x := buffer[i]
+		sum += x * x
+		if x < 0 {
+			x = -x
+		}
+		if x > peak {
+			peak = x
+		}
+	}
+	return peak, sum
+}
+
+// Clamp limits every sample to [lo, hi]
+func Clamp(buffer []float32, lo, hi float32) {
+	i := 0
+	if accelerated {
+		i = clampAccel(buffer, lo, hi)
+	}
+	for ; i < len(buffer); i++ {
+		if buffer[i] > hi {
+			buffer[i] = hi
+		} else if buffer[i] < lo {
+			buffer[i] = lo
+		}
+	}
+}
@@ -0,0 +1,100 @@
+//go:build amd64 && !purego
+
+package simd
+
+const accelName = "avx2"
+
+var hasAccel = detectAVX2()
+
+// detectAVX2 reports AVX2 and FMA support, including OS support for the
+// YMM register state
+func detectAVX2() bool {
+	maxLeaf, _, _, _ := cpuid(0, 0)
+	if maxLeaf < 7 {
+		return false
+	}
+
+	_, _, ecx1, _ := cpuid(1, 0)
+	const (
+		fma     = 1 << 12
+		osxsave = 1 << 27
+		avx     = 1 << 28
+	)
+	if ecx1&(fma|osxsave|avx) != fma|osxsave|avx {
+		return false
+	}
+
+	// XMM and YMM state enabled by the OS
+	if xcr0, _ := xgetbv(); xcr0&6 != 6 {
+		return false
+	}
+
+	_, ebx7, _, _ := cpuid(7, 0)
+	const avx2 = 1 << 5
+	return ebx7&avx2 != 0
+}
+
+//go:noescape
+func cpuid(eaxArg, ecxArg uint32) (eax, ebx, ecx, edx uint32)
+
+//go:noescape
+func xgetbv() (eax, edx uint32)
+
+//go:noescape
+func scaleAddAVX2(dst, src *float32, n int, scale float32)
+
+//go:noescape
+func scaleToAVX2(dst, src *float32, n int, scale float32)
+
+//go:noescape
+func mixAVX2(dst, a, b *float32, n int, gainA, gainB float32)
+
+//go:noescape
+func peakSumSquaresAVX2(src *float32, n int) (peak, sum float32)
+
+//go:noescape
+func clampAVX2(buffer *float32, n int, lo, hi float32)
+
+// The Accel wrappers run whole 8-sample vectors and return how many samples
+// they processed; the caller finishes the tail
+
+func scaleAddAccel(dst, src []float32, scale float32) int {
+	n := len(dst) &^ 7
+	if n > 0 {
+		scaleAddAVX2(&dst[0], &src[0], n, scale)
+	}
+	return n
+}
+
+func scaleToAccel(dst, src []float32, scale float32) int {
+	n := len(dst) &^ 7
+	if n > 0 {
+		scaleToAVX2(&dst[0], &src[0], n, scale)
+	}
+	return n
+}
+
+func mixAccel(dst, a, b []float32, gainA, gainB float32) int {
+	n := len(dst) &^ 7
+	if n > 0 {
+		mixAVX2(&dst[0], &a[0], &b[0], n, gainA, gainB)
+	}
+	return n
+}
+
+func peakSumSquaresAccel(buffer []float32) (int, float32, float32) {
+	n := len(buffer) &^ 7
+	if n == 0 {
+		return 0, 0, 0
+	}
+	peak, sum := peakSumSquaresAVX2(&buffer[0], n)
+	return n, peak, sum
+}
+
+func clampAccel(buffer []float32, lo, hi float32) int {
+	n := len(buffer) &^ 7
+	if n > 0 {
+		clampAVX2(&buffer[0], n, lo, hi)
+	}
+	return n
+}
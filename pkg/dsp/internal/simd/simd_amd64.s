@@ -0,0 +1,216 @@
+//go:build amd64 && !purego
+
+#include "textflag.h"
+
+// func cpuid(eaxArg, ecxArg uint32) (eax, ebx, ecx, edx uint32)
+TEXT ·cpuid(SB), NOSPLIT, $0-24
+	MOVL eaxArg+0(FP), AX
+	MOVL ecxArg+4(FP), CX
+	CPUID
+	MOVL AX, eax+8(FP)
+	MOVL BX, ebx+12(FP)
+	MOVL CX, ecx+16(FP)
+	MOVL DX, edx+20(FP)
+	RET
+
+// func xgetbv() (eax, edx uint32)
+TEXT ·xgetbv(SB), NOSPLIT, $0-8
+	MOVL $0, CX
+	XGETBV
+	MOVL AX, eax+0(FP)
+	MOVL DX, edx+4(FP)
+	RET
+
+// The kernels below require n to be a multiple of 8. They run two vectors
+// per iteration and finish with a single vector when n is an odd multiple.
+
+// func scaleAddAVX2(dst, src *float32, n int, scale float32)
+TEXT ·scaleAddAVX2(SB), NOSPLIT, $0-28
+	MOVQ dst+0(FP), DI
+	MOVQ src+8(FP), SI
+	MOVQ n+16(FP), CX
+	VBROADCASTSS scale+24(FP), Y15
+
+scaleAddLoop:
+	CMPQ CX, $16
+	JL   scaleAddTail
+	VMOVUPS (DI), Y0
+	VMOVUPS 32(DI), Y1
+	VFMADD231PS (SI), Y15, Y0
+	VFMADD231PS 32(SI), Y15, Y1
+	VMOVUPS Y0, (DI)
+	VMOVUPS Y1, 32(DI)
+	ADDQ $64, DI
+	ADDQ $64, SI
+	SUBQ $16, CX
+	JMP  scaleAddLoop
+
+scaleAddTail:
+	CMPQ CX, $8
+	JL   scaleAddDone
+	VMOVUPS (DI), Y0
+	VFMADD231PS (SI), Y15, Y0
+	VMOVUPS Y0, (DI)
+
+scaleAddDone:
+	VZEROUPPER
+	RET
+
+// func scaleToAVX2(dst, src *float32, n int, scale float32)
+TEXT ·scaleToAVX2(SB), NOSPLIT, $0-28
+	MOVQ dst+0(FP), DI
+	MOVQ src+8(FP), SI
+	MOVQ n+16(FP), CX
+	VBROADCASTSS scale+24(FP), Y15
+
+scaleToLoop:
+	CMPQ CX, $16
+	JL   scaleToTail
+	VMULPS (SI), Y15, Y0
+	VMULPS 32(SI), Y15, Y1
+	VMOVUPS Y0, (DI)
+	VMOVUPS Y1, 32(DI)
+	ADDQ $64, DI
+	ADDQ $64, SI
+	SUBQ $16, CX
+	JMP  scaleToLoop
+
+scaleToTail:
+	CMPQ CX, $8
+	JL   scaleToDone
+	VMULPS (SI), Y15, Y0
+	VMOVUPS Y0, (DI)
+
+scaleToDone:
+	VZEROUPPER
+	RET
+
+// func mixAVX2(dst, a, b *float32, n int, gainA, gainB float32)
+TEXT ·mixAVX2(SB), NOSPLIT, $0-40
+	MOVQ dst+0(FP), DI
+	MOVQ a+8(FP), SI
+	MOVQ b+16(FP), DX
+	MOVQ n+24(FP), CX
+	VBROADCASTSS gainA+32(FP), Y14
+	VBROADCASTSS gainB+36(FP), Y15
+
+mixLoop:
+	CMPQ CX, $16
+	JL   mixTail
+	VMULPS (SI), Y14, Y0
+	VMULPS 32(SI), Y14, Y1
+	VFMADD231PS (DX), Y15, Y0
+	VFMADD231PS 32(DX), Y15, Y1
+	VMOVUPS Y0, (DI)
+	VMOVUPS Y1, 32(DI)
+	ADDQ $64, DI
+	ADDQ $64, SI
+	ADDQ $64, DX
+	SUBQ $16, CX
+	JMP  mixLoop
+
+mixTail:
+	CMPQ CX, $8
+	JL   mixDone
+	VMULPS (SI), Y14, Y0
+	VFMADD231PS (DX), Y15, Y0
+	VMOVUPS Y0, (DI)
+
+mixDone:
+	VZEROUPPER
+	RET
+
+// func peakSumSquaresAVX2(src *float32, n int) (peak, sum float32)
+TEXT ·peakSumSquaresAVX2(SB), NOSPLIT, $0-24
+	MOVQ src+0(FP), SI
+	MOVQ n+8(FP), CX
+
+	// Sign-clearing mask for absolute values
+	MOVL $0x7fffffff, AX
+	VMOVD AX, X15
+	VPBROADCASTD X15, Y15
+
+	VXORPS Y0, Y0, Y0 // Peak accumulators
+	VXORPS Y1, Y1, Y1
+	VXORPS Y2, Y2, Y2 // Sum-of-squares accumulators
+	VXORPS Y3, Y3, Y3
+
+peakLoop:
+	CMPQ CX, $16
+	JL   peakTail
+	VMOVUPS (SI), Y4
+	VMOVUPS 32(SI), Y5
+	VFMADD231PS Y4, Y4, Y2
+	VFMADD231PS Y5, Y5, Y3
+	VANDPS Y15, Y4, Y4
+	VANDPS Y15, Y5, Y5
+	VMAXPS Y4, Y0, Y0
+	VMAXPS Y5, Y1, Y1
+	ADDQ $64, SI
+	SUBQ $16, CX
+	JMP  peakLoop
+
+peakTail:
+	CMPQ CX, $8
+	JL   peakReduce
+	VMOVUPS (SI), Y4
+	VFMADD231PS Y4, Y4, Y2
+	VANDPS Y15, Y4, Y4
+	VMAXPS Y4, Y0, Y0
+
+peakReduce:
+	VMAXPS Y1, Y0, Y0
+	VADDPS Y3, Y2, Y2
+
+	VEXTRACTF128 $1, Y0, X1
+	VMAXPS X1, X0, X0
+	VMOVHLPS X0, X0, X1
+	VMAXPS X1, X0, X0
+	VPSHUFD $1, X0, X1
+	VMAXSS X1, X0, X0
+	VMOVSS X0, peak+16(FP)
+
+	VEXTRACTF128 $1, Y2, X3
+	VADDPS X3, X2, X2
+	VMOVHLPS X2, X2, X3
+	VADDPS X3, X2, X2
+	VPSHUFD $1, X2, X3
+	VADDSS X3, X2, X2
+	VMOVSS X2, sum+20(FP)
+
+	VZEROUPPER
+	RET
+
+// func clampAVX2(buffer *float32, n int, lo, hi float32)
+TEXT ·clampAVX2(SB), NOSPLIT, $0-24
+	MOVQ buffer+0(FP), DI
+	MOVQ n+8(FP), CX
+	VBROADCASTSS lo+16(FP), Y14
+	VBROADCASTSS hi+20(FP), Y15
+
+clampLoop:
+	CMPQ CX, $16
+	JL   clampTail
+	VMOVUPS (DI), Y0
+	VMOVUPS 32(DI), Y1
+	VMINPS Y15, Y0, Y0
+	VMINPS Y15, Y1, Y1
+	VMAXPS Y14, Y0, Y0
+	VMAXPS Y14, Y1, Y1
+	VMOVUPS Y0, (DI)
+	VMOVUPS Y1, 32(DI)
+	ADDQ $64, DI
+	SUBQ $16, CX
+	JMP  clampLoop
+
+clampTail:
+	CMPQ CX, $8
+	JL   clampDone
+	VMOVUPS (DI), Y0
+	VMINPS Y15, Y0, Y0
+	VMAXPS Y14, Y0, Y0
+	VMOVUPS Y0, (DI)
+
+clampDone:
+	VZEROUPPER
+	RET
@@ -0,0 +1,19 @@
+//go:build !amd64 || purego
+
+package simd
+
+// Without an assembly kernel set every call takes the Go loop
+
+const accelName = "generic"
+
+const hasAccel = false
+
+func scaleAddAccel(dst, src []float32, scale float32) int { return 0 }
+
+func scaleToAccel(dst, src []float32, scale float32) int { return 0 }
+
+func mixAccel(dst, a, b []float32, gainA, gainB float32) int { return 0 }
+
+func peakSumSquaresAccel(buffer []float32) (int, float32, float32) { return 0, 0, 0 }
+
+func clampAccel(buffer []float32, lo, hi float32) int { return 0 }
@@ -0,0 +1,101 @@
+package simd
+
+import (
+	"math"
+	"testing"
+)
+
+// testLengths cover empty input, pure tails, single vectors and odd tails
+var testLengths = []int{0, 1, 7, 8, 9, 15, 16, 17, 31, 64, 100, 513}
+
+func testSignal(n, seed int) []float32 {
+	buffer := make([]float32, n)
+	for i := range buffer {
+		buffer[i] = float32(math.Sin(float64(i*(seed+3))*0.37)) * 1.5
+	}
+	return buffer
+}
+
+func assertClose(t *testing.T, name string, got, want []float32) {
+	t.Helper()
+	for i := range want {
+		if diff := math.Abs(float64(got[i] - want[i])); diff > 1e-6 {
+			t.Fatalf("%s: sample %d got %f, want %f", name, i, got[i], want[i])
+		}
+	}
+}
+
+// forEachLevel runs fn with the assembly kernels and with the generic path
+func forEachLevel(t *testing.T, fn func(t *testing.T)) {
+	previous := SetAccelerated(true)
+	defer SetAccelerated(previous)
+
+	t.Run(Level(), fn)
+	SetAccelerated(false)
+	t.Run("generic", fn)
+}
+
+func TestKernels(t *testing.T) {
+	forEachLevel(t, func(t *testing.T) {
+		for _, n := range testLengths {
+			// Offset views exercise unaligned starts
+			for _, offset := range []int{0, 1, 3} {
+				a := testSignal(n+offset, 1)[offset:]
+				b := testSignal(n+offset, 2)[offset:]
+
+				got := append([]float32(nil), a...)
+				ScaleAdd(got, b, 0.7)
+				want := make([]float32, n)
+				for i := range want {
+					want[i] = a[i] + b[i]*0.7
+				}
+				assertClose(t, "ScaleAdd", got, want)
+
+				ScaleTo(got, a, -0.25)
+				for i := range want {
+					want[i] = a[i] * -0.25
+				}
+				assertClose(t, "ScaleTo", got, want)
+
+				Mix(got, a, b, 0.3, 0.6)
+				for i := range want {
+					want[i] = a[i]*0.3 + b[i]*0.6
+				}
+				assertClose(t, "Mix", got, want)
+
+				copy(got, a)
+				Clamp(got, -0.5, 0.8)
+				for i := range want {
+					want[i] = float32(math.Max(-0.5, math.Min(0.8, float64(a[i]))))
+				}
+				assertClose(t, "Clamp", got, want)
+
+				var wantPeak, wantSum float64
+				for _, x := range a {
+					wantPeak = math.Max(wantPeak, math.Abs(float64(x)))
+					wantSum += float64(x) * float64(x)
+				}
+				peak, sum := PeakSumSquares(a)
+				if float64(peak) != wantPeak {
+					t.Errorf("n=%d: peak %f, want %f", n, peak, wantPeak)
+				}
+				if math.Abs(float64(sum)-wantSum) > 1e-4*(1+wantSum) {
+					t.Errorf("n=%d: sum of squares %f, want %f", n, sum, wantSum)
+				}
+			}
+		}
+	})
+}
+
+func TestKernelsStayInBounds(t *testing.T) {
+	forEachLevel(t, func(t *testing.T) {
+		backing := testSignal(40, 4)
+		guard := backing[33]
+		view := backing[:33]
+		Scale(view, 2)
+		Clamp(view, -0.1, 0.1)
+		if backing[33] != guard {
+			t.Error("Kernel wrote past the end of the slice")
+		}
+	})
+}
@@ -111,13 +111,14 @@ func NewAllPass() *AllPass {
 }
 
 // Process interpolates using all-pass filtering.
-// Suitable for fractional delay lines.
+// Suitable for fractional delay lines: input is the sample at the integer
+// part of the delay and the filter adds frac samples of delay.
 func (ap *AllPass) Process(input, frac float32) float32 {
 	// All-pass coefficient
 	a := (1 - frac) / (1 + frac)
 	
-	// All-pass filter
-	output := input + a*ap.x1 - a*ap.y1
+	// First-order all-pass: H(z) = (a + z^-1) / (1 + a*z^-1)
+	output := a*input + ap.x1 - a*ap.y1
 	
 	// Update state
 	ap.x1 = input
@@ -2,6 +2,17 @@ package modulation
 
 import (
 	"math"
+
+	"github.com/justyntemme/vst3go/pkg/dsp/delay"
+)
+
+// maxChorusVoices is the most voices SetVoices accepts
+const maxChorusVoices = 4
+
+// Ranges of SetDelay and SetDepth in milliseconds
+const (
+	chorusMaxDelayMs = 50.0
+	chorusMaxDepthMs = 10.0
 )
 
 // Chorus implements a multi-voice chorus effect
@@ -17,14 +28,23 @@ type Chorus struct {
 	spread   float64 // Stereo spread (0-1)
 	voices   int     // Number of chorus voices
 
-	// Delay lines for each voice (stereo)
-	delayLinesL     [][]float32
-	delayLinesR     [][]float32
-	delayIndex      int
-	maxDelaySamples int
+	// One delay line per channel, tapped by every voice. They are sized
+	// for the longest delay and depth, so settings never reallocate them.
+	lineL, lineR *delay.Line
+	maxDelay     float64 // Longest voice delay in samples
 
-	// LFOs for each voice
-	lfos []*LFO
+	// One chunk of voice delays, delayed samples and wet sums
+	delays     []float32
+	tap        []float32
+	wetL, wetR []float32
+
+	// LFOs for each voice and one chunk of their rendered output
+	lfos       []*LFO
+	modulation [maxChorusVoices][]float32
+
+	// Per-voice pan gains, including the 1/voices level scaling
+	panL [maxChorusVoices]float32
+	panR [maxChorusVoices]float32
 
 	// Feedback state
 	feedbackL float32
@@ -43,10 +63,22 @@ func NewChorus(sampleRate float64) *Chorus {
 		spread:     1.0,
 		voices:     2,
 	}
+	for v := range c.modulation {
+		c.modulation[v] = make([]float32, modulationChunk)
+	}
+
+	// Longest base delay plus deepest modulation, and room for a chunk
+	maxDelay := int((chorusMaxDelayMs + chorusMaxDepthMs) * sampleRate / 1000.0)
+	c.lineL = delay.NewSamples(maxDelay + modulationChunk)
+	c.lineR = delay.NewSamples(maxDelay + modulationChunk)
+	c.maxDelay = float64(maxDelay)
+	c.delays = make([]float32, modulationChunk)
+	c.tap = make([]float32, modulationChunk)
+	c.wetL = make([]float32, modulationChunk)
+	c.wetR = make([]float32, modulationChunk)
 
 	// Initialize with default voices
 	c.SetVoices(2)
-	c.updateDelayLines()
 
 	return c
 }
@@ -61,13 +93,12 @@ func (c *Chorus) SetRate(hz float64) {
 
 // SetDepth sets the modulation depth in milliseconds
 func (c *Chorus) SetDepth(ms float64) {
-	c.depth = math.Max(0.0, math.Min(10.0, ms))
+	c.depth = math.Max(0.0, math.Min(chorusMaxDepthMs, ms))
 }
 
 // SetDelay sets the base delay time in milliseconds
 func (c *Chorus) SetDelay(ms float64) {
-	c.delay = math.Max(1.0, math.Min(50.0, ms))
-	c.updateDelayLines()
+	c.delay = math.Max(1.0, math.Min(chorusMaxDelayMs, ms))
 }
 
 // SetMix sets the wet/dry mix (0=dry, 1=wet)
@@ -83,11 +114,12 @@ func (c *Chorus) SetFeedback(feedback float64) {
 // SetSpread sets the stereo spread
 func (c *Chorus) SetSpread(spread float64) {
 	c.spread = math.Max(0.0, math.Min(1.0, spread))
+	c.updatePan()
 }
 
 // SetVoices sets the number of chorus voices (1-4)
 func (c *Chorus) SetVoices(voices int) {
-	c.voices = max(1, min(4, voices))
+	c.voices = max(1, min(maxChorusVoices, voices))
 
 	// Create LFOs for each voice
 	c.lfos = make([]*LFO, c.voices)
@@ -101,30 +133,20 @@ func (c *Chorus) SetVoices(voices int) {
 		c.lfos[i].SetPhase(phase)
 	}
 
-	c.updateDelayLines()
+	c.updatePan()
 }
 
-// updateDelayLines updates the delay line buffers
-func (c *Chorus) updateDelayLines() {
-	// Calculate maximum delay needed (base + modulation depth)
-	maxDelayMs := c.delay + c.depth
-	c.maxDelaySamples = int(maxDelayMs * c.sampleRate / 1000.0)
-
-	// Add some headroom
-	c.maxDelaySamples = int(float64(c.maxDelaySamples) * 1.2)
-
-	// Create delay lines for each voice
-	c.delayLinesL = make([][]float32, c.voices)
-	c.delayLinesR = make([][]float32, c.voices)
-
-	for i := 0; i < c.voices; i++ {
-		c.delayLinesL[i] = make([]float32, c.maxDelaySamples)
-		c.delayLinesR[i] = make([]float32, c.maxDelaySamples)
+// updatePan spreads the voices across the stereo field
+func (c *Chorus) updatePan() {
+	if c.voices == 1 {
+		c.panL[0], c.panR[0] = 1, 1
+		return
+	}
+	for v := 0; v < c.voices; v++ {
+		pan := (float64(v)/float64(c.voices-1) - 0.5) * c.spread
+		c.panL[v] = float32(math.Cos((pan+0.5)*math.Pi/2) / float64(c.voices))
+		c.panR[v] = float32(math.Sin((pan+0.5)*math.Pi/2) / float64(c.voices))
 	}
-
-	c.delayIndex = 0
-	c.feedbackL = 0
-	c.feedbackR = 0
 }
 
 // Process processes mono input
@@ -135,66 +157,36 @@ func (c *Chorus) Process(input float32) (outputL, outputR float32) {
 
 // ProcessStereo processes stereo input
 func (c *Chorus) ProcessStereo(inputL, inputR float32) (outputL, outputR float32) {
+	// Get modulation from each voice's LFO (±1)
+	var modulation [maxChorusVoices]float32
+	for v := 0; v < c.voices; v++ {
+		modulation[v] = float32(c.lfos[v].Process())
+	}
+	return c.chorus(inputL, inputR, &modulation)
+}
+
+// chorus processes one stereo sample with the given per-voice modulation
+func (c *Chorus) chorus(inputL, inputR float32, modulation *[maxChorusVoices]float32) (outputL, outputR float32) {
 	// Start with dry signal
 	outputL = inputL * float32(1.0-c.mix)
 	outputR = inputR * float32(1.0-c.mix)
 
 	// Mix of input and feedback for delay lines
-	delayInputL := inputL + c.feedbackL*float32(c.feedback)
-	delayInputR := inputR + c.feedbackR*float32(c.feedback)
-
-	// Write to delay lines
-	for v := 0; v < c.voices; v++ {
-		c.delayLinesL[v][c.delayIndex] = delayInputL
-		c.delayLinesR[v][c.delayIndex] = delayInputR
-	}
+	c.lineL.Write(inputL + c.feedbackL*float32(c.feedback))
+	c.lineR.Write(inputR + c.feedbackR*float32(c.feedback))
 
 	// Process each voice
 	wetL := float32(0)
 	wetR := float32(0)
 
 	for v := 0; v < c.voices; v++ {
-		// Get modulation from LFO (±1)
-		modulation := c.lfos[v].Process()
-
 		// Calculate delay time in samples
-		delayMs := c.delay + c.depth*modulation
-		delaySamples := delayMs * c.sampleRate / 1000.0
-
-		// Ensure delay is within bounds
-		delaySamples = math.Max(1.0, math.Min(float64(c.maxDelaySamples-1), delaySamples))
-
-		// Calculate read position with linear interpolation
-		readPos := float64(c.delayIndex) - delaySamples
-		if readPos < 0 {
-			readPos += float64(c.maxDelaySamples)
-		}
+		delayMs := c.delay + c.depth*float64(modulation[v])
+		delaySamples := math.Max(1.0, math.Min(c.maxDelay, delayMs*c.sampleRate/1000.0))
 
-		// Get integer and fractional parts
-		readIdx := int(readPos)
-		frac := float32(readPos - float64(readIdx))
-
-		// Linear interpolation for left channel
-		idx1 := readIdx % c.maxDelaySamples
-		idx2 := (readIdx + 1) % c.maxDelaySamples
-		sampleL := c.delayLinesL[v][idx1]*(1-frac) + c.delayLinesL[v][idx2]*frac
-
-		// Linear interpolation for right channel
-		sampleR := c.delayLinesR[v][idx1]*(1-frac) + c.delayLinesR[v][idx2]*frac
-
-		// Apply stereo spread
-		// For multiple voices, pan them across the stereo field
-		if c.voices > 1 {
-			pan := (float64(v)/float64(c.voices-1) - 0.5) * c.spread
-			panL := float32(math.Cos((pan + 0.5) * math.Pi / 2))
-			panR := float32(math.Sin((pan + 0.5) * math.Pi / 2))
-
-			wetL += sampleL * panL / float32(c.voices)
-			wetR += sampleR * panR / float32(c.voices)
-		} else {
-			wetL += sampleL
-			wetR += sampleR
-		}
+		// The sample just written sits one behind the write position
+		wetL += c.lineL.Read(delaySamples+1) * c.panL[v]
+		wetR += c.lineR.Read(delaySamples+1) * c.panR[v]
 	}
 
 	// Store feedback
@@ -205,42 +197,120 @@ func (c *Chorus) ProcessStereo(inputL, inputR float32) (outputL, outputR float32
 	outputL += wetL * float32(c.mix)
 	outputR += wetR * float32(c.mix)
 
-	// Advance delay index
-	c.delayIndex = (c.delayIndex + 1) % c.maxDelaySamples
-
 	return outputL, outputR
 }
 
 // ProcessBuffer processes a mono buffer
 func (c *Chorus) ProcessBuffer(input, outputL, outputR []float32) {
-	for i := range input {
-		outputL[i], outputR[i] = c.Process(input[i])
-	}
+	c.processBlock(input, input, outputL, outputR, nil)
 }
 
-// ProcessStereoBuffer processes stereo buffers
+// ProcessStereoBuffer processes stereo buffers. The voice LFOs are rendered
+// a chunk at a time ahead of the delay lines.
 func (c *Chorus) ProcessStereoBuffer(inputL, inputR, outputL, outputR []float32) {
-	for i := range inputL {
-		outputL[i], outputR[i] = c.ProcessStereo(inputL[i], inputR[i])
+	c.processBlock(inputL, inputR, outputL, outputR, nil)
+}
+
+// ProcessStereoBufferModulated processes stereo buffers with each voice's
+// delay swept by modulation[voice] (-1 to 1, one value per sample) instead
+// of the internal LFOs, e.g. buffers rendered by an Engine. It needs one
+// buffer per voice.
+func (c *Chorus) ProcessStereoBufferModulated(inputL, inputR, outputL, outputR []float32, modulation [][]float32) {
+	c.processBlock(inputL, inputR, outputL, outputR, modulation)
+}
+
+// processBlock processes a block in chunks, rendering the voice LFOs when
+// no modulation is supplied
+func (c *Chorus) processBlock(inputL, inputR, outputL, outputR []float32, modulation [][]float32) {
+	for start := 0; start < len(inputL); start += modulationChunk {
+		n := min(modulationChunk, len(inputL)-start)
+
+		var mod [maxChorusVoices][]float32
+		for v := 0; v < c.voices; v++ {
+			if modulation != nil {
+				mod[v] = modulation[v][start : start+n]
+			} else {
+				mod[v] = c.modulation[v][:n]
+				c.lfos[v].Render(mod[v], 1)
+			}
+		}
+
+		if c.feedback == 0 {
+			c.chorusChunk(inputL[start:start+n], inputR[start:start+n], outputL[start:start+n], outputR[start:start+n], &mod)
+			continue
+		}
+
+		var sample [maxChorusVoices]float32
+		for i := 0; i < n; i++ {
+			for v := 0; v < c.voices; v++ {
+				sample[v] = mod[v][i]
+			}
+			j := start + i
+			outputL[j], outputR[j] = c.chorus(inputL[j], inputR[j], &sample)
+		}
 	}
 }
 
-// Reset resets the chorus state
-func (c *Chorus) Reset() {
-	// Clear delay lines
+// chorusChunk processes a chunk without feedback: the input is written to
+// the lines as one block and every voice reads it back with one modulated
+// read per channel
+func (c *Chorus) chorusChunk(inputL, inputR, outputL, outputR []float32, modulation *[maxChorusVoices][]float32) {
+	n := len(inputL)
+	c.lineL.WriteBlock(inputL)
+	c.lineR.WriteBlock(inputR)
+
+	wetL, wetR := c.wetL[:n], c.wetR[:n]
+	for i := range wetL {
+		wetL[i] = 0
+		wetR[i] = 0
+	}
+
+	delays, tap := c.delays[:n], c.tap[:n]
+	base := float32(c.delay * c.sampleRate / 1000.0)
+	scale := float32(c.depth * c.sampleRate / 1000.0)
+	high := float32(c.maxDelay)
 	for v := 0; v < c.voices; v++ {
-		for i := range c.delayLinesL[v] {
-			c.delayLinesL[v][i] = 0
-			c.delayLinesR[v][i] = 0
+		for i, m := range modulation[v][:n] {
+			d := base + scale*m
+			if d < 1 {
+				d = 1
+			} else if d > high {
+				d = high
+			}
+			delays[i] = d
+		}
+
+		panL, panR := c.panL[v], c.panR[v]
+		c.lineL.ReadModulated(tap, delays, delay.InterpolationLinear)
+		for i, x := range tap {
+			wetL[i] += x * panL
+		}
+		c.lineR.ReadModulated(tap, delays, delay.InterpolationLinear)
+		for i, x := range tap {
+			wetR[i] += x * panR
 		}
 	}
 
+	dry, wet := float32(1.0-c.mix), float32(c.mix)
+	for i := range wetL {
+		outputL[i] = inputL[i]*dry + wetL[i]*wet
+		outputR[i] = inputR[i]*dry + wetR[i]*wet
+	}
+	c.feedbackL = wetL[n-1]
+	c.feedbackR = wetR[n-1]
+}
+
+// Reset resets the chorus state
+func (c *Chorus) Reset() {
+	// Clear delay lines
+	c.lineL.Reset()
+	c.lineR.Reset()
+
 	// Reset LFOs
 	for _, lfo := range c.lfos {
 		lfo.Reset()
 	}
 
-	c.delayIndex = 0
 	c.feedbackL = 0
 	c.feedbackR = 0
 }
@@ -0,0 +1,134 @@
+package modulation
+
+// modulationChunk is the number of samples the effects render their own
+// LFOs for at a time; longer blocks are processed in chunks of this size
+const modulationChunk = 256
+
+// Source is a modulator the Engine can render. Render fills out with
+// values spaced stride samples apart and advances the source by
+// len(out)*stride samples. LFO and the envelope generators implement it.
+type Source interface {
+	Render(out []float32, stride int)
+}
+
+// Engine renders a set of modulation sources once per block into
+// contiguous control buffers. Any number of destinations can then read the
+// same buffer, so one LFO drives many parameters without being recomputed.
+//
+// At a control interval of 1 every source renders at audio rate. With a
+// larger interval sources are evaluated only every interval samples and the
+// buffers are filled by linear interpolation between those points; the
+// source runs one interval ahead so the interpolated curve passes through
+// every control point on time.
+type Engine struct {
+	maxBlockSize int
+	interval     int
+	rendered     int // Samples in the last rendered block
+	slots        []modulationSlot
+}
+
+// modulationSlot is one registered source and its buffers
+type modulationSlot struct {
+	source  Source
+	buffer  []float32 // Rendered block, maxBlockSize long
+	control []float32 // Control points for one block at the control interval
+	prev    float32   // Control point at the start of the current segment
+	next    float32   // Control point at the end of the current segment
+	pos     int       // Samples into the current segment
+	primed  bool
+}
+
+// NewEngine creates a modulation engine for blocks of up to maxBlockSize
+// samples, rendering at audio rate
+func NewEngine(maxBlockSize int) *Engine {
+	if maxBlockSize < 1 {
+		maxBlockSize = 1
+	}
+	return &Engine{
+		maxBlockSize: maxBlockSize,
+		interval:     1,
+	}
+}
+
+// SetControlInterval sets how many samples apart sources are evaluated
+// (1 = audio rate). Call it at setup time; it restarts interpolation.
+func (e *Engine) SetControlInterval(samples int) {
+	e.interval = max(1, min(e.maxBlockSize, samples))
+	for i := range e.slots {
+		s := &e.slots[i]
+		s.control = make([]float32, e.maxBlockSize/e.interval+2)
+		s.pos = 0
+		s.primed = false
+	}
+}
+
+// ControlInterval returns the control interval in samples
+func (e *Engine) ControlInterval() int {
+	return e.interval
+}
+
+// Add registers a source and returns the index of its buffer. Call it at
+// setup time.
+func (e *Engine) Add(source Source) int {
+	e.slots = append(e.slots, modulationSlot{
+		source:  source,
+		buffer:  make([]float32, e.maxBlockSize),
+		control: make([]float32, e.maxBlockSize/e.interval+2),
+	})
+	return len(e.slots) - 1
+}
+
+// Render renders numSamples of every source. Blocks longer than the
+// engine's maximum block size are truncated to it.
+func (e *Engine) Render(numSamples int) {
+	numSamples = max(0, min(e.maxBlockSize, numSamples))
+	e.rendered = numSamples
+	for i := range e.slots {
+		s := &e.slots[i]
+		if e.interval == 1 {
+			s.source.Render(s.buffer[:numSamples], 1)
+			continue
+		}
+		s.interpolate(numSamples, e.interval)
+	}
+}
+
+// Buffer returns the samples source index rendered in the last Render call.
+// The slice is reused by the next call.
+func (e *Engine) Buffer(index int) []float32 {
+	return e.slots[index].buffer[:e.rendered]
+}
+
+// interpolate fills n samples of the buffer from control points interval
+// samples apart
+func (s *modulationSlot) interpolate(n, interval int) {
+	if !s.primed {
+		s.source.Render(s.control[:1], interval)
+		s.next = s.control[0]
+		s.primed = true
+	}
+
+	// One new control point is due every time a segment starts
+	pos := s.pos
+	starts := 0
+	if first := (interval - pos) % interval; first < n {
+		starts = (n - first + interval - 1) / interval
+	}
+	points := s.control[:starts]
+	s.source.Render(points, interval)
+
+	prev, next := s.prev, s.next
+	step := 1.0 / float32(interval)
+	j := 0
+	for i := range s.buffer[:n] {
+		if pos == 0 {
+			prev, next = next, points[j]
+			j++
+		}
+		s.buffer[i] = prev + (next-prev)*float32(pos)*step
+		if pos++; pos == interval {
+			pos = 0
+		}
+	}
+	s.prev, s.next, s.pos = prev, next, pos
+}
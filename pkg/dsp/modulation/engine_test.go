@@ -0,0 +1,252 @@
+package modulation
+
+import (
+	"math"
+	"testing"
+
+	"github.com/justyntemme/vst3go/pkg/dsp/envelope"
+)
+
+func TestEngineAudioRate(t *testing.T) {
+	engine := NewEngine(512)
+	lfo := NewLFO(48000.0)
+	lfo.SetFrequency(3.0)
+	id := engine.Add(lfo)
+
+	reference := NewLFO(48000.0)
+	reference.SetFrequency(3.0)
+
+	for _, n := range []int{512, 37, 200} {
+		engine.Render(n)
+		buffer := engine.Buffer(id)
+		if len(buffer) != n {
+			t.Fatalf("Buffer length %d, want %d", len(buffer), n)
+		}
+		for i, got := range buffer {
+			if want := reference.Process(); math.Abs(float64(got)-want) > 1e-5 {
+				t.Fatalf("Sample %d: got %f, want %f", i, got, want)
+			}
+		}
+	}
+}
+
+func TestEngineControlRate(t *testing.T) {
+	const interval = 32
+	engine := NewEngine(512)
+	engine.SetControlInterval(interval)
+	lfo := NewLFO(48000.0)
+	lfo.SetFrequency(5.0)
+	id := engine.Add(lfo)
+
+	reference := NewLFO(48000.0)
+	reference.SetFrequency(5.0)
+
+	// Odd block sizes make segments straddle block boundaries
+	sample := 0
+	for _, n := range []int{100, 37, 512, 1, 255} {
+		engine.Render(n)
+		for _, got := range engine.Buffer(id) {
+			want := reference.Process()
+			tolerance := 1e-3 // Interpolation error between points
+			if sample%interval == 0 {
+				tolerance = 1e-5 // Control points land on time
+			}
+			if math.Abs(float64(got)-want) > tolerance {
+				t.Fatalf("Sample %d: got %f, want %f", sample, got, want)
+			}
+			sample++
+		}
+	}
+}
+
+func TestEngineEnvelopeSource(t *testing.T) {
+	const interval = 16
+	engine := NewEngine(256)
+	engine.SetControlInterval(interval)
+	env := envelope.New(48000.0)
+	env.SetADSR(0.01, 0.05, 0.5, 0.05)
+	env.Trigger()
+	id := engine.Add(env)
+
+	reference := envelope.New(48000.0)
+	reference.SetADSR(0.01, 0.05, 0.5, 0.05)
+	reference.Trigger()
+
+	for block := 0; block < 20; block++ {
+		engine.Render(256)
+		for i, got := range engine.Buffer(id) {
+			want := reference.Next()
+			if math.Abs(float64(got-want)) > 0.01 {
+				t.Fatalf("Block %d sample %d: got %f, want %f", block, i, got, want)
+			}
+		}
+	}
+}
+
+func TestSharedModulation(t *testing.T) {
+	// One engine LFO drives two flangers; each must match a flanger running
+	// its own identical LFO
+	engine := NewEngine(256)
+	lfo := NewLFO(48000.0)
+	lfo.SetWaveform(WaveformTriangle)
+	lfo.SetFrequency(0.5)
+	id := engine.Add(lfo)
+
+	shared := []*Flanger{NewFlanger(48000.0), NewFlanger(48000.0)}
+	own := NewFlanger(48000.0)
+
+	input := make([]float32, 256)
+	want := make([]float32, 256)
+	got := make([]float32, 256)
+	for block := 0; block < 8; block++ {
+		for i := range input {
+			input[i] = float32(math.Sin(float64(block*256+i) * 0.05))
+		}
+		own.ProcessBuffer(input, want)
+		engine.Render(len(input))
+		for _, f := range shared {
+			f.ProcessBufferModulated(input, got, engine.Buffer(id))
+			for i := range want {
+				if math.Abs(float64(got[i]-want[i])) > 1e-4 {
+					t.Fatalf("Block %d sample %d: got %f, want %f", block, i, got[i], want[i])
+				}
+			}
+		}
+	}
+}
+
+func TestBlockProcessingMatchesPerSample(t *testing.T) {
+	const n = 1000
+	inputL := make([]float32, n)
+	inputR := make([]float32, n)
+	for i := range inputL {
+		inputL[i] = float32(math.Sin(float64(i) * 0.03))
+		inputR[i] = float32(math.Cos(float64(i) * 0.02))
+	}
+	gotL := make([]float32, n)
+	gotR := make([]float32, n)
+
+	check := func(name string, perSample func(l, r float32) (float32, float32), block func()) {
+		t.Helper()
+		block()
+		for i := range inputL {
+			wantL, wantR := perSample(inputL[i], inputR[i])
+			if math.Abs(float64(gotL[i]-wantL)) > 1e-4 || math.Abs(float64(gotR[i]-wantR)) > 1e-4 {
+				t.Fatalf("%s: sample %d got (%f, %f), want (%f, %f)", name, i, gotL[i], gotR[i], wantL, wantR)
+			}
+		}
+	}
+
+	chorus, chorusRef := NewChorus(48000.0), NewChorus(48000.0)
+	for _, c := range []*Chorus{chorus, chorusRef} {
+		c.SetVoices(3)
+		c.SetFeedback(0.3)
+	}
+	check("Chorus", chorusRef.ProcessStereo, func() {
+		chorus.ProcessStereoBuffer(inputL, inputR, gotL, gotR)
+	})
+
+	flanger, flangerRef := NewFlanger(48000.0), NewFlanger(48000.0)
+	check("Flanger", flangerRef.ProcessStereo, func() {
+		flanger.ProcessStereoBuffer(inputL, inputR, gotL, gotR)
+	})
+
+	phaser, phaserRef := NewPhaser(48000.0), NewPhaser(48000.0)
+	check("Phaser", phaserRef.ProcessStereo, func() {
+		phaser.ProcessStereoBuffer(inputL, inputR, gotL, gotR)
+	})
+
+	tremolo, tremoloRef := NewTremolo(48000.0), NewTremolo(48000.0)
+	for _, tr := range []*Tremolo{tremolo, tremoloRef} {
+		tr.SetStereo(true)
+		tr.SetStereoPhase(0.25)
+		tr.SetWaveform(WaveformSquare)
+	}
+	check("Tremolo", tremoloRef.ProcessStereo, func() {
+		tremolo.ProcessStereoBuffer(inputL, inputR, gotL, gotR)
+	})
+}
+
+func TestModulationZeroAllocations(t *testing.T) {
+	engine := NewEngine(512)
+	engine.SetControlInterval(16)
+	lfo := NewLFO(48000.0)
+	env := envelope.New(48000.0)
+	env.Trigger()
+	id := engine.Add(lfo)
+	engine.Add(env)
+
+	chorus := NewChorus(48000.0)
+	flanger := NewFlanger(48000.0)
+	phaser := NewPhaser(48000.0)
+	tremolo := NewTremolo(48000.0)
+	inL := make([]float32, 512)
+	inR := make([]float32, 512)
+	outL := make([]float32, 512)
+	outR := make([]float32, 512)
+
+	allocs := testing.AllocsPerRun(20, func() {
+		engine.Render(512)
+		mod := engine.Buffer(id)
+		chorus.ProcessStereoBuffer(inL, inR, outL, outR)
+		flanger.ProcessStereoBuffer(inL, inR, outL, outR)
+		flanger.ProcessStereoBufferModulated(inL, inR, outL, outR, mod)
+		phaser.ProcessStereoBufferModulated(inL, inR, outL, outR, mod)
+		tremolo.ProcessStereoBuffer(inL, inR, outL, outR)
+	})
+	if allocs != 0 {
+		t.Errorf("Modulated processing allocated %.1f times", allocs)
+	}
+}
+
+func BenchmarkEngine(b *testing.B) {
+	for _, interval := range []int{1, 32} {
+		engine := NewEngine(512)
+		engine.SetControlInterval(interval)
+		for i := 0; i < 8; i++ {
+			lfo := NewLFO(48000.0)
+			lfo.SetFrequency(float64(i + 1))
+			engine.Add(lfo)
+		}
+		name := "AudioRate"
+		if interval > 1 {
+			name = "ControlRate"
+		}
+		b.Run(name, func(b *testing.B) {
+			b.ReportAllocs()
+			for i := 0; i < b.N; i++ {
+				engine.Render(512)
+			}
+		})
+	}
+}
+
+func BenchmarkModulationEffectsBlock(b *testing.B) {
+	chorus := NewChorus(48000.0)
+	flanger := NewFlanger(48000.0)
+	phaser := NewPhaser(48000.0)
+	inL := make([]float32, 512)
+	inR := make([]float32, 512)
+	outL := make([]float32, 512)
+	outR := make([]float32, 512)
+	for i := range inL {
+		inL[i] = float32(math.Sin(float64(i) * 0.05))
+		inR[i] = inL[i]
+	}
+
+	b.Run("Chorus", func(b *testing.B) {
+		for i := 0; i < b.N; i++ {
+			chorus.ProcessStereoBuffer(inL, inR, outL, outR)
+		}
+	})
+	b.Run("Flanger", func(b *testing.B) {
+		for i := 0; i < b.N; i++ {
+			flanger.ProcessStereoBuffer(inL, inR, outL, outR)
+		}
+	})
+	b.Run("Phaser", func(b *testing.B) {
+		for i := 0; i < b.N; i++ {
+			phaser.ProcessStereoBuffer(inL, inR, outL, outR)
+		}
+	})
+}
@@ -2,6 +2,14 @@ package modulation
 
 import (
 	"math"
+
+	"github.com/justyntemme/vst3go/pkg/dsp/delay"
+)
+
+// Ranges of SetDelay and SetDepth in milliseconds
+const (
+	flangerMaxDelayMs = 10.0
+	flangerMaxDepthMs = 10.0
 )
 
 // Flanger implements a classic flanger effect with feedback
@@ -16,13 +24,14 @@ type Flanger struct {
 	mix      float64 // Wet/dry mix (0-1)
 	manual   float64 // Manual control for static flanging (0-1)
 
-	// Delay line
-	delayLine       []float32
-	delayIndex      int
-	maxDelaySamples int
+	// Delay line, sized for the longest delay and depth
+	line     *delay.Line
+	maxDelay float64 // Longest delay in samples
 
 	// LFO
-	lfo *LFO
+	lfo        *LFO
+	modulation []float32 // One chunk of rendered LFO
+	wet        []float32 // One chunk of delayed samples
 
 	// Feedback state
 	feedbackSample float32
@@ -42,6 +51,8 @@ func NewFlanger(sampleRate float64) *Flanger {
 		mix:        0.5, // 50% wet
 		manual:     0.5, // Center position
 		manualMode: false,
+		modulation: make([]float32, modulationChunk),
+		wet:        make([]float32, modulationChunk),
 	}
 
 	// Create LFO
@@ -50,7 +61,9 @@ func NewFlanger(sampleRate float64) *Flanger {
 	f.lfo.SetFrequency(f.rate)
 
 	// Initialize delay line
-	f.updateDelayLine()
+	maxDelay := int((flangerMaxDelayMs + flangerMaxDepthMs) * sampleRate / 1000.0)
+	f.line = delay.NewSamples(maxDelay)
+	f.maxDelay = float64(maxDelay)
 
 	return f
 }
@@ -63,13 +76,12 @@ func (f *Flanger) SetRate(hz float64) {
 
 // SetDepth sets the modulation depth in milliseconds
 func (f *Flanger) SetDepth(ms float64) {
-	f.depth = math.Max(0.0, math.Min(10.0, ms))
+	f.depth = math.Max(0.0, math.Min(flangerMaxDepthMs, ms))
 }
 
 // SetDelay sets the center delay time in milliseconds
 func (f *Flanger) SetDelay(ms float64) {
-	f.delay = math.Max(0.1, math.Min(10.0, ms))
-	f.updateDelayLine()
+	f.delay = math.Max(0.1, math.Min(flangerMaxDelayMs, ms))
 }
 
 // SetFeedback sets the feedback amount (-1 to 1)
@@ -92,36 +104,8 @@ func (f *Flanger) SetManualMode(enabled bool) {
 	f.manualMode = enabled
 }
 
-// updateDelayLine updates the delay line buffer size
-func (f *Flanger) updateDelayLine() {
-	// Calculate maximum delay needed
-	maxDelayMs := f.delay + f.depth
-	f.maxDelaySamples = int(maxDelayMs * f.sampleRate / 1000.0)
-
-	// Add some headroom
-	f.maxDelaySamples = int(float64(f.maxDelaySamples) * 1.2)
-
-	// Create new delay line
-	f.delayLine = make([]float32, f.maxDelaySamples)
-	f.delayIndex = 0
-	f.feedbackSample = 0
-}
-
 // Process processes a mono sample
 func (f *Flanger) Process(input float32) float32 {
-	// Mix input with feedback
-	delayInput := input + f.feedbackSample*float32(f.feedback)
-
-	// Limit to prevent runaway feedback
-	if delayInput > 1.0 {
-		delayInput = 1.0
-	} else if delayInput < -1.0 {
-		delayInput = -1.0
-	}
-
-	// Write to delay line
-	f.delayLine[f.delayIndex] = delayInput
-
 	// Calculate modulated delay time
 	var modulation float64
 	if f.manualMode {
@@ -132,38 +116,11 @@ func (f *Flanger) Process(input float32) float32 {
 		modulation = f.lfo.Process()
 	}
 
-	// Calculate delay time in samples
-	delayMs := f.delay + f.depth*modulation
-	delaySamples := delayMs * f.sampleRate / 1000.0
-
-	// Ensure delay is within bounds
-	delaySamples = math.Max(0.1, math.Min(float64(f.maxDelaySamples-1), delaySamples))
-
-	// Calculate read position with linear interpolation
-	readPos := float64(f.delayIndex) - delaySamples
-	if readPos < 0 {
-		readPos += float64(f.maxDelaySamples)
-	}
-
-	// Get integer and fractional parts
-	readIdx := int(readPos)
-	frac := float32(readPos - float64(readIdx))
-
-	// Linear interpolation
-	idx1 := readIdx % f.maxDelaySamples
-	idx2 := (readIdx + 1) % f.maxDelaySamples
-	delayedSample := f.delayLine[idx1]*(1-frac) + f.delayLine[idx2]*frac
-
-	// Store for feedback
-	f.feedbackSample = delayedSample
-
-	// Mix dry and wet signals
-	output := input*(1-float32(f.mix)) + delayedSample*float32(f.mix)
-
-	// Advance delay index
-	f.delayIndex = (f.delayIndex + 1) % f.maxDelaySamples
-
-	return output
+	in := [1]float32{input}
+	mod := [1]float32{float32(modulation)}
+	var out [1]float32
+	f.flangeChunk(in[:], out[:], mod[:])
+	return out[0]
 }
 
 // ProcessStereo processes stereo input with inverted phase on right channel
@@ -184,29 +141,109 @@ func (f *Flanger) ProcessStereo(inputL, inputR float32) (outputL, outputR float3
 	return outputL, outputR
 }
 
-// ProcessBuffer processes a buffer of samples
+// ProcessBuffer processes a buffer of samples. The LFO is rendered a chunk
+// at a time ahead of the delay line.
 func (f *Flanger) ProcessBuffer(input, output []float32) {
-	for i := range input {
-		output[i] = f.Process(input[i])
-	}
+	f.processBlock(input, nil, output, nil, nil)
 }
 
 // ProcessStereoBuffer processes stereo buffers
 func (f *Flanger) ProcessStereoBuffer(inputL, inputR, outputL, outputR []float32) {
-	for i := range inputL {
-		outputL[i], outputR[i] = f.ProcessStereo(inputL[i], inputR[i])
+	f.processBlock(inputL, inputR, outputL, outputR, nil)
+}
+
+// ProcessBufferModulated processes a buffer with the delay swept by
+// modulation (-1 to 1, one value per sample) instead of the internal LFO,
+// e.g. a buffer rendered by an Engine and shared with other effects
+func (f *Flanger) ProcessBufferModulated(input, output, modulation []float32) {
+	f.processBlock(input, nil, output, nil, modulation)
+}
+
+// ProcessStereoBufferModulated processes stereo buffers with external modulation
+func (f *Flanger) ProcessStereoBufferModulated(inputL, inputR, outputL, outputR, modulation []float32) {
+	f.processBlock(inputL, inputR, outputL, outputR, modulation)
+}
+
+// processBlock processes a block in chunks, rendering the internal
+// modulation when none is supplied. inputR is nil for mono.
+func (f *Flanger) processBlock(inputL, inputR, outputL, outputR, modulation []float32) {
+	mix := float32(f.mix)
+	for start := 0; start < len(inputL); start += modulationChunk {
+		n := min(modulationChunk, len(inputL)-start)
+
+		var mod []float32
+		if modulation != nil {
+			mod = modulation[start : start+n]
+		} else {
+			mod = f.modulation[:n]
+			if f.manualMode {
+				manual := float32(2.0*f.manual - 1.0)
+				for i := range mod {
+					mod[i] = manual
+				}
+			} else {
+				f.lfo.Render(mod, 1)
+			}
+		}
+
+		f.flangeChunk(inputL[start:start+n], outputL[start:start+n], mod)
+		if inputR != nil {
+			// The right channel carries the inverted wet signal
+			for i, x := range inputR[start : start+n] {
+				outputR[start+i] = x*(1-mix) - f.wet[i]*mix*mix
+			}
+		}
+	}
+}
+
+// flangeChunk runs a chunk through the delay line with the delay swept by
+// modulation (-1 to 1), holding the line state in locals. It leaves the
+// delayed samples in f.wet.
+func (f *Flanger) flangeChunk(input, output, modulation []float32) {
+	line := f.line
+	feedbackSample := f.feedbackSample
+	feedback := float32(f.feedback)
+	mix := float32(f.mix)
+
+	// delaySamples = base + scale*modulation, clamped
+	base := f.delay * f.sampleRate / 1000.0
+	scale := f.depth * f.sampleRate / 1000.0
+	maxDelay := f.maxDelay
+
+	wet := f.wet[:len(input)]
+	for i, x := range input {
+		delayInput := x + feedbackSample*feedback
+		if delayInput > 1.0 {
+			delayInput = 1.0
+		} else if delayInput < -1.0 {
+			delayInput = -1.0
+		}
+		line.Write(delayInput)
+
+		delaySamples := base + scale*float64(modulation[i])
+		if delaySamples < 0.1 {
+			delaySamples = 0.1
+		} else if delaySamples > maxDelay {
+			delaySamples = maxDelay
+		}
+
+		// The sample just written sits one behind the write position
+		delayed := line.Read(delaySamples + 1)
+
+		feedbackSample = delayed
+		wet[i] = delayed
+		output[i] = x*(1-mix) + delayed*mix
 	}
+
+	f.feedbackSample = feedbackSample
 }
 
 // Reset resets the flanger state
 func (f *Flanger) Reset() {
 	// Clear delay line
-	for i := range f.delayLine {
-		f.delayLine[i] = 0
-	}
+	f.line.Reset()
 
 	// Reset state
-	f.delayIndex = 0
 	f.feedbackSample = 0
 
 	// Reset LFO
@@ -183,6 +183,69 @@ func (l *LFO) ProcessBuffer(output []float64) {
 	}
 }
 
+// Render fills out with LFO values spaced stride samples apart, advancing
+// the LFO by len(out)*stride samples. With a stride of 1 it renders at audio
+// rate and matches successive Process calls. The sine is generated by a
+// rotating phasor seeded from the phase once per call, so the loop has no
+// trigonometric calls.
+func (l *LFO) Render(out []float32, stride int) {
+	if stride < 1 {
+		stride = 1
+	}
+	inc := l.phaseInc * float64(stride)
+	phase := l.phase
+
+	switch l.waveform {
+	case WaveformSine:
+		s, c := math.Sincos(2.0 * math.Pi * phase)
+		rs, rc := math.Sincos(2.0 * math.Pi * inc)
+		for i := range out {
+			out[i] = clampUnit(s*l.depth + l.offset)
+			s, c = s*rc+c*rs, c*rc-s*rs
+		}
+		phase = wrapPhase(phase + inc*float64(len(out)))
+
+	case WaveformRandom:
+		for i := range out {
+			if l.randomCounter >= l.randomPeriod {
+				l.randomCounter = 0
+				l.currentRandom = 2.0*randFloat() - 1.0
+			}
+			l.randomCounter += stride
+			out[i] = clampUnit(l.currentRandom*l.depth + l.offset)
+		}
+		phase = wrapPhase(phase + inc*float64(len(out)))
+
+	default:
+		for i := range out {
+			l.phase = phase
+			out[i] = clampUnit(l.generateWaveform()*l.depth + l.offset)
+			phase = wrapPhase(phase + inc)
+		}
+	}
+
+	l.phase = phase
+}
+
+// wrapPhase wraps a non-negative phase to 0-1
+func wrapPhase(phase float64) float64 {
+	if phase >= 1.0 {
+		phase -= math.Floor(phase)
+	}
+	return phase
+}
+
+// clampUnit clamps a modulation value to -1..1
+func clampUnit(x float64) float32 {
+	if x > 1.0 {
+		return 1.0
+	}
+	if x < -1.0 {
+		return -1.0
+	}
+	return float32(x)
+}
+
 // GetPhase returns the current phase (0-1)
 func (l *LFO) GetPhase() float64 {
 	return l.phase
@@ -258,6 +258,42 @@ func TestLFOReset(t *testing.T) {
 	}
 }
 
+func TestLFORender(t *testing.T) {
+	for _, waveform := range []Waveform{WaveformSine, WaveformTriangle, WaveformSquare, WaveformSawtooth} {
+		for _, stride := range []int{1, 16} {
+			reference := NewLFO(48000.0)
+			lfo := NewLFO(48000.0)
+			for _, l := range []*LFO{reference, lfo} {
+				l.SetFrequency(7.0)
+				l.SetWaveform(waveform)
+				l.SetDepth(0.8)
+				l.SetOffset(0.1)
+				l.SetPhase(0.3)
+			}
+
+			// Several blocks so the phase carries over between calls
+			out := make([]float32, 300)
+			for block := 0; block < 4; block++ {
+				lfo.Render(out, stride)
+				for i, got := range out {
+					want := reference.Process()
+					for k := 1; k < stride; k++ {
+						reference.Process()
+					}
+					if math.Abs(float64(got)-want) > 1e-4 {
+						t.Fatalf("Waveform %d stride %d: block %d sample %d got %f, want %f",
+							waveform, stride, block, i, got, want)
+					}
+				}
+			}
+			if math.Abs(lfo.GetPhase()-reference.GetPhase()) > 1e-9 {
+				t.Errorf("Waveform %d stride %d: phase %f, want %f",
+					waveform, stride, lfo.GetPhase(), reference.GetPhase())
+			}
+		}
+	}
+}
+
 // Benchmark LFO
 func BenchmarkLFO(b *testing.B) {
 	lfo := NewLFO(48000.0)
@@ -279,3 +315,13 @@ func BenchmarkLFOBuffer(b *testing.B) {
 		lfo.ProcessBuffer(buffer)
 	}
 }
+
+func BenchmarkLFORender(b *testing.B) {
+	lfo := NewLFO(48000.0)
+	buffer := make([]float32, 1024)
+
+	b.ResetTimer()
+	for i := 0; i < b.N; i++ {
+		lfo.Render(buffer, 1)
+	}
+}
@@ -60,7 +60,8 @@ type Phaser struct {
 	filters []*AllPassFilter
 
 	// LFO
-	lfo *LFO
+	lfo        *LFO
+	modulation []float32 // One chunk of rendered LFO
 
 	// Feedback state
 	feedbackSample float32
@@ -68,6 +69,8 @@ type Phaser struct {
 	// Frequency range for modulation
 	minFreq float64
 	maxFreq float64
+	logMin  float64
+	logMax  float64
 }
 
 // NewPhaser creates a new phaser effect
@@ -82,6 +85,7 @@ func NewPhaser(sampleRate float64) *Phaser {
 		stages:     4,      // 4 stages default
 		minFreq:    200.0,  // 200Hz minimum
 		maxFreq:    2000.0, // 2kHz maximum
+		modulation: make([]float32, modulationChunk),
 	}
 
 	// Create LFO
@@ -117,6 +121,7 @@ func (p *Phaser) SetFrequencyRange(minFreq, maxFreq float64) {
 	p.minFreq = math.Max(20.0, math.Min(p.sampleRate/4, minFreq))
 	p.maxFreq = math.Max(p.minFreq+100, math.Min(p.sampleRate/2, maxFreq))
 	p.centerFreq = (p.minFreq + p.maxFreq) / 2
+	p.updateLogRange()
 }
 
 // SetFeedback sets the feedback amount (-1 to 1)
@@ -163,24 +168,35 @@ func (p *Phaser) updateFrequencyRange() {
 	// Ensure valid range
 	p.minFreq = math.Max(20.0, p.minFreq)
 	p.maxFreq = math.Min(p.sampleRate/4, p.maxFreq)
+	p.updateLogRange()
+}
+
+// updateLogRange caches the log of the sweep range
+func (p *Phaser) updateLogRange() {
+	p.logMin = math.Log(p.minFreq)
+	p.logMax = math.Log(p.maxFreq)
 }
 
 // Process processes a mono sample
 func (p *Phaser) Process(input float32) float32 {
 	// Get LFO modulation (-1 to 1)
-	lfoValue := p.lfo.Process()
+	output, _ := p.shift(input, p.lfo.Process())
+	return output
+}
 
+// shift runs one sample through the all-pass cascade with the notches placed
+// by modulation (-1 to 1) and returns the mixed output and its wet part
+func (p *Phaser) shift(input float32, modulation float64) (output, wet float32) {
 	// Map LFO to frequency range
 	// Use exponential scaling for more musical response
-	normalizedLFO := (lfoValue + 1.0) / 2.0 // 0 to 1
-	logMin := math.Log(p.minFreq)
-	logMax := math.Log(p.maxFreq)
-	logFreq := logMin + (logMax-logMin)*normalizedLFO
-	freq := math.Exp(logFreq)
+	normalizedLFO := (modulation + 1.0) / 2.0 // 0 to 1
+	freq := math.Exp(p.logMin + (p.logMax-p.logMin)*normalizedLFO)
 
-	// Update all-pass filter frequencies
+	// Every stage shares the same frequency, so the coefficient is computed once
+	tanFreq := math.Tan(math.Pi * freq / p.sampleRate)
+	a1 := (1.0 - tanFreq) / (1.0 + tanFreq)
 	for _, filter := range p.filters {
-		filter.SetFrequency(freq, p.sampleRate)
+		filter.a1 = a1
 	}
 
 	// Process through all-pass cascade with feedback
@@ -202,19 +218,17 @@ func (p *Phaser) Process(input float32) float32 {
 	p.feedbackSample = wetSignal
 
 	// Mix dry and wet signals
-	output := input*float32(1-p.mix) + wetSignal*float32(p.mix)
+	wet = wetSignal * float32(p.mix)
+	output = input*float32(1-p.mix) + wet
 
-	return output
+	return output, wet
 }
 
 // ProcessStereo processes stereo input with phase-shifted modulation
 func (p *Phaser) ProcessStereo(inputL, inputR float32) (outputL, outputR float32) {
 	// For stereo, we could use two separate phasers with phase-shifted LFOs
 	// For now, use the same processing but with inverted wet signal on right
-	outputL = p.Process(inputL)
-
-	// Get the wet component
-	wetL := outputL - inputL*float32(1-p.mix)
+	outputL, wetL := p.shift(inputL, p.lfo.Process())
 
 	// Create right channel with slightly different phasing
 	// Process right input normally but invert the wet signal
@@ -224,17 +238,52 @@ func (p *Phaser) ProcessStereo(inputL, inputR float32) (outputL, outputR float32
 	return outputL, outputR
 }
 
-// ProcessBuffer processes a buffer of samples
+// ProcessBuffer processes a buffer of samples. The LFO is rendered a chunk
+// at a time ahead of the filters.
 func (p *Phaser) ProcessBuffer(input, output []float32) {
-	for i := range input {
-		output[i] = p.Process(input[i])
-	}
+	p.processBlock(input, nil, output, nil, nil)
 }
 
 // ProcessStereoBuffer processes stereo buffers
 func (p *Phaser) ProcessStereoBuffer(inputL, inputR, outputL, outputR []float32) {
-	for i := range inputL {
-		outputL[i], outputR[i] = p.ProcessStereo(inputL[i], inputR[i])
+	p.processBlock(inputL, inputR, outputL, outputR, nil)
+}
+
+// ProcessBufferModulated processes a buffer with the notches swept by
+// modulation (-1 to 1, one value per sample) instead of the internal LFO,
+// e.g. a buffer rendered by an Engine and shared with other effects
+func (p *Phaser) ProcessBufferModulated(input, output, modulation []float32) {
+	p.processBlock(input, nil, output, nil, modulation)
+}
+
+// ProcessStereoBufferModulated processes stereo buffers with external modulation
+func (p *Phaser) ProcessStereoBufferModulated(inputL, inputR, outputL, outputR, modulation []float32) {
+	p.processBlock(inputL, inputR, outputL, outputR, modulation)
+}
+
+// processBlock processes a block in chunks, rendering the LFO when no
+// modulation is supplied. inputR is nil for mono.
+func (p *Phaser) processBlock(inputL, inputR, outputL, outputR, modulation []float32) {
+	dry := float32(1 - p.mix)
+	for start := 0; start < len(inputL); start += modulationChunk {
+		n := min(modulationChunk, len(inputL)-start)
+
+		var mod []float32
+		if modulation != nil {
+			mod = modulation[start : start+n]
+		} else {
+			mod = p.modulation[:n]
+			p.lfo.Render(mod, 1)
+		}
+
+		for i, m := range mod {
+			j := start + i
+			out, wet := p.shift(inputL[j], float64(m))
+			outputL[j] = out
+			if inputR != nil {
+				outputR[j] = inputR[j]*dry - wet
+			}
+		}
 	}
 }
 
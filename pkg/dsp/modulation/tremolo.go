@@ -27,8 +27,9 @@ type Tremolo struct {
 	phase    float64     // Stereo phase offset (0-1)
 
 	// LFOs
-	lfoL *LFO
-	lfoR *LFO
+	lfoL       *LFO
+	lfoR       *LFO
+	modulation []float32 // One chunk of rendered LFO
 
 	// Smoothing for square wave to avoid clicks
 	smoothing     bool
@@ -50,6 +51,7 @@ func NewTremolo(sampleRate float64) *Tremolo {
 		smoothing:     false,
 		smoothedGainL: 1.0,
 		smoothedGainR: 1.0,
+		modulation:    make([]float32, modulationChunk),
 	}
 
 	// Create LFOs
@@ -136,6 +138,13 @@ func (t *Tremolo) Process(input float32) float32 {
 	// Get LFO value (-1 to 1)
 	lfoValue := t.lfoL.Process()
 
+	// Apply amplitude modulation
+	return input * float32(t.gain(lfoValue, &t.smoothedGainL))
+}
+
+// gain maps an LFO value (-1 to 1) to the tremolo gain, smoothing it in
+// smoothed when enabled
+func (t *Tremolo) gain(lfoValue float64, smoothed *float64) float64 {
 	// Calculate gain based on mode
 	var gain float64
 
@@ -149,18 +158,16 @@ func (t *Tremolo) Process(input float32) float32 {
 		// Harmonic tremolo: use absolute value of LFO for richer harmonics
 		// This creates frequency doubling effect
 		// abs(LFO) goes from 0 to 1, so we modulate from (1-depth) to 1
-		absLFO := math.Abs(lfoValue)
-		gain = 1.0 - t.depth*absLFO
+		gain = 1.0 - t.depth*math.Abs(lfoValue)
 	}
 
 	// Apply smoothing if enabled (mainly for square wave)
 	if t.smoothing {
-		t.smoothedGainL = gain + (t.smoothedGainL-gain)*t.smoothCoeff
-		gain = t.smoothedGainL
+		*smoothed = gain + (*smoothed-gain)*t.smoothCoeff
+		gain = *smoothed
 	}
 
-	// Apply amplitude modulation
-	return input * float32(gain)
+	return gain
 }
 
 // ProcessStereo processes stereo input
@@ -173,46 +180,82 @@ func (t *Tremolo) ProcessStereo(inputL, inputR float32) (outputL, outputR float3
 		lfoR = t.lfoR.Process()
 	}
 
-	// Calculate gains based on mode
-	var gainL, gainR float64
+	// Apply amplitude modulation
+	outputL = inputL * float32(t.gain(lfoL, &t.smoothedGainL))
+	outputR = inputR * float32(t.gain(lfoR, &t.smoothedGainR))
 
-	switch t.mode {
-	case TremoloModeNormal:
-		gainL = 1.0 - t.depth*(1.0-lfoL)/2.0
-		gainR = 1.0 - t.depth*(1.0-lfoR)/2.0
+	return outputL, outputR
+}
 
-	case TremoloModeHarmonic:
-		gainL = 1.0 - t.depth*math.Abs(lfoL)
-		gainR = 1.0 - t.depth*math.Abs(lfoR)
-	}
+// ProcessBuffer processes a buffer of samples. The LFO is rendered a chunk
+// at a time ahead of the gain stage.
+func (t *Tremolo) ProcessBuffer(input, output []float32) {
+	t.processBlock(input, output, nil, &t.smoothedGainL, t.lfoL)
+}
 
-	// Apply smoothing if enabled
-	if t.smoothing {
-		t.smoothedGainL = gainL + (t.smoothedGainL-gainL)*t.smoothCoeff
-		t.smoothedGainR = gainR + (t.smoothedGainR-gainR)*t.smoothCoeff
-		gainL = t.smoothedGainL
-		gainR = t.smoothedGainR
+// ProcessStereoBuffer processes stereo buffers
+func (t *Tremolo) ProcessStereoBuffer(inputL, inputR, outputL, outputR []float32) {
+	if t.stereo {
+		t.processBlock(inputL, outputL, nil, &t.smoothedGainL, t.lfoL)
+		t.processBlock(inputR, outputR, nil, &t.smoothedGainR, t.lfoR)
+		return
 	}
+	t.processLinked(inputL, inputR, outputL, outputR, nil)
+}
 
-	// Apply amplitude modulation
-	outputL = inputL * float32(gainL)
-	outputR = inputR * float32(gainR)
+// ProcessBufferModulated processes a buffer with the gain driven by
+// modulation (-1 to 1, one value per sample) instead of the internal LFO,
+// e.g. a buffer rendered by an Engine and shared with other effects
+func (t *Tremolo) ProcessBufferModulated(input, output, modulation []float32) {
+	t.processBlock(input, output, modulation, &t.smoothedGainL, nil)
+}
 
-	return outputL, outputR
+// ProcessStereoBufferModulated processes stereo buffers with external
+// modulation. modulationR may be nil to drive both channels from
+// modulationL.
+func (t *Tremolo) ProcessStereoBufferModulated(inputL, inputR, outputL, outputR, modulationL, modulationR []float32) {
+	if modulationR == nil {
+		t.processLinked(inputL, inputR, outputL, outputR, modulationL)
+		return
+	}
+	t.processBlock(inputL, outputL, modulationL, &t.smoothedGainL, nil)
+	t.processBlock(inputR, outputR, modulationR, &t.smoothedGainR, nil)
 }
 
-// ProcessBuffer processes a buffer of samples
-func (t *Tremolo) ProcessBuffer(input, output []float32) {
-	for i := range input {
-		output[i] = t.Process(input[i])
+// processBlock applies the tremolo to one channel, rendering lfo in chunks
+// when no modulation is supplied
+func (t *Tremolo) processBlock(input, output, modulation []float32, smoothed *float64, lfo *LFO) {
+	for start := 0; start < len(input); start += modulationChunk {
+		n := min(modulationChunk, len(input)-start)
+		mod := t.chunkModulation(modulation, start, n, lfo)
+		for i, m := range mod {
+			output[start+i] = input[start+i] * float32(t.gain(float64(m), smoothed))
+		}
 	}
 }
 
-// ProcessStereoBuffer processes stereo buffers
-func (t *Tremolo) ProcessStereoBuffer(inputL, inputR, outputL, outputR []float32) {
-	for i := range inputL {
-		outputL[i], outputR[i] = t.ProcessStereo(inputL[i], inputR[i])
+// processLinked applies the same modulation to both channels
+func (t *Tremolo) processLinked(inputL, inputR, outputL, outputR, modulation []float32) {
+	for start := 0; start < len(inputL); start += modulationChunk {
+		n := min(modulationChunk, len(inputL)-start)
+		mod := t.chunkModulation(modulation, start, n, t.lfoL)
+		for i, m := range mod {
+			j := start + i
+			outputL[j] = inputL[j] * float32(t.gain(float64(m), &t.smoothedGainL))
+			outputR[j] = inputR[j] * float32(t.gain(float64(m), &t.smoothedGainR))
+		}
+	}
+}
+
+// chunkModulation returns n samples of modulation from start, rendering lfo
+// when none is supplied
+func (t *Tremolo) chunkModulation(modulation []float32, start, n int, lfo *LFO) []float32 {
+	if modulation != nil {
+		return modulation[start : start+n]
 	}
+	mod := t.modulation[:n]
+	lfo.Render(mod, 1)
+	return mod
 }
 
 // GetCurrentGain returns the current gain value (for visualization)
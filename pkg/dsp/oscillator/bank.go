@@ -0,0 +1,201 @@
+package oscillator
+
+// MaxBankLanes is the number of voices one Bank renders together
+const MaxBankLanes = 8
+
+// BankMode selects how a Bank band-limits its waveform
+type BankMode int
+
+const (
+	// BankWavetable reads the shared mip-mapped wavetables
+	BankWavetable BankMode = iota
+	// BankPolyBLEP computes the naive waveform and corrects its
+	// discontinuities with PolyBLEP/PolyBLAMP; no table memory is touched
+	BankPolyBLEP
+)
+
+// Bank renders up to MaxBankLanes oscillators of one shape in a single pass.
+// Lane state is kept as parallel arrays (struct of arrays), so the mixing
+// loop steps every lane per sample with no per-voice method calls, and a
+// synth with many voices renders them a bank at a time. The wavetable level
+// of each lane is chosen once per block.
+type Bank struct {
+	sampleRate float64
+	lanes      int
+	shape      Shape
+	mode       BankMode
+	table      *Wavetable
+
+	phase  [MaxBankLanes]float64
+	inc    [MaxBankLanes]float64
+	gain   [MaxBankLanes]float32
+	active [MaxBankLanes]bool
+}
+
+// NewBank creates a bank of lanes oscillators (at most MaxBankLanes). All
+// lanes start inactive at 440 Hz with unity gain.
+func NewBank(sampleRate float64, lanes int, shape Shape, mode BankMode) *Bank {
+	if lanes < 1 {
+		lanes = 1
+	}
+	if lanes > MaxBankLanes {
+		lanes = MaxBankLanes
+	}
+	b := &Bank{
+		sampleRate: sampleRate,
+		lanes:      lanes,
+		mode:       mode,
+	}
+	b.SetShape(shape)
+	for l := 0; l < lanes; l++ {
+		b.inc[l] = 440.0 / sampleRate
+		b.gain[l] = 1
+	}
+	return b
+}
+
+// Lanes returns the number of lanes
+func (b *Bank) Lanes() int {
+	return b.lanes
+}
+
+// SetShape changes the waveform of every lane. In wavetable mode the first
+// use of a shape builds its shared table, so call this at setup time.
+func (b *Bank) SetShape(shape Shape) {
+	b.shape = shape
+	if b.mode == BankWavetable {
+		b.table = SharedWavetable(shape)
+	}
+}
+
+// SetFrequency sets the frequency of one lane
+func (b *Bank) SetFrequency(lane int, freq float64) {
+	b.inc[lane] = freq / b.sampleRate
+}
+
+// SetGain sets the level one lane contributes to ProcessMix
+func (b *Bank) SetGain(lane int, gain float32) {
+	b.gain[lane] = gain
+}
+
+// SetActive starts or stops a lane. Inactive lanes are skipped entirely.
+func (b *Bank) SetActive(lane int, active bool) {
+	b.active[lane] = active
+}
+
+// IsActive reports whether a lane is running
+func (b *Bank) IsActive(lane int) bool {
+	return b.active[lane]
+}
+
+// SetPhase sets the phase (0-1) of one lane
+func (b *Bank) SetPhase(lane int, phase float64) {
+	b.phase[lane] = phase - float64(int(phase))
+	if b.phase[lane] < 0 {
+		b.phase[lane]++
+	}
+}
+
+// Reset returns every lane to phase 0
+func (b *Bank) Reset() {
+	for l := range b.phase {
+		b.phase[l] = 0
+	}
+}
+
+// Process renders each active lane into outputs[lane] - no allocations.
+// Lane gains are not applied, so each voice can apply its own envelope.
+func (b *Bank) Process(outputs [][]float32) {
+	lanes := b.lanes
+	if len(outputs) < lanes {
+		lanes = len(outputs)
+	}
+	for l := 0; l < lanes; l++ {
+		if !b.active[l] {
+			continue
+		}
+		out := outputs[l]
+		phase, inc := b.phase[l], b.inc[l]
+
+		if b.mode == BankWavetable {
+			table := b.table.levels[LevelFor(inc)]
+			for i := range out {
+				out[i] = lookup(table, phase)
+				phase += inc
+				if phase >= 1 {
+					phase--
+				}
+			}
+		} else {
+			for i := range out {
+				out[i] = float32(polyBLEPSample(b.shape, phase, inc))
+				phase += inc
+				if phase >= 1 {
+					phase--
+				}
+			}
+		}
+		b.phase[l] = phase
+	}
+}
+
+// ProcessMix renders the gain-weighted sum of every active lane into out -
+// no allocations
+func (b *Bank) ProcessMix(out []float32) {
+	for i := range out {
+		out[i] = 0
+	}
+
+	// Gather the active lanes so the inner loop has no branches
+	var (
+		tables [MaxBankLanes][]float32
+		phase  [MaxBankLanes]float64
+		inc    [MaxBankLanes]float64
+		gain   [MaxBankLanes]float32
+		index  [MaxBankLanes]int
+	)
+	n := 0
+	for l := 0; l < b.lanes; l++ {
+		if !b.active[l] {
+			continue
+		}
+		if b.mode == BankWavetable {
+			tables[n] = b.table.levels[LevelFor(b.inc[l])]
+		}
+		phase[n], inc[n], gain[n], index[n] = b.phase[l], b.inc[l], b.gain[l], l
+		n++
+	}
+	if n == 0 {
+		return
+	}
+
+	if b.mode == BankWavetable {
+		for i := range out {
+			acc := float32(0)
+			for l := 0; l < n; l++ {
+				acc += gain[l] * lookup(tables[l], phase[l])
+				phase[l] += inc[l]
+				if phase[l] >= 1 {
+					phase[l]--
+				}
+			}
+			out[i] = acc
+		}
+	} else {
+		for i := range out {
+			acc := float32(0)
+			for l := 0; l < n; l++ {
+				acc += gain[l] * float32(polyBLEPSample(b.shape, phase[l], inc[l]))
+				phase[l] += inc[l]
+				if phase[l] >= 1 {
+					phase[l]--
+				}
+			}
+			out[i] = acc
+		}
+	}
+
+	for l := 0; l < n; l++ {
+		b.phase[index[l]] = phase[l]
+	}
+}
@@ -45,9 +45,9 @@ func (o *Oscillator) updatePhase() {
 	}
 }
 
-// Sine generates a sine wave sample
+// Sine generates a sine wave sample from the shared sine table
 func (o *Oscillator) Sine() float32 {
-	sample := float32(math.Sin(2.0 * math.Pi * o.phase))
+	sample := lookup(sineTable, o.phase)
 	o.updatePhase()
 	return sample
 }
@@ -0,0 +1,211 @@
+package oscillator
+
+import (
+	"math"
+	"testing"
+)
+
+func TestSineTable(t *testing.T) {
+	osc := New(48000)
+	osc.SetFrequency(997)
+	for i := 0; i < 4800; i++ {
+		want := math.Sin(2 * math.Pi * osc.phase)
+		if got := float64(osc.Sine()); math.Abs(got-want) > 1e-5 {
+			t.Fatalf("Sample %d: got %f, want %f", i, got, want)
+		}
+	}
+}
+
+func TestLevelForStaysBelowNyquist(t *testing.T) {
+	for _, freq := range []float64{20, 100, 440, 1000, 5000, 12000, 20000} {
+		inc := freq / 48000
+		level := LevelFor(inc)
+		harmonics := maxHarmonics >> level
+		if level < TableLevels-1 && float64(harmonics)*inc > 0.5 {
+			t.Errorf("%.0f Hz: level %d has %d partials, top one at %.3f",
+				freq, level, harmonics, float64(harmonics)*inc)
+		}
+		// The next richer level must alias, or this level is duller than needed
+		if level > 0 && float64(harmonics*2)*inc <= 0.5 {
+			t.Errorf("%.0f Hz: level %d is not the richest alias-free level", freq, level)
+		}
+	}
+}
+
+func TestWavetableMatchesNaiveShapes(t *testing.T) {
+	naive := New(48000)
+	for _, tc := range []struct {
+		shape Shape
+		next  func() float32
+	}{
+		{ShapeSaw, naive.Saw},
+		{ShapeSquare, naive.Square},
+		{ShapeTriangle, naive.Triangle},
+	} {
+		table := SharedWavetable(tc.shape)
+		naive.Reset()
+		naive.SetFrequency(48000.0 / TableSize)
+
+		// Away from the discontinuities the richest level tracks the naive shape
+		for i := 0; i < TableSize; i++ {
+			phase := float64(i) / TableSize
+			want := tc.next()
+			if phase < 0.05 || math.Abs(phase-0.5) < 0.05 || phase > 0.95 {
+				continue
+			}
+			if got := table.Lookup(0, phase); math.Abs(float64(got-want)) > 0.02 {
+				t.Errorf("Shape %d phase %.3f: got %f, want %f", tc.shape, phase, got, want)
+				break
+			}
+		}
+	}
+	if SharedWavetable(ShapeSaw) != SharedWavetable(ShapeSaw) {
+		t.Error("Shared wavetables should be built once")
+	}
+}
+
+// aliasLevel renders shape with the given correction increment and sums the
+// windowed spectrum at the frequencies the first partials above Nyquist
+// fold back to
+func aliasLevel(shape Shape, inc, correction float64) float64 {
+	const n = 8192
+	signal := make([]float64, n)
+	phase := 0.0
+	for i := range signal {
+		window := 0.5 - 0.5*math.Cos(2*math.Pi*float64(i)/n)
+		signal[i] = window * polyBLEPSample(shape, phase, correction)
+		phase += inc
+		if phase >= 1 {
+			phase--
+		}
+	}
+
+	total := 0.0
+	found := 0
+	for h := 2; found < 4; h++ {
+		if amplitude, _ := harmonic(shape, h); amplitude == 0 || float64(h)*inc <= 0.5 {
+			continue
+		}
+		f := float64(h) * inc
+		f = math.Abs(f - math.Round(f))
+		var re, im float64
+		for i, v := range signal {
+			re += v * math.Cos(2*math.Pi*f*float64(i))
+			im -= v * math.Sin(2*math.Pi*f*float64(i))
+		}
+		total += math.Hypot(re, im)
+		found++
+	}
+	return total
+}
+
+func TestPolyBLEPReducesAliasing(t *testing.T) {
+	const inc = 2937.0 / 48000
+	for _, shape := range []Shape{ShapeSaw, ShapeSquare, ShapeTriangle} {
+		naive := aliasLevel(shape, inc, 0)
+		corrected := aliasLevel(shape, inc, inc)
+		if corrected >= naive*0.5 {
+			t.Errorf("Shape %d: PolyBLEP aliasing %f not well below naive %f", shape, corrected, naive)
+		}
+	}
+}
+
+func TestBankProcessMatchesMix(t *testing.T) {
+	for _, mode := range []BankMode{BankWavetable, BankPolyBLEP} {
+		perLane := NewBank(48000, 4, ShapeSaw, mode)
+		mixed := NewBank(48000, 4, ShapeSaw, mode)
+		for l := 0; l < 4; l++ {
+			freq := 110 * float64(l+1)
+			perLane.SetFrequency(l, freq)
+			mixed.SetFrequency(l, freq)
+			mixed.SetGain(l, 0.25)
+			if l != 2 {
+				perLane.SetActive(l, true)
+				mixed.SetActive(l, true)
+			}
+		}
+
+		outputs := make([][]float32, 4)
+		for l := range outputs {
+			outputs[l] = make([]float32, 256)
+		}
+		sum := make([]float32, 256)
+		perLane.Process(outputs)
+		mixed.ProcessMix(sum)
+
+		for i := range sum {
+			want := 0.25 * (outputs[0][i] + outputs[1][i] + outputs[3][i])
+			if math.Abs(float64(sum[i]-want)) > 1e-5 {
+				t.Fatalf("Mode %d sample %d: mix %f, lanes %f", mode, i, sum[i], want)
+			}
+		}
+		if outputs[2][0] != 0 {
+			t.Errorf("Mode %d: inactive lane was rendered", mode)
+		}
+	}
+}
+
+func TestBankZeroAllocations(t *testing.T) {
+	b := NewBank(48000, MaxBankLanes, ShapeSquare, BankWavetable)
+	for l := 0; l < MaxBankLanes; l++ {
+		b.SetActive(l, true)
+	}
+	out := make([]float32, 512)
+	outputs := [][]float32{out}
+	allocs := testing.AllocsPerRun(50, func() {
+		b.ProcessMix(out)
+		b.Process(outputs)
+	})
+	if allocs != 0 {
+		t.Errorf("Bank allocated %.1f times", allocs)
+	}
+}
+
+// BenchmarkVoices64 renders 64 saw voices one oscillator at a time and eight
+// banks at a time
+func BenchmarkVoices64(b *testing.B) {
+	out := make([]float32, 512)
+	voice := make([]float32, 512)
+
+	b.Run("BandLimitedSaw", func(b *testing.B) {
+		oscs := make([]*BandLimitedSaw, 64)
+		for v := range oscs {
+			oscs[v] = NewBandLimitedSaw(48000)
+			oscs[v].SetFrequency(55 * float64(v%24+1))
+		}
+		for i := 0; i < b.N; i++ {
+			for _, osc := range oscs {
+				osc.Process(voice)
+				for s := range out {
+					out[s] += voice[s]
+				}
+			}
+		}
+	})
+
+	for _, mode := range []struct {
+		name string
+		mode BankMode
+	}{{"BankWavetable", BankWavetable}, {"BankPolyBLEP", BankPolyBLEP}} {
+		b.Run(mode.name, func(b *testing.B) {
+			banks := make([]*Bank, 64/MaxBankLanes)
+			for k := range banks {
+				banks[k] = NewBank(48000, MaxBankLanes, ShapeSaw, mode.mode)
+				for l := 0; l < MaxBankLanes; l++ {
+					banks[k].SetFrequency(l, 55*float64((k*MaxBankLanes+l)%24+1))
+					banks[k].SetActive(l, true)
+				}
+			}
+			b.ReportAllocs()
+			b.ResetTimer()
+			for i := 0; i < b.N; i++ {
+				for _, bank := range banks {
+					bank.ProcessMix(voice)
+					for s := range out {
+						out[s] += voice[s]
+					}
+				}
+			}
+		})
+	}
+}
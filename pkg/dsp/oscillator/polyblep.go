@@ -0,0 +1,64 @@
+package oscillator
+
+// PolyBLEP returns the two-sample polynomial band-limited step residual for
+// a discontinuity at phase 0, where t is the phase (0-1) and dt the phase
+// increment. Subtracting it from a naive waveform with a unit step at the
+// wrap removes most of the aliasing the step causes.
+func PolyBLEP(t, dt float64) float64 {
+	if t < dt {
+		t /= dt
+		return t + t - t*t - 1
+	}
+	if t > 1-dt {
+		t = (t - 1) / dt
+		return t*t + t + t + 1
+	}
+	return 0
+}
+
+// PolyBLAMP returns the band-limited ramp residual for a unit change of
+// slope at phase 0, the integrated counterpart of PolyBLEP used to smooth
+// the corners of a triangle wave
+func PolyBLAMP(t, dt float64) float64 {
+	if t < dt {
+		t = t/dt - 1
+		return -t * t * t / 3
+	}
+	if t > 1-dt {
+		t = (t-1)/dt + 1
+		return t * t * t / 3
+	}
+	return 0
+}
+
+// polyBLEPSample renders one sample of shape at phase t with increment dt.
+// Sine needs no correction.
+func polyBLEPSample(shape Shape, t, dt float64) float64 {
+	switch shape {
+	case ShapeSaw:
+		return 2*t - 1 - PolyBLEP(t, dt)
+	case ShapeSquare:
+		y := -1.0
+		if t < 0.5 {
+			y = 1
+		}
+		return y + PolyBLEP(t, dt) - PolyBLEP(wrapHalf(t), dt)
+	case ShapeTriangle:
+		y := 3 - 4*t
+		if t < 0.5 {
+			y = 4*t - 1
+		}
+		return y + 4*dt*(PolyBLAMP(t, dt)-PolyBLAMP(wrapHalf(t), dt))
+	default:
+		return float64(lookup(sineTable, t))
+	}
+}
+
+// wrapHalf offsets a phase by half a cycle
+func wrapHalf(t float64) float64 {
+	t += 0.5
+	if t >= 1 {
+		t--
+	}
+	return t
+}
@@ -0,0 +1,160 @@
+package oscillator
+
+import (
+	"math"
+	"sync"
+)
+
+// Shape selects a classic oscillator waveform
+type Shape int
+
+const (
+	ShapeSine Shape = iota
+	ShapeSaw
+	ShapeSquare
+	ShapeTriangle
+)
+
+const (
+	// TableSize is the length of one wavetable cycle
+	TableSize = 2048
+	tableMask = TableSize - 1
+
+	// TableLevels is the number of mip levels per wavetable, one per octave.
+	// Level 0 holds maxHarmonics partials and each level halves that.
+	TableLevels  = 10
+	maxHarmonics = 512
+)
+
+// sineTable is one sine cycle plus a guard sample for interpolation
+var sineTable = buildSineTable()
+
+func buildSineTable() []float32 {
+	table := make([]float32, TableSize+1)
+	for i := range table {
+		table[i] = float32(math.Sin(2 * math.Pi * float64(i) / TableSize))
+	}
+	return table
+}
+
+// Wavetable is a mip-mapped, band-limited single-cycle waveform. Each octave
+// level omits the partials that would alias at the frequencies it is used
+// for. Tables are read-only once built and can be shared by any number of
+// oscillators.
+type Wavetable struct {
+	levels [TableLevels][]float32 // TableSize + 1 samples each
+}
+
+var (
+	sharedTables [ShapeTriangle + 1]*Wavetable
+	sharedOnce   [ShapeTriangle + 1]sync.Once
+)
+
+// SharedWavetable returns the process-wide table for shape, building it on
+// first use. Call it at setup time; the first call for each shape computes
+// every level by additive synthesis.
+func SharedWavetable(shape Shape) *Wavetable {
+	if shape < ShapeSine || shape > ShapeTriangle {
+		shape = ShapeSine
+	}
+	sharedOnce[shape].Do(func() {
+		sharedTables[shape] = NewWavetable(shape)
+	})
+	return sharedTables[shape]
+}
+
+// NewWavetable builds a wavetable for shape. The levels match the naive
+// waveforms of Oscillator in phase and polarity.
+func NewWavetable(shape Shape) *Wavetable {
+	w := &Wavetable{}
+	for level := range w.levels {
+		w.levels[level] = buildLevel(shape, maxHarmonics>>level)
+	}
+	return w
+}
+
+// buildLevel sums harmonics up to limit, reading sines from sineTable so
+// every partial lands exactly on the table grid
+func buildLevel(shape Shape, limit int) []float32 {
+	sum := make([]float64, TableSize)
+	for h := 1; h <= limit; h++ {
+		amplitude, offset := harmonic(shape, h)
+		if amplitude == 0 {
+			continue
+		}
+		for i := range sum {
+			sum[i] += amplitude * float64(sineTable[(h*i+offset)&tableMask])
+		}
+	}
+
+	table := make([]float32, TableSize+1)
+	for i, v := range sum {
+		table[i] = float32(v)
+	}
+	table[TableSize] = table[0]
+	return table
+}
+
+// harmonic returns the amplitude of partial h and its phase offset in table
+// samples (TableSize/4 turns the sine into a cosine)
+func harmonic(shape Shape, h int) (amplitude float64, offset int) {
+	switch shape {
+	case ShapeSaw:
+		// 2*phase - 1
+		return -2 / (math.Pi * float64(h)), 0
+	case ShapeSquare:
+		if h%2 == 1 {
+			return 4 / (math.Pi * float64(h)), 0
+		}
+	case ShapeTriangle:
+		// -1 at phase 0, +1 at phase 0.5
+		if h%2 == 1 {
+			return -8 / (math.Pi * math.Pi * float64(h*h)), TableSize / 4
+		}
+	default:
+		if h == 1 {
+			return 1, 0
+		}
+	}
+	return 0, 0
+}
+
+// LevelFor returns the mip level to use for a phase increment in cycles per
+// sample: the richest level with no partial above Nyquist
+func LevelFor(phaseInc float64) int {
+	if phaseInc <= 0 {
+		return 0
+	}
+	// Level k is alias-free while phaseInc <= 2^k / (2*maxHarmonics)
+	_, exp := math.Frexp(phaseInc * 2 * maxHarmonics)
+	level := exp
+	if math.Ldexp(1, exp-1) == phaseInc*2*maxHarmonics {
+		level = exp - 1
+	}
+	if level < 0 {
+		return 0
+	}
+	if level >= TableLevels {
+		return TableLevels - 1
+	}
+	return level
+}
+
+// Level returns mip level k (TableSize + 1 samples, the last one a guard)
+func (w *Wavetable) Level(k int) []float32 {
+	return w.levels[k]
+}
+
+// Lookup reads level k at phase (0-1) with linear interpolation
+func (w *Wavetable) Lookup(k int, phase float64) float32 {
+	return lookup(w.levels[k], phase)
+}
+
+func lookup(table []float32, phase float64) float32 {
+	position := phase * TableSize
+	index := int(position)
+	frac := float32(position - float64(index))
+	index &= tableMask
+	a := table[index]
+	return a + (table[index+1]-a)*frac
+}
@@ -0,0 +1,146 @@
+package oversample
+
+import "math"
+
+// firHalfTaps is the number of nonzero taps on each side of the centre of
+// each stage's half-band FIR. The first stage sees content up to the base
+// Nyquist and needs the steepest filter; later stages only have to reject
+// images far above the signal and get away with far fewer taps.
+var firHalfTaps = [...]int{16, 6, 4}
+
+// firKaiserBeta sets the stopband rejection of the windowed-sinc design (~90 dB)
+const firKaiserBeta = 9.0
+
+// firStage is a linear-phase half-band FIR in polyphase form. Every other tap
+// of a half-band filter is zero except the centre tap of 0.5, so one phase
+// is a pure delay and only the other phase needs a dot product.
+type firStage struct {
+	half int       // Nonzero taps per side (N)
+	taps []float64 // The 2N taps of the filtering phase
+
+	// Per-channel histories, written twice so a window never wraps
+	up      [][]float64
+	upPos   []int
+	even    [][]float64
+	odd     [][]float64
+	downPos []int
+}
+
+func newFIRStage(channels, index int) *firStage {
+	half := firHalfTaps[index]
+	f := &firStage{
+		half:    half,
+		taps:    designHalfband(half),
+		up:      make([][]float64, channels),
+		upPos:   make([]int, channels),
+		even:    make([][]float64, channels),
+		odd:     make([][]float64, channels),
+		downPos: make([]int, channels),
+	}
+	for ch := 0; ch < channels; ch++ {
+		f.up[ch] = make([]float64, 4*half)
+		f.even[ch] = make([]float64, 4*half)
+		f.odd[ch] = make([]float64, 4*half)
+	}
+	return f
+}
+
+// designHalfband returns the filtering phase of a Kaiser-windowed half-band
+// FIR with half nonzero taps per side, normalized to unity DC gain
+func designHalfband(half int) []float64 {
+	length := 4*half - 1
+	centre := float64(2*half - 1)
+	taps := make([]float64, 2*half)
+
+	sum := 0.0
+	for k := range taps {
+		m := float64(2 * k)
+		x := (m - centre) / 2
+		sinc := math.Sin(math.Pi*x) / (math.Pi * x)
+		r := 2*m/float64(length-1) - 1
+		window := besselI0(firKaiserBeta*math.Sqrt(1-r*r)) / besselI0(firKaiserBeta)
+		taps[k] = 0.5 * sinc * window
+		sum += taps[k]
+	}
+	// The centre tap supplies the other half of the DC gain
+	for k := range taps {
+		taps[k] *= 0.5 / sum
+	}
+	return taps
+}
+
+// besselI0 is the zeroth-order modified Bessel function of the first kind
+func besselI0(x float64) float64 {
+	sum, term := 1.0, 1.0
+	for k := 1; k < 50; k++ {
+		term *= (x / (2 * float64(k))) * (x / (2 * float64(k)))
+		sum += term
+		if term < 1e-12*sum {
+			break
+		}
+	}
+	return sum
+}
+
+// push writes x as the newest sample of a doubled history and returns the
+// window that starts with it
+func push(history []float64, pos *int, x float64) []float64 {
+	size := len(history) / 2
+	*pos--
+	if *pos < 0 {
+		*pos = size - 1
+	}
+	history[*pos] = x
+	history[*pos+size] = x
+	return history[*pos : *pos+size]
+}
+
+func (f *firStage) upsample(channel int, in, out []float64) {
+	history := f.up[channel]
+	pos := &f.upPos[channel]
+	taps := f.taps
+	for n, x := range in {
+		window := push(history, pos, x)
+		window = window[:len(taps)]
+		acc := 0.0
+		for k, h := range taps {
+			acc += h * window[k]
+		}
+		// Zero stuffing halves the level; the factor of 2 restores it
+		out[2*n] = 2 * acc
+		out[2*n+1] = window[f.half-1]
+	}
+}
+
+func (f *firStage) downsample(channel int, in, out []float64) {
+	even := f.even[channel]
+	odd := f.odd[channel]
+	taps := f.taps
+	for n := range out {
+		pos := f.downPos[channel]
+		window := push(even, &pos, in[2*n])
+		oddWindow := push(odd, &f.downPos[channel], in[2*n+1])
+
+		window = window[:len(taps)]
+		acc := 0.0
+		for k, h := range taps {
+			acc += h * window[k]
+		}
+		out[n] = acc + 0.5*oddWindow[f.half]
+	}
+}
+
+// delay is the centre-tap delay of the up and down filters combined
+func (f *firStage) delay() float64 {
+	return float64(4*f.half - 2)
+}
+
+func (f *firStage) reset() {
+	for ch := range f.up {
+		clear(f.up[ch])
+		clear(f.even[ch])
+		clear(f.odd[ch])
+		f.upPos[ch] = 0
+		f.downPos[ch] = 0
+	}
+}
@@ -0,0 +1,150 @@
+package oversample
+
+import "math"
+
+// iirDesigns lists the allpass coefficient count and normalized transition
+// bandwidth of each stage. As with the FIR stages, the first stage is the
+// steep one.
+var iirDesigns = [...]struct {
+	coefficients int
+	transition   float64
+}{
+	{8, 0.04},
+	{4, 0.22},
+	{3, 0.35},
+}
+
+// iirStage is a polyphase IIR half-band: two parallel chains of first-order
+// allpass sections, each running at the low rate. Every section costs one
+// multiply, which makes this the cheapest steep half-band available.
+type iirStage struct {
+	coeffs []float64
+
+	// Section state (x1, y1 pairs) per channel, for each direction
+	up   [][]float64
+	down [][]float64
+}
+
+func newIIRStage(channels, index int) *iirStage {
+	design := iirDesigns[index]
+	s := &iirStage{
+		coeffs: designPolyphaseIIR(design.coefficients, design.transition),
+		up:     make([][]float64, channels),
+		down:   make([][]float64, channels),
+	}
+	for ch := 0; ch < channels; ch++ {
+		s.up[ch] = make([]float64, 2*len(s.coeffs))
+		s.down[ch] = make([]float64, 2*len(s.coeffs))
+	}
+	return s
+}
+
+// allpass runs x through first-order allpass section i of state
+func allpass(coeff float64, state []float64, i int, x float64) float64 {
+	y := state[2*i] + (x-state[2*i+1])*coeff
+	state[2*i] = x
+	state[2*i+1] = y
+	return y
+}
+
+func (s *iirStage) upsample(channel int, in, out []float64) {
+	state := s.up[channel]
+	coeffs := s.coeffs
+	for n, x := range in {
+		even, odd := x, x
+		for i := 0; i < len(coeffs); i += 2 {
+			even = allpass(coeffs[i], state, i, even)
+			if i+1 < len(coeffs) {
+				odd = allpass(coeffs[i+1], state, i+1, odd)
+			}
+		}
+		out[2*n] = even
+		out[2*n+1] = odd
+	}
+}
+
+func (s *iirStage) downsample(channel int, in, out []float64) {
+	state := s.down[channel]
+	coeffs := s.coeffs
+	for n := range out {
+		even, odd := in[2*n+1], in[2*n]
+		for i := 0; i < len(coeffs); i += 2 {
+			even = allpass(coeffs[i], state, i, even)
+			if i+1 < len(coeffs) {
+				odd = allpass(coeffs[i+1], state, i+1, odd)
+			}
+		}
+		out[n] = 0.5 * (even + odd)
+	}
+}
+
+// delay is the DC group delay of the up and down filters combined. Each
+// section (a + z^-2)/(1 + a z^-2) delays DC by 2(1-a)/(1+a) high-rate
+// samples; the two branches are averaged and offset by one sample.
+func (s *iirStage) delay() float64 {
+	total := 1.0
+	for _, a := range s.coeffs {
+		total += 2 * (1 - a) / (1 + a)
+	}
+	return total
+}
+
+func (s *iirStage) reset() {
+	for ch := range s.up {
+		clear(s.up[ch])
+		clear(s.down[ch])
+	}
+}
+
+// designPolyphaseIIR computes the allpass coefficients of an elliptic
+// half-band filter split into two polyphase branches, for the given number
+// of coefficients and transition bandwidth (relative to the high rate).
+// Even-indexed coefficients belong to one branch, odd-indexed to the other.
+func designPolyphaseIIR(count int, transition float64) []float64 {
+	k := math.Tan((1 - transition*2) * math.Pi / 4)
+	k *= k
+	kkSqrt := math.Pow(1-k*k, 0.25)
+	e := 0.5 * (1 - kkSqrt) / (1 + kkSqrt)
+	e2 := e * e
+	e4 := e2 * e2
+	q := e * (1 + e4*(2+e4*(15+150*e4)))
+
+	order := float64(count*2 + 1)
+	coeffs := make([]float64, count)
+	for index := range coeffs {
+		c := float64(index + 1)
+		num := ellipticNumerator(q, order, c) * math.Pow(q, 0.25)
+		den := ellipticDenominator(q, order, c) + 0.5
+		ww := num / den
+		wwSq := ww * ww
+		x := math.Sqrt((1-wwSq*k)*(1-wwSq/k)) / (1 + wwSq)
+		coeffs[index] = (1 - x) / (1 + x)
+	}
+	return coeffs
+}
+
+func ellipticNumerator(q, order, c float64) float64 {
+	acc := 0.0
+	sign := 1.0
+	for i := 0; ; i++ {
+		term := math.Pow(q, float64(i*(i+1))) * math.Sin(float64(i*2+1)*c*math.Pi/order) * sign
+		acc += term
+		sign = -sign
+		if math.Abs(term) <= 1e-100 || i > 100 {
+			return acc
+		}
+	}
+}
+
+func ellipticDenominator(q, order, c float64) float64 {
+	acc := 0.0
+	sign := -1.0
+	for i := 1; ; i++ {
+		term := math.Pow(q, float64(i*i)) * math.Cos(float64(i*2)*c*math.Pi/order) * sign
+		acc += term
+		sign = -sign
+		if math.Abs(term) <= 1e-100 || i > 100 {
+			return acc
+		}
+	}
+}
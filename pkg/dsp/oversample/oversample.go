@@ -0,0 +1,246 @@
+// Package oversample runs nonlinear processing at 2x, 4x or 8x the base
+// sample rate. Each factor of two is a polyphase half-band stage, so every
+// filter runs at the lower of its two rates and skips the zero-stuffed
+// inputs, a fraction of the work of a single long resampling FIR.
+//
+// All state and rate buffers are allocated when the Oversampler is created;
+// the block methods do not allocate.
+package oversample
+
+import "math"
+
+// Mode selects the half-band filter design
+type Mode int
+
+const (
+	// LinearPhase uses symmetric half-band FIR stages. All frequencies are
+	// delayed equally, by Latency samples.
+	LinearPhase Mode = iota
+	// MinimumPhase uses polyphase IIR allpass stages: far less delay and
+	// CPU, at the cost of a frequency-dependent phase shift near Nyquist.
+	MinimumPhase
+)
+
+// Supported oversampling factors
+const (
+	Factor2 = 2
+	Factor4 = 4
+	Factor8 = 8
+)
+
+// stage is one 2x half-band step between a low and a high rate
+type stage interface {
+	// upsample doubles in into out (len(out) = 2*len(in))
+	upsample(channel int, in, out []float64)
+	// downsample halves in into out (len(in) = 2*len(out))
+	downsample(channel int, in, out []float64)
+	// delay is the up/down round-trip delay in samples at the high rate
+	delay() float64
+	reset()
+}
+
+// Oversampler converts blocks between the base rate and factor times the base
+// rate for a fixed number of channels
+type Oversampler struct {
+	factor       int
+	mode         Mode
+	channels     int
+	maxBlockSize int
+	stages       []stage
+	latency      int
+	upLatency    int
+
+	// levels[ch][k] holds channel ch at 2^(k+1) times the base rate
+	levels [][][]float64
+
+	// Linear-phase alignment delay at the top rate, so the total latency is
+	// a whole number of base-rate samples
+	pad     int
+	padTail [][8]float64
+}
+
+// New creates an oversampler for channels channels and base-rate blocks of
+// up to maxBlockSize samples. factor is rounded to 2, 4 or 8.
+func New(channels, factor int, mode Mode, maxBlockSize int) *Oversampler {
+	if channels < 1 {
+		channels = 1
+	}
+	if maxBlockSize < 1 {
+		maxBlockSize = 1
+	}
+	numStages := 1
+	switch {
+	case factor >= Factor8:
+		numStages = 3
+	case factor >= Factor4:
+		numStages = 2
+	}
+
+	o := &Oversampler{
+		factor:       1 << numStages,
+		mode:         mode,
+		channels:     channels,
+		maxBlockSize: maxBlockSize,
+		levels:       make([][][]float64, channels),
+		padTail:      make([][8]float64, channels),
+	}
+
+	for s := 0; s < numStages; s++ {
+		if mode == MinimumPhase {
+			o.stages = append(o.stages, newIIRStage(channels, s))
+		} else {
+			o.stages = append(o.stages, newFIRStage(channels, s))
+		}
+	}
+	for ch := range o.levels {
+		o.levels[ch] = make([][]float64, numStages)
+		for s := range o.levels[ch] {
+			o.levels[ch][s] = make([]float64, maxBlockSize<<(s+1))
+		}
+	}
+
+	o.computeLatency()
+	return o
+}
+
+// computeLatency sums the stage delays in top-rate samples and, for linear
+// phase, pads them up to a whole base-rate sample
+func (o *Oversampler) computeLatency() {
+	total := 0.0
+	for s, st := range o.stages {
+		total += st.delay() * float64(int(1)<<(len(o.stages)-1-s))
+	}
+	// The up and down filters of a stage are identical, so each direction
+	// carries half of the round trip
+	o.upLatency = int(math.Ceil(total / 2 / float64(o.factor)))
+
+	if o.mode == LinearPhase {
+		top := int(total + 0.5)
+		o.pad = (o.factor - top%o.factor) % o.factor
+		o.latency = (top + o.pad) / o.factor
+		return
+	}
+	// The allpass stages have no exact delay; report the low-frequency group delay
+	o.latency = int(total/float64(o.factor) + 0.5)
+}
+
+// Factor returns the oversampling factor (2, 4 or 8)
+func (o *Oversampler) Factor() int {
+	return o.factor
+}
+
+// Mode returns the filter design in use
+func (o *Oversampler) Mode() Mode {
+	return o.mode
+}
+
+// Latency returns the delay an Upsample/Downsample round trip adds, in
+// base-rate samples. Report it through GetLatencySamples.
+func (o *Oversampler) Latency() int {
+	return o.latency
+}
+
+// UpsampleLatency returns the delay of Upsample alone, rounded up to whole
+// base-rate samples. Detectors that only look at the oversampled signal
+// (true-peak meters, limiter sidechains) align the dry path with it.
+func (o *Oversampler) UpsampleLatency() int {
+	return o.upLatency
+}
+
+// MaxBlockSize returns the longest base-rate block Upsample accepts
+func (o *Oversampler) MaxBlockSize() int {
+	return o.maxBlockSize
+}
+
+// Upsample converts a base-rate block of one channel to the oversampled rate
+// and returns the oversampled block, which the caller may process in place
+// before calling Downsample. The returned slice is owned by the oversampler.
+// Blocks longer than MaxBlockSize are truncated; an empty block leaves the
+// filter state untouched.
+func (o *Oversampler) Upsample(channel int, input []float64) []float64 {
+	n := len(input)
+	if n > o.maxBlockSize {
+		n = o.maxBlockSize
+	}
+	levels := o.levels[channel]
+	if n == 0 {
+		return levels[len(o.stages)-1][:0]
+	}
+
+	in := input[:n]
+	for s, st := range o.stages {
+		out := levels[s][:n<<(s+1)]
+		st.upsample(channel, in, out)
+		in = out
+	}
+	return in
+}
+
+// Downsample converts the channel's oversampled block back to the base rate
+// into output, whose length must match the block passed to Upsample. An
+// empty output is a no-op.
+func (o *Oversampler) Downsample(channel int, output []float64) {
+	n := len(output)
+	if n > o.maxBlockSize {
+		n = o.maxBlockSize
+	}
+	if n == 0 {
+		return
+	}
+	levels := o.levels[channel]
+	top := len(o.stages) - 1
+
+	in := levels[top][:n<<(top+1)]
+	if o.pad > 0 {
+		o.delayTop(channel, in)
+	}
+	for s := top; s >= 0; s-- {
+		var out []float64
+		if s == 0 {
+			out = output[:n]
+		} else {
+			out = levels[s-1][:n<<s]
+		}
+		o.stages[s].downsample(channel, in, out)
+		in = out
+	}
+}
+
+// Process upsamples input, runs process on the oversampled block and writes
+// the downsampled result to output. Blocks of any length are split into
+// chunks of at most MaxBlockSize. input and output may be the same slice.
+func (o *Oversampler) Process(channel int, input, output []float64, process func(block []float64)) {
+	n := len(input)
+	if len(output) < n {
+		n = len(output)
+	}
+	for start := 0; start < n; start += o.maxBlockSize {
+		end := start + o.maxBlockSize
+		if end > n {
+			end = n
+		}
+		block := o.Upsample(channel, input[start:end])
+		process(block)
+		o.Downsample(channel, output[start:end])
+	}
+}
+
+// delayTop delays the top-rate block by pad samples
+func (o *Oversampler) delayTop(channel int, block []float64) {
+	tail := &o.padTail[channel]
+	var next [8]float64
+	copy(next[:o.pad], block[len(block)-o.pad:])
+	copy(block[o.pad:], block[:len(block)-o.pad])
+	copy(block[:o.pad], tail[:o.pad])
+	*tail = next
+}
+
+// Reset clears the filter state of every channel
+func (o *Oversampler) Reset() {
+	for _, st := range o.stages {
+		st.reset()
+	}
+	for ch := range o.padTail {
+		o.padTail[ch] = [8]float64{}
+	}
+}
@@ -0,0 +1,221 @@
+package oversample
+
+import (
+	"math"
+	"testing"
+)
+
+// magnitudeAt returns the amplitude of frequency f (cycles per sample) in x
+func magnitudeAt(x []float64, f float64) float64 {
+	var re, im float64
+	for i, v := range x {
+		phase := 2 * math.Pi * f * float64(i)
+		re += v * math.Cos(phase)
+		im -= v * math.Sin(phase)
+	}
+	return math.Hypot(re, im) * 2 / float64(len(x))
+}
+
+func sine(n int, f float64) []float64 {
+	x := make([]float64, n)
+	for i := range x {
+		x[i] = math.Sin(2 * math.Pi * f * float64(i))
+	}
+	return x
+}
+
+func TestOversamplerFactors(t *testing.T) {
+	for _, factor := range []int{Factor2, Factor4, Factor8} {
+		for _, mode := range []Mode{LinearPhase, MinimumPhase} {
+			o := New(1, factor, mode, 512)
+			if o.Factor() != factor {
+				t.Errorf("Factor %d: got %d", factor, o.Factor())
+			}
+			up := o.Upsample(0, make([]float64, 100))
+			if len(up) != 100*factor {
+				t.Errorf("Factor %d: upsampled length %d", factor, len(up))
+			}
+		}
+	}
+	if New(1, 3, LinearPhase, 64).Factor() != Factor2 {
+		t.Error("Unsupported factors should round down")
+	}
+}
+
+func TestImageRejection(t *testing.T) {
+	const n = 4096
+	const f = 0.2 // 9.6 kHz at 48 kHz
+	for _, mode := range []Mode{LinearPhase, MinimumPhase} {
+		for _, factor := range []int{Factor2, Factor4, Factor8} {
+			o := New(1, factor, mode, n)
+			up := o.Upsample(0, sine(n, f))
+			settled := up[len(up)/4:]
+
+			signal := magnitudeAt(settled, f/float64(factor))
+			image := magnitudeAt(settled, (1-f)/float64(factor))
+			if math.Abs(signal-1) > 0.01 {
+				t.Errorf("Mode %d x%d: passband level %f", mode, factor, signal)
+			}
+			if db := 20 * math.Log10(image/signal); db > -70 {
+				t.Errorf("Mode %d x%d: image only %.1f dB down", mode, factor, db)
+			}
+		}
+	}
+}
+
+func TestLinearPhaseLatency(t *testing.T) {
+	const n = 2048
+	for _, factor := range []int{Factor2, Factor4, Factor8} {
+		o := New(1, factor, LinearPhase, n)
+		input := sine(n, 0.05)
+		output := make([]float64, n)
+		o.Process(0, input, output, func([]float64) {})
+
+		latency := o.Latency()
+		if latency <= 0 {
+			t.Fatalf("x%d: expected positive latency, got %d", factor, latency)
+		}
+		for i := n / 2; i < n; i++ {
+			if diff := math.Abs(output[i] - input[i-latency]); diff > 1e-3 {
+				t.Fatalf("x%d: sample %d off by %f with latency %d", factor, i, diff, latency)
+			}
+		}
+	}
+}
+
+func TestUpsampleLatency(t *testing.T) {
+	for _, factor := range []int{Factor2, Factor4, Factor8} {
+		o := New(1, factor, LinearPhase, 256)
+		impulse := make([]float64, 256)
+		impulse[0] = 1
+		up := o.Upsample(0, impulse)
+
+		peak := 0
+		for i, v := range up {
+			if math.Abs(v) > math.Abs(up[peak]) {
+				peak = i
+			}
+		}
+		// The impulse lands within the sample before the reported latency
+		delay := float64(peak) / float64(factor)
+		if latency := float64(o.UpsampleLatency()); delay > latency || delay <= latency-1 {
+			t.Errorf("x%d: impulse at %.2f samples, UpsampleLatency %v", factor, delay, latency)
+		}
+	}
+}
+
+func TestMinimumPhaseUsesLessLatency(t *testing.T) {
+	linear := New(1, Factor4, LinearPhase, 64)
+	minimum := New(1, Factor4, MinimumPhase, 64)
+	if minimum.Latency() >= linear.Latency() {
+		t.Errorf("Minimum phase latency %d should be below linear phase %d",
+			minimum.Latency(), linear.Latency())
+	}
+}
+
+func TestProcessChunksLongBlocks(t *testing.T) {
+	input := sine(1000, 0.03)
+
+	chunked := New(1, Factor4, LinearPhase, 128)
+	gotChunked := make([]float64, len(input))
+	chunked.Process(0, input, gotChunked, func(block []float64) {
+		for i := range block {
+			block[i] = math.Tanh(2 * block[i])
+		}
+	})
+
+	whole := New(1, Factor4, LinearPhase, len(input))
+	want := make([]float64, len(input))
+	whole.Process(0, input, want, func(block []float64) {
+		for i := range block {
+			block[i] = math.Tanh(2 * block[i])
+		}
+	})
+
+	for i := range want {
+		if math.Abs(gotChunked[i]-want[i]) > 1e-12 {
+			t.Fatalf("Sample %d: chunked %f, whole %f", i, gotChunked[i], want[i])
+		}
+	}
+}
+
+func TestChannelsAndReset(t *testing.T) {
+	o := New(2, Factor2, MinimumPhase, 256)
+	input := sine(256, 0.1)
+	left := make([]float64, 256)
+	right := make([]float64, 256)
+
+	o.Process(0, input, left, func([]float64) {})
+	o.Process(1, make([]float64, 256), right, func([]float64) {})
+	for i, v := range right {
+		if v != 0 {
+			t.Fatalf("Channel 1 picked up channel 0 state at sample %d: %f", i, v)
+		}
+	}
+
+	o.Reset()
+	again := make([]float64, 256)
+	o.Process(0, input, again, func([]float64) {})
+	for i := range left {
+		if left[i] != again[i] {
+			t.Fatalf("Reset did not clear state, sample %d differs", i)
+		}
+	}
+}
+
+func TestEmptyBlocks(t *testing.T) {
+	for _, factor := range []int{Factor2, Factor4, Factor8} {
+		for _, mode := range []Mode{LinearPhase, MinimumPhase} {
+			o := New(1, factor, mode, 64)
+			if block := o.Upsample(0, nil); len(block) != 0 {
+				t.Errorf("%dx: expected an empty oversampled block, got %d samples", factor, len(block))
+			}
+			o.Downsample(0, nil)
+			o.Process(0, nil, nil, func([]float64) {})
+		}
+	}
+}
+
+func TestOversamplerZeroAllocations(t *testing.T) {
+	o := New(2, Factor8, LinearPhase, 256)
+	input := sine(256, 0.1)
+	output := make([]float64, 256)
+	process := func(block []float64) {
+		for i := range block {
+			block[i] *= 0.5
+		}
+	}
+
+	allocs := testing.AllocsPerRun(50, func() {
+		o.Process(0, input, output, process)
+		o.Process(1, input, output, process)
+	})
+	if allocs != 0 {
+		t.Errorf("Process allocated %.1f times", allocs)
+	}
+}
+
+func BenchmarkOversampler(b *testing.B) {
+	input := sine(512, 0.1)
+	output := make([]float64, 512)
+	process := func(block []float64) {
+		for i := range block {
+			block[i] = math.Tanh(block[i])
+		}
+	}
+
+	for _, mode := range []struct {
+		name string
+		mode Mode
+	}{{"LinearPhase", LinearPhase}, {"MinimumPhase", MinimumPhase}} {
+		for _, factor := range []int{Factor2, Factor4, Factor8} {
+			o := New(1, factor, mode.mode, 512)
+			b.Run(mode.name+"_x"+string(rune('0'+factor)), func(b *testing.B) {
+				b.ReportAllocs()
+				for i := 0; i < b.N; i++ {
+					o.Process(0, input, output, process)
+				}
+			})
+		}
+	}
+}
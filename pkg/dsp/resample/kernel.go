@@ -0,0 +1,174 @@
+package resample
+
+import (
+	"math"
+	"sync"
+
+	"github.com/justyntemme/vst3go/pkg/dsp/sample"
+)
+
+// Quality selects the kernel length and table density, trading CPU for
+// stopband rejection and passband width
+type Quality int
+
+const (
+	// QualityLow uses 8 taps: cheap enough for many varispeed voices
+	QualityLow Quality = iota
+	// QualityMedium uses 16 taps
+	QualityMedium
+	// QualityHigh uses 32 taps, transparent for real-time conversion
+	QualityHigh
+	// QualityBest uses 64 taps, for offline work such as impulse responses
+	QualityBest
+)
+
+// design is the kernel shape of a quality level
+type design struct {
+	zeroCrossings int     // Half-width of the kernel in zero crossings
+	phases        int     // Table rows per input sample
+	rolloff       float64 // Cutoff as a fraction of the lower Nyquist frequency
+}
+
+func (q Quality) design() design {
+	switch q {
+	case QualityLow:
+		return design{zeroCrossings: 4, phases: 64, rolloff: 0.80}
+	case QualityMedium:
+		return design{zeroCrossings: 8, phases: 128, rolloff: 0.90}
+	case QualityBest:
+		return design{zeroCrossings: 32, phases: 512, rolloff: 0.97}
+	default:
+		return design{zeroCrossings: 16, phases: 256, rolloff: 0.95}
+	}
+}
+
+// kernel is a polyphase table of a Blackman-windowed sinc. Row p holds the
+// taps for an output p/phases of an input sample past the center tap;
+// there is one extra row so a fraction can blend rows p and p+1.
+type kernel struct {
+	taps     int
+	phases   int
+	coeffs   []float64 // (phases+1) rows of taps coefficients
+	coeffs32 []float32 // The same rows for 32-bit resamplers
+}
+
+// kernelKey identifies a table. The cutoff only depends on the ratio when
+// downsampling, so all upsampling ratios of a quality share one table.
+type kernelKey struct {
+	quality Quality
+	cutoff  float64
+}
+
+// cutoffStepsPerOctave is the grid downsampling ratios are rounded down to
+// before picking a table, so nearby ratios share one. Rounding down lowers
+// the cutoff by at most 1.5%, which never lets an alias through.
+const cutoffStepsPerOctave = 48
+
+// maxCachedKernels bounds the tables kept for reuse. A table near MinRatio
+// holds thousands of taps per row, so an unbounded cache would grow with
+// every distinct ratio. Evicted tables stay alive while a Resampler uses
+// them and are rebuilt on the next request.
+const maxCachedKernels = 16
+
+var (
+	kernelsMu   sync.Mutex
+	kernels     = map[kernelKey]*kernel{}
+	kernelOrder []kernelKey // Least recently used first
+)
+
+// kernelFor returns the shared table for quality at ratio, building it on
+// first use. Tables are never modified once built.
+func kernelFor(quality Quality, ratio float64) *kernel {
+	d := quality.design()
+	key := kernelKey{quality: quality, cutoff: d.rolloff * quantizeRatio(ratio)}
+
+	kernelsMu.Lock()
+	defer kernelsMu.Unlock()
+	k, ok := kernels[key]
+	if !ok {
+		if len(kernelOrder) == maxCachedKernels {
+			delete(kernels, kernelOrder[0])
+			kernelOrder = kernelOrder[1:]
+		}
+		k = newKernel(d, key.cutoff)
+		kernels[key] = k
+	} else {
+		for i, used := range kernelOrder {
+			if used == key {
+				kernelOrder = append(kernelOrder[:i], kernelOrder[i+1:]...)
+				break
+			}
+		}
+	}
+	kernelOrder = append(kernelOrder, key)
+	return k
+}
+
+// quantizeRatio rounds a downsampling ratio down to the cutoff grid;
+// upsampling ratios map to 1
+func quantizeRatio(ratio float64) float64 {
+	if ratio >= 1 {
+		return 1
+	}
+	steps := math.Floor(math.Log2(ratio)*cutoffStepsPerOctave + 1e-9)
+	return math.Exp2(steps / cutoffStepsPerOctave)
+}
+
+// newKernel tabulates a windowed sinc low-passed at cutoff times the input
+// Nyquist frequency. A lower cutoff widens the kernel so it keeps the same
+// number of zero crossings.
+func newKernel(d design, cutoff float64) *kernel {
+	half := int(math.Ceil(float64(d.zeroCrossings) / cutoff))
+	k := &kernel{
+		taps:   2 * half,
+		phases: d.phases,
+		coeffs: make([]float64, (d.phases+1)*2*half),
+	}
+
+	for p := 0; p <= d.phases; p++ {
+		frac := float64(p) / float64(d.phases)
+		row := k.coeffs[p*k.taps : (p+1)*k.taps]
+		sum := 0.0
+		for i := range row {
+			// Tap i sits this many input samples from the output position
+			x := float64(i-(half-1)) - frac
+			sinc := 1.0
+			if x != 0 {
+				sinc = math.Sin(math.Pi*x*cutoff) / (math.Pi * x * cutoff)
+			}
+			w := 0.0
+			if r := x / float64(half); r > -1 && r < 1 {
+				w = 0.42 + 0.5*math.Cos(math.Pi*r) + 0.08*math.Cos(2*math.Pi*r)
+			}
+			row[i] = sinc * w
+			sum += row[i]
+		}
+		// Unity DC gain for every phase, so fractional positions don't ripple
+		for i := range row {
+			row[i] /= sum
+		}
+	}
+
+	k.coeffs32 = make([]float32, len(k.coeffs))
+	for i, c := range k.coeffs {
+		k.coeffs32[i] = float32(c)
+	}
+	return k
+}
+
+// tableOf returns the kernel rows in the sample format T, so coefficients
+// are blended without converting each one
+func tableOf[T sample.Float](k *kernel) []T {
+	if table, ok := any(k.coeffs32).([]T); ok {
+		return table
+	}
+	if table, ok := any(k.coeffs).([]T); ok {
+		return table
+	}
+	// Named float types get a private copy
+	table := make([]T, len(k.coeffs))
+	for i, c := range k.coeffs {
+		table[i] = T(c)
+	}
+	return table
+}
@@ -0,0 +1,252 @@
+// Package resample converts audio between sample rates with polyphase
+// windowed-sinc kernels. The kernel tables are computed once per quality
+// and cutoff and shared by every Resampler in the process, so an output
+// sample costs one blend of two table rows plus a dot product per channel -
+// no trigonometry on the audio thread. Downsampling cutoffs are rounded to
+// a 1/48-octave grid and only the most recently used tables are cached, so
+// many distinct ratios don't grow memory without bound.
+//
+// A Resampler is streaming: it keeps its history between calls, so blocks
+// can be any length and the ratio can change between them for varispeed.
+// All buffers are allocated when it is created; Process does not allocate.
+package resample
+
+import (
+	"math"
+
+	"github.com/justyntemme/vst3go/pkg/dsp/sample"
+)
+
+// historyChunk is how many input frames a Resampler buffers beyond its
+// kernel length
+const historyChunk = 512
+
+// Ratio limits; the slowest ratio still advances less than historyChunk
+// input frames per output frame
+const (
+	MinRatio = 1.0 / 256
+	MaxRatio = 256.0
+)
+
+// Resampler is the 32-bit resampler used by most processors
+type Resampler = ResamplerOf[float32]
+
+// Resampler64 is the double-precision resampler
+type Resampler64 = ResamplerOf[float64]
+
+// ResamplerOf converts a fixed number of channels by ratio output frames per
+// input frame. The channels share the kernel phase, so the coefficients of
+// each output frame are blended once and applied to all of them.
+type ResamplerOf[T sample.Float] struct {
+	kernel   *kernel
+	table    []T // Kernel rows in the sample format
+	quality  Quality
+	channels int
+	ratio    float64
+	step     float64 // Input frames per output frame
+
+	history [][]T // Per channel, kernel taps + historyChunk frames
+	filled  int   // Frames of history in use
+	pos     int   // First tap of the next output frame
+	frac    float64
+	coef    []T // Blended coefficients of the current frame
+}
+
+// New creates a resampler producing ratio output frames per input frame,
+// e.g. 48000.0/44100 to convert 44.1 kHz audio to 48 kHz
+func New(channels int, ratio float64, quality Quality) *Resampler {
+	return NewOf[float32](channels, ratio, quality)
+}
+
+// New64 creates a double-precision resampler
+func New64(channels int, ratio float64, quality Quality) *Resampler64 {
+	return NewOf[float64](channels, ratio, quality)
+}
+
+// NewOf creates a resampler for either sample format. The anti-aliasing
+// cutoff is fixed by ratio: for varispeed, create the resampler with the
+// lowest ratio it will run at.
+func NewOf[T sample.Float](channels int, ratio float64, quality Quality) *ResamplerOf[T] {
+	if channels < 1 {
+		channels = 1
+	}
+	ratio = clampRatio(ratio)
+	k := kernelFor(quality, ratio)
+	r := &ResamplerOf[T]{
+		kernel:   k,
+		table:    tableOf[T](k),
+		quality:  quality,
+		channels: channels,
+		history:  make([][]T, channels),
+		coef:     make([]T, k.taps),
+	}
+	for ch := range r.history {
+		r.history[ch] = make([]T, k.taps+historyChunk)
+	}
+	r.SetRatio(ratio)
+	r.Reset()
+	return r
+}
+
+func clampRatio(ratio float64) float64 {
+	if ratio <= 0 || math.IsNaN(ratio) {
+		return 1
+	}
+	return math.Max(MinRatio, math.Min(MaxRatio, ratio))
+}
+
+// Channels returns the number of channels
+func (r *ResamplerOf[T]) Channels() int {
+	return r.channels
+}
+
+// Quality returns the kernel quality
+func (r *ResamplerOf[T]) Quality() Quality {
+	return r.quality
+}
+
+// Ratio returns the output frames produced per input frame
+func (r *ResamplerOf[T]) Ratio() float64 {
+	return r.ratio
+}
+
+// SetRatio changes the conversion ratio from the next output frame - safe
+// to call between blocks. The kernel is kept, so ratios below the one the
+// resampler was created with alias.
+func (r *ResamplerOf[T]) SetRatio(ratio float64) {
+	r.ratio = clampRatio(ratio)
+	r.step = 1 / r.ratio
+}
+
+// Latency returns how far the output lags the input, in input frames: an
+// output frame needs this many frames past its position before it is
+// produced. Feed that many zeros to flush the end of a stream.
+func (r *ResamplerOf[T]) Latency() int {
+	return r.kernel.taps / 2
+}
+
+// MaxOutput returns the most frames Process can produce from inputFrames
+// new input frames at the current ratio
+func (r *ResamplerOf[T]) MaxOutput(inputFrames int) int {
+	return int(math.Ceil(float64(inputFrames)*r.ratio)) + 1
+}
+
+// Reset clears the history. The first output frame lines up with the first
+// input frame after it.
+func (r *ResamplerOf[T]) Reset() {
+	for _, h := range r.history {
+		clear(h)
+	}
+	// Zeros before the first input frame, which sits under the center tap
+	r.filled = r.kernel.taps/2 - 1
+	r.pos = 0
+	r.frac = 0
+}
+
+// Process converts input into output until either runs out - no
+// allocations. It returns the input frames consumed and output frames
+// produced; unconsumed input must be passed again. All channels of a call
+// must have the same length.
+func (r *ResamplerOf[T]) Process(input, output [][]T) (consumed, produced int) {
+	channels := r.channels
+	if len(input) < channels {
+		channels = len(input)
+	}
+	if len(output) < channels {
+		channels = len(output)
+	}
+	if channels == 0 {
+		return 0, 0
+	}
+	inLen, outLen := len(input[0]), len(output[0])
+	taps := r.kernel.taps
+
+	for {
+		for produced < outLen && r.pos+taps <= r.filled {
+			r.blend()
+			for ch := 0; ch < channels; ch++ {
+				output[ch][produced] = dot(r.history[ch][r.pos:r.pos+taps], r.coef)
+			}
+			produced++
+
+			r.frac += r.step
+			advance := int(r.frac)
+			r.frac -= float64(advance)
+			r.pos += advance
+		}
+		if produced == outLen || consumed == inLen {
+			return consumed, produced
+		}
+
+		// Drop the frames no output needs any more and refill
+		start := r.pos
+		if start > r.filled {
+			start = r.filled
+		}
+		take := len(r.history[0]) - (r.filled - start)
+		if take > inLen-consumed {
+			take = inLen - consumed
+		}
+		for ch := 0; ch < r.channels; ch++ {
+			h := r.history[ch]
+			copy(h, h[start:r.filled])
+			if ch < channels {
+				copy(h[r.filled-start:], input[ch][consumed:consumed+take])
+			} else {
+				clear(h[r.filled-start : r.filled-start+take])
+			}
+		}
+		r.filled += take - start
+		r.pos -= start
+		consumed += take
+	}
+}
+
+// blend interpolates the coefficients of the current fractional position
+// between the two nearest table rows
+func (r *ResamplerOf[T]) blend() {
+	k := r.kernel
+	f := r.frac * float64(k.phases)
+	p := int(f)
+	t := T(f - float64(p))
+	row0 := r.table[p*k.taps : (p+1)*k.taps]
+	row1 := r.table[(p+1)*k.taps : (p+2)*k.taps]
+	row1 = row1[:len(row0)]
+	coef := r.coef[:len(row0)]
+	for i, c := range row0 {
+		coef[i] = c + (row1[i]-c)*t
+	}
+}
+
+// dot is the kernel sum of one channel. Kernels have an even number of taps;
+// two accumulators keep the additions from forming one long chain.
+func dot[T sample.Float](history, coef []T) T {
+	history = history[:len(coef)]
+	var a, b T
+	for i := 0; i+1 < len(coef); i += 2 {
+		a += history[i] * coef[i]
+		b += history[i+1] * coef[i+1]
+	}
+	return a + b
+}
+
+// Convert resamples a whole signal by ratio, for offline work such as
+// preparing impulse responses. The result has ceil(len(input)*ratio)
+// samples and is time-aligned with the input. It allocates.
+func Convert[T sample.Float](input []T, ratio float64, quality Quality) []T {
+	r := NewOf[T](1, ratio, quality)
+	out := make([]T, int(math.Ceil(float64(len(input))*r.ratio-1e-9)))
+	in := [][]T{input}
+	zeros := make([]T, r.Latency()+1)
+
+	for produced := 0; produced < len(out); {
+		// Past the end of the input the kernel reads silence
+		if len(in[0]) == 0 {
+			in[0] = zeros
+		}
+		c, p := r.Process(in, [][]T{out[produced:]})
+		in[0] = in[0][c:]
+		produced += p
+	}
+	return out
+}
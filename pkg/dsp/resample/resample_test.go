@@ -0,0 +1,190 @@
+package resample
+
+import (
+	"math"
+	"testing"
+)
+
+func sine(n int, frequency, sampleRate float64) []float64 {
+	signal := make([]float64, n)
+	for i := range signal {
+		signal[i] = math.Sin(2 * math.Pi * frequency * float64(i) / sampleRate)
+	}
+	return signal
+}
+
+func TestConvertMatchesAnalyticSine(t *testing.T) {
+	const from, to = 44100.0, 48000.0
+	input := sine(8820, 1000, from)
+
+	for _, tc := range []struct {
+		quality   Quality
+		tolerance float64
+	}{{QualityLow, 5e-4}, {QualityMedium, 2e-4}, {QualityHigh, 1e-4}, {QualityBest, 1e-5}} {
+		out := Convert(input, to/from, tc.quality)
+		if len(out) != 9600 {
+			t.Fatalf("Quality %d: expected 9600 samples, got %d", tc.quality, len(out))
+		}
+		// Skip the edges, where the kernel reaches past the signal
+		worst := 0.0
+		for i := 200; i < len(out)-200; i++ {
+			want := math.Sin(2 * math.Pi * 1000 * float64(i) / to)
+			worst = math.Max(worst, math.Abs(out[i]-want))
+		}
+		if worst > tc.tolerance {
+			t.Errorf("Quality %d: error %g exceeds %g", tc.quality, worst, tc.tolerance)
+		}
+	}
+}
+
+func TestDownsamplingRejectsAliases(t *testing.T) {
+	// 30 kHz at 96 kHz has no place below the 24 kHz Nyquist of 48 kHz
+	out := Convert(sine(9600, 30000, 96000), 0.5, QualityHigh)
+	peak := 0.0
+	for _, v := range out[200 : len(out)-200] {
+		peak = math.Max(peak, math.Abs(v))
+	}
+	if peak > 1e-3 {
+		t.Errorf("Alias leaked through at %g", peak)
+	}
+}
+
+func TestStreamingMatchesOneShot(t *testing.T) {
+	input := sine(5000, 440, 48000)
+	whole := New64(1, 0.37, QualityMedium)
+	want := make([]float64, whole.MaxOutput(len(input)))
+	_, n := whole.Process([][]float64{input}, [][]float64{want})
+	want = want[:n]
+
+	// Odd input blocks and an output too small for some of them
+	pieces := New64(1, 0.37, QualityMedium)
+	var got []float64
+	out := make([]float64, 7)
+	for start := 0; start < len(input); {
+		end := start + 13
+		if end > len(input) {
+			end = len(input)
+		}
+		c, p := pieces.Process([][]float64{input[start:end]}, [][]float64{out})
+		got = append(got, out[:p]...)
+		start += c
+	}
+	if len(got) != len(want) {
+		t.Fatalf("Streaming produced %d frames, one block %d", len(got), len(want))
+	}
+	for i := range want {
+		if got[i] != want[i] {
+			t.Fatalf("Frame %d: streaming %f, one block %f", i, got[i], want[i])
+		}
+	}
+}
+
+func TestChannelsMatchMono(t *testing.T) {
+	left, right := sine(2000, 300, 44100), sine(2000, 5000, 44100)
+	stereo := New64(2, 1.7, QualityHigh)
+	out := [][]float64{make([]float64, 4000), make([]float64, 4000)}
+	_, n := stereo.Process([][]float64{left, right}, out)
+
+	for ch, input := range [][]float64{left, right} {
+		mono := New64(1, 1.7, QualityHigh)
+		want := make([]float64, 4000)
+		_, m := mono.Process([][]float64{input}, [][]float64{want})
+		if m != n {
+			t.Fatalf("Channel %d: mono produced %d frames, stereo %d", ch, m, n)
+		}
+		for i := 0; i < n; i++ {
+			if out[ch][i] != want[i] {
+				t.Fatalf("Channel %d, frame %d: stereo %f, mono %f", ch, i, out[ch][i], want[i])
+			}
+		}
+	}
+}
+
+func TestKernelsAreShared(t *testing.T) {
+	a := New(2, 48000.0/44100, QualityHigh)
+	b := New64(1, 2, QualityHigh)
+	if a.kernel != b.kernel {
+		t.Error("Upsamplers of one quality should share a kernel table")
+	}
+	if c := New(1, 0.5, QualityHigh); c.kernel == a.kernel {
+		t.Error("Downsampling needs its own lower cutoff")
+	}
+	if c := New(1, 0.5, QualityHigh); c.Latency() != 2*a.Latency() {
+		t.Errorf("Halving the cutoff should double the kernel: %d vs %d", c.Latency(), a.Latency())
+	}
+}
+
+func TestKernelCacheIsBounded(t *testing.T) {
+	// Nearby downsampling ratios share a table
+	if a, b := New(1, 0.7001, QualityLow), New(1, 0.7002, QualityLow); a.kernel != b.kernel {
+		t.Error("Nearby ratios should round to one table")
+	}
+
+	for i := 0; i < 4*maxCachedKernels; i++ {
+		New(1, 0.9/float64(i+2), QualityLow)
+	}
+	kernelsMu.Lock()
+	cached, ordered := len(kernels), len(kernelOrder)
+	kernelsMu.Unlock()
+	if cached > maxCachedKernels || cached != ordered {
+		t.Errorf("Cache holds %d tables (%d ordered), limit %d", cached, ordered, maxCachedKernels)
+	}
+}
+
+func TestVarispeedKeepsDC(t *testing.T) {
+	r := New(1, 0.5, QualityMedium)
+	input := make([]float32, 64)
+	for i := range input {
+		input[i] = 1
+	}
+	out := make([]float32, r.MaxOutput(64*4))
+	for block := 0; block < 40; block++ {
+		// Sweep between half and double speed
+		r.SetRatio(0.5 + 1.5*float64(block%10)/9)
+		_, n := r.Process([][]float32{input}, [][]float32{out[:r.MaxOutput(64)]})
+		if block < 4 {
+			continue
+		}
+		for i, v := range out[:n] {
+			if math.Abs(float64(v)-1) > 1e-3 {
+				t.Fatalf("Block %d, frame %d: DC read %f", block, i, v)
+			}
+		}
+	}
+}
+
+func TestResamplerZeroAllocations(t *testing.T) {
+	r := New(2, 48000.0/44100, QualityHigh)
+	input := [][]float32{make([]float32, 512), make([]float32, 512)}
+	output := [][]float32{make([]float32, 600), make([]float32, 600)}
+
+	allocs := testing.AllocsPerRun(100, func() {
+		r.Process(input, output)
+	})
+	if allocs != 0 {
+		t.Errorf("Resampler allocated %.1f times per block", allocs)
+	}
+}
+
+func BenchmarkResampler(b *testing.B) {
+	for _, q := range []struct {
+		name    string
+		quality Quality
+	}{{"Low", QualityLow}, {"Medium", QualityMedium}, {"High", QualityHigh}, {"Best", QualityBest}} {
+		b.Run(q.name, func(b *testing.B) {
+			r := New(2, 48000.0/44100, q.quality)
+			input := [][]float32{make([]float32, 512), make([]float32, 512)}
+			for ch := range input {
+				for i := range input[ch] {
+					input[ch][i] = float32(math.Sin(float64(i) * 0.01))
+				}
+			}
+			output := [][]float32{make([]float32, 600), make([]float32, 600)}
+
+			b.ResetTimer()
+			for i := 0; i < b.N; i++ {
+				r.Process(input, output)
+			}
+		})
+	}
+}
@@ -2,30 +2,48 @@ package reverb
 
 import (
 	"math"
+	"math/bits"
 	"math/rand"
 )
 
 // FDN implements a Feedback Delay Network reverb
 // This is a more sophisticated reverb algorithm that uses multiple delay lines
 // with a feedback matrix for rich, dense reverberation
+//
+// All delay lines live in one contiguous buffer, each a power-of-two,
+// mask-indexed region. Audio is rendered in chunks no longer than the
+// shortest delay, so every line is read for the whole chunk before any write.
+// The feedback matrix is then applied across lines on chunk-length vectors: a
+// fast Hadamard butterfly when the line count is a power of two, a dense
+// multiply otherwise. Modulation is a quadrature recurrence oscillator
+// sampled at chunk rate, so the per-sample path has no trig and no allocation.
 type FDN struct {
 	// Number of delay lines (typically 4, 8, or 16)
 	numDelays int
 
-	// Delay lines
-	delayLines   [][]float32
-	delayTimes   []int
-	writeIndices []int
-
-	// Feedback matrix (Hadamard matrix for good diffusion)
+	// Delay lines: per-line views into one contiguous buffer
+	delayLines [][]float32
+	delayTimes []int
+	buffer     []float32
+	offsets    []int // Start of each line in buffer
+	masks      []int // Line length - 1 (lengths are powers of two)
+	writePos   int   // Shared write counter, masked per line
+
+	// Feedback matrix: base orthogonal matrix, and the effective matrix
+	// after decay and diffusion scaling
+	baseMatrix     [][]float64
 	feedbackMatrix [][]float64
+	hadamard       bool    // Base matrix is Sylvester-Hadamard; use the butterfly
+	identityGain   float32 // Feedback gain of each line onto itself
+	matrixGain     float32 // Feedback gain of the base matrix
 
 	// Input and output gains
 	inputGains  []float64
 	outputGains []float64
 
-	// Damping filters (one per delay line)
-	dampingFilters []*DampingFilter
+	// Damping (one-pole lowpass per delay line)
+	dampState []float32
+	dampCoeff float32
 
 	// Global parameters
 	decay      float64
@@ -35,15 +53,30 @@ type FDN struct {
 	wetLevel   float64
 	dryLevel   float64
 
-	// Modulation LFOs
-	modLFOs   []float64
-	modPhases []float64
+	// Modulation LFOs: quadrature oscillator per line (sin, cos), rotated
+	// once per chunk
+	modSin    []float64
+	modCos    []float64
 	modDepth  float64
 	modRate   float64
+	rotLength int // Chunk length the cached rotation is for
+	rotSin    float64
+	rotCos    float64
+
+	// Chunk scratch, lines x maxChunk, preallocated
+	maxChunk int
+	reads    []float32
+	mixed    []float32
+	wet      []float32
+	tapL     []float32
+	tapR     []float32
 
 	sampleRate float64
 }
 
+// fdnMaxChunk bounds the chunk length (and so the scratch size)
+const fdnMaxChunk = 64
+
 // DampingFilter implements a simple one-pole lowpass filter for damping
 type DampingFilter struct {
 	state float32
@@ -80,24 +113,25 @@ func (d *DampingFilter) Reset() {
 // NewFDN creates a new Feedback Delay Network reverb
 func NewFDN(numDelays int, sampleRate float64) *FDN {
 	f := &FDN{
-		numDelays:      numDelays,
-		delayLines:     make([][]float32, numDelays),
-		delayTimes:     make([]int, numDelays),
-		writeIndices:   make([]int, numDelays),
-		inputGains:     make([]float64, numDelays),
-		outputGains:    make([]float64, numDelays),
-		dampingFilters: make([]*DampingFilter, numDelays),
-		modLFOs:        make([]float64, numDelays),
-		modPhases:      make([]float64, numDelays),
-		decay:          0.5,
-		damping:        0.5,
-		diffusion:      0.5,
-		modulation:     0.0,
-		wetLevel:       0.3,
-		dryLevel:       0.7,
-		modDepth:       5.0, // samples
-		modRate:        0.5, // Hz
-		sampleRate:     sampleRate,
+		numDelays:   numDelays,
+		delayLines:  make([][]float32, numDelays),
+		delayTimes:  make([]int, numDelays),
+		offsets:     make([]int, numDelays),
+		masks:       make([]int, numDelays),
+		inputGains:  make([]float64, numDelays),
+		outputGains: make([]float64, numDelays),
+		dampState:   make([]float32, numDelays),
+		modSin:      make([]float64, numDelays),
+		modCos:      make([]float64, numDelays),
+		decay:       0.5,
+		damping:     0.5,
+		diffusion:   0.5,
+		modulation:  0.0,
+		wetLevel:    0.3,
+		dryLevel:    0.7,
+		modDepth:    5.0, // samples
+		modRate:     0.5, // Hz
+		sampleRate:  sampleRate,
 	}
 
 	// Initialize delay times using prime numbers for good diffusion
@@ -108,69 +142,92 @@ func NewFDN(numDelays int, sampleRate float64) *FDN {
 	for i := 0; i < numDelays; i++ {
 		// Use prime number ratios for delay times
 		delayTime := baseDelay * primes[i%len(primes)] / 23
+		if delayTime < 1 {
+			delayTime = 1
+		}
 		f.delayTimes[i] = delayTime
-		f.delayLines[i] = make([]float32, delayTime+int(f.modDepth)+1)
-
-		// Initialize damping filters
-		f.dampingFilters[i] = NewDampingFilter()
-
-		// Initialize modulation phases
-		f.modPhases[i] = float64(i) * 2.0 * math.Pi / float64(numDelays)
 
 		// Equal input/output gains
 		f.inputGains[i] = 1.0 / math.Sqrt(float64(numDelays))
 		f.outputGains[i] = 1.0 / math.Sqrt(float64(numDelays))
 	}
 
+	// Chunks never read samples written within the same chunk
+	minDelay := f.delayTimes[0]
+	for _, d := range f.delayTimes {
+		if d < minDelay {
+			minDelay = d
+		}
+	}
+	f.maxChunk = minDelay - int(math.Ceil(f.modDepth)) - 2
+	if f.maxChunk > fdnMaxChunk {
+		f.maxChunk = fdnMaxChunk
+	}
+	if f.maxChunk < 1 {
+		f.maxChunk = 1
+	}
+
+	// Lay the lines out back to back, each rounded up to a power of two
+	total := 0
+	for i, d := range f.delayTimes {
+		size := 1
+		for size < d+int(math.Ceil(f.modDepth))+f.maxChunk+2 {
+			size <<= 1
+		}
+		f.offsets[i] = total
+		f.masks[i] = size - 1
+		total += size
+	}
+	f.buffer = make([]float32, total)
+	for i := range f.delayLines {
+		f.delayLines[i] = f.buffer[f.offsets[i] : f.offsets[i]+f.masks[i]+1]
+	}
+
+	f.reads = make([]float32, numDelays*f.maxChunk)
+	f.mixed = make([]float32, numDelays*f.maxChunk)
+	f.wet = make([]float32, f.maxChunk)
+	f.tapL = make([]float32, f.maxChunk)
+	f.tapR = make([]float32, f.maxChunk)
+
 	// Create feedback matrix (Hadamard matrix for optimal diffusion)
 	f.createHadamardMatrix()
 
+	f.resetModulation()
+
 	// Apply initial parameter settings
 	f.updateInternalParameters()
 
 	return f
 }
 
-// createHadamardMatrix creates a Hadamard matrix for the feedback network
+// createHadamardMatrix creates the base feedback matrix: a Sylvester
+// Hadamard matrix when the line count is a power of two, otherwise a
+// Householder reflection
 func (f *FDN) createHadamardMatrix() {
 	n := f.numDelays
+	f.baseMatrix = make([][]float64, n)
 	f.feedbackMatrix = make([][]float64, n)
-	for i := range f.feedbackMatrix {
+	for i := range f.baseMatrix {
+		f.baseMatrix[i] = make([]float64, n)
 		f.feedbackMatrix[i] = make([]float64, n)
 	}
 
-	// For simplicity, use a normalized Hadamard-like matrix
-	// This provides good diffusion properties
-	if n == 4 {
-		// 4x4 Hadamard matrix
-		h := [][]float64{
-			{1, 1, 1, 1},
-			{1, -1, 1, -1},
-			{1, 1, -1, -1},
-			{1, -1, -1, 1},
-		}
-		scale := 0.5 // 1/sqrt(4)
-		for i := 0; i < 4; i++ {
-			for j := 0; j < 4; j++ {
-				f.feedbackMatrix[i][j] = h[i][j] * scale
-			}
-		}
-	} else if n == 8 {
-		// 8x8 Hadamard matrix (simplified)
-		scale := 1.0 / math.Sqrt(8.0)
-		for i := 0; i < 8; i++ {
-			for j := 0; j < 8; j++ {
-				// Create a pattern that provides good diffusion
-				if (i+j)%2 == 0 {
-					f.feedbackMatrix[i][j] = scale
-				} else {
-					f.feedbackMatrix[i][j] = -scale
-				}
+	f.hadamard = n >= 2 && n&(n-1) == 0
+	if !f.hadamard {
+		f.createHouseholderMatrix()
+		return
+	}
+
+	// H[i][j] = (-1)^popcount(i&j) / sqrt(n), the matrix the butterfly applies
+	scale := 1.0 / math.Sqrt(float64(n))
+	for i := 0; i < n; i++ {
+		for j := 0; j < n; j++ {
+			if bits.OnesCount(uint(i&j))%2 == 0 {
+				f.baseMatrix[i][j] = scale
+			} else {
+				f.baseMatrix[i][j] = -scale
 			}
 		}
-	} else {
-		// For other sizes, use a householder reflection matrix
-		f.createHouseholderMatrix()
 	}
 }
 
@@ -196,9 +253,9 @@ func (f *FDN) createHouseholderMatrix() {
 	for i := 0; i < n; i++ {
 		for j := 0; j < n; j++ {
 			if i == j {
-				f.feedbackMatrix[i][j] = 1.0 - 2.0*v[i]*v[j]
+				f.baseMatrix[i][j] = 1.0 - 2.0*v[i]*v[j]
 			} else {
-				f.feedbackMatrix[i][j] = -2.0 * v[i] * v[j]
+				f.baseMatrix[i][j] = -2.0 * v[i] * v[j]
 			}
 		}
 	}
@@ -239,10 +296,8 @@ func (f *FDN) SetDryLevel(level float64) {
 
 // updateInternalParameters updates internal parameters after changes
 func (f *FDN) updateInternalParameters() {
-	// Update damping filters
-	for i := 0; i < f.numDelays; i++ {
-		f.dampingFilters[i].SetDamping(f.damping)
-	}
+	// One-pole damping: higher damping = lower cutoff frequency
+	f.dampCoeff = float32(1.0 - f.damping)
 
 	// Scale feedback matrix by decay amount
 	// Higher decay = more feedback = longer reverb tail
@@ -251,164 +306,262 @@ func (f *FDN) updateInternalParameters() {
 	// Apply diffusion by mixing with identity matrix
 	// Low diffusion = more parallel delays, high diffusion = more mixing
 	diffusionMix := f.diffusion
-	
-	// Create base Hadamard matrix
-	f.createHadamardMatrix()
-	
-	// Apply decay and diffusion scaling to feedback matrix
+
+	// The loop applies decay and diffusion twice, as the original
+	// per-sample engine did and the presets are tuned for:
+	//   ds*(1-d)*x + ds*d*M*x  with  M = ds*((1-d)*I + d*B)
+	// which is identityGain*x + matrixGain*B*x
+	identityGain := decayScale * (1 - diffusionMix) * (1 + diffusionMix*decayScale)
+	matrixGain := diffusionMix * diffusionMix * decayScale * decayScale
+	f.identityGain = float32(identityGain)
+	f.matrixGain = float32(matrixGain)
+
+	// Effective matrix, used directly by the dense path
 	for i := 0; i < f.numDelays; i++ {
 		for j := 0; j < f.numDelays; j++ {
-			// Store original Hadamard value
-			hadamardValue := f.feedbackMatrix[i][j]
-			
+			value := matrixGain * f.baseMatrix[i][j]
 			if i == j {
-				// Mix between identity (no diffusion) and Hadamard (full diffusion)
-				f.feedbackMatrix[i][j] = decayScale * ((1.0-diffusionMix) + diffusionMix*hadamardValue)
-			} else {
-				// Off-diagonal elements scaled by diffusion
-				f.feedbackMatrix[i][j] = decayScale * diffusionMix * hadamardValue
+				value += identityGain
 			}
+			f.feedbackMatrix[i][j] = value
 		}
 	}
 }
 
 // Process processes a mono input sample
 func (f *FDN) Process(input float32) float32 {
-	// Read outputs from all delay lines
-	delayOutputs := make([]float32, f.numDelays)
+	in := [1]float32{input}
+	f.renderChunk(in[:])
+	return input*float32(f.dryLevel) + f.wet[0]*float32(f.wetLevel)
+}
 
-	for i := 0; i < f.numDelays; i++ {
-		// Calculate modulated read position
-		modulation := 0.0
-		if f.modulation > 0 {
-			// Update LFO
-			f.modLFOs[i] = math.Sin(f.modPhases[i])
-			f.modPhases[i] += 2.0 * math.Pi * f.modRate / f.sampleRate
-			if f.modPhases[i] > 2.0*math.Pi {
-				f.modPhases[i] -= 2.0 * math.Pi
-			}
-			modulation = f.modLFOs[i] * f.modDepth * f.modulation
-		}
+// ProcessStereo processes stereo input
+func (f *FDN) ProcessStereo(inputL, inputR float32) (outputL, outputR float32) {
+	// Mix to mono for processing
+	mono := [1]float32{(inputL + inputR) * 0.5}
+	f.renderChunk(mono[:])
+
+	outputL, outputR = f.stereoMix(inputL, inputR, mono[0], 0)
+	return outputL, outputR
+}
 
-		// Calculate read index with modulation
-		readPos := f.writeIndices[i] - f.delayTimes[i]
-		modulatedPos := float64(readPos) - modulation
+// ProcessBlock processes a mono input block into a stereo output. Each
+// sample matches ProcessStereo with the input on both channels. The outputs
+// may alias the input.
+func (f *FDN) ProcessBlock(in, outL, outR []float32) {
+	for start := 0; start < len(in); start += f.maxChunk {
+		end := start + f.maxChunk
+		if end > len(in) {
+			end = len(in)
+		}
+		chunk := in[start:end]
+		f.renderChunk(chunk)
 
-		// Wrap around
-		for modulatedPos < 0 {
-			modulatedPos += float64(len(f.delayLines[i]))
+		left := outL[start:end]
+		right := outR[start:end]
+		for k, x := range chunk {
+			left[k], right[k] = f.stereoMix(x, x, x, k)
 		}
+	}
+}
 
-		// Linear interpolation for smooth modulation
-		intPos := int(modulatedPos)
-		frac := float32(modulatedPos - float64(intPos))
+// stereoMix builds a stereo sample from the rendered chunk at index k: the
+// mono reverb plus decorrelated taps of the first two delay lines
+func (f *FDN) stereoMix(inputL, inputR, mono float32, k int) (outputL, outputR float32) {
+	dry := float32(f.dryLevel)
+	wet := float32(f.wetLevel)
 
-		idx1 := intPos % len(f.delayLines[i])
-		idx2 := (intPos + 1) % len(f.delayLines[i])
+	processed := mono*dry + f.wet[k]*wet
+	outputL = processed
+	outputR = processed
 
-		// Interpolate
-		delayOutputs[i] = f.delayLines[i][idx1]*(1-frac) + f.delayLines[i][idx2]*frac
+	// Add some stereo width with the samples just written to two lines
+	if f.numDelays >= 2 {
+		spread := float32(0.3)
+		outputL += f.tapL[k] * spread * wet
+		outputR += f.tapR[k] * spread * wet
 	}
 
-	// Apply feedback matrix to create new inputs
-	feedbackInputs := make([]float32, f.numDelays)
-	decayScale := float32(0.4 + f.decay*0.58)
+	// Apply final wet/dry mix
+	outputL = inputL*dry + outputL*wet
+	outputR = inputR*dry + outputR*wet
+	return outputL, outputR
+}
 
-	for i := 0; i < f.numDelays; i++ {
-		sum := float32(0)
-		for j := 0; j < f.numDelays; j++ {
-			// Mix between feedback matrix and identity based on diffusion
-			if i == j {
-				// Identity component (parallel delays)
-				sum += delayOutputs[j] * float32(1.0-f.diffusion) * decayScale
+// renderChunk runs the network for up to maxChunk samples of mono input,
+// leaving the summed outputs in wet and the line 0/1 writes in tapL/tapR
+func (f *FDN) renderChunk(in []float32) {
+	n := len(in)
+	lines := f.numDelays
+	stride := f.maxChunk
+
+	// Read every line for the whole chunk
+	depth := f.modDepth * f.modulation
+	modulated := depth > 0
+	var rotSin, rotCos float64
+	if modulated {
+		rotSin, rotCos = f.rotation(n)
+	}
+	for i := 0; i < lines; i++ {
+		reads := f.reads[i*stride : i*stride+n]
+		line := f.delayLines[i]
+		mask := f.masks[i]
+		readPos := f.writePos - f.delayTimes[i]
+
+		if !modulated {
+			for k := range reads {
+				reads[k] = line[(readPos+k)&mask]
 			}
-			// Feedback matrix component (cross-coupling)
-			sum += delayOutputs[j] * float32(f.feedbackMatrix[i][j]*f.diffusion) * decayScale
+			continue
 		}
-		feedbackInputs[i] = sum
-	}
-
-	// Write to delay lines with damping
-	for i := 0; i < f.numDelays; i++ {
-		// Mix input with feedback
-		delayInput := input*float32(f.inputGains[i]) + feedbackInputs[i]
-
-		// Apply damping
-		delayInput = f.dampingFilters[i].Process(delayInput)
 
-		// Write to delay line
-		f.delayLines[i][f.writeIndices[i]] = delayInput
+		// Block-rate LFO: ramp the offset linearly between the chunk edges
+		s, c := f.modSin[i], f.modCos[i]
+		nextSin := s*rotCos + c*rotSin
+		nextCos := c*rotCos - s*rotSin
+		// Renormalize to keep the recurrence from drifting
+		g := 1.5 - 0.5*(nextSin*nextSin+nextCos*nextCos)
+		f.modSin[i], f.modCos[i] = nextSin*g, nextCos*g
+
+		offset := s * depth
+		step := (nextSin - s) * depth / float64(n)
+		for k := range reads {
+			pos := float64(readPos+k) - offset
+
+			intPos := int(pos)
+			if float64(intPos) > pos {
+				intPos-- // Floor for positions before the first write
+			}
+			frac := float32(pos - float64(intPos))
 
-		// Update write index
-		f.writeIndices[i]++
-		if f.writeIndices[i] >= len(f.delayLines[i]) {
-			f.writeIndices[i] = 0
+			// Linear interpolation for smooth modulation
+			reads[k] = line[intPos&mask]*(1-frac) + line[(intPos+1)&mask]*frac
+			offset += step
 		}
 	}
 
-	// Sum outputs
-	output := float32(0)
-	for i := 0; i < f.numDelays; i++ {
-		output += delayOutputs[i] * float32(f.outputGains[i])
+	// Output taps
+	wet := f.wet[:n]
+	gain := float32(f.outputGains[0])
+	copy(wet, f.reads[:n])
+	for i := 1; i < lines; i++ {
+		reads := f.reads[i*stride : i*stride+n]
+		for k := range wet {
+			wet[k] += reads[k]
+		}
+	}
+	for k := range wet {
+		wet[k] *= gain
 	}
 
-	// Apply wet/dry mix
-	return input*float32(f.dryLevel) + output*float32(f.wetLevel)
-}
-
-// ProcessStereo processes stereo input
-func (f *FDN) ProcessStereo(inputL, inputR float32) (outputL, outputR float32) {
-	// Mix to mono for processing
-	mono := (inputL + inputR) * 0.5
+	// Feedback matrix across lines
+	f.mixFeedback(n)
 
-	// Process through FDN
-	processed := f.Process(mono)
+	// Write to delay lines with damping
+	coeff := f.dampCoeff
+	for i := 0; i < lines; i++ {
+		mixed := f.mixed[i*stride : i*stride+n]
+		line := f.delayLines[i]
+		mask := f.masks[i]
+		inGain := float32(f.inputGains[i])
+		state := f.dampState[i]
+		for k, x := range in {
+			// One-pole lowpass: y[n] = x[n] * (1-coeff) + y[n-1] * coeff
+			state = (x*inGain+mixed[k])*(1-coeff) + state*coeff
+			line[(f.writePos+k)&mask] = state
+		}
+		f.dampState[i] = state
+	}
 
-	// Create stereo output by using different combinations of delay outputs
-	// This is a simplified approach - a full implementation would have
-	// separate processing for left and right channels
+	if lines >= 2 {
+		for k := 0; k < n; k++ {
+			f.tapL[k] = f.delayLines[0][(f.writePos+k)&f.masks[0]]
+			f.tapR[k] = f.delayLines[1][(f.writePos+k)&f.masks[1]]
+		}
+	}
+	f.writePos += n
+}
 
-	// For now, create a basic stereo spread
-	outputL = processed
-	outputR = processed
+// mixFeedback applies the feedback matrix to the chunk reads
+func (f *FDN) mixFeedback(n int) {
+	lines := f.numDelays
+	stride := f.maxChunk
 
-	// Add some stereo width by phase inverting some of the signal
-	if f.numDelays >= 2 {
-		// Get two delay outputs for stereo decorrelation
-		delay1 := f.delayLines[0][f.writeIndices[0]-1]
-		if f.writeIndices[0]-1 < 0 {
-			delay1 = f.delayLines[0][len(f.delayLines[0])-1]
+	if !f.hadamard {
+		for i := 0; i < lines; i++ {
+			mixed := f.mixed[i*stride : i*stride+n]
+			for k := range mixed {
+				mixed[k] = 0
+			}
+			for j := 0; j < lines; j++ {
+				gain := float32(f.feedbackMatrix[i][j])
+				reads := f.reads[j*stride : j*stride+n]
+				for k := range mixed {
+					mixed[k] += reads[k] * gain
+				}
+			}
 		}
+		return
+	}
 
-		delay2 := f.delayLines[1][f.writeIndices[1]-1]
-		if f.writeIndices[1]-1 < 0 {
-			delay2 = f.delayLines[1][len(f.delayLines[1])-1]
+	// In-place fast Walsh-Hadamard transform on chunk-length vectors
+	copy(f.mixed[:lines*stride], f.reads[:lines*stride])
+	for h := 1; h < lines; h <<= 1 {
+		for i := 0; i < lines; i += h << 1 {
+			for j := i; j < i+h; j++ {
+				a := f.mixed[j*stride : j*stride+n]
+				b := f.mixed[(j+h)*stride : (j+h)*stride+n]
+				for k := range a {
+					x, y := a[k], b[k]
+					a[k] = x + y
+					b[k] = x - y
+				}
+			}
 		}
+	}
 
-		// Add decorrelated signals to create width
-		spread := float32(0.3)
-		outputL += delay1 * spread * float32(f.wetLevel)
-		outputR += delay2 * spread * float32(f.wetLevel)
+	// identityGain * x + matrixGain * H x (see updateInternalParameters)
+	hGain := f.matrixGain / float32(math.Sqrt(float64(lines)))
+	iGain := f.identityGain
+	for i := 0; i < lines; i++ {
+		mixed := f.mixed[i*stride : i*stride+n]
+		reads := f.reads[i*stride : i*stride+n]
+		for k := range mixed {
+			mixed[k] = mixed[k]*hGain + reads[k]*iGain
+		}
 	}
+}
 
-	// Apply final wet/dry mix
-	outputL = inputL*float32(f.dryLevel) + outputL*float32(f.wetLevel)
-	outputR = inputR*float32(f.dryLevel) + outputR*float32(f.wetLevel)
+// rotation returns the LFO rotation for a chunk of n samples, recomputed
+// only when the chunk length changes
+func (f *FDN) rotation(n int) (float64, float64) {
+	if n != f.rotLength {
+		angle := 2.0 * math.Pi * f.modRate / f.sampleRate * float64(n)
+		f.rotSin, f.rotCos = math.Sincos(angle)
+		f.rotLength = n
+	}
+	return f.rotSin, f.rotCos
+}
 
-	return outputL, outputR
+// resetModulation spreads the LFO phases evenly across the lines
+func (f *FDN) resetModulation() {
+	for i := 0; i < f.numDelays; i++ {
+		phase := float64(i) * 2.0 * math.Pi / float64(f.numDelays)
+		f.modSin[i], f.modCos[i] = math.Sincos(phase)
+	}
 }
 
 // Reset clears all internal state
 func (f *FDN) Reset() {
 	// Clear all delay lines
-	for i := 0; i < f.numDelays; i++ {
-		for j := range f.delayLines[i] {
-			f.delayLines[i][j] = 0
-		}
-		f.writeIndices[i] = 0
-		f.dampingFilters[i].Reset()
-		f.modPhases[i] = float64(i) * 2.0 * math.Pi / float64(f.numDelays)
+	for i := range f.buffer {
+		f.buffer[i] = 0
+	}
+	for i := range f.dampState {
+		f.dampState[i] = 0
 	}
+	f.writePos = 0
+	f.resetModulation()
 }
 
 // Preset methods
@@ -231,6 +231,31 @@ func TestFDNFeedbackMatrix(t *testing.T) {
 	}
 }
 
+func TestFDNFeedbackKeepsOriginalResponse(t *testing.T) {
+	fdn := NewFDN(4, 44100)
+	fdn.SetDecay(0.7)
+	fdn.SetDiffusion(0.6)
+
+	// The original engine scaled the matrix by decay and diffusion, then
+	// scaled it again in the loop: ds*(1-d)*I + ds*d*(ds*((1-d)*I + d*H))
+	ds, d := 0.4+0.7*0.58, 0.6
+	for i := 0; i < 4; i++ {
+		for j := 0; j < 4; j++ {
+			scaled := d * fdn.baseMatrix[i][j]
+			if i == j {
+				scaled += 1 - d
+			}
+			want := ds * d * ds * scaled
+			if i == j {
+				want += ds * (1 - d)
+			}
+			if got := fdn.feedbackMatrix[i][j]; math.Abs(got-want) > 1e-12 {
+				t.Errorf("Feedback[%d][%d] = %f, want %f", i, j, got, want)
+			}
+		}
+	}
+}
+
 func TestFDNDelayTimes(t *testing.T) {
 	fdn := NewFDN(4, 44100)
 
@@ -296,3 +321,103 @@ func BenchmarkFDNStereo(b *testing.B) {
 		}
 	}
 }
+
+func TestFDNProcessBlockMatchesStereo(t *testing.T) {
+	for _, numDelays := range []int{4, 6, 8} {
+		block := NewFDN(numDelays, 44100)
+		sample := NewFDN(numDelays, 44100)
+		for _, fdn := range []*FDN{block, sample} {
+			fdn.SetPresetMediumHall()
+			fdn.SetModulation(0)
+			// The Householder matrix is random; share it
+			copy(fdn.baseMatrix, block.baseMatrix)
+			fdn.updateInternalParameters()
+		}
+
+		in := make([]float32, 3000)
+		in[0] = 1
+		in[1500] = -0.5
+		outL := make([]float32, len(in))
+		outR := make([]float32, len(in))
+
+		// Uneven block sizes exercise the chunk edges
+		for start, size := 0, 37; start < len(in); start, size = start+size, size*2%509+1 {
+			end := start + size
+			if end > len(in) {
+				end = len(in)
+			}
+			block.ProcessBlock(in[start:end], outL[start:end], outR[start:end])
+		}
+
+		for i, x := range in {
+			l, r := sample.ProcessStereo(x, x)
+			if math.Abs(float64(l-outL[i])) > 1e-5 || math.Abs(float64(r-outR[i])) > 1e-5 {
+				t.Fatalf("%d lines, sample %d: block %f/%f, per-sample %f/%f", numDelays, i, outL[i], outR[i], l, r)
+			}
+		}
+	}
+}
+
+func TestFDNHadamardButterfly(t *testing.T) {
+	fdn := NewFDN(8, 44100)
+	fdn.SetDiffusion(0.7)
+	fdn.SetDecay(0.6)
+
+	// The butterfly must apply exactly the effective feedback matrix
+	n := 3
+	for i := 0; i < fdn.numDelays; i++ {
+		for k := 0; k < n; k++ {
+			fdn.reads[i*fdn.maxChunk+k] = float32(i*n+k+1) * 0.1
+		}
+	}
+	fdn.mixFeedback(n)
+
+	for i := 0; i < fdn.numDelays; i++ {
+		for k := 0; k < n; k++ {
+			want := 0.0
+			for j := 0; j < fdn.numDelays; j++ {
+				want += fdn.feedbackMatrix[i][j] * float64(fdn.reads[j*fdn.maxChunk+k])
+			}
+			if got := fdn.mixed[i*fdn.maxChunk+k]; math.Abs(float64(got)-want) > 1e-5 {
+				t.Errorf("Line %d, sample %d: got %f, want %f", i, k, got, want)
+			}
+		}
+	}
+}
+
+func TestFDNZeroAllocations(t *testing.T) {
+	fdn := NewFDN(8, 44100)
+	fdn.SetPresetLargeHall()
+
+	in := make([]float32, 512)
+	outL := make([]float32, 512)
+	outR := make([]float32, 512)
+	in[0] = 1
+
+	allocs := testing.AllocsPerRun(50, func() {
+		fdn.ProcessBlock(in, outL, outR)
+		fdn.Process(0.5)
+		fdn.ProcessStereo(0.5, 0.5)
+	})
+	if allocs != 0 {
+		t.Errorf("FDN allocated %.1f times per block", allocs)
+	}
+}
+
+func BenchmarkFDNBlock(b *testing.B) {
+	fdn := NewFDN(8, 44100)
+	fdn.SetPresetMediumHall()
+
+	input := make([]float32, 512)
+	outputL := make([]float32, 512)
+	outputR := make([]float32, 512)
+	for i := range input {
+		input[i] = float32(i%100) / 100.0
+	}
+
+	b.ReportAllocs()
+	b.ResetTimer()
+	for i := 0; i < b.N; i++ {
+		fdn.ProcessBlock(input, outputL, outputR)
+	}
+}
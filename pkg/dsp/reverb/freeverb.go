@@ -61,6 +61,10 @@ type Freeverb struct {
 	dry   float64
 	damp1 float64
 	damp2 float64
+
+	// One chunk of mono input and wet sums for ProcessStereoBuffer
+	mono       []float32
+	wetL, wetR []float32
 }
 
 // NewFreeverb creates a new Freeverb reverb instance
@@ -74,6 +78,9 @@ func NewFreeverb(sampleRate float64) *Freeverb {
 		width:      initialWidth,
 		mode:       0.0,
 		sampleRate: sampleRate,
+		mono:       make([]float32, reverbChunk),
+		wetL:       make([]float32, reverbChunk),
+		wetR:       make([]float32, reverbChunk),
 	}
 
 	// Scale factor for different sample rates
@@ -203,6 +210,43 @@ func (f *Freeverb) ProcessStereo(inputL, inputR float32) (outputL, outputR float
 	return outputL, outputR
 }
 
+// ProcessStereoBuffer processes stereo buffers - no allocations. Each comb
+// and all-pass filter runs over a whole chunk at a time, so its line moves
+// in block copies instead of one sample per filter per sample.
+func (f *Freeverb) ProcessStereoBuffer(inputL, inputR, outputL, outputR []float32) {
+	gain := float32(f.gain)
+	wet1, wet2, dry := float32(f.wet1), float32(f.wet2), float32(f.dry)
+	for start := 0; start < len(inputL); start += reverbChunk {
+		n := reverbChunk
+		if n > len(inputL)-start {
+			n = len(inputL) - start
+		}
+		inL, inR := inputL[start:start+n], inputR[start:start+n]
+		mono, wetL, wetR := f.mono[:n], f.wetL[:n], f.wetR[:n]
+		for i := range mono {
+			mono[i] = (inL[i] + inR[i]) * gain
+			wetL[i] = 0
+			wetR[i] = 0
+		}
+
+		for i := 0; i < numCombs; i++ {
+			f.combL[i].ProcessAdd(mono, wetL)
+			f.combR[i].ProcessAdd(mono, wetR)
+		}
+		for i := 0; i < numAllpasses; i++ {
+			f.allpassL[i].ProcessBuffer(wetL)
+			f.allpassR[i].ProcessBuffer(wetR)
+		}
+
+		outL, outR := outputL[start:start+n], outputR[start:start+n]
+		for i := range outL {
+			l, r := inL[i], inR[i]
+			outL[i] = wetL[i]*wet1 + wetR[i]*wet2 + l*dry
+			outR[i] = wetR[i]*wet1 + wetL[i]*wet2 + r*dry
+		}
+	}
+}
+
 // Process processes a mono input sample
 func (f *Freeverb) Process(input float32) float32 {
 	// For mono processing, use left channel only
@@ -208,7 +208,7 @@ func TestFreeverbDifferentSampleRates(t *testing.T) {
 		// Check that delay times are scaled properly
 		// Higher sample rates should have proportionally longer delay buffers
 		expectedScaling := sr / 44100.0
-		actualDelay := len(reverb.combL[0].buffer)
+		actualDelay := reverb.combL[0].delay
 		expectedDelay := int(float64(combTuning[0]) * expectedScaling)
 
 		// Allow some rounding error
@@ -218,6 +218,55 @@ func TestFreeverbDifferentSampleRates(t *testing.T) {
 	}
 }
 
+func TestFreeverbStereoBufferMatchesPerSample(t *testing.T) {
+	perSample := NewFreeverb(48000)
+	block := NewFreeverb(48000)
+	perSample.SetPresetLargeHall()
+	block.SetPresetLargeHall()
+
+	inputL, inputR := make([]float32, 3000), make([]float32, 3000)
+	for i := range inputL {
+		inputL[i] = float32(math.Sin(float64(i) * 0.05))
+		inputR[i] = float32(math.Sin(float64(i) * 0.11))
+	}
+	outputL, outputR := make([]float32, 3000), make([]float32, 3000)
+	// Uneven blocks exercise the chunking
+	for start := 0; start < 3000; start += 700 {
+		end := start + 700
+		if end > 3000 {
+			end = 3000
+		}
+		block.ProcessStereoBuffer(inputL[start:end], inputR[start:end], outputL[start:end], outputR[start:end])
+	}
+
+	for i := range inputL {
+		l, r := perSample.ProcessStereo(inputL[i], inputR[i])
+		if math.Abs(float64(l-outputL[i])) > 1e-6 || math.Abs(float64(r-outputR[i])) > 1e-6 {
+			t.Fatalf("Sample %d: block (%f, %f), per-sample (%f, %f)", i, outputL[i], outputR[i], l, r)
+		}
+	}
+}
+
+func BenchmarkFreeverbStereoBuffer(b *testing.B) {
+	reverb := NewFreeverb(44100)
+	reverb.SetPresetMediumHall()
+
+	inputL := make([]float32, 512)
+	inputR := make([]float32, 512)
+	outputL := make([]float32, 512)
+	outputR := make([]float32, 512)
+	for i := range inputL {
+		inputL[i] = float32(i%100) / 100.0
+		inputR[i] = float32((i+50)%100) / 100.0
+	}
+
+	b.ResetTimer()
+
+	for i := 0; i < b.N; i++ {
+		reverb.ProcessStereoBuffer(inputL, inputR, outputL, outputR)
+	}
+}
+
 func BenchmarkFreeverbStereo(b *testing.B) {
 	reverb := NewFreeverb(44100)
 	reverb.SetPresetMediumHall()
@@ -3,13 +3,19 @@ package reverb
 
 import (
 	"math"
+
+	"github.com/justyntemme/vst3go/pkg/dsp/delay"
 )
 
+// reverbChunk is the longest block the comb and all-pass filters move
+// through their lines at once
+const reverbChunk = 256
+
 // CombFilter implements a feedback comb filter for reverb
 type CombFilter struct {
-	buffer      []float32
-	bufferSize  int
-	bufferIdx   int
+	line        *delay.Line
+	delay       int       // Delay in samples
+	scratch     []float32 // One chunk of delayed samples
 	feedback    float64
 	filterstore float32
 	damp1       float64
@@ -19,15 +25,27 @@ type CombFilter struct {
 // NewCombFilter creates a new comb filter with the given delay in samples
 func NewCombFilter(delaySamples int) *CombFilter {
 	return &CombFilter{
-		buffer:     make([]float32, delaySamples),
-		bufferSize: delaySamples,
-		bufferIdx:  0,
-		feedback:   0.5,
-		damp1:      0.5,
-		damp2:      0.5,
+		line:     delay.NewSamples(delaySamples),
+		delay:    delaySamples,
+		scratch:  make([]float32, chunkFor(delaySamples)),
+		feedback: 0.5,
+		damp1:    0.5,
+		damp2:    0.5,
 	}
 }
 
+// chunkFor returns the block size of a filter: a block never reads samples
+// written within the same block
+func chunkFor(delaySamples int) int {
+	if delaySamples < 1 {
+		return 1
+	}
+	if delaySamples > reverbChunk {
+		return reverbChunk
+	}
+	return delaySamples
+}
+
 // SetFeedback sets the feedback amount (0-1)
 func (c *CombFilter) SetFeedback(feedback float64) {
 	c.feedback = math.Max(0.0, math.Min(1.0, feedback))
@@ -41,47 +59,63 @@ func (c *CombFilter) SetDamping(damping float64) {
 
 // Process processes a single sample through the comb filter
 func (c *CombFilter) Process(input float32) float32 {
-	output := c.buffer[c.bufferIdx]
+	output := c.line.At(c.delay)
 
 	// Apply damping (simple lowpass filter)
-	c.filterstore = float32(float64(output)*c.damp2 + float64(c.filterstore)*c.damp1)
+	c.filterstore = output*float32(c.damp2) + c.filterstore*float32(c.damp1)
 
 	// Write to buffer with feedback
-	c.buffer[c.bufferIdx] = input + float32(c.feedback)*c.filterstore
-
-	// Advance buffer index
-	c.bufferIdx++
-	if c.bufferIdx >= c.bufferSize {
-		c.bufferIdx = 0
-	}
+	c.line.Write(input + float32(c.feedback)*c.filterstore)
 
 	return output
 }
 
+// ProcessAdd runs a block through the comb filter and adds the result to
+// output - no allocations. Each chunk is read from the line with one block
+// copy before it is written back.
+func (c *CombFilter) ProcessAdd(input, output []float32) {
+	feedback, damp1, damp2 := float32(c.feedback), float32(c.damp1), float32(c.damp2)
+	for start := 0; start < len(input); start += len(c.scratch) {
+		n := len(c.scratch)
+		if n > len(input)-start {
+			n = len(input) - start
+		}
+		block := c.scratch[:n]
+		c.line.ReadBlock(block, c.delay)
+
+		in, out := input[start:start+n], output[start:start+n]
+		filterstore := c.filterstore
+		for i, delayed := range block {
+			filterstore = delayed*damp2 + filterstore*damp1
+			block[i] = in[i] + feedback*filterstore
+			out[i] += delayed
+		}
+		c.filterstore = filterstore
+		c.line.WriteBlock(block)
+	}
+}
+
 // Reset clears the comb filter state
 func (c *CombFilter) Reset() {
-	for i := range c.buffer {
-		c.buffer[i] = 0
-	}
-	c.bufferIdx = 0
+	c.line.Reset()
 	c.filterstore = 0
 }
 
 // AllPassFilter implements an all-pass filter for reverb diffusion
 type AllPassFilter struct {
-	buffer     []float32
-	bufferSize int
-	bufferIdx  int
-	feedback   float64
+	line     *delay.Line
+	delay    int       // Delay in samples
+	scratch  []float32 // One chunk of delayed samples
+	feedback float64
 }
 
 // NewAllPassFilter creates a new all-pass filter with the given delay in samples
 func NewAllPassFilter(delaySamples int) *AllPassFilter {
 	return &AllPassFilter{
-		buffer:     make([]float32, delaySamples),
-		bufferSize: delaySamples,
-		bufferIdx:  0,
-		feedback:   0.5,
+		line:     delay.NewSamples(delaySamples),
+		delay:    delaySamples,
+		scratch:  make([]float32, chunkFor(delaySamples)),
+		feedback: 0.5,
 	}
 }
 
@@ -92,28 +126,41 @@ func (a *AllPassFilter) SetFeedback(feedback float64) {
 
 // Process processes a single sample through the all-pass filter
 func (a *AllPassFilter) Process(input float32) float32 {
-	bufout := a.buffer[a.bufferIdx]
+	bufout := a.line.At(a.delay)
 
 	// All-pass filter equation: y[n] = -x[n] + x[n-D] + C * y[n-D]
 	// where C is the feedback coefficient
 	output := -input + bufout
-	a.buffer[a.bufferIdx] = input + float32(a.feedback)*bufout
-
-	// Advance buffer index
-	a.bufferIdx++
-	if a.bufferIdx >= a.bufferSize {
-		a.bufferIdx = 0
-	}
+	a.line.Write(input + float32(a.feedback)*bufout)
 
 	return output
 }
 
+// ProcessBuffer runs a block through the all-pass filter in place - no
+// allocations
+func (a *AllPassFilter) ProcessBuffer(buffer []float32) {
+	feedback := float32(a.feedback)
+	for start := 0; start < len(buffer); start += len(a.scratch) {
+		n := len(a.scratch)
+		if n > len(buffer)-start {
+			n = len(buffer) - start
+		}
+		block := a.scratch[:n]
+		a.line.ReadBlock(block, a.delay)
+
+		io := buffer[start : start+n]
+		for i, bufout := range block {
+			x := io[i]
+			io[i] = -x + bufout
+			block[i] = x + feedback*bufout
+		}
+		a.line.WriteBlock(block)
+	}
+}
+
 // Reset clears the all-pass filter state
 func (a *AllPassFilter) Reset() {
-	for i := range a.buffer {
-		a.buffer[i] = 0
-	}
-	a.bufferIdx = 0
+	a.line.Reset()
 }
 
 // Schroeder implements the classic Schroeder reverb algorithm
@@ -12,8 +12,8 @@ func TestCombFilterCreation(t *testing.T) {
 		t.Fatal("Failed to create comb filter")
 	}
 
-	if len(comb.buffer) != 1000 {
-		t.Errorf("Buffer size mismatch: got %d, want 1000", len(comb.buffer))
+	if comb.delay != 1000 {
+		t.Errorf("Delay mismatch: got %d, want 1000", comb.delay)
 	}
 
 	if comb.feedback != 0.5 {
@@ -63,8 +63,8 @@ func TestAllPassFilterCreation(t *testing.T) {
 		t.Fatal("Failed to create all-pass filter")
 	}
 
-	if len(allpass.buffer) != 500 {
-		t.Errorf("Buffer size mismatch: got %d, want 500", len(allpass.buffer))
+	if allpass.delay != 500 {
+		t.Errorf("Delay mismatch: got %d, want 500", allpass.delay)
 	}
 }
 
@@ -97,6 +97,31 @@ func TestAllPassFilterProcess(t *testing.T) {
 	}
 }
 
+func TestCombAndAllPassBlocksMatchProcess(t *testing.T) {
+	input := make([]float32, 2000)
+	for i := range input {
+		input[i] = float32(math.Sin(float64(i)*0.07)) * 0.5
+	}
+
+	comb, combBlock := NewCombFilter(300), NewCombFilter(300)
+	comb.SetFeedback(0.8)
+	combBlock.SetFeedback(0.8)
+	allpass, allpassBlock := NewAllPassFilter(150), NewAllPassFilter(150)
+
+	combOut := make([]float32, len(input))
+	combBlock.ProcessAdd(input, combOut)
+	allpassOut := append([]float32(nil), combOut...)
+	allpassBlock.ProcessBuffer(allpassOut)
+
+	for i, x := range input {
+		c := comb.Process(x)
+		a := allpass.Process(c)
+		if math.Abs(float64(c-combOut[i])) > 1e-6 || math.Abs(float64(a-allpassOut[i])) > 1e-6 {
+			t.Fatalf("Sample %d: block (%f, %f), per-sample (%f, %f)", i, combOut[i], allpassOut[i], c, a)
+		}
+	}
+}
+
 func TestSchroederCreation(t *testing.T) {
 	reverb := NewSchroeder(48000.0)
 
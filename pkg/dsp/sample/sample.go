@@ -0,0 +1,10 @@
+// Package sample defines the sample type constraint shared by the generic DSP kernels.
+package sample
+
+// Float is satisfied by the two sample formats VST3 hosts deliver:
+// 32-bit (kSample32) and 64-bit (kSample64) floating point.
+// Kernels written against Float are instantiated once per format, so a
+// double-precision chain runs natively without converting every block.
+type Float interface {
+	~float32 | ~float64
+}
@@ -0,0 +1,31 @@
+package utility
+
+import "github.com/justyntemme/vst3go/pkg/dsp/sample"
+
+// DenormalThreshold is the magnitude (-300 dBFS) below which the denormal
+// helpers flush a value to zero. It sits far above the subnormal range, so
+// decaying state is zeroed before the FPU ever slows down on it.
+const DenormalThreshold = 1e-15
+
+// FlushDenormal returns 0 for values within DenormalThreshold of zero.
+//
+// Plugins hosted through the bridge already run with flush-to-zero on, so
+// this is for DSP code that runs elsewhere (offline tools, tests, other
+// hosts) or on platforms without FTZ. Apply it to recursive filter state
+// once per block rather than per sample.
+func FlushDenormal[T sample.Float](x T) T {
+	if x < DenormalThreshold && x > -DenormalThreshold {
+		return 0
+	}
+	return x
+}
+
+// FlushDenormals applies FlushDenormal to every sample of buffer in place,
+// e.g. to the samples a feedback delay line received during the block
+func FlushDenormals[T sample.Float](buffer []T) {
+	for i, x := range buffer {
+		if x < DenormalThreshold && x > -DenormalThreshold {
+			buffer[i] = 0
+		}
+	}
+}
@@ -0,0 +1,67 @@
+package utility
+
+import (
+	"math"
+	"testing"
+)
+
+func TestFlushDenormal(t *testing.T) {
+	subnormal := math.Float32frombits(1) // Smallest positive subnormal
+	for _, x := range []float32{subnormal, -subnormal, 1e-20, -1e-16, 0} {
+		if got := FlushDenormal(x); got != 0 {
+			t.Errorf("FlushDenormal(%g) = %g, want 0", x, got)
+		}
+	}
+	for _, x := range []float32{1e-14, -1e-10, 0.5, -1} {
+		if got := FlushDenormal(x); got != x {
+			t.Errorf("FlushDenormal(%g) = %g, want it unchanged", x, got)
+		}
+	}
+	if got := FlushDenormal(4.9e-324); got != 0 {
+		t.Errorf("float64 subnormal flushed to %g", got)
+	}
+}
+
+func TestFlushDenormals(t *testing.T) {
+	buffer := []float64{1e-300, 0.25, -1e-16, -0.5, 1e-14}
+	FlushDenormals(buffer)
+	want := []float64{0, 0.25, 0, -0.5, 1e-14}
+	for i := range want {
+		if buffer[i] != want[i] {
+			t.Errorf("Sample %d: got %g, want %g", i, buffer[i], want[i])
+		}
+	}
+}
+
+// decayTail runs a slow one-pole lowpass on silence, the way a filter or
+// comb in a reverb rings out after the input stops
+func decayTail(state float32, block []float32) float32 {
+	const a = 0.0001
+	for i := range block {
+		state += a * (block[i] - state)
+		block[i] = state
+	}
+	return state
+}
+
+// BenchmarkDenormalTail shows the cost of a tail that has decayed into the
+// subnormal range, without and with a per-block flush of the filter state.
+// The bridge turns on FTZ/DAZ during process calls, which has the effect of
+// the flushed case for every operation.
+func BenchmarkDenormalTail(b *testing.B) {
+	block := make([]float32, 512)
+	const tail = 1e-39 // Subnormal in float32
+
+	b.Run("Subnormal", func(b *testing.B) {
+		for i := 0; i < b.N; i++ {
+			clear(block)
+			decayTail(tail, block)
+		}
+	})
+	b.Run("Flushed", func(b *testing.B) {
+		for i := 0; i < b.N; i++ {
+			clear(block)
+			decayTail(FlushDenormal(float32(tail)), block)
+		}
+	})
+}
@@ -9,6 +9,7 @@ import (
 	"runtime"
 	"strings"
 	"sync"
+	"sync/atomic"
 	"time"
 )
 
@@ -48,14 +49,15 @@ func (l LogLevel) String() string {
 	}
 }
 
-// Logger provides structured logging for VST3 plugins.
+// Logger provides structured logging for VST3 plugins. The level and
+// enabled flag are atomics so Enabled takes no lock on the audio thread.
 type Logger struct {
 	mu          sync.Mutex
 	output      io.Writer
-	level       LogLevel
+	level       atomic.Int32
 	prefix      string
 	flags       int
-	enabled     bool
+	enabled     atomic.Bool
 	includeTime bool
 	includeLine bool
 }
@@ -86,15 +88,16 @@ func init() {
 
 // New creates a new logger instance.
 func New(output io.Writer, prefix string, flags int) *Logger {
-	return &Logger{
+	l := &Logger{
 		output:      output,
 		prefix:      prefix,
 		flags:       flags,
-		level:       LogLevelInfo,
-		enabled:     true,
 		includeTime: flags&FlagTime != 0,
 		includeLine: flags&(FlagShortFile|FlagLongFile) != 0,
 	}
+	l.level.Store(int32(LogLevelInfo))
+	l.enabled.Store(true)
+	return l
 }
 
 // NewFileLogger creates a logger that writes to a file.
@@ -123,9 +126,7 @@ func (l *Logger) SetOutput(w io.Writer) {
 
 // SetLevel sets the minimum log level.
 func (l *Logger) SetLevel(level LogLevel) {
-	l.mu.Lock()
-	defer l.mu.Unlock()
-	l.level = level
+	l.level.Store(int32(level))
 }
 
 // SetPrefix sets the logger prefix.
@@ -146,26 +147,29 @@ func (l *Logger) SetFlags(flags int) {
 
 // SetEnabled enables or disables the logger.
 func (l *Logger) SetEnabled(enabled bool) {
-	l.mu.Lock()
-	defer l.mu.Unlock()
-	l.enabled = enabled
+	l.enabled.Store(enabled)
 }
 
 // IsEnabled returns whether the logger is enabled.
 func (l *Logger) IsEnabled() bool {
-	l.mu.Lock()
-	defer l.mu.Unlock()
-	return l.enabled
+	return l.enabled.Load()
+}
+
+// Enabled reports whether a message at the given level would be written.
+// Hot paths check it before formatting so disabled logging costs nothing;
+// it takes no lock and is safe on the audio thread.
+func (l *Logger) Enabled(level LogLevel) bool {
+	return l.enabled.Load() && int32(level) >= l.level.Load()
 }
 
 // log writes a log message at the specified level.
 func (l *Logger) log(level LogLevel, format string, args ...interface{}) {
-	l.mu.Lock()
-	defer l.mu.Unlock()
-	
-	if !l.enabled || level < l.level {
+	if !l.Enabled(level) {
 		return
 	}
+
+	l.mu.Lock()
+	defer l.mu.Unlock()
 	
 	// Build the log message
 	var sb strings.Builder
@@ -267,6 +271,11 @@ func SetEnabled(enabled bool) {
 	defaultLogger.SetEnabled(enabled)
 }
 
+// Enabled reports whether the default logger writes messages at the given level.
+func Enabled(level LogLevel) bool {
+	return defaultLogger.Enabled(level)
+}
+
 // Debug logs a debug message using the default logger.
 func Debug(format string, args ...interface{}) {
 	defaultLogger.Debug(format, args...)
@@ -4,6 +4,7 @@ import (
 	"bytes"
 	"strings"
 	"testing"
+	"time"
 )
 
 func TestLogger(t *testing.T) {
@@ -92,6 +93,25 @@ func TestLogger(t *testing.T) {
 	})
 }
 
+func TestEnabledTakesNoLock(t *testing.T) {
+	logger := New(&bytes.Buffer{}, "", FlagLevel)
+	logger.SetLevel(LogLevelWarn)
+
+	// A writer holding the mutex must not stall the audio-thread check
+	logger.mu.Lock()
+	defer logger.mu.Unlock()
+	done := make(chan bool)
+	go func() { done <- logger.Enabled(LogLevelError) && !logger.Enabled(LogLevelInfo) }()
+	select {
+	case ok := <-done:
+		if !ok {
+			t.Error("Enabled reported the wrong levels")
+		}
+	case <-time.After(time.Second):
+		t.Fatal("Enabled blocked on the logger mutex")
+	}
+}
+
 func TestLogLevel(t *testing.T) {
 	tests := []struct {
 		level    LogLevel
@@ -3,6 +3,7 @@ package debug
 
 import (
 	"fmt"
+	"sort"
 	"sync"
 	"sync/atomic"
 	"time"
@@ -286,4 +287,308 @@ func (a *AudioProcessProfiler) AudioReport() string {
 	report += fmt.Sprintf("  CPU Load:     %.2f%%\n", a.GetCPULoad())
 	
 	return report
-}
\ No newline at end of file
+}
+// Real-time section profiling
+//
+// RTProfiler is safe to leave enabled on the audio thread: sections are
+// registered up front on the control thread and identified by integer IDs,
+// each section is a single-producer ring of durations taken from the
+// monotonic clock, and recording never locks or allocates. Aggregation
+// (p50/p99/max, block budget usage) happens on the reader side.
+
+// SectionID identifies a section registered with an RTProfiler. The low
+// bits index a slot and the high bits carry a generation, so an ID kept
+// after Unregister never records into the section that reused its slot.
+type SectionID int32
+
+// NoSection is returned when a section could not be registered; recording
+// against it is a no-op.
+const NoSection SectionID = -1
+
+const (
+	// rtSlotBits sizes the slot table: at most 1024 sections are live at once.
+	rtSlotBits    = 10
+	maxRTSections = 1 << rtSlotBits
+	rtSlotMask    = maxRTSections - 1
+	// rtRingSize is the number of recent durations kept per section (power of two).
+	rtRingSize = 512
+)
+
+// rtEpoch anchors monotonic timestamps.
+var rtEpoch = time.Now()
+
+// rtSection is one producer's ring of recent durations in nanoseconds.
+type rtSection struct {
+	id       SectionID
+	name     string
+	ring     [rtRingSize]atomic.Int64
+	head     atomic.Uint64 // Written only by the producing thread
+	floor    atomic.Uint64 // First entry the reader still reports (set by Reset)
+	budgetNs atomic.Int64  // Block budget: max block size / sample rate
+}
+
+// RTProfiler records section timings from the audio thread without locks
+// or allocations. Each section must have a single producing thread.
+type RTProfiler struct {
+	mu          sync.Mutex // Serializes registration only
+	sections    [maxRTSections]atomic.Pointer[rtSection]
+	count       atomic.Int32 // Slots ever used
+	free        []int32      // Unregistered slots, reused first
+	generations [maxRTSections]int32
+	enabled     atomic.Bool
+}
+
+// DefaultRTProfiler is the global real-time profiler. It is disabled until
+// EnableRTProfiling is called; plugin Process calls and dsp chain stages
+// register with it automatically.
+var DefaultRTProfiler = NewRTProfiler()
+
+// NewRTProfiler creates a disabled real-time profiler.
+func NewRTProfiler() *RTProfiler {
+	return &RTProfiler{}
+}
+
+// Register adds a section and returns its ID. Every call creates a new
+// section, so each producer (plugin instance, chain stage) gets its own ring
+// even when names repeat. Producers Unregister their sections when torn
+// down. Call from the control thread.
+func (p *RTProfiler) Register(name string) SectionID {
+	p.mu.Lock()
+	defer p.mu.Unlock()
+
+	var slot int32
+	if n := len(p.free); n > 0 {
+		slot = p.free[n-1]
+		p.free = p.free[:n-1]
+	} else {
+		slot = p.count.Load()
+		if slot >= maxRTSections {
+			return NoSection
+		}
+		p.count.Store(slot + 1)
+	}
+
+	// Wrap the generation before it reaches the sign bit
+	p.generations[slot] = (p.generations[slot] + 1) & (1<<(31-rtSlotBits) - 1)
+	id := SectionID(p.generations[slot]<<rtSlotBits | slot)
+	p.sections[slot].Store(&rtSection{id: id, name: name})
+	return id
+}
+
+// Unregister removes a section and frees its slot for reuse. Recording
+// against the ID afterwards is a no-op. Call from the control thread once
+// the producer no longer records.
+func (p *RTProfiler) Unregister(id SectionID) {
+	if p.section(id) == nil {
+		return
+	}
+	p.mu.Lock()
+	defer p.mu.Unlock()
+
+	slot := int32(id) & rtSlotMask
+	if s := p.sections[slot].Load(); s != nil && s.id == id {
+		p.sections[slot].Store(nil)
+		p.free = append(p.free, slot)
+	}
+}
+
+// section resolves an ID to its live section, or nil
+func (p *RTProfiler) section(id SectionID) *rtSection {
+	if id < 0 {
+		return nil
+	}
+	s := p.sections[int32(id)&rtSlotMask].Load()
+	if s == nil || s.id != id {
+		return nil
+	}
+	return s
+}
+
+// SetEnabled enables or disables recording.
+func (p *RTProfiler) SetEnabled(enabled bool) {
+	p.enabled.Store(enabled)
+}
+
+// IsEnabled returns whether recording is enabled.
+func (p *RTProfiler) IsEnabled() bool {
+	return p.enabled.Load()
+}
+
+// SetBlockBudget sets the real-time budget of a section's block, the time
+// the host allows for maxSamplesPerBlock samples at sampleRate. Each plugin
+// instance sets its own, since instances run at different settings.
+func (p *RTProfiler) SetBlockBudget(id SectionID, maxSamplesPerBlock int32, sampleRate float64) {
+	s := p.section(id)
+	if s == nil {
+		return
+	}
+	if maxSamplesPerBlock <= 0 || sampleRate <= 0 {
+		s.budgetNs.Store(0)
+		return
+	}
+	s.budgetNs.Store(int64(float64(maxSamplesPerBlock) / sampleRate * float64(time.Second)))
+}
+
+// BlockBudget returns a section's block budget, or 0 when none is set.
+func (p *RTProfiler) BlockBudget(id SectionID) time.Duration {
+	if s := p.section(id); s != nil {
+		return time.Duration(s.budgetNs.Load())
+	}
+	return 0
+}
+
+// Begin returns a monotonic start timestamp, or 0 when profiling is disabled.
+func (p *RTProfiler) Begin() int64 {
+	if !p.enabled.Load() {
+		return 0
+	}
+	return int64(time.Since(rtEpoch))
+}
+
+// End records the time elapsed since a Begin timestamp for a section.
+func (p *RTProfiler) End(id SectionID, start int64) {
+	if start == 0 {
+		return
+	}
+	p.record(id, int64(time.Since(rtEpoch))-start)
+}
+
+// record pushes one duration into a section's ring.
+func (p *RTProfiler) record(id SectionID, ns int64) {
+	s := p.section(id)
+	if s == nil {
+		return
+	}
+
+	h := s.head.Load()
+	s.ring[h&(rtRingSize-1)].Store(ns)
+	s.head.Store(h + 1)
+}
+
+// SectionStats summarizes the recent timings of one section.
+type SectionStats struct {
+	Name  string
+	Count uint64 // Recordings since registration or the last Reset
+	P50   time.Duration
+	P99   time.Duration
+	Max   time.Duration
+	// Budget is the section's block budget, 0 when none is set
+	Budget time.Duration
+	// Fractions of the block budget used at p99 and max (0 when no budget is set)
+	BudgetP99 float64
+	BudgetMax float64
+}
+
+// Stats aggregates a section's recent timings. Call from a non-real-time thread.
+func (p *RTProfiler) Stats(id SectionID) (SectionStats, bool) {
+	s := p.section(id)
+	if s == nil {
+		return SectionStats{}, false
+	}
+
+	stats := SectionStats{Name: s.name, Budget: time.Duration(s.budgetNs.Load())}
+	floor := s.floor.Load()
+	head := s.head.Load()
+	if head <= floor {
+		return stats, true
+	}
+	stats.Count = head - floor
+
+	start := floor
+	if head-start > rtRingSize {
+		start = head - rtRingSize
+	}
+	samples := make([]int64, 0, head-start)
+	for i := start; i < head; i++ {
+		samples = append(samples, s.ring[i&(rtRingSize-1)].Load())
+	}
+
+	// Drop entries the producer overwrote while we were copying
+	if now := s.head.Load(); now > rtRingSize {
+		if overwritten := now - rtRingSize; overwritten > start {
+			if overwritten >= head {
+				return stats, true
+			}
+			samples = samples[overwritten-start:]
+		}
+	}
+
+	sort.Slice(samples, func(i, j int) bool { return samples[i] < samples[j] })
+	stats.P50 = time.Duration(samples[(len(samples)-1)*50/100])
+	stats.P99 = time.Duration(samples[(len(samples)-1)*99/100])
+	stats.Max = time.Duration(samples[len(samples)-1])
+
+	if stats.Budget > 0 {
+		stats.BudgetP99 = float64(stats.P99) / float64(stats.Budget)
+		stats.BudgetMax = float64(stats.Max) / float64(stats.Budget)
+	}
+	return stats, true
+}
+
+// AllStats aggregates every registered section in slot order.
+func (p *RTProfiler) AllStats() []SectionStats {
+	n := p.count.Load()
+	result := make([]SectionStats, 0, n)
+	for slot := int32(0); slot < n; slot++ {
+		if s := p.sections[slot].Load(); s != nil {
+			if stats, ok := p.Stats(s.id); ok {
+				result = append(result, stats)
+			}
+		}
+	}
+	return result
+}
+
+// Reset discards recorded timings without touching the producers.
+func (p *RTProfiler) Reset() {
+	n := p.count.Load()
+	for id := int32(0); id < n; id++ {
+		if s := p.sections[id].Load(); s != nil {
+			s.floor.Store(s.head.Load())
+		}
+	}
+}
+
+// Report generates a real-time performance report.
+func (p *RTProfiler) Report() string {
+	report := "Real-Time Performance Report:\n"
+	report += "=============================\n\n"
+
+	recorded := false
+	for _, stats := range p.AllStats() {
+		if stats.Count == 0 {
+			continue
+		}
+		recorded = true
+
+		report += fmt.Sprintf("%s:\n", stats.Name)
+		report += fmt.Sprintf("  Count:   %d\n", stats.Count)
+		report += fmt.Sprintf("  P50:     %v\n", stats.P50)
+		report += fmt.Sprintf("  P99:     %v\n", stats.P99)
+		report += fmt.Sprintf("  Max:     %v\n", stats.Max)
+		if stats.Budget > 0 {
+			report += fmt.Sprintf("  Budget:  %.1f%% p99, %.1f%% max of %v\n", stats.BudgetP99*100, stats.BudgetMax*100, stats.Budget)
+		}
+		report += "\n"
+	}
+
+	if !recorded {
+		return "No real-time measurements recorded"
+	}
+	return report
+}
+
+// EnableRTProfiling enables the default real-time profiler.
+func EnableRTProfiling() {
+	DefaultRTProfiler.SetEnabled(true)
+}
+
+// DisableRTProfiling disables the default real-time profiler.
+func DisableRTProfiling() {
+	DefaultRTProfiler.SetEnabled(false)
+}
+
+// RTProfilingReport returns a report from the default real-time profiler.
+func RTProfilingReport() string {
+	return DefaultRTProfiler.Report()
+}
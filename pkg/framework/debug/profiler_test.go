@@ -213,4 +213,131 @@ func BenchmarkProfiler(b *testing.B) {
 			stop()
 		}
 	})
-}
\ No newline at end of file
+}
+
+func TestRTProfiler(t *testing.T) {
+	t.Run("Percentiles", func(t *testing.T) {
+		p := NewRTProfiler()
+		id := p.Register("section")
+
+		for i := 1; i <= 100; i++ {
+			p.record(id, int64(i)*int64(time.Microsecond))
+		}
+
+		stats, ok := p.Stats(id)
+		if !ok {
+			t.Fatal("Section not found")
+		}
+		if stats.Count != 100 {
+			t.Errorf("Expected count 100, got %d", stats.Count)
+		}
+		if stats.P50 != 50*time.Microsecond || stats.P99 != 99*time.Microsecond || stats.Max != 100*time.Microsecond {
+			t.Errorf("Unexpected percentiles: p50=%v p99=%v max=%v", stats.P50, stats.P99, stats.Max)
+		}
+	})
+
+	t.Run("BlockBudget", func(t *testing.T) {
+		p := NewRTProfiler()
+		id := p.Register("process")
+		other := p.Register("other instance")
+		p.SetBlockBudget(id, 480, 48000)     // 10ms
+		p.SetBlockBudget(other, 4096, 44100) // Must not change id's budget
+		p.record(id, int64(5*time.Millisecond))
+
+		stats, _ := p.Stats(id)
+		if stats.BudgetMax < 0.49 || stats.BudgetMax > 0.51 {
+			t.Errorf("Expected 50%% of budget, got %.2f", stats.BudgetMax)
+		}
+		if !strings.Contains(p.Report(), "Budget:") {
+			t.Error("Report missing budget usage")
+		}
+	})
+
+	t.Run("RingWraps", func(t *testing.T) {
+		p := NewRTProfiler()
+		id := p.Register("wrap")
+		for i := 0; i < rtRingSize*3; i++ {
+			p.record(id, int64(i))
+		}
+
+		stats, _ := p.Stats(id)
+		if stats.Count != rtRingSize*3 {
+			t.Errorf("Expected count %d, got %d", rtRingSize*3, stats.Count)
+		}
+		if stats.Max != time.Duration(rtRingSize*3-1) {
+			t.Errorf("Max should come from the most recent window, got %v", stats.Max)
+		}
+
+		p.Reset()
+		if stats, _ := p.Stats(id); stats.Count != 0 {
+			t.Error("Reset should discard recorded timings")
+		}
+	})
+
+	t.Run("Unregister", func(t *testing.T) {
+		p := NewRTProfiler()
+		p.SetEnabled(true)
+
+		// Instances come and go far more often than the slot table is large
+		for i := 0; i < 3*maxRTSections; i++ {
+			id := p.Register("instance")
+			if id == NoSection {
+				t.Fatalf("Registration %d failed with sections released", i)
+			}
+			p.Unregister(id)
+		}
+
+		stale := p.Register("old")
+		p.Unregister(stale)
+		fresh := p.Register("new")
+		p.record(stale, 1)
+		if stats, _ := p.Stats(fresh); stats.Count != 0 {
+			t.Error("A stale ID recorded into the section that reused its slot")
+		}
+		if _, ok := p.Stats(stale); ok {
+			t.Error("Unregistered section still resolves")
+		}
+		if all := p.AllStats(); len(all) != 1 || all[0].Name != "new" {
+			t.Errorf("Expected only the live section, got %v", all)
+		}
+	})
+
+	t.Run("DisabledAndUnknown", func(t *testing.T) {
+		p := NewRTProfiler()
+		id := p.Register("disabled")
+		p.End(id, p.Begin())
+		if stats, _ := p.Stats(id); stats.Count != 0 {
+			t.Error("Disabled profiler should not record")
+		}
+
+		p.SetEnabled(true)
+		p.End(NoSection, p.Begin())
+		if _, ok := p.Stats(NoSection); ok {
+			t.Error("NoSection should not resolve")
+		}
+	})
+
+	t.Run("ZeroAllocations", func(t *testing.T) {
+		p := NewRTProfiler()
+		p.SetEnabled(true)
+		id := p.Register("alloc")
+
+		allocs := testing.AllocsPerRun(1000, func() {
+			p.End(id, p.Begin())
+		})
+		if allocs != 0 {
+			t.Errorf("Recording allocated %.1f times", allocs)
+		}
+	})
+}
+
+func BenchmarkRTProfiler(b *testing.B) {
+	p := NewRTProfiler()
+	p.SetEnabled(true)
+	id := p.Register("bench")
+
+	b.ReportAllocs()
+	for i := 0; i < b.N; i++ {
+		p.End(id, p.Begin())
+	}
+}
@@ -3,6 +3,9 @@ package dsp
 
 import (
 	"fmt"
+	"runtime"
+
+	"github.com/justyntemme/vst3go/pkg/framework/debug"
 )
 
 // Processor represents a DSP processor that can be chained.
@@ -46,31 +49,35 @@ func (f ProcessorFunc) Reset() {
 // Chain represents a chain of DSP processors.
 type Chain struct {
 	processors []Processor
+	stages     []debug.SectionID // Real-time profiler section per processor
 	name       string
 	bypass     bool
 }
 
-// NewChain creates a new DSP chain.
+// NewChain creates a new DSP chain. Its profiler sections are released by
+// Close, or when the chain is garbage collected.
 func NewChain(name string) *Chain {
-	return &Chain{
+	c := &Chain{
 		name:       name,
 		processors: make([]Processor, 0),
 	}
+	runtime.SetFinalizer(c, (*Chain).Close)
+	return c
 }
 
 // Add adds a processor to the chain.
 func (c *Chain) Add(processor Processor) *Chain {
 	c.processors = append(c.processors, processor)
+	c.stages = append(c.stages, registerStage(c.name, processor))
 	return c
 }
 
 // AddFunc adds a processing function to the chain.
 func (c *Chain) AddFunc(name string, process func([]float32)) *Chain {
-	c.processors = append(c.processors, &namedProcessor{
+	return c.Add(&namedProcessor{
 		name:    name,
 		process: ProcessorFunc(process),
 	})
-	return c
 }
 
 // Process processes audio through the chain.
@@ -79,8 +86,34 @@ func (c *Chain) Process(buffer []float32) {
 		return
 	}
 	
-	for _, processor := range c.processors {
+	profiler := debug.DefaultRTProfiler
+	for i, processor := range c.processors {
+		start := profiler.Begin()
 		processor.Process(buffer)
+		profiler.End(c.stages[i], start)
+	}
+}
+
+// Close unregisters the chain's stages from the real-time profiler. The
+// chain keeps processing, unprofiled.
+func (c *Chain) Close() {
+	releaseStages(c.stages)
+}
+
+// registerStage registers a chain stage with the real-time profiler
+func registerStage(chainName string, processor interface{}) debug.SectionID {
+	stageName := fmt.Sprintf("%T", processor)
+	if named, ok := processor.(*namedProcessor); ok {
+		stageName = named.name
+	}
+	return debug.DefaultRTProfiler.Register(chainName + "/" + stageName)
+}
+
+// releaseStages unregisters chain stages and marks them unprofiled
+func releaseStages(stages []debug.SectionID) {
+	for i, id := range stages {
+		debug.DefaultRTProfiler.Unregister(id)
+		stages[i] = debug.NoSection
 	}
 }
 
@@ -123,21 +156,32 @@ func (n *namedProcessor) Reset() {
 // StereoChain represents a chain of stereo DSP processors.
 type StereoChain struct {
 	processors []StereoProcessor
+	stages     []debug.SectionID // Real-time profiler section per processor
 	name       string
 	bypass     bool
 }
 
-// NewStereoChain creates a new stereo DSP chain.
+// NewStereoChain creates a new stereo DSP chain. Its profiler sections are
+// released by Close, or when the chain is garbage collected.
 func NewStereoChain(name string) *StereoChain {
-	return &StereoChain{
+	c := &StereoChain{
 		name:       name,
 		processors: make([]StereoProcessor, 0),
 	}
+	runtime.SetFinalizer(c, (*StereoChain).Close)
+	return c
+}
+
+// Close unregisters the chain's stages from the real-time profiler. The
+// chain keeps processing, unprofiled.
+func (c *StereoChain) Close() {
+	releaseStages(c.stages)
 }
 
 // Add adds a stereo processor to the chain.
 func (c *StereoChain) Add(processor StereoProcessor) *StereoChain {
 	c.processors = append(c.processors, processor)
+	c.stages = append(c.stages, registerStage(c.name, processor))
 	return c
 }
 
@@ -147,8 +191,11 @@ func (c *StereoChain) ProcessStereo(left, right []float32) {
 		return
 	}
 	
-	for _, processor := range c.processors {
+	profiler := debug.DefaultRTProfiler
+	for i, processor := range c.processors {
+		start := profiler.Begin()
 		processor.ProcessStereo(left, right)
+		profiler.End(c.stages[i], start)
 	}
 }
 
@@ -164,69 +211,6 @@ func (c *StereoChain) SetBypass(bypass bool) {
 	c.bypass = bypass
 }
 
-// ParallelChain processes audio through multiple chains in parallel and mixes the results.
-type ParallelChain struct {
-	chains []Processor
-	gains  []float32
-	name   string
-	bypass bool
-}
-
-// NewParallelChain creates a new parallel chain.
-func NewParallelChain(name string) *ParallelChain {
-	return &ParallelChain{
-		name:   name,
-		chains: make([]Processor, 0),
-		gains:  make([]float32, 0),
-	}
-}
-
-// Add adds a chain with a gain factor.
-func (p *ParallelChain) Add(chain Processor, gain float32) *ParallelChain {
-	p.chains = append(p.chains, chain)
-	p.gains = append(p.gains, gain)
-	return p
-}
-
-// Process processes audio through all parallel chains.
-func (p *ParallelChain) Process(buffer []float32) {
-	if p.bypass || len(p.chains) == 0 {
-		return
-	}
-	
-	// Create temporary buffers for each chain
-	tempBuffers := make([][]float32, len(p.chains))
-	for i := range tempBuffers {
-		tempBuffers[i] = make([]float32, len(buffer))
-		copy(tempBuffers[i], buffer)
-	}
-	
-	// Process each chain
-	for i, chain := range p.chains {
-		chain.Process(tempBuffers[i])
-	}
-	
-	// Mix results
-	for i := range buffer {
-		buffer[i] = 0
-		for j, temp := range tempBuffers {
-			buffer[i] += temp[i] * p.gains[j]
-		}
-	}
-}
-
-// Reset resets all chains.
-func (p *ParallelChain) Reset() {
-	for _, chain := range p.chains {
-		chain.Reset()
-	}
-}
-
-// SetBypass sets the bypass state.
-func (p *ParallelChain) SetBypass(bypass bool) {
-	p.bypass = bypass
-}
-
 // Builder provides a fluent API for building DSP chains.
 type Builder struct {
 	chain  *Chain
@@ -2,7 +2,10 @@ package dsp
 
 import (
 	"math"
+	"runtime"
 	"testing"
+
+	"github.com/justyntemme/vst3go/pkg/framework/debug"
 )
 
 // TestProcessor is a simple test processor that multiplies by a value.
@@ -187,6 +190,21 @@ func TestStereoChain(t *testing.T) {
 	})
 }
 
+func TestChainCloseReleasesProfilerSections(t *testing.T) {
+	chain := NewChain("closing")
+	chain.AddFunc("gain", func([]float32) {})
+	stage := chain.stages[0]
+	if _, ok := debug.DefaultRTProfiler.Stats(stage); !ok {
+		t.Fatal("Stage was not registered")
+	}
+
+	chain.Close()
+	if _, ok := debug.DefaultRTProfiler.Stats(stage); ok {
+		t.Error("Close left the stage registered")
+	}
+	chain.Process(make([]float32, 4)) // Still processes, unprofiled
+}
+
 func TestParallelChain(t *testing.T) {
 	t.Run("BasicParallel", func(t *testing.T) {
 		parallel := NewParallelChain("test")
@@ -225,6 +243,93 @@ func TestParallelChain(t *testing.T) {
 	})
 }
 
+func TestParallelChainBranches(t *testing.T) {
+	newChain := func() *ParallelChain {
+		parallel := NewParallelChain("test")
+		parallel.Add(&TestProcessor{multiplier: 1.0}, 0.5)
+		parallel.AddOffloaded(&TestProcessor{multiplier: 2.0}, 0.25)
+		parallel.Add(&TestProcessor{multiplier: 3.0}, 1.0)
+		parallel.AddOffloaded(&TestProcessor{multiplier: -1.0}, 0.5)
+		parallel.Add(&TestProcessor{multiplier: 4.0}, 0.125)
+		parallel.Prepare(256)
+		return parallel
+	}
+
+	// 0.5 + 0.5 + 3 - 0.5 + 0.5 = 4
+	check := func(t *testing.T, buffer []float32) {
+		for i, v := range buffer {
+			expected := float32(i) * 4
+			if math.Abs(float64(v-expected)) > 0.001 {
+				t.Fatalf("Sample %d: expected %f, got %f", i, expected, v)
+			}
+		}
+	}
+	ramp := func(n int) []float32 {
+		buffer := make([]float32, n)
+		for i := range buffer {
+			buffer[i] = float32(i)
+		}
+		return buffer
+	}
+
+	t.Run("Inline", func(t *testing.T) {
+		buffer := ramp(256)
+		newChain().Process(buffer)
+		check(t, buffer)
+	})
+
+	t.Run("Workers", func(t *testing.T) {
+		parallel := newChain()
+		parallel.StartWorkers(2)
+		defer parallel.StopWorkers()
+
+		for block := 0; block < 50; block++ {
+			buffer := ramp(128)
+			parallel.Process(buffer)
+			check(t, buffer)
+		}
+	})
+
+	t.Run("StopJoinsWorkers", func(t *testing.T) {
+		parallel := newChain()
+		before := runtime.NumGoroutine()
+
+		// Restarting the pool must not pile up threads
+		for i := 0; i < 10; i++ {
+			parallel.StartWorkers(2)
+			parallel.StopWorkers()
+		}
+		if after := runtime.NumGoroutine(); after != before {
+			t.Errorf("%d goroutines before, %d after StopWorkers", before, after)
+		}
+	})
+
+	t.Run("OversizeBlocks", func(t *testing.T) {
+		parallel := newChain()
+		input := ramp(1000)
+		buffer := make([]float32, len(input))
+		allocs := testing.AllocsPerRun(10, func() {
+			copy(buffer, input)
+			parallel.Process(buffer)
+		})
+		check(t, buffer)
+		if allocs != 0 {
+			t.Errorf("Block longer than the prepared size allocated %.1f times", allocs)
+		}
+	})
+
+	t.Run("ZeroAllocations", func(t *testing.T) {
+		parallel := newChain()
+		buffer := make([]float32, 256)
+		allocs := testing.AllocsPerRun(100, func() {
+			parallel.Process(buffer)
+		})
+		if allocs != 0 {
+			t.Errorf("ParallelChain allocated %.1f times per block", allocs)
+		}
+	})
+}
+
 func TestBuilder(t *testing.T) {
 	t.Run("ValidBuild", func(t *testing.T) {
 		chain, err := NewBuilder("test").
@@ -327,6 +432,7 @@ func BenchmarkParallelChain(b *testing.B) {
 		buffer[i] = float32(i) / 512.0
 	}
 	
+	b.ReportAllocs()
 	b.ResetTimer()
 	for i := 0; i < b.N; i++ {
 		parallel.Process(buffer)
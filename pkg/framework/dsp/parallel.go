@@ -0,0 +1,247 @@
+package dsp
+
+import (
+	"runtime"
+	"sync"
+)
+
+// ParallelChain processes audio through multiple chains in parallel and mixes the results.
+//
+// Every branch owns a buffer sized at Prepare time, so processing does not
+// allocate; blocks longer than the prepared size are processed in pieces.
+// Branches added with AddOffloaded run on a small worker pool
+// started by StartWorkers, so an expensive branch can use a second core
+// within the same block; Process waits for them before mixing.
+type ParallelChain struct {
+	branches     []parallelBranch
+	maxBlockSize int
+	name         string
+	bypass       bool
+
+	// Opt-in worker pool for offloaded branches
+	workers []*branchWorker
+	pending sync.WaitGroup
+	running sync.WaitGroup // Worker goroutines still alive
+	input   []float32      // Block being processed, read by workers
+}
+
+// parallelBranch is one chain of a ParallelChain with its private buffer
+type parallelBranch struct {
+	processor Processor
+	gain      float32
+	buffer    []float32
+	offloaded bool
+}
+
+// branchWorker runs its share of the offloaded branches once per block
+type branchWorker struct {
+	wake     chan struct{}
+	branches []int
+}
+
+// NewParallelChain creates a new parallel chain.
+func NewParallelChain(name string) *ParallelChain {
+	return &ParallelChain{
+		name:     name,
+		branches: make([]parallelBranch, 0),
+	}
+}
+
+// Add adds a chain with a gain factor.
+func (p *ParallelChain) Add(chain Processor, gain float32) *ParallelChain {
+	p.branches = append(p.branches, parallelBranch{
+		processor: chain,
+		gain:      gain,
+		buffer:    make([]float32, p.maxBlockSize),
+	})
+	return p
+}
+
+// AddOffloaded adds a chain that runs on the worker pool once StartWorkers
+// has been called, and inline before that. Use it for branches expensive
+// enough to outweigh the cross-thread handoff (reverbs, lookahead
+// compressors); cheap branches are faster inline.
+func (p *ParallelChain) AddOffloaded(chain Processor, gain float32) *ParallelChain {
+	p.Add(chain, gain)
+	p.branches[len(p.branches)-1].offloaded = true
+	return p
+}
+
+// Prepare sizes every branch buffer for blocks of up to maxBlockSize samples.
+// Call it from setup, not from the audio thread. Longer blocks are processed
+// in maxBlockSize pieces; a chain never prepared sizes itself from its first
+// block, which allocates.
+func (p *ParallelChain) Prepare(maxBlockSize int) {
+	p.maxBlockSize = maxBlockSize
+	for i := range p.branches {
+		if cap(p.branches[i].buffer) < maxBlockSize {
+			p.branches[i].buffer = make([]float32, maxBlockSize)
+		}
+	}
+}
+
+// StartWorkers starts a pool of numWorkers goroutines, each locked to its own
+// OS thread, and spreads the offloaded branches over them. Call it at setup
+// time, after adding branches and before processing.
+func (p *ParallelChain) StartWorkers(numWorkers int) {
+	p.StopWorkers()
+
+	var offloaded []int
+	for i := range p.branches {
+		if p.branches[i].offloaded {
+			offloaded = append(offloaded, i)
+		}
+	}
+	if numWorkers > len(offloaded) {
+		numWorkers = len(offloaded)
+	}
+	if numWorkers < 1 {
+		return
+	}
+
+	p.workers = make([]*branchWorker, numWorkers)
+	for w := range p.workers {
+		p.workers[w] = &branchWorker{wake: make(chan struct{}, 1)}
+	}
+	for i, branch := range offloaded {
+		worker := p.workers[i%numWorkers]
+		worker.branches = append(worker.branches, branch)
+	}
+	p.running.Add(len(p.workers))
+	for _, worker := range p.workers {
+		go p.runWorker(worker)
+	}
+}
+
+// StopWorkers stops the worker pool and waits for its goroutines to exit;
+// offloaded branches run inline again. It must not be called concurrently
+// with Process.
+func (p *ParallelChain) StopWorkers() {
+	for _, worker := range p.workers {
+		close(worker.wake)
+	}
+	p.running.Wait()
+	p.workers = nil
+}
+
+func (p *ParallelChain) runWorker(worker *branchWorker) {
+	defer p.running.Done()
+	runtime.LockOSThread()
+	defer runtime.UnlockOSThread()
+
+	for range worker.wake {
+		for _, i := range worker.branches {
+			p.processBranch(i)
+		}
+		p.pending.Done()
+	}
+}
+
+// Process processes audio through all parallel chains.
+func (p *ParallelChain) Process(buffer []float32) {
+	if p.bypass || len(p.branches) == 0 {
+		return
+	}
+	if p.maxBlockSize == 0 {
+		p.Prepare(len(buffer))
+	}
+
+	for start := 0; start < len(buffer); start += p.maxBlockSize {
+		end := start + p.maxBlockSize
+		if end > len(buffer) {
+			end = len(buffer)
+		}
+		p.processBlock(buffer[start:end])
+	}
+}
+
+// processBlock runs every branch over a block of at most maxBlockSize
+// samples and mixes the results into it
+func (p *ParallelChain) processBlock(buffer []float32) {
+	p.input = buffer
+	if len(p.workers) > 0 {
+		p.pending.Add(len(p.workers))
+		for _, worker := range p.workers {
+			worker.wake <- struct{}{}
+		}
+	}
+
+	for i := range p.branches {
+		if !p.branches[i].offloaded || len(p.workers) == 0 {
+			p.processBranch(i)
+		}
+	}
+
+	// Barrier: every branch is finished before the input is overwritten
+	if len(p.workers) > 0 {
+		p.pending.Wait()
+	}
+	p.input = nil
+
+	p.mix(buffer)
+}
+
+// processBranch runs one branch on a copy of the current input
+func (p *ParallelChain) processBranch(i int) {
+	branch := &p.branches[i]
+	out := branch.buffer[:len(p.input)]
+	copy(out, p.input)
+	branch.processor.Process(out)
+}
+
+// mix sums the branch outputs into buffer, two branches per pass
+func (p *ParallelChain) mix(buffer []float32) {
+	n := len(buffer)
+	branches := p.branches
+
+	first := 0
+	if len(branches)%2 == 1 {
+		scaleInto(buffer, branches[0].buffer[:n], branches[0].gain)
+		first = 1
+	} else {
+		mix2Into(buffer, branches[0].buffer[:n], branches[0].gain, branches[1].buffer[:n], branches[1].gain)
+		first = 2
+	}
+
+	for i := first; i+1 < len(branches); i += 2 {
+		accumulate2(buffer, branches[i].buffer[:n], branches[i].gain, branches[i+1].buffer[:n], branches[i+1].gain)
+	}
+}
+
+// scaleInto computes dst = a*ga
+func scaleInto(dst, a []float32, ga float32) {
+	a = a[:len(dst)]
+	for i := range dst {
+		dst[i] = a[i] * ga
+	}
+}
+
+// mix2Into computes dst = a*ga + b*gb
+func mix2Into(dst, a []float32, ga float32, b []float32, gb float32) {
+	a = a[:len(dst)]
+	b = b[:len(dst)]
+	for i := range dst {
+		dst[i] = a[i]*ga + b[i]*gb
+	}
+}
+
+// accumulate2 computes dst += a*ga + b*gb
+func accumulate2(dst, a []float32, ga float32, b []float32, gb float32) {
+	a = a[:len(dst)]
+	b = b[:len(dst)]
+	for i := range dst {
+		dst[i] += a[i]*ga + b[i]*gb
+	}
+}
+
+// Reset resets all chains.
+func (p *ParallelChain) Reset() {
+	for i := range p.branches {
+		p.branches[i].processor.Reset()
+	}
+}
+
+// SetBypass sets the bypass state.
+func (p *ParallelChain) SetBypass(bypass bool) {
+	p.bypass = bypass
+}
@@ -89,10 +89,21 @@ func (b *Builder) Bypass() *Builder {
 	return b
 }
 
-// Formatter sets custom value formatting and parsing
+// Formatter sets custom value formatting and parsing. It clears any
+// precision set before it; call Precision afterwards to declare the new
+// formatter's step.
 func (b *Builder) Formatter(format func(float64) string, parse func(string) (float64, error)) *Builder {
 	b.param.formatFunc = format
 	b.param.parseFunc = parse
+	b.param.precision = 0
+	return b
+}
+
+// Precision sets the smallest plain-value step the formatter shows, so
+// nearby values share a cached display string (see Parameter.SetPrecision).
+// Call it after Formatter.
+func (b *Builder) Precision(step float64) *Builder {
+	b.param.precision = step
 	return b
 }
 
@@ -98,7 +98,8 @@ func MixParameter(id uint32, name string) *Builder {
 		Range(0, 100).
 		Default(100).
 		Unit("%").
-		Formatter(PercentFormatter, PercentParser)
+		Formatter(PercentFormatter, PercentParser).
+		Precision(1)
 }
 
 // FrequencyParameter creates a standard frequency parameter with logarithmic scaling
@@ -175,7 +176,8 @@ func QParameter(id uint32, name string, minQ, maxQ, defaultQ float64) *Builder {
 		Default(defaultQ).
 		Formatter(func(v float64) string {
 			return fmt.Sprintf("Q: %.2f", v)
-		}, nil)
+		}, nil).
+		Precision(0.01)
 }
 
 // PanParameter creates a stereo pan parameter
@@ -250,7 +252,8 @@ func FeedbackParameter(id uint32, name string) *Builder {
 		Range(0, 100).
 		Default(0).
 		Unit("%").
-		Formatter(PercentFormatter, PercentParser)
+		Formatter(PercentFormatter, PercentParser).
+		Precision(1)
 }
 
 // ResonanceParameter creates a standard resonance parameter
@@ -269,7 +272,8 @@ func DriveParameter(id uint32, name string) *Builder {
 		Range(0, 100).
 		Default(0).
 		Unit("%").
-		Formatter(PercentFormatter, PercentParser)
+		Formatter(PercentFormatter, PercentParser).
+		Precision(1)
 }
 
 // OutputLevelMeter creates a read-only output level meter
@@ -321,7 +325,8 @@ func DepthParameter(id uint32, name string) *Builder {
 		Range(0, 100).
 		Default(50).
 		Unit("%").
-		Formatter(PercentFormatter, PercentParser)
+		Formatter(PercentFormatter, PercentParser).
+		Precision(1)
 }
 
 // BypassParameter creates a bypass on/off switch
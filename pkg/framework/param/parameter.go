@@ -3,6 +3,7 @@ package param
 
 import (
 	"fmt"
+	"math"
 	"strconv"
 	"sync/atomic"
 	"unsafe"
@@ -27,6 +28,17 @@ type Parameter struct {
 	// Value formatting
 	formatFunc func(float64) string
 	parseFunc  func(string) (float64, error)
+	precision  float64 // Plain-value step the display resolves, 0 if unknown
+
+	// Last FormatValue result, so redrawing an unchanged value is free
+	lastFormat atomic.Pointer[formattedValue]
+}
+
+// formattedValue is a cached FormatValue result. Entries are immutable so
+// the UI and host threads can share them through an atomic pointer.
+type formattedValue struct {
+	key  uint64
+	text string
 }
 
 // Flags for parameters
@@ -75,16 +87,44 @@ func (p *Parameter) SetPlainValue(plain float64) {
 	p.SetValue(normalized)
 }
 
-// SetFormatter sets custom value formatting
+// SetFormatter sets custom value formatting. The display precision is
+// reset to exact-match caching; call SetPrecision afterwards if the new
+// formatter has a fixed step.
 func (p *Parameter) SetFormatter(format func(float64) string, parse func(string) (float64, error)) {
 	p.formatFunc = format
 	p.parseFunc = parse
+	p.precision = 0
+	p.lastFormat.Store(nil)
+}
+
+// SetPrecision declares the smallest plain-value step the formatter shows,
+// e.g. 0.1 for "%.1f dB". Values that round to the same step then reuse the
+// last formatted string. Leave it at 0 for formatters with thresholds or
+// special cases ("-∞ dB", "Center"); only identical values are reused then.
+func (p *Parameter) SetPrecision(step float64) {
+	p.precision = step
+	p.lastFormat.Store(nil)
 }
 
-// FormatValue returns formatted parameter value
+// FormatValue returns formatted parameter value. The last result is cached,
+// so hosts that poll the display string of an idle parameter don't format
+// or allocate.
 func (p *Parameter) FormatValue(normalized float64) string {
 	plain := p.Denormalize(normalized)
 
+	key, cacheable := p.formatKey(plain)
+	if cached := p.lastFormat.Load(); cached != nil && cacheable && cached.key == key {
+		return cached.text
+	}
+
+	text := p.format(plain)
+	if cacheable {
+		p.lastFormat.Store(&formattedValue{key: key, text: text})
+	}
+	return text
+}
+
+func (p *Parameter) format(plain float64) string {
 	if p.formatFunc != nil {
 		return p.formatFunc(plain)
 	}
@@ -97,6 +137,29 @@ func (p *Parameter) FormatValue(normalized float64) string {
 	return fmt.Sprintf("%.2f", plain)
 }
 
+// formatKey quantizes plain to the display precision. Values halfway
+// between two steps are not cached: printf rounds those to even, so the
+// bucket they fall in depends on their exact binary value.
+func (p *Parameter) formatKey(plain float64) (uint64, bool) {
+	step := p.precision
+	if step == 0 && p.formatFunc == nil {
+		step = 0.01 // "%.2f"
+		if p.StepCount > 0 {
+			step = 1 // "%.0f"
+		}
+	}
+	if step <= 0 {
+		return math.Float64bits(plain), true
+	}
+
+	steps := plain / step
+	if _, frac := math.Modf(math.Abs(steps)); math.Abs(frac-0.5) < 1e-9 {
+		return 0, false
+	}
+	// Keep the sign of -0 so "-0.00" and "0.00" stay apart
+	return math.Float64bits(math.Round(steps)), true
+}
+
 // ParseValue parses string to normalized value
 func (p *Parameter) ParseValue(str string) (float64, error) {
 	if p.parseFunc != nil {
@@ -0,0 +1,113 @@
+package param
+
+import (
+	"fmt"
+	"math/rand"
+	"testing"
+)
+
+func TestFormatValueCacheMatchesFormatter(t *testing.T) {
+	params := []*Parameter{
+		New(0, "Plain").Range(-1, 1).Build(),
+		New(1, "Steps").Range(0, 10).Steps(10).Build(),
+		MixParameter(2, "Mix").Build(),
+		QParameter(3, "Q", 0.1, 10, 0.7).Build(),
+		GainParameter(4, "Gain").Build(),
+	}
+	rng := rand.New(rand.NewSource(1))
+	for _, p := range params {
+		previous := 0.0
+		for i := 0; i < 20000; i++ {
+			// Mostly small moves, like a knob being dragged
+			value := previous + (rng.Float64()-0.5)*0.002
+			if i%7 == 0 {
+				value = rng.Float64()
+			}
+			if value < 0 || value > 1 {
+				value = rng.Float64()
+			}
+			previous = value
+
+			if got, want := p.FormatValue(value), p.format(p.Denormalize(value)); got != want {
+				t.Fatalf("%s at %v: cached %q, formatter %q", p.Name, value, got, want)
+			}
+		}
+	}
+}
+
+func TestFormatValueRoundingEdges(t *testing.T) {
+	p := New(0, "Plain").Range(-1, 1).Build()
+	for _, tc := range []struct {
+		plain float64
+		want  string
+	}{
+		{0.125, "0.12"}, // Halfway: printf rounds to even
+		{0.13, "0.13"},
+		{0.125, "0.12"},
+		{0.001, "0.00"},
+		{-0.001, "-0.00"},
+		{0.001, "0.00"},
+	} {
+		if got := p.FormatValue(p.Normalize(tc.plain)); got != tc.want {
+			t.Errorf("%v: got %q, want %q", tc.plain, got, tc.want)
+		}
+	}
+}
+
+func TestSetFormatterClearsCache(t *testing.T) {
+	p := New(0, "Plain").Build()
+	p.FormatValue(0.5)
+	p.SetFormatter(func(float64) string { return "custom" }, nil)
+	if got := p.FormatValue(0.5); got != "custom" {
+		t.Errorf("Stale cached string after SetFormatter: %q", got)
+	}
+}
+
+func TestReplacedFormatterResetsPrecision(t *testing.T) {
+	tenths := func(v float64) string { return fmt.Sprintf("%.1f%%", v) }
+
+	built := MixParameter(0, "Mix").Formatter(tenths, nil).Build()
+	set := MixParameter(1, "Mix").Build()
+	set.SetFormatter(tenths, nil)
+
+	for _, p := range []*Parameter{built, set} {
+		for _, plain := range []float64{50.3, 50.4} {
+			if got, want := p.FormatValue(p.Normalize(plain)), tenths(plain); got != want {
+				t.Errorf("%s %v: got %q, want %q", p.Name, plain, got, want)
+			}
+		}
+	}
+
+	// Precision after the formatter still applies
+	stepped := MixParameter(2, "Mix").Formatter(tenths, nil).Precision(0.1).Build()
+	if stepped.precision != 0.1 {
+		t.Errorf("Precision after Formatter was dropped: %v", stepped.precision)
+	}
+}
+
+func TestFormatValueCachedZeroAllocations(t *testing.T) {
+	p := FrequencyParameter(0, "Cutoff", 20, 20000, 1000).Build()
+	p.FormatValue(0.3)
+	allocs := testing.AllocsPerRun(100, func() {
+		p.FormatValue(0.3)
+	})
+	if allocs != 0 {
+		t.Errorf("Formatting an unchanged value allocated %.1f times", allocs)
+	}
+}
+
+// BenchmarkFormatValue formats an idle parameter, as hosts do when they
+// redraw automation lanes and generic editors
+func BenchmarkFormatValue(b *testing.B) {
+	p := QParameter(0, "Q", 0.1, 10, 0.7).Build()
+	b.Run("Uncached", func(b *testing.B) {
+		for i := 0; i < b.N; i++ {
+			p.format(p.Denormalize(0.3))
+		}
+	})
+	b.Run("Cached", func(b *testing.B) {
+		for i := 0; i < b.N; i++ {
+			p.FormatValue(0.3)
+		}
+	})
+}
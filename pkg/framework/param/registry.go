@@ -1,14 +1,23 @@
 package param
 
 import (
+	"errors"
 	"sync"
+	"sync/atomic"
 )
 
+// ErrRegistrySealed is returned when adding parameters to a sealed registry
+var ErrRegistrySealed = errors.New("parameter registry is sealed")
+
 // Registry manages plugin parameters
 type Registry struct {
 	params map[uint32]*Parameter
 	order  []uint32 // Maintain order for indexed access
 	mu     sync.RWMutex
+
+	// Immutable lookup tables, set once the parameter set is frozen.
+	// Reads go through them without locking.
+	sealed atomic.Pointer[sealedIndex]
 }
 
 // NewRegistry creates a new parameter registry
@@ -24,6 +33,10 @@ func (r *Registry) Add(params ...*Parameter) error {
 	r.mu.Lock()
 	defer r.mu.Unlock()
 
+	if r.sealed.Load() != nil {
+		return ErrRegistrySealed
+	}
+
 	for _, p := range params {
 		if _, exists := r.params[p.ID]; exists {
 			continue // Skip duplicates
@@ -35,8 +48,38 @@ func (r *Registry) Add(params ...*Parameter) error {
 	return nil
 }
 
+// Seal freezes the parameter set. Afterwards Get, GetByIndex, IndexOf and
+// Count are lock-free and Add returns ErrRegistrySealed. Sealing an already
+// sealed registry is a no-op.
+func (r *Registry) Seal() {
+	r.mu.Lock()
+	defer r.mu.Unlock()
+
+	if r.sealed.Load() != nil {
+		return
+	}
+
+	byIndex := make([]*Parameter, len(r.order))
+	for i, id := range r.order {
+		byIndex[i] = r.params[id]
+	}
+	r.sealed.Store(newSealedIndex(byIndex))
+}
+
+// IsSealed returns true once Seal has been called
+func (r *Registry) IsSealed() bool {
+	return r.sealed.Load() != nil
+}
+
 // Get retrieves a parameter by ID
 func (r *Registry) Get(id uint32) *Parameter {
+	if s := r.sealed.Load(); s != nil {
+		if i := s.indexOf(id); i >= 0 {
+			return s.byIndex[i]
+		}
+		return nil
+	}
+
 	r.mu.RLock()
 	defer r.mu.RUnlock()
 
@@ -45,6 +88,13 @@ func (r *Registry) Get(id uint32) *Parameter {
 
 // GetByIndex retrieves a parameter by index
 func (r *Registry) GetByIndex(index int32) *Parameter {
+	if s := r.sealed.Load(); s != nil {
+		if index < 0 || index >= int32(len(s.byIndex)) {
+			return nil
+		}
+		return s.byIndex[index]
+	}
+
 	r.mu.RLock()
 	defer r.mu.RUnlock()
 
@@ -56,14 +106,59 @@ func (r *Registry) GetByIndex(index int32) *Parameter {
 	return r.params[id]
 }
 
+// IndexOf returns the registration index of a parameter, or -1. The index is
+// a stable handle for GetByIndex and the Snapshot layout; resolve it once at
+// setup time.
+func (r *Registry) IndexOf(id uint32) int32 {
+	if s := r.sealed.Load(); s != nil {
+		return s.indexOf(id)
+	}
+
+	r.mu.RLock()
+	defer r.mu.RUnlock()
+
+	for i, orderedID := range r.order {
+		if orderedID == id {
+			return int32(i)
+		}
+	}
+	return -1
+}
+
 // Count returns the number of parameters
 func (r *Registry) Count() int32 {
+	if s := r.sealed.Load(); s != nil {
+		return int32(len(s.byIndex))
+	}
+
 	r.mu.RLock()
 	defer r.mu.RUnlock()
 
 	return int32(len(r.order))
 }
 
+// Snapshot writes every normalized value into dst in registration order,
+// growing it only if it is too short, and returns it. With a sealed registry
+// and a dst sized to Count this is lock-free and allocation-free, giving
+// processors a contiguous per-block parameter view indexed by IndexOf.
+func (r *Registry) Snapshot(dst []float64) []float64 {
+	if s := r.sealed.Load(); s != nil {
+		return snapshotValues(dst, s.byIndex)
+	}
+
+	r.mu.RLock()
+	defer r.mu.RUnlock()
+
+	if cap(dst) < len(r.order) {
+		dst = make([]float64, len(r.order))
+	}
+	dst = dst[:len(r.order)]
+	for i, id := range r.order {
+		dst[i] = r.params[id].GetValue()
+	}
+	return dst
+}
+
 // All returns all parameters in order
 func (r *Registry) All() []*Parameter {
 	r.mu.RLock()
@@ -76,3 +171,116 @@ func (r *Registry) All() []*Parameter {
 
 	return result
 }
+
+// snapshotValues copies the normalized values of params into dst
+func snapshotValues(dst []float64, params []*Parameter) []float64 {
+	if cap(dst) < len(params) {
+		dst = make([]float64, len(params))
+	}
+	dst = dst[:len(params)]
+	for i, p := range params {
+		dst[i] = p.GetValue()
+	}
+	return dst
+}
+
+// sealedIndex maps parameter IDs to registration indices. Compact ID ranges
+// use a direct table; sparse IDs use a minimal-probe perfect hash, so every
+// lookup is a single table read plus one key comparison.
+type sealedIndex struct {
+	byIndex []*Parameter
+
+	// Direct table: slot = id
+	direct []int32
+
+	// Perfect hash: slot = (id * mult) >> shift
+	keys  []uint32
+	slots []int32
+	mult  uint32
+	shift uint32
+}
+
+// maxDirectSpan bounds the direct table when IDs are not compact
+const maxDirectSpan = 4096
+
+func newSealedIndex(byIndex []*Parameter) *sealedIndex {
+	s := &sealedIndex{byIndex: byIndex}
+
+	maxID := uint32(0)
+	for _, p := range byIndex {
+		if p.ID > maxID {
+			maxID = p.ID
+		}
+	}
+
+	// IDs are usually small enums; index them directly when that stays compact
+	if span := uint64(maxID) + 1; span <= maxDirectSpan || span <= uint64(4*len(byIndex)) {
+		s.direct = make([]int32, span)
+		for i := range s.direct {
+			s.direct[i] = -1
+		}
+		for i, p := range byIndex {
+			s.direct[p.ID] = int32(i)
+		}
+		return s
+	}
+
+	s.buildPerfectHash()
+	return s
+}
+
+// buildPerfectHash searches for a multiplicative hash without collisions,
+// doubling the table until one is found
+func (s *sealedIndex) buildPerfectHash() {
+	bits := uint32(1)
+	for 1<<bits < 2*len(s.byIndex) {
+		bits++
+	}
+
+	for ; ; bits++ {
+		size := 1 << bits
+		keys := make([]uint32, size)
+		slots := make([]int32, size)
+
+		for attempt := uint32(0); attempt < 64; attempt++ {
+			mult := 0x9E3779B1 + attempt*0x6A09E667 | 1 // Odd multipliers
+			shift := 32 - bits
+
+			for i := range slots {
+				slots[i] = -1
+			}
+
+			collision := false
+			for i, p := range s.byIndex {
+				slot := (p.ID * mult) >> shift
+				if slots[slot] >= 0 {
+					collision = true
+					break
+				}
+				slots[slot] = int32(i)
+				keys[slot] = p.ID
+			}
+
+			if !collision {
+				s.keys, s.slots, s.mult, s.shift = keys, slots, mult, shift
+				return
+			}
+		}
+	}
+}
+
+// indexOf returns the registration index for id, or -1
+func (s *sealedIndex) indexOf(id uint32) int32 {
+	if s.direct != nil {
+		if uint64(id) < uint64(len(s.direct)) {
+			return s.direct[id]
+		}
+		return -1
+	}
+
+	slot := (id * s.mult) >> s.shift
+	if i := s.slots[slot]; i >= 0 && s.keys[slot] == id {
+		return i
+	}
+	return -1
+}
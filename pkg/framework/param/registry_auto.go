@@ -34,6 +34,10 @@ func (r *AutoRegistry) Register(params ...*Parameter) error {
 	r.mu.Lock()
 	defer r.mu.Unlock()
 	
+	if r.IsSealed() {
+		return ErrRegistrySealed
+	}
+	
 	for _, p := range params {
 		// Check if we already have this parameter by name
 		if existingID, exists := r.nameToID[p.Name]; exists {
@@ -67,6 +71,10 @@ func (r *AutoRegistry) RegisterWithID(id uint32, param *Parameter) error {
 	r.mu.Lock()
 	defer r.mu.Unlock()
 	
+	if r.IsSealed() {
+		return ErrRegistrySealed
+	}
+	
 	// Force the ID
 	param.ID = id
 	
@@ -110,11 +118,16 @@ func (r *AutoRegistry) GetID(name string) (uint32, bool) {
 	return id, exists
 }
 
-// Clear removes all parameters and resets the ID counter
+// Clear removes all parameters and resets the ID counter. A sealed registry
+// is left untouched.
 func (r *AutoRegistry) Clear() {
 	r.mu.Lock()
 	defer r.mu.Unlock()
 	
+	if r.IsSealed() {
+		return
+	}
+	
 	r.params = make(map[uint32]*Parameter)
 	r.order = make([]uint32, 0)
 	r.nameToID = make(map[string]uint32)
@@ -0,0 +1,133 @@
+package param
+
+import (
+	"errors"
+	"testing"
+)
+
+func TestRegistrySeal(t *testing.T) {
+	t.Run("DenseIDs", func(t *testing.T) {
+		reg := NewRegistry()
+		reg.Add(
+			New(0, "Gain").Build(),
+			New(1, "Mix").Build(),
+			New(5, "Cutoff").Build(),
+		)
+		reg.Seal()
+
+		if !reg.IsSealed() {
+			t.Fatal("Registry should report sealed")
+		}
+		if reg.Count() != 3 {
+			t.Errorf("Expected 3 parameters, got %d", reg.Count())
+		}
+		if p := reg.Get(5); p == nil || p.Name != "Cutoff" {
+			t.Errorf("Get(5) returned %v", p)
+		}
+		if reg.Get(2) != nil || reg.Get(100) != nil {
+			t.Error("Unknown IDs should return nil")
+		}
+		if reg.IndexOf(5) != 2 || reg.IndexOf(3) != -1 {
+			t.Errorf("Unexpected indices: %d, %d", reg.IndexOf(5), reg.IndexOf(3))
+		}
+		if p := reg.GetByIndex(1); p == nil || p.ID != 1 {
+			t.Errorf("GetByIndex(1) returned %v", p)
+		}
+	})
+
+	t.Run("SparseIDs", func(t *testing.T) {
+		ids := []uint32{7, 0x1000, 0xBEEF, 0x7FFFFFFF, 0xFFFFFFFE, 123456789}
+		reg := NewRegistry()
+		for _, id := range ids {
+			reg.Add(New(id, "Param").Build())
+		}
+		reg.Seal()
+
+		for i, id := range ids {
+			if p := reg.Get(id); p == nil || p.ID != id {
+				t.Errorf("Get(%d) returned %v", id, p)
+			}
+			if reg.IndexOf(id) != int32(i) {
+				t.Errorf("IndexOf(%d) = %d, want %d", id, reg.IndexOf(id), i)
+			}
+		}
+		for _, id := range []uint32{0, 8, 0xBEEE, 0xFFFFFFFF} {
+			if reg.Get(id) != nil {
+				t.Errorf("Get(%d) should return nil", id)
+			}
+		}
+	})
+
+	t.Run("RejectsAdd", func(t *testing.T) {
+		reg := NewRegistry()
+		reg.Add(New(0, "Gain").Build())
+		reg.Seal()
+
+		if err := reg.Add(New(1, "Mix").Build()); !errors.Is(err, ErrRegistrySealed) {
+			t.Errorf("Expected ErrRegistrySealed, got %v", err)
+		}
+		if reg.Count() != 1 {
+			t.Errorf("Sealed registry should not grow, got %d", reg.Count())
+		}
+
+		auto := NewAutoRegistry()
+		auto.Register(BypassParameter(0, "Bypass").Build())
+		auto.Seal()
+		if err := auto.Register(GainParameter(0, "Volume").Build()); !errors.Is(err, ErrRegistrySealed) {
+			t.Errorf("Expected ErrRegistrySealed from AutoRegistry, got %v", err)
+		}
+	})
+}
+
+func TestRegistrySnapshot(t *testing.T) {
+	reg := NewRegistry()
+	reg.Add(
+		New(10, "A").Default(0.25).Build(),
+		New(20, "B").Default(0.5).Build(),
+		New(30, "C").Default(1).Build(),
+	)
+	reg.Seal()
+
+	values := reg.Snapshot(nil)
+	want := []float64{0.25, 0.5, 1}
+	if len(values) != len(want) {
+		t.Fatalf("Expected %d values, got %d", len(want), len(values))
+	}
+	for i := range want {
+		if values[i] != want[i] {
+			t.Errorf("Value %d: got %f, want %f", i, values[i], want[i])
+		}
+	}
+
+	reg.Get(20).SetValue(0.75)
+	allocs := testing.AllocsPerRun(100, func() {
+		values = reg.Snapshot(values)
+		_ = reg.Get(30)
+	})
+	if allocs != 0 {
+		t.Errorf("Sealed Snapshot/Get allocated %.1f times", allocs)
+	}
+	if values[reg.IndexOf(20)] != 0.75 {
+		t.Errorf("Snapshot missed update, got %f", values[1])
+	}
+}
+
+func BenchmarkRegistryGet(b *testing.B) {
+	reg := NewRegistry()
+	for id := uint32(0); id < 32; id++ {
+		reg.Add(New(id, "Param").Build())
+	}
+
+	b.Run("Locked", func(b *testing.B) {
+		for i := 0; i < b.N; i++ {
+			_ = reg.Get(uint32(i) & 31)
+		}
+	})
+
+	reg.Seal()
+	b.Run("Sealed", func(b *testing.B) {
+		for i := 0; i < b.N; i++ {
+			_ = reg.Get(uint32(i) & 31)
+		}
+	})
+}
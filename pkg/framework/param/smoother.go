@@ -25,6 +25,7 @@ type Smoother struct {
 	rate          float64
 	threshold     float64
 	isSmoothing   bool
+	ramping       bool // Fixed-length ramp from RampTo, always linear
 	
 	// For linear smoothing
 	step float64
@@ -53,6 +54,7 @@ func (s *Smoother) SetTarget(target float64) {
 	
 	s.target = target
 	s.isSmoothing = true
+	s.ramping = false
 	
 	switch s.smoothingType {
 	case LinearSmoothing:
@@ -83,13 +85,46 @@ func (s *Smoother) SetTarget(target float64) {
 	}
 }
 
+// RampTo moves toward target so that it is reached after exactly the given
+// number of samples, regardless of the configured rate. Exponential smoothers
+// ramp linearly; logarithmic smoothers ramp in log space. Used to follow host
+// automation curves without splitting the processing block.
+func (s *Smoother) RampTo(target float64, samples int) {
+	if samples <= 0 || target == s.current {
+		s.Reset(target)
+		return
+	}
+
+	s.target = target
+	s.isSmoothing = true
+	s.ramping = true
+
+	if s.smoothingType == LogarithmicSmoothing {
+		const minVal = 0.001
+		currentVal := math.Max(s.current, minVal)
+		targetVal := math.Max(target, minVal)
+
+		s.logCurrent = math.Log(currentVal)
+		s.logTarget = math.Log(targetVal)
+		s.logStep = (s.logTarget - s.logCurrent) / float64(samples)
+		return
+	}
+
+	s.step = (target - s.current) / float64(samples)
+}
+
 // Next returns the next smoothed value.
 func (s *Smoother) Next() float64 {
 	if !s.isSmoothing {
 		return s.current
 	}
 	
-	switch s.smoothingType {
+	smoothingType := s.smoothingType
+	if s.ramping && smoothingType == ExponentialSmoothing {
+		smoothingType = LinearSmoothing
+	}
+	
+	switch smoothingType {
 	case ExponentialSmoothing:
 		// One-pole filter: y = y + a * (x - y)
 		s.current += (s.target - s.current) * (1.0 - s.rate)
@@ -145,6 +180,7 @@ func (s *Smoother) Reset(value float64) {
 	s.current = value
 	s.target = value
 	s.isSmoothing = false
+	s.ramping = false
 }
 
 // SetRate updates the smoothing rate.
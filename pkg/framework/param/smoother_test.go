@@ -305,4 +305,27 @@ func BenchmarkSmoother(b *testing.B) {
 			})
 		}
 	})
-}
\ No newline at end of file
+}
+
+func TestSmootherRampTo(t *testing.T) {
+	// Exponential smoothers follow a fixed-length linear ramp
+	smoother := NewSmoother(ExponentialSmoothing, 0.999)
+	smoother.Reset(0.0)
+	smoother.RampTo(1.0, 4)
+
+	for i := 0; i < 4; i++ {
+		expected := float64(i+1) * 0.25
+		if value := smoother.Next(); math.Abs(value-expected) > 1e-9 {
+			t.Errorf("Sample %d: expected %f, got %f", i, expected, value)
+		}
+	}
+	if smoother.IsSmoothing() {
+		t.Error("Ramp should finish after the requested number of samples")
+	}
+
+	// A zero-length ramp jumps straight to the target
+	smoother.RampTo(0.5, 0)
+	if smoother.Next() != 0.5 || smoother.IsSmoothing() {
+		t.Error("Zero-length ramp should jump to target")
+	}
+}
@@ -0,0 +1,226 @@
+package process
+
+import (
+	"unsafe"
+
+	"github.com/justyntemme/vst3go/pkg/framework/bus"
+)
+
+// DefaultArenaChannels is the number of scratch channels an arena holds when
+// no bus configuration is known
+const DefaultArenaChannels = 8
+
+// arenaAlignment is the byte alignment of every scratch channel (one cache line)
+const arenaAlignment = 64
+
+// Arena is a per-instance pool of scratch channel buffers for the audio
+// thread. All memory is allocated up front from the maximum block size; the
+// arena is rewound before every render, so buffers handed out during one
+// block are reused by the next. Each channel starts on a cache-line boundary.
+// Contents are not cleared on reuse. The arena never allocates once built: a
+// request beyond its capacity returns nil and is counted as an overflow.
+//
+// Build with the 'debug' tag to record high-water marks (see Usage) for
+// sizing the arena.
+type Arena struct {
+	maxBlockSize int
+	channels     int // float32 channels
+	channels64   int // float64 channels, zero unless 64-bit processing is offered
+
+	data32   []float32 // channels contiguous strides of float32
+	data64   []float64 // channels contiguous strides of float64
+	stride32 int
+	stride64 int
+
+	// Reusable channel-slice headers for Channels/Channels64
+	headers32 [][]float32
+	headers64 [][]float64
+
+	next32    int // Next free float32 channel
+	next64    int // Next free float64 channel
+	overflows int // Requests refused since creation
+
+	usage arenaUsage
+}
+
+// ArenaUsage reports how much of an arena processing actually used
+type ArenaUsage struct {
+	Channels    int // Capacity in float32 channels
+	Channels64  int // Capacity in float64 channels
+	HighWater   int // Most float32 channels handed out in one render
+	HighWater64 int // Most float64 channels handed out in one render
+	Overflows   int // Requests beyond capacity, each of which returned nil
+}
+
+// NewArena creates an arena of channels float32 and channels64 float64
+// scratch buffers, each maxBlockSize samples long. Pass zero channels64 for
+// processors that only render 32-bit audio.
+func NewArena(maxBlockSize, channels, channels64 int) *Arena {
+	if channels < 0 {
+		channels = 0
+	}
+	if channels64 < 0 {
+		channels64 = 0
+	}
+	if maxBlockSize < 1 {
+		maxBlockSize = 1
+	}
+
+	a := &Arena{
+		maxBlockSize: maxBlockSize,
+		channels:     channels,
+		channels64:   channels64,
+		stride32:     alignUp(maxBlockSize, arenaAlignment/4),
+		stride64:     alignUp(maxBlockSize, arenaAlignment/8),
+	}
+	if channels > 0 {
+		a.data32 = alignedSlice[float32](a.stride32 * channels)
+		a.headers32 = make([][]float32, channels)
+	}
+	if channels64 > 0 {
+		a.data64 = alignedSlice[float64](a.stride64 * channels64)
+		a.headers64 = make([][]float64, channels64)
+	}
+	return a
+}
+
+// ArenaChannelsFor sizes an arena for a bus configuration: enough scratch
+// channels to hold a copy of every input and output channel twice over,
+// and never fewer than DefaultArenaChannels. Inactive buses are counted too,
+// since hosts may activate a sidechain after the arena is created.
+func ArenaChannelsFor(buses *bus.Configuration) int {
+	if buses == nil {
+		return DefaultArenaChannels
+	}
+
+	channels := 0
+	for _, direction := range []bus.Direction{bus.DirectionInput, bus.DirectionOutput} {
+		count := buses.GetBusCount(bus.MediaTypeAudio, direction)
+		for i := int32(0); i < count; i++ {
+			if info := buses.GetBusInfo(bus.MediaTypeAudio, direction, i); info != nil {
+				channels += 2 * int(info.ChannelCount)
+			}
+		}
+	}
+	if channels < DefaultArenaChannels {
+		channels = DefaultArenaChannels
+	}
+	return channels
+}
+
+// Reset returns every buffer to the arena. Called before each render.
+func (a *Arena) Reset() {
+	a.usage.observe(a.next32, a.next64)
+	a.next32 = 0
+	a.next64 = 0
+}
+
+// Buffer returns a scratch buffer of length samples, or nil when the arena
+// is exhausted (counted as an overflow)
+func (a *Arena) Buffer(length int) []float32 {
+	length = a.clampLength(length)
+	if a.next32 == a.channels {
+		a.overflows++
+		return nil
+	}
+	start := a.next32 * a.stride32
+	a.next32++
+	return a.data32[start : start+length : start+length]
+}
+
+// Buffer64 returns a double-precision scratch buffer of length samples, or
+// nil when the arena is exhausted or holds no float64 channels
+func (a *Arena) Buffer64(length int) []float64 {
+	length = a.clampLength(length)
+	if a.next64 == a.channels64 {
+		a.overflows++
+		return nil
+	}
+	start := a.next64 * a.stride64
+	a.next64++
+	return a.data64[start : start+length : start+length]
+}
+
+// Channels returns numChannels scratch buffers of length samples as a
+// channel set, in the same layout as Context.Input/Output, or nil when
+// fewer than numChannels are left
+func (a *Arena) Channels(numChannels, length int) [][]float32 {
+	if numChannels < 0 || a.channels-a.next32 < numChannels {
+		a.overflows++
+		return nil
+	}
+	// Headers are indexed by first channel, so sets never overlap
+	first := a.next32
+	channels := a.headers32[first : first+numChannels : first+numChannels]
+	for ch := range channels {
+		channels[ch] = a.Buffer(length)
+	}
+	return channels
+}
+
+// Channels64 returns numChannels double-precision scratch buffers, or nil
+// when fewer than numChannels are left
+func (a *Arena) Channels64(numChannels, length int) [][]float64 {
+	if numChannels < 0 || a.channels64-a.next64 < numChannels {
+		a.overflows++
+		return nil
+	}
+	first := a.next64
+	channels := a.headers64[first : first+numChannels : first+numChannels]
+	for ch := range channels {
+		channels[ch] = a.Buffer64(length)
+	}
+	return channels
+}
+
+// Capacity returns the number of float32 scratch channels
+func (a *Arena) Capacity() int {
+	return a.channels
+}
+
+// Capacity64 returns the number of float64 scratch channels
+func (a *Arena) Capacity64() int {
+	return a.channels64
+}
+
+// MaxBlockSize returns the length of every scratch channel
+func (a *Arena) MaxBlockSize() int {
+	return a.maxBlockSize
+}
+
+// Usage reports capacity, overflows and, in debug builds, high-water marks.
+// Read it from the audio thread or while processing is stopped.
+func (a *Arena) Usage() ArenaUsage {
+	usage := ArenaUsage{Channels: a.channels, Channels64: a.channels64, Overflows: a.overflows}
+	a.usage.report(&usage, a.next32, a.next64)
+	return usage
+}
+
+func (a *Arena) clampLength(length int) int {
+	if length < 0 {
+		return 0
+	}
+	if length > a.maxBlockSize {
+		return a.maxBlockSize
+	}
+	return length
+}
+
+// alignUp rounds n up to a multiple of align
+func alignUp(n, align int) int {
+	return (n + align - 1) / align * align
+}
+
+// alignedSlice allocates n elements starting on an arenaAlignment boundary
+func alignedSlice[T float32 | float64](n int) []T {
+	var zero T
+	size := int(unsafe.Sizeof(zero))
+	padding := arenaAlignment / size
+	buffer := make([]T, n+padding)
+
+	offset := 0
+	if misalign := int(uintptr(unsafe.Pointer(&buffer[0])) % arenaAlignment); misalign != 0 {
+		offset = (arenaAlignment - misalign) / size
+	}
+	return buffer[offset : offset+n : offset+n]
+}
@@ -0,0 +1,25 @@
+//go:build debug
+// +build debug
+
+package process
+
+// arenaUsage records the most channels an arena handed out in one render
+type arenaUsage struct {
+	highWater   int
+	highWater64 int
+}
+
+func (u *arenaUsage) observe(used32, used64 int) {
+	if used32 > u.highWater {
+		u.highWater = used32
+	}
+	if used64 > u.highWater64 {
+		u.highWater64 = used64
+	}
+}
+
+func (u *arenaUsage) report(usage *ArenaUsage, used32, used64 int) {
+	u.observe(used32, used64)
+	usage.HighWater = u.highWater
+	usage.HighWater64 = u.highWater64
+}
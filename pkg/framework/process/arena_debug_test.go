@@ -0,0 +1,20 @@
+//go:build debug
+// +build debug
+
+package process
+
+import "testing"
+
+func TestArenaHighWater(t *testing.T) {
+	arena := NewArena(64, 8, 8)
+
+	arena.Channels(3, 64)
+	arena.Buffer64(64)
+	arena.Reset()
+	arena.Buffer(64)
+
+	usage := arena.Usage()
+	if usage.HighWater != 3 || usage.HighWater64 != 1 {
+		t.Errorf("Unexpected high-water marks %d/%d", usage.HighWater, usage.HighWater64)
+	}
+}
@@ -0,0 +1,11 @@
+//go:build !debug
+// +build !debug
+
+package process
+
+// arenaUsage is a no-op when not in debug mode
+type arenaUsage struct{}
+
+func (u *arenaUsage) observe(used32, used64 int) {}
+
+func (u *arenaUsage) report(usage *ArenaUsage, used32, used64 int) {}
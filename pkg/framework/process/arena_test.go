@@ -0,0 +1,100 @@
+package process
+
+import (
+	"testing"
+	"unsafe"
+
+	"github.com/justyntemme/vst3go/pkg/framework/bus"
+)
+
+func TestArenaBuffers(t *testing.T) {
+	arena := NewArena(100, 4, 0)
+
+	a := arena.Buffer(64)
+	first := &a[0]
+	b := arena.Buffer(100)
+	if len(a) != 64 || len(b) != 100 {
+		t.Fatalf("Unexpected lengths %d/%d", len(a), len(b))
+	}
+	for _, buf := range [][]float32{a, b} {
+		if uintptr(unsafe.Pointer(&buf[0]))%arenaAlignment != 0 {
+			t.Error("Scratch buffer is not cache-line aligned")
+		}
+	}
+
+	// Buffers must not overlap, and appending must not spill into a neighbour
+	for i := range b {
+		b[i] = 1
+	}
+	a = append(a, 2)
+	if b[0] != 1 {
+		t.Error("Appending to a scratch buffer overwrote its neighbour")
+	}
+
+	channels := arena.Channels(2, 32)
+	if len(channels) != 2 || len(channels[1]) != 32 {
+		t.Fatalf("Unexpected channel set %d x %d", len(channels), len(channels[1]))
+	}
+	if arena.Usage().Overflows != 0 {
+		t.Errorf("Expected no overflows, got %d", arena.Usage().Overflows)
+	}
+
+	// Exhausted arenas refuse instead of allocating on the audio thread
+	allocs := testing.AllocsPerRun(10, func() {
+		if arena.Buffer(16) != nil || arena.Channels(2, 16) != nil {
+			t.Error("Overflow should return nil")
+		}
+	})
+	if allocs != 0 {
+		t.Errorf("Overflow allocated %.1f times", allocs)
+	}
+	if arena.Usage().Overflows == 0 {
+		t.Error("Overflows should be counted")
+	}
+
+	// Without double-precision channels the arena holds no float64 memory
+	if arena.data64 != nil || arena.Buffer64(16) != nil {
+		t.Error("32-bit-only arena should not provide float64 buffers")
+	}
+
+	// Reset reuses the same memory
+	arena.Reset()
+	if again := arena.Buffer(100); &again[0] != first {
+		t.Error("Reset should rewind to the first scratch channel")
+	}
+}
+
+func TestArenaChannelsFor(t *testing.T) {
+	if got := ArenaChannelsFor(nil); got != DefaultArenaChannels {
+		t.Errorf("Expected default for nil buses, got %d", got)
+	}
+
+	buses := bus.NewBuilder().WithQuadInput("In").WithQuadOutput("Out").WithSidechain("SC").MustBuild()
+	if got := ArenaChannelsFor(buses); got != 2*(4+2+4) {
+		t.Errorf("Expected arena sized from buses, got %d", got)
+	}
+}
+
+func TestContextScratchZeroAllocations(t *testing.T) {
+	ctx := newAutomationContext(256)
+	if ctx.Scratch().Capacity() != 0 || ctx.Scratch().Capacity64() != 0 {
+		t.Error("NewContext should leave sizing the arena to ReserveScratch")
+	}
+	ctx.ReserveScratch(6, 2)
+
+	allocs := testing.AllocsPerRun(100, func() {
+		ctx.Scratch().Reset()
+		mix := ctx.ScratchChannels(2)
+		side := ctx.ScratchBuffer()
+		wide := ctx.ScratchChannels64(2)
+		copy(mix[0], ctx.Input[0])
+		side[0] = float32(wide[1][0])
+	})
+
+	if allocs != 0 {
+		t.Errorf("Scratch arena allocated %.1f times per block", allocs)
+	}
+	if len(ctx.ScratchBuffer()) != 256 {
+		t.Error("Scratch buffers should be sized to the block")
+	}
+}
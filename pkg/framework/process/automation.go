@@ -0,0 +1,227 @@
+package process
+
+import (
+	"github.com/justyntemme/vst3go/pkg/framework/debug"
+	"github.com/justyntemme/vst3go/pkg/framework/param"
+	"github.com/justyntemme/vst3go/pkg/framework/state"
+)
+
+// DefaultMinChunkSize is the default smallest chunk sample-accurate
+// automation splits a block into. Changes landing closer than this to the
+// current chunk start are applied at that start instead of opening a new chunk.
+const DefaultMinChunkSize = 16
+
+// maxChunkChannels is the channel-slice header capacity reserved per direction
+const maxChunkChannels = 16
+
+// paramRamp routes a parameter's automation into a smoother
+type paramRamp struct {
+	id       uint32
+	smoother *param.Smoother
+}
+
+// SetMinChunkSize sets the smallest chunk automation may split a block into.
+// A value of 1 splits at every distinct offset; only changes on the same
+// sample are merged.
+func (c *Context) SetMinChunkSize(samples int) {
+	if samples < 1 {
+		samples = 1
+	}
+	c.minChunkSize = samples
+}
+
+// MinChunkSize returns the smallest chunk automation may split a block into
+func (c *Context) MinChunkSize() int {
+	return c.minChunkSize
+}
+
+// SetParamSmoother routes automation for a parameter into a smoother instead
+// of splitting the block. Each block the smoother ramps (in plain units) to
+// the last automation point, arriving exactly at its sample offset. Passing
+// nil restores block splitting for the parameter. Call from the control thread.
+func (c *Context) SetParamSmoother(id uint32, smoother *param.Smoother) {
+	for i := range c.ramps {
+		if c.ramps[i].id != id {
+			continue
+		}
+		if smoother == nil {
+			c.ramps = append(c.ramps[:i], c.ramps[i+1:]...)
+		} else {
+			c.ramps[i].smoother = smoother
+		}
+		return
+	}
+	if smoother != nil {
+		c.ramps = append(c.ramps, paramRamp{id: id, smoother: smoother})
+	}
+}
+
+// SetStateRamp sets how many samples parameters with a smoother glide over
+// when a loaded state is applied, so a program change during playback
+// crossfades the settings instead of jumping. Other parameters, and all of
+// them when samples is 0 (the default), step at the block boundary.
+func (c *Context) SetStateRamp(samples int) {
+	if samples < 0 {
+		samples = 0
+	}
+	c.stateRamp = samples
+}
+
+// StateRamp returns the glide length set by SetStateRamp
+func (c *Context) StateRamp() int {
+	return c.stateRamp
+}
+
+// ApplyState applies a decoded state before the block renders - no
+// allocations. Call it on the audio thread at a block boundary; host
+// automation of the same block still applies on top of it.
+func (c *Context) ApplyState(snapshot *state.Snapshot) {
+	for i := 0; i < snapshot.Len(); i++ {
+		id, value := snapshot.At(i)
+		p := c.params.Get(id)
+		if p == nil {
+			continue
+		}
+		p.SetValue(value)
+		if smoother := c.paramSmoother(id); smoother != nil {
+			smoother.RampTo(p.GetPlainValue(), c.stateRamp)
+		}
+	}
+}
+
+// ChunkOffset returns the sample offset of the current chunk within the host
+// block, or 0 when the whole block is being processed
+func (c *Context) ChunkOffset() int {
+	return c.chunkOffset
+}
+
+// ProcessChunked renders the current block with sample-accurate automation.
+// The parameter changes must be sorted. Step changes split the block into
+// chunks of at least MinChunkSize samples (the final chunk may be shorter);
+// Input/Output are narrowed to each chunk through reused slice headers, so
+// no allocation happens. Parameters with a smoother are ramped instead.
+func (c *Context) ProcessChunked(render func()) {
+	numSamples := c.NumSamples()
+	trace := debug.Enabled(debug.LogLevelDebug)
+
+	// Ramped parameters never split the block
+	steps := c.stepChanges[:0]
+	for _, change := range c.GetParameterChanges() {
+		if smoother := c.paramSmoother(change.ParamID); smoother != nil {
+			c.applyRamp(change, smoother, trace)
+			continue
+		}
+		steps = append(steps, change)
+	}
+	c.stepChanges = steps
+
+	c.blockInput, c.blockOutput = c.Input, c.Output
+	c.blockInput64, c.blockOutput64 = c.Input64, c.Output64
+
+	start := 0
+	i := 0
+	for i < len(steps) {
+		// Everything too close to the chunk start is merged into it
+		for i < len(steps) && steps[i].SampleOffset-start < c.minChunkSize {
+			c.applyStep(steps[i], start, trace)
+			i++
+		}
+		if i == len(steps) {
+			break
+		}
+
+		end := steps[i].SampleOffset
+		if end >= numSamples {
+			// Late points are applied before the tail chunk
+			for ; i < len(steps); i++ {
+				c.applyStep(steps[i], start, trace)
+			}
+			break
+		}
+
+		c.renderChunk(start, end, numSamples, render)
+		start = end
+	}
+	c.renderChunk(start, numSamples, numSamples, render)
+
+	c.Input, c.Output = c.blockInput, c.blockOutput
+	c.Input64, c.Output64 = c.blockInput64, c.blockOutput64
+	c.chunkOffset = 0
+}
+
+// renderChunk points the buffers at samples [start, end) and renders them
+func (c *Context) renderChunk(start, end, numSamples int, render func()) {
+	if end <= start {
+		return
+	}
+
+	if start == 0 && end == numSamples {
+		c.Input, c.Output = c.blockInput, c.blockOutput
+		c.Input64, c.Output64 = c.blockInput64, c.blockOutput64
+	} else {
+		c.chunkInput = sliceChannels(c.chunkInput[:0], c.blockInput, start, end)
+		c.chunkOutput = sliceChannels(c.chunkOutput[:0], c.blockOutput, start, end)
+		c.chunkInput64 = sliceChannels(c.chunkInput64[:0], c.blockInput64, start, end)
+		c.chunkOutput64 = sliceChannels(c.chunkOutput64[:0], c.blockOutput64, start, end)
+		c.Input, c.Output = c.chunkInput, c.chunkOutput
+		c.Input64, c.Output64 = c.chunkInput64, c.chunkOutput64
+	}
+
+	c.chunkOffset = start
+	render()
+}
+
+// applyStep applies a change at the start of the chunk it was merged into
+func (c *Context) applyStep(change ParameterChange, at int, trace bool) {
+	p := c.params.Get(change.ParamID)
+	if p == nil {
+		return
+	}
+	p.SetValue(change.Value)
+
+	if trace {
+		debug.Debug("[SAMPLE_ACCURATE] Applied param %d change at sample %d (requested %d): value=%.6f, plain=%.1f",
+			change.ParamID, at, change.SampleOffset, change.Value, p.GetPlainValue())
+	}
+}
+
+// applyRamp retargets a parameter's smoother to arrive at the change offset
+func (c *Context) applyRamp(change ParameterChange, smoother *param.Smoother, trace bool) {
+	p := c.params.Get(change.ParamID)
+	if p == nil {
+		return
+	}
+	p.SetValue(change.Value)
+	smoother.RampTo(p.GetPlainValue(), change.SampleOffset)
+
+	if trace {
+		debug.Debug("[SAMPLE_ACCURATE] Ramping param %d to plain=%.1f over %d samples",
+			change.ParamID, p.GetPlainValue(), change.SampleOffset)
+	}
+}
+
+// paramSmoother returns the smoother registered for a parameter, if any
+func (c *Context) paramSmoother(id uint32) *param.Smoother {
+	for i := range c.ramps {
+		if c.ramps[i].id == id {
+			return c.ramps[i].smoother
+		}
+	}
+	return nil
+}
+
+// sliceChannels appends sub-slices [start:end) of every channel to dst,
+// clamped to each channel's length
+func sliceChannels[T float32 | float64](dst, channels [][]T, start, end int) [][]T {
+	for _, channel := range channels {
+		if start >= len(channel) {
+			continue
+		}
+		if end > len(channel) {
+			dst = append(dst, channel[start:])
+		} else {
+			dst = append(dst, channel[start:end])
+		}
+	}
+	return dst
+}
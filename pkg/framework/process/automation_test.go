@@ -0,0 +1,139 @@
+package process
+
+import (
+	"math"
+	"testing"
+
+	"github.com/justyntemme/vst3go/pkg/framework/param"
+	"github.com/justyntemme/vst3go/pkg/framework/state"
+)
+
+func newAutomationContext(blockSize int) *Context {
+	registry := param.NewRegistry()
+	registry.Add(
+		param.New(0, "Gain").Range(0, 1).Default(0).Build(),
+		param.New(1, "Cutoff").Range(0, 100).Default(0).Build(),
+	)
+
+	ctx := NewContext(blockSize, registry)
+	ctx.Input = [][]float32{make([]float32, blockSize), make([]float32, blockSize)}
+	ctx.Output = [][]float32{make([]float32, blockSize), make([]float32, blockSize)}
+	return ctx
+}
+
+func TestProcessChunkedSplitsAndMerges(t *testing.T) {
+	ctx := newAutomationContext(256)
+	ctx.SetMinChunkSize(16)
+
+	// 100 and 104 merge, 250 lands in the tail chunk
+	ctx.AddParameterChange(0, 0.1, 0)
+	ctx.AddParameterChange(0, 0.2, 100)
+	ctx.AddParameterChange(0, 0.3, 104)
+	ctx.AddParameterChange(0, 0.4, 250)
+	ctx.SortParameterChanges()
+
+	type chunk struct {
+		offset, length int
+		value          float64
+	}
+	var chunks []chunk
+	ctx.ProcessChunked(func() {
+		if len(ctx.Input) != 2 || len(ctx.Output) != 2 {
+			t.Fatalf("Expected 2 channels per chunk, got %d/%d", len(ctx.Input), len(ctx.Output))
+		}
+		chunks = append(chunks, chunk{ctx.ChunkOffset(), ctx.NumSamples(), ctx.Param(0)})
+	})
+
+	want := []chunk{{0, 100, 0.1}, {100, 150, 0.3}, {250, 6, 0.4}}
+	if len(chunks) != len(want) {
+		t.Fatalf("Expected %d chunks, got %v", len(want), chunks)
+	}
+	for i := range want {
+		if chunks[i] != want[i] {
+			t.Errorf("Chunk %d: got %+v, want %+v", i, chunks[i], want[i])
+		}
+	}
+
+	// Full-block views are restored afterwards
+	if ctx.NumSamples() != 256 || ctx.ChunkOffset() != 0 {
+		t.Errorf("Block not restored: %d samples at offset %d", ctx.NumSamples(), ctx.ChunkOffset())
+	}
+}
+
+func TestProcessChunkedRampsSmoothedParams(t *testing.T) {
+	ctx := newAutomationContext(128)
+	smoother := param.NewSmoother(param.ExponentialSmoothing, 0.99)
+	ctx.SetParamSmoother(1, smoother)
+
+	// Dense automation on a ramped parameter must not split the block
+	for offset := 0; offset < 128; offset += 4 {
+		ctx.AddParameterChange(1, float64(offset)/128, offset)
+	}
+	ctx.SortParameterChanges()
+
+	renders := 0
+	ctx.ProcessChunked(func() {
+		renders++
+		for i := 0; i < ctx.NumSamples(); i++ {
+			smoother.Next()
+		}
+	})
+
+	if renders != 1 {
+		t.Errorf("Expected a single render for ramped automation, got %d", renders)
+	}
+
+	// Last point is 124/128 normalized on a 0-100 range, reached at sample 124
+	want := 124.0 / 128 * 100
+	if got := smoother.Next(); math.Abs(got-want) > 1e-9 {
+		t.Errorf("Smoother should reach the last point, got %f want %f", got, want)
+	}
+}
+
+func TestApplyStateRampsSmoothedParams(t *testing.T) {
+	ctx := newAutomationContext(128)
+	smoother := param.NewSmoother(param.ExponentialSmoothing, 0.99)
+	ctx.SetParamSmoother(1, smoother)
+	ctx.SetStateRamp(64)
+
+	// A preset with both parameters moved
+	preset := newAutomationContext(128)
+	preset.params.Get(0).SetValue(0.8)
+	preset.params.Get(1).SetValue(0.5)
+	ctx.ApplyState(state.Capture(preset.params, nil))
+
+	if got := ctx.Param(0); got != 0.8 {
+		t.Errorf("Unsmoothed parameter should step to 0.8, got %f", got)
+	}
+	// The smoothed parameter glides to 50 over the ramp
+	for i := 0; i < 31; i++ {
+		smoother.Next()
+	}
+	if got := smoother.Next(); math.Abs(got-25) > 1e-9 {
+		t.Errorf("Halfway through the ramp expected 25, got %f", got)
+	}
+	for i := 0; i < 32; i++ {
+		smoother.Next()
+	}
+	if got := smoother.Next(); got != 50 {
+		t.Errorf("Ramp should end at 50, got %f", got)
+	}
+}
+
+func TestProcessChunkedZeroAllocations(t *testing.T) {
+	ctx := newAutomationContext(512)
+	render := func() {}
+
+	allocs := testing.AllocsPerRun(100, func() {
+		ctx.ResetParameterChanges()
+		for offset := 480; offset >= 0; offset -= 8 {
+			ctx.AddParameterChange(0, float64(offset)/512, offset)
+		}
+		ctx.SortParameterChanges()
+		ctx.ProcessChunked(render)
+	})
+
+	if allocs != 0 {
+		t.Errorf("ProcessChunked allocated %.1f times per block", allocs)
+	}
+}
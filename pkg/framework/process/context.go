@@ -3,12 +3,15 @@ package process
 
 import (
 	"fmt"
-	"sort"
 
 	"github.com/justyntemme/vst3go/pkg/framework/param"
 	"github.com/justyntemme/vst3go/pkg/midi"
 )
 
+// MaxParameterChanges is the number of automation points a context holds per
+// block; further points are dropped
+const MaxParameterChanges = 512
+
 // ParameterChange represents a parameter change at a specific sample offset
 type ParameterChange struct {
 	ParamID      uint32
@@ -111,9 +114,15 @@ type Context struct {
 	Output     [][]float32
 	SampleRate float64
 
+	// Double-precision views of the host buffers, populated instead of
+	// Input/Output when the host processes in kSample64 mode
+	Input64  [][]float64
+	Output64 [][]float64
+
 	// Pre-allocated work buffers
 	workBuffer []float32
 	tempBuffer []float32
+	scratch    *Arena
 
 	// Parameter access
 	params *param.Registry
@@ -121,24 +130,55 @@ type Context struct {
 	// Sample-accurate automation
 	paramChanges []ParameterChange // Pre-allocated slice for parameter changes
 	changeCount  int               // Number of active parameter changes
+	stepChanges  []ParameterChange // Changes that split the block (not ramped)
+	ramps        []paramRamp       // Parameters followed by a smoother instead of splitting
+	minChunkSize int               // Changes closer than this share a chunk boundary
+	chunkOffset  int               // Start of the current chunk within the block
+	stateRamp    int               // Samples smoothed parameters glide over when a state loads
+
+	// Full-block views saved while a chunk is selected, and reusable
+	// channel-slice headers for the chunk views
+	blockInput    [][]float32
+	blockOutput   [][]float32
+	blockInput64  [][]float64
+	blockOutput64 [][]float64
+	chunkInput    [][]float32
+	chunkOutput   [][]float32
+	chunkInput64  [][]float64
+	chunkOutput64 [][]float64
 
 	// Transport and timing information
 	Transport *TransportInfo
 
 	// MIDI event processing
-	eventBuffer *midi.EventBuffer
+	eventBuffer      *midi.EventBuffer
+	controllerEvents *midi.EventRing // UI/controller thread -> audio thread, owned by the component
+
+	// Silence tracking for skipping blocks
+	silence *Silence
+
+	// Bus structure of the block, set by NewMultiBusContext
+	buses *MultiBusContext
 }
 
 // NewContext creates a new process context with pre-allocated buffers
 func NewContext(maxBlockSize int, params *param.Registry) *Context {
 	return &Context{
-		workBuffer:   make([]float32, maxBlockSize),
-		tempBuffer:   make([]float32, maxBlockSize),
-		params:       params,
-		paramChanges: make([]ParameterChange, 128), // Pre-allocate space for parameter changes
-		changeCount:  0,
-		Transport:    &TransportInfo{}, // Initialize transport info
-		eventBuffer:  midi.NewEventBuffer(),
+		workBuffer:    make([]float32, maxBlockSize),
+		tempBuffer:    make([]float32, maxBlockSize),
+		scratch:       NewArena(maxBlockSize, 0, 0), // Sized by ReserveScratch
+		params:        params,
+		paramChanges:  make([]ParameterChange, MaxParameterChanges), // Pre-allocate space for parameter changes
+		changeCount:   0,
+		stepChanges:   make([]ParameterChange, 0, MaxParameterChanges),
+		minChunkSize:  DefaultMinChunkSize,
+		chunkInput:    make([][]float32, 0, maxChunkChannels),
+		chunkOutput:   make([][]float32, 0, maxChunkChannels),
+		chunkInput64:  make([][]float64, 0, maxChunkChannels),
+		chunkOutput64: make([][]float64, 0, maxChunkChannels),
+		Transport:     &TransportInfo{}, // Initialize transport info
+		eventBuffer:   midi.NewEventBuffer(),
+		silence:       newSilence(),
 	}
 }
 
@@ -166,9 +206,20 @@ func (c *Context) NumSamples() int {
 	if len(c.Output) > 0 && len(c.Output[0]) > 0 {
 		return len(c.Output[0])
 	}
+	if len(c.Input64) > 0 && len(c.Input64[0]) > 0 {
+		return len(c.Input64[0])
+	}
+	if len(c.Output64) > 0 && len(c.Output64[0]) > 0 {
+		return len(c.Output64[0])
+	}
 	return 0
 }
 
+// Is64Bit returns true if the current block carries double-precision buffers
+func (c *Context) Is64Bit() bool {
+	return len(c.Input64) > 0 || len(c.Output64) > 0
+}
+
 // NumInputChannels returns the number of input channels
 func (c *Context) NumInputChannels() int {
 	return len(c.Input)
@@ -191,6 +242,57 @@ func (c *Context) TempBuffer() []float32 {
 	return c.tempBuffer[:c.NumSamples()]
 }
 
+// Scratch returns the context's scratch-buffer arena
+func (c *Context) Scratch() *Arena {
+	return c.scratch
+}
+
+// ReserveScratch resizes the scratch arena to hold channels float32 and
+// channels64 float64 buffers. It allocates, so call it at setup time (for
+// example from ConfigureContext), never from the audio thread. Until it is
+// called the arena is empty.
+func (c *Context) ReserveScratch(channels, channels64 int) {
+	if channels != c.scratch.Capacity() || channels64 != c.scratch.Capacity64() {
+		c.scratch = NewArena(c.scratch.MaxBlockSize(), channels, channels64)
+	}
+}
+
+// ScratchBuffer returns a scratch buffer sized to the current block from the
+// arena. Buffers are reused for every block, so don't keep them across calls.
+// It returns nil once the arena is exhausted.
+func (c *Context) ScratchBuffer() []float32 {
+	return c.scratch.Buffer(c.NumSamples())
+}
+
+// ScratchBuffer64 returns a double-precision scratch buffer sized to the
+// current block
+func (c *Context) ScratchBuffer64() []float64 {
+	return c.scratch.Buffer64(c.NumSamples())
+}
+
+// ScratchChannels returns numChannels scratch buffers sized to the current block
+func (c *Context) ScratchChannels(numChannels int) [][]float32 {
+	return c.scratch.Channels(numChannels, c.NumSamples())
+}
+
+// ScratchChannels64 returns numChannels double-precision scratch buffers
+// sized to the current block
+func (c *Context) ScratchChannels64(numChannels int) [][]float64 {
+	return c.scratch.Channels64(numChannels, c.NumSamples())
+}
+
+// Silence returns the silence tracker that decides when blocks are skipped
+func (c *Context) Silence() *Silence {
+	return c.silence
+}
+
+// Buses returns the bus structure of the current block, e.g. for the
+// sidechain input. It is nil until NewMultiBusContext attaches a bus
+// configuration; the framework always does for hosted processors.
+func (c *Context) Buses() *MultiBusContext {
+	return c.buses
+}
+
 // PassThrough copies input to output (for bypass)
 func (c *Context) PassThrough() {
 	numChannels := c.NumInputChannels()
@@ -201,6 +303,15 @@ func (c *Context) PassThrough() {
 	for ch := 0; ch < numChannels; ch++ {
 		copy(c.Output[ch], c.Input[ch])
 	}
+
+	numChannels = len(c.Input64)
+	if len(c.Output64) < numChannels {
+		numChannels = len(c.Output64)
+	}
+
+	for ch := 0; ch < numChannels; ch++ {
+		copy(c.Output64[ch], c.Input64[ch])
+	}
 }
 
 // Clear zeros the output buffers
@@ -210,6 +321,11 @@ func (c *Context) Clear() {
 			c.Output[ch][i] = 0
 		}
 	}
+	for ch := range c.Output64 {
+		for i := range c.Output64[ch] {
+			c.Output64[ch][i] = 0
+		}
+	}
 }
 
 // SetParameterAtOffset sets a parameter value at a specific sample offset within the current block
@@ -244,13 +360,19 @@ func (c *Context) ResetParameterChanges() {
 	c.changeCount = 0
 }
 
-// SortParameterChanges sorts parameter changes by sample offset for processing
+// SortParameterChanges sorts parameter changes by sample offset for processing.
+// Hosts deliver points per parameter already in order, so a stable insertion
+// sort is both allocation-free and close to linear here.
 func (c *Context) SortParameterChanges() {
-	if c.changeCount > 1 {
-		// Sort only the active portion of the slice
-		sort.Slice(c.paramChanges[:c.changeCount], func(i, j int) bool {
-			return c.paramChanges[i].SampleOffset < c.paramChanges[j].SampleOffset
-		})
+	changes := c.paramChanges[:c.changeCount]
+	for i := 1; i < len(changes); i++ {
+		change := changes[i]
+		j := i
+		for j > 0 && changes[j-1].SampleOffset > change.SampleOffset {
+			changes[j] = changes[j-1]
+			j--
+		}
+		changes[j] = change
 	}
 }
 
@@ -272,29 +394,70 @@ func (c *Context) ApplyParameterChange(change ParameterChange) {
 }
 
 // Event processing methods
+//
+// Input and output events live in fixed-capacity, value-typed stores; the
+// accessors below return zero-copy views that stay valid until the store is
+// next modified (usually the next block).
 
 // AddInputEvent adds a MIDI event to the input queue
 func (c *Context) AddInputEvent(event midi.Event) {
 	c.eventBuffer.AddInputEvent(event)
 }
 
+// AddInputRecord adds a value-typed MIDI event to the input queue without boxing
+func (c *Context) AddInputRecord(record midi.EventRecord) {
+	c.eventBuffer.Input().Add(record)
+}
+
 // AddOutputEvent adds a MIDI event to the output queue
 func (c *Context) AddOutputEvent(event midi.Event) {
 	c.eventBuffer.AddOutputEvent(event)
 }
 
+// AddOutputRecord adds a value-typed MIDI event to the output queue without boxing
+func (c *Context) AddOutputRecord(record midi.EventRecord) {
+	c.eventBuffer.Output().Add(record)
+}
+
+// SetControllerEvents attaches the queue PushControllerEvent feeds. The
+// owner keeps it across contexts, so events queued before the context is
+// recreated (setupProcessing) are still delivered.
+func (c *Context) SetControllerEvents(ring *midi.EventRing) {
+	c.controllerEvents = ring
+}
+
+// PushControllerEvent queues an event from the UI or controller thread for
+// the next processing block. Only one thread may push; returns false when
+// the queue is full or none is attached.
+func (c *Context) PushControllerEvent(record midi.EventRecord) bool {
+	return c.controllerEvents != nil && c.controllerEvents.Push(record)
+}
+
+// DrainControllerEvents moves queued controller events into the input
+// events at the start of the block. Called on the audio thread.
+func (c *Context) DrainControllerEvents() {
+	if c.controllerEvents != nil {
+		c.controllerEvents.DrainTo(c.eventBuffer.Input(), 0)
+	}
+}
+
+// InputEvents returns the input event store, e.g. to walk it with a cursor
+func (c *Context) InputEvents() *midi.EventStore {
+	return c.eventBuffer.Input()
+}
+
 // GetInputEvents returns input events in the specified sample range
-func (c *Context) GetInputEvents(startSample, endSample int32) []midi.Event {
+func (c *Context) GetInputEvents(startSample, endSample int32) []midi.EventRecord {
 	return c.eventBuffer.GetInputEvents(startSample, endSample)
 }
 
 // GetAllInputEvents returns all input events for the current block
-func (c *Context) GetAllInputEvents() []midi.Event {
-	return c.eventBuffer.GetInputEvents(0, int32(c.NumSamples()))
+func (c *Context) GetAllInputEvents() []midi.EventRecord {
+	return c.eventBuffer.Input().Records()
 }
 
 // GetOutputEvents returns all output events generated during processing
-func (c *Context) GetOutputEvents() []midi.Event {
+func (c *Context) GetOutputEvents() []midi.EventRecord {
 	return c.eventBuffer.GetOutputEvents()
 }
 
@@ -313,16 +476,13 @@ func (c *Context) ClearAllEvents() {
 	c.eventBuffer.ClearAll()
 }
 
-// ProcessEvents processes events through an event processor for sample-accurate processing
+// ProcessEvents processes events through an event processor for sample-accurate processing.
+// Events are passed as *midi.EventRecord so no allocation happens.
 func (c *Context) ProcessEvents(processor midi.EventProcessor, startSample, endSample int32) {
-	events := c.GetInputEvents(startSample, endSample)
-	for _, event := range events {
-		processor.ProcessEvent(event)
-	}
+	c.eventBuffer.Input().ProcessEvents(processor, startSample, endSample)
 }
 
 // HasInputEvents returns true if there are input events in the current block
 func (c *Context) HasInputEvents() bool {
-	events := c.GetAllInputEvents()
-	return len(events) > 0
+	return !c.eventBuffer.Input().IsEmpty()
 }
@@ -151,4 +151,32 @@ func TestContextClearAllEvents(t *testing.T) {
 	if len(ctx.GetOutputEvents()) != 0 {
 		t.Error("Expected no output events after ClearAllEvents")
 	}
-}
\ No newline at end of file
+}
+
+func TestContext64BitBuffers(t *testing.T) {
+	ctx := NewContext(512, param.NewRegistry())
+
+	ctx.Input64 = [][]float64{{0.25, -0.5, 1.0}}
+	ctx.Output64 = [][]float64{make([]float64, 3)}
+
+	if !ctx.Is64Bit() {
+		t.Fatal("Context with 64-bit buffers should report Is64Bit")
+	}
+	if ctx.NumSamples() != 3 {
+		t.Errorf("Expected 3 samples, got %d", ctx.NumSamples())
+	}
+
+	ctx.PassThrough()
+	for i, v := range ctx.Output64[0] {
+		if v != ctx.Input64[0][i] {
+			t.Errorf("PassThrough: Output64[0][%d] = %f, want %f", i, v, ctx.Input64[0][i])
+		}
+	}
+
+	ctx.Clear()
+	for i, v := range ctx.Output64[0] {
+		if v != 0 {
+			t.Errorf("Clear: Output64[0][%d] = %f, want 0", i, v)
+		}
+	}
+}
@@ -5,78 +5,188 @@ import (
 	"github.com/justyntemme/vst3go/pkg/framework/bus"
 )
 
-// BusBuffers represents audio buffers for a single bus
+// BusBuffers locates one audio bus within the current block. A bus's
+// channels are a contiguous range of the context's flat channel lists
+// (Input/Output, or Input64/Output64 in 64-bit mode), so they are never
+// copied and follow the chunk views of sample-accurate automation.
 type BusBuffers struct {
-	Channels [][]float32
-	BusInfo  *bus.Info
+	BusInfo *bus.Info
+
+	first int // Index of the bus's first channel in the flat list
+	count int // Mapped channels; 0 when inactive or not provided by the host
+}
+
+// Mapped reports whether the bus carries audio in the current block
+func (b *BusBuffers) Mapped() bool {
+	return b.count > 0
 }
 
-// MultiBusContext extends Context with multi-bus support
+// MultiBusContext extends Context with the bus structure of the block.
+//
+// The bridge fills it directly while mapping the host buffers: every active
+// bus in the processor's bus.Configuration gets its range of the flat
+// channel lists, and inactive buses are skipped entirely, so they take no
+// channels in Input/Output either. Get it from Context.Buses.
 type MultiBusContext struct {
 	*Context
-	
-	// Multi-bus audio buffers
+
+	// One entry per configured audio bus, in bus index order
 	InputBuses  []BusBuffers
 	OutputBuses []BusBuffers
-	
+
 	// Bus configuration
 	BusConfig *bus.Configuration
 }
 
-// NewMultiBusContext creates a new multi-bus process context
+// NewMultiBusContext attaches the bus layout of busConfig to ctx. The bus
+// entries and ctx's channel-slice headers are preallocated for every
+// configured channel, active or not, so mapping a block never allocates
+// even after the host activates a sidechain.
 func NewMultiBusContext(ctx *Context, busConfig *bus.Configuration) *MultiBusContext {
-	return &MultiBusContext{
-		Context:     ctx,
-		InputBuses:  make([]BusBuffers, 0),
-		OutputBuses: make([]BusBuffers, 0),
-		BusConfig:   busConfig,
+	m := &MultiBusContext{
+		Context:   ctx,
+		BusConfig: busConfig,
+	}
+	var inputChannels, outputChannels int
+	m.InputBuses, inputChannels = busLayout(busConfig, bus.DirectionInput)
+	m.OutputBuses, outputChannels = busLayout(busConfig, bus.DirectionOutput)
+
+	ctx.Input = make([][]float32, 0, inputChannels)
+	ctx.Output = make([][]float32, 0, outputChannels)
+	ctx.Input64 = make([][]float64, 0, inputChannels)
+	ctx.Output64 = make([][]float64, 0, outputChannels)
+	if inputChannels > cap(ctx.chunkInput) {
+		ctx.chunkInput = make([][]float32, 0, inputChannels)
+		ctx.chunkInput64 = make([][]float64, 0, inputChannels)
+	}
+	if outputChannels > cap(ctx.chunkOutput) {
+		ctx.chunkOutput = make([][]float32, 0, outputChannels)
+		ctx.chunkOutput64 = make([][]float64, 0, outputChannels)
 	}
+	ctx.buses = m
+	return m
 }
 
-// GetMainInput returns the main input bus buffers
-func (m *MultiBusContext) GetMainInput() [][]float32 {
-	for i, busBuffers := range m.InputBuses {
-		if busBuffers.BusInfo.BusType == bus.TypeMain {
-			return m.InputBuses[i].Channels
+func busLayout(config *bus.Configuration, direction bus.Direction) ([]BusBuffers, int) {
+	if config == nil {
+		return nil, 0
+	}
+	count := config.GetBusCount(bus.MediaTypeAudio, direction)
+	buses := make([]BusBuffers, count)
+	channels := 0
+	for i := range buses {
+		buses[i].BusInfo = config.GetBusInfo(bus.MediaTypeAudio, direction, int32(i))
+		channels += int(buses[i].BusInfo.ChannelCount)
+	}
+	return buses, channels
+}
+
+// InputActive reports whether host input bus index should be mapped: it is
+// configured and active
+func (m *MultiBusContext) InputActive(index int) bool {
+	return index < len(m.InputBuses) && m.InputBuses[index].BusInfo.IsActive
+}
+
+// OutputActive reports whether host output bus index should be mapped
+func (m *MultiBusContext) OutputActive(index int) bool {
+	return index < len(m.OutputBuses) && m.OutputBuses[index].BusInfo.IsActive
+}
+
+// ResetMapping unmaps every bus at the start of a block
+func (m *MultiBusContext) ResetMapping() {
+	for i := range m.InputBuses {
+		m.InputBuses[i].count = 0
+	}
+	for i := range m.OutputBuses {
+		m.OutputBuses[i].count = 0
+	}
+}
+
+// MapInput records that input bus index occupies count channels of the
+// flat input list starting at first. Called by the bridge.
+func (m *MultiBusContext) MapInput(index, first, count int) {
+	m.InputBuses[index].first = first
+	m.InputBuses[index].count = count
+}
+
+// MapOutput records the flat output channel range of output bus index
+func (m *MultiBusContext) MapOutput(index, first, count int) {
+	m.OutputBuses[index].first = first
+	m.OutputBuses[index].count = count
+}
+
+// busChannels returns a bus's view of a flat channel list, or nil
+func busChannels[T float32 | float64](channels [][]T, buses []BusBuffers, index int) [][]T {
+	if index < 0 || index >= len(buses) {
+		return nil
+	}
+	b := &buses[index]
+	if b.count == 0 || b.first+b.count > len(channels) {
+		return nil
+	}
+	return channels[b.first : b.first+b.count]
+}
+
+// findBus returns the index of the first mapped bus of the given type, or -1
+func findBus(buses []BusBuffers, busType bus.Type) int {
+	for i := range buses {
+		if buses[i].count > 0 && buses[i].BusInfo.BusType == busType {
+			return i
 		}
 	}
-	return nil
+	return -1
+}
+
+// GetMainInput returns the main input bus buffers
+func (m *MultiBusContext) GetMainInput() [][]float32 {
+	return busChannels(m.Input, m.InputBuses, findBus(m.InputBuses, bus.TypeMain))
 }
 
 // GetMainOutput returns the main output bus buffers
 func (m *MultiBusContext) GetMainOutput() [][]float32 {
-	for i, busBuffers := range m.OutputBuses {
-		if busBuffers.BusInfo.BusType == bus.TypeMain {
-			return m.OutputBuses[i].Channels
-		}
-	}
-	return nil
+	return busChannels(m.Output, m.OutputBuses, findBus(m.OutputBuses, bus.TypeMain))
 }
 
-// GetSidechainInput returns the sidechain (first aux) input if available
+// GetSidechainInput returns the sidechain (first active aux) input, or nil
+// when the host has not activated it
 func (m *MultiBusContext) GetSidechainInput() [][]float32 {
-	for i, busBuffers := range m.InputBuses {
-		if busBuffers.BusInfo.BusType == bus.TypeAux {
-			return m.InputBuses[i].Channels
-		}
-	}
-	return nil
+	return busChannels(m.Input, m.InputBuses, findBus(m.InputBuses, bus.TypeAux))
+}
+
+// GetMainInput64 returns the main input bus buffers in 64-bit mode
+func (m *MultiBusContext) GetMainInput64() [][]float64 {
+	return busChannels(m.Input64, m.InputBuses, findBus(m.InputBuses, bus.TypeMain))
+}
+
+// GetMainOutput64 returns the main output bus buffers in 64-bit mode
+func (m *MultiBusContext) GetMainOutput64() [][]float64 {
+	return busChannels(m.Output64, m.OutputBuses, findBus(m.OutputBuses, bus.TypeMain))
+}
+
+// GetSidechainInput64 returns the sidechain input in 64-bit mode, or nil
+func (m *MultiBusContext) GetSidechainInput64() [][]float64 {
+	return busChannels(m.Input64, m.InputBuses, findBus(m.InputBuses, bus.TypeAux))
 }
 
-// GetInputBus returns a specific input bus by index
+// GetInputBus returns a specific input bus by index, or nil when it is not
+// mapped in this block
 func (m *MultiBusContext) GetInputBus(index int) [][]float32 {
-	if index >= 0 && index < len(m.InputBuses) {
-		return m.InputBuses[index].Channels
-	}
-	return nil
+	return busChannels(m.Input, m.InputBuses, index)
 }
 
-// GetOutputBus returns a specific output bus by index
+// GetOutputBus returns a specific output bus by index, or nil
 func (m *MultiBusContext) GetOutputBus(index int) [][]float32 {
-	if index >= 0 && index < len(m.OutputBuses) {
-		return m.OutputBuses[index].Channels
-	}
-	return nil
+	return busChannels(m.Output, m.OutputBuses, index)
+}
+
+// GetInputBus64 returns a specific input bus in 64-bit mode, or nil
+func (m *MultiBusContext) GetInputBus64(index int) [][]float64 {
+	return busChannels(m.Input64, m.InputBuses, index)
+}
+
+// GetOutputBus64 returns a specific output bus in 64-bit mode, or nil
+func (m *MultiBusContext) GetOutputBus64(index int) [][]float64 {
+	return busChannels(m.Output64, m.OutputBuses, index)
 }
 
 // GetInputBusInfo returns information about a specific input bus
@@ -95,30 +205,30 @@ func (m *MultiBusContext) GetOutputBusInfo(index int) *bus.Info {
 	return nil
 }
 
-// NumInputBuses returns the number of input buses
+// NumInputBuses returns the number of configured input buses
 func (m *MultiBusContext) NumInputBuses() int {
 	return len(m.InputBuses)
 }
 
-// NumOutputBuses returns the number of output buses
+// NumOutputBuses returns the number of configured output buses
 func (m *MultiBusContext) NumOutputBuses() int {
 	return len(m.OutputBuses)
 }
 
-// ProcessInputBuses iterates through all active input buses
+// ProcessInputBuses iterates through the input buses mapped in this block
 func (m *MultiBusContext) ProcessInputBuses(fn func(busIndex int, channels [][]float32, info *bus.Info)) {
-	for i, bus := range m.InputBuses {
-		if bus.BusInfo.IsActive {
-			fn(i, bus.Channels, bus.BusInfo)
+	for i := range m.InputBuses {
+		if channels := m.GetInputBus(i); channels != nil {
+			fn(i, channels, m.InputBuses[i].BusInfo)
 		}
 	}
 }
 
-// ProcessOutputBuses iterates through all active output buses
+// ProcessOutputBuses iterates through the output buses mapped in this block
 func (m *MultiBusContext) ProcessOutputBuses(fn func(busIndex int, channels [][]float32, info *bus.Info)) {
-	for i, bus := range m.OutputBuses {
-		if bus.BusInfo.IsActive {
-			fn(i, bus.Channels, bus.BusInfo)
+	for i := range m.OutputBuses {
+		if channels := m.GetOutputBus(i); channels != nil {
+			fn(i, channels, m.OutputBuses[i].BusInfo)
 		}
 	}
 }
@@ -132,47 +242,35 @@ func (m *MultiBusContext) ProcessMainBuses(fn func(input, output [][]float32)) {
 	}
 }
 
-// ProcessWithSidechain processes main I/O with sidechain
+// ProcessWithSidechain processes main I/O with the sidechain, which is nil
+// when the host has not activated it
 func (m *MultiBusContext) ProcessWithSidechain(fn func(main, sidechain, output [][]float32)) {
 	mainIn := m.GetMainInput()
-	sidechain := m.GetSidechainInput()
 	mainOut := m.GetMainOutput()
-	
 	if mainIn != nil && mainOut != nil {
-		// If no sidechain, pass nil
-		fn(mainIn, sidechain, mainOut)
+		fn(mainIn, m.GetSidechainInput(), mainOut)
 	}
 }
 
-// ClearAllOutputs clears all output buses
+// ClearAllOutputs clears all mapped output buses
 func (m *MultiBusContext) ClearAllOutputs() {
-	for _, bus := range m.OutputBuses {
-		for ch := range bus.Channels {
-			for i := range bus.Channels[ch] {
-				bus.Channels[ch][i] = 0
-			}
-		}
-	}
+	m.Clear()
 }
 
-// PassThroughAll copies all inputs to corresponding outputs
+// PassThroughAll copies every mapped input bus to the output bus with the
+// same index
 func (m *MultiBusContext) PassThroughAll() {
-	minBuses := len(m.InputBuses)
-	if len(m.OutputBuses) < minBuses {
-		minBuses = len(m.OutputBuses)
-	}
-	
-	for busIdx := 0; busIdx < minBuses; busIdx++ {
-		inChannels := m.InputBuses[busIdx].Channels
-		outChannels := m.OutputBuses[busIdx].Channels
-		
-		minChannels := len(inChannels)
-		if len(outChannels) < minChannels {
-			minChannels = len(outChannels)
-		}
-		
-		for ch := 0; ch < minChannels; ch++ {
+	for busIdx := range m.InputBuses {
+		inChannels := m.GetInputBus(busIdx)
+		outChannels := m.GetOutputBus(busIdx)
+		for ch := 0; ch < len(inChannels) && ch < len(outChannels); ch++ {
 			copy(outChannels[ch], inChannels[ch])
 		}
+
+		in64 := m.GetInputBus64(busIdx)
+		out64 := m.GetOutputBus64(busIdx)
+		for ch := 0; ch < len(in64) && ch < len(out64); ch++ {
+			copy(out64[ch], in64[ch])
+		}
 	}
-}
\ No newline at end of file
+}
@@ -0,0 +1,122 @@
+package process
+
+import (
+	"testing"
+
+	"github.com/justyntemme/vst3go/pkg/framework/bus"
+	"github.com/justyntemme/vst3go/pkg/framework/param"
+)
+
+// mapBlock maps host buffers the way the bridge does: active buses only,
+// each recorded as a range of the flat lists
+func mapBlock(m *MultiBusContext, inputs, outputs [][][]float32) {
+	m.Input = m.Input[:0]
+	m.Output = m.Output[:0]
+	m.ResetMapping()
+	for i, channels := range inputs {
+		if m.InputActive(i) {
+			first := len(m.Input)
+			m.Input = append(m.Input, channels...)
+			m.MapInput(i, first, len(channels))
+		}
+	}
+	for i, channels := range outputs {
+		if m.OutputActive(i) {
+			first := len(m.Output)
+			m.Output = append(m.Output, channels...)
+			m.MapOutput(i, first, len(channels))
+		}
+	}
+}
+
+func stereo(n int, value float32) [][]float32 {
+	channels := [][]float32{make([]float32, n), make([]float32, n)}
+	for _, ch := range channels {
+		for i := range ch {
+			ch[i] = value
+		}
+	}
+	return channels
+}
+
+func TestMultiBusSidechainMapping(t *testing.T) {
+	config := bus.NewEffectStereoSidechain()
+	ctx := NewContext(64, param.NewRegistry())
+	m := NewMultiBusContext(ctx, config)
+	if ctx.Buses() != m || m.NumInputBuses() != 2 || m.NumOutputBuses() != 1 {
+		t.Fatalf("Layout %d in / %d out", m.NumInputBuses(), m.NumOutputBuses())
+	}
+
+	main, sidechain, out := stereo(64, 0.5), stereo(64, 0.25), stereo(64, 0)
+
+	// The sidechain starts inactive and is skipped entirely
+	mapBlock(m, [][][]float32{main, sidechain}, [][][]float32{out})
+	if len(ctx.Input) != 2 || m.GetSidechainInput() != nil || m.InputBuses[1].Mapped() {
+		t.Fatalf("Inactive sidechain mapped: %d input channels", len(ctx.Input))
+	}
+
+	config.SetBusActive(bus.MediaTypeAudio, bus.DirectionInput, 1, true)
+	mapBlock(m, [][][]float32{main, sidechain}, [][][]float32{out})
+	if len(ctx.Input) != 4 {
+		t.Fatalf("Expected 4 flat input channels, got %d", len(ctx.Input))
+	}
+
+	calls := 0
+	m.ProcessWithSidechain(func(in, sc, output [][]float32) {
+		calls++
+		if len(in) != 2 || len(sc) != 2 || len(output) != 2 {
+			t.Fatalf("Bus widths %d/%d/%d", len(in), len(sc), len(output))
+		}
+		if in[0][0] != 0.5 || sc[1][63] != 0.25 || &output[0][0] != &out[0][0] {
+			t.Error("Buses do not alias the host buffers")
+		}
+	})
+	if calls != 1 {
+		t.Error("ProcessWithSidechain did not run")
+	}
+	if m.GetMainInput64() != nil || m.GetInputBus(5) != nil {
+		t.Error("Unmapped views should be nil")
+	}
+}
+
+func TestMultiBusFollowsChunks(t *testing.T) {
+	config := bus.NewEffectStereoSidechain()
+	config.SetBusActive(bus.MediaTypeAudio, bus.DirectionInput, 1, true)
+	registry := param.NewRegistry()
+	registry.Add(param.New(0, "Gain").Range(0, 1).Default(0).Build())
+	ctx := NewContext(128, registry)
+	m := NewMultiBusContext(ctx, config)
+	mapBlock(m, [][][]float32{stereo(128, 1), stereo(128, 2)}, [][][]float32{stereo(128, 0)})
+
+	ctx.AddParameterChange(0, 0.5, 40)
+	ctx.SortParameterChanges()
+	var lengths []int
+	ctx.ProcessChunked(func() {
+		sc := m.GetSidechainInput()
+		if len(sc) != 2 || sc[0][0] != 2 {
+			t.Fatalf("Sidechain view lost in chunk at %d", ctx.ChunkOffset())
+		}
+		lengths = append(lengths, len(sc[0]), len(m.GetMainOutput()[1]))
+	})
+	if len(lengths) != 4 || lengths[0] != 40 || lengths[1] != 40 || lengths[2] != 88 || lengths[3] != 88 {
+		t.Errorf("Chunk bus lengths %v, want [40 40 88 88]", lengths)
+	}
+}
+
+func TestMultiBusMappingZeroAllocations(t *testing.T) {
+	config := bus.NewEffectStereoSidechain()
+	config.SetBusActive(bus.MediaTypeAudio, bus.DirectionInput, 1, true)
+	ctx := NewContext(64, param.NewRegistry())
+	m := NewMultiBusContext(ctx, config)
+	inputs := [][][]float32{stereo(64, 1), stereo(64, 1)}
+	outputs := [][][]float32{stereo(64, 0)}
+
+	allocs := testing.AllocsPerRun(100, func() {
+		mapBlock(m, inputs, outputs)
+		m.ProcessWithSidechain(func(in, sc, out [][]float32) {})
+		m.PassThroughAll()
+	})
+	if allocs != 0 {
+		t.Errorf("Mapping allocated %.1f times per block", allocs)
+	}
+}
@@ -0,0 +1,129 @@
+package process
+
+// InfiniteTail is the tail a processor reports from GetTailSamples when it
+// never stops producing output on its own (the host sees kInfiniteTail).
+// Such processors are never skipped.
+const InfiniteTail int32 = -1
+
+// DefaultSilenceThreshold is the level (about -120 dBFS) at or below which
+// a sample counts as silent when buffers are scanned for silence
+const DefaultSilenceThreshold float32 = 1e-6
+
+// Silence tracks runs of silent input so the framework can skip processing.
+//
+// Each block the framework reports whether every input channel is silent,
+// either from the host's silence flags or, when detection is enabled, by
+// scanning the input. Once the output rendered from silent input has stayed
+// silent for a full tail window, blocks are skipped: ProcessAudio is not
+// called, the outputs are zeroed and flagged silent so the host can skip
+// downstream work too. The first non-silent block resumes processing.
+//
+// Skipping is off by default. A processor enables it from
+// ContextConfigurer.ConfigureContext once GetTailSamples covers the longest
+// gap its output can have: an echo that returns after a longer silence is
+// lost.
+type Silence struct {
+	enabled   bool
+	detect    bool
+	threshold float32
+
+	silentOutput int64 // Consecutive silent output samples rendered from silent input
+	inputSilent  bool  // The current block's input is silent
+	skipping     bool
+}
+
+func newSilence() *Silence {
+	return &Silence{
+		threshold: DefaultSilenceThreshold,
+	}
+}
+
+// SetEnabled enables or disables skipping. Leave it disabled for processors
+// that must run on silence, such as meters or free-running generators, and
+// for processors whose output can go quiet for longer than their tail.
+func (s *Silence) SetEnabled(enabled bool) {
+	s.enabled = enabled
+	s.Reset()
+}
+
+// SetDetection enables scanning the input for silence when the host has not
+// flagged it, for hosts that never set silence flags. threshold is the
+// largest absolute sample value that counts as silent.
+func (s *Silence) SetDetection(enabled bool, threshold float32) {
+	s.detect = enabled
+	if threshold < 0 {
+		threshold = -threshold
+	}
+	s.threshold = threshold
+}
+
+// Detection reports whether input scanning is enabled
+func (s *Silence) Detection() bool {
+	return s.detect
+}
+
+// Threshold returns the level at or below which scanned samples are silent
+func (s *Silence) Threshold() float32 {
+	return s.threshold
+}
+
+// InputSilent reports whether the current block's input is silent
+func (s *Silence) InputSilent() bool {
+	return s.inputSilent
+}
+
+// Skipping reports whether the current block is being skipped
+func (s *Silence) Skipping() bool {
+	return s.skipping
+}
+
+// Enabled reports whether blocks are skipped on silence
+func (s *Silence) Enabled() bool {
+	return s.enabled
+}
+
+// Begin records the current block's input state and returns true when the
+// block can be skipped. tail is the processor's tail in samples.
+func (s *Silence) Begin(inputSilent bool, tail int32) bool {
+	s.inputSilent = inputSilent
+	if !s.enabled || !inputSilent || tail == InfiniteTail {
+		s.silentOutput = 0
+		s.skipping = false
+		return false
+	}
+
+	// At least one block is rendered and checked, even with no tail
+	s.skipping = s.silentOutput > 0 && s.silentOutput >= int64(tail)
+	return s.skipping
+}
+
+// End records whether the numSamples the processor just rendered came out
+// silent. Any sound restarts the tail window.
+func (s *Silence) End(outputSilent bool, numSamples int) {
+	if outputSilent && s.inputSilent {
+		s.silentOutput += int64(numSamples)
+	} else {
+		s.silentOutput = 0
+	}
+}
+
+// Reset forgets the current silent run, e.g. when processing restarts
+func (s *Silence) Reset() {
+	s.silentOutput = 0
+	s.inputSilent = false
+	s.skipping = false
+}
+
+// IsSilent reports whether every sample of every channel is within
+// threshold of zero. It returns at the first louder sample, so audible
+// buffers cost almost nothing to check.
+func IsSilent[T float32 | float64](channels [][]T, threshold T) bool {
+	for _, channel := range channels {
+		for _, x := range channel {
+			if x > threshold || x < -threshold {
+				return false
+			}
+		}
+	}
+	return true
+}
@@ -0,0 +1,146 @@
+package process
+
+import "testing"
+
+// enabledSilence returns a tracker with skipping turned on
+func enabledSilence() *Silence {
+	s := NewContext(64, nil).Silence()
+	s.SetEnabled(true)
+	return s
+}
+
+func TestSilenceSkipsAfterTail(t *testing.T) {
+	s := enabledSilence()
+	const block = 64
+	const tail = 150
+
+	// Sound never skips
+	if s.Begin(false, tail) {
+		t.Fatal("Skipped a block with input")
+	}
+	s.End(false, block)
+
+	// The tail is rendered in full: 150 samples need three blocks
+	for i := 0; i < 3; i++ {
+		if s.Begin(true, tail) {
+			t.Fatalf("Skipped silent block %d inside the tail", i)
+		}
+		s.End(true, block)
+	}
+	if !s.Begin(true, tail) {
+		t.Fatal("Did not skip once the tail elapsed")
+	}
+	if !s.Skipping() || !s.InputSilent() {
+		t.Error("Skipping state not reported")
+	}
+
+	// Sound resumes processing immediately
+	if s.Begin(false, tail) {
+		t.Fatal("Skipped a block with input after silence")
+	}
+	s.End(false, block)
+}
+
+func TestSilenceWaitsForOutputToDie(t *testing.T) {
+	s := enabledSilence()
+
+	// A processor that under-reports its tail keeps running while its
+	// output is still ringing
+	for i := 0; i < 10; i++ {
+		if s.Begin(true, 0) {
+			t.Fatalf("Skipped block %d while output was audible", i)
+		}
+		s.End(false, 64)
+	}
+	s.Begin(true, 0)
+	s.End(true, 64)
+	if !s.Begin(true, 0) {
+		t.Error("Did not skip after the output went silent")
+	}
+}
+
+func TestSilenceKeepsTailWithGaps(t *testing.T) {
+	s := enabledSilence()
+	const tail = 256
+
+	// Echoes 192 samples apart, separated by silent blocks: the gaps are
+	// shorter than the tail, so no block may be skipped between them
+	for echo := 0; echo < 20; echo++ {
+		for i := 0; i < 2; i++ {
+			if s.Begin(true, tail) {
+				t.Fatalf("Skipped a gap before echo %d", echo)
+			}
+			s.End(true, 64)
+		}
+		if s.Begin(true, tail) {
+			t.Fatalf("Skipped echo %d", echo)
+		}
+		s.End(false, 64)
+	}
+
+	// Once the echoes die out, a full silent tail allows skipping
+	for i := 0; i < 4; i++ {
+		if s.Begin(true, tail) {
+			t.Fatalf("Skipped block %d of the final tail", i)
+		}
+		s.End(true, 64)
+	}
+	if !s.Begin(true, tail) {
+		t.Error("Did not skip after a full silent tail")
+	}
+}
+
+func TestSilenceOptInAndInfiniteTail(t *testing.T) {
+	s := NewContext(64, nil).Silence()
+	if s.Enabled() {
+		t.Fatal("Skipping should be off by default")
+	}
+	for i := 0; i < 4; i++ {
+		if s.Begin(true, 0) {
+			t.Fatal("Skipped without skipping enabled")
+		}
+		s.End(true, 64)
+	}
+
+	s.SetEnabled(true)
+	for i := 0; i < 4; i++ {
+		if s.Begin(true, InfiniteTail) {
+			t.Fatal("Skipped a processor with an infinite tail")
+		}
+		s.End(true, 64)
+	}
+}
+
+func TestIsSilent(t *testing.T) {
+	channels := [][]float32{make([]float32, 32), make([]float32, 32)}
+	if !IsSilent(channels, 0) {
+		t.Error("Zeros should be silent")
+	}
+
+	channels[1][31] = 1e-7
+	if IsSilent(channels, 0) {
+		t.Error("Nonzero sample counted as silent at threshold 0")
+	}
+	if !IsSilent(channels, DefaultSilenceThreshold) {
+		t.Error("Sample below the threshold should be silent")
+	}
+
+	channels[0][3] = -0.5
+	if IsSilent(channels, DefaultSilenceThreshold) {
+		t.Error("Negative sample above the threshold counted as silent")
+	}
+	if !IsSilent([][]float64{make([]float64, 8)}, 0) {
+		t.Error("float64 zeros should be silent")
+	}
+}
+
+func TestSilenceDetectionSettings(t *testing.T) {
+	s := NewContext(64, nil).Silence()
+	if s.Detection() {
+		t.Error("Detection should be off by default")
+	}
+	s.SetDetection(true, -1e-5)
+	if !s.Detection() || s.Threshold() != 1e-5 {
+		t.Errorf("Detection %v threshold %g", s.Detection(), s.Threshold())
+	}
+}
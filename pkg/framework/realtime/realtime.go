@@ -0,0 +1,322 @@
+// Package realtime tunes the Go runtime for audio callbacks.
+//
+// Process calls arrive on host threads through cgo, and a callback runs on
+// the host thread that made it, so audio work is already pinned to a host
+// thread. What goes wrong under load is garbage collection: a cycle that
+// starts or ends during a process call stops the world at the worst moment,
+// and a goroutine that allocates while the GC is marking is drafted into
+// mark assists.
+//
+// Mode keeps the GC away from process calls:
+//   - Pacing switches from GOGC to a memory limit, so the runtime only
+//     collects on its own when the heap nears the limit.
+//   - A background collector runs collections itself, started right after
+//     a process call returns, so the stop-the-world phases land between
+//     blocks and the collection has a whole block period to finish.
+//   - The audio thread never assists as long as processing does not
+//     allocate, which the framework's zero-allocation paths guarantee.
+//
+// Counters report how often a GC cycle still overlapped a process call.
+// Process calls only do atomic operations to keep them: runtime/metrics
+// takes global runtime locks and is read by the collector goroutine alone.
+package realtime
+
+import (
+	"errors"
+	"runtime"
+	"runtime/debug"
+	"runtime/metrics"
+	"sync"
+	"sync/atomic"
+	"time"
+)
+
+// Config configures the real-time runtime mode
+type Config struct {
+	// MemoryLimit is the soft heap limit the runtime paces collection
+	// against (debug.SetMemoryLimit). 0 keeps the current limit.
+	MemoryLimit int64
+
+	// GCPercent replaces GOGC while the mode is enabled. -1 turns off
+	// proportional pacing so only the memory limit and the scheduled
+	// collections trigger a cycle; it requires a MemoryLimit.
+	GCPercent int
+
+	// CollectHeapGrowth is the number of bytes allocated since the last
+	// cycle that schedules a collection between blocks
+	CollectHeapGrowth uint64
+
+	// CollectInterval is how often the collector checks heap growth. A
+	// collection is also scheduled once per interval with any growth at all
+	// when CollectHeapGrowth is 0.
+	CollectInterval time.Duration
+}
+
+// DefaultConfig paces against a 256 MiB limit and collects between blocks
+// once 8 MiB have been allocated
+func DefaultConfig() Config {
+	return Config{
+		MemoryLimit:       256 << 20,
+		GCPercent:         -1,
+		CollectHeapGrowth: 8 << 20,
+		CollectInterval:   100 * time.Millisecond,
+	}
+}
+
+// Stats are the counters of an enabled Mode
+type Stats struct {
+	ProcessCalls         uint64        // Process calls tracked
+	OverlappingCalls     uint64        // Process calls during which a GC cycle completed
+	GCCycles             uint64        // GC cycles completed since the mode was enabled
+	ScheduledCollections uint64        // Cycles started by the collector between blocks
+	GCPauseTotal         time.Duration // Stop-the-world time since the mode was enabled
+}
+
+const gcCyclesMetric = "/gc/cycles/total:gc-cycles"
+
+// Mode is the enabled real-time runtime mode. Only one can be enabled at a
+// time, since the GC settings are process-wide.
+type Mode struct {
+	cfg Config
+
+	previousPercent int
+	previousLimit   int64
+	generation      uint64 // Sentinel generation counting this mode's cycles
+	startCycles     uint64
+	startPause      time.Duration
+
+	inFlight    atomic.Int32 // Process calls currently running
+	pending     atomic.Bool  // The collector waits for a block to end
+	blockDone   chan struct{}
+	stop        chan struct{}
+	stopped     sync.WaitGroup
+	calls       atomic.Uint64
+	overlapping atomic.Uint64
+	scheduled   atomic.Uint64
+}
+
+var (
+	enabledMu sync.Mutex
+	enabled   *Mode
+
+	// Completed GC cycles as seen by the sentinel of the enabled mode, read
+	// by process calls with a single atomic load
+	gcCycles           atomic.Uint64
+	sentinelGeneration atomic.Uint64
+)
+
+// gcSentinel is an unreachable object whose finalizer runs once per GC
+// cycle: it counts the cycle and arms a new sentinel for the next one. It
+// is 16 bytes so the tiny allocator, whose finalizers may never run, does
+// not serve it.
+type gcSentinel struct {
+	generation uint64
+	_          uint64
+}
+
+// armSentinel starts a sentinel chain that runs until the generation moves
+// on. The finalizer goroutine runs shortly after the cycle ends, so a cycle
+// that ends right at the end of a process call may count for the next one.
+func armSentinel(generation uint64) {
+	sentinel := &gcSentinel{generation: generation}
+	runtime.SetFinalizer(sentinel, func(s *gcSentinel) {
+		if sentinelGeneration.Load() != s.generation {
+			return
+		}
+		gcCycles.Add(1)
+		armSentinel(s.generation)
+	})
+}
+
+// maxDeferrals is how many block ends a scheduled collection waits for
+// other process calls to finish before it runs anyway
+const maxDeferrals = 8
+
+// Enable applies cfg to the runtime and starts the background collector
+func Enable(cfg Config) (*Mode, error) {
+	if cfg.GCPercent < 0 && cfg.MemoryLimit <= 0 {
+		return nil, errors.New("realtime: disabling GOGC requires a memory limit")
+	}
+	if cfg.CollectInterval <= 0 {
+		cfg.CollectInterval = DefaultConfig().CollectInterval
+	}
+
+	enabledMu.Lock()
+	defer enabledMu.Unlock()
+	if enabled != nil {
+		return nil, errors.New("realtime: mode already enabled")
+	}
+
+	m := &Mode{
+		cfg:       cfg,
+		blockDone: make(chan struct{}, 1),
+		stop:      make(chan struct{}),
+	}
+	m.startCycles = readCycles()
+	m.startPause = pauseTotal()
+	m.generation = sentinelGeneration.Add(1)
+	armSentinel(m.generation)
+	if cfg.MemoryLimit > 0 {
+		m.previousLimit = debug.SetMemoryLimit(cfg.MemoryLimit)
+	} else {
+		m.previousLimit = debug.SetMemoryLimit(-1)
+	}
+	m.previousPercent = debug.SetGCPercent(cfg.GCPercent)
+
+	m.stopped.Add(1)
+	go m.collect()
+	enabled = m
+	return m, nil
+}
+
+// Enabled returns the enabled mode, or nil
+func Enabled() *Mode {
+	enabledMu.Lock()
+	defer enabledMu.Unlock()
+	return enabled
+}
+
+// Disable stops the collector and restores the previous GC settings
+func (m *Mode) Disable() {
+	enabledMu.Lock()
+	defer enabledMu.Unlock()
+	if enabled != m {
+		return
+	}
+	close(m.stop)
+	m.stopped.Wait()
+	sentinelGeneration.Add(1) // Ends the sentinel chain at the next cycle
+	debug.SetGCPercent(m.previousPercent)
+	debug.SetMemoryLimit(m.previousLimit)
+	enabled = nil
+}
+
+// Config returns the configuration the mode was enabled with
+func (m *Mode) Config() Config {
+	return m.cfg
+}
+
+// Stats returns the current counters. Call it off the audio thread.
+func (m *Mode) Stats() Stats {
+	return Stats{
+		ProcessCalls:         m.calls.Load(),
+		OverlappingCalls:     m.overlapping.Load(),
+		GCCycles:             readCycles() - m.startCycles,
+		ScheduledCollections: m.scheduled.Load(),
+		GCPauseTotal:         pauseTotal() - m.startPause,
+	}
+}
+
+// Tracker follows the process calls of one plugin instance. The calls of
+// one instance never overlap, so the cycle count at the start of a call is
+// kept without synchronization.
+type Tracker struct {
+	mode   *Mode
+	cycles uint64
+}
+
+// NewTracker creates a tracker for one plugin instance
+func (m *Mode) NewTracker() *Tracker {
+	return &Tracker{mode: m}
+}
+
+// Begin marks the start of a process call. It does not allocate or lock.
+func (t *Tracker) Begin() {
+	t.mode.inFlight.Add(1)
+	t.cycles = gcCycles.Load()
+}
+
+// End marks the end of a process call and, when a collection is waiting,
+// tells the collector a block just finished. It does not allocate or lock.
+func (t *Tracker) End() {
+	m := t.mode
+	if gcCycles.Load() != t.cycles {
+		m.overlapping.Add(1)
+	}
+	m.calls.Add(1)
+	m.inFlight.Add(-1)
+
+	if m.pending.Load() {
+		select {
+		case m.blockDone <- struct{}{}:
+		default:
+		}
+	}
+}
+
+// collect is the background collector: it watches heap growth and runs a
+// collection right after a block ends
+func (m *Mode) collect() {
+	defer m.stopped.Done()
+
+	ticker := time.NewTicker(m.cfg.CollectInterval)
+	defer ticker.Stop()
+	samples := []metrics.Sample{{Name: "/gc/heap/allocs:bytes"}, {Name: gcCyclesMetric}}
+	var lastAllocs, lastCycles uint64
+
+	for {
+		select {
+		case <-m.stop:
+			return
+		case <-ticker.C:
+		}
+
+		metrics.Read(samples)
+		allocs, cycles := samples[0].Value.Uint64(), samples[1].Value.Uint64()
+		if cycles != lastCycles {
+			// The runtime collected on its own; measure growth from here
+			lastAllocs, lastCycles = allocs, cycles
+			continue
+		}
+		growth := allocs - lastAllocs
+		if growth == 0 || growth < m.cfg.CollectHeapGrowth {
+			continue
+		}
+
+		if !m.awaitBlockEnd(ticker) {
+			return
+		}
+		runtime.GC()
+		m.scheduled.Add(1)
+
+		metrics.Read(samples)
+		lastAllocs, lastCycles = samples[0].Value.Uint64(), samples[1].Value.Uint64()
+	}
+}
+
+// awaitBlockEnd waits until a process call has just returned with no other
+// call in flight. When audio is not running, a tick passes without a block
+// ending and the collection runs right away. It returns false when the
+// mode is being disabled.
+func (m *Mode) awaitBlockEnd(ticker *time.Ticker) bool {
+	select {
+	case <-m.blockDone: // Stale signal from the previous wait
+	default:
+	}
+	m.pending.Store(true)
+	defer m.pending.Store(false)
+
+	for deferrals := 0; ; deferrals++ {
+		select {
+		case <-m.stop:
+			return false
+		case <-ticker.C:
+		case <-m.blockDone:
+		}
+		if m.inFlight.Load() == 0 || deferrals >= maxDeferrals {
+			return true
+		}
+	}
+}
+
+func readCycles() uint64 {
+	sample := []metrics.Sample{{Name: gcCyclesMetric}}
+	metrics.Read(sample)
+	return sample[0].Value.Uint64()
+}
+
+func pauseTotal() time.Duration {
+	var stats debug.GCStats
+	debug.ReadGCStats(&stats)
+	return stats.PauseTotal
+}
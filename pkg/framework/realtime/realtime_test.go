@@ -0,0 +1,161 @@
+package realtime
+
+import (
+	"runtime"
+	"runtime/debug"
+	"testing"
+	"time"
+)
+
+var sink []byte
+
+// waitForCycle runs a collection and waits for the sentinel to count it
+func waitForCycle(t *testing.T) {
+	start := gcCycles.Load()
+	runtime.GC()
+	deadline := time.Now().Add(5 * time.Second)
+	for gcCycles.Load() == start {
+		if time.Now().After(deadline) {
+			t.Fatal("The GC sentinel did not count the cycle")
+		}
+		time.Sleep(time.Millisecond)
+	}
+}
+
+func TestSentinelStopsWithMode(t *testing.T) {
+	m, err := Enable(DefaultConfig())
+	if err != nil {
+		t.Fatal(err)
+	}
+	for i := 0; i < 3; i++ {
+		waitForCycle(t)
+	}
+	m.Disable()
+
+	// The chain ends at the first cycle after Disable
+	runtime.GC()
+	runtime.GC()
+	time.Sleep(10 * time.Millisecond)
+	count := gcCycles.Load()
+	runtime.GC()
+	time.Sleep(10 * time.Millisecond)
+	if gcCycles.Load() != count {
+		t.Error("Sentinel still counting after Disable")
+	}
+}
+
+func TestEnableAndDisable(t *testing.T) {
+	if _, err := Enable(Config{GCPercent: -1}); err == nil {
+		t.Fatal("Disabling GOGC without a memory limit was accepted")
+	}
+
+	previousLimit := debug.SetMemoryLimit(-1)
+	m, err := Enable(DefaultConfig())
+	if err != nil {
+		t.Fatal(err)
+	}
+	if Enabled() != m {
+		t.Error("Enabled mode not reported")
+	}
+	if _, err := Enable(DefaultConfig()); err == nil {
+		t.Error("Second mode enabled alongside the first")
+	}
+	if limit := debug.SetMemoryLimit(-1); limit != DefaultConfig().MemoryLimit {
+		t.Errorf("Memory limit %d", limit)
+	}
+
+	m.Disable()
+	if Enabled() != nil {
+		t.Error("Mode still enabled")
+	}
+	if limit := debug.SetMemoryLimit(-1); limit != previousLimit {
+		t.Errorf("Memory limit %d not restored to %d", limit, previousLimit)
+	}
+	percent := debug.SetGCPercent(100)
+	debug.SetGCPercent(percent)
+	if percent < 0 {
+		t.Error("GOGC not restored")
+	}
+}
+
+func TestTrackerCountsOverlappingCycles(t *testing.T) {
+	m, err := Enable(DefaultConfig())
+	if err != nil {
+		t.Fatal(err)
+	}
+	defer m.Disable()
+	tracker := m.NewTracker()
+
+	tracker.Begin()
+	tracker.End()
+	tracker.Begin()
+	waitForCycle(t)
+	tracker.End()
+
+	stats := m.Stats()
+	if stats.ProcessCalls != 2 || stats.OverlappingCalls != 1 {
+		t.Errorf("Calls %d, overlapping %d; want 2 and 1", stats.ProcessCalls, stats.OverlappingCalls)
+	}
+	if stats.GCCycles < 1 {
+		t.Errorf("GC cycles %d", stats.GCCycles)
+	}
+}
+
+func TestCollectionScheduledBetweenBlocks(t *testing.T) {
+	cfg := DefaultConfig()
+	cfg.CollectHeapGrowth = 1 << 20
+	cfg.CollectInterval = 2 * time.Millisecond
+	m, err := Enable(cfg)
+	if err != nil {
+		t.Fatal(err)
+	}
+	defer m.Disable()
+	tracker := m.NewTracker()
+
+	for i := 0; i < 64; i++ {
+		sink = make([]byte, 64<<10)
+	}
+	deadline := time.Now().Add(5 * time.Second)
+	for m.Stats().ScheduledCollections == 0 {
+		if time.Now().After(deadline) {
+			t.Fatal("No collection was scheduled")
+		}
+		tracker.Begin()
+		time.Sleep(100 * time.Microsecond)
+		tracker.End()
+		time.Sleep(time.Millisecond)
+	}
+}
+
+func TestTrackerZeroAllocations(t *testing.T) {
+	m, err := Enable(DefaultConfig())
+	if err != nil {
+		t.Fatal(err)
+	}
+	defer m.Disable()
+	tracker := m.NewTracker()
+	m.pending.Store(true) // Exercise the block-end signal as well
+
+	allocs := testing.AllocsPerRun(100, func() {
+		tracker.Begin()
+		tracker.End()
+	})
+	if allocs != 0 {
+		t.Errorf("Tracking allocated %.1f times per call", allocs)
+	}
+}
+
+func BenchmarkTracker(b *testing.B) {
+	m, err := Enable(DefaultConfig())
+	if err != nil {
+		b.Fatal(err)
+	}
+	defer m.Disable()
+	tracker := m.NewTracker()
+
+	b.ReportAllocs()
+	for i := 0; i < b.N; i++ {
+		tracker.Begin()
+		tracker.End()
+	}
+}
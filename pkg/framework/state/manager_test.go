@@ -0,0 +1,192 @@
+package state
+
+import (
+	"bytes"
+	"encoding/binary"
+	"errors"
+	"io"
+	"testing"
+
+	"github.com/justyntemme/vst3go/pkg/framework/param"
+)
+
+func newRegistry(count int) *param.Registry {
+	registry := param.NewRegistry()
+	for i := 0; i < count; i++ {
+		registry.Add(param.New(uint32(i), "Param").Range(0, 1).Default(0).Build())
+	}
+	return registry
+}
+
+// encodeV1 writes a state the way version 1 of the format did
+func encodeV1(ids []uint32, values []float64, custom []byte) []byte {
+	var buf bytes.Buffer
+	buf.WriteString("VST3GO")
+	binary.Write(&buf, binary.LittleEndian, uint32(1))
+	binary.Write(&buf, binary.LittleEndian, int32(len(ids)))
+	for i, id := range ids {
+		binary.Write(&buf, binary.LittleEndian, id)
+		binary.Write(&buf, binary.LittleEndian, values[i])
+	}
+	if custom == nil {
+		binary.Write(&buf, binary.LittleEndian, uint32(0))
+	} else {
+		binary.Write(&buf, binary.LittleEndian, uint32(1))
+		buf.Write(custom)
+	}
+	return buf.Bytes()
+}
+
+func TestSaveLoadRoundTrip(t *testing.T) {
+	source := newRegistry(4)
+	for i, p := range source.All() {
+		p.SetValue(0.1 * float64(i+1))
+	}
+	m := NewManager(source)
+	m.SetCustomSaveFunc(func(w io.Writer) error {
+		_, err := w.Write([]byte("custom"))
+		return err
+	})
+	var buf bytes.Buffer
+	if err := m.Save(&buf); err != nil {
+		t.Fatal(err)
+	}
+
+	target := newRegistry(4)
+	var custom []byte
+	loader := NewManager(target)
+	loader.SetCustomLoadFunc(func(r io.Reader) error {
+		var err error
+		custom, err = io.ReadAll(r)
+		return err
+	})
+	if err := loader.Load(&buf); err != nil {
+		t.Fatal(err)
+	}
+
+	for i, p := range target.All() {
+		if want := 0.1 * float64(i+1); p.GetValue() != want {
+			t.Errorf("Parameter %d: got %f, want %f", i, p.GetValue(), want)
+		}
+	}
+	if string(custom) != "custom" {
+		t.Errorf("Custom data: got %q", custom)
+	}
+}
+
+func TestDecodeVersion1(t *testing.T) {
+	data := encodeV1([]uint32{0, 7, 2}, []float64{0.25, 0.5, 0.75}, []byte("legacy"))
+	s, err := Decode(data)
+	if err != nil {
+		t.Fatal(err)
+	}
+	if s.Len() != 3 {
+		t.Fatalf("Expected 3 parameters, got %d", s.Len())
+	}
+	if id, value := s.At(1); id != 7 || value != 0.5 {
+		t.Errorf("Second record: got (%d, %f)", id, value)
+	}
+	if string(s.Custom()) != "legacy" {
+		t.Errorf("Custom data: got %q", s.Custom())
+	}
+
+	// Unknown IDs are skipped
+	registry := newRegistry(3)
+	s.Apply(registry)
+	if registry.Get(0).GetValue() != 0.25 || registry.Get(2).GetValue() != 0.75 {
+		t.Error("Known parameters should be applied")
+	}
+
+	if s, err := Decode(encodeV1([]uint32{1}, []float64{1}, nil)); err != nil || s.Custom() != nil {
+		t.Errorf("Version 1 without custom data: %v, %q", err, s.Custom())
+	}
+}
+
+func TestDecodeRejectsBadStreams(t *testing.T) {
+	valid := Capture(newRegistry(3), []byte("tail")).AppendBinary(nil)
+
+	if _, err := Decode([]byte("NOTVST3GO.....")); err == nil {
+		t.Error("Wrong magic should fail")
+	}
+	newer := append([]byte(nil), valid...)
+	binary.LittleEndian.PutUint32(newer[6:], FormatVersion+1)
+	if _, err := Decode(newer); err == nil {
+		t.Error("Newer version should fail")
+	}
+	for _, n := range []int{0, 10, headerSize + recordSize, len(valid) - 1} {
+		if _, err := Decode(valid[:n]); !errors.Is(err, ErrTruncated) {
+			t.Errorf("Stream cut at %d bytes: got %v, want ErrTruncated", n, err)
+		}
+	}
+	huge := append([]byte(nil), valid...)
+	binary.LittleEndian.PutUint32(huge[10:], 1<<30)
+	if _, err := Decode(huge); !errors.Is(err, ErrTruncated) {
+		t.Errorf("Oversized count: got %v, want ErrTruncated", err)
+	}
+}
+
+func TestSnapshotDoesNotAliasInput(t *testing.T) {
+	data := Capture(newRegistry(1), []byte("abc")).AppendBinary(nil)
+	s, err := Decode(data)
+	if err != nil {
+		t.Fatal(err)
+	}
+	data[len(data)-1] = 'x'
+	if string(s.Custom()) != "abc" {
+		t.Errorf("Snapshot changed with its input: %q", s.Custom())
+	}
+}
+
+func TestSnapshotApplyZeroAllocations(t *testing.T) {
+	registry := newRegistry(64)
+	s := Capture(registry, nil)
+	allocs := testing.AllocsPerRun(100, func() {
+		s.Apply(registry)
+	})
+	if allocs != 0 {
+		t.Errorf("Apply allocated %.1f times", allocs)
+	}
+}
+
+// BenchmarkLoad loads a 200-parameter state: the reflection-based version 1
+// reader it replaced next to decoding into a snapshot
+func BenchmarkLoad(b *testing.B) {
+	registry := newRegistry(200)
+	ids := make([]uint32, 200)
+	values := make([]float64, 200)
+	for i := range ids {
+		ids[i] = uint32(i)
+		values[i] = float64(i) / 200
+	}
+	data := encodeV1(ids, values, nil)
+
+	b.Run("BinaryRead", func(b *testing.B) {
+		for i := 0; i < b.N; i++ {
+			r := bytes.NewReader(data)
+			header := make([]byte, 6)
+			io.ReadFull(r, header)
+			var version uint32
+			var count int32
+			binary.Read(r, binary.LittleEndian, &version)
+			binary.Read(r, binary.LittleEndian, &count)
+			for j := int32(0); j < count; j++ {
+				var id uint32
+				var value float64
+				binary.Read(r, binary.LittleEndian, &id)
+				binary.Read(r, binary.LittleEndian, &value)
+				if p := registry.Get(id); p != nil {
+					p.SetValue(value)
+				}
+			}
+		}
+	})
+	b.Run("Decode", func(b *testing.B) {
+		for i := 0; i < b.N; i++ {
+			s, err := Decode(data)
+			if err != nil {
+				b.Fatal(err)
+			}
+			s.Apply(registry)
+		}
+	})
+}
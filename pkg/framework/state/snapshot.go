@@ -0,0 +1,146 @@
+package state
+
+import (
+	"encoding/binary"
+	"errors"
+	"fmt"
+	"math"
+
+	"github.com/justyntemme/vst3go/pkg/framework/param"
+)
+
+// Stream layout, all little-endian:
+//
+//	"VST3GO" | version u32 | count u32 | count x (id u32, value f64) | custom
+//
+// Version 2 prefixes the custom data with its length (u32), so readers can
+// skip it. Version 1 wrote the count as i32 and a custom flag (u32) followed
+// by custom data running to the end of the stream; it is still decoded.
+const (
+	// FormatVersion is the version Save writes
+	FormatVersion = 2
+
+	magic       = "VST3GO"
+	headerSize  = len(magic) + 4 + 4 // Magic, version, parameter count
+	recordSize  = 4 + 8              // Parameter ID, normalized value
+	trailerSize = 4                  // Custom data length (or v1 flag)
+)
+
+// ErrTruncated is returned when a state stream ends early
+var ErrTruncated = errors.New("state data is truncated")
+
+// Snapshot is a decoded plugin state: parameter values by ID plus the
+// processor's custom data. It is never modified after decoding, so it can
+// be handed to the audio thread and applied there without locks.
+type Snapshot struct {
+	ids    []uint32
+	values []float64 // Normalized
+	custom []byte
+}
+
+// Decode parses a state stream without reflection. Parameter values are
+// read straight from the buffer; only the snapshot's own slices allocate.
+// The snapshot does not keep a reference to data.
+func Decode(data []byte) (*Snapshot, error) {
+	if len(data) < headerSize {
+		return nil, ErrTruncated
+	}
+	if string(data[:len(magic)]) != magic {
+		return nil, fmt.Errorf("invalid state format")
+	}
+	version := binary.LittleEndian.Uint32(data[len(magic):])
+	if version > FormatVersion {
+		return nil, fmt.Errorf("state version %d is newer than supported version %d", version, FormatVersion)
+	}
+	count := int(binary.LittleEndian.Uint32(data[len(magic)+4:]))
+	if version < 2 {
+		// Version 1 wrote a signed count
+		count = int(int32(count))
+	}
+	body := data[headerSize:]
+	if count < 0 || count > (len(body)-trailerSize)/recordSize {
+		return nil, ErrTruncated
+	}
+
+	s := &Snapshot{
+		ids:    make([]uint32, count),
+		values: make([]float64, count),
+	}
+	for i := range s.ids {
+		record := body[i*recordSize : (i+1)*recordSize]
+		s.ids[i] = binary.LittleEndian.Uint32(record)
+		s.values[i] = math.Float64frombits(binary.LittleEndian.Uint64(record[4:]))
+	}
+
+	trailer := body[count*recordSize:]
+	custom := trailer[trailerSize:]
+	if version < 2 {
+		if binary.LittleEndian.Uint32(trailer) == 0 {
+			custom = nil
+		}
+	} else {
+		size := int(binary.LittleEndian.Uint32(trailer))
+		if size > len(custom) {
+			return nil, ErrTruncated
+		}
+		custom = custom[:size]
+	}
+	if len(custom) > 0 {
+		s.custom = append([]byte(nil), custom...)
+	}
+	return s, nil
+}
+
+// Capture snapshots the current values of every parameter in registry
+func Capture(registry *param.Registry, custom []byte) *Snapshot {
+	params := registry.All()
+	s := &Snapshot{
+		ids:    make([]uint32, len(params)),
+		values: make([]float64, len(params)),
+		custom: append([]byte(nil), custom...),
+	}
+	for i, p := range params {
+		s.ids[i] = p.ID
+		s.values[i] = p.GetValue()
+	}
+	return s
+}
+
+// AppendBinary appends the snapshot in the current format to dst
+func (s *Snapshot) AppendBinary(dst []byte) []byte {
+	dst = append(dst, magic...)
+	dst = binary.LittleEndian.AppendUint32(dst, FormatVersion)
+	dst = binary.LittleEndian.AppendUint32(dst, uint32(len(s.ids)))
+	for i, id := range s.ids {
+		dst = binary.LittleEndian.AppendUint32(dst, id)
+		dst = binary.LittleEndian.AppendUint64(dst, math.Float64bits(s.values[i]))
+	}
+	dst = binary.LittleEndian.AppendUint32(dst, uint32(len(s.custom)))
+	return append(dst, s.custom...)
+}
+
+// Len returns the number of parameter values
+func (s *Snapshot) Len() int {
+	return len(s.ids)
+}
+
+// At returns the ID and normalized value of the i-th parameter
+func (s *Snapshot) At(i int) (id uint32, value float64) {
+	return s.ids[i], s.values[i]
+}
+
+// Custom returns the processor's custom data, or nil. It must not be
+// modified.
+func (s *Snapshot) Custom() []byte {
+	return s.custom
+}
+
+// Apply sets every parameter that exists in registry - no allocations.
+// Unknown IDs are skipped for forward compatibility.
+func (s *Snapshot) Apply(registry *param.Registry) {
+	for i, id := range s.ids {
+		if p := registry.Get(id); p != nil {
+			p.SetValue(s.values[i])
+		}
+	}
+}
@@ -63,10 +63,10 @@ type Allocator struct {
 	stealingMode  StealingMode
 	maxVoices     int
 	activeVoices  int
-	noteToVoice   map[uint8][]int // Maps note number to voice indices
+	noteVoices    [midiNotes][]int // Voice indices per note, preallocated to len(voices)
 	lastTriggered int              // For round-robin allocation
 	sustainPedal  bool
-	sustainedNotes map[uint8]bool
+	sustainedNotes [midiNotes]bool
 	
 	// Unison mode settings
 	unisonDetune float64
@@ -79,16 +79,25 @@ type Allocator struct {
 	glideActive  bool
 }
 
+// midiNotes is the number of MIDI note numbers
+const midiNotes = 128
+
 // NewAllocator creates a new voice allocator
 func NewAllocator(voices []Voice) *Allocator {
-	return &Allocator{
-		voices:         voices,
-		mode:           ModePoly,
-		stealingMode:   StealOldest,
-		maxVoices:      len(voices),
-		noteToVoice:    make(map[uint8][]int),
-		sustainedNotes: make(map[uint8]bool),
+	a := &Allocator{
+		voices:       voices,
+		mode:         ModePoly,
+		stealingMode: StealOldest,
+		maxVoices:    len(voices),
+	}
+
+	// Share one backing array so note mappings never allocate
+	n := len(voices)
+	backing := make([]int, midiNotes*n)
+	for note := range a.noteVoices {
+		a.noteVoices[note] = backing[note*n : note*n : (note+1)*n]
 	}
+	return a
 }
 
 // SetMode sets the allocation mode
@@ -124,9 +133,40 @@ func (a *Allocator) SetGlideTime(seconds float64) {
 	a.glideTime = seconds
 }
 
+// ProcessEvents handles a run of value-typed MIDI events without allocating,
+// e.g. ctx.GetInputEvents(start, end)
+func (a *Allocator) ProcessEvents(records []midi.EventRecord) {
+	for i := range records {
+		a.ProcessRecord(&records[i])
+	}
+}
+
+// ProcessRecord handles a value-typed MIDI event
+func (a *Allocator) ProcessRecord(record *midi.EventRecord) {
+	switch record.Kind {
+	case midi.EventTypeNoteOn:
+		if record.Data2 > 0 {
+			a.NoteOn(record.Data1, record.Data2)
+		} else {
+			// Note on with velocity 0 is treated as note off
+			a.NoteOff(record.Data1, 0)
+		}
+	case midi.EventTypeNoteOff:
+		a.NoteOff(record.Data1, record.Data2)
+	case midi.EventTypeControlChange:
+		if record.Data1 == midi.CCSustain {
+			a.SetSustainPedal(record.Data2 >= 64)
+		}
+	}
+}
+
 // ProcessEvent handles a MIDI event
 func (a *Allocator) ProcessEvent(event midi.Event) {
 	switch e := event.(type) {
+	case *midi.EventRecord:
+		a.ProcessRecord(e)
+	case midi.EventRecord:
+		a.ProcessRecord(&e)
 	case midi.NoteOnEvent:
 		if e.Velocity > 0 {
 			a.NoteOn(e.NoteNumber, e.Velocity)
@@ -145,6 +185,10 @@ func (a *Allocator) ProcessEvent(event midi.Event) {
 
 // NoteOn handles a note on event
 func (a *Allocator) NoteOn(note uint8, velocity uint8) {
+	if note >= midiNotes {
+		return
+	}
+
 	switch a.mode {
 	case ModePoly:
 		a.noteOnPoly(note, velocity)
@@ -159,6 +203,10 @@ func (a *Allocator) NoteOn(note uint8, velocity uint8) {
 
 // NoteOff handles a note off event
 func (a *Allocator) NoteOff(note uint8, velocity uint8) {
+	if note >= midiNotes {
+		return
+	}
+
 	if a.sustainPedal {
 		// Mark note as sustained instead of releasing
 		a.sustainedNotes[note] = true
@@ -180,10 +228,12 @@ func (a *Allocator) SetSustainPedal(on bool) {
 	a.sustainPedal = on
 	if !on {
 		// Release all sustained notes
-		for note := range a.sustainedNotes {
-			a.NoteOff(note, 0)
+		for note, sustained := range a.sustainedNotes {
+			if sustained {
+				a.sustainedNotes[note] = false
+				a.NoteOff(uint8(note), 0)
+			}
 		}
-		a.sustainedNotes = make(map[uint8]bool)
 	}
 }
 
@@ -192,8 +242,8 @@ func (a *Allocator) Reset() {
 	for _, voice := range a.voices {
 		voice.Stop()
 	}
-	a.noteToVoice = make(map[uint8][]int)
-	a.sustainedNotes = make(map[uint8]bool)
+	a.clearNoteVoices()
+	a.sustainedNotes = [midiNotes]bool{}
 	a.sustainPedal = false
 	a.activeVoices = 0
 	a.currentNote = 0
@@ -212,10 +262,17 @@ func (a *Allocator) GetActiveVoiceCount() int {
 	return count
 }
 
+// clearNoteVoices removes every note-to-voice mapping
+func (a *Allocator) clearNoteVoices() {
+	for note := range a.noteVoices {
+		a.noteVoices[note] = a.noteVoices[note][:0]
+	}
+}
+
 // noteOnPoly handles poly mode note on
 func (a *Allocator) noteOnPoly(note uint8, velocity uint8) {
 	// Check if note is already playing
-	if voices, exists := a.noteToVoice[note]; exists && len(voices) > 0 {
+	if voices := a.noteVoices[note]; len(voices) > 0 {
 		// Retrigger the note on existing voice(s)
 		for _, idx := range voices {
 			a.voices[idx].TriggerNote(note, velocity)
@@ -236,17 +293,15 @@ func (a *Allocator) noteOnPoly(note uint8, velocity uint8) {
 
 	// Allocate the voice
 	a.voices[voiceIdx].TriggerNote(note, velocity)
-	a.noteToVoice[note] = []int{voiceIdx}
+	a.noteVoices[note] = append(a.noteVoices[note][:0], voiceIdx)
 }
 
 // noteOffPoly handles poly mode note off
 func (a *Allocator) noteOffPoly(note uint8, velocity uint8) {
-	if voices, exists := a.noteToVoice[note]; exists {
-		for _, idx := range voices {
-			a.voices[idx].ReleaseNote()
-		}
-		delete(a.noteToVoice, note)
+	for _, idx := range a.noteVoices[note] {
+		a.voices[idx].ReleaseNote()
 	}
+	a.noteVoices[note] = a.noteVoices[note][:0]
 }
 
 // noteOnMono handles mono mode note on
@@ -261,7 +316,8 @@ func (a *Allocator) noteOnMono(note uint8, velocity uint8) {
 	a.previousNote = a.currentNote
 	a.currentNote = note
 	a.voices[0].TriggerNote(note, velocity)
-	a.noteToVoice = map[uint8][]int{note: {0}}
+	a.clearNoteVoices()
+	a.noteVoices[note] = append(a.noteVoices[note], 0)
 }
 
 // noteOnLegato handles legato mode note on
@@ -275,7 +331,8 @@ func (a *Allocator) noteOnLegato(note uint8, velocity uint8) {
 		a.currentNote = note
 		a.glideActive = true
 		// Voice implementation should handle the pitch change
-		a.noteToVoice = map[uint8][]int{note: {0}}
+		a.clearNoteVoices()
+		a.noteVoices[note] = append(a.noteVoices[note], 0)
 	}
 }
 
@@ -283,7 +340,7 @@ func (a *Allocator) noteOnLegato(note uint8, velocity uint8) {
 func (a *Allocator) noteOffMono(note uint8, velocity uint8) {
 	if note == a.currentNote {
 		a.voices[0].ReleaseNote()
-		delete(a.noteToVoice, note)
+		a.noteVoices[note] = a.noteVoices[note][:0]
 		a.currentNote = 0
 		a.glideActive = false
 	}
@@ -295,10 +352,11 @@ func (a *Allocator) noteOnUnison(note uint8, velocity uint8) {
 	for i := 0; i < a.maxVoices; i++ {
 		a.voices[i].TriggerNote(note, velocity)
 	}
-	a.noteToVoice[note] = make([]int, a.maxVoices)
-	for i := range a.noteToVoice[note] {
-		a.noteToVoice[note][i] = i
+	voices := a.noteVoices[note][:0]
+	for i := 0; i < a.maxVoices; i++ {
+		voices = append(voices, i)
 	}
+	a.noteVoices[note] = voices
 	a.currentNote = note
 }
 
@@ -308,7 +366,7 @@ func (a *Allocator) noteOffUnison(note uint8, velocity uint8) {
 		for i := 0; i < a.maxVoices; i++ {
 			a.voices[i].ReleaseNote()
 		}
-		delete(a.noteToVoice, note)
+		a.noteVoices[note] = a.noteVoices[note][:0]
 		a.currentNote = 0
 	}
 }
@@ -370,16 +428,13 @@ func (a *Allocator) stealVoice() int {
 	}
 
 	if bestIdx != -1 {
-		// Remove the stolen voice from noteToVoice map
-		stolenNote := a.voices[bestIdx].GetNote()
-		if voices, exists := a.noteToVoice[stolenNote]; exists {
+		// Remove the stolen voice from its note mapping
+		if stolenNote := a.voices[bestIdx].GetNote(); stolenNote < midiNotes {
+			voices := a.noteVoices[stolenNote]
 			for i, idx := range voices {
 				if idx == bestIdx {
-					// Remove this index from the slice
-					a.noteToVoice[stolenNote] = append(voices[:i], voices[i+1:]...)
-					if len(a.noteToVoice[stolenNote]) == 0 {
-						delete(a.noteToVoice, stolenNote)
-					}
+					// Remove this index from the slice (in place, no allocation)
+					a.noteVoices[stolenNote] = append(voices[:i], voices[i+1:]...)
 					break
 				}
 			}
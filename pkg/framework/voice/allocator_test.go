@@ -311,7 +311,35 @@ func TestReset(t *testing.T) {
 	if allocator.sustainPedal {
 		t.Error("Reset should clear sustain pedal")
 	}
-	if len(allocator.noteToVoice) != 0 {
-		t.Error("Reset should clear note mappings")
+	for note, voices := range allocator.noteVoices {
+		if len(voices) != 0 {
+			t.Errorf("Reset should clear note mappings, note %d still mapped", note)
+		}
+	}
+}
+
+func TestProcessEventsZeroAllocations(t *testing.T) {
+	voices := createTestVoices(4)
+	allocator := NewAllocator(voices)
+	store := midi.NewEventStore(midi.DefaultEventCapacity)
+
+	// Enough notes to force stealing, plus sustain on/off
+	for i := int32(0); i < 8; i++ {
+		store.Add(midi.EventRecord{BaseEvent: midi.BaseEvent{Offset: i}, Kind: midi.EventTypeNoteOn, Data1: uint8(60 + i), Data2: 100})
 	}
-}
\ No newline at end of file
+	store.Add(midi.EventRecord{BaseEvent: midi.BaseEvent{Offset: 8}, Kind: midi.EventTypeControlChange, Data1: midi.CCSustain, Data2: 127})
+	for i := int32(0); i < 8; i++ {
+		store.Add(midi.EventRecord{BaseEvent: midi.BaseEvent{Offset: 9 + i}, Kind: midi.EventTypeNoteOff, Data1: uint8(60 + i)})
+	}
+	store.Add(midi.EventRecord{BaseEvent: midi.BaseEvent{Offset: 20}, Kind: midi.EventTypeControlChange, Data1: midi.CCSustain, Data2: 0})
+
+	allocs := testing.AllocsPerRun(100, func() {
+		allocator.ProcessEvents(store.Range(0, 512))
+	})
+	if allocs != 0 {
+		t.Errorf("ProcessEvents allocated %.1f times per block", allocs)
+	}
+	if allocator.GetActiveVoiceCount() != 0 {
+		t.Error("All notes should be released after sustain off")
+	}
+}
@@ -0,0 +1,253 @@
+package voice
+
+import (
+	"runtime"
+	"sync"
+	"sync/atomic"
+	"time"
+)
+
+// DefaultMinParallelWork is the estimated per-block render time below which
+// the Renderer stays on the calling thread
+const DefaultMinParallelWork = 50 * time.Microsecond
+
+// Renderer renders the active voices of a voice set and sums them into one
+// mono buffer. With workers started it splits the voices across the caller
+// and a fixed pool of goroutines locked to OS threads. Each participant
+// first renders its own share, then steals unclaimed voices from the others,
+// so voices of unequal cost balance out. Every participant accumulates into
+// its own bus, and the buses are summed at the end of the block.
+//
+// Small blocks are not worth the handoff. The renderer keeps a running
+// estimate of the per-voice cost and renders on the calling thread while the
+// estimated block cost is below the minimum parallel work.
+type Renderer struct {
+	voices       []Voice
+	active       []int32 // Indices of the voices rendered this block
+	maxBlockSize int
+
+	// participants[0] is the calling thread; the rest belong to workers
+	participants []*renderParticipant
+	workers      []*renderWorker
+	pending      sync.WaitGroup // Worker shares of the current block
+	running      sync.WaitGroup // Worker goroutines, joined by Stop
+	numSamples   int            // Length of the block being rendered
+	sharing      int            // Participants rendering the current block
+
+	minParallelWork time.Duration
+	voiceCost       float64 // Smoothed render time per voice, in nanoseconds
+}
+
+// renderParticipant is one thread's share of a block
+type renderParticipant struct {
+	cursor  atomic.Int32 // Next unclaimed slot in active
+	end     int32        // End of this participant's share
+	scratch []float32    // Output of the voice being rendered
+	bus     []float32    // Sum of every voice this participant rendered
+	mixed   bool         // Bus holds at least one voice this block
+	busy    time.Duration
+	_       [64]byte // Keep neighbouring cursors off the same cache line
+}
+
+// renderWorker parks a goroutine between blocks
+type renderWorker struct {
+	wake chan struct{}
+	self int // Participant index
+}
+
+// NewRenderer creates a renderer for voices and blocks of up to maxBlockSize samples
+func NewRenderer(voices []Voice, maxBlockSize int) *Renderer {
+	r := &Renderer{
+		voices:          voices,
+		active:          make([]int32, 0, len(voices)),
+		maxBlockSize:    maxBlockSize,
+		minParallelWork: DefaultMinParallelWork,
+	}
+	r.participants = []*renderParticipant{newRenderParticipant(maxBlockSize)}
+	return r
+}
+
+func newRenderParticipant(maxBlockSize int) *renderParticipant {
+	return &renderParticipant{
+		scratch: make([]float32, maxBlockSize),
+		bus:     make([]float32, maxBlockSize),
+	}
+}
+
+// SetMinParallelWork sets the estimated block render time below which voices
+// are rendered on the calling thread. Zero always uses the workers.
+func (r *Renderer) SetMinParallelWork(d time.Duration) {
+	r.minParallelWork = d
+}
+
+// Start starts numWorkers render goroutines in addition to the calling thread.
+// Call it at setup time, never from the audio thread.
+func (r *Renderer) Start(numWorkers int) {
+	r.Stop()
+
+	for w := 0; w < numWorkers; w++ {
+		worker := &renderWorker{
+			wake: make(chan struct{}, 1),
+			self: len(r.participants),
+		}
+		r.participants = append(r.participants, newRenderParticipant(r.maxBlockSize))
+		r.workers = append(r.workers, worker)
+		r.running.Add(1)
+		go r.runWorker(worker)
+	}
+}
+
+// Stop stops the render goroutines and waits for them to exit, releasing
+// their OS threads. It must not be called concurrently with Render.
+func (r *Renderer) Stop() {
+	for _, worker := range r.workers {
+		close(worker.wake)
+	}
+	r.running.Wait()
+	r.workers = nil
+	r.participants = r.participants[:1]
+}
+
+// Workers returns the number of running render goroutines
+func (r *Renderer) Workers() int {
+	return len(r.workers)
+}
+
+// Render sums every active voice into out and returns how many voices played
+func (r *Renderer) Render(out []float32) int {
+	numSamples := len(out)
+	if numSamples > r.maxBlockSize {
+		numSamples = r.maxBlockSize
+		out = out[:numSamples]
+	}
+	for i := range out {
+		out[i] = 0
+	}
+
+	r.active = r.active[:0]
+	for i, v := range r.voices {
+		if v != nil && v.IsActive() {
+			r.active = append(r.active, int32(i))
+		}
+	}
+	if len(r.active) == 0 {
+		return 0
+	}
+
+	r.numSamples = numSamples
+	participants := len(r.participants)
+	if participants > len(r.active) {
+		participants = len(r.active)
+	}
+	estimate := time.Duration(r.voiceCost * float64(len(r.active)))
+	if participants == 1 || estimate < r.minParallelWork {
+		participants = 1
+	}
+
+	r.sharing = participants
+	r.partition(participants)
+
+	if participants > 1 {
+		r.pending.Add(participants - 1)
+		for _, worker := range r.workers[:participants-1] {
+			worker.wake <- struct{}{}
+		}
+	}
+	r.renderShare(0)
+	if participants > 1 {
+		r.pending.Wait()
+	}
+
+	// Sum the buses; the calling thread's share is included here as well
+	var busy time.Duration
+	for _, p := range r.participants[:participants] {
+		busy += p.busy
+		if !p.mixed {
+			continue
+		}
+		bus := p.bus[:numSamples]
+		for i := range out {
+			out[i] += bus[i]
+		}
+	}
+
+	// Track the per-voice cost to decide whether the next block goes parallel
+	cost := float64(busy) / float64(len(r.active))
+	if r.voiceCost == 0 {
+		r.voiceCost = cost
+	} else {
+		r.voiceCost += 0.1 * (cost - r.voiceCost)
+	}
+
+	return len(r.active)
+}
+
+// partition splits the active voices into contiguous shares
+func (r *Renderer) partition(participants int) {
+	n := int32(len(r.active))
+	share := n / int32(participants)
+	extra := n % int32(participants)
+
+	start := int32(0)
+	for i, p := range r.participants {
+		if i >= participants {
+			p.cursor.Store(0)
+			p.end = 0
+			continue
+		}
+		end := start + share
+		if int32(i) < extra {
+			end++
+		}
+		p.cursor.Store(start)
+		p.end = end
+		start = end
+	}
+}
+
+// renderShare renders participant self's voices, then steals from the rest
+func (r *Renderer) renderShare(self int) {
+	p := r.participants[self]
+	p.mixed = false
+	start := time.Now()
+
+	for offset := 0; offset < r.sharing; offset++ {
+		victim := r.participants[(self+offset)%r.sharing]
+		for {
+			slot := victim.cursor.Add(1) - 1
+			if slot >= victim.end {
+				break
+			}
+			r.renderVoice(p, r.active[slot])
+		}
+	}
+
+	p.busy = time.Since(start)
+}
+
+// renderVoice renders one voice and accumulates it into the participant's bus
+func (r *Renderer) renderVoice(p *renderParticipant, index int32) {
+	scratch := p.scratch[:r.numSamples]
+	bus := p.bus[:r.numSamples]
+	r.voices[index].Process(scratch)
+
+	if !p.mixed {
+		copy(bus, scratch)
+		p.mixed = true
+		return
+	}
+	for i := range bus {
+		bus[i] += scratch[i]
+	}
+}
+
+func (r *Renderer) runWorker(worker *renderWorker) {
+	defer r.running.Done()
+	runtime.LockOSThread()
+	defer runtime.UnlockOSThread()
+
+	for range worker.wake {
+		r.renderShare(worker.self)
+		r.pending.Done()
+	}
+}
@@ -0,0 +1,142 @@
+package voice
+
+import (
+	"runtime"
+	"testing"
+)
+
+// renderVoice writes a constant level and does some busy work so the cost
+// varies between voices
+type renderVoice struct {
+	level float32
+	work  int
+}
+
+func (v *renderVoice) IsActive() bool                         { return v.level != 0 }
+func (v *renderVoice) GetNote() uint8                         { return 0 }
+func (v *renderVoice) GetVelocity() uint8                     { return 0 }
+func (v *renderVoice) GetAmplitude() float64                  { return float64(v.level) }
+func (v *renderVoice) GetAge() int64                          { return 0 }
+func (v *renderVoice) TriggerNote(note uint8, velocity uint8) {}
+func (v *renderVoice) ReleaseNote()                           {}
+func (v *renderVoice) Stop()                                  { v.level = 0 }
+func (v *renderVoice) Process(output []float32) {
+	acc := float32(0)
+	for i := 0; i < v.work; i++ {
+		acc += float32(i) * 1e-9
+	}
+	for i := range output {
+		output[i] = v.level + acc*0
+	}
+}
+
+func createRenderVoices(count int) ([]Voice, float32) {
+	voices := make([]Voice, count)
+	sum := float32(0)
+	for i := range voices {
+		v := &renderVoice{work: (i % 5) * 2000}
+		if i%3 != 0 {
+			v.level = float32(i%7+1) * 0.125
+		}
+		sum += v.level
+		voices[i] = v
+	}
+	return voices, sum
+}
+
+func TestRendererSum(t *testing.T) {
+	voices, sum := createRenderVoices(64)
+
+	for _, workers := range []int{0, 1, 3} {
+		renderer := NewRenderer(voices, 256)
+		renderer.SetMinParallelWork(0)
+		renderer.Start(workers)
+
+		for block := 0; block < 20; block++ {
+			out := make([]float32, 128)
+			renderer.Render(out)
+			for i, v := range out {
+				if v != sum {
+					t.Fatalf("%d workers, sample %d: expected %f, got %f", workers, i, sum, v)
+				}
+			}
+		}
+		renderer.Stop()
+	}
+}
+
+func TestRendererAdaptiveThreshold(t *testing.T) {
+	voices, _ := createRenderVoices(8) // Five active voices
+	for _, v := range voices {
+		v.(*renderVoice).work = 0
+	}
+	renderer := NewRenderer(voices, 64)
+	renderer.Start(2)
+	defer renderer.Stop()
+
+	// Cheap voices stay well under the default threshold
+	out := make([]float32, 64)
+	for block := 0; block < 10; block++ {
+		renderer.Render(out)
+	}
+	if renderer.sharing != 1 {
+		t.Errorf("Cheap blocks should render single-threaded, used %d participants", renderer.sharing)
+	}
+
+	renderer.SetMinParallelWork(0)
+	renderer.Render(out)
+	if renderer.sharing != 3 {
+		t.Errorf("Expected all participants with no threshold, used %d", renderer.sharing)
+	}
+}
+
+func TestRendererZeroAllocations(t *testing.T) {
+	voices, _ := createRenderVoices(32)
+	renderer := NewRenderer(voices, 256)
+	renderer.SetMinParallelWork(0)
+	renderer.Start(2)
+	defer renderer.Stop()
+
+	out := make([]float32, 256)
+	allocs := testing.AllocsPerRun(100, func() {
+		renderer.Render(out)
+	})
+	if allocs != 0 {
+		t.Errorf("Renderer allocated %.1f times per block", allocs)
+	}
+}
+
+func TestRendererStopJoinsWorkers(t *testing.T) {
+	voices, _ := createRenderVoices(8)
+	renderer := NewRenderer(voices, 64)
+	before := runtime.NumGoroutine()
+
+	// Activating and deactivating repeatedly must not pile up threads
+	for i := 0; i < 10; i++ {
+		renderer.Start(3)
+		renderer.Stop()
+	}
+	if after := runtime.NumGoroutine(); after != before {
+		t.Errorf("%d goroutines before, %d after Stop", before, after)
+	}
+	if renderer.Workers() != 0 {
+		t.Errorf("%d workers left after Stop", renderer.Workers())
+	}
+}
+
+func BenchmarkRenderer(b *testing.B) {
+	for _, workers := range []int{0, 1, 3} {
+		voices, _ := createRenderVoices(64)
+		renderer := NewRenderer(voices, 128)
+		renderer.SetMinParallelWork(0)
+		renderer.Start(workers)
+		out := make([]float32, 128)
+
+		b.Run(map[int]string{0: "Inline", 1: "TwoThreads", 3: "FourThreads"}[workers], func(b *testing.B) {
+			for i := 0; i < b.N; i++ {
+				renderer.Render(out)
+			}
+		})
+		renderer.Stop()
+	}
+}
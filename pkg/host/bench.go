@@ -0,0 +1,288 @@
+package host
+
+import (
+	"errors"
+	"math/bits"
+	"runtime"
+	"sort"
+	"time"
+)
+
+// Config describes one offline render
+type Config struct {
+	SampleRate      float64
+	BlockSize       int
+	Seconds         float64 // Length of the measured render in audio time
+	WarmupBlocks    int     // Blocks rendered before measuring
+	DoublePrecision bool
+
+	// Automation density: parameters automated per block (-1 for every
+	// automatable parameter) and points per parameter per block
+	AutomatedParams int
+	PointsPerBlock  int
+
+	// MIDI load: note events per block, alternating note on and off
+	NotesPerBlock int
+
+	// Silent input flagged by the host instead of noise
+	Silent bool
+}
+
+// DefaultConfig is a 10 second render at 48 kHz in 512-sample blocks with
+// four automated parameters
+func DefaultConfig() Config {
+	return Config{
+		SampleRate:      48000,
+		BlockSize:       512,
+		Seconds:         10,
+		WarmupBlocks:    32,
+		AutomatedParams: 4,
+		PointsPerBlock:  4,
+	}
+}
+
+// Report is the result of one render. RealTimeFactor is processing time over
+// audio time: below 1 the plugin renders faster than real time.
+type Report struct {
+	Plugin          string  `json:"plugin"`
+	SampleRate      float64 `json:"sample_rate"`
+	BlockSize       int     `json:"block_size"`
+	Blocks          int     `json:"blocks"`
+	DoublePrecision bool    `json:"double_precision"`
+	AutomatedParams int     `json:"automated_params"`
+	PointsPerBlock  int     `json:"points_per_block"`
+	NotesPerBlock   int     `json:"notes_per_block"`
+	Silent          bool    `json:"silent_input"`
+
+	AudioSeconds   float64 `json:"audio_seconds"`
+	ProcessSeconds float64 `json:"process_seconds"`
+	RealTimeFactor float64 `json:"realtime_factor"`
+
+	Latency LatencyReport `json:"block_latency"`
+
+	AllocsPerBlock float64 `json:"allocs_per_block"`
+	BytesPerBlock  float64 `json:"bytes_per_block"`
+	GCCycles       uint32  `json:"gc_cycles"`
+	GCPauseSeconds float64 `json:"gc_pause_seconds"`
+	GCPauseShare   float64 `json:"gc_pause_share"` // GC pause time over processing time
+
+	GoVersion string `json:"go_version"`
+}
+
+// LatencyReport summarizes the wall time of the process calls
+type LatencyReport struct {
+	BudgetNs   int64 `json:"budget_ns"` // Audio duration of one block
+	OverBudget int   `json:"over_budget"`
+	MinNs      int64 `json:"min_ns"`
+	MeanNs     int64 `json:"mean_ns"`
+	P50Ns      int64 `json:"p50_ns"`
+	P90Ns      int64 `json:"p90_ns"`
+	P99Ns      int64 `json:"p99_ns"`
+	P999Ns     int64 `json:"p999_ns"`
+	MaxNs      int64 `json:"max_ns"`
+
+	// Power-of-two buckets from 1 µs; each counts the blocks that took at
+	// most UpToNs and more than the previous bucket's bound
+	Histogram []Bucket `json:"histogram"`
+}
+
+// Bucket is one latency histogram bucket
+type Bucket struct {
+	UpToNs int64 `json:"up_to_ns"`
+	Count  int   `json:"count"`
+}
+
+// automationPeriod is the length of one automation sweep in seconds
+const automationPeriod = 2.0
+
+// Run renders the linked plugin offline and measures it
+func Run(cfg Config) (*Report, error) {
+	if cfg.SampleRate <= 0 || cfg.BlockSize <= 0 || cfg.Seconds <= 0 {
+		return nil, errors.New("sample rate, block size and length must be positive")
+	}
+	inst, err := Open()
+	if err != nil {
+		return nil, err
+	}
+	defer inst.Close()
+	if err := inst.Start(cfg.SampleRate, cfg.BlockSize, cfg.DoublePrecision); err != nil {
+		return nil, err
+	}
+
+	params := inst.AutomatableParameters()
+	if cfg.AutomatedParams >= 0 && cfg.AutomatedParams < len(params) {
+		params = params[:cfg.AutomatedParams]
+	}
+	if cfg.PointsPerBlock <= 0 {
+		params = nil
+	}
+
+	r := &renderer{
+		inst:   inst,
+		cfg:    cfg,
+		params: params,
+		seed:   1,
+	}
+	if cfg.Silent {
+		inst.SetInputSilence(true)
+	}
+
+	for i := 0; i < cfg.WarmupBlocks; i++ {
+		if err := r.block(); err != nil {
+			return nil, err
+		}
+	}
+
+	blocks := int(cfg.Seconds*cfg.SampleRate) / cfg.BlockSize
+	if blocks < 1 {
+		blocks = 1
+	}
+	latencies := make([]int64, blocks)
+
+	runtime.GC()
+	var before, after runtime.MemStats
+	runtime.ReadMemStats(&before)
+	for i := range latencies {
+		r.stage()
+		start := time.Now()
+		err := inst.Process(cfg.BlockSize)
+		latencies[i] = int64(time.Since(start))
+		if err != nil {
+			return nil, err
+		}
+	}
+	runtime.ReadMemStats(&after)
+
+	report := &Report{
+		Plugin:          inst.Name(),
+		SampleRate:      cfg.SampleRate,
+		BlockSize:       cfg.BlockSize,
+		Blocks:          blocks,
+		DoublePrecision: cfg.DoublePrecision,
+		AutomatedParams: len(params),
+		PointsPerBlock:  cfg.PointsPerBlock,
+		NotesPerBlock:   cfg.NotesPerBlock,
+		Silent:          cfg.Silent,
+		AudioSeconds:    float64(blocks*cfg.BlockSize) / cfg.SampleRate,
+		AllocsPerBlock:  float64(after.Mallocs-before.Mallocs) / float64(blocks),
+		BytesPerBlock:   float64(after.TotalAlloc-before.TotalAlloc) / float64(blocks),
+		GCCycles:        after.NumGC - before.NumGC,
+		GCPauseSeconds:  float64(after.PauseTotalNs-before.PauseTotalNs) / 1e9,
+		GoVersion:       runtime.Version(),
+	}
+	var total int64
+	for _, l := range latencies {
+		total += l
+	}
+	report.ProcessSeconds = float64(total) / 1e9
+	report.Latency = summarize(latencies, total, int64(float64(cfg.BlockSize)/cfg.SampleRate*1e9))
+	report.RealTimeFactor = report.ProcessSeconds / report.AudioSeconds
+	if report.ProcessSeconds > 0 {
+		report.GCPauseShare = report.GCPauseSeconds / report.ProcessSeconds
+	}
+	return report, nil
+}
+
+// renderer stages the input, automation and notes of each block without
+// allocating, so the measured allocations are the plugin's own
+type renderer struct {
+	inst   *Instance
+	cfg    Config
+	params []uint32
+	sample int64  // Samples rendered so far
+	notes  int    // Note events sent so far
+	seed   uint32 // Noise generator state
+}
+
+func (r *renderer) block() error {
+	r.stage()
+	return r.inst.Process(r.cfg.BlockSize)
+}
+
+// stage fills the inputs and queues the next block's events
+func (r *renderer) stage() {
+	n := r.cfg.BlockSize
+	if !r.cfg.Silent {
+		for bus, channels := range r.inst.InputChannels() {
+			for ch := 0; ch < channels; ch++ {
+				if r.cfg.DoublePrecision {
+					in := r.inst.Input64(bus, ch)
+					for i := range in[:n] {
+						in[i] = float64(r.noise())
+					}
+				} else {
+					in := r.inst.Input32(bus, ch)
+					for i := range in[:n] {
+						in[i] = r.noise()
+					}
+				}
+			}
+		}
+	}
+
+	r.inst.ClearBlock()
+	periodSamples := automationPeriod * r.cfg.SampleRate
+	for p, id := range r.params {
+		for k := 0; k < r.cfg.PointsPerBlock; k++ {
+			offset := k * n / r.cfg.PointsPerBlock
+			// Triangle sweep over the full range, each parameter out of phase
+			phase := float64(r.sample+int64(offset))/periodSamples + float64(p)/float64(len(r.params))
+			phase -= float64(int64(phase))
+			value := 2 * phase
+			if value > 1 {
+				value = 2 - value
+			}
+			r.inst.AddParameterPoint(id, offset, value)
+		}
+	}
+	for k := 0; k < r.cfg.NotesPerBlock; k++ {
+		on := r.notes%2 == 0
+		note := r.notes / 2
+		r.inst.AddNote(k*n/r.cfg.NotesPerBlock, on, 48+note%24, 0.8, note)
+		r.notes++
+	}
+	r.sample += int64(n)
+}
+
+// noise returns white noise at -12 dBFS from a xorshift generator
+func (r *renderer) noise() float32 {
+	r.seed ^= r.seed << 13
+	r.seed ^= r.seed >> 17
+	r.seed ^= r.seed << 5
+	return (float32(r.seed)/float32(1<<32)*2 - 1) * 0.25
+}
+
+// summarize sorts latencies in place and builds the latency report
+func summarize(latencies []int64, total, budget int64) LatencyReport {
+	report := LatencyReport{BudgetNs: budget}
+	for _, l := range latencies {
+		if l > budget {
+			report.OverBudget++
+		}
+	}
+	report.MeanNs = total / int64(len(latencies))
+
+	sort.Slice(latencies, func(i, j int) bool { return latencies[i] < latencies[j] })
+	percentile := func(p float64) int64 {
+		return latencies[int(p*float64(len(latencies)-1))]
+	}
+	report.MinNs = latencies[0]
+	report.P50Ns = percentile(0.50)
+	report.P90Ns = percentile(0.90)
+	report.P99Ns = percentile(0.99)
+	report.P999Ns = percentile(0.999)
+	report.MaxNs = latencies[len(latencies)-1]
+
+	const firstBucket = int64(time.Microsecond)
+	for _, l := range latencies {
+		index := 0
+		if l > firstBucket {
+			index = bits.Len64(uint64((l - 1) / firstBucket))
+		}
+		for len(report.Histogram) <= index {
+			report.Histogram = append(report.Histogram, Bucket{UpToNs: firstBucket << len(report.Histogram)})
+		}
+		report.Histogram[index].Count++
+	}
+	return report
+}
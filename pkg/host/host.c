@@ -0,0 +1,312 @@
+#include "host.h"
+#include <string.h>
+
+// Entry point of the plugin linked into this binary (bridge/bridge.c)
+extern struct Steinberg_IPluginFactory* GetPluginFactory();
+
+#define COMPONENT_VTBL(host) ((struct Steinberg_Vst_IComponentVtbl*)(host)->component->lpVtbl)
+#define PROCESSOR_VTBL(host) ((struct Steinberg_Vst_IAudioProcessorVtbl*)(host)->processor->lpVtbl)
+#define CONTROLLER_VTBL(host) ((struct Steinberg_Vst_IEditControllerVtbl*)(host)->controller->lpVtbl)
+
+// The lists are owned by the host, so reference counting is a no-op
+static Steinberg_tresult SMTG_STDMETHODCALLTYPE list_queryInterface(void* thisInterface, const Steinberg_TUID iid, void** obj) {
+    *obj = NULL;
+    return Steinberg_kNoInterface;
+}
+
+static Steinberg_uint32 SMTG_STDMETHODCALLTYPE list_addRef(void* thisInterface) {
+    return 1;
+}
+
+static Steinberg_uint32 SMTG_STDMETHODCALLTYPE list_release(void* thisInterface) {
+    return 1;
+}
+
+// IParamValueQueue
+static Steinberg_Vst_ParamID SMTG_STDMETHODCALLTYPE queue_getParameterId(void* thisInterface) {
+    return ((HostParamQueue*)thisInterface)->id;
+}
+
+static Steinberg_int32 SMTG_STDMETHODCALLTYPE queue_getPointCount(void* thisInterface) {
+    return ((HostParamQueue*)thisInterface)->count;
+}
+
+static Steinberg_tresult SMTG_STDMETHODCALLTYPE queue_getPoint(void* thisInterface, Steinberg_int32 index, Steinberg_int32* sampleOffset, Steinberg_Vst_ParamValue* value) {
+    HostParamQueue* queue = (HostParamQueue*)thisInterface;
+    if (index < 0 || index >= queue->count) {
+        return Steinberg_kInvalidArgument;
+    }
+    *sampleOffset = queue->offsets[index];
+    *value = queue->values[index];
+    return Steinberg_kResultOk;
+}
+
+static Steinberg_tresult SMTG_STDMETHODCALLTYPE queue_addPoint(void* thisInterface, Steinberg_int32 sampleOffset, Steinberg_Vst_ParamValue value, Steinberg_int32* index) {
+    HostParamQueue* queue = (HostParamQueue*)thisInterface;
+    if (queue->count >= HOST_MAX_POINTS) {
+        return Steinberg_kResultFalse;
+    }
+    queue->offsets[queue->count] = sampleOffset;
+    queue->values[queue->count] = value;
+    if (index) {
+        *index = queue->count;
+    }
+    queue->count++;
+    return Steinberg_kResultOk;
+}
+
+static struct Steinberg_Vst_IParamValueQueueVtbl queueVtbl = {
+    list_queryInterface,
+    list_addRef,
+    list_release,
+    queue_getParameterId,
+    queue_getPointCount,
+    queue_getPoint,
+    queue_addPoint
+};
+
+// IParameterChanges
+static Steinberg_int32 SMTG_STDMETHODCALLTYPE changes_getParameterCount(void* thisInterface) {
+    return ((HostParamChanges*)thisInterface)->count;
+}
+
+static struct Steinberg_Vst_IParamValueQueue* SMTG_STDMETHODCALLTYPE changes_getParameterData(void* thisInterface, Steinberg_int32 index) {
+    HostParamChanges* changes = (HostParamChanges*)thisInterface;
+    if (index < 0 || index >= changes->count) {
+        return NULL;
+    }
+    return (struct Steinberg_Vst_IParamValueQueue*)&changes->queues[index];
+}
+
+static struct Steinberg_Vst_IParamValueQueue* SMTG_STDMETHODCALLTYPE changes_addParameterData(void* thisInterface, const Steinberg_Vst_ParamID* id, Steinberg_int32* index) {
+    HostParamChanges* changes = (HostParamChanges*)thisInterface;
+    for (int32_t i = 0; i < changes->count; i++) {
+        if (changes->queues[i].id == *id) {
+            *index = i;
+            return (struct Steinberg_Vst_IParamValueQueue*)&changes->queues[i];
+        }
+    }
+    if (changes->count >= HOST_MAX_PARAMS) {
+        return NULL;
+    }
+    HostParamQueue* queue = &changes->queues[changes->count];
+    queue->id = *id;
+    queue->count = 0;
+    *index = changes->count++;
+    return (struct Steinberg_Vst_IParamValueQueue*)queue;
+}
+
+static struct Steinberg_Vst_IParameterChangesVtbl changesVtbl = {
+    list_queryInterface,
+    list_addRef,
+    list_release,
+    changes_getParameterCount,
+    changes_getParameterData,
+    changes_addParameterData
+};
+
+// IEventList
+static Steinberg_int32 SMTG_STDMETHODCALLTYPE events_getEventCount(void* thisInterface) {
+    return ((HostEventList*)thisInterface)->count;
+}
+
+static Steinberg_tresult SMTG_STDMETHODCALLTYPE events_getEvent(void* thisInterface, Steinberg_int32 index, struct Steinberg_Vst_Event* e) {
+    HostEventList* list = (HostEventList*)thisInterface;
+    if (index < 0 || index >= list->count) {
+        return Steinberg_kInvalidArgument;
+    }
+    *e = list->events[index];
+    return Steinberg_kResultOk;
+}
+
+static Steinberg_tresult SMTG_STDMETHODCALLTYPE events_addEvent(void* thisInterface, struct Steinberg_Vst_Event* e) {
+    HostEventList* list = (HostEventList*)thisInterface;
+    if (list->count >= HOST_MAX_EVENTS) {
+        return Steinberg_kResultFalse;
+    }
+    list->events[list->count++] = *e;
+    return Steinberg_kResultOk;
+}
+
+static struct Steinberg_Vst_IEventListVtbl eventsVtbl = {
+    list_queryInterface,
+    list_addRef,
+    list_release,
+    events_getEventCount,
+    events_getEvent,
+    events_addEvent
+};
+
+void hostInitLists(HostInstance* host) {
+    host->inputParams.lpVtbl = &changesVtbl;
+    host->outputParams.lpVtbl = &changesVtbl;
+    for (int i = 0; i < HOST_MAX_PARAMS; i++) {
+        host->inputParams.queues[i].lpVtbl = &queueVtbl;
+        host->outputParams.queues[i].lpVtbl = &queueVtbl;
+    }
+    host->inputEvents.lpVtbl = &eventsVtbl;
+    host->outputEvents.lpVtbl = &eventsVtbl;
+
+    host->data.inputs = host->inputs;
+    host->data.outputs = host->outputs;
+    host->data.inputParameterChanges = (struct Steinberg_Vst_IParameterChanges*)&host->inputParams;
+    host->data.outputParameterChanges = (struct Steinberg_Vst_IParameterChanges*)&host->outputParams;
+    host->data.inputEvents = (struct Steinberg_Vst_IEventList*)&host->inputEvents;
+    host->data.outputEvents = (struct Steinberg_Vst_IEventList*)&host->outputEvents;
+    host->data.processContext = &host->context;
+}
+
+Steinberg_tresult hostOpen(HostInstance* host, int32_t classIndex, char* name, int32_t nameLen) {
+    host->factory = GetPluginFactory();
+    if (!host->factory) {
+        return Steinberg_kResultFalse;
+    }
+    if (classIndex < 0 || classIndex >= host->factory->lpVtbl->countClasses(host->factory)) {
+        return Steinberg_kInvalidArgument;
+    }
+
+    struct Steinberg_PClassInfo info;
+    memset(&info, 0, sizeof(info));
+    Steinberg_tresult result = host->factory->lpVtbl->getClassInfo(host->factory, classIndex, &info);
+    if (result != Steinberg_kResultOk) {
+        return result;
+    }
+    if (nameLen > 0) {
+        strncpy(name, info.name, nameLen - 1);
+        name[nameLen - 1] = 0;
+    }
+
+    void* obj = NULL;
+    result = host->factory->lpVtbl->createInstance(host->factory, info.cid, Steinberg_Vst_IComponent_iid, &obj);
+    if (result != Steinberg_kResultOk || !obj) {
+        return result != Steinberg_kResultOk ? result : Steinberg_kResultFalse;
+    }
+    host->component = (struct Steinberg_FUnknown*)obj;
+
+    result = COMPONENT_VTBL(host)->initialize(host->component, NULL);
+    if (result != Steinberg_kResultOk) {
+        return result;
+    }
+
+    obj = NULL;
+    result = host->component->lpVtbl->queryInterface(host->component, Steinberg_Vst_IAudioProcessor_iid, &obj);
+    if (result != Steinberg_kResultOk || !obj) {
+        return Steinberg_kNoInterface;
+    }
+    host->processor = (struct Steinberg_FUnknown*)obj;
+
+    obj = NULL;
+    if (host->component->lpVtbl->queryInterface(host->component, Steinberg_Vst_IEditController_iid, &obj) == Steinberg_kResultOk) {
+        host->controller = (struct Steinberg_FUnknown*)obj;
+    }
+
+    hostInitLists(host);
+    return Steinberg_kResultOk;
+}
+
+int32_t hostBusCount(HostInstance* host, int32_t direction) {
+    return COMPONENT_VTBL(host)->getBusCount(host->component, Steinberg_Vst_MediaTypes_kAudio, direction);
+}
+
+int32_t hostBusChannels(HostInstance* host, int32_t direction, int32_t index) {
+    struct Steinberg_Vst_BusInfo info;
+    memset(&info, 0, sizeof(info));
+    if (COMPONENT_VTBL(host)->getBusInfo(host->component, Steinberg_Vst_MediaTypes_kAudio, direction, index, &info) != Steinberg_kResultOk) {
+        return 0;
+    }
+    return info.channelCount;
+}
+
+int32_t hostParameterCount(HostInstance* host) {
+    if (!host->controller) {
+        return 0;
+    }
+    return CONTROLLER_VTBL(host)->getParameterCount(host->controller);
+}
+
+Steinberg_tresult hostParameterInfo(HostInstance* host, int32_t index, uint32_t* id, int32_t* flags) {
+    struct Steinberg_Vst_ParameterInfo info;
+    memset(&info, 0, sizeof(info));
+    Steinberg_tresult result = CONTROLLER_VTBL(host)->getParameterInfo(host->controller, index, &info);
+    *id = info.id;
+    *flags = info.flags;
+    return result;
+}
+
+Steinberg_tresult hostStart(HostInstance* host, double sampleRate, int32_t maxBlockSize, int32_t sampleSize) {
+    struct Steinberg_Vst_ProcessSetup setup;
+    setup.processMode = 2; // kOffline
+    setup.symbolicSampleSize = sampleSize;
+    setup.maxSamplesPerBlock = maxBlockSize;
+    setup.sampleRate = sampleRate;
+
+    Steinberg_tresult result = PROCESSOR_VTBL(host)->canProcessSampleSize(host->processor, sampleSize);
+    if (result != Steinberg_kResultOk) {
+        return result;
+    }
+    result = PROCESSOR_VTBL(host)->setupProcessing(host->processor, &setup);
+    if (result != Steinberg_kResultOk) {
+        return result;
+    }
+    result = COMPONENT_VTBL(host)->setActive(host->component, 1);
+    if (result != Steinberg_kResultOk) {
+        return result;
+    }
+
+    host->data.processMode = setup.processMode;
+    host->data.symbolicSampleSize = sampleSize;
+    host->context.sampleRate = sampleRate;
+    return PROCESSOR_VTBL(host)->setProcessing(host->processor, 1);
+}
+
+void hostSetBus(HostInstance* host, int32_t direction, int32_t index, int32_t numChannels, void** buffers) {
+    struct Steinberg_Vst_AudioBusBuffers* bus = direction == Steinberg_Vst_BusDirections_kInput ? &host->inputs[index] : &host->outputs[index];
+    bus->numChannels = numChannels;
+    bus->silenceFlags = 0;
+    bus->Steinberg_Vst_AudioBusBuffers_channelBuffers32 = (Steinberg_Vst_Sample32**)buffers;
+}
+
+void hostAddNote(HostInstance* host, int32_t sampleOffset, int32_t on, int16_t pitch, float velocity, int32_t noteId) {
+    HostEventList* list = &host->inputEvents;
+    if (list->count >= HOST_MAX_EVENTS) {
+        return;
+    }
+    struct Steinberg_Vst_Event* e = &list->events[list->count++];
+    memset(e, 0, sizeof(*e));
+    e->sampleOffset = sampleOffset;
+    if (on) {
+        e->type = Steinberg_Vst_Event_EventTypes_kNoteOnEvent;
+        e->Steinberg_Vst_Event_noteOn.pitch = pitch;
+        e->Steinberg_Vst_Event_noteOn.velocity = velocity;
+        e->Steinberg_Vst_Event_noteOn.noteId = noteId;
+    } else {
+        e->type = Steinberg_Vst_Event_EventTypes_kNoteOffEvent;
+        e->Steinberg_Vst_Event_noteOff.pitch = pitch;
+        e->Steinberg_Vst_Event_noteOff.velocity = velocity;
+        e->Steinberg_Vst_Event_noteOff.noteId = noteId;
+    }
+}
+
+Steinberg_tresult hostProcess(HostInstance* host) {
+    host->outputParams.count = 0;
+    host->outputEvents.count = 0;
+    return PROCESSOR_VTBL(host)->process(host->processor, &host->data);
+}
+
+void hostClose(HostInstance* host) {
+    if (host->processor) {
+        PROCESSOR_VTBL(host)->setProcessing(host->processor, 0);
+        COMPONENT_VTBL(host)->setActive(host->component, 0);
+        host->processor->lpVtbl->release(host->processor);
+        host->processor = NULL;
+    }
+    if (host->controller) {
+        host->controller->lpVtbl->release(host->controller);
+        host->controller = NULL;
+    }
+    if (host->component) {
+        COMPONENT_VTBL(host)->terminate(host->component);
+        host->component->lpVtbl->release(host->component);
+        host->component = NULL;
+    }
+}
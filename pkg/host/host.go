@@ -0,0 +1,257 @@
+// Package host is a headless VST3 host for offline rendering and benchmarking.
+//
+// It drives the plugin linked into the current binary through its C ABI
+// exactly as a DAW would: GetPluginFactory, createInstance, setupProcessing,
+// setActive and IAudioProcessor::process with host-owned buffers, parameter
+// queues and event lists. A Go binary cannot dlopen a c-shared Go plugin (it
+// would bring up a second runtime), so the plugin is linked in instead and
+// the host calls back into it through the same entry points a DAW uses.
+package host
+
+// #cgo CFLAGS: -I${SRCDIR}/../../include
+// #include <stdlib.h>
+// #include "host.h"
+import "C"
+
+import (
+	"errors"
+	"fmt"
+	"unsafe"
+
+	"github.com/justyntemme/vst3go/pkg/framework/param"
+
+	// Links the C bridge that exports GetPluginFactory
+	_ "github.com/justyntemme/vst3go/pkg/plugin/cbridge"
+)
+
+// Instance is one plugin instance with its host-side buffers. All memory the
+// plugin sees is allocated in C.
+type Instance struct {
+	c    *C.HostInstance
+	name string
+
+	inputChannels  []int
+	outputChannels []int
+	sampleSize     int // Bytes per sample, 4 or 8
+	maxBlockSize   int
+
+	// C memory: one pointer array per bus, one buffer per channel
+	busPointers []unsafe.Pointer
+	channels    []unsafe.Pointer
+	inputs      [][]unsafe.Pointer
+	outputs     [][]unsafe.Pointer
+}
+
+// Open creates and initializes the first class of the linked plugin
+func Open() (*Instance, error) {
+	inst := &Instance{c: (*C.HostInstance)(C.calloc(1, C.sizeof_HostInstance))}
+	var name [64]C.char
+	if result := C.hostOpen(inst.c, 0, &name[0], C.int32_t(len(name))); result != C.Steinberg_kResultOk {
+		inst.Close()
+		return nil, fmt.Errorf("opening plugin failed with result %d", int(result))
+	}
+	inst.name = C.GoString(&name[0])
+
+	for dir, channels := range []*[]int{&inst.inputChannels, &inst.outputChannels} {
+		count := int(C.hostBusCount(inst.c, C.int32_t(dir)))
+		if count > C.HOST_MAX_BUSES {
+			inst.Close()
+			return nil, fmt.Errorf("plugin has %d buses, host supports %d", count, C.HOST_MAX_BUSES)
+		}
+		for i := 0; i < count; i++ {
+			*channels = append(*channels, int(C.hostBusChannels(inst.c, C.int32_t(dir), C.int32_t(i))))
+		}
+	}
+	return inst, nil
+}
+
+// Name returns the plugin class name
+func (inst *Instance) Name() string {
+	return inst.name
+}
+
+// AutomatableParameters returns the ids of parameters a host would automate:
+// automatable, writable and not the bypass switch
+func (inst *Instance) AutomatableParameters() []uint32 {
+	var ids []uint32
+	for i := 0; i < int(C.hostParameterCount(inst.c)); i++ {
+		var id C.uint32_t
+		var flags C.int32_t
+		if C.hostParameterInfo(inst.c, C.int32_t(i), &id, &flags) != C.Steinberg_kResultOk {
+			continue
+		}
+		if uint32(flags)&param.CanAutomate != 0 && uint32(flags)&(param.IsReadOnly|param.IsBypass) == 0 {
+			ids = append(ids, uint32(id))
+		}
+	}
+	return ids
+}
+
+// Start allocates the channel buffers and starts processing
+func (inst *Instance) Start(sampleRate float64, maxBlockSize int, doublePrecision bool) error {
+	sampleSize, symbolic := 4, C.int32_t(0) // kSample32
+	if doublePrecision {
+		sampleSize, symbolic = 8, 1 // kSample64
+	}
+	inst.sampleSize = sampleSize
+	inst.maxBlockSize = maxBlockSize
+
+	inst.inputs = inst.allocateBuses(C.Steinberg_Vst_BusDirections_kInput, inst.inputChannels)
+	inst.outputs = inst.allocateBuses(C.Steinberg_Vst_BusDirections_kOutput, inst.outputChannels)
+	inst.c.data.numInputs = C.int32_t(len(inst.inputChannels))
+	inst.c.data.numOutputs = C.int32_t(len(inst.outputChannels))
+
+	if result := C.hostStart(inst.c, C.double(sampleRate), C.int32_t(maxBlockSize), symbolic); result != C.Steinberg_kResultOk {
+		if doublePrecision && result == C.Steinberg_kResultFalse {
+			return errors.New("plugin does not support 64-bit processing")
+		}
+		return fmt.Errorf("starting processing failed with result %d", int(result))
+	}
+	inst.c.context.state = C.Steinberg_Vst_ProcessContext_StatesAndFlags_kPlaying |
+		C.Steinberg_Vst_ProcessContext_StatesAndFlags_kTempoValid |
+		C.Steinberg_Vst_ProcessContext_StatesAndFlags_kTimeSigValid
+	inst.c.context.tempo = 120
+	inst.c.context.timeSigNumerator = 4
+	inst.c.context.timeSigDenominator = 4
+	return nil
+}
+
+func (inst *Instance) allocateBuses(direction C.int32_t, channels []int) [][]unsafe.Pointer {
+	buses := make([][]unsafe.Pointer, len(channels))
+	for i, n := range channels {
+		pointers := C.calloc(C.size_t(n+1), C.size_t(unsafe.Sizeof(uintptr(0))))
+		inst.busPointers = append(inst.busPointers, pointers)
+		array := unsafe.Slice((*unsafe.Pointer)(pointers), n)
+		for ch := range array {
+			array[ch] = C.calloc(C.size_t(inst.maxBlockSize), C.size_t(inst.sampleSize))
+			inst.channels = append(inst.channels, array[ch])
+		}
+		buses[i] = array
+		C.hostSetBus(inst.c, direction, C.int32_t(i), C.int32_t(n), (*unsafe.Pointer)(pointers))
+	}
+	return buses
+}
+
+// Input32 returns channel ch of input bus as a slice over the C buffer. It
+// is only valid in 32-bit mode; see Input64.
+func (inst *Instance) Input32(bus, ch int) []float32 {
+	return unsafe.Slice((*float32)(inst.inputs[bus][ch]), inst.maxBlockSize)
+}
+
+// Input64 returns channel ch of input bus in 64-bit mode
+func (inst *Instance) Input64(bus, ch int) []float64 {
+	return unsafe.Slice((*float64)(inst.inputs[bus][ch]), inst.maxBlockSize)
+}
+
+// Output32 returns channel ch of output bus in 32-bit mode
+func (inst *Instance) Output32(bus, ch int) []float32 {
+	return unsafe.Slice((*float32)(inst.outputs[bus][ch]), inst.maxBlockSize)
+}
+
+// Output64 returns channel ch of output bus in 64-bit mode
+func (inst *Instance) Output64(bus, ch int) []float64 {
+	return unsafe.Slice((*float64)(inst.outputs[bus][ch]), inst.maxBlockSize)
+}
+
+// InputChannels returns the channel count of every input bus
+func (inst *Instance) InputChannels() []int {
+	return inst.inputChannels
+}
+
+// OutputChannels returns the channel count of every output bus
+func (inst *Instance) OutputChannels() []int {
+	return inst.outputChannels
+}
+
+// ClearBlock empties the parameter changes and events staged for the next
+// block
+func (inst *Instance) ClearBlock() {
+	inst.c.inputParams.count = 0
+	inst.c.inputEvents.count = 0
+}
+
+// AddParameterPoint stages an automation point for the next block. Points of
+// one parameter must be added in sample order. It reports false when the
+// host's fixed-size queues are full.
+func (inst *Instance) AddParameterPoint(id uint32, sampleOffset int, value float64) bool {
+	changes := &inst.c.inputParams
+	index := -1
+	for i := 0; i < int(changes.count); i++ {
+		if uint32(changes.queues[i].id) == id {
+			index = i
+			break
+		}
+	}
+	if index < 0 {
+		if changes.count >= C.HOST_MAX_PARAMS {
+			return false
+		}
+		index = int(changes.count)
+		changes.count++
+		changes.queues[index].id = C.Steinberg_Vst_ParamID(id)
+		changes.queues[index].count = 0
+	}
+
+	queue := &changes.queues[index]
+	if queue.count >= C.HOST_MAX_POINTS {
+		return false
+	}
+	queue.offsets[queue.count] = C.int32_t(sampleOffset)
+	queue.values[queue.count] = C.double(value)
+	queue.count++
+	return true
+}
+
+// AddNote stages a note on or off for the next block
+func (inst *Instance) AddNote(sampleOffset int, on bool, pitch int, velocity float32, noteID int) {
+	var flag C.int32_t
+	if on {
+		flag = 1
+	}
+	C.hostAddNote(inst.c, C.int32_t(sampleOffset), flag, C.int16_t(pitch), C.float(velocity), C.int32_t(noteID))
+}
+
+// Process renders one block of numSamples with the staged parameter changes
+// and events, then advances the transport
+func (inst *Instance) Process(numSamples int) error {
+	if numSamples > inst.maxBlockSize {
+		return fmt.Errorf("block of %d samples exceeds the maximum of %d", numSamples, inst.maxBlockSize)
+	}
+	inst.c.data.numSamples = C.int32_t(numSamples)
+	if result := C.hostProcess(inst.c); result != C.Steinberg_kResultOk {
+		return fmt.Errorf("process failed with result %d", int(result))
+	}
+	inst.c.context.projectTimeSamples += C.Steinberg_int64(numSamples)
+	inst.c.context.continousTimeSamples += C.Steinberg_int64(numSamples)
+	return nil
+}
+
+// SetInputSilence sets the silence flags of every input bus, as a host does
+// for silent tracks. The flags stay set until changed.
+func (inst *Instance) SetInputSilence(silent bool) {
+	for i, n := range inst.inputChannels {
+		var flags C.Steinberg_uint64
+		if silent {
+			flags = C.Steinberg_uint64(1)<<uint(n) - 1
+		}
+		inst.c.inputs[i].silenceFlags = flags
+	}
+}
+
+// Close stops processing, releases the plugin and frees all C memory
+func (inst *Instance) Close() {
+	if inst.c == nil {
+		return
+	}
+	C.hostClose(inst.c)
+	for _, p := range inst.channels {
+		C.free(p)
+	}
+	for _, p := range inst.busPointers {
+		C.free(p)
+	}
+	C.free(unsafe.Pointer(inst.c))
+	inst.c = nil
+	inst.channels = nil
+	inst.busPointers = nil
+}
@@ -0,0 +1,85 @@
+#ifndef VST3GO_HOST_H
+#define VST3GO_HOST_H
+
+#include "../../include/vst3/vst3_c_api.h"
+
+// Internal to the bench binary: never exported from a shared object
+#pragma GCC visibility push(hidden)
+
+// Capacities of the host-side parameter and event lists per block
+#define HOST_MAX_PARAMS 64
+#define HOST_MAX_POINTS 64
+#define HOST_MAX_EVENTS 512
+#define HOST_MAX_BUSES 8
+
+typedef struct {
+    struct Steinberg_Vst_IParamValueQueueVtbl* lpVtbl;
+    Steinberg_Vst_ParamID id;
+    int32_t count;
+    int32_t offsets[HOST_MAX_POINTS];
+    double values[HOST_MAX_POINTS];
+} HostParamQueue;
+
+typedef struct {
+    struct Steinberg_Vst_IParameterChangesVtbl* lpVtbl;
+    int32_t count;
+    HostParamQueue queues[HOST_MAX_PARAMS];
+} HostParamChanges;
+
+typedef struct {
+    struct Steinberg_Vst_IEventListVtbl* lpVtbl;
+    int32_t count;
+    struct Steinberg_Vst_Event events[HOST_MAX_EVENTS];
+} HostEventList;
+
+// One plugin instance driven the way a host drives it. Everything the
+// plugin sees lives in C memory.
+typedef struct {
+    struct Steinberg_IPluginFactory* factory;
+    struct Steinberg_FUnknown* component;  // IComponent
+    struct Steinberg_FUnknown* processor;  // IAudioProcessor
+    struct Steinberg_FUnknown* controller; // IEditController, may be NULL
+
+    HostParamChanges inputParams;
+    HostParamChanges outputParams;
+    HostEventList inputEvents;
+    HostEventList outputEvents;
+
+    struct Steinberg_Vst_AudioBusBuffers inputs[HOST_MAX_BUSES];
+    struct Steinberg_Vst_AudioBusBuffers outputs[HOST_MAX_BUSES];
+    struct Steinberg_Vst_ProcessContext context;
+    struct Steinberg_Vst_ProcessData data;
+} HostInstance;
+
+// Creates and initializes class index of the linked plugin's factory
+Steinberg_tresult hostOpen(HostInstance* host, int32_t classIndex, char* name, int32_t nameLen);
+
+// Number of buses and the channel count of one bus; direction is kInput or kOutput
+int32_t hostBusCount(HostInstance* host, int32_t direction);
+int32_t hostBusChannels(HostInstance* host, int32_t direction, int32_t index);
+
+// Number of parameters and the id and flags of one
+int32_t hostParameterCount(HostInstance* host);
+Steinberg_tresult hostParameterInfo(HostInstance* host, int32_t index, uint32_t* id, int32_t* flags);
+
+// Configures processing and starts it
+Steinberg_tresult hostStart(HostInstance* host, double sampleRate, int32_t maxBlockSize, int32_t sampleSize);
+
+// Points a bus at caller-owned channel buffers (float** or double**)
+void hostSetBus(HostInstance* host, int32_t direction, int32_t index, int32_t numChannels, void** buffers);
+
+// Appends a note on or off to the block's input events
+void hostAddNote(HostInstance* host, int32_t sampleOffset, int32_t on, int16_t pitch, float velocity, int32_t noteId);
+
+// Runs one process call with the block already staged in host->data
+Steinberg_tresult hostProcess(HostInstance* host);
+
+// Stops processing and releases the instance
+void hostClose(HostInstance* host);
+
+// Prepares the process data and parameter/event list vtables
+void hostInitLists(HostInstance* host);
+
+#pragma GCC visibility pop
+
+#endif // VST3GO_HOST_H
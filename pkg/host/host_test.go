@@ -0,0 +1,192 @@
+package host
+
+import (
+	"bytes"
+	"encoding/json"
+	"testing"
+
+	"github.com/justyntemme/vst3go/pkg/framework/bus"
+	"github.com/justyntemme/vst3go/pkg/framework/param"
+	"github.com/justyntemme/vst3go/pkg/framework/plugin"
+	"github.com/justyntemme/vst3go/pkg/framework/process"
+	"github.com/justyntemme/vst3go/pkg/framework/realtime"
+	vst3plugin "github.com/justyntemme/vst3go/pkg/plugin"
+)
+
+const (
+	paramGain uint32 = iota
+	paramBypass
+)
+
+type testPlugin struct{}
+
+func (testPlugin) GetInfo() plugin.Info {
+	return plugin.Info{ID: "com.vst3go.host.test", Name: "Host Test", Version: "1.0.0", Vendor: "VST3Go", Category: "Fx"}
+}
+
+// The test plugin runs in real-time mode so the host exercises the tracking
+func (testPlugin) RealTimeConfig() realtime.Config {
+	return realtime.DefaultConfig()
+}
+
+func (testPlugin) CreateProcessor() vst3plugin.Processor {
+	p := &testProcessor{params: param.NewRegistry(), buses: bus.NewStereoConfiguration(), tiny: 1e-38, scale: 1e-3}
+	p.params.Add(param.New(paramGain, "Gain").Range(0, 1).Default(1).Build())
+	p.params.Add(param.BypassParameter(paramBypass, "Bypass").Bypass().Build())
+	lastProcessor = p
+	return p
+}
+
+// testProcessor applies its gain parameter, counts the events it is sent
+// and computes a subnormal product to observe the floating point mode
+type testProcessor struct {
+	params *param.Registry
+	buses  *bus.Configuration
+	events int
+
+	tiny, scale, product float32
+}
+
+var lastProcessor *testProcessor
+
+func (p *testProcessor) Initialize(sampleRate float64, maxBlockSize int32) error { return nil }
+func (p *testProcessor) GetParameters() *param.Registry                          { return p.params }
+func (p *testProcessor) GetBuses() *bus.Configuration                            { return p.buses }
+func (p *testProcessor) SetActive(active bool) error                             { return nil }
+func (p *testProcessor) GetLatencySamples() int32                                { return 0 }
+func (p *testProcessor) GetTailSamples() int32                                   { return 0 }
+
+func (p *testProcessor) ProcessAudio(ctx *process.Context) {
+	p.product = p.tiny * p.scale
+	if ctx.ChunkOffset() == 0 {
+		p.events += ctx.InputEvents().Size()
+	}
+	gain := float32(p.params.Get(paramGain).GetPlainValue())
+	for ch := range ctx.Output {
+		for i, x := range ctx.Input[ch][:ctx.NumSamples()] {
+			ctx.Output[ch][i] = x * gain
+		}
+	}
+}
+
+func init() {
+	vst3plugin.Register(testPlugin{})
+}
+
+func TestInstanceProcess(t *testing.T) {
+	inst, err := Open()
+	if err != nil {
+		t.Fatal(err)
+	}
+	defer inst.Close()
+	if inst.Name() != "Host Test" {
+		t.Errorf("Name %q", inst.Name())
+	}
+	if got := inst.AutomatableParameters(); len(got) != 1 || got[0] != paramGain {
+		t.Errorf("Automatable parameters %v, want only the gain", got)
+	}
+	if err := inst.Start(48000, 64, false); err != nil {
+		t.Fatal(err)
+	}
+
+	for ch := 0; ch < 2; ch++ {
+		in := inst.Input32(0, ch)
+		for i := range in {
+			in[i] = 0.5
+		}
+	}
+	inst.AddParameterPoint(paramGain, 0, 0.25)
+	if err := inst.Process(64); err != nil {
+		t.Fatal(err)
+	}
+	for ch := 0; ch < 2; ch++ {
+		if got := inst.Output32(0, ch)[63]; got != 0.125 {
+			t.Errorf("Channel %d output %f, want 0.125", ch, got)
+		}
+	}
+	if lastProcessor.product != 0 {
+		t.Errorf("Subnormal %g survived a process call; flush-to-zero is off", lastProcessor.product)
+	}
+	if outside := lastProcessor.tiny * lastProcessor.scale; outside == 0 {
+		t.Error("Flush-to-zero leaked out of the process call")
+	}
+
+	if err := inst.Process(128); err == nil {
+		t.Error("Block above the maximum block size was accepted")
+	}
+}
+
+func TestRunReport(t *testing.T) {
+	cfg := DefaultConfig()
+	cfg.BlockSize = 128
+	cfg.Seconds = 0.5
+	cfg.WarmupBlocks = 4
+	cfg.NotesPerBlock = 2
+	report, err := Run(cfg)
+	if err != nil {
+		t.Fatal(err)
+	}
+
+	if report.Blocks != 187 || report.AutomatedParams != 1 {
+		t.Errorf("Blocks %d, automated params %d", report.Blocks, report.AutomatedParams)
+	}
+	if want := 2 * (report.Blocks + cfg.WarmupBlocks); lastProcessor.events != want {
+		t.Errorf("Processor received %d note events, want %d", lastProcessor.events, want)
+	}
+	if calls := realtime.Enabled().Stats().ProcessCalls; calls < uint64(report.Blocks) {
+		t.Errorf("Real-time mode tracked %d process calls, want at least %d", calls, report.Blocks)
+	}
+	if report.RealTimeFactor <= 0 || report.ProcessSeconds <= 0 {
+		t.Errorf("Real-time factor %g over %g s", report.RealTimeFactor, report.ProcessSeconds)
+	}
+	l := report.Latency
+	if !(l.MinNs <= l.P50Ns && l.P50Ns <= l.P99Ns && l.P99Ns <= l.MaxNs) {
+		t.Errorf("Percentiles out of order: %+v", l)
+	}
+	if l.BudgetNs != 2666666 {
+		t.Errorf("Budget %d ns", l.BudgetNs)
+	}
+	counted := 0
+	for _, b := range l.Histogram {
+		counted += b.Count
+	}
+	if counted != report.Blocks {
+		t.Errorf("Histogram counts %d blocks, want %d", counted, report.Blocks)
+	}
+
+	data, err := json.Marshal(report)
+	if err != nil || !bytes.Contains(data, []byte(`"realtime_factor"`)) {
+		t.Errorf("JSON report %s (%v)", data, err)
+	}
+}
+
+func TestSummarizeHistogram(t *testing.T) {
+	latencies := []int64{500, 1000, 1001, 2000, 3999, 9000}
+	report := summarize(latencies, 17500, 2500)
+	want := []Bucket{{1000, 2}, {2000, 2}, {4000, 1}, {8000, 0}, {16000, 1}}
+	if len(report.Histogram) != len(want) {
+		t.Fatalf("Histogram %v, want %v", report.Histogram, want)
+	}
+	for i := range want {
+		if report.Histogram[i] != want[i] {
+			t.Errorf("Bucket %d: %v, want %v", i, report.Histogram[i], want[i])
+		}
+	}
+	if report.OverBudget != 2 || report.MeanNs != 2916 || report.MaxNs != 9000 {
+		t.Errorf("Summary %+v", report)
+	}
+}
+
+func TestMainWritesJSON(t *testing.T) {
+	var out bytes.Buffer
+	if err := run([]string{"-block", "64,256", "-seconds", "0.1", "-warmup", "1"}, &out); err != nil {
+		t.Fatal(err)
+	}
+	var reports []Report
+	if err := json.Unmarshal(out.Bytes(), &reports); err != nil {
+		t.Fatal(err)
+	}
+	if len(reports) != 2 || reports[0].BlockSize != 64 || reports[1].BlockSize != 256 {
+		t.Errorf("Reports %+v", reports)
+	}
+}
@@ -0,0 +1,101 @@
+package host
+
+import (
+	"encoding/json"
+	"flag"
+	"fmt"
+	"io"
+	"os"
+	"strconv"
+	"strings"
+)
+
+// Main is the command line benchmark of the linked plugin. Plugin examples
+// hook it up from main_bench.go, which is only compiled with the bench
+// build tag, so plugin libraries never link the host; their main function
+// calls it, after every init has registered the plugin:
+//
+//	go build -tags bench -o gain-bench ./examples/gain && ./gain-bench -block 64,512 -o gain.json
+//
+// Every combination of sample rate and block size is rendered and the
+// reports are written as a JSON array.
+func Main() {
+	if err := run(os.Args[1:], os.Stdout); err != nil {
+		fmt.Fprintln(os.Stderr, err)
+		os.Exit(1)
+	}
+}
+
+func run(args []string, stdout io.Writer) error {
+	defaults := DefaultConfig()
+	flags := flag.NewFlagSet("bench", flag.ContinueOnError)
+	rates := flags.String("rate", "48000", "comma-separated sample rates")
+	blockSizes := flags.String("block", strconv.Itoa(defaults.BlockSize), "comma-separated block sizes")
+	seconds := flags.Float64("seconds", defaults.Seconds, "audio seconds rendered per configuration")
+	warmup := flags.Int("warmup", defaults.WarmupBlocks, "blocks rendered before measuring")
+	params := flags.Int("params", defaults.AutomatedParams, "parameters automated per block, -1 for all")
+	points := flags.Int("points", defaults.PointsPerBlock, "automation points per parameter per block")
+	notes := flags.Int("notes", defaults.NotesPerBlock, "note events per block")
+	double := flags.Bool("double", false, "process in 64-bit")
+	silent := flags.Bool("silent", false, "render silent, host-flagged input")
+	output := flags.String("o", "", "write the JSON report to this file instead of stdout")
+	if err := flags.Parse(args); err != nil {
+		return err
+	}
+
+	sampleRates, err := parseList(*rates, strconv.ParseFloat)
+	if err != nil {
+		return fmt.Errorf("invalid -rate: %w", err)
+	}
+	sizes, err := parseList(*blockSizes, func(s string, _ int) (float64, error) {
+		n, err := strconv.Atoi(s)
+		return float64(n), err
+	})
+	if err != nil {
+		return fmt.Errorf("invalid -block: %w", err)
+	}
+
+	var reports []*Report
+	for _, rate := range sampleRates {
+		for _, size := range sizes {
+			report, err := Run(Config{
+				SampleRate:      rate,
+				BlockSize:       int(size),
+				Seconds:         *seconds,
+				WarmupBlocks:    *warmup,
+				DoublePrecision: *double,
+				AutomatedParams: *params,
+				PointsPerBlock:  *points,
+				NotesPerBlock:   *notes,
+				Silent:          *silent,
+			})
+			if err != nil {
+				return fmt.Errorf("%g Hz, %d samples: %w", rate, int(size), err)
+			}
+			reports = append(reports, report)
+		}
+	}
+
+	data, err := json.MarshalIndent(reports, "", "  ")
+	if err != nil {
+		return err
+	}
+	data = append(data, '\n')
+	if *output != "" {
+		return os.WriteFile(*output, data, 0o644)
+	}
+	_, err = stdout.Write(data)
+	return err
+}
+
+func parseList(list string, parse func(string, int) (float64, error)) ([]float64, error) {
+	var values []float64
+	for _, field := range strings.Split(list, ",") {
+		v, err := parse(strings.TrimSpace(field), 64)
+		if err != nil {
+			return nil, err
+		}
+		values = append(values, v)
+	}
+	return values, nil
+}
@@ -1,239 +1,274 @@
 package midi
 
 import (
-	"sort"
-	"sync"
+	"sync/atomic"
 )
 
-type EventQueue struct {
-	events []Event
-	mu     sync.RWMutex
-	sorted bool
+// DefaultEventCapacity is the number of events an EventStore holds per block
+const DefaultEventCapacity = 1024
+
+// EventStore is a fixed-capacity, value-typed event list for the audio
+// thread. Events stay sorted by sample offset on insertion; hosts deliver
+// them in order, so adding is O(1) in practice. Range queries return
+// sub-slices of the store itself and never copy. An EventStore is not safe
+// for concurrent use; feed it from other threads through an EventRing.
+type EventStore struct {
+	records []EventRecord
+	dropped int
 }
 
-func NewEventQueue() *EventQueue {
-	return &EventQueue{
-		events: make([]Event, 0, 128),
-		sorted: true,
+// NewEventStore creates a store holding up to capacity events
+func NewEventStore(capacity int) *EventStore {
+	return &EventStore{
+		records: make([]EventRecord, 0, capacity),
 	}
 }
 
-func (q *EventQueue) Add(event Event) {
-	q.mu.Lock()
-	defer q.mu.Unlock()
+// Add inserts a record in sample order. It returns false and counts the
+// record as dropped when the store is full.
+func (s *EventStore) Add(record EventRecord) bool {
+	n := len(s.records)
+	if n == cap(s.records) {
+		s.dropped++
+		return false
+	}
 
-	q.events = append(q.events, event)
-	q.sorted = false
+	s.records = s.records[:n+1]
+	i := n
+	for i > 0 && s.records[i-1].Offset > record.Offset {
+		s.records[i] = s.records[i-1]
+		i--
+	}
+	s.records[i] = record
+	return true
 }
 
-func (q *EventQueue) AddMultiple(events []Event) {
-	if len(events) == 0 {
-		return
-	}
+// AddEvent converts a typed event and inserts it
+func (s *EventStore) AddEvent(event Event) bool {
+	return s.Add(ToRecord(event))
+}
 
-	q.mu.Lock()
-	defer q.mu.Unlock()
+// Records returns every stored record in sample order (no copy)
+func (s *EventStore) Records() []EventRecord {
+	return s.records
+}
 
-	q.events = append(q.events, events...)
-	q.sorted = false
+// Range returns the records in [startSample, endSample) without copying.
+// The slice is only valid until the store is next modified.
+func (s *EventStore) Range(startSample, endSample int32) []EventRecord {
+	start := s.search(startSample)
+	end := start
+	for end < len(s.records) && s.records[end].Offset < endSample {
+		end++
+	}
+	return s.records[start:end]
 }
 
-func (q *EventQueue) GetEventsInRange(startSample, endSample int32) []Event {
-	q.mu.RLock()
-	defer q.mu.RUnlock()
+// Cursor returns a cursor positioned at the first stored record
+func (s *EventStore) Cursor() EventCursor {
+	return EventCursor{store: s}
+}
 
-	if !q.sorted {
-		q.mu.RUnlock()
-		q.mu.Lock()
-		q.sortEvents()
-		q.mu.Unlock()
-		q.mu.RLock()
+// RemoveProcessedEvents drops the records at or before upToSample
+func (s *EventStore) RemoveProcessedEvents(upToSample int32) {
+	keep := s.search(upToSample + 1)
+	if keep > 0 {
+		n := copy(s.records, s.records[keep:])
+		s.records = s.records[:n]
 	}
+}
 
-	if len(q.events) == 0 {
-		return nil
+// OffsetEvents shifts every record by offset samples
+func (s *EventStore) OffsetEvents(offset int32) {
+	for i := range s.records {
+		s.records[i].Offset += offset
 	}
+}
 
-	// Binary search for start position
-	startIdx := sort.Search(len(q.events), func(i int) bool {
-		return q.events[i].SampleOffset() >= startSample
-	})
-
-	if startIdx >= len(q.events) {
-		return nil
+// ProcessEvents hands the records in [startSample, endSample) to a processor.
+// Each record is passed as a *EventRecord, which converts to Event without
+// allocating.
+func (s *EventStore) ProcessEvents(processor EventProcessor, startSample, endSample int32) {
+	records := s.Range(startSample, endSample)
+	for i := range records {
+		processor.ProcessEvent(&records[i])
 	}
+}
 
-	// Find end position
-	endIdx := startIdx
-	for endIdx < len(q.events) && q.events[endIdx].SampleOffset() < endSample {
-		endIdx++
-	}
+// Clear removes all records and resets the dropped counter
+func (s *EventStore) Clear() {
+	s.records = s.records[:0]
+	s.dropped = 0
+}
 
-	if startIdx == endIdx {
-		return nil
-	}
+func (s *EventStore) Size() int {
+	return len(s.records)
+}
 
-	// Return a copy of the relevant events
-	result := make([]Event, endIdx-startIdx)
-	copy(result, q.events[startIdx:endIdx])
-	return result
+func (s *EventStore) IsEmpty() bool {
+	return len(s.records) == 0
 }
 
-func (q *EventQueue) GetAllEvents() []Event {
-	q.mu.RLock()
-	defer q.mu.RUnlock()
+// Capacity returns the maximum number of records the store holds
+func (s *EventStore) Capacity() int {
+	return cap(s.records)
+}
+
+// Dropped returns how many records were rejected since the last Clear
+func (s *EventStore) Dropped() int {
+	return s.dropped
+}
 
-	if !q.sorted {
-		q.mu.RUnlock()
-		q.mu.Lock()
-		q.sortEvents()
-		q.mu.Unlock()
-		q.mu.RLock()
+// search returns the index of the first record at or after sample
+func (s *EventStore) search(sample int32) int {
+	lo, hi := 0, len(s.records)
+	for lo < hi {
+		mid := int(uint(lo+hi) >> 1)
+		if s.records[mid].Offset < sample {
+			lo = mid + 1
+		} else {
+			hi = mid
+		}
 	}
+	return lo
+}
 
-	result := make([]Event, len(q.events))
-	copy(result, q.events)
-	return result
+// EventCursor walks an EventStore in sample order, handing out zero-copy
+// runs of records. Useful for rendering a block in chunks.
+type EventCursor struct {
+	store *EventStore
+	pos   int
 }
 
-func (q *EventQueue) Clear() {
-	q.mu.Lock()
-	defer q.mu.Unlock()
+// Next returns the unvisited records before endSample and advances past them
+func (c *EventCursor) Next(endSample int32) []EventRecord {
+	records := c.store.records
+	start := c.pos
+	for c.pos < len(records) && records[c.pos].Offset < endSample {
+		c.pos++
+	}
+	return records[start:c.pos]
+}
 
-	q.events = q.events[:0]
-	q.sorted = true
+// Done returns true when every record has been visited
+func (c *EventCursor) Done() bool {
+	return c.pos >= len(c.store.records)
 }
 
-func (q *EventQueue) RemoveProcessedEvents(upToSample int32) {
-	q.mu.Lock()
-	defer q.mu.Unlock()
+// EventRing is a lock-free single-producer, single-consumer queue of event
+// records, used to hand events from the UI or controller thread to the
+// audio thread.
+type EventRing struct {
+	buffer []EventRecord
+	mask   uint64
+	head   atomic.Uint64 // Next slot to write; advanced by the producer only
+	tail   atomic.Uint64 // Next slot to read; advanced by the consumer only
+}
 
-	if !q.sorted {
-		q.sortEvents()
+// NewEventRing creates a ring holding at least capacity records
+func NewEventRing(capacity int) *EventRing {
+	size := 1
+	for size < capacity {
+		size <<= 1
+	}
+	return &EventRing{
+		buffer: make([]EventRecord, size),
+		mask:   uint64(size - 1),
 	}
+}
 
-	// Find the first event that should be kept
-	keepIdx := sort.Search(len(q.events), func(i int) bool {
-		return q.events[i].SampleOffset() > upToSample
-	})
+// Push enqueues a record. Producer side only; returns false when full.
+func (r *EventRing) Push(record EventRecord) bool {
+	head := r.head.Load()
+	if head-r.tail.Load() > r.mask {
+		return false
+	}
+	r.buffer[head&r.mask] = record
+	r.head.Store(head + 1)
+	return true
+}
 
-	if keepIdx > 0 {
-		// Remove processed events
-		copy(q.events, q.events[keepIdx:])
-		q.events = q.events[:len(q.events)-keepIdx]
+// Pop dequeues the oldest record. Consumer side only.
+func (r *EventRing) Pop() (EventRecord, bool) {
+	tail := r.tail.Load()
+	if tail == r.head.Load() {
+		return EventRecord{}, false
 	}
+	record := r.buffer[tail&r.mask]
+	r.tail.Store(tail + 1)
+	return record, true
 }
 
-func (q *EventQueue) Size() int {
-	q.mu.RLock()
-	defer q.mu.RUnlock()
-	return len(q.events)
-}
-
-func (q *EventQueue) IsEmpty() bool {
-	q.mu.RLock()
-	defer q.mu.RUnlock()
-	return len(q.events) == 0
-}
-
-func (q *EventQueue) sortEvents() {
-	sort.SliceStable(q.events, func(i, j int) bool {
-		return q.events[i].SampleOffset() < q.events[j].SampleOffset()
-	})
-	q.sorted = true
-}
-
-func (q *EventQueue) OffsetEvents(offset int32) {
-	q.mu.Lock()
-	defer q.mu.Unlock()
-
-	for i := range q.events {
-		switch e := q.events[i].(type) {
-		case NoteOnEvent:
-			e.Offset += offset
-			q.events[i] = e
-		case NoteOffEvent:
-			e.Offset += offset
-			q.events[i] = e
-		case ControlChangeEvent:
-			e.Offset += offset
-			q.events[i] = e
-		case PitchBendEvent:
-			e.Offset += offset
-			q.events[i] = e
-		case PolyPressureEvent:
-			e.Offset += offset
-			q.events[i] = e
-		case ChannelPressureEvent:
-			e.Offset += offset
-			q.events[i] = e
-		case ProgramChangeEvent:
-			e.Offset += offset
-			q.events[i] = e
-		case ClockEvent:
-			e.Offset += offset
-			q.events[i] = e
-		case StartEvent:
-			e.Offset += offset
-			q.events[i] = e
-		case StopEvent:
-			e.Offset += offset
-			q.events[i] = e
-		case ContinueEvent:
-			e.Offset += offset
-			q.events[i] = e
+// DrainTo moves every queued record into a store at the given sample offset
+// and returns how many were moved. Consumer side only.
+func (r *EventRing) DrainTo(store *EventStore, offset int32) int {
+	moved := 0
+	for {
+		record, ok := r.Pop()
+		if !ok {
+			return moved
 		}
+		record.Offset = offset
+		store.Add(record)
+		moved++
 	}
 }
 
-type EventProcessor interface {
-	ProcessEvent(event Event)
+// Len returns the number of queued records
+func (r *EventRing) Len() int {
+	return int(r.head.Load() - r.tail.Load())
 }
 
-func (q *EventQueue) ProcessEvents(processor EventProcessor, startSample, endSample int32) {
-	events := q.GetEventsInRange(startSample, endSample)
-	for _, event := range events {
-		processor.ProcessEvent(event)
-	}
+type EventProcessor interface {
+	ProcessEvent(event Event)
 }
 
+// EventBuffer pairs the input and output stores of a processing block
 type EventBuffer struct {
-	inputQueue  *EventQueue
-	outputQueue *EventQueue
+	inputStore  *EventStore
+	outputStore *EventStore
 }
 
 func NewEventBuffer() *EventBuffer {
 	return &EventBuffer{
-		inputQueue:  NewEventQueue(),
-		outputQueue: NewEventQueue(),
+		inputStore:  NewEventStore(DefaultEventCapacity),
+		outputStore: NewEventStore(DefaultEventCapacity),
 	}
 }
 
+func (b *EventBuffer) Input() *EventStore {
+	return b.inputStore
+}
+
+func (b *EventBuffer) Output() *EventStore {
+	return b.outputStore
+}
+
 func (b *EventBuffer) AddInputEvent(event Event) {
-	b.inputQueue.Add(event)
+	b.inputStore.AddEvent(event)
 }
 
 func (b *EventBuffer) AddOutputEvent(event Event) {
-	b.outputQueue.Add(event)
+	b.outputStore.AddEvent(event)
 }
 
-func (b *EventBuffer) GetInputEvents(startSample, endSample int32) []Event {
-	return b.inputQueue.GetEventsInRange(startSample, endSample)
+func (b *EventBuffer) GetInputEvents(startSample, endSample int32) []EventRecord {
+	return b.inputStore.Range(startSample, endSample)
 }
 
-func (b *EventBuffer) GetOutputEvents() []Event {
-	return b.outputQueue.GetAllEvents()
+func (b *EventBuffer) GetOutputEvents() []EventRecord {
+	return b.outputStore.Records()
 }
 
 func (b *EventBuffer) ClearInput() {
-	b.inputQueue.Clear()
+	b.inputStore.Clear()
 }
 
 func (b *EventBuffer) ClearOutput() {
-	b.outputQueue.Clear()
+	b.outputStore.Clear()
 }
 
 func (b *EventBuffer) ClearAll() {
-	b.inputQueue.Clear()
-	b.outputQueue.Clear()
-}
\ No newline at end of file
+	b.inputStore.Clear()
+	b.outputStore.Clear()
+}
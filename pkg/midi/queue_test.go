@@ -4,8 +4,8 @@ import (
 	"testing"
 )
 
-func TestEventQueue(t *testing.T) {
-	q := NewEventQueue()
+func TestEventStore(t *testing.T) {
+	q := NewEventStore(DefaultEventCapacity)
 
 	// Test empty queue
 	if !q.IsEmpty() {
@@ -16,9 +16,9 @@ func TestEventQueue(t *testing.T) {
 	}
 
 	// Add events
-	q.Add(NoteOnEvent{BaseEvent: BaseEvent{Offset: 100}, NoteNumber: 60, Velocity: 100})
-	q.Add(NoteOffEvent{BaseEvent: BaseEvent{Offset: 200}, NoteNumber: 60, Velocity: 0})
-	q.Add(ControlChangeEvent{BaseEvent: BaseEvent{Offset: 50}, Controller: CCSustain, Value: 127})
+	q.AddEvent(NoteOnEvent{BaseEvent: BaseEvent{Offset: 100}, NoteNumber: 60, Velocity: 100})
+	q.AddEvent(NoteOffEvent{BaseEvent: BaseEvent{Offset: 200}, NoteNumber: 60, Velocity: 0})
+	q.AddEvent(ControlChangeEvent{BaseEvent: BaseEvent{Offset: 50}, Controller: CCSustain, Value: 127})
 
 	if q.IsEmpty() {
 		t.Error("Expected queue to not be empty")
@@ -28,15 +28,15 @@ func TestEventQueue(t *testing.T) {
 	}
 }
 
-func TestEventQueueSorting(t *testing.T) {
-	q := NewEventQueue()
+func TestEventStoreSorting(t *testing.T) {
+	q := NewEventStore(DefaultEventCapacity)
 
 	// Add events out of order
-	q.Add(NoteOnEvent{BaseEvent: BaseEvent{Offset: 300}, NoteNumber: 62, Velocity: 100})
-	q.Add(NoteOnEvent{BaseEvent: BaseEvent{Offset: 100}, NoteNumber: 60, Velocity: 100})
-	q.Add(NoteOnEvent{BaseEvent: BaseEvent{Offset: 200}, NoteNumber: 61, Velocity: 100})
+	q.AddEvent(NoteOnEvent{BaseEvent: BaseEvent{Offset: 300}, NoteNumber: 62, Velocity: 100})
+	q.AddEvent(NoteOnEvent{BaseEvent: BaseEvent{Offset: 100}, NoteNumber: 60, Velocity: 100})
+	q.AddEvent(NoteOnEvent{BaseEvent: BaseEvent{Offset: 200}, NoteNumber: 61, Velocity: 100})
 
-	events := q.GetAllEvents()
+	events := q.Records()
 	if len(events) != 3 {
 		t.Fatalf("Expected 3 events, got %d", len(events))
 	}
@@ -51,14 +51,14 @@ func TestEventQueueSorting(t *testing.T) {
 }
 
 func TestGetEventsInRange(t *testing.T) {
-	q := NewEventQueue()
+	q := NewEventStore(DefaultEventCapacity)
 
 	// Add events
-	q.Add(NoteOnEvent{BaseEvent: BaseEvent{Offset: 0}, NoteNumber: 60, Velocity: 100})
-	q.Add(NoteOnEvent{BaseEvent: BaseEvent{Offset: 50}, NoteNumber: 61, Velocity: 100})
-	q.Add(NoteOnEvent{BaseEvent: BaseEvent{Offset: 100}, NoteNumber: 62, Velocity: 100})
-	q.Add(NoteOnEvent{BaseEvent: BaseEvent{Offset: 150}, NoteNumber: 63, Velocity: 100})
-	q.Add(NoteOnEvent{BaseEvent: BaseEvent{Offset: 200}, NoteNumber: 64, Velocity: 100})
+	q.AddEvent(NoteOnEvent{BaseEvent: BaseEvent{Offset: 0}, NoteNumber: 60, Velocity: 100})
+	q.AddEvent(NoteOnEvent{BaseEvent: BaseEvent{Offset: 50}, NoteNumber: 61, Velocity: 100})
+	q.AddEvent(NoteOnEvent{BaseEvent: BaseEvent{Offset: 100}, NoteNumber: 62, Velocity: 100})
+	q.AddEvent(NoteOnEvent{BaseEvent: BaseEvent{Offset: 150}, NoteNumber: 63, Velocity: 100})
+	q.AddEvent(NoteOnEvent{BaseEvent: BaseEvent{Offset: 200}, NoteNumber: 64, Velocity: 100})
 
 	// Test different ranges
 	tests := []struct {
@@ -75,7 +75,7 @@ func TestGetEventsInRange(t *testing.T) {
 	}
 
 	for _, tt := range tests {
-		events := q.GetEventsInRange(tt.start, tt.end)
+		events := q.Range(tt.start, tt.end)
 		if len(events) != tt.expected {
 			t.Errorf("Range [%d, %d): expected %d events, got %d", 
 				tt.start, tt.end, tt.expected, len(events))
@@ -84,11 +84,11 @@ func TestGetEventsInRange(t *testing.T) {
 }
 
 func TestRemoveProcessedEvents(t *testing.T) {
-	q := NewEventQueue()
+	q := NewEventStore(DefaultEventCapacity)
 
 	// Add events
 	for i := int32(0); i < 5; i++ {
-		q.Add(NoteOnEvent{BaseEvent: BaseEvent{Offset: i * 50}, NoteNumber: 60 + uint8(i), Velocity: 100})
+		q.AddEvent(NoteOnEvent{BaseEvent: BaseEvent{Offset: i * 50}, NoteNumber: 60 + uint8(i), Velocity: 100})
 	}
 
 	// Remove events up to sample 125 (should remove first 3 events: 0, 50, 100)
@@ -98,7 +98,7 @@ func TestRemoveProcessedEvents(t *testing.T) {
 		t.Errorf("Expected 2 events remaining, got %d", q.Size())
 	}
 
-	remaining := q.GetAllEvents()
+	remaining := q.Records()
 	if len(remaining) != 2 {
 		t.Fatalf("Expected 2 remaining events, got %d", len(remaining))
 	}
@@ -113,18 +113,18 @@ func TestRemoveProcessedEvents(t *testing.T) {
 }
 
 func TestOffsetEvents(t *testing.T) {
-	q := NewEventQueue()
+	q := NewEventStore(DefaultEventCapacity)
 
 	// Add various event types
-	q.Add(NoteOnEvent{BaseEvent: BaseEvent{Offset: 100}, NoteNumber: 60, Velocity: 100})
-	q.Add(NoteOffEvent{BaseEvent: BaseEvent{Offset: 200}, NoteNumber: 60, Velocity: 0})
-	q.Add(ControlChangeEvent{BaseEvent: BaseEvent{Offset: 50}, Controller: CCSustain, Value: 127})
-	q.Add(PitchBendEvent{BaseEvent: BaseEvent{Offset: 150}, Value: 1000})
+	q.AddEvent(NoteOnEvent{BaseEvent: BaseEvent{Offset: 100}, NoteNumber: 60, Velocity: 100})
+	q.AddEvent(NoteOffEvent{BaseEvent: BaseEvent{Offset: 200}, NoteNumber: 60, Velocity: 0})
+	q.AddEvent(ControlChangeEvent{BaseEvent: BaseEvent{Offset: 50}, Controller: CCSustain, Value: 127})
+	q.AddEvent(PitchBendEvent{BaseEvent: BaseEvent{Offset: 150}, Value: 1000})
 
 	// Offset all events by 100
 	q.OffsetEvents(100)
 
-	events := q.GetAllEvents()
+	events := q.Records()
 	expectedOffsets := []int32{150, 200, 250, 300} // Sorted order
 
 	for i, event := range events {
@@ -176,13 +176,13 @@ func (p *testEventProcessor) ProcessEvent(event Event) {
 }
 
 func TestProcessEvents(t *testing.T) {
-	q := NewEventQueue()
+	q := NewEventStore(DefaultEventCapacity)
 	processor := &testEventProcessor{}
 
 	// Add events
-	q.Add(NoteOnEvent{BaseEvent: BaseEvent{Offset: 50}, NoteNumber: 60, Velocity: 100})
-	q.Add(NoteOnEvent{BaseEvent: BaseEvent{Offset: 150}, NoteNumber: 61, Velocity: 100})
-	q.Add(NoteOnEvent{BaseEvent: BaseEvent{Offset: 250}, NoteNumber: 62, Velocity: 100})
+	q.AddEvent(NoteOnEvent{BaseEvent: BaseEvent{Offset: 50}, NoteNumber: 60, Velocity: 100})
+	q.AddEvent(NoteOnEvent{BaseEvent: BaseEvent{Offset: 150}, NoteNumber: 61, Velocity: 100})
+	q.AddEvent(NoteOnEvent{BaseEvent: BaseEvent{Offset: 250}, NoteNumber: 62, Velocity: 100})
 
 	// Process events in range [0, 200)
 	q.ProcessEvents(processor, 0, 200)
@@ -200,33 +200,98 @@ func TestProcessEvents(t *testing.T) {
 	}
 }
 
-func TestConcurrentAccess(t *testing.T) {
-	q := NewEventQueue()
+func TestEventRingConcurrentAccess(t *testing.T) {
+	ring := NewEventRing(16)
+	q := NewEventStore(DefaultEventCapacity)
 	done := make(chan bool)
 
-	// Writer goroutine
+	// Producer goroutine (UI/controller thread)
 	go func() {
 		for i := 0; i < 100; i++ {
-			q.Add(NoteOnEvent{BaseEvent: BaseEvent{Offset: int32(i)}, NoteNumber: 60, Velocity: 100})
+			for !ring.Push(EventRecord{BaseEvent: BaseEvent{Offset: int32(i)}, Kind: EventTypeNoteOn, Data1: 60, Data2: 100}) {
+				// Ring full, wait for the consumer
+			}
 		}
 		done <- true
 	}()
 
-	// Reader goroutine
-	go func() {
-		for i := 0; i < 100; i++ {
-			_ = q.GetEventsInRange(0, 100)
-			_ = q.Size()
+	// Consumer drains into the store as the audio thread would
+	received := 0
+	for received < 100 {
+		record, ok := ring.Pop()
+		if !ok {
+			continue
 		}
-		done <- true
-	}()
-
-	// Wait for both goroutines to complete
-	<-done
+		if record.Offset != int32(received) {
+			t.Fatalf("Expected FIFO order, got offset %d at position %d", record.Offset, received)
+		}
+		q.Add(record)
+		received++
+	}
 	<-done
 
 	// Verify final state
 	if q.Size() != 100 {
 		t.Errorf("Expected 100 events, got %d", q.Size())
 	}
-}
\ No newline at end of file
+	if ring.Len() != 0 {
+		t.Errorf("Expected empty ring, got %d", ring.Len())
+	}
+}
+
+func TestEventStoreCapacityAndCursor(t *testing.T) {
+	q := NewEventStore(4)
+	for i := int32(0); i < 6; i++ {
+		q.AddEvent(NoteOnEvent{BaseEvent: BaseEvent{Offset: i * 100}, NoteNumber: 60, Velocity: 100})
+	}
+	if q.Size() != 4 || q.Dropped() != 2 {
+		t.Errorf("Expected 4 stored and 2 dropped, got %d/%d", q.Size(), q.Dropped())
+	}
+
+	// Cursor hands out consecutive chunks without revisiting records
+	cursor := q.Cursor()
+	if n := len(cursor.Next(150)); n != 2 {
+		t.Errorf("Expected 2 records before 150, got %d", n)
+	}
+	if n := len(cursor.Next(150)); n != 0 {
+		t.Errorf("Cursor should not revisit records, got %d", n)
+	}
+	if n := len(cursor.Next(1000)); n != 2 || !cursor.Done() {
+		t.Errorf("Expected remaining 2 records, got %d", n)
+	}
+
+	// Records round-trip to typed events
+	event := q.Records()[0].Event()
+	if noteOn, ok := event.(NoteOnEvent); !ok || noteOn.NoteNumber != 60 || noteOn.Velocity != 100 {
+		t.Errorf("Record did not round-trip to NoteOnEvent: %v", event)
+	}
+}
+
+func TestEventStoreZeroAllocations(t *testing.T) {
+	q := NewEventStore(DefaultEventCapacity)
+	ring := NewEventRing(64)
+	processor := &countingProcessor{}
+
+	allocs := testing.AllocsPerRun(100, func() {
+		q.Clear()
+		ring.Push(EventRecord{Kind: EventTypeControlChange, Data1: CCSustain, Data2: 127})
+		ring.DrainTo(q, 0)
+		for i := int32(0); i < 32; i++ {
+			q.Add(EventRecord{BaseEvent: BaseEvent{Offset: i * 8}, Kind: EventTypeNoteOn, Data1: 60, Data2: 100})
+		}
+		_ = q.Range(64, 128)
+		q.ProcessEvents(processor, 0, 256)
+	})
+
+	if allocs != 0 {
+		t.Errorf("Event store allocated %.1f times per block", allocs)
+	}
+}
+
+type countingProcessor struct {
+	count int
+}
+
+func (p *countingProcessor) ProcessEvent(event Event) {
+	p.count++
+}
@@ -0,0 +1,90 @@
+package midi
+
+import (
+	"fmt"
+)
+
+// EventRecord is the value-typed form of any Event, used by the real-time
+// event store so events are never boxed on the audio thread. The meaning of
+// the data fields depends on Kind:
+//
+//	NoteOn/NoteOff:   Data1 = note,       Data2 = velocity
+//	PolyPressure:     Data1 = note,       Data2 = pressure
+//	ControlChange:    Data1 = controller, Data2 = value
+//	ProgramChange:    Data1 = program
+//	ChannelPressure:  Data1 = pressure
+//	PitchBend:        Bend  = -8192..8191
+type EventRecord struct {
+	BaseEvent
+	Kind  EventType
+	Data1 uint8
+	Data2 uint8
+	Bend  int16
+}
+
+func (r EventRecord) Type() EventType {
+	return r.Kind
+}
+
+func (r EventRecord) String() string {
+	return fmt.Sprintf("Event{type:%d, ch:%d, data:%d/%d, bend:%d, offset:%d}",
+		r.Kind, r.EventChannel, r.Data1, r.Data2, r.Bend, r.Offset)
+}
+
+// Event returns the typed event the record describes. Boxing the result
+// allocates, so real-time code should read the record fields directly.
+func (r EventRecord) Event() Event {
+	switch r.Kind {
+	case EventTypeNoteOn:
+		return NoteOnEvent{BaseEvent: r.BaseEvent, NoteNumber: r.Data1, Velocity: r.Data2}
+	case EventTypeNoteOff:
+		return NoteOffEvent{BaseEvent: r.BaseEvent, NoteNumber: r.Data1, Velocity: r.Data2}
+	case EventTypePolyPressure:
+		return PolyPressureEvent{BaseEvent: r.BaseEvent, NoteNumber: r.Data1, Pressure: r.Data2}
+	case EventTypeControlChange:
+		return ControlChangeEvent{BaseEvent: r.BaseEvent, Controller: r.Data1, Value: r.Data2}
+	case EventTypeProgramChange:
+		return ProgramChangeEvent{BaseEvent: r.BaseEvent, Program: r.Data1}
+	case EventTypeChannelPressure:
+		return ChannelPressureEvent{BaseEvent: r.BaseEvent, Pressure: r.Data1}
+	case EventTypePitchBend:
+		return PitchBendEvent{BaseEvent: r.BaseEvent, Value: r.Bend}
+	case EventTypeClock:
+		return ClockEvent{BaseEvent: r.BaseEvent}
+	case EventTypeStart:
+		return StartEvent{BaseEvent: r.BaseEvent}
+	case EventTypeStop:
+		return StopEvent{BaseEvent: r.BaseEvent}
+	case EventTypeContinue:
+		return ContinueEvent{BaseEvent: r.BaseEvent}
+	}
+	return r
+}
+
+// ToRecord converts a typed event into its value-typed record
+func ToRecord(event Event) EventRecord {
+	switch e := event.(type) {
+	case EventRecord:
+		return e
+	case *EventRecord:
+		return *e
+	case NoteOnEvent:
+		return EventRecord{BaseEvent: e.BaseEvent, Kind: EventTypeNoteOn, Data1: e.NoteNumber, Data2: e.Velocity}
+	case NoteOffEvent:
+		return EventRecord{BaseEvent: e.BaseEvent, Kind: EventTypeNoteOff, Data1: e.NoteNumber, Data2: e.Velocity}
+	case PolyPressureEvent:
+		return EventRecord{BaseEvent: e.BaseEvent, Kind: EventTypePolyPressure, Data1: e.NoteNumber, Data2: e.Pressure}
+	case ControlChangeEvent:
+		return EventRecord{BaseEvent: e.BaseEvent, Kind: EventTypeControlChange, Data1: e.Controller, Data2: e.Value}
+	case ProgramChangeEvent:
+		return EventRecord{BaseEvent: e.BaseEvent, Kind: EventTypeProgramChange, Data1: e.Program}
+	case ChannelPressureEvent:
+		return EventRecord{BaseEvent: e.BaseEvent, Kind: EventTypeChannelPressure, Data1: e.Pressure}
+	case PitchBendEvent:
+		return EventRecord{BaseEvent: e.BaseEvent, Kind: EventTypePitchBend, Bend: e.Value}
+	}
+	return EventRecord{
+		BaseEvent: BaseEvent{EventChannel: event.Channel(), Offset: event.SampleOffset()},
+		Kind:      event.Type(),
+	}
+}
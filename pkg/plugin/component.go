@@ -8,9 +8,12 @@ import (
 	"bytes"
 	"fmt"
 	"sync"
+	"sync/atomic"
 	"unsafe"
 
 	"github.com/justyntemme/vst3go/pkg/framework/bus"
+	"github.com/justyntemme/vst3go/pkg/framework/debug"
+	"github.com/justyntemme/vst3go/pkg/framework/param"
 	"github.com/justyntemme/vst3go/pkg/framework/process"
 	"github.com/justyntemme/vst3go/pkg/framework/state"
 	"github.com/justyntemme/vst3go/pkg/midi"
@@ -20,23 +23,75 @@ import (
 // componentImpl wraps a Processor to implement VST3 interfaces
 type componentImpl struct {
 	processor    Processor
+	processor64  Processor64 // Non-nil when the processor renders kSample64 natively
 	processCtx   *process.Context
 	sampleRate   float64
 	maxBlockSize int32
-	active       bool
-	processing   bool
-	mu           sync.RWMutex
+	active       atomic.Bool
+	processing   atomic.Bool
+	mu           sync.Mutex        // Serializes control-thread state changes; never taken in Process
 	wrapper      *componentWrapper // Reference to wrapper for notifications
+	renderFn     func()            // Bound render, reused so chunked processing doesn't allocate
+	inputs       *blockInputs      // Host automation and events, filled once per block by the bridge
+	profileID    debug.SectionID   // Real-time profiler section timing Process
+
+	// Controller-thread events, kept here so they survive setupProcessing
+	// recreating the process context
+	controllerEvents *midi.EventRing
+
+	// State decoded by SetState while processing, applied by Process at
+	// the next block boundary
+	pendingState atomic.Pointer[state.Snapshot]
+}
+
+// maxBlockEvents bounds the events marshalled from the host per block
+const maxBlockEvents = 512
+
+// controllerEventCapacity bounds the controller-thread events queued between blocks
+const controllerEventCapacity = 256
+
+// blockInputs holds the flat arrays the C bridge fills per block
+type blockInputs struct {
+	points [process.MaxParameterChanges]C.ParamPoint
+	events [maxBlockEvents]C.EventRecord
+	counts C.BlockInputCounts
 }
 
 // newComponent creates a new component implementation
 func newComponent(processor Processor) *componentImpl {
 	params := processor.GetParameters()
-	return &componentImpl{
+	processor64, _ := processor.(Processor64)
+	c := &componentImpl{
 		processor:    processor,
-		processCtx:   process.NewContext(8192, params), // Default max block size
-		maxBlockSize: 8192,
+		processor64:  processor64,
+		maxBlockSize: 8192, // Default max block size
+		inputs:       &blockInputs{},
+		profileID:    debug.DefaultRTProfiler.Register(fmt.Sprintf("%T.Process", processor)),
+
+		controllerEvents: midi.NewEventRing(controllerEventCapacity),
 	}
+	c.renderFn = c.render
+	c.processCtx = c.newProcessContext(int(c.maxBlockSize), params)
+	return c
+}
+
+// newProcessContext creates a process context and lets the processor
+// configure it
+func (c *componentImpl) newProcessContext(maxBlockSize int, params *param.Registry) *process.Context {
+	ctx := process.NewContext(maxBlockSize, params)
+	ctx.SetControllerEvents(c.controllerEvents)
+	process.NewMultiBusContext(ctx, c.processor.GetBuses())
+	// Double-precision scratch only for processors that render kSample64
+	channels := process.ArenaChannelsFor(c.processor.GetBuses())
+	channels64 := 0
+	if c.processor64 != nil {
+		channels64 = channels
+	}
+	ctx.ReserveScratch(channels, channels64)
+	if configurer, ok := c.processor.(ContextConfigurer); ok {
+		configurer.ConfigureContext(ctx)
+	}
+	return ctx
 }
 
 // IComponent implementation
@@ -44,7 +99,20 @@ func (c *componentImpl) Initialize(_ interface{}) error {
 	return c.processor.Initialize(48000, c.maxBlockSize) // Default sample rate
 }
 
+// release frees what the component registered globally. The wrapper calls
+// it when the host releases the instance.
+func (c *componentImpl) release() {
+	debug.DefaultRTProfiler.Unregister(c.profileID)
+	c.profileID = debug.NoSection
+}
+
+// Terminate deactivates a processor the host left active, so it releases
+// what it holds while active (worker threads, for example) before the
+// instance is released
 func (c *componentImpl) Terminate() error {
+	if c.active.Load() {
+		return c.SetActive(false)
+	}
 	return nil
 }
 
@@ -88,18 +156,38 @@ func (c *componentImpl) GetRoutingInfo(inInfo, outInfo interface{}) error {
 	return vst3.ErrNotImplemented
 }
 
+// ActivateBus records the host's bus activation. Inactive audio buses are
+// not mapped by Process. Process reads the activation without
+// synchronization, so changes are refused while processing; VST3 hosts
+// activate buses before setActive(true) anyway.
 func (c *componentImpl) ActivateBus(mediaType, direction, index int32, state bool) error {
-	return nil
+	c.mu.Lock()
+	defer c.mu.Unlock()
+
+	if c.processing.Load() {
+		return fmt.Errorf("cannot activate buses while processing")
+	}
+	buses := c.processor.GetBuses()
+	if buses == nil {
+		return vst3.ErrNotImplemented
+	}
+	return buses.SetBusActive(bus.MediaType(mediaType), bus.Direction(direction), index, state)
 }
 
 func (c *componentImpl) SetActive(active bool) error {
 	c.mu.Lock()
 	defer c.mu.Unlock()
 
-	c.active = active
+	c.active.Store(active)
 	return c.processor.SetActive(active)
 }
 
+// SetState decodes a state on the calling (message) thread. While
+// processing, the parameter values are published to the audio thread and
+// applied together at the start of its next block, so a program change
+// never lands mid-block or half-applied; otherwise they apply at once.
+// Custom data travels with them to processors implementing
+// CustomStateApplier; other StatefulProcessors load it immediately.
 func (c *componentImpl) SetState(stateData []byte) error {
 	if c.processor == nil {
 		return fmt.Errorf("no processor available")
@@ -111,16 +199,32 @@ func (c *componentImpl) SetState(stateData []byte) error {
 		return fmt.Errorf("no parameters available")
 	}
 
-	// Create state manager and configure custom state handling
-	stateManager := state.NewManager(params)
+	snapshot, err := state.Decode(stateData)
+	if err != nil {
+		return err
+	}
 
-	// Check if processor implements StatefulProcessor
-	if stateful, ok := c.processor.(StatefulProcessor); ok {
-		stateManager.SetCustomLoadFunc(stateful.LoadCustomState)
+	c.mu.Lock()
+	if c.processing.Load() {
+		// A newer state replaces one the audio thread has not picked up yet
+		c.pendingState.Store(snapshot)
+		c.mu.Unlock()
+
+		// The snapshot carries the custom data to the block boundary for
+		// processors that can take it there
+		if _, ok := c.processor.(CustomStateApplier); ok {
+			return nil
+		}
+	} else {
+		snapshot.Apply(params)
+		c.mu.Unlock()
 	}
 
-	buf := bytes.NewReader(stateData)
-	return stateManager.Load(buf)
+	// Check if processor implements StatefulProcessor
+	if stateful, ok := c.processor.(StatefulProcessor); ok && snapshot.Custom() != nil {
+		return stateful.LoadCustomState(bytes.NewReader(snapshot.Custom()))
+	}
+	return nil
 }
 
 func (c *componentImpl) GetState() ([]byte, error) {
@@ -134,6 +238,11 @@ func (c *componentImpl) GetState() ([]byte, error) {
 		return nil, fmt.Errorf("no parameters available")
 	}
 
+	// A state still waiting for the audio thread is what the host loaded
+	if pending := c.pendingState.Load(); pending != nil {
+		return pending.AppendBinary(nil), nil
+	}
+
 	// Create state manager and configure custom state handling
 	stateManager := state.NewManager(params)
 
@@ -161,9 +270,14 @@ func (c *componentImpl) GetBusArrangement(direction, index int32) (int64, error)
 }
 
 func (c *componentImpl) CanProcessSampleSize(symbolicSampleSize int32) error {
-	// We only support 32-bit float
-	if symbolicSampleSize == 0 { // kSample32
+	switch symbolicSampleSize {
+	case vst3.SymbolicSampleSize32:
 		return nil
+	case vst3.SymbolicSampleSize64:
+		// Only offer 64-bit when the processor can render it without conversion
+		if c.processor64 != nil {
+			return nil
+		}
 	}
 	return vst3.ErrNotImplemented
 }
@@ -181,27 +295,54 @@ func (c *componentImpl) SetupProcessing(setup *vst3.ProcessSetup) error {
 		c.maxBlockSize = setup.MaxSamplesPerBlock
 		// Recreate process context with new max block size
 		params := c.processor.GetParameters()
-		c.processCtx = process.NewContext(int(c.maxBlockSize), params)
+		c.processCtx = c.newProcessContext(int(c.maxBlockSize), params)
+	}
+	debug.DefaultRTProfiler.SetBlockBudget(c.profileID, c.maxBlockSize, c.sampleRate)
+
+	if err := c.processor.Initialize(c.sampleRate, c.maxBlockSize); err != nil {
+		return err
 	}
 
-	return c.processor.Initialize(c.sampleRate, c.maxBlockSize)
+	// The parameter set is final once the processor is initialized; sealing
+	// makes audio-thread lookups lock-free
+	if params := c.processor.GetParameters(); params != nil {
+		params.Seal()
+	}
+	return nil
 }
 
 func (c *componentImpl) SetProcessing(state bool) error {
 	c.mu.Lock()
 	defer c.mu.Unlock()
 
-	c.processing = state
+	c.processCtx.Silence().Reset()
+	c.processing.Store(state)
+	if !state {
+		// No block is coming to pick up a pending state
+		c.applyPendingState()
+	}
 	return nil
 }
 
-func (c *componentImpl) Process(data unsafe.Pointer) error {
-	c.mu.RLock()
-	defer c.mu.RUnlock()
+// applyPendingState applies a state published by SetState, if any - no
+// allocations. Process calls it at each block boundary.
+func (c *componentImpl) applyPendingState() {
+	if snapshot := c.pendingState.Swap(nil); snapshot != nil {
+		c.processCtx.ApplyState(snapshot)
+		if applier, ok := c.processor.(CustomStateApplier); ok && snapshot.Custom() != nil {
+			applier.ApplyCustomState(snapshot.Custom())
+		}
+	}
+}
 
-	if !c.processing {
+// Process runs on the audio thread. It takes no locks: the host only calls
+// it between setProcessing(true) and setProcessing(false), and never
+// concurrently with setupProcessing, so the processing flag is all we need.
+func (c *componentImpl) Process(data unsafe.Pointer) error {
+	if !c.processing.Load() {
 		return nil
 	}
+	profileStart := debug.DefaultRTProfiler.Begin()
 
 	// Get raw process data struct
 	processData := (*C.struct_Steinberg_Vst_ProcessData)(data)
@@ -263,43 +404,55 @@ func (c *componentImpl) Process(data unsafe.Pointer) error {
 
 	// Set input/output buffers (slicing pre-allocated arrays, no allocation)
 	numSamples := int(processData.numSamples)
+	is64 := processData.symbolicSampleSize == vst3.SymbolicSampleSize64
+	if is64 && c.processor64 == nil {
+		debug.DefaultRTProfiler.End(c.profileID, profileStart)
+		return vst3.ErrNotImplemented
+	}
 
-	// Clear slices (no allocation, just updating slice headers)
+	// Map the active buses into the flat channel lists, recording each
+	// bus's range (slicing pre-allocated arrays, no allocation)
 	c.processCtx.Input = c.processCtx.Input[:0]
 	c.processCtx.Output = c.processCtx.Output[:0]
+	c.processCtx.Input64 = c.processCtx.Input64[:0]
+	c.processCtx.Output64 = c.processCtx.Output64[:0]
+	layout := c.processCtx.Buses()
+	layout.ResetMapping()
 
-	// Map input buffers
 	if processData.numInputs > 0 && processData.inputs != nil {
 		inputBuses := (*[1]C.struct_Steinberg_Vst_AudioBusBuffers)(unsafe.Pointer(processData.inputs))[:processData.numInputs:processData.numInputs]
-		for _, bus := range inputBuses {
-			channelBuffers32 := getChannelBuffers32(&bus)
-			if bus.numChannels > 0 && channelBuffers32 != nil {
-				channels := (*[16]*float32)(unsafe.Pointer(channelBuffers32))[:bus.numChannels:bus.numChannels]
-				for _, channel := range channels {
-					if channel != nil {
-						// Create slice from pointer without allocation
-						samples := (*[vst3.MaxArraySize]float32)(unsafe.Pointer(channel))[:numSamples:numSamples]
-						c.processCtx.Input = append(c.processCtx.Input, samples)
-					}
-				}
+		for i := range inputBuses {
+			if !layout.InputActive(i) {
+				continue
+			}
+			bus := &inputBuses[i]
+			if is64 {
+				first := len(c.processCtx.Input64)
+				c.processCtx.Input64 = mapChannels(c.processCtx.Input64, unsafe.Pointer(getChannelBuffers64(bus)), int(bus.numChannels), numSamples)
+				layout.MapInput(i, first, len(c.processCtx.Input64)-first)
+			} else {
+				first := len(c.processCtx.Input)
+				c.processCtx.Input = mapChannels(c.processCtx.Input, unsafe.Pointer(getChannelBuffers32(bus)), int(bus.numChannels), numSamples)
+				layout.MapInput(i, first, len(c.processCtx.Input)-first)
 			}
 		}
 	}
 
-	// Map output buffers
 	if processData.numOutputs > 0 && processData.outputs != nil {
 		outputBuses := (*[1]C.struct_Steinberg_Vst_AudioBusBuffers)(unsafe.Pointer(processData.outputs))[:processData.numOutputs:processData.numOutputs]
-		for _, bus := range outputBuses {
-			channelBuffers32 := getChannelBuffers32(&bus)
-			if bus.numChannels > 0 && channelBuffers32 != nil {
-				channels := (*[16]*float32)(unsafe.Pointer(channelBuffers32))[:bus.numChannels:bus.numChannels]
-				for _, channel := range channels {
-					if channel != nil {
-						// Create slice from pointer without allocation
-						samples := (*[vst3.MaxArraySize]float32)(unsafe.Pointer(channel))[:numSamples:numSamples]
-						c.processCtx.Output = append(c.processCtx.Output, samples)
-					}
-				}
+		for i := range outputBuses {
+			if !layout.OutputActive(i) {
+				continue
+			}
+			bus := &outputBuses[i]
+			if is64 {
+				first := len(c.processCtx.Output64)
+				c.processCtx.Output64 = mapChannels(c.processCtx.Output64, unsafe.Pointer(getChannelBuffers64(bus)), int(bus.numChannels), numSamples)
+				layout.MapOutput(i, first, len(c.processCtx.Output64)-first)
+			} else {
+				first := len(c.processCtx.Output)
+				c.processCtx.Output = mapChannels(c.processCtx.Output, unsafe.Pointer(getChannelBuffers32(bus)), int(bus.numChannels), numSamples)
+				layout.MapOutput(i, first, len(c.processCtx.Output)-first)
 			}
 		}
 	}
@@ -307,40 +460,51 @@ func (c *componentImpl) Process(data unsafe.Pointer) error {
 	// Reset parameter changes for this processing block
 	c.processCtx.ResetParameterChanges()
 
-	// Process input events (MIDI)
-	if processData.inputEvents != nil {
-		c.processInputEvents(processData.inputEvents)
+	// A state loaded on the message thread takes effect at this boundary,
+	// before the block's own automation
+	c.applyPendingState()
+
+	// Read the block's events and automation with a single cgo call
+	inputs := c.inputs
+	C.readBlockInputs(processData,
+		&inputs.points[0], C.int32_t(len(inputs.points)),
+		&inputs.events[0], C.int32_t(len(inputs.events)),
+		&inputs.counts)
+
+	// Process input events (MIDI): controller-thread events first, at offset 0
+	c.processCtx.ClearInputEvents()
+	c.processCtx.DrainControllerEvents()
+	for i := range inputs.events[:inputs.counts.numEvents] {
+		c.processEventRecord(&inputs.events[i])
 	}
 
 	// Collect parameter changes for sample-accurate automation
-	if processData.inputParameterChanges != nil {
-		// Get parameter count using C helper function
-		paramCount := C.getParameterChangeCount(unsafe.Pointer(processData.inputParameterChanges))
-
-		// Process each parameter that has changes
-		for i := C.int32_t(0); i < paramCount; i++ {
-			paramQueue := C.getParameterData(unsafe.Pointer(processData.inputParameterChanges), i)
-			if paramQueue != nil {
-				// Get parameter ID
-				paramID := C.getParameterId(paramQueue)
-
-				// Get number of automation points
-				pointCount := C.getPointCount(paramQueue)
-
-				// Process all automation points for this parameter
-				for j := C.int32_t(0); j < pointCount; j++ {
-					var sampleOffset C.int32_t
-					var value C.double
-
-					// Get the automation point
-					result := C.getPoint(paramQueue, j, &sampleOffset, &value)
-					if result == 0 { // kResultOk
-						// Add parameter change for sample-accurate processing
-						c.processCtx.AddParameterChange(uint32(paramID), float64(value), int(sampleOffset))
-					}
-				}
-			}
+	for i := range inputs.points[:inputs.counts.numPoints] {
+		point := &inputs.points[i]
+		c.processCtx.AddParameterChange(uint32(point.paramId), float64(point.value), int(point.sampleOffset))
+	}
+
+	// Skip the block once the output has been silent for a full tail
+	silence := c.processCtx.Silence()
+	inputSilent := c.inputSilent(processData, is64) && !c.processCtx.HasInputEvents()
+	var tail int32
+	if inputSilent && silence.Enabled() {
+		tail = c.processor.GetTailSamples()
+	}
+	wasSkipping := silence.Skipping()
+	if silence.Begin(inputSilent, tail) {
+		if flusher, ok := c.processor.(SilenceFlusher); ok && !wasSkipping {
+			flusher.FlushSilence()
+		}
+		if c.processCtx.HasParameterChanges() {
+			// Keep parameters current for when processing resumes
+			c.processCtx.SortParameterChanges()
+			c.processCtx.ProcessChunked(skipRender)
 		}
+		c.processCtx.Clear()
+		c.setOutputSilence(processData, true)
+		debug.DefaultRTProfiler.End(c.profileID, profileStart)
+		return nil
 	}
 
 	// Process audio with sample-accurate parameter automation
@@ -349,72 +513,152 @@ func (c *componentImpl) Process(data unsafe.Pointer) error {
 		c.processCtx.SortParameterChanges()
 
 		// Process audio in chunks between parameter changes
-		c.processSampleAccurate()
+		c.processCtx.ProcessChunked(c.renderFn)
 	} else {
 		// No parameter changes - process entire block
-		c.processor.ProcessAudio(c.processCtx)
+		c.render()
+	}
+
+	// Only a tail rendered from silence is scanned for having died out
+	outputSilent := false
+	if inputSilent {
+		if is64 {
+			outputSilent = process.IsSilent(c.processCtx.Output64, float64(silence.Threshold()))
+		} else {
+			outputSilent = process.IsSilent(c.processCtx.Output, silence.Threshold())
+		}
 	}
+	silence.End(outputSilent, numSamples)
+	c.setOutputSilence(processData, outputSilent)
 
+	debug.DefaultRTProfiler.End(c.profileID, profileStart)
 	return nil
 }
 
-func (c *componentImpl) GetTailSamples() uint32 {
-	return uint32(c.processor.GetTailSamples())
+// skipRender stands in for rendering when a skipped block still has
+// automation to apply
+func skipRender() {}
+
+// channelMask returns the silence flag bits covering a bus's channels
+func channelMask(numChannels C.int32_t) C.Steinberg_uint64 {
+	if numChannels >= 64 {
+		return ^C.Steinberg_uint64(0)
+	}
+	return C.Steinberg_uint64(1)<<uint(numChannels) - 1
 }
 
-// processInputEvents processes MIDI events from the host
-func (c *componentImpl) processInputEvents(eventList *C.struct_Steinberg_Vst_IEventList) {
-	if eventList == nil {
-		return
+// inputSilent reports whether every input channel is silent, from the
+// host's silence flags or, when detection is enabled, by scanning the
+// input. Processors without audio inputs never count as silent.
+func (c *componentImpl) inputSilent(processData *C.struct_Steinberg_Vst_ProcessData, is64 bool) bool {
+	if processData.numInputs <= 0 || processData.inputs == nil {
+		return false
+	}
+
+	channels := 0
+	flagged := true
+	inputBuses := (*[1]C.struct_Steinberg_Vst_AudioBusBuffers)(unsafe.Pointer(processData.inputs))[:processData.numInputs:processData.numInputs]
+	layout := c.processCtx.Buses()
+	for i := range inputBuses {
+		bus := &inputBuses[i]
+		if bus.numChannels <= 0 || !layout.InputActive(i) {
+			continue
+		}
+		channels += int(bus.numChannels)
+		mask := channelMask(bus.numChannels)
+		if bus.silenceFlags&mask != mask {
+			flagged = false
+		}
+	}
+	if channels == 0 {
+		return false
+	}
+	if flagged {
+		return true
+	}
+
+	silence := c.processCtx.Silence()
+	if !silence.Detection() {
+		return false
+	}
+	if is64 {
+		return process.IsSilent(c.processCtx.Input64, float64(silence.Threshold()))
 	}
+	return process.IsSilent(c.processCtx.Input, silence.Threshold())
+}
 
-	// Get event count using helper
-	eventCount := C.getEventCount(unsafe.Pointer(eventList))
-	if eventCount <= 0 {
+// setOutputSilence flags every output channel silent or not for the host.
+// Inactive buses are never written, so they are always flagged silent.
+func (c *componentImpl) setOutputSilence(processData *C.struct_Steinberg_Vst_ProcessData, silent bool) {
+	if processData.numOutputs <= 0 || processData.outputs == nil {
 		return
 	}
+	outputBuses := (*[1]C.struct_Steinberg_Vst_AudioBusBuffers)(unsafe.Pointer(processData.outputs))[:processData.numOutputs:processData.numOutputs]
+	layout := c.processCtx.Buses()
+	for i := range outputBuses {
+		bus := &outputBuses[i]
+		if silent || !layout.OutputActive(i) {
+			bus.silenceFlags = channelMask(bus.numChannels)
+		} else {
+			bus.silenceFlags = 0
+		}
+	}
+}
+
+// mapChannels appends zero-copy slices over a bus's host channel pointers
+func mapChannels[T float32 | float64](dst [][]T, channelBuffers unsafe.Pointer, numChannels, numSamples int) [][]T {
+	if numChannels <= 0 || channelBuffers == nil {
+		return dst
+	}
 
-	// Process each event
-	for i := C.int32_t(0); i < eventCount; i++ {
-		var event C.struct_Steinberg_Vst_Event
-		if C.getEvent(unsafe.Pointer(eventList), i, &event) == 0 { // kResultOk
-			c.processSingleEvent(&event)
+	channels := (*[16]*T)(channelBuffers)[:numChannels:numChannels]
+	for _, channel := range channels {
+		if channel != nil {
+			// Create slice from pointer without allocation
+			samples := (*[vst3.MaxArraySize]T)(unsafe.Pointer(channel))[:numSamples:numSamples]
+			dst = append(dst, samples)
 		}
 	}
+	return dst
 }
 
-// processSingleEvent converts a VST3 event to our MIDI event format
-func (c *componentImpl) processSingleEvent(event *C.struct_Steinberg_Vst_Event) {
-	// Use helper function to get event type
-	eventType := C.getEventType(event)
-	
-	switch eventType {
-	case C.Steinberg_Vst_Event_EventTypes_kNoteOnEvent:
-		// Note On event - use helper to get the event data
-		noteOn := C.getNoteOnEvent(event)
-		c.processCtx.AddInputEvent(midi.NoteOnEvent{
-			BaseEvent: midi.BaseEvent{
-				EventChannel: uint8(noteOn.channel),
-				Offset:       int32(event.sampleOffset),
-			},
-			NoteNumber: uint8(noteOn.pitch),
-			Velocity:   uint8(noteOn.velocity * 127), // VST3 uses 0-1, MIDI uses 0-127
-		})
+// render hands the current block (or chunk) to the processor in the
+// sample format the host delivered
+func (c *componentImpl) render() {
+	c.processCtx.Scratch().Reset()
+	if c.processCtx.Is64Bit() {
+		c.processor64.ProcessAudio64(c.processCtx)
+		return
+	}
+	c.processor.ProcessAudio(c.processCtx)
+}
 
-	case C.Steinberg_Vst_Event_EventTypes_kNoteOffEvent:
-		// Note Off event - use helper to get the event data
-		noteOff := C.getNoteOffEvent(event)
-		c.processCtx.AddInputEvent(midi.NoteOffEvent{
-			BaseEvent: midi.BaseEvent{
-				EventChannel: uint8(noteOff.channel),
-				Offset:       int32(event.sampleOffset),
-			},
-			NoteNumber: uint8(noteOff.pitch),
-			Velocity:   uint8(noteOff.velocity * 127),
-		})
+func (c *componentImpl) GetTailSamples() uint32 {
+	return uint32(c.processor.GetTailSamples())
+}
 
-	// Add more event types as needed
+// processEventRecord converts a marshalled VST3 event to our MIDI event format
+func (c *componentImpl) processEventRecord(record *C.EventRecord) {
+	event := midi.EventRecord{
+		BaseEvent: midi.BaseEvent{
+			EventChannel: uint8(record.channel),
+			Offset:       int32(record.sampleOffset),
+		},
+		Data1: uint8(record.pitch),
+		Data2: uint8(record.value * 127), // VST3 uses 0-1, MIDI uses 0-127
 	}
+
+	switch record._type {
+	case C.Steinberg_Vst_Event_EventTypes_kNoteOnEvent:
+		event.Kind = midi.EventTypeNoteOn
+	case C.Steinberg_Vst_Event_EventTypes_kNoteOffEvent:
+		event.Kind = midi.EventTypeNoteOff
+	case C.Steinberg_Vst_Event_EventTypes_kPolyPressureEvent:
+		event.Kind = midi.EventTypePolyPressure
+	default:
+		return
+	}
+	c.processCtx.AddInputRecord(event)
 }
 
 // IEditController implementation
@@ -520,90 +764,3 @@ func (c *componentImpl) SetParamNormalizedWithNotification(id uint32, value floa
 	}
 	return vst3.ErrInvalidArgument
 }
-
-// processSampleAccurate processes audio with sample-accurate parameter automation
-func (c *componentImpl) processSampleAccurate() {
-	changes := c.processCtx.GetParameterChanges()
-	numSamples := c.processCtx.NumSamples()
-	lastOffset := 0
-
-	// Store original buffers
-	origInput := c.processCtx.Input
-	origOutput := c.processCtx.Output
-
-	// Process each chunk between parameter changes
-	for _, change := range changes {
-		if change.SampleOffset > lastOffset {
-			// Process chunk from lastOffset to change.SampleOffset
-			chunkSize := change.SampleOffset - lastOffset
-
-			// Temporarily update context buffers to point to sub-slices (no allocation)
-			c.processCtx.Input = nil
-			c.processCtx.Output = nil
-
-			// Set up input sub-slices
-			for ch := 0; ch < len(origInput); ch++ {
-				if lastOffset < len(origInput[ch]) {
-					endOffset := lastOffset + chunkSize
-					if endOffset > len(origInput[ch]) {
-						endOffset = len(origInput[ch])
-					}
-					c.processCtx.Input = append(c.processCtx.Input, origInput[ch][lastOffset:endOffset])
-				}
-			}
-
-			// Set up output sub-slices
-			for ch := 0; ch < len(origOutput); ch++ {
-				if lastOffset < len(origOutput[ch]) {
-					endOffset := lastOffset + chunkSize
-					if endOffset > len(origOutput[ch]) {
-						endOffset = len(origOutput[ch])
-					}
-					c.processCtx.Output = append(c.processCtx.Output, origOutput[ch][lastOffset:endOffset])
-				}
-			}
-
-			// Process this chunk
-			c.processor.ProcessAudio(c.processCtx)
-
-			lastOffset = change.SampleOffset
-		}
-
-		// Apply the parameter change
-		c.processCtx.ApplyParameterChange(change)
-
-		// Debug output
-		if p := c.processor.GetParameters().Get(change.ParamID); p != nil {
-			fmt.Printf("[SAMPLE_ACCURATE] Applied param %d change at sample %d: value=%.6f, plain=%.1f\n",
-				change.ParamID, change.SampleOffset, change.Value, p.GetPlainValue())
-		}
-	}
-
-	// Process final chunk if there are samples remaining
-	if lastOffset < numSamples {
-		// Temporarily update context buffers for final chunk
-		c.processCtx.Input = nil
-		c.processCtx.Output = nil
-
-		// Set up input sub-slices for final chunk
-		for ch := 0; ch < len(origInput); ch++ {
-			if lastOffset < len(origInput[ch]) {
-				c.processCtx.Input = append(c.processCtx.Input, origInput[ch][lastOffset:])
-			}
-		}
-
-		// Set up output sub-slices for final chunk
-		for ch := 0; ch < len(origOutput); ch++ {
-			if lastOffset < len(origOutput[ch]) {
-				c.processCtx.Output = append(c.processCtx.Output, origOutput[ch][lastOffset:])
-			}
-		}
-
-		// Process final chunk
-		c.processor.ProcessAudio(c.processCtx)
-	}
-
-	// Restore original buffers
-	c.processCtx.Input = origInput
-	c.processCtx.Output = origOutput
-}
@@ -0,0 +1,212 @@
+package plugin
+
+import (
+	"bytes"
+	"io"
+	"testing"
+
+	"github.com/justyntemme/vst3go/pkg/framework/bus"
+	"github.com/justyntemme/vst3go/pkg/framework/param"
+	"github.com/justyntemme/vst3go/pkg/framework/process"
+	"github.com/justyntemme/vst3go/pkg/framework/state"
+	"github.com/justyntemme/vst3go/pkg/midi"
+	"github.com/justyntemme/vst3go/pkg/vst3"
+)
+
+// stateProcessor is a minimal processor with one parameter and custom state
+type stateProcessor struct {
+	params *param.Registry
+	buses  *bus.Configuration
+	custom []byte
+}
+
+func newStateProcessor() *stateProcessor {
+	params := param.NewRegistry()
+	params.Add(param.New(0, "Gain").Range(0, 1).Default(0).Build())
+	return &stateProcessor{params: params, buses: bus.NewStereoConfiguration()}
+}
+
+func (p *stateProcessor) Initialize(float64, int32) error   { return nil }
+func (p *stateProcessor) ProcessAudio(*process.Context)     {}
+func (p *stateProcessor) GetParameters() *param.Registry    { return p.params }
+func (p *stateProcessor) GetBuses() *bus.Configuration      { return p.buses }
+func (p *stateProcessor) SetActive(bool) error              { return nil }
+func (p *stateProcessor) GetLatencySamples() int32          { return 0 }
+func (p *stateProcessor) GetTailSamples() int32             { return 0 }
+func (p *stateProcessor) SaveCustomState(w io.Writer) error { _, err := w.Write(p.custom); return err }
+func (p *stateProcessor) LoadCustomState(r io.Reader) (err error) {
+	p.custom, err = io.ReadAll(r)
+	return err
+}
+
+func presetWithGain(gain float64, custom string) []byte {
+	source := param.NewRegistry()
+	source.Add(param.New(0, "Gain").Range(0, 1).Default(0).Build())
+	source.Get(0).SetValue(gain)
+	return state.Capture(source, []byte(custom)).AppendBinary(nil)
+}
+
+func TestSetStateWhileProcessingWaitsForBlock(t *testing.T) {
+	processor := newStateProcessor()
+	c := newComponent(processor)
+	gain := processor.params.Get(0)
+
+	// Not processing: applied at once
+	if err := c.SetState(presetWithGain(0.25, "a")); err != nil {
+		t.Fatal(err)
+	}
+	if gain.GetValue() != 0.25 || string(processor.custom) != "a" {
+		t.Fatalf("Idle load: gain %f, custom %q", gain.GetValue(), processor.custom)
+	}
+
+	// Processing: the audio thread picks the newest state at the boundary
+	c.SetProcessing(true)
+	c.SetState(presetWithGain(0.5, "b"))
+	c.SetState(presetWithGain(0.75, "c"))
+	if gain.GetValue() != 0.25 {
+		t.Errorf("State applied before the block boundary: %f", gain.GetValue())
+	}
+	if saved, _ := c.GetState(); !bytes.Equal(saved, presetWithGain(0.75, "c")) {
+		t.Error("GetState should report the state waiting to be applied")
+	}
+	c.applyPendingState()
+	if gain.GetValue() != 0.75 {
+		t.Errorf("Expected the newest state at the block boundary, got %f", gain.GetValue())
+	}
+
+	// Stopping applies a state no block picked up
+	c.SetState(presetWithGain(1, "d"))
+	c.SetProcessing(false)
+	if gain.GetValue() != 1 {
+		t.Errorf("Pending state lost when processing stopped: %f", gain.GetValue())
+	}
+}
+
+// applierProcessor takes custom state at the block boundary
+type applierProcessor struct {
+	*stateProcessor
+	applied [8]byte
+	size    int
+}
+
+func (p *applierProcessor) ApplyCustomState(data []byte) { p.size = copy(p.applied[:], data) }
+
+func TestCustomStateAppliedWithParameters(t *testing.T) {
+	processor := &applierProcessor{stateProcessor: newStateProcessor()}
+	c := newComponent(processor)
+	gain := processor.params.Get(0)
+
+	c.SetProcessing(true)
+	c.SetState(presetWithGain(0.5, "b"))
+	if processor.size != 0 || processor.custom != nil {
+		t.Fatal("Custom state applied before the block boundary")
+	}
+	c.applyPendingState()
+	if gain.GetValue() != 0.5 || string(processor.applied[:processor.size]) != "b" {
+		t.Errorf("Block boundary: gain %f, custom %q", gain.GetValue(), processor.applied[:processor.size])
+	}
+	if processor.custom != nil {
+		t.Error("LoadCustomState called for a state loaded while processing")
+	}
+
+	snapshot, err := state.Decode(presetWithGain(0.25, "c"))
+	if err != nil {
+		t.Fatal(err)
+	}
+	allocs := testing.AllocsPerRun(100, func() {
+		c.pendingState.Store(snapshot)
+		c.applyPendingState()
+	})
+	if allocs != 0 {
+		t.Errorf("Applying custom state allocated %.1f times", allocs)
+	}
+}
+
+func TestApplyPendingStateZeroAllocations(t *testing.T) {
+	c := newComponent(newStateProcessor())
+	c.SetProcessing(true)
+	snapshot, err := state.Decode(presetWithGain(0.5, ""))
+	if err != nil {
+		t.Fatal(err)
+	}
+
+	allocs := testing.AllocsPerRun(100, func() {
+		c.pendingState.Store(snapshot)
+		c.applyPendingState()
+	})
+	if allocs != 0 {
+		t.Errorf("Applying a pending state allocated %.1f times", allocs)
+	}
+}
+
+// activeProcessor records activation so teardown can be checked
+type activeProcessor struct {
+	*stateProcessor
+	active bool
+}
+
+func (p *activeProcessor) SetActive(active bool) error {
+	p.active = active
+	return nil
+}
+
+func TestTerminateDeactivatesProcessor(t *testing.T) {
+	processor := &activeProcessor{stateProcessor: newStateProcessor()}
+	c := newComponent(processor)
+	c.SetActive(true)
+	if err := c.Terminate(); err != nil {
+		t.Fatal(err)
+	}
+	if processor.active {
+		t.Error("Terminate left the processor active")
+	}
+}
+
+func TestControllerEventsSurviveSetupProcessing(t *testing.T) {
+	c := newComponent(newStateProcessor())
+	old := c.processCtx
+	if !old.PushControllerEvent(midi.EventRecord{Kind: midi.EventTypeNoteOn}) {
+		t.Fatal("Controller event rejected")
+	}
+
+	if err := c.SetupProcessing(&vst3.ProcessSetup{SampleRate: 44100, MaxSamplesPerBlock: 256}); err != nil {
+		t.Fatal(err)
+	}
+	if c.processCtx == old {
+		t.Fatal("Expected SetupProcessing to recreate the context")
+	}
+	c.processCtx.DrainControllerEvents()
+	if got := c.processCtx.InputEvents().Size(); got != 1 {
+		t.Errorf("Expected the queued controller event after setup, got %d", got)
+	}
+}
+
+func TestActivateBusRefusedWhileProcessing(t *testing.T) {
+	processor := newStateProcessor()
+	c := newComponent(processor)
+	audio, input := int32(bus.MediaTypeAudio), int32(bus.DirectionInput)
+
+	if err := c.ActivateBus(audio, input, 0, false); err != nil {
+		t.Fatal(err)
+	}
+	c.SetProcessing(true)
+	if err := c.ActivateBus(audio, input, 0, true); err == nil {
+		t.Error("ActivateBus should be refused while processing")
+	}
+	if processor.buses.GetBusInfo(bus.MediaTypeAudio, bus.DirectionInput, 0).IsActive {
+		t.Error("Bus activation changed while processing")
+	}
+
+	c.SetProcessing(false)
+	if err := c.ActivateBus(audio, input, 0, true); err != nil {
+		t.Errorf("ActivateBus after processing stopped: %v", err)
+	}
+}
+
+func TestActivateBusWithoutBuses(t *testing.T) {
+	processor := newStateProcessor()
+	processor.buses = nil
+	if err := newComponent(processor).ActivateBus(0, 0, 0, true); err == nil {
+		t.Error("Expected an error without a bus configuration")
+	}
+}
@@ -7,57 +7,90 @@ package plugin
 // static inline float** getChannelBuffers32(struct Steinberg_Vst_AudioBusBuffers* bus) {
 //     return bus->Steinberg_Vst_AudioBusBuffers_channelBuffers32;
 // }
+//
+// // Helper to access channelBuffers64 from the union
+// static inline double** getChannelBuffers64(struct Steinberg_Vst_AudioBusBuffers* bus) {
+//     return bus->Steinberg_Vst_AudioBusBuffers_channelBuffers64;
+// }
 import "C"
-import "unsafe"
+import (
+	"unicode/utf16"
+	"unicode/utf8"
+	"unsafe"
+)
 
 // getChannelBuffers32 extracts the 32-bit channel buffers from an audio bus
 func getChannelBuffers32(bus *C.struct_Steinberg_Vst_AudioBusBuffers) **C.float {
 	return C.getChannelBuffers32(bus)
 }
 
-// copyStringToTChar copies a Go string to a VST3 TChar (UTF16) buffer
-func copyStringToTChar(src string, dst *C.Steinberg_Vst_TChar, maxLen int) {
-	// Convert to runes for proper Unicode handling
-	runes := []rune(src)
-	n := len(runes)
-	if n > maxLen-1 {
-		n = maxLen - 1
-	}
-
-	// Copy runes as UTF16
-	for i := 0; i < n; i++ {
-		*(*C.Steinberg_char16)(unsafe.Pointer(
-			uintptr(unsafe.Pointer(dst)) + uintptr(i*2))) = C.Steinberg_char16(runes[i])
-	}
+// getChannelBuffers64 extracts the 64-bit channel buffers from an audio bus
+func getChannelBuffers64(bus *C.struct_Steinberg_Vst_AudioBusBuffers) **C.double {
+	return C.getChannelBuffers64(bus)
+}
 
-	// Null terminate
-	*(*C.Steinberg_char16)(unsafe.Pointer(
-		uintptr(unsafe.Pointer(dst)) + uintptr(n*2))) = 0
+// copyStringToTChar copies a Go string to a VST3 TChar (UTF16) buffer of
+// maxLen units, such as a String128, without allocating
+func copyStringToTChar(src string, dst *C.Steinberg_Vst_TChar, maxLen int) {
+	encodeUTF16(unsafe.Slice((*uint16)(unsafe.Pointer(dst)), maxLen), src)
 }
 
-// stringFromTChar converts a VST3 TChar (UTF16) buffer to a Go string
+// stringFromTChar converts a null-terminated VST3 TChar (UTF16) buffer to a
+// Go string. Hosts pass String128 buffers, so at most 128 units are read.
 func stringFromTChar(src *C.Steinberg_Vst_TChar) string {
 	if src == nil {
 		return ""
 	}
+	return decodeUTF16(unsafe.Slice((*uint16)(unsafe.Pointer(src)), 128))
+}
 
-	// Count length
-	length := 0
-	for {
-		ch := *(*C.Steinberg_char16)(unsafe.Pointer(
-			uintptr(unsafe.Pointer(src)) + uintptr(length*2)))
-		if ch == 0 {
+// encodeUTF16 writes src to dst as null-terminated UTF-16 and returns the
+// number of units before the terminator. Text that doesn't fit is cut at a
+// character boundary, never between the halves of a surrogate pair.
+func encodeUTF16(dst []uint16, src string) int {
+	if len(dst) == 0 {
+		return 0
+	}
+	limit := len(dst) - 1
+	n := 0
+	for _, r := range src {
+		if r < 0x10000 {
+			if n == limit {
+				break
+			}
+			// Invalid UTF-8 already decoded to U+FFFD
+			dst[n] = uint16(r)
+			n++
+			continue
+		}
+		if n+2 > limit {
 			break
 		}
-		length++
+		hi, lo := utf16.EncodeRune(r)
+		dst[n], dst[n+1] = uint16(hi), uint16(lo)
+		n += 2
 	}
+	dst[n] = 0
+	return n
+}
 
-	// Convert to runes
-	runes := make([]rune, length)
-	for i := 0; i < length; i++ {
-		runes[i] = rune(*(*C.Steinberg_char16)(unsafe.Pointer(
-			uintptr(unsafe.Pointer(src)) + uintptr(i*2))))
+// decodeUTF16 converts null-terminated UTF-16 to a Go string. The text is
+// assembled in a stack buffer, so the string is the only allocation.
+func decodeUTF16(src []uint16) string {
+	var buf [512]byte
+	out := buf[:0]
+	for i := 0; i < len(src) && src[i] != 0; i++ {
+		r := rune(src[i])
+		if utf16.IsSurrogate(r) {
+			next := rune(0)
+			if i+1 < len(src) {
+				next = rune(src[i+1])
+			}
+			if r = utf16.DecodeRune(r, next); r != utf8.RuneError {
+				i++
+			}
+		}
+		out = utf8.AppendRune(out, r)
 	}
-
-	return string(runes)
+	return string(out)
 }
@@ -0,0 +1,62 @@
+package plugin
+
+import (
+	"testing"
+	"unicode/utf16"
+)
+
+func TestEncodeUTF16(t *testing.T) {
+	for _, tc := range []struct {
+		src  string
+		size int
+		want []uint16
+	}{
+		{"Gain", 128, []uint16{'G', 'a', 'i', 'n'}},
+		{"250 µs", 128, utf16.Encode([]rune("250 µs"))},
+		{"a𝄞b", 128, utf16.Encode([]rune("a𝄞b"))},
+		{"abcdef", 4, []uint16{'a', 'b', 'c'}},
+		{"ab𝄞", 4, []uint16{'a', 'b'}}, // The pair doesn't fit: don't split it
+		{"a\xffb", 128, []uint16{'a', 0xFFFD, 'b'}},
+	} {
+		dst := make([]uint16, tc.size)
+		for i := range dst {
+			dst[i] = 0xAAAA
+		}
+		n := encodeUTF16(dst, tc.src)
+		if n != len(tc.want) || dst[n] != 0 {
+			t.Errorf("%q: wrote %d units (terminator %#x), want %d", tc.src, n, dst[n], len(tc.want))
+			continue
+		}
+		for i, u := range tc.want {
+			if dst[i] != u {
+				t.Errorf("%q: unit %d is %#x, want %#x", tc.src, i, dst[i], u)
+			}
+		}
+	}
+}
+
+func TestDecodeUTF16(t *testing.T) {
+	for _, tc := range []struct {
+		src  []uint16
+		want string
+	}{
+		{append(utf16.Encode([]rune("12.5 kHz")), 0, 'x'), "12.5 kHz"},
+		{append(utf16.Encode([]rune("±∞ 𝄞")), 0), "±∞ 𝄞"},
+		{[]uint16{'a', 0xD834, 'b', 0}, "a�b"}, // Lone surrogate
+		{[]uint16{'n', 'o', 'n', 'u', 'l'}, "nonul"},
+	} {
+		if got := decodeUTF16(tc.src); got != tc.want {
+			t.Errorf("Decoded %q, want %q", got, tc.want)
+		}
+	}
+}
+
+func TestEncodeUTF16ZeroAllocations(t *testing.T) {
+	var dst [128]uint16
+	allocs := testing.AllocsPerRun(100, func() {
+		encodeUTF16(dst[:], "-12.5 dB · 250 µs")
+	})
+	if allocs != 0 {
+		t.Errorf("Encoding allocated %.1f times", allocs)
+	}
+}
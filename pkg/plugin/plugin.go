@@ -8,6 +8,7 @@ import (
 	"github.com/justyntemme/vst3go/pkg/framework/param"
 	"github.com/justyntemme/vst3go/pkg/framework/plugin"
 	"github.com/justyntemme/vst3go/pkg/framework/process"
+	"github.com/justyntemme/vst3go/pkg/framework/realtime"
 )
 
 // Plugin is the main interface that users implement
@@ -19,6 +20,19 @@ type Plugin interface {
 	CreateProcessor() Processor
 }
 
+// RealTimePlugin is implemented by plugins that run the Go runtime in
+// real-time mode: GC pacing by memory limit and collections scheduled
+// between process calls (see package realtime). Register enables the mode
+// with the returned configuration; realtime.Enabled().Stats() reports how
+// often a GC cycle still overlapped a process call.
+type RealTimePlugin interface {
+	Plugin
+
+	// RealTimeConfig returns the runtime configuration, usually
+	// realtime.DefaultConfig()
+	RealTimeConfig() realtime.Config
+}
+
 // Processor handles the actual audio processing
 type Processor interface {
 	// Initialize is called when the plugin is created
@@ -39,10 +53,45 @@ type Processor interface {
 	// GetLatencySamples returns the plugin's latency in samples
 	GetLatencySamples() int32
 
-	// GetTailSamples returns the tail length in samples
+	// GetTailSamples returns the tail length in samples, or
+	// process.InfiniteTail. With skipping enabled, ProcessAudio is skipped
+	// once the output has been silent for a full tail (see process.Silence).
 	GetTailSamples() int32
 }
 
+// SilenceFlusher is implemented by processors that enable silence skipping
+// and keep state such as delay lines, filter memories or envelopes.
+// FlushSilence is called on the audio thread when skipping starts and must
+// clear that state, so the first block after the silence doesn't replay
+// what was left in it. It must not allocate.
+type SilenceFlusher interface {
+	Processor
+
+	// FlushSilence clears the processor's internal audio state
+	FlushSilence()
+}
+
+// Processor64 extends Processor with native double-precision processing.
+// Processors that implement it advertise kSample64 support to the host; in
+// 64-bit mode ProcessAudio64 is called with ctx.Input64/ctx.Output64 mapped
+// directly onto the host buffers.
+type Processor64 interface {
+	Processor
+
+	// ProcessAudio64 processes double-precision audio - ZERO ALLOCATIONS!
+	ProcessAudio64(ctx *process.Context)
+}
+
+// ContextConfigurer lets a processor tune its process context, for example
+// the automation chunk size or per-parameter smoothers. ConfigureContext is
+// called on the control thread whenever the context is (re)created.
+type ContextConfigurer interface {
+	Processor
+
+	// ConfigureContext configures a newly created process context
+	ConfigureContext(ctx *process.Context)
+}
+
 // StatefulProcessor extends Processor with custom state save/load capabilities
 // Processors can optionally implement this interface to save custom state
 // beyond parameter values (e.g., delay buffer contents, filter states)
@@ -54,6 +103,23 @@ type StatefulProcessor interface {
 	SaveCustomState(w io.Writer) error
 
 	// LoadCustomState loads additional state beyond parameters
-	// This is called after all parameters have been loaded
+	// This is called on the message thread after the parameter values have
+	// been applied, or queued for the next block while processing. In the
+	// latter case it runs before the queued values take effect and may land
+	// mid-block; implement CustomStateApplier to switch both together
 	LoadCustomState(r io.Reader) error
 }
+
+// CustomStateApplier extends StatefulProcessor for custom state that must
+// change at the same block boundary as the parameter values of a state
+// loaded while processing
+type CustomStateApplier interface {
+	StatefulProcessor
+
+	// ApplyCustomState is called on the audio thread, between blocks, with
+	// the custom data of a state loaded while processing, right after its
+	// parameter values were applied. It must not block or allocate; data
+	// is only valid for the duration of the call. LoadCustomState still
+	// handles states loaded while idle
+	ApplyCustomState(data []byte)
+}
@@ -31,8 +31,10 @@ package plugin
 import "C"
 import (
 	"sync"
+	"sync/atomic"
 	"unsafe"
 
+	"github.com/justyntemme/vst3go/pkg/framework/realtime"
 	"github.com/justyntemme/vst3go/pkg/vst3"
 )
 
@@ -48,15 +50,35 @@ type componentWrapper struct {
 	component        Component
 	handle           unsafe.Pointer
 	id               uintptr
-	componentHandler unsafe.Pointer // IComponentHandler from host
-	handlerMu        sync.RWMutex   // Protects componentHandler access
+	componentHandler unsafe.Pointer    // IComponentHandler from host
+	handlerMu        sync.RWMutex      // Protects componentHandler access
+	realtime         *realtime.Tracker // Process call tracking in real-time mode, or nil
+
+	// Host-format parameter info, encoded once for every parameter
+	paramInfoMu sync.Mutex
+	paramInfos  []C.struct_Steinberg_Vst_ParameterInfo
 }
 
+// Component handles are stable, non-pointer values stored in the C
+// ComponentWrapper. The low bits index a fixed slot table and the high bits
+// carry a generation counter so a stale handle never resolves to a component
+// that later reused the same slot.
+const (
+	componentSlotBits = 12
+	maxComponents     = 1 << componentSlotBits
+	componentSlotMask = maxComponents - 1
+)
+
 var (
-	// Global map of component wrappers indexed by ID
-	components   = make(map[uintptr]*componentWrapper)
-	componentsMu sync.RWMutex
-	nextID       uintptr = 1
+	// Fixed-index component table. Slots are published atomically so audio
+	// and controller callbacks resolve their wrapper without locks or hashing.
+	componentSlots [maxComponents]atomic.Pointer[componentWrapper]
+
+	// Slot bookkeeping, only touched when instances are created or released
+	componentsMu    sync.Mutex
+	freeSlots       []uintptr
+	nextSlot        uintptr = 1 // Slot 0 is reserved so a zero handle is never valid
+	slotGenerations [maxComponents]uintptr
 )
 
 // Global plugin instance
@@ -75,9 +97,15 @@ var globalFactoryInfo = FactoryInfo{
 	Email:  "info@vst3go.dev",
 }
 
-// Register sets the global plugin instance
+// Register sets the global plugin instance. A RealTimePlugin also enables
+// the real-time runtime mode; the GC settings are per plugin binary, since
+// every plugin module carries its own Go runtime.
 func Register(p Plugin) {
 	globalPlugin = p
+	if rt, ok := p.(RealTimePlugin); ok && realtime.Enabled() == nil {
+		// An invalid configuration leaves the runtime untouched
+		_, _ = realtime.Enable(rt.RealTimeConfig())
+	}
 }
 
 // SetFactoryInfo sets the factory information
@@ -93,35 +121,57 @@ func recoverPanic(operation string) {
 	}
 }
 
-// registerComponent registers a component wrapper and returns its ID
+// registerComponent publishes a component wrapper in the slot table and
+// returns its handle, or 0 if every slot is in use
 func registerComponent(wrapper *componentWrapper) uintptr {
 	componentsMu.Lock()
 	defer componentsMu.Unlock()
-	id := nextID
-	nextID++
+
+	var slot uintptr
+	if n := len(freeSlots); n > 0 {
+		slot = freeSlots[n-1]
+		freeSlots = freeSlots[:n-1]
+	} else if nextSlot < maxComponents {
+		slot = nextSlot
+		nextSlot++
+	} else {
+		return 0
+	}
+
+	slotGenerations[slot]++
+	id := slotGenerations[slot]<<componentSlotBits | slot
 	wrapper.id = id
-	components[id] = wrapper
+	componentSlots[slot].Store(wrapper)
 	return id
 }
 
-// unregisterComponent removes a component wrapper by ID
+// unregisterComponent removes a component wrapper by handle
 func unregisterComponent(id uintptr) {
 	componentsMu.Lock()
 	defer componentsMu.Unlock()
-	delete(components, id)
+
+	slot := id & componentSlotMask
+	if slot == 0 {
+		return
+	}
+	wrapper := componentSlots[slot].Load()
+	if wrapper == nil || wrapper.id != id {
+		return
+	}
+	componentSlots[slot].Store(nil)
+	freeSlots = append(freeSlots, slot)
 }
 
-// getComponent retrieves a component wrapper by ID
+// getComponent resolves a handle to its component wrapper.
+// Lock-free and allocation-free; safe to call from the audio thread.
 func getComponent(id uintptr) *componentWrapper {
-	componentsMu.RLock()
-	defer componentsMu.RUnlock()
-
-	if id == 0 {
+	slot := id & componentSlotMask
+	if slot == 0 {
 		return nil
 	}
 
-	wrapper, exists := components[id]
-	if !exists {
+	wrapper := componentSlots[slot].Load()
+	if wrapper == nil || wrapper.id != id {
 		return nil
 	}
 
@@ -235,17 +285,25 @@ func GoCreateInstance(cid *C.char, iid *C.char) unsafe.Pointer {
 	wrapper := &componentWrapper{
 		component: component,
 	}
+	if mode := realtime.Enabled(); mode != nil {
+		wrapper.realtime = mode.NewTracker()
+	}
 
 	// Set wrapper reference in component for notifications
 	component.wrapper = wrapper
 
-	// Register and get ID
+	// Register and get a stable handle
 	id := registerComponent(wrapper)
+	if id == 0 {
+		component.release()
+		return nil
+	}
 
-	// Create C component with ID instead of Go pointer
+	// Create C component with the handle instead of a Go pointer
 	cComponent := C.createComponent(unsafe.Pointer(id))
 	if cComponent == nil {
 		unregisterComponent(id)
+		component.release()
 		return nil
 	}
 
@@ -262,6 +320,13 @@ func GoReleaseComponent(componentPtr unsafe.Pointer) {
 		return
 	}
 
+	// Hosts that release without terminating still get the processor torn down
+	if wrapper := getComponent(id); wrapper != nil {
+		wrapper.component.Terminate()
+		if component, ok := wrapper.component.(*componentImpl); ok {
+			component.release()
+		}
+	}
 	unregisterComponent(id)
 }
 
@@ -122,6 +122,11 @@ func GoAudioProcess(componentPtr unsafe.Pointer, data unsafe.Pointer) C.Steinber
 		return C.Steinberg_tresult(vst3.ResultFalse)
 	}
 
+	if wrapper.realtime != nil {
+		wrapper.realtime.Begin()
+		defer wrapper.realtime.End()
+	}
+
 	err := wrapper.component.Process(data)
 	if err != nil {
 		return C.Steinberg_tresult(vst3.ResultFalse)
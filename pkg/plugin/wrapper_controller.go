@@ -46,54 +46,50 @@ func GoEditControllerGetParameterInfo(componentPtr unsafe.Pointer, paramIndex C.
 		return C.Steinberg_tresult(vst3.ResultFalse)
 	}
 
-	paramInfo, err := wrapper.component.GetParameterInfo(int32(paramIndex))
-	if err != nil || paramInfo == nil {
+	if !wrapper.parameterInfo(int32(paramIndex), info) {
 		return C.Steinberg_tresult(vst3.ResultFalse)
 	}
+	return C.Steinberg_tresult(vst3.ResultOK)
+}
 
-	// Copy to C struct
-	cInfo := info
-	cInfo.id = C.Steinberg_Vst_ParamID(paramInfo.ID)
-
-	// Copy title
-	titleBytes := []byte(paramInfo.Title)
-	if len(titleBytes) > 127 {
-		titleBytes = titleBytes[:127]
-	}
-	for i, b := range titleBytes {
-		cInfo.title[i] = C.Steinberg_char16(b)
-	}
-	cInfo.title[len(titleBytes)] = 0
-
-	// Copy short title
-	shortTitleBytes := []byte(paramInfo.ShortTitle)
-	if len(shortTitleBytes) > 127 {
-		shortTitleBytes = shortTitleBytes[:127]
-	}
-	for i, b := range shortTitleBytes {
-		cInfo.shortTitle[i] = C.Steinberg_char16(b)
-	}
-	cInfo.shortTitle[len(shortTitleBytes)] = 0
-
-	// Copy units
-	unitsBytes := []byte(paramInfo.Units)
-	if len(unitsBytes) > 127 {
-		unitsBytes = unitsBytes[:127]
-	}
-	for i, b := range unitsBytes {
-		cInfo.units[i] = C.Steinberg_char16(b)
-	}
-	cInfo.units[len(unitsBytes)] = 0
+// parameterInfo copies the info of the parameter at index into info. Hosts
+// query every parameter in turn while scanning, so the whole table is
+// converted to UTF-16 on the first call and later calls are a struct copy.
+// It is rebuilt if the parameter count changes.
+func (w *componentWrapper) parameterInfo(index int32, info *C.struct_Steinberg_Vst_ParameterInfo) bool {
+	w.paramInfoMu.Lock()
+	defer w.paramInfoMu.Unlock()
+
+	count := w.component.GetParameterCount()
+	if int32(len(w.paramInfos)) != count {
+		infos := make([]C.struct_Steinberg_Vst_ParameterInfo, count)
+		for i := range infos {
+			paramInfo, err := w.component.GetParameterInfo(int32(i))
+			if err != nil || paramInfo == nil {
+				return false
+			}
+			fillParameterInfo(&infos[i], paramInfo)
+		}
+		w.paramInfos = infos
+	}
+
+	if index < 0 || index >= count {
+		return false
+	}
+	*info = w.paramInfos[index]
+	return true
+}
 
+// fillParameterInfo converts a parameter description to the host struct
+func fillParameterInfo(cInfo *C.struct_Steinberg_Vst_ParameterInfo, paramInfo *vst3.ParameterInfo) {
+	cInfo.id = C.Steinberg_Vst_ParamID(paramInfo.ID)
+	copyStringToTChar(paramInfo.Title, &cInfo.title[0], len(cInfo.title))
+	copyStringToTChar(paramInfo.ShortTitle, &cInfo.shortTitle[0], len(cInfo.shortTitle))
+	copyStringToTChar(paramInfo.Units, &cInfo.units[0], len(cInfo.units))
 	cInfo.stepCount = C.Steinberg_int32(paramInfo.StepCount)
 	cInfo.defaultNormalizedValue = C.Steinberg_Vst_ParamValue(paramInfo.DefaultValue)
 	cInfo.unitId = C.Steinberg_Vst_UnitID(paramInfo.UnitID)
 	cInfo.flags = C.Steinberg_int32(paramInfo.Flags)
-
-	// Debug: Print parameter info
-	// fmt.Printf("Parameter %d: StepCount=%d, Flags=%d, Name=%s\n", paramInfo.ID, paramInfo.StepCount, paramInfo.Flags, paramInfo.Title)
-
-	return C.Steinberg_tresult(vst3.ResultOK)
 }
 
 //export GoEditControllerGetParamStringByValue
@@ -109,7 +105,7 @@ func GoEditControllerGetParamStringByValue(componentPtr unsafe.Pointer, id C.Ste
 		return C.Steinberg_tresult(vst3.ResultFalse)
 	}
 
-	// Convert to UTF16 for VST3
+	// Convert to UTF16 straight into the host's String128
 	copyStringToTChar(str, string, 128)
 
 	return C.Steinberg_tresult(vst3.ResultOK)
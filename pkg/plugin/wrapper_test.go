@@ -0,0 +1,72 @@
+package plugin
+
+import (
+	"testing"
+
+	// Links the C bridge so the cgo references in this package resolve
+	_ "github.com/justyntemme/vst3go/pkg/plugin/cbridge"
+)
+
+func TestComponentHandleLookup(t *testing.T) {
+	a := &componentWrapper{}
+	b := &componentWrapper{}
+
+	idA := registerComponent(a)
+	idB := registerComponent(b)
+	if idA == 0 || idB == 0 || idA == idB {
+		t.Fatalf("Expected distinct non-zero handles, got %d and %d", idA, idB)
+	}
+
+	if getComponent(idA) != a || getComponent(idB) != b {
+		t.Fatal("Handles should resolve to their registered wrappers")
+	}
+
+	if getComponent(0) != nil {
+		t.Error("Zero handle should never resolve")
+	}
+
+	unregisterComponent(idA)
+	if getComponent(idA) != nil {
+		t.Error("Released handle should no longer resolve")
+	}
+
+	// The freed slot is reused, but the old handle must stay dead
+	c := &componentWrapper{}
+	idC := registerComponent(c)
+	if idC&componentSlotMask != idA&componentSlotMask {
+		t.Errorf("Expected slot reuse, got slot %d want %d", idC&componentSlotMask, idA&componentSlotMask)
+	}
+	if idC == idA {
+		t.Error("Reused slot should carry a new generation")
+	}
+	if getComponent(idA) != nil {
+		t.Error("Stale handle resolved to a component in a reused slot")
+	}
+	if getComponent(idC) != c {
+		t.Error("New handle should resolve to the new wrapper")
+	}
+
+	// Releasing a stale handle must not evict the current occupant
+	unregisterComponent(idA)
+	if getComponent(idC) != c {
+		t.Error("Stale unregister evicted the current component")
+	}
+
+	unregisterComponent(idB)
+	unregisterComponent(idC)
+}
+
+func BenchmarkGetComponent(b *testing.B) {
+	w := &componentWrapper{}
+	id := registerComponent(w)
+	defer unregisterComponent(id)
+
+	b.ReportAllocs()
+	b.RunParallel(func(pb *testing.PB) {
+		for pb.Next() {
+			if getComponent(id) != w {
+				b.Fatal("lookup failed")
+			}
+		}
+	})
+}
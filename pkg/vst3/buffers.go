@@ -5,6 +5,10 @@ package vst3
 // static inline Steinberg_Vst_Sample32** getChannelBuffers32(struct Steinberg_Vst_AudioBusBuffers* buffers) {
 //     return buffers->Steinberg_Vst_AudioBusBuffers_channelBuffers32;
 // }
+//
+// static inline Steinberg_Vst_Sample64** getChannelBuffers64(struct Steinberg_Vst_AudioBusBuffers* buffers) {
+//     return buffers->Steinberg_Vst_AudioBusBuffers_channelBuffers64;
+// }
 import "C"
 import (
 	"unsafe"
@@ -12,12 +16,14 @@ import (
 
 // AudioBuffer provides safe access to VST3 audio buffers
 type AudioBuffer struct {
-	channelBuffers [][]float32
-	numSamples     int32
+	channelBuffers   [][]float32
+	channelBuffers64 [][]float64
+	numSamples       int32
 }
 
-// NewAudioBuffer creates a new audio buffer from C audio bus buffers
-func NewAudioBuffer(cBuffers *C.struct_Steinberg_Vst_AudioBusBuffers, numSamples int32) *AudioBuffer {
+// NewAudioBuffer creates a new audio buffer from C audio bus buffers.
+// symbolicSampleSize selects which side of the channel buffer union is valid.
+func NewAudioBuffer(cBuffers *C.struct_Steinberg_Vst_AudioBusBuffers, numSamples int32, symbolicSampleSize int32) *AudioBuffer {
 	if cBuffers == nil {
 		return nil
 	}
@@ -27,6 +33,26 @@ func NewAudioBuffer(cBuffers *C.struct_Steinberg_Vst_AudioBusBuffers, numSamples
 		return nil
 	}
 
+	if symbolicSampleSize == SymbolicSampleSize64 {
+		channelBuffers64 := make([][]float64, numChannels)
+
+		if channelBuffers := C.getChannelBuffers64(cBuffers); channelBuffers != nil {
+			channelPtrs := (*[MaxArraySize]*C.Steinberg_Vst_Sample64)(unsafe.Pointer(channelBuffers))[:numChannels:numChannels]
+
+			for i := 0; i < numChannels; i++ {
+				if channelPtrs[i] != nil {
+					// Create a Go slice from the C buffer without copying
+					channelBuffers64[i] = (*[MaxArraySize / 2]float64)(unsafe.Pointer(channelPtrs[i]))[:numSamples:numSamples]
+				}
+			}
+		}
+
+		return &AudioBuffer{
+			channelBuffers64: channelBuffers64,
+			numSamples:       numSamples,
+		}
+	}
+
 	// Create Go slices for each channel
 	channelBuffers := make([][]float32, numChannels)
 
@@ -59,8 +85,24 @@ func (b *AudioBuffer) GetChannel(index int) []float32 {
 	return b.channelBuffers[index]
 }
 
+// GetChannel64 returns a specific channel's double-precision buffer
+func (b *AudioBuffer) GetChannel64(index int) []float64 {
+	if index < 0 || index >= len(b.channelBuffers64) {
+		return nil
+	}
+	return b.channelBuffers64[index]
+}
+
+// Is64Bit returns true if the buffer wraps kSample64 channels
+func (b *AudioBuffer) Is64Bit() bool {
+	return b.channelBuffers64 != nil
+}
+
 // NumChannels returns the number of channels
 func (b *AudioBuffer) NumChannels() int {
+	if b.channelBuffers64 != nil {
+		return len(b.channelBuffers64)
+	}
 	return len(b.channelBuffers)
 }
 
@@ -189,7 +231,7 @@ func NewProcessDataWrapper(dataPtr unsafe.Pointer) *ProcessDataWrapper {
 		inputPtrs := (*[MaxArraySize]C.struct_Steinberg_Vst_AudioBusBuffers)(unsafe.Pointer(data.inputs))[:numInputs:numInputs]
 
 		for i := 0; i < numInputs; i++ {
-			wrapper.inputBuffers[i] = NewAudioBuffer(&inputPtrs[i], int32(data.numSamples))
+			wrapper.inputBuffers[i] = NewAudioBuffer(&inputPtrs[i], int32(data.numSamples), int32(data.symbolicSampleSize))
 		}
 	}
 
@@ -200,7 +242,7 @@ func NewProcessDataWrapper(dataPtr unsafe.Pointer) *ProcessDataWrapper {
 		outputPtrs := (*[MaxArraySize]C.struct_Steinberg_Vst_AudioBusBuffers)(unsafe.Pointer(data.outputs))[:numOutputs:numOutputs]
 
 		for i := 0; i < numOutputs; i++ {
-			wrapper.outputBuffers[i] = NewAudioBuffer(&outputPtrs[i], int32(data.numSamples))
+			wrapper.outputBuffers[i] = NewAudioBuffer(&outputPtrs[i], int32(data.numSamples), int32(data.symbolicSampleSize))
 		}
 	}
 
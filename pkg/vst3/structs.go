@@ -14,6 +14,12 @@ type AudioBusBuffers struct {
 	Buffers     [][]float32
 }
 
+// Symbolic sample sizes (ProcessSetup.SymbolicSampleSize / ProcessData.symbolicSampleSize)
+const (
+	SymbolicSampleSize32 = 0 // kSample32
+	SymbolicSampleSize64 = 1 // kSample64
+)
+
 // ProcessSetup contains audio processing configuration
 type ProcessSetup struct {
 	ProcessMode        int32